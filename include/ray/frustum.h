@@ -271,6 +271,13 @@ public:
 	T getFar() const noexcept { return _far.distance; }
 	T getNear() const noexcept { return _near.distance; }
 
+	const Plane3t<T>& getLeftPlane() const noexcept { return _left; }
+	const Plane3t<T>& getRightPlane() const noexcept { return _right; }
+	const Plane3t<T>& getTopPlane() const noexcept { return _top; }
+	const Plane3t<T>& getBottomPlane() const noexcept { return _bottom; }
+	const Plane3t<T>& getNearPlane() const noexcept { return _near; }
+	const Plane3t<T>& getFarPlane() const noexcept { return _far; }
+
 private:
 	Plane3t<T> _left;
 	Plane3t<T> _right;
@@ -48,6 +48,7 @@ public:
 	virtual ~GameApplication() noexcept;
 
 	bool open(WindHandle hwnd, std::uint32_t w, std::uint32_t h, std::uint32_t framebuffer_w, std::uint32_t framebuffer_h, float dpi) noexcept;
+	bool openHeadless() noexcept;
 	void close() noexcept;
 
 	bool start() noexcept;
@@ -73,6 +74,9 @@ public:
 	bool setFileServicePath(const std::wstring& path) noexcept;
 	bool setResDownloadURL(const util::string& path) noexcept;
 
+	bool record(const util::string& path) noexcept;
+	bool replay(const util::string& path) noexcept;
+
 	bool sendMessage(const MessagePtr& message) noexcept;
 	bool postMessage(const MessagePtr& message) noexcept;
 
@@ -85,6 +89,8 @@ private:
 	GameApplication(const GameApplication&) noexcept = delete;
 	GameApplication& operator=(const GameApplication&) noexcept = delete;
 
+	bool openServer() noexcept;
+
 private:
 
 	bool _isInitialize;
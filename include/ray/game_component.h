@@ -68,6 +68,16 @@ public:
 		return std::dynamic_pointer_cast<T>(this->getComponent(T::RTTI));
 	}
 
+	// GameAccessFlagNone keeps the component on the main thread, in the order of its game object.
+	// GameAccessFlagSelfBit : only members of the component itself are read and written.
+	// GameAccessFlagTransformReadBit : transforms within the hierarchy of its game object are read.
+	// GameAccessFlagTransformWriteBit : the transform of its game object is written, which moves the children too.
+	// Opted-in components must not send messages, (de)activate objects or touch other features.
+	// Each phase runs the opted-in components of every object first, then the others, so within one object
+	// the opted-in components run before the rest whatever their order. onMoveAfter of a component that did
+	// not opt in is held back while the opted-in ones run and called once on the main thread afterwards.
+	virtual GameAccessFlags getAccessFlags() const noexcept;
+
 	virtual void load(const archivebuf& reader) noexcept;
 	virtual void save(archivebuf& write) noexcept;
 
@@ -165,12 +165,17 @@ private:
 	void _onActivate() except;
 	void _onDeactivate() noexcept;
 
-	void _onFrameBegin() except;
-	void _onFrame() except;
-	void _onFrameEnd() except;
+	void _onFrameBegin(bool parallel) except;
+	void _onFrame(bool parallel) except;
+	void _onFrameEnd(bool parallel) except;
+
+	GameAccessFlags _getDispatchAccess(GameDispatchType type, bool& serial) const noexcept;
 
 	void _onMoveBefore() except;
 	void _onMoveAfter() except;
+	void _onMoveAfterDeferred() except;
+
+	bool _hasSerialMoveBefore() const noexcept;
 
 	void _onLayerChangeBefore() except;
 	void _onLayerChangeAfter() except;
@@ -211,6 +216,8 @@ private:
 	mutable bool _localNeedUpdates;
 	mutable bool _worldNeedUpdates;
 
+	bool _isMoveAfterDeferred;
+
 	GameObjects _children;
 	GameObjectWeakPtr _parent;
 
@@ -38,7 +38,9 @@
 #define _H_GAME_OBJECT_MANAGER_H_
 
 #include <stack>
+#include <unordered_map>
 #include <ray/game_features.h>
+#include <ray/thread.h>
 
 _NAME_BEGIN
 
@@ -68,6 +70,9 @@ public:
 
 	bool activeObject(const util::string& name) noexcept;
 
+	void setNumThreads(std::uint32_t numThreads) noexcept;
+	std::uint32_t getNumThreads() const noexcept;
+
 	void onFrameBegin() noexcept;
 	void onFrame() noexcept;
 	void onFrameEnd() noexcept;
@@ -79,12 +84,29 @@ private:
 	void _unsetObject(GameObject* entity) noexcept;
 	void _activeObject(GameObject* entity, bool active) noexcept;
 
+	void _dispatch(GameDispatchType type) noexcept;
+	void _dispatch(GameObject* object, GameDispatchType type, bool parallel) noexcept;
+
+	void _deferMoveAfter(GameObject* object) noexcept;
+
 private:
 	bool _hasEmptyActors;
 
 	std::stack<std::size_t> _emptyLists;
 	std::vector<GameObject*> _instanceLists;
 	std::vector<GameObject*> _activeActors;
+
+	std::uint32_t _numThreads;
+
+	ThreadPool _threadPool;
+
+	bool _isParallelDispatch;
+
+	std::vector<std::vector<GameObject*>> _parallelGroups;
+	std::vector<std::vector<GameObject*>> _parallelMoves;
+	std::vector<GameAccessFlags> _parallelGroupFlags;
+	std::vector<std::uint8_t> _parallelGroupSerial;
+	std::unordered_map<GameObject*, std::size_t> _parallelGroupIndices;
 };
 
 _NAME_END
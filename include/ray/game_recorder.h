@@ -0,0 +1,150 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#ifndef _H_GAME_RECORDER_H_
+#define _H_GAME_RECORDER_H_
+
+#include <ray/game_types.h>
+#include <ray/fstream.h>
+
+_NAME_BEGIN
+
+enum GameRecordMode : std::uint8_t
+{
+	GameRecordModeNone,
+	GameRecordModeRecord,
+	GameRecordModeReplay,
+};
+
+enum GameRecordEntryType : std::uint8_t
+{
+	GameRecordEntryTypeFrame,
+	GameRecordEntryTypeInputSend,
+	GameRecordEntryTypeInputPost,
+	GameRecordEntryTypeMessageSend,
+	GameRecordEntryTypeMessagePost,
+};
+
+struct EXPORT GameRecordEntry
+{
+	GameRecordEntryType type;
+
+	InputEvent event;
+	MessagePtr message;
+
+	std::vector<std::string> files;
+	std::vector<const char*> filenames;
+};
+
+struct EXPORT GameRecordFrame
+{
+	float delta;
+	std::vector<GameRecordEntry> entries;
+};
+
+// Writes the frame delta, the input events and the messages of every frame into a compact binary log,
+// and reads them back so that a session can be replayed with the same deltas in the same order.
+// Messages are stored by their rtti name, a message with state has to give it out through Message::read
+// and take it back through Message::write.
+class EXPORT GameRecorder final
+{
+public:
+	GameRecorder() noexcept;
+	~GameRecorder() noexcept;
+
+	bool record(const util::string& path) noexcept;
+	bool replay(const util::string& path) noexcept;
+	void close() noexcept;
+
+	GameRecordMode getRecordMode() const noexcept;
+
+	bool isRecording() const noexcept;
+	bool isReplaying() const noexcept;
+
+	std::uint32_t getNumFrames() const noexcept;
+
+	void addInputEvent(const InputEvent& event, bool post) noexcept;
+	void addMessage(const MessagePtr& message, bool post) noexcept;
+	void addFrame(float delta) noexcept;
+
+	bool readFrame(GameRecordFrame& frame) noexcept;
+
+private:
+	void flush() noexcept;
+
+	void writeInputEvent(std::vector<char>& buffer, const InputEvent& event, bool post) noexcept;
+	void writeMessage(std::vector<char>& buffer, const MessagePtr& message, bool post) noexcept;
+
+	bool readInputEvent(GameRecordEntry& entry) noexcept;
+	bool readMessage(GameRecordEntry& entry) noexcept;
+
+	bool read(void* data, std::size_t size) noexcept;
+
+	template<typename T>
+	static void write(std::vector<char>& buffer, const T& value) noexcept
+	{
+		auto data = reinterpret_cast<const char*>(&value);
+		buffer.insert(buffer.end(), data, data + sizeof(T));
+	}
+
+	template<typename T>
+	bool read(T& value) noexcept
+	{
+		return this->read(&value, sizeof(T));
+	}
+
+private:
+	GameRecorder(const GameRecorder&) = delete;
+	GameRecorder& operator=(const GameRecorder&) = delete;
+
+private:
+	GameRecordMode _mode;
+
+	std::uint32_t _numFrames;
+
+	ofstream _stream;
+
+	std::vector<char> _frame;
+	std::vector<char> _pending;
+	std::vector<char> _payload;
+
+	std::vector<char> _replay;
+	std::size_t _offset;
+};
+
+_NAME_END
+
+#endif
@@ -58,6 +58,9 @@ public:
 	void setGameListener(const GameListenerPtr& listener) noexcept;
 	const GameListenerPtr& getGameListener() const noexcept;
 
+	void setGameRecorder(const GameRecorderPtr& recorder) noexcept;
+	const GameRecorderPtr& getGameRecorder() const noexcept;
+
 	bool isActive() const noexcept;
 	bool isStopping() const noexcept;
 	bool isQuitRequest() const noexcept;
@@ -111,6 +114,7 @@ private:
 
 	GameApplication* _gameApp;
 	GameListenerPtr _gameListener;
+	GameRecorderPtr _gameRecorder;
 
 	MessageDispatcher _dispatcher;
 };
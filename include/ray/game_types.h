@@ -57,6 +57,7 @@ class GameListener;
 class GameObject;
 class GameObjectManager;
 class GameComponent;
+class GameRecorder;
 
 typedef std::shared_ptr<GameScene> GameScenePtr;
 typedef std::shared_ptr<GameListener> GameListenerPtr;
@@ -65,6 +66,7 @@ typedef std::shared_ptr<GameComponent> GameComponentPtr;
 typedef std::shared_ptr<GameFeature> GameFeaturePtr;
 typedef std::shared_ptr<GameServer> GameServerPtr;
 typedef std::shared_ptr<GameApplication> GameApplicationPtr;
+typedef std::shared_ptr<GameRecorder> GameRecorderPtr;
 
 typedef std::weak_ptr<GameScene> GameSceneWeakPtr;
 typedef std::weak_ptr<GameListener> GameListenerWeakPtr;
@@ -93,6 +95,19 @@ enum GameDispatchType : std::uint8_t
 	GameDispatchTypeRangeSize = (GameDispatchTypeEndRange - GameDispatchTypeBeginRange + 1),
 };
 
+// What a component touches in onFrameBegin, onFrame and onFrameEnd. Components that declare anything
+// but GameAccessFlagNone are updated across the worker threads of GameObjectManager.
+enum GameAccessFlagBits
+{
+	GameAccessFlagNone = 0,
+	GameAccessFlagSelfBit = 1,
+	GameAccessFlagTransformReadBit = 2,
+	GameAccessFlagTransformWriteBit = 4,
+	GameAccessFlagTransformBit = GameAccessFlagTransformReadBit | GameAccessFlagTransformWriteBit,
+};
+
+typedef std::uint32_t GameAccessFlags;
+
 _NAME_END
 
 #endif
\ No newline at end of file
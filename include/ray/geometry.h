@@ -55,6 +55,25 @@ public:
 	std::uint32_t numInstances;
 };
 
+class EXPORT GraphicsCluster final
+{
+public:
+	GraphicsCluster() noexcept;
+	GraphicsCluster(const float3& center, float radius, const float3& coneAxis, float coneCutoff, std::uint32_t startIndice, std::uint32_t numIndices) noexcept;
+
+	float3 center;
+	float radius;
+
+	// sine of the cone half angle, 1.0 never culls
+	float3 coneAxis;
+	float coneCutoff;
+
+	std::uint32_t startIndice;
+	std::uint32_t numIndices;
+};
+
+typedef std::vector<GraphicsCluster> GraphicsClusters;
+
 class EXPORT Geometry final : public RenderObject
 {
 	__DeclareSubClass(Geometry, RenderObject)
@@ -77,16 +96,45 @@ public:
 	void setIndexBuffer(const GraphicsDataPtr& data, std::intptr_t offset, GraphicsIndexType indexType) noexcept;
 	const GraphicsDataPtr& getIndexBuffer() const noexcept;
 
+	void setQuantize(const float3& positionScale, const float3& positionBias, const float4& texcoordScaleBias) noexcept;
+	const float3& getQuantizePositionScale() const noexcept;
+	const float3& getQuantizePositionBias() const noexcept;
+	const float4& getQuantizeTexcoord() const noexcept;
+
 	void setGraphicsIndirect(GraphicsIndirectPtr&& renderable) noexcept;
 	void setGraphicsIndirect(const GraphicsIndirectPtr& renderable) noexcept;
 	GraphicsIndirectPtr getGraphicsIndirect() noexcept;
 
+	void setGraphicsIndirectLevels(const GraphicsIndirects& levels) noexcept;
+	const GraphicsIndirects& getGraphicsIndirectLevels() const noexcept;
+
+	void setLevel(std::size_t level) noexcept;
+	std::size_t getLevel() const noexcept;
+
+	void setGraphicsClusters(const GraphicsClusters& clusters) noexcept;
+	const GraphicsClusters& getGraphicsClusters() const noexcept;
+	std::size_t getVisibleClusterCount(const Camera& camera) const noexcept;
+
 private:
 	bool onVisiableTest(const Camera& camera, const Frustum& fru) noexcept;
 
 	void onAddRenderData(RenderDataManager& manager) noexcept;
 	void onRenderObject(RenderPipeline& pipelineContext, RenderQueue queue, MaterialTech* tech) noexcept;
 
+private:
+	bool cullClusters(const Camera& camera) noexcept;
+
+private:
+	struct ClusterVisibility
+	{
+		float4x4 viewProject;
+		float4x4 transform;
+		bool needUpload;
+		std::uint32_t drawCount;
+		std::vector<std::uint32_t> commands;
+		GraphicsDataPtr indirect;
+	};
+
 private:
 	static RenderQueue stringToRenderQueue(const std::string& techName) noexcept;
 
@@ -104,8 +152,20 @@ private:
 	GraphicsDataPtr _vbo;
 	GraphicsDataPtr _ibo;
 	GraphicsIndexType _indexType;
+
+	float3 _quantizePositionScale;
+	float3 _quantizePositionBias;
+	float4 _quantizeTexcoord;
+
+	std::size_t _level;
+
 	GraphicsIndirectPtr _renderable;
+	GraphicsIndirects _renderableLevels;
 	GraphicsInputLayoutPtr _inputLayout;
+
+	GraphicsClusters _clusters;
+	std::vector<float> _clusterBounds;
+	std::map<std::weak_ptr<const rtti::Interface>, ClusterVisibility, std::owner_less<std::weak_ptr<const rtti::Interface>>> _clusterVisibilities;
 };
 
 _NAME_END
@@ -109,6 +109,10 @@ public:
 
 	virtual void present() noexcept = 0;
 
+	// GPU timestamp ranges reported to the Profiler, backends without timer queries ignore them.
+	virtual void beginProfile(const char* name) noexcept;
+	virtual void endProfile() noexcept;
+
 private:
 	GraphicsContext(const GraphicsContext&) noexcept = delete;
 	GraphicsContext& operator=(const GraphicsContext&) noexcept = delete;
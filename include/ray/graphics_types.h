@@ -806,7 +806,8 @@ enum GraphicsUsageFlagBits
 	GraphicsUsageFlagCoherentBit = 0x00000008,
 	GraphicsUsageFlagFlushExplicitBit = 0x00000010,
 	GraphicsUsageFlagDynamicStorageBit = 0x00000020,
-	GraphicsUsageFlagClientStorageBit = 0x00000040
+	GraphicsUsageFlagClientStorageBit = 0x00000040,
+	GraphicsUsageFlagStreamBit = 0x00000080
 };
 
 typedef std::uint32_t GraphicsUsageFlags;
@@ -0,0 +1,75 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2015.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#ifndef _H_IMAG_COMPRESS_H_
+#define _H_IMAG_COMPRESS_H_
+
+#include <ray/image.h>
+
+_NAME_BEGIN
+
+class ThreadPool;
+
+namespace image
+{
+	enum class compress_quality_t : std::uint8_t
+	{
+		Fast,
+		Normal,
+		High,
+	};
+
+	struct CompressDesc
+	{
+		// Fast fits the principal axis and tries one BC6H and BC7 mode, Normal refines the endpoints
+		// and tries more modes, High also searches the best partitions and every BC7 rotation.
+		compress_quality_t quality = compress_quality_t::Normal;
+
+		// Null runs on the shared ThreadPool::instance(), which has a worker per core.
+		ThreadPool* threadPool = nullptr;
+	};
+
+	// Encodes every mip, face and array layer of src into BC1, BC2, BC3, BC4, BC5, BC6H or BC7.
+	// BC6H takes 16 or 32 bit float RGB(A), the others 8 bit UNorm or SRGB, BC4 and BC5 read R and RG only.
+	EXPORT bool compress(Image& dst, const Image& src, format_t format, const CompressDesc& desc = CompressDesc()) noexcept;
+
+	// Decodes BC1, BC2, BC3 and BC7 to R8G8B8A8, BC4 to R8, BC5 to R8G8 and BC6H to R16G16B16SFloat.
+	EXPORT bool decompress(Image& dst, const Image& src) noexcept;
+}
+
+_NAME_END
+
+#endif
@@ -38,6 +38,7 @@
 #define _H_IMAG_CUBEMAP_H_
 
 #include <ray/image.h>
+#include <ray/SH.h>
 
 _NAME_BEGIN
 
@@ -51,6 +52,24 @@ namespace image
 
 	bool EXPORT makeCubemapFromLatLong(Image& _dst, const Image& _src, bool _useBilinearInterpolation = false);
 	bool EXPORT makeLatLongFromCubemap(Image& _dst, const Image& _src, bool _useBilinearInterpolation = false);
+
+	// Projects a float cubemap or an equirectangular (lat-long) image onto spherical harmonics.
+	bool EXPORT makeSHFromCubemap(SH9Color& sh, const Image& src) noexcept;
+	bool EXPORT makeSHFromCubemap(SH16Color& sh, const Image& src) noexcept;
+	bool EXPORT makeSHFromCubemap(SH25Color& sh, const Image& src) noexcept;
+
+	bool EXPORT makeSHFromLatLong(SH9Color& sh, const Image& src) noexcept;
+	bool EXPORT makeSHFromLatLong(SH16Color& sh, const Image& src) noexcept;
+	bool EXPORT makeSHFromLatLong(SH25Color& sh, const Image& src) noexcept;
+
+	// Evaluates the cosine convolved radiance into a R32G32B32SFloat cubemap.
+	bool EXPORT makeIrradianceFromSH(Image& dst, const SH9Color& sh, std::uint32_t size) noexcept;
+	bool EXPORT makeIrradianceFromSH(Image& dst, const SH16Color& sh, std::uint32_t size) noexcept;
+	bool EXPORT makeIrradianceFromSH(Image& dst, const SH25Color& sh, std::uint32_t size) noexcept;
+
+	// Builds a GGX prefiltered specular cubemap, mip n is filtered with roughness n / (mipLevel - 1).
+	// size and mipLevel of zero take the source size and a full mip chain.
+	bool EXPORT makePrefilteredCubemap(Image& dst, const Image& src, std::uint32_t size = 0, std::uint32_t mipLevel = 0, std::uint32_t sampleCount = 64) noexcept;
 }
 
 _NAME_END
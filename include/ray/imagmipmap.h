@@ -0,0 +1,81 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2015.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#ifndef _H_IMAG_MIPMAP_H_
+#define _H_IMAG_MIPMAP_H_
+
+#include <ray/image.h>
+
+_NAME_BEGIN
+
+class ThreadPool;
+
+namespace image
+{
+	enum class mip_filter_t : std::uint8_t
+	{
+		Box,
+		Kaiser,
+	};
+
+	struct MipmapDesc
+	{
+		mip_filter_t filter = mip_filter_t::Box;
+
+		// Zero builds the full chain down to 1x1.
+		std::uint32_t mipLevel = 0;
+
+		// Cutout textures keep the fraction of texels with alpha above this value on every mip, zero disables it.
+		float alphaCutoff = 0.0f;
+
+		// Treats 8 bit UNorm colour as sRGB and filters it in linear space, SRGB formats always are.
+		// Off by default so normal maps, masks and other data textures are filtered as stored.
+		bool sRGB = false;
+
+		// Null runs on the shared ThreadPool::instance(), which has a worker per core.
+		ThreadPool* threadPool = nullptr;
+	};
+
+	// Rebuilds the mip chain of every face and array layer from the first mip of src.
+	// Supports 8 and 16 bit UNorm, SRGB and 16 or 32 bit float formats, odd sizes round down like the GPU does.
+	EXPORT bool makeMipmap(Image& dst, const Image& src, const MipmapDesc& desc = MipmapDesc()) noexcept;
+
+	EXPORT std::uint32_t getMipLevelCount(std::uint32_t width, std::uint32_t height) noexcept;
+}
+
+_NAME_END
+
+#endif
@@ -62,6 +62,33 @@ namespace image
 	EXPORT void rgba32f_to_rgba8sint(const Image& src, Image& dst);
 	EXPORT void rgba64f_to_rgba8sint(const Image& src, Image& dst);
 
+	// The converters below run on SSE2, AVX2 or NEON when the cpu has it and fall back to scalar code otherwise,
+	// every path produces the same bits. Counts are in pixels, or in values for the single channel ones.
+	// Converters that keep the pixel size may run in place.
+	enum class simd_t : std::uint8_t
+	{
+		None,
+		SSE2,
+		AVX2,
+		NEON,
+	};
+
+	EXPORT simd_t simd_support() noexcept;
+	EXPORT simd_t get_simd_level() noexcept;
+	EXPORT void set_simd_level(simd_t level) noexcept;
+
+	EXPORT void rgb8_to_rgba8(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha = 0xFF) noexcept;
+	EXPORT void rgba8_to_rgb8(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept;
+	EXPORT void rgb8_to_bgr8(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept;
+	EXPORT void rgba8_to_bgra8(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept;
+	EXPORT void bgr8_to_rgba8(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha = 0xFF) noexcept;
+
+	EXPORT void r8_to_r32f(const std::uint8_t* src, float* dst, std::size_t count) noexcept;
+	EXPORT void r32f_to_r8(const float* src, std::uint8_t* dst, std::size_t count) noexcept;
+
+	EXPORT void r32f_to_r16f(const float* src, std::uint16_t* dst, std::size_t count) noexcept;
+	EXPORT void r16f_to_r32f(const std::uint16_t* src, float* dst, std::size_t count) noexcept;
+
 	template<typename _Tx, typename size_t = std::uint32_t, typename channel_t = std::uint8_t>
 	void flipHorizontal(_Tx* data, size_t w, size_t h, channel_t channel)
 	{
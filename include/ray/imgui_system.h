@@ -81,13 +81,6 @@ private:
 	std::string _imguiPath;
 	std::string _imguiDockPath;
 
-	MaterialPtr _material;
-	MaterialTechPtr _materialTech;
-	MaterialParamPtr _materialDecal;
-	MaterialParamPtr _materialProj;
-
-	GraphicsDataPtr _vbo;
-	GraphicsDataPtr _ibo;
 	GraphicsTexturePtr _texture;
 };
 
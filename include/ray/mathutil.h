@@ -871,6 +871,74 @@ namespace math
 		return *reinterpret_cast<std::uint64_t*>(&fp);
 	}
 
+	inline std::uint16_t fpToHalf(float fp) noexcept
+	{
+		std::uint32_t x = fpToIEEE(fp);
+		std::uint32_t sign = (x >> 16) & 0x8000;
+		std::uint32_t mantissa = x & 0x007FFFFF;
+		std::int32_t exponent = (std::int32_t)((x >> 23) & 0xFF) - 127 + 15;
+
+		if (((x >> 23) & 0xFF) == 0xFF)
+			return (std::uint16_t)(sign | 0x7C00 | (mantissa ? 0x0200 : 0));
+
+		if (exponent >= 0x1F)
+			return (std::uint16_t)(sign | 0x7C00);
+
+		if (exponent <= 0)
+		{
+			if (exponent < -10)
+				return (std::uint16_t)sign;
+
+			mantissa |= 0x00800000;
+
+			std::uint32_t shift = 14 - exponent;
+			std::uint32_t half = mantissa >> shift;
+			std::uint32_t remainder = mantissa & ((1u << shift) - 1);
+			std::uint32_t middle = 1u << (shift - 1);
+
+			if (remainder > middle || (remainder == middle && (half & 1)))
+				half++;
+
+			return (std::uint16_t)(sign | half);
+		}
+
+		std::uint32_t half = sign | (exponent << 10) | (mantissa >> 13);
+		std::uint32_t remainder = mantissa & 0x1FFF;
+
+		if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+			half++;
+
+		return (std::uint16_t)half;
+	}
+
+	inline float fpFromHalf(std::uint16_t half) noexcept
+	{
+		std::uint32_t sign = (std::uint32_t)(half & 0x8000) << 16;
+		std::int32_t exponent = (half >> 10) & 0x1F;
+		std::uint32_t mantissa = half & 0x03FF;
+
+		if (exponent == 0x1F)
+			return fpFromIEEE(sign | 0x7F800000 | (mantissa << 13));
+
+		if (exponent == 0)
+		{
+			if (mantissa == 0)
+				return fpFromIEEE(sign);
+
+			exponent = 1;
+
+			while (!(mantissa & 0x0400))
+			{
+				mantissa <<= 1;
+				exponent--;
+			}
+
+			mantissa &= 0x03FF;
+		}
+
+		return fpFromIEEE(sign | ((std::uint32_t)(exponent + 127 - 15) << 23) | (mantissa << 13));
+	}
+
 	template<typename T>
 	inline bool closeTo(T a, T b, T epsilon) noexcept
 	{
@@ -61,6 +61,12 @@ public:
 	void setReceiveShadow(bool value) noexcept;
 	bool getReceiveShadow() const noexcept;
 
+	void setQuantize(ModelQuantizeFlags quantize) noexcept;
+	ModelQuantizeFlags getQuantize() const noexcept;
+
+	void setClusterCulling(bool enable) noexcept;
+	bool getClusterCulling() const noexcept;
+
 	void setMaterial(const MaterialPtr& material) noexcept;
 	void setMaterial(const MaterialPtr& material, std::size_t n) noexcept;
 	void setSharedMaterial(const MaterialPtr& material) noexcept;
@@ -101,6 +107,8 @@ protected:
 	virtual void onAttachComponent(const GameComponentPtr& component) noexcept;
 	virtual void onDetachComponent(const GameComponentPtr& component) noexcept;
 
+	virtual void onRenderObjectVisiable(RenderObject& object, const Camera& camera, float distanceSqrt) noexcept;
+
 protected:
 	void _attacRenderObject(GeometryPtr object) noexcept;
 	void _attacRenderObjects() noexcept;
@@ -116,6 +124,9 @@ protected:
 	void _updateMaterial(std::size_t n) noexcept;
 	void _updateMaterials() noexcept;
 
+	ModelQuantizeFlags _selectQuantize() const noexcept;
+	std::size_t _selectLevel(float screenRadius) const noexcept;
+
 private:
 	MeshRenderComponent(const MeshRenderComponent&) noexcept = delete;
 	MeshRenderComponent& operator=(const MeshRenderComponent&) noexcept = delete;
@@ -126,6 +137,14 @@ private:
 	bool _isCastShadow;
 	bool _isReceiveShadow;
 
+	ModelQuantizeFlags _quantize;
+
+	bool _isClusterCulling;
+
+	std::size_t _lodLevel;
+	float _lodRadius;
+	std::vector<float> _lodErrors;
+
 	Materials _materials;
 	Materials _sharedMaterials;
 
@@ -136,6 +155,8 @@ protected:
 
 	GraphicsDataPtr _renderMeshVbo;
 	GraphicsDataPtr _renderMeshIbo;
+
+	ModelQuantizeFlags _renderMeshQuantize;
 };
 
 _NAME_END
@@ -0,0 +1,85 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2016.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#ifndef _H_MODEL_ATLAS_H_
+#define _H_MODEL_ATLAS_H_
+
+#include <ray/modhelp.h>
+
+_NAME_BEGIN
+
+struct EXPORT MeshAtlasParams final
+{
+	MeshAtlasParams() noexcept;
+
+	std::uint32_t width;
+	std::uint32_t height;
+
+	// Texels kept free between two charts.
+	std::uint32_t margin;
+
+	// Fraction of area a triangle may lose to the planar projection of its chart, 0 allows flat charts only.
+	float maxStretch;
+
+	// The stretch is relaxed until the atlas has no more charts than this, 0 is unlimited.
+	std::uint32_t maxCharts;
+
+	// Called from the calling thread, returning false cancels.
+	std::function<bool(float progress)> progress;
+};
+
+struct EXPORT MeshAtlasStats final
+{
+	std::size_t numCharts;
+	std::size_t numVertices;
+
+	float texelsPerUnit;
+	float utilization;
+};
+
+// Segments the triangles of every subset into charts grown over shared edges within a normal cone, projects each chart
+// onto its plane and packs the charts into a width x height atlas. Subsets are segmented on separate threads.
+// Vertices are split along chart borders: remap gives the source vertex of every output vertex, indices and texcoords
+// are the rewritten index buffer and the atlas coordinates in [0, 1].
+EXPORT bool makeAtlasUV(const Float3Array& vertices, const UintArray& indices, const MeshSubsets& subsets, const MeshAtlasParams& params, UintArray& remap, UintArray& outIndices, Float2Array& texcoords, MeshAtlasStats* stats = nullptr) noexcept;
+
+// Same as above, stores the coordinates into the texcoord slot and splits every vertex stream of the mesh.
+// Mesh levels and clusters refer to the old vertices and are dropped, so this runs before makeMeshLevels and optimizeMesh.
+EXPORT bool makeAtlasUV(MeshProperty& mesh, std::uint8_t slot, const MeshAtlasParams& params, MeshAtlasStats* stats = nullptr) noexcept;
+
+_NAME_END
+
+#endif
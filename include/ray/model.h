@@ -37,7 +37,7 @@
 #ifndef _H_MODEL_H_
 #define _H_MODEL_H_
 
-#include <ray/modhelp.h>
+#include <ray/modopt.h>
 
 _NAME_BEGIN
 
@@ -229,6 +229,45 @@ struct EXPORT MeshSubset final
 
 typedef std::vector<MeshSubset> MeshSubsets;
 
+struct EXPORT MeshLevel final
+{
+	MeshLevel() noexcept
+		: error(0.0f)
+	{
+	}
+
+	float error;
+
+	UintArray indices;
+	MeshSubsets subsets;
+};
+
+typedef std::vector<MeshLevel> MeshLevels;
+
+struct EXPORT MeshCluster final
+{
+	MeshCluster() noexcept
+		: startIndices(0)
+		, indicesCount(0)
+		, center(float3::Zero)
+		, radius(0.0f)
+		, coneAxis(float3::UnitZ)
+		, coneCutoff(1.0f)
+	{
+	}
+
+	std::uint32_t startIndices;
+	std::uint32_t indicesCount;
+
+	float3 center;
+	float radius;
+
+	float3 coneAxis;
+	float coneCutoff;
+};
+
+typedef std::vector<MeshCluster> MeshClusters;
+
 class EXPORT MeshProperty final : public std::enable_shared_from_this<MeshProperty>
 {
 public:
@@ -247,6 +286,8 @@ public:
 	void setIndicesArray(const UintArray& array) noexcept;
 	void setBindposes(const Float4x4Array& array) noexcept;
 	void setMeshSubsets(const MeshSubsets& subsets) noexcept;
+	void setMeshLevels(const MeshLevels& levels) noexcept;
+	void setMeshClusters(const MeshClusters& clusters) noexcept;
 
 	void setVertexArray(Float3Array&& array) noexcept;
 	void setNormalArray(Float3Array&& array) noexcept;
@@ -257,6 +298,8 @@ public:
 	void setIndicesArray(UintArray&& array) noexcept;
 	void setBindposes(Float4x4Array&& array) noexcept;
 	void setMeshSubsets(MeshSubsets&& subsets) noexcept;
+	void setMeshLevels(MeshLevels&& levels) noexcept;
+	void setMeshClusters(MeshClusters&& clusters) noexcept;
 
 	Float3Array& getVertexArray() noexcept;
 	Float3Array& getNormalArray() noexcept;
@@ -267,6 +310,8 @@ public:
 	UintArray& getIndicesArray() noexcept;
 	Float4x4Array& getBindposes() noexcept;
 	MeshSubsets& getMeshSubsets() noexcept;
+	MeshLevels& getMeshLevels() noexcept;
+	MeshClusters& getMeshClusters() noexcept;
 
 	const Float3Array& getVertexArray() const noexcept;
 	const Float3Array& getNormalArray() const noexcept;
@@ -276,6 +321,8 @@ public:
 	const VertexWeights& getWeightArray() const noexcept;
 	const UintArray& getIndicesArray() const noexcept;
 	const MeshSubsets& getMeshSubsets() const noexcept;
+	const MeshLevels& getMeshLevels() const noexcept;
+	const MeshClusters& getMeshClusters() const noexcept;
 
 	const Bones& getBoneArray(const Bones& array) const noexcept;
 	const Float4x4Array& getBindposes() const noexcept;
@@ -332,6 +379,8 @@ private:
 	BoundingBox _boundingBox;
 
 	MeshSubsets _meshSubsets;
+	MeshLevels _meshLevels;
+	MeshClusters _meshClusters;
 };
 
 _NAME_END
@@ -0,0 +1,56 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2016.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#ifndef _H_MODEL_LOD_H_
+#define _H_MODEL_LOD_H_
+
+#include <ray/modhelp.h>
+
+_NAME_BEGIN
+
+// Quadric error edge collapse over the index buffer, vertices are never moved or created so every level shares the vertex buffer.
+// Vertices on attribute seams are locked and border vertices only slide along the border.
+// Error is the root mean square distance to the original planes, relative to the bounding sphere radius.
+// Returns the error reached; stops at ratio of the source triangles or before a collapse exceeds targetError.
+EXPORT float simplifyMesh(const MeshProperty& mesh, const UintArray& source, const MeshSubsets& sourceSubsets, float ratio, float targetError, UintArray& indices, MeshSubsets& subsets) noexcept;
+
+// Builds a chain of up to count levels into MeshProperty::getMeshLevels, each simplified from the previous one.
+// The chain ends early once a level can no longer drop a tenth of its triangles.
+EXPORT std::size_t makeMeshLevels(MeshProperty& mesh, std::size_t count, float ratio = 0.5f, float targetError = 0.1f) noexcept;
+
+_NAME_END
+
+#endif
@@ -0,0 +1,96 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2016.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#ifndef _H_MODEL_OPTIMIZE_H_
+#define _H_MODEL_OPTIMIZE_H_
+
+#include <ray/modhelp.h>
+
+_NAME_BEGIN
+
+enum MeshOptimizeFlagBits
+{
+	MeshOptimizeFlagBitWeldVertices = 0x00000001,
+	MeshOptimizeFlagBitVertexCache = 0x00000002,
+	MeshOptimizeFlagBitOverdraw = 0x00000004,
+	MeshOptimizeFlagBitVertexFetch = 0x00000008,
+	MeshOptimizeFlagBitALL = 0x0000000F,
+	MeshOptimizeFlagBitClusters = 0x00000010,
+};
+
+typedef std::uint32_t MeshOptimizeFlags;
+
+struct EXPORT MeshOptimizeStats final
+{
+	std::size_t numVerticesBefore;
+	std::size_t numVerticesAfter;
+
+	float acmrBefore;
+	float acmrAfter;
+	float atvrBefore;
+	float atvrAfter;
+};
+
+// Average cache miss ratio (misses per triangle) of a FIFO post-transform cache.
+EXPORT float computeACMR(const std::uint32_t* indices, std::size_t numIndices, std::size_t numVertices, std::uint32_t cacheSize = 16) noexcept;
+
+// Average transformed vertex ratio (misses per referenced vertex), 1.0 is optimal.
+EXPORT float computeATVR(const std::uint32_t* indices, std::size_t numIndices, std::size_t numVertices, std::uint32_t cacheSize = 16) noexcept;
+
+// Merges bitwise identical vertices across every attribute stream and rewrites the indices.
+EXPORT std::size_t weldVertices(MeshProperty& mesh) noexcept;
+
+// Reorders the triangles of every subset for the post-transform cache (Forsyth).
+EXPORT void optimizeVertexCache(MeshProperty& mesh) noexcept;
+EXPORT void optimizeVertexCache(std::uint32_t* indices, std::size_t numIndices, std::size_t numVertices) noexcept;
+
+// Splits every subset into clusters at cache flushes and sorts them front to back from the outside in.
+// A cluster split is only kept while its ACMR stays below threshold times the original.
+EXPORT void optimizeOverdraw(MeshProperty& mesh, float threshold = 1.05f) noexcept;
+
+// Renumbers vertices by first use in the index buffer and drops unreferenced ones.
+EXPORT std::size_t optimizeVertexFetch(MeshProperty& mesh) noexcept;
+
+// Regroups the triangles of every subset into clusters grown over shared vertices, each limited to maxVertices
+// unique vertices and maxTriangles triangles, and stores their bounding spheres and normal cones.
+// Reordering the triangles afterwards (cache or overdraw) drops the clusters, so this runs last.
+EXPORT std::size_t buildMeshClusters(MeshProperty& mesh, std::size_t maxVertices = 64, std::size_t maxTriangles = 124) noexcept;
+
+EXPORT void optimizeMesh(MeshProperty& mesh, MeshOptimizeFlags flags = MeshOptimizeFlagBitALL, MeshOptimizeStats* stats = nullptr) noexcept;
+
+_NAME_END
+
+#endif
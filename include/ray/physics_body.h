@@ -74,6 +74,9 @@ public:
 	void sleep(bool sleep) noexcept;
 	bool isSleep() const noexcept;
 
+	void enableCollisionStay(bool enable) noexcept;
+	bool isEnableCollisionStay() const noexcept;
+
 	void setLayer(std::uint8_t layer) noexcept;
 	void setLayerMask(std::uint16_t mask) noexcept;
 	std::uint8_t getLayer() const noexcept;
@@ -108,6 +111,8 @@ private:
 	friend class PhysicsScene;
 	btRigidBody* getRigidbody() noexcept;
 
+	void waitSimulation() const noexcept;
+
 private:
 	PhysicsBody(const PhysicsBody&) = delete;
 	PhysicsBody& operator=(const PhysicsBody&) = delete;
@@ -121,6 +126,9 @@ private:
 
 	bool _sleep;
 	bool _isKinematic;
+	bool _isEnableCollisionStay;
+
+	std::uint32_t _collisionStamp;
 
 	float _mass;
 
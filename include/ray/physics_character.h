@@ -66,6 +66,9 @@ public:
 
 	void setPhysicsScene(PhysicsScenePtr scene) noexcept;
 
+private:
+	void waitSimulation() const noexcept;
+
 private:
 
 	mutable Vector3 _translate;
@@ -38,6 +38,7 @@
 #define _H_PHYSIC_FEATURES_H_
 
 #include <ray/physics_forward.h>
+#include <ray/physics_scene.h>
 
 _NAME_BEGIN
 
@@ -46,19 +47,27 @@ class EXPORT PhysicFeatures final : public GameFeature
 	__DeclareSubClass(PhysicFeatures, GameFeature)
 public:
 	PhysicFeatures() noexcept;
+	PhysicFeatures(const PhysicsScene::Setting& setting) noexcept;
 	~PhysicFeatures() noexcept;
 
+	void setPhysicsSetting(const PhysicsScene::Setting& setting) noexcept;
+	const PhysicsScene::Setting& getPhysicsSetting() const noexcept;
+
 	GameFeaturePtr clone() const noexcept;
 
 private:
 	void onActivate() except;
 	void onDeactivate() noexcept;
 
+	void onFrameBegin() noexcept;
 	void onFrameEnd() noexcept;
 
 private:
 	PhysicFeatures(const PhysicFeatures&) = delete;
 	PhysicFeatures& operator=(const PhysicFeatures&) = delete;
+
+private:
+	PhysicsScene::Setting _setting;
 };
 
 _NAME_END
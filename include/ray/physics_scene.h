@@ -38,6 +38,7 @@
 #define _H_PHYSICS_SECENE_H_
 
 #include <ray/physics_body.h>
+#include <ray/thread.h>
 
 _NAME_BEGIN
 
@@ -54,6 +55,14 @@ public:
 
 		AABB aabb;
 
+		float fixedTimeStep;
+		std::uint32_t maxSubSteps;
+		std::uint32_t numThreads;
+
+		PhysicsBroadphaseType broadphase;
+
+		bool enableAsyncSimulation;
+
 		Setting() noexcept;
 	};
 
@@ -69,14 +78,22 @@ public:
 	void setSpeed(float speed) noexcept;
 	void setSkitWindow(float width) noexcept;
 	void setGravity(const Vector3& gravity) noexcept;
+	void setFixedTimeStep(float step) noexcept;
+	void setMaxSubSteps(std::uint32_t steps) noexcept;
 
 	float getLength() const noexcept;
 	float getMass() const noexcept;
 	float getSpeed() const noexcept;
 	float getSkitWindow() const noexcept;
 	const Vector3& getGravity() const noexcept;
+	float getFixedTimeStep() const noexcept;
+	std::uint32_t getMaxSubSteps() const noexcept;
+	std::uint32_t getNumThreads() const noexcept;
+	PhysicsBroadphaseType getBroadphaseType() const noexcept;
 
 	bool isFetchResult() const noexcept;
+	bool isSimulating() const noexcept;
+	bool isAsyncSimulation() const noexcept;
 
 	void addJoint(btTypedConstraint* joint) noexcept;
 	void removeJoint(btTypedConstraint* joint) noexcept;
@@ -91,20 +108,47 @@ public:
 	void removeAction(btActionInterface* action) noexcept;
 
 	void simulation(float delta) noexcept;
+	void fetchResult() noexcept;
+
+	void waitSimulation() noexcept;
+
+private:
+	friend class PhysicsBody;
+	void addCollisionListener(PhysicsBody* body) noexcept;
+	void removeCollisionListener(PhysicsBody* body) noexcept;
+
+	bool setPendingTransform(PhysicsBody* body, const float4x4& transform) noexcept;
+	void removePendingTransform(PhysicsBody* body) noexcept;
+
+	void dispatchCollisionStay() noexcept;
 
 private:
 
 	bool _isFetchResult;
+	bool _isSimulating;
+	bool _isFetchPending;
+
+	std::uint32_t _collisionStamp;
 
 	Setting _setting;
 
 	btBroadphaseInterface* _broadphase;
 	btCollisionDispatcher* _dispatcher;
 	btDefaultCollisionConfiguration* _collisionConfiguration;
-	btSequentialImpulseConstraintSolver* _solver;
+	btConstraintSolver* _solver;
 	btDiscreteDynamicsWorld* _dynamicsWorld;
 
+	btThreadSupportInterface* _threadSupportCollision;
+	btThreadSupportInterface* _threadSupportSolver;
+
 	std::vector<PhysicsBody*> _rigidbodys;
+	std::vector<PhysicsBody*> _collisionListeners;
+	std::vector<PhysicsBody*> _collisionStays;
+
+	std::mutex _pendingLock;
+	std::vector<std::pair<PhysicsBody*, float4x4>> _pendingTransforms;
+
+	std::unique_ptr<ThreadLambda> _simulationThread;
 };
 
 _NAME_END
@@ -49,6 +49,7 @@ public:
 	~PhysicsSystem() noexcept;
 
 	bool open() noexcept;
+	bool open(const PhysicsScene::Setting& setting) noexcept;
 	void close() noexcept;
 
 	bool isFetchResult() const noexcept;
@@ -56,6 +57,7 @@ public:
 	PhysicsScenePtr getPhysicsScene() noexcept;
 
 	void simulation(float delta) noexcept;
+	void fetchResult() noexcept;
 
 private:
 	PhysicsScenePtr _scene;
@@ -56,9 +56,20 @@ class btConvexShape;
 class btPairCachingGhostObject;
 class btCollisionShape;
 class btGeneric6DofSpringConstraint;
+class btConstraintSolver;
+class btThreadSupportInterface;
 
 _NAME_BEGIN
 
+enum class PhysicsBroadphaseType : std::uint8_t
+{
+	PhysicsBroadphaseTypeAxisSweep3 = 0,
+	PhysicsBroadphaseTypeDbvt = 1,
+	PhysicsBroadphaseTypeBeginRange = PhysicsBroadphaseTypeAxisSweep3,
+	PhysicsBroadphaseTypeEndRange = PhysicsBroadphaseTypeDbvt,
+	PhysicsBroadphaseTypeRangeSize = (PhysicsBroadphaseTypeEndRange - PhysicsBroadphaseTypeBeginRange + 1),
+};
+
 typedef std::shared_ptr<class PhysicsShape> PhysicsShapePtr;
 typedef std::shared_ptr<class PhysicsScene> PhysicsScenePtr;
 typedef std::shared_ptr<class PhysicsSystem> PhysicsSystemPtr;
@@ -0,0 +1,181 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#ifndef _H_PROFILER_H_
+#define _H_PROFILER_H_
+
+#include <ray/timer.h>
+#include <ray/macro.h>
+#include <atomic>
+#include <mutex>
+
+_NAME_BEGIN
+
+// Collects named CPU/GPU time ranges from any thread and writes them as a Chrome trace (chrome://tracing).
+// Names must outlive the profiler, string literals or Rtti type names are expected.
+class EXPORT Profiler final
+{
+	__DeclareSingleton(Profiler)
+public:
+	struct Event
+	{
+		const char* name;
+		std::uint64_t begin;
+		std::uint64_t end;
+	};
+
+	struct Statistic
+	{
+		std::string path;
+		std::size_t count;
+		std::uint64_t total;
+		std::uint64_t max;
+	};
+
+public:
+	Profiler() noexcept;
+	~Profiler() noexcept;
+
+	void setEnable(bool enable) noexcept;
+
+	static bool getEnable() noexcept
+	{
+		return _isEnabled.load(std::memory_order_relaxed);
+	}
+
+	void setThreadName(const char* name) noexcept;
+
+	void addEvent(const char* name, std::uint64_t begin, std::uint64_t end) noexcept;
+	void addGpuEvent(const char* name, std::uint64_t begin, std::uint64_t end) noexcept;
+
+	std::size_t getEventCount() const noexcept;
+
+	// Aggregates events by their nesting path on each thread, e.g. "GameServer::update/GameServer::onFrame".
+	void getStatistics(std::vector<Statistic>& statistics) const noexcept;
+
+	void clear() noexcept;
+
+	bool save(const std::string& path) const noexcept;
+
+private:
+	struct ThreadEvents
+	{
+		std::mutex lock;
+		std::uint32_t track;
+		std::string name;
+		std::vector<Event> events;
+	};
+
+	ThreadEvents* getThreadEvents() noexcept;
+
+private:
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+
+private:
+	static std::atomic<bool> _isEnabled;
+
+	std::uint64_t _startTime;
+
+	mutable std::mutex _mutex;
+	std::vector<std::unique_ptr<ThreadEvents>> _threads;
+	mutable ThreadEvents _gpuEvents;
+};
+
+class ProfileScope final
+{
+public:
+	ProfileScope(const char* name) noexcept
+		: _name(Profiler::getEnable() ? name : nullptr)
+		, _begin(_name ? Timer::clock() : 0)
+	{
+	}
+
+	~ProfileScope() noexcept
+	{
+		if (_name)
+			Profiler::instance()->addEvent(_name, _begin, Timer::clock());
+	}
+
+private:
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	const char* _name;
+	std::uint64_t _begin;
+};
+
+// Wraps any object exposing beginProfile/endProfile, such as GraphicsContext or RenderPipeline,
+// the backend resolves its timestamp queries a few frames later and reports them through addGpuEvent.
+template<typename T>
+class ProfileGpuScope final
+{
+public:
+	ProfileGpuScope(T& context, const char* name) noexcept
+		: _context(Profiler::getEnable() ? &context : nullptr)
+	{
+		if (_context)
+			_context->beginProfile(name);
+	}
+
+	~ProfileGpuScope() noexcept
+	{
+		if (_context)
+			_context->endProfile();
+	}
+
+private:
+	ProfileGpuScope(const ProfileGpuScope&) = delete;
+	ProfileGpuScope& operator=(const ProfileGpuScope&) = delete;
+
+private:
+	T* _context;
+};
+
+#define __ProfileScopeName(line) JOIN(_profileScope, line)
+
+#if defined(_BUILD_PROFILER)
+#	define __ProfileScope(name) ProfileScope __ProfileScopeName(__LINE__)(name)
+#	define __ProfileGpuScope(context, name) ProfileGpuScope<typename std::remove_reference<decltype(context)>::type> __ProfileScopeName(__LINE__)(context, name)
+#else
+#	define __ProfileScope(name)
+#	define __ProfileGpuScope(context, name)
+#endif
+
+_NAME_END
+
+#endif
@@ -69,7 +69,11 @@
 RAY_C_LINKAGE RAY_EXPORT void RAY_CALL rayInit(const char* gamedir, const char* scenename) noexcept;
 RAY_C_LINKAGE RAY_EXPORT void RAY_CALL rayTerminate() noexcept;
 
+RAY_C_LINKAGE RAY_EXPORT void RAY_CALL rayRecord(const char* path) noexcept;
+RAY_C_LINKAGE RAY_EXPORT void RAY_CALL rayReplay(const char* path) noexcept;
+
 RAY_C_LINKAGE RAY_EXPORT bool RAY_CALL rayOpenWindow(const char* title, int w, int h) noexcept;
+RAY_C_LINKAGE RAY_EXPORT bool RAY_CALL rayOpenHeadless() noexcept;
 RAY_C_LINKAGE RAY_EXPORT void RAY_CALL rayCloseWindow() noexcept;
 
 RAY_C_LINKAGE RAY_EXPORT bool RAY_CALL rayIsQuitRequest() noexcept;
@@ -49,6 +49,8 @@ public:
 
 	virtual void onRenderObjectPre(const Camera& camera) noexcept = 0;
 	virtual void onRenderObjectPost(const Camera& camera) noexcept = 0;
+
+	virtual void onRenderObjectVisiable(RenderObject& object, const Camera& camera, float distanceSqrt) noexcept;
 };
 
 class EXPORT RenderObject : public rtti::Interface
@@ -92,6 +94,7 @@ public:
 	virtual void onSceneChangeAfter() noexcept;
 
 	virtual bool onVisiableTest(const Camera& camera, const Frustum& fru) noexcept;
+	virtual void onVisiableDistance(const Camera& camera, float distanceSqrt) noexcept;
 	virtual void onAddRenderData(RenderDataManager& manager) noexcept;
 
 	virtual void onRenderBefore(const Camera& camera) noexcept;
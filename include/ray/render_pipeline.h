@@ -96,6 +96,7 @@ public:
 
 	void drawLayer(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t startVertice, std::uint32_t startInstances, std::uint32_t layer) noexcept;
 	void drawIndexedLayer(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t startIndice, std::uint32_t startVertice, std::uint32_t startInstances, std::uint32_t layer) noexcept;
+	void drawIndexedIndirectLayer(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride, std::uint32_t layer) noexcept;
 
 	void drawRenderQueue(RenderQueue queue) noexcept;
 	void drawRenderQueue(RenderQueue queue, const MaterialTechPtr& tech) noexcept;
@@ -107,6 +108,9 @@ public:
 
 	void present() noexcept;
 
+	void beginProfile(const char* name) noexcept;
+	void endProfile() noexcept;
+
 	bool isTextureSupport(GraphicsFormat format) noexcept;
 	bool isTextureDimSupport(GraphicsTextureDim dimension) noexcept;
 	bool isVertexSupport(GraphicsFormat format) noexcept;
@@ -114,6 +118,7 @@ public:
 
 	void setTransform(const float4x4& transform) noexcept;
 	void setTransformInverse(const float4x4& transform) noexcept;
+	void setQuantize(const float3& positionScale, const float3& positionBias, const float4& texcoordScaleBias) noexcept;
 
 	const MaterialSemanticPtr& getSemanticParam(GlobalSemanticType type) const noexcept;
 
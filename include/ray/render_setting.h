@@ -70,6 +70,10 @@ struct EXPORT RenderSetting
 	bool enableColorGrading;
 	bool enableGlobalIllumination;
 
+	std::uint32_t lightProbeFaceBudget;
+
+	float lodBias;
+
 	float2 earthRadius;
 	float2 earthScaleHeight;
 
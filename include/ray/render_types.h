@@ -261,6 +261,9 @@ enum GlobalSemanticType
 	GlobalSemanticTypeModelView,
 	GlobalSemanticTypeModelViewProject,
 	GlobalSemanticTypeModelViewInverse,
+	GlobalSemanticTypeQuantizePositionScale,
+	GlobalSemanticTypeQuantizePositionBias,
+	GlobalSemanticTypeQuantizeTexcoord,
 	GlobalSemanticTypeCameraAperture,
 	GlobalSemanticTypeCameraNear,
 	GlobalSemanticTypeCameraFar,
@@ -40,7 +40,8 @@
 #include <ray/res_loader.h>
 #include <ray/render_types.h>
 #include <ray/game_types.h>
-#include <ray/modhelp.h>
+#include <ray/modopt.h>
+#include <ray/modlod.h>
 
 _NAME_BEGIN
 
@@ -59,6 +60,22 @@ enum ModelMakerFlagBits
 
 typedef std::uint32_t ModelMakerFlags;
 
+enum ModelQuantizeFlagBits
+{
+	ModelQuantizeFlagBitPositionHalf = 0x00000001,
+	ModelQuantizeFlagBitPositionUNorm16 = 0x00000002,
+	ModelQuantizeFlagBitColorUNorm8 = 0x00000004,
+	ModelQuantizeFlagBitTexcoordHalf = 0x00000008,
+	ModelQuantizeFlagBitTexcoordUNorm16 = 0x00000010,
+	ModelQuantizeFlagBitPosition = ModelQuantizeFlagBitPositionHalf | ModelQuantizeFlagBitPositionUNorm16,
+	ModelQuantizeFlagBitColor = ModelQuantizeFlagBitColorUNorm8,
+	ModelQuantizeFlagBitTexcoord = ModelQuantizeFlagBitTexcoordHalf | ModelQuantizeFlagBitTexcoordUNorm16,
+	ModelQuantizeFlagBitHalf = ModelQuantizeFlagBitPositionHalf | ModelQuantizeFlagBitColorUNorm8 | ModelQuantizeFlagBitTexcoordHalf,
+	ModelQuantizeFlagBitUNorm16 = ModelQuantizeFlagBitPositionUNorm16 | ModelQuantizeFlagBitColorUNorm8 | ModelQuantizeFlagBitTexcoordUNorm16,
+};
+
+typedef std::uint32_t ModelQuantizeFlags;
+
 class EXPORT ResManager final
 {
 	__DeclareSingleton(ResManager)
@@ -66,7 +83,7 @@ public:
 	ResManager() noexcept;
 	~ResManager() noexcept;
 
-	bool createModel(const util::string& path, ModelPtr& model) noexcept;
+	bool createModel(const util::string& path, ModelPtr& model, MeshOptimizeFlags optimize = 0, std::size_t levels = 0) noexcept;
 	bool createMaterial(const util::string& path, MaterialPtr& material) noexcept;
 	bool createTexture(const util::string& path, GraphicsTexturePtr& texture, GraphicsTextureDim dim = GraphicsTextureDim::GraphicsTextureDim2D, GraphicsSamplerFilter filter = GraphicsSamplerFilter::GraphicsSamplerFilterLinear, GraphicsSamplerWrap warp = GraphicsSamplerWrap::GraphicsSamplerWrapRepeat, bool cache = true) noexcept;
 	bool createAnimation(const util::string& path, const GameObjects& bones, GameComponentPtr& animation) noexcept;
@@ -79,8 +96,12 @@ public:
 	bool createRigidbodyToBone(const Model& model, const GameObjects& bones, GameObjects& rigidbodys);
 	bool createJoints(const Model& model, const GameObjects& rigidbodys, GameObjects& joints) noexcept;
 
-	GraphicsDataPtr createVertexBuffer(const MeshProperty& mesh, ModelMakerFlags flags) noexcept;
+	GraphicsDataPtr createVertexBuffer(const MeshProperty& mesh, ModelMakerFlags flags, ModelQuantizeFlags quantize = 0) noexcept;
 	GraphicsDataPtr createIndexBuffer(const MeshProperty& mesh) noexcept;
+	GraphicsIndexType getIndexType(const MeshProperty& mesh) const noexcept;
+	std::size_t getLevelStartIndice(const MeshProperty& mesh, std::size_t level) const noexcept;
+	void getQuantizeRange(const MeshProperty& mesh, ModelQuantizeFlags quantize, float3& positionScale, float3& positionBias, float4& texcoordScaleBias) const noexcept;
+	ModelQuantizeFlags getQuantizeFlags(const GraphicsInputLayoutDesc& inputLayout, ModelQuantizeFlags& mask) const noexcept;
 
 	GraphicsTexturePtr getTexture(const util::string& name) const noexcept;
 	const GraphicsTextures& getTextureAll() const noexcept;
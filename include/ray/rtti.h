@@ -47,6 +47,7 @@ namespace rtti
 
 	class EXPORT Rtti
 	{
+		friend class Factory;
 	public:
 		typedef Interface*(*RttiConstruct)();
 	public:
@@ -63,10 +64,16 @@ namespace rtti
 		bool isDerivedFrom(const Rtti& other) const;
 		bool isDerivedFrom(const std::string& name) const;
 
+	private:
+		bool isDerivedFromParent(const Rtti* other) const noexcept;
+
 	private:
 		std::string _name;
 		const Rtti* _parent;
 		RttiConstruct _construct;
+
+		// Registration slot in the factory, indexes the pre-order intervals of the factory's published snapshot.
+		std::uint32_t _index;
 	};
 
 	class EXPORT Interface : public std::enable_shared_from_this<Interface>
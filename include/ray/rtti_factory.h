@@ -38,6 +38,9 @@
 #define _H_RTTI_FACTORY_H_
 
 #include <ray/rtti.h>
+#include <unordered_map>
+#include <atomic>
+#include <mutex>
 
 _NAME_BEGIN
 
@@ -46,6 +49,7 @@ namespace rtti
 	class EXPORT Factory final
 	{
 		__DeclareSingleton(Factory)
+		friend class Rtti;
 	public:
 		Factory() noexcept;
 		~Factory() noexcept;
@@ -88,8 +92,38 @@ namespace rtti
 		}
 
 	private:
+		// Pre-order interval of a type, a type derives from other when its begin lies in other's interval.
+		struct Interval
+		{
+			std::uint32_t begin;
+			std::uint32_t end;
+		};
+
+		// Built by open and rebuilt by every later add, then published as a whole,
+		// so Rtti::isDerivedFrom on another thread never sees a half numbered tree.
+		struct Snapshot
+		{
+			std::unordered_map<std::string, Rtti*> names;
+			std::vector<Interval> intervals;
+		};
+
+		void buildSnapshot() noexcept;
+
+		static const Snapshot* getSnapshot() noexcept
+		{
+			return _snapshot.load(std::memory_order_acquire);
+		}
+
+	private:
+		bool _isOpened;
+
+		std::mutex _mutex;
 		std::vector<Rtti*> _rttis;
-		std::map<std::string, Rtti*> _rtti_lists;
+
+		// Constant initialized, so it is valid before the factory is first used. Replaced snapshots stay alive,
+		// a reader may still be looking at one.
+		static std::atomic<const Snapshot*> _snapshot;
+		std::vector<std::unique_ptr<Snapshot>> _snapshots;
 	};
 
 	template<typename T>
@@ -58,6 +58,7 @@ public:
 	void setPitch(float pitch) noexcept;
 	void setMaxDistance(float maxdis) noexcept;
 	void setMinDistance(float mindis) noexcept;
+	void setPriority(std::uint8_t priority) noexcept;
 
 	float getVolume() const noexcept;
 	float getMinVolume() const noexcept;
@@ -65,6 +66,7 @@ public:
 	float getPitch() const noexcept;
 	float getMaxDistance() const noexcept;
 	float getMinDistance() const noexcept;
+	std::uint8_t getPriority() const noexcept;
 
 	void setSoundClip(const SoundClip& clip) noexcept;
 	void getSoundClip(SoundClip& clip) const noexcept;
@@ -114,6 +116,8 @@ private:
 
 	float _pitch;
 
+	std::uint8_t _priority;
+
 	bool _isPlayOnActivate;
 	bool _isPause;
 	bool _isLoop;
@@ -55,8 +55,13 @@ public:
 	virtual void setDistanceModel(bool enable) noexcept = 0;
 	virtual bool getDistanceModel() const noexcept = 0;
 
+	virtual void setMaxVoices(std::uint32_t count) noexcept = 0;
+	virtual std::uint32_t getMaxVoices() const noexcept = 0;
+
 	virtual SoundSourcePtr createSoundSource() = 0;
 	virtual SoundListenerPtr createSoundListener() noexcept = 0;
+
+	virtual void update(float delta) noexcept = 0;
 };
 
 _NAME_END
@@ -52,6 +52,8 @@ private:
 	virtual void onActivate() except;
 	virtual void onDeactivate() noexcept;
 
+	virtual void onFrameEnd() noexcept;
+
 private:
 	SoundFeature(const SoundFeature&) noexcept = delete;
 	SoundFeature& operator=(const SoundFeature&) noexcept = delete;
@@ -73,6 +73,7 @@ public:
 	virtual void setPitch(float pitch) noexcept = 0;
 	virtual void setMaxDistance(float maxdis) noexcept = 0;
 	virtual void setMinDistance(float mindis) noexcept = 0;
+	virtual void setPriority(std::uint8_t priority) noexcept = 0;
 	virtual void setSoundClip(const SoundClip& clip) noexcept = 0;
 
 	virtual void getTranslate(float3& translate) noexcept = 0;
@@ -86,6 +87,7 @@ public:
 	virtual float getPitch() const noexcept = 0;
 	virtual float getMaxDistance() const noexcept = 0;
 	virtual float getMinDistance() const noexcept = 0;
+	virtual std::uint8_t getPriority() const noexcept = 0;
 
 	virtual void play(bool play) noexcept = 0;
 	virtual void loop(bool loop) noexcept = 0;
@@ -56,6 +56,9 @@ public:
 	void setDistanceModel(bool enable) noexcept;
 	bool getDistanceModel() const noexcept;
 
+	void setMaxVoices(std::uint32_t count) noexcept;
+	std::uint32_t getMaxVoices() const noexcept;
+
 	SoundSourcePtr createSoundSource() except;
 	SoundSourcePtr createSoundSource(const std::string& filename, SoundFile::Type type = SoundFile::Unknown) except;
 	SoundReaderPtr createSoundReader(const std::string& filename, SoundFile::Type type = SoundFile::Unknown) noexcept;
@@ -63,6 +66,8 @@ public:
 
 	SoundListenerPtr createSoundListener() noexcept;
 
+	void update(float delta) noexcept;
+
 	bool emptyHandler() const noexcept;
 	bool add(SoundReaderPtr handler) noexcept;
 	bool remove(SoundReaderPtr handler) noexcept;
@@ -46,6 +46,9 @@ _NAME_BEGIN
 typedef int SOUND_FORMAT_TYPE;
 typedef int SoundFrequency;
 
+// Sounds that decode to at most this many bytes are decoded once into a shared buffer, longer ones are streamed.
+constexpr std::size_t SoundStaticBufferSize = 1 << 20;
+
 enum class SoundFormat : SOUND_FORMAT_TYPE
 {
 	None,
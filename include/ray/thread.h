@@ -44,6 +44,7 @@
 #include <atomic>
 #include <queue>
 #include <condition_variable>
+#include <functional>
 
 _NAME_BEGIN
 
@@ -94,6 +95,57 @@ private:
 	std::vector<std::function<void(void)>> _taskDispose;
 };
 
+// Runs a batch of indexed tasks across a fixed set of worker threads, the calling thread
+// takes part in the batch and parallelFor returns once every task has finished.
+// The two argument form also passes the index of the running thread, the calling thread
+// is 0 and workers are 1 to getNumThreads() - 1, for indexing per thread scratch data.
+// Batches from different threads run one after another, a parallelFor issued from inside
+// a task of the same pool runs inline on the calling thread.
+class EXPORT ThreadPool final
+{
+	__DeclareSingleton(ThreadPool)
+public:
+	ThreadPool() noexcept;
+	~ThreadPool() noexcept;
+
+	void start(std::uint32_t numThreads) noexcept;
+	void stop() noexcept;
+
+	std::uint32_t getNumThreads() const noexcept;
+
+	void parallelFor(std::size_t count, const std::function<void(std::size_t)>& func) except;
+	void parallelFor(std::size_t count, const std::function<void(std::size_t, std::uint32_t)>& func) except;
+
+private:
+	void execute(const std::function<void(std::size_t, std::uint32_t)>& func, std::size_t count, std::uint32_t thread) noexcept;
+
+	void dispose(std::uint64_t generation, std::uint32_t thread) noexcept;
+
+private:
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+private:
+	std::mutex _batchMutex;
+
+	std::mutex _mutex;
+	std::condition_variable _taskRequest;
+	std::condition_variable _finishRequest;
+
+	bool _isQuitRequest;
+
+	std::uint64_t _generation;
+	std::size_t _numTasks;
+	std::size_t _numBusyThreads;
+	std::atomic<std::size_t> _nextTask;
+
+	const std::function<void(std::size_t, std::uint32_t)>* _task;
+
+	std::exception_ptr _exception;
+
+	std::vector<std::thread> _threads;
+};
+
 _NAME_END
 
 #endif
\ No newline at end of file
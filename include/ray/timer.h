@@ -55,6 +55,8 @@ public:
 	float elapsed_max() const noexcept;
 	float elapsed_min() const noexcept;
 
+	static std::uint64_t clock() noexcept;
+
 	float fps() const noexcept;
 	float averageFps() const noexcept;
 	float appTime() const noexcept;
@@ -67,6 +69,7 @@ public:
 	void sleep(float fps) const noexcept;
 
 	void update() noexcept;
+	void update(float delta) noexcept;
 
 private:
 	Timer(const Timer&) = delete;
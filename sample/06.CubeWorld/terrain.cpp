@@ -354,7 +354,7 @@ TerrainComponent::deleteChunks() noexcept
 		auto y = chunked(translate.y);
 		auto z = chunked(translate.z);
 
-		if ((*it)->distance(x, y, z) > _deleteRadius)
+		if ((*it)->distance(x, y, z) > (std::size_t)_deleteRadius)
 		{
 			_chunks.erase(it);
 			break;
@@ -376,11 +376,7 @@ TerrainComponent::createChunks() noexcept
 	ray::Frustum fru;
 	fru.extract(this->getComponent<ray::CameraComponent>()->getViewProject());
 
-	std::int32_t bestX = 0;
-	std::int32_t bestY = 0;
-	std::int32_t bestZ = 0;
-	std::int32_t start = std::numeric_limits<std::int32_t>::max();
-	std::int32_t bestScore = start;
+	std::vector<std::pair<std::int32_t, ray::int2>> candidates;
 
 	for (std::int32_t iq = -_createRadius; iq <= _createRadius; iq++)
 	{
@@ -390,36 +386,92 @@ TerrainComponent::createChunks() noexcept
 			std::int32_t dy = y;
 			std::int32_t dz = z + ip;
 
-			auto chunk = this->getChunkByChunkPos(dx, dy, dz);
-			if (chunk && !chunk->dirt())
+			if (this->getChunkByChunkPos(dx, dy, dz) || this->isBuilding(dx, dy, dz))
 				continue;
 
 			std::int32_t invisiable = !this->visiable(fru, dx, dy, dz);
 			std::int32_t distance = std::max(std::abs(iq), std::abs(ip));
 			std::int32_t score = (invisiable << 24) | distance;
-			if (score < bestScore)
-			{
-				bestScore = score;
-				bestX = dx;
-				bestZ = dz;
-			}
+
+			candidates.emplace_back(score, ray::int2(dx, dz));
 		}
 	}
 
-	if (start == bestScore)
+	if (candidates.empty())
 		return;
 
-	auto chunk = this->getChunkByChunkPos(bestX, bestY, bestZ);
-	if (!chunk)
+	std::sort(candidates.begin(), candidates.end(), [](const std::pair<std::int32_t, ray::int2>& a, const std::pair<std::int32_t, ray::int2>& b) { return a.first < b.first; });
+
+	auto candidate = candidates.begin();
+
+	for (auto& ctx : _threads)
+	{
+		if (candidate == candidates.end())
+			break;
+
+		if (ctx->state != TerrainThread::IDLE)
+			continue;
+
+		ctx->x = candidate->second.x;
+		ctx->y = y;
+		ctx->z = candidate->second.y;
+		ctx->size = _size;
+		ctx->chunk = std::make_shared<TerrainChunk>(*this);
+		ctx->chunk->create(ctx->x, ctx->y, ctx->z, ctx->size);
+
+		ctx->mutex.lock();
+		ctx->state = TerrainThread::BUSY;
+		ctx->mutex.unlock();
+		ctx->dispose.notify_one();
+
+		++candidate;
+	}
+}
+
+void
+TerrainComponent::checkChunks() noexcept
+{
+	auto translate = this->getGameObject()->getTranslate();
+
+	auto x = chunked(translate.x);
+	auto y = chunked(translate.y);
+	auto z = chunked(translate.z);
+
+	for (auto& ctx : _threads)
 	{
-		chunk = std::make_shared<TerrainChunk>(*this);
-		chunk->create(bestX, bestY, bestZ, _size);
+		if (ctx->state != TerrainThread::DONE)
+			continue;
+
+		auto chunk = ctx->chunk;
+
+		ctx->chunk = nullptr;
+		ctx->state = TerrainThread::IDLE;
+
+		if (chunk->distance(x, y, z) > (std::size_t)_deleteRadius)
+			continue;
+
+		chunk->createObjects();
 		chunk->setActive(true);
 
 		_chunks.push_back(chunk);
 	}
 }
 
+bool
+TerrainComponent::isBuilding(std::int32_t x, std::int32_t y, std::int32_t z) const noexcept
+{
+	for (auto& ctx : _threads)
+	{
+		if (ctx->state == TerrainThread::IDLE)
+			continue;
+
+		if (ctx->x == x && ctx->y == y && ctx->z == z)
+			return true;
+	}
+
+	return false;
+}
+
 void
 TerrainComponent::hitChunks() noexcept
 {
@@ -447,26 +499,59 @@ TerrainComponent::hitChunks() noexcept
 	}
 }
 
+void
+TerrainComponent::startThreads() noexcept
+{
+	std::size_t numThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 2) - 1;
+
+	for (std::size_t i = 0; i < numThreads; i++)
+	{
+		auto ctx = std::make_shared<TerrainThread>();
+		ctx->_thread = std::make_unique<std::thread>(std::bind(&TerrainComponent::dispose, this, ctx));
+
+		_threads.push_back(ctx);
+	}
+}
+
+void
+TerrainComponent::stopThreads() noexcept
+{
+	for (auto& ctx : _threads)
+	{
+		ctx->mutex.lock();
+		ctx->isQuitRequest = true;
+		ctx->mutex.unlock();
+		ctx->dispose.notify_one();
+	}
+
+	for (auto& ctx : _threads)
+	{
+		if (ctx->_thread)
+			ctx->_thread->join();
+	}
+
+	_threads.clear();
+}
+
 void
 TerrainComponent::dispose(std::shared_ptr<TerrainThread> ctx) noexcept
 {
-	while (!ctx->isQuitRequest)
+	for (;;)
 	{
-		if (ctx->state != TerrainThread::BUSY)
-		{
-			ctx->mutex.lock();
-			ctx->dispose.wait(ctx->mutex);
-			ctx->mutex.unlock();
-			continue;
-		}
+		ctx->mutex.lock();
+		ctx->dispose.wait(ctx->mutex, [&]() { return ctx->isQuitRequest || ctx->state == TerrainThread::BUSY; });
+		ctx->mutex.unlock();
+
+		if (ctx->isQuitRequest)
+			break;
 
 		if (ctx->chunk)
-		{
-			ctx->chunk->create(ctx->size, ctx->x, ctx->y, ctx->z);
-		}
+			ctx->chunk->build();
 
 		ctx->state = TerrainThread::DONE;
 	}
+
+	ctx->state = TerrainThread::QUIT;
 }
 
 ray::GameComponentPtr
@@ -495,18 +580,24 @@ TerrainComponent::onActivate() except
 		{
 			auto chunk = std::make_shared<TerrainChunk>(*this);
 			chunk->create(i, 0, j, _size);
+			chunk->build();
+			chunk->createObjects();
 			chunk->setActive(true);
 
 			_chunks.push_back(chunk);
 		}
 	}
 
+	this->startThreads();
+
 	this->addComponentDispatch(ray::GameDispatchType::GameDispatchTypeFrameEnd, this);
 }
 
 void
 TerrainComponent::onDeactivate() noexcept
 {
+	this->stopThreads();
+
 	_chunks.clear();
 	_itmes.clear();
 
@@ -517,6 +608,7 @@ void
 TerrainComponent::onFrameEnd() except
 {
 	this->deleteChunks();
+	this->checkChunks();
 	this->createChunks();
 	this->hitChunks();
 }
\ No newline at end of file
@@ -49,7 +49,7 @@ public:
 	{
 	}
 
-	bool isQuitRequest;
+	std::atomic<bool> isQuitRequest;
 
 	std::int32_t x;
 	std::int32_t y;
@@ -114,6 +114,11 @@ private:
 	void checkChunks() noexcept;
 	void hitChunks() noexcept;
 
+	bool isBuilding(std::int32_t x, std::int32_t y, std::int32_t z) const noexcept;
+
+	void startThreads() noexcept;
+	void stopThreads() noexcept;
+
 	void dispose(std::shared_ptr<TerrainThread> ctx) noexcept;
 
 	void onActivate() except;
@@ -140,6 +145,8 @@ private:
 	std::vector<TerrainItemPtr> _itmes;
 	std::vector<TerrainObjectPtr> _objects;
 	std::vector<TerrainChunkPtr> _chunks;
+
+	std::vector<std::shared_ptr<TerrainThread>> _threads;
 };
 
 #endif
\ No newline at end of file
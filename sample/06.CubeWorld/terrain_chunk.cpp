@@ -57,22 +57,28 @@ TerrainChunk::create(std::int32_t x, std::int32_t y, std::int32_t z, std::size_t
 	_z = z;
 	_size = size;
 	_map = std::make_shared<TerrainMap>();
-	_map->create(0x7FFF);
+	_map->create(size, std::numeric_limits<BlockPosition>::max() + 1);
 
-	auto objects = _terrain.getObjects();
+	auto& objects = _terrain.getObjects();
 	for (auto& it : objects)
-	{
-		auto object = it->clone();
-		if (object->create(*this))
-		{
-			_objects.push_back(object);
-		}
-	}
+		_objects.push_back(it->clone());
+}
 
+void
+TerrainChunk::build() noexcept
+{
+	for (auto& it : _objects)
+		it->create(*this);
+
+	for (auto& it : _objects)
+		it->createMesh(*this);
+}
+
+void
+TerrainChunk::createObjects() noexcept
+{
 	for (auto& it : _objects)
-	{
 		it->createObject(*this);
-	}
 }
 
 std::size_t
@@ -95,31 +101,34 @@ TerrainChunk::getPosition(std::int32_t& x, std::int32_t& y, std::int32_t& z) noe
 bool
 TerrainChunk::set(const TerrainData& data) noexcept
 {
-	assert(data.x >= 0 || data.x < _size);
-	assert(data.y >= 0 || data.y < _size);
-	assert(data.z >= 0 || data.z < _size);
+	assert(data.x >= 0 && data.x < _size);
+	assert(data.y >= 0 && data.y < _map->height());
+	assert(data.z >= 0 && data.z < _size);
 	return _map->set(data);
 }
 
 bool
 TerrainChunk::get(TerrainData& data) const noexcept
 {
-	if (data.x < 0 || data.x >= _size) return 0;
-	if (data.y < 0 || data.y >= _size) return 0;
-	if (data.z < 0 || data.z >= _size) return 0;
 	return _map->get(data);
 }
 
+InstanceID
+TerrainChunk::get(std::int32_t x, std::int32_t y, std::int32_t z) const noexcept
+{
+	return _map->get(x, y, z);
+}
+
 std::size_t
 TerrainChunk::size() const noexcept
 {
 	return _size;
 }
 
-const TerrainDatas&
-TerrainChunk::data() const noexcept
+std::size_t
+TerrainChunk::height() const noexcept
 {
-	return _map->data();
+	return _map->height();
 }
 
 void
@@ -46,6 +46,8 @@ public:
 	~TerrainChunk() noexcept;
 
 	void create(std::int32_t x, std::int32_t y, std::int32_t z, std::size_t size) noexcept;
+	void build() noexcept;
+	void createObjects() noexcept;
 
 	void setActive(bool active) noexcept;
 	bool getActive() const noexcept;
@@ -54,6 +56,7 @@ public:
 	bool dirt() const noexcept;
 
 	std::size_t size() const noexcept;
+	std::size_t height() const noexcept;
 	std::size_t distance(std::int32_t x, std::int32_t y, std::int32_t z) noexcept;
 
 	void getPosition(std::int32_t& x, std::int32_t& y, std::int32_t& z) noexcept;
@@ -61,7 +64,7 @@ public:
 	bool set(const TerrainData& data) noexcept;
 	bool get(TerrainData& data) const noexcept;
 
-	const TerrainDatas& data() const noexcept;
+	InstanceID get(std::int32_t x, std::int32_t y, std::int32_t z) const noexcept;
 
 	void update() noexcept;
 
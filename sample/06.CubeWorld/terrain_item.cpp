@@ -65,137 +65,132 @@ TerrainObject::getItems() noexcept
 	return items;
 }
 
-bool
-TerrainObject::visiable(const TerrainChunk& chunk, const TerrainData& it, VisiableFaces& faces) noexcept
-{
-	TerrainData d1(it.x - 1, it.y, it.z);
-	TerrainData d2(it.x + 1, it.y, it.z);
-	TerrainData d3(it.x, it.y - 1, it.z);
-	TerrainData d4(it.x, it.y + 1, it.z);
-	TerrainData d5(it.x, it.y, it.z - 1);
-	TerrainData d6(it.x, it.y, it.z + 1);
-
-	bool f1 = false;
-	bool f2 = false;
-	bool f3 = false;
-	bool f4 = false;
-	bool f5 = false;
-	bool f6 = false;
-
-	if (it.x >= 0) f1 = chunk.get(d1);
-	if (it.y >= 0) f3 = chunk.get(d3);
-	if (it.z >= 0) f5 = chunk.get(d5);
-	if (it.x < chunk.size()) f2 = chunk.get(d2);
-	if (it.y < chunk.size()) f4 = chunk.get(d4);
-	if (it.z < chunk.size()) f6 = chunk.get(d6);
-
-	f1 = (d1.instanceID != it.instanceID) ? true : false;
-	f2 = (d2.instanceID != it.instanceID) ? true : false;
-	f3 = (d3.instanceID != it.instanceID) ? true : false;
-	f4 = (d4.instanceID != it.instanceID) ? true : false;
-	f5 = (d5.instanceID != it.instanceID) ? true : false;
-	f6 = (d6.instanceID != it.instanceID) ? true : false;
-
-	faces.left = f1;
-	faces.right = f2;
-	faces.bottom = f3;
-	faces.top = f4;
-	faces.front = f5;
-	faces.back = f6;
-
-	return (f1 + f2 + f3 + f4 + f5 + f6) ? true : false;
-}
-
 void
-TerrainObject::makeCube(ray::MeshPropertyPtr data, const VisiableFaces& faces, float x, float y, float z, float n) noexcept
+TerrainObject::makeMesh(ray::MeshPropertyPtr mesh, const TerrainChunk& chunk, InstanceID instance, std::int32_t minY) noexcept
 {
-	static const float positions[6][4][3] = 
-	{
-		{ { -1, -1, -1 },{ -1, -1, +1 },{ -1, +1, -1 },{ -1, +1, +1 } },
-		{ { +1, -1, -1 },{ +1, -1, +1 },{ +1, +1, -1 },{ +1, +1, +1 } },
-		{ { -1, +1, -1 },{ -1, +1, +1 },{ +1, +1, -1 },{ +1, +1, +1 } },
-		{ { -1, -1, -1 },{ -1, -1, +1 },{ +1, -1, -1 },{ +1, -1, +1 } },
-		{ { -1, -1, -1 },{ -1, +1, -1 },{ +1, -1, -1 },{ +1, +1, -1 } },
-		{ { -1, -1, +1 },{ -1, +1, +1 },{ +1, -1, +1 },{ +1, +1, +1 } }
-	};
-
-	static const float normals[6][3] = 
-	{
-		{ -1, 0, 0 },
-		{ +1, 0, 0 },
-		{ 0, +1, 0 },
-		{ 0, -1, 0 },
-		{ 0, 0, -1 },
-		{ 0, 0, +1 }
-	};
-
-	static const float uvs[6][4][2] = 
-	{
-		{ { 0, 0 },{ 1, 0 },{ 0, 1 },{ 1, 1 } },
-		{ { 1, 0 },{ 0, 0 },{ 1, 1 },{ 0, 1 } },
-		{ { 0, 1 },{ 0, 0 },{ 1, 1 },{ 1, 0 } },
-		{ { 0, 0 },{ 0, 1 },{ 1, 0 },{ 1, 1 } },
-		{ { 0, 0 },{ 0, 1 },{ 1, 0 },{ 1, 1 } },
-		{ { 1, 0 },{ 1, 1 },{ 0, 0 },{ 0, 1 } }
-	};
-
-	static const float indices[6][6] = 
-	{
-		{ 0, 3, 2, 0, 1, 3 },
-		{ 0, 3, 1, 0, 2, 3 },
-		{ 0, 3, 2, 0, 1, 3 },
-		{ 0, 3, 1, 0, 2, 3 },
-		{ 0, 3, 2, 0, 1, 3 },
-		{ 0, 3, 1, 0, 2, 3 }
-	};
-
-	static const float flipped[6][6] = 
-	{
-		{ 0, 1, 2, 1, 3, 2 },
-		{ 0, 2, 1, 2, 3, 1 },
-		{ 0, 1, 2, 1, 3, 2 },
-		{ 0, 2, 1, 2, 3, 1 },
-		{ 0, 1, 2, 1, 3, 2 },
-		{ 0, 2, 1, 2, 3, 1 }
-	};
-
-	float s = 0.0625;
-	float a = 0 + 1 / 2048.0;
-	float b = s - 1 / 2048.0;
-	int visiable[6] = { faces.left, faces.right, faces.top, faces.bottom, faces.front, faces.back };
-
-	auto& vertex = data->getVertexArray();
-	auto& normal = data->getNormalArray();
-	auto& texcoord = data->getTexcoordArray();
-	auto& face = data->getFaceArray();
-
-	for (int i = 0; i < 6; i++) 
+	const std::int32_t dims[3] = { (std::int32_t)chunk.size(), (std::int32_t)chunk.height(), (std::int32_t)chunk.size() };
+
+	auto& vertices = mesh->getVertexArray();
+	auto& normals = mesh->getNormalArray();
+	auto& tangents = mesh->getTangentArray();
+	auto& texcoords = mesh->getTexcoordArray();
+	auto& indices = mesh->getIndicesArray();
+
+	std::vector<std::uint8_t> mask;
+
+	// Greedy meshing, visible faces of each slice are merged into the largest rectangles.
+	for (std::int32_t face = 0; face < 6; face++)
 	{
-		if (visiable[i] == 0) 
-			continue;
+		const std::int32_t d = face >> 1;
+		const std::int32_t u = (d + 1) % 3;
+		const std::int32_t v = (d + 2) % 3;
+		const std::int32_t dir = (face & 1) ? 1 : -1;
+
+		mask.resize(dims[u] * dims[v]);
 
-		for (int j = 0; j < 6; j++) 
+		for (std::int32_t slice = 0; slice < dims[d]; slice++)
 		{
-			int k = indices[i][j];
-
-			ray::Vector3 v;
-			v.x = x + n * positions[i][k][0];
-			v.y = y + n * positions[i][k][1];
-			v.z = z + n * positions[i][k][2];
-
-			ray::Vector3 vn;
-			vn.x = normals[i][0];
-			vn.y = normals[i][1];
-			vn.z = normals[i][2];
-
-			ray::Vector2 uv;
-			uv.x = (uvs[i][k][0] ? b : a);
-			uv.y = (uvs[i][k][1] ? b : a);
-
-			vertex.push_back(v);
-			normal.push_back(vn);
-			texcoord.push_back(uv);
-			face.push_back(vertex.size() - 1);
+			std::int32_t pos[3];
+			std::int32_t count = 0;
+
+			pos[d] = slice;
+
+			for (pos[v] = 0; pos[v] < dims[v]; pos[v]++)
+			{
+				for (pos[u] = 0; pos[u] < dims[u]; pos[u]++)
+				{
+					bool visiable = false;
+
+					if (pos[1] >= minY && chunk.get(pos[0], pos[1], pos[2]) == instance)
+					{
+						std::int32_t next[3] = { pos[0], pos[1], pos[2] };
+						next[d] += dir;
+
+						visiable = chunk.get(next[0], next[1], next[2]) != instance;
+					}
+
+					mask[pos[v] * dims[u] + pos[u]] = visiable;
+					count += visiable;
+				}
+			}
+
+			if (count == 0)
+				continue;
+
+			for (std::int32_t j = 0; j < dims[v]; j++)
+			{
+				for (std::int32_t i = 0; i < dims[u];)
+				{
+					if (!mask[j * dims[u] + i])
+					{
+						i++;
+						continue;
+					}
+
+					std::int32_t w = 1;
+					while (i + w < dims[u] && mask[j * dims[u] + i + w])
+						w++;
+
+					std::int32_t h = 1;
+					for (; j + h < dims[v]; h++)
+					{
+						std::int32_t k = 0;
+						while (k < w && mask[(j + h) * dims[u] + i + k])
+							k++;
+
+						if (k < w)
+							break;
+					}
+
+					for (std::int32_t y = 0; y < h; y++)
+						std::memset(&mask[(j + y) * dims[u] + i], 0, w);
+
+					float corner[3];
+					corner[d] = (slice << 1) + dir;
+					corner[u] = (i << 1) - 1;
+					corner[v] = (j << 1) - 1;
+
+					ray::float3 du = ray::float3::Zero;
+					ray::float3 dv = ray::float3::Zero;
+					du[u] = w << 1;
+					dv[v] = h << 1;
+
+					ray::float3 normal = ray::float3::Zero;
+					normal[d] = dir;
+
+					ray::float4 tangent = ray::float4::Zero;
+					tangent[u] = 1;
+					tangent.w = dir;
+
+					const ray::float3 base(corner[0], corner[1], corner[2]);
+					const std::uint32_t start = vertices.size();
+
+					vertices.push_back(base);
+					vertices.push_back(base + du);
+					vertices.push_back(base + du + dv);
+					vertices.push_back(base + dv);
+
+					texcoords.push_back(ray::float2(0, 0));
+					texcoords.push_back(ray::float2(w, 0));
+					texcoords.push_back(ray::float2(w, h));
+					texcoords.push_back(ray::float2(0, h));
+
+					for (std::uint8_t n = 0; n < 4; n++)
+					{
+						normals.push_back(normal);
+						tangents.push_back(tangent);
+					}
+
+					static const std::uint32_t frontFace[6] = { 0, 1, 2, 0, 2, 3 };
+					static const std::uint32_t backFace[6] = { 0, 2, 1, 0, 3, 2 };
+
+					const std::uint32_t* quad = dir > 0 ? frontFace : backFace;
+					for (std::uint8_t n = 0; n < 6; n++)
+						indices.push_back(start + quad[n]);
+
+					i += w;
+				}
+			}
 		}
 	}
 }
\ No newline at end of file
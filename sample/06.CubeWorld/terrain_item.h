@@ -50,21 +50,13 @@ private:
 	InstanceID _instanceID;
 };
 
-struct VisiableFaces
-{
-	InstanceID left;
-	InstanceID right;
-	InstanceID bottom;
-	InstanceID top;
-	InstanceID back;
-	InstanceID front;
-};
-
 class TerrainObject
 {
 public:
 
+	// create and createMesh may run on a terrain worker thread, createObject runs on the main thread.
 	virtual bool create(TerrainChunk& chunk) noexcept = 0;
+	virtual bool createMesh(TerrainChunk& chunk) noexcept = 0;
 	virtual bool createObject(TerrainChunk& chunk) noexcept = 0;
 
 	virtual bool setActive(bool active) noexcept = 0;
@@ -76,8 +68,7 @@ public:
 	void addItem(TerrainItemPtr item) noexcept;
 	TerrainItems& getItems() noexcept;
 
-	bool visiable(const TerrainChunk& chunk, const TerrainData& entry, VisiableFaces& faces) noexcept;
-	void makeCube(ray::MeshPropertyPtr data, const VisiableFaces& faces, float x, float y, float z, float n) noexcept;
+	void makeMesh(ray::MeshPropertyPtr mesh, const TerrainChunk& chunk, InstanceID instance, std::int32_t minY = 0) noexcept;
 
 private:
 	TerrainItems items;
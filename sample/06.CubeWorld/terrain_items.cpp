@@ -89,56 +89,45 @@ TerrainGrass::create(TerrainChunk& chunk) noexcept
 }
 
 bool
-TerrainGrass::createObject(TerrainChunk& chunk) noexcept
+TerrainGrass::createMesh(TerrainChunk& chunk) noexcept
 {
-	auto mesh = std::make_shared<ray::MeshProperty>();
-
-	for (auto& it : chunk.data())
-	{
-		if (it.empty() || it.instanceID != _grass->getInstance())
-			continue;
+	_mesh = std::make_shared<ray::MeshProperty>();
 
-		if (it.y <= 0)
-			continue;
+	this->makeMesh(_mesh, chunk, _grass->getInstance(), 1);
 
-		VisiableFaces faces;
-		int total = this->visiable(chunk, it, faces);
-		if (total)
-		{
-			int dx = it.x << 1;
-			int dy = it.y << 1;
-			int dz = it.z << 1;
-
-			this->makeCube(mesh, faces, dx, dy, dz, 1);
-		}
+	if (_mesh->getNumVertices())
+	{
+		_mesh->computeBoundingBox();
+		return true;
 	}
 
-	if (mesh->getNumVertices())
-	{
-		mesh->computeTangents();
-		mesh->computeTangentQuats();
-		mesh->computeBoundingBox();
+	_mesh = nullptr;
+	return false;
+}
 
-		int mx, my, mz;
-		chunk.getPosition(mx, my, mz);
+bool
+TerrainGrass::createObject(TerrainChunk& chunk) noexcept
+{
+	if (!_mesh)
+		return false;
 
-		int size = chunk.size();
+	int mx, my, mz;
+	chunk.getPosition(mx, my, mz);
 
-		int offsetX = mx * size << 1;
-		int offsetY = my * size << 1;
-		int offsetZ = mz * size << 1;
+	int size = chunk.size();
 
-		auto gameObject = _grassObject->clone();
-		gameObject->setName(ray::format("chunk_%d_%d_%d") % offsetX % offsetY % offsetZ);
-		gameObject->setTranslate(ray::Vector3(offsetX, offsetY, offsetZ));
-		gameObject->getComponent<ray::MeshComponent>()->setMesh(mesh);
+	int offsetX = mx * size << 1;
+	int offsetY = my * size << 1;
+	int offsetZ = mz * size << 1;
 
-		_object = gameObject;
+	auto gameObject = _grassObject->clone();
+	gameObject->setName(ray::format("chunk_%d_%d_%d") % offsetX % offsetY % offsetZ);
+	gameObject->setTranslate(ray::Vector3(offsetX, offsetY, offsetZ));
+	gameObject->getComponent<ray::MeshComponent>()->setMesh(_mesh);
 
-		return true;
-	}
+	_object = gameObject;
 
-	return false;
+	return true;
 }
 
 bool
@@ -167,9 +156,13 @@ TerrainGrass::setActive(bool active) noexcept
 bool
 TerrainGrass::update(TerrainChunk& chunk) noexcept
 {
-	_object->destroy();
-	_object = nullptr;
+	if (_object)
+	{
+		_object->destroy();
+		_object = nullptr;
+	}
 
+	this->createMesh(chunk);
 	this->createObject(chunk);
 	this->setActive(true);
 
@@ -271,36 +264,30 @@ TerrainTree::create(TerrainChunk& chunk) noexcept
 }
 
 bool
-TerrainTree::createObject(TerrainChunk& chunk) noexcept
+TerrainTree::createMesh(TerrainChunk& chunk) noexcept
 {
-	auto woods = std::make_shared<ray::MeshProperty>();
-	auto leafs = std::make_shared<ray::MeshProperty>();
-
-	for (auto& it : chunk.data())
-	{
-		if (it.empty())
-			continue;
+	_woods = std::make_shared<ray::MeshProperty>();
+	_leafs = std::make_shared<ray::MeshProperty>();
 
-		if (it.instanceID != _wood->getInstance() &&
-			it.instanceID != _leaf->getInstance())
-			continue;
+	this->makeMesh(_woods, chunk, _wood->getInstance());
+	this->makeMesh(_leafs, chunk, _leaf->getInstance());
 
-		VisiableFaces faces;
-		int total = this->visiable(chunk, it, faces);
-		if (total)
-		{
-			int dx = it.x << 1;
-			int dy = it.y << 1;
-			int dz = it.z << 1;
+	if (_woods->getNumVertices())
+		_woods->computeBoundingBox();
+	else
+		_woods = nullptr;
 
-			if (it.instanceID == _wood->getInstance())
-				this->makeCube(woods, faces, dx, dy, dz, 1);
+	if (_leafs->getNumVertices())
+		_leafs->computeBoundingBox();
+	else
+		_leafs = nullptr;
 
-			if (it.instanceID == _leaf->getInstance())
-				this->makeCube(leafs, faces, dx, dy, dz, 1);
-		}
-	}
+	return _woods || _leafs;
+}
 
+bool
+TerrainTree::createObject(TerrainChunk& chunk) noexcept
+{
 	int mx, my, mz;
 	chunk.getPosition(mx, my, mz);
 
@@ -310,30 +297,22 @@ TerrainTree::createObject(TerrainChunk& chunk) noexcept
 	int offsetY = my * size << 1;
 	int offsetZ = mz * size << 1;
 
-	if (woods->getNumVertices())
+	if (_woods)
 	{
-		woods->computeTangents();
-		woods->computeTangentQuats();
-		woods->computeBoundingBox();
-
 		auto gameObject = _woodObject->clone();
 		gameObject->setName(ray::format("chunk_wood_%d_%d_%d") % offsetX % offsetY % offsetZ);
 		gameObject->setTranslate(ray::Vector3(offsetX, offsetY, offsetZ));
-		gameObject->getComponent<ray::MeshComponent>()->setMesh(woods);
+		gameObject->getComponent<ray::MeshComponent>()->setMesh(_woods);
 
 		_objects.push_back(gameObject);
 	}
 
-	if (leafs->getNumVertices())
+	if (_leafs)
 	{
-		leafs->computeTangents();
-		leafs->computeTangentQuats();
-		leafs->computeBoundingBox();
-
 		auto gameObject = _leafObject->clone();
 		gameObject->setName(ray::format("chunk_leaf_%d_%d_%d") % offsetX % offsetY % offsetZ);
 		gameObject->setTranslate(ray::Vector3(offsetX, offsetY, offsetZ));
-		gameObject->getComponent<ray::MeshComponent>()->setMesh(leafs);
+		gameObject->getComponent<ray::MeshComponent>()->setMesh(_leafs);
 
 		_objects.push_back(gameObject);
 	}
@@ -431,56 +410,45 @@ TerrainClound::create(TerrainChunk& chunk) noexcept
 }
 
 bool
-TerrainClound::createObject(TerrainChunk& chunk) noexcept
+TerrainClound::createMesh(TerrainChunk& chunk) noexcept
 {
-	auto mesh = std::make_shared<ray::MeshProperty>();
+	_mesh = std::make_shared<ray::MeshProperty>();
 
-	for (auto& it : chunk.data())
-	{
-		if (it.empty())
-			continue;
-
-		if (it.instanceID != _clound->getInstance())
-			continue;
+	this->makeMesh(_mesh, chunk, _clound->getInstance());
 
-		VisiableFaces faces;
-		int total = this->visiable(chunk, it, faces);
-		if (total)
-		{
-			int dx = it.x << 1;
-			int dy = it.y << 1;
-			int dz = it.z << 1;
-
-			this->makeCube(mesh, faces, dx, dy, dz, 1);
-		}
+	if (_mesh->getNumVertices())
+	{
+		_mesh->computeBoundingBox();
+		return true;
 	}
 
-	if (mesh->getNumVertices())
-	{
-		mesh->computeTangents();
-		mesh->computeTangentQuats();
-		mesh->computeBoundingBox();
+	_mesh = nullptr;
+	return false;
+}
 
-		int mx, my, mz;
-		chunk.getPosition(mx, my, mz);
+bool
+TerrainClound::createObject(TerrainChunk& chunk) noexcept
+{
+	if (!_mesh)
+		return false;
 
-		int size = chunk.size();
+	int mx, my, mz;
+	chunk.getPosition(mx, my, mz);
 
-		int offsetX = mx * size << 1;
-		int offsetY = my * size << 1;
-		int offsetZ = mz * size << 1;
+	int size = chunk.size();
 
-		auto gameObject = _cloundObject->clone();
-		gameObject->setName(ray::format("chunk_%d_%d_%d") % offsetX % offsetY % offsetZ);
-		gameObject->setTranslate(ray::Vector3(offsetX, offsetY, offsetZ));
-		gameObject->getComponent<ray::MeshComponent>()->setMesh(mesh);
+	int offsetX = mx * size << 1;
+	int offsetY = my * size << 1;
+	int offsetZ = mz * size << 1;
 
-		_object = gameObject;
+	auto gameObject = _cloundObject->clone();
+	gameObject->setName(ray::format("chunk_%d_%d_%d") % offsetX % offsetY % offsetZ);
+	gameObject->setTranslate(ray::Vector3(offsetX, offsetY, offsetZ));
+	gameObject->getComponent<ray::MeshComponent>()->setMesh(_mesh);
 
-		return true;
-	}
+	_object = gameObject;
 
-	return false;
+	return true;
 }
 
 bool
@@ -575,56 +543,45 @@ TerrainWater::create(TerrainChunk& chunk) noexcept
 }
 
 bool
-TerrainWater::createObject(TerrainChunk& chunk) noexcept
+TerrainWater::createMesh(TerrainChunk& chunk) noexcept
 {
-	auto mesh = std::make_shared<ray::MeshProperty>();
-
-	for (auto& it : chunk.data())
-	{
-		if (it.empty())
-			continue;
-
-		if (it.instanceID != _water->getInstance())
-			continue;
+	_mesh = std::make_shared<ray::MeshProperty>();
 
-		VisiableFaces faces;
-		int total = this->visiable(chunk, it, faces);
-		if (total)
-		{
-			int dx = it.x << 1;
-			int dy = it.y << 1;
-			int dz = it.z << 1;
+	this->makeMesh(_mesh, chunk, _water->getInstance());
 
-			this->makeCube(mesh, faces, dx, dy, dz, 1);
-		}
+	if (_mesh->getNumVertices())
+	{
+		_mesh->computeBoundingBox();
+		return true;
 	}
 
-	if (mesh->getNumVertices())
-	{
-		mesh->computeTangents();
-		mesh->computeTangentQuats();
-		mesh->computeBoundingBox();
+	_mesh = nullptr;
+	return false;
+}
 
-		int mx, my, mz;
-		chunk.getPosition(mx, my, mz);
+bool
+TerrainWater::createObject(TerrainChunk& chunk) noexcept
+{
+	if (!_mesh)
+		return false;
 
-		int size = chunk.size();
+	int mx, my, mz;
+	chunk.getPosition(mx, my, mz);
 
-		int offsetX = mx * size << 1;
-		int offsetY = my * size << 1;
-		int offsetZ = mz * size << 1;
+	int size = chunk.size();
 
-		auto gameObject = _waterObject->clone();
-		gameObject->setName(ray::format("chunk_%d_%d_%d") % offsetX % offsetY % offsetZ);
-		gameObject->setTranslate(ray::Vector3(offsetX, offsetY, offsetZ));
-		gameObject->getComponent<ray::MeshComponent>()->setMesh(mesh);
+	int offsetX = mx * size << 1;
+	int offsetY = my * size << 1;
+	int offsetZ = mz * size << 1;
 
-		_object = gameObject;
+	auto gameObject = _waterObject->clone();
+	gameObject->setName(ray::format("chunk_%d_%d_%d") % offsetX % offsetY % offsetZ);
+	gameObject->setTranslate(ray::Vector3(offsetX, offsetY, offsetZ));
+	gameObject->getComponent<ray::MeshComponent>()->setMesh(_mesh);
 
-		return true;
-	}
+	_object = gameObject;
 
-	return false;
+	return true;
 }
 
 bool
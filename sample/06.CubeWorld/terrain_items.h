@@ -46,6 +46,7 @@ public:
 	~TerrainGrass() noexcept;
 
 	bool create(TerrainChunk& chunk) noexcept;
+	bool createMesh(TerrainChunk& chunk) noexcept;
 	bool createObject(TerrainChunk& chunk) noexcept;
 
 	bool setActive(bool active) noexcept;
@@ -60,6 +61,8 @@ private:
 
 	std::shared_ptr<Grass> _grass;
 
+	ray::MeshPropertyPtr _mesh;
+
 	ray::GameObjectPtr _grassObject;
 	ray::GameObjectPtr _object;
 };
@@ -71,6 +74,7 @@ public:
 	~TerrainTree() noexcept;
 
 	bool create(TerrainChunk& chunk) noexcept;
+	bool createMesh(TerrainChunk& chunk) noexcept;
 	bool createObject(TerrainChunk& chunk) noexcept;
 
 	bool setActive(bool active) noexcept;
@@ -86,6 +90,9 @@ private:
 	std::shared_ptr<Wood> _wood;
 	std::shared_ptr<Leaf> _leaf;
 
+	ray::MeshPropertyPtr _woods;
+	ray::MeshPropertyPtr _leafs;
+
 	ray::GameObjectPtr _woodObject;
 	ray::GameObjectPtr _leafObject;
 
@@ -99,6 +106,7 @@ public:
 	~TerrainClound() noexcept;
 
 	bool create(TerrainChunk& chunk) noexcept;
+	bool createMesh(TerrainChunk& chunk) noexcept;
 	bool createObject(TerrainChunk& chunk) noexcept;
 
 	bool setActive(bool active) noexcept;
@@ -111,6 +119,7 @@ private:
 	class Clound : public TerrainItem {};
 
 	std::shared_ptr<Clound> _clound;
+	ray::MeshPropertyPtr _mesh;
 	ray::GameObjectPtr _cloundObject;
 
 	ray::GameObjectPtr _object;
@@ -123,6 +132,7 @@ public:
 	~TerrainWater() noexcept;
 
 	bool create(TerrainChunk& chunk) noexcept;
+	bool createMesh(TerrainChunk& chunk) noexcept;
 	bool createObject(TerrainChunk& chunk) noexcept;
 
 	bool setActive(bool active) noexcept;
@@ -136,6 +146,8 @@ private:
 
 	std::shared_ptr<Water> _water;
 
+	ray::MeshPropertyPtr _mesh;
+
 	ray::GameObjectPtr _waterObject;
 	ray::GameObjectPtr _object;
 };
@@ -37,13 +37,15 @@
 #include "terrain_map.h"
 
 TerrainMap::TerrainMap() noexcept
-	: _mask(0)
+	: _size(0)
+	, _height(0)
+	, _count(0)
 {
 }
 
-TerrainMap::TerrainMap(std::size_t mask) noexcept
+TerrainMap::TerrainMap(std::size_t size, std::size_t height) noexcept
 {
-	this->create(mask);
+	this->create(size, height);
 }
 
 TerrainMap::~TerrainMap() noexcept
@@ -52,83 +54,56 @@ TerrainMap::~TerrainMap() noexcept
 }
 
 void
-TerrainMap::create(std::size_t mask) noexcept
+TerrainMap::create(std::size_t size, std::size_t height) noexcept
 {
-	_mask = mask;
+	_size = size;
+	_height = height;
 	_count = 0;
-	_data.resize(mask + 1);
+	_data.assign(size * size * height, 0);
 }
 
 void
 TerrainMap::clear() noexcept
 {
 	_data.clear();
+	_count = 0;
 }
 
 bool
 TerrainMap::set(const TerrainData& data) noexcept
 {
-	std::size_t index = ray::math::hash_int(data.x, data.y, data.z) & _mask;
-
-	auto* entry = &_data[index];
-
-	int overwrite = 0;
-	while (!entry->empty())
-	{
-		if (entry->x == data.x && entry->y == data.y && entry->z == data.z)
-		{
-			overwrite = 1;
-			break;
-		}
-
-		index = (index + 1) & _mask;
-		entry = &_data[index];
-	}
-
-	if (overwrite)
-	{
-		if (entry->instanceID != data.instanceID)
-		{
-			entry->instanceID = data.instanceID;
-			return true;
-		}
-	}
-	else if (data.instanceID)
-	{
-		*entry = data;
+	if (data.x < 0 || data.x >= (std::int32_t)_size) return false;
+	if (data.y < 0 || data.y >= (std::int32_t)_height) return false;
+	if (data.z < 0 || data.z >= (std::int32_t)_size) return false;
 
-		_count++;
-		if (_count * 2 > _mask)
-			this->grow();
+	auto& entry = _data[(data.y * _size + data.z) * _size + data.x];
+	if (entry == data.instanceID)
+		return false;
 
-		return true;
-	}
+	if (entry == 0)
+		_count++;
+	else if (data.instanceID == 0)
+		_count--;
 
-	return false;
+	entry = data.instanceID;
+	return true;
 }
 
 bool
-TerrainMap::get(TerrainData& data) noexcept
+TerrainMap::get(TerrainData& data) const noexcept
 {
-	std::size_t index = ray::math::hash_int(data.x, data.y, data.z) & _mask;
-
-	TerrainData* entry = &_data[index];
-
-	while (!entry->empty())
-	{
-		if (entry->x == data.x &&
-			entry->y == data.y &&
-			entry->z == data.z)
-		{
-			data.instanceID = entry->instanceID;
-			return true;
-		}
+	data.instanceID = this->get(data.x, data.y, data.z);
+	return data.instanceID != 0;
+}
 
-		index = (index + 1) & _mask;
-		entry = &_data[index];
-	}
+InstanceID
+TerrainMap::get(std::int32_t x, std::int32_t y, std::int32_t z) const noexcept
+{
+	if (x < 0 || x >= (std::int32_t)_size) return 0;
+	if (y < 0 || y >= (std::int32_t)_height) return 0;
+	if (z < 0 || z >= (std::int32_t)_size) return 0;
 
-	return false;
+	return _data[(y * _size + z) * _size + x];
 }
 
 std::size_t
@@ -137,27 +112,20 @@ TerrainMap::count() const noexcept
 	return _count;
 }
 
-void
-TerrainMap::grow() noexcept
+std::size_t
+TerrainMap::size() const noexcept
+{
+	return _size;
+}
+
+std::size_t
+TerrainMap::height() const noexcept
 {
-	TerrainMap map;
-	map.create(_mask << 1 | 1);
-
-	for (auto& it : _data)
-	{
-		if (!it.empty())
-		{
-			map.set(it);
-		}
-	}
-
-	_mask = map._mask;
-	_count = map._count;
-	_data.swap(map._data);
+	return _height;
 }
 
-TerrainDatas&
-TerrainMap::data() noexcept
+const InstanceIDs&
+TerrainMap::data() const noexcept
 {
 	return _data;
 }
\ No newline at end of file
@@ -75,24 +75,28 @@ public:
 	InstanceID instanceID;
 };
 
+// Dense voxel storage of one chunk, size * height * size instance ids laid out x, z, y.
 class TerrainMap final
 {
 public:
 	TerrainMap() noexcept;
-	TerrainMap(std::size_t mask) noexcept;
+	TerrainMap(std::size_t size, std::size_t height) noexcept;
 	~TerrainMap() noexcept;
 
-	void create(std::size_t mask) noexcept;
+	void create(std::size_t size, std::size_t height) noexcept;
 	void clear() noexcept;
 
 	bool set(const TerrainData& data) noexcept;
-	bool get(TerrainData& data) noexcept;
+	bool get(TerrainData& data) const noexcept;
 
-	void grow() noexcept;
+	InstanceID get(std::int32_t x, std::int32_t y, std::int32_t z) const noexcept;
 
 	std::size_t count() const noexcept;
 
-	TerrainDatas& data() noexcept;
+	std::size_t size() const noexcept;
+	std::size_t height() const noexcept;
+
+	const InstanceIDs& data() const noexcept;
 
 private:
 	TerrainMap(const TerrainMap&) noexcept = delete;
@@ -100,10 +104,11 @@ private:
 
 private:
 
-	std::size_t _mask;
+	std::size_t _size;
+	std::size_t _height;
 	std::size_t _count;
 
-	std::vector<TerrainData> _data;
+	InstanceIDs _data;
 };
 
 #endif
\ No newline at end of file
@@ -61,5 +61,6 @@ typedef std::vector<class TerrainData> TerrainDatas;
 
 typedef std::int8_t BlockPosition;
 typedef std::int16_t InstanceID;
+typedef std::vector<InstanceID> InstanceIDs;
 
 #endif
\ No newline at end of file
@@ -37,6 +37,7 @@
 #include <ray/game_application.h>
 #include <ray/game_server.h>
 #include <ray/game_listener.h>
+#include <ray/game_recorder.h>
 
 #include <ray/utf8.h>
 #include <ray/iolistener.h>
@@ -122,44 +123,7 @@ GameApplication::open(WindHandle hwnd, std::uint32_t w, std::uint32_t h, std::ui
 		return false;
 	}
 
-	auto local = setlocale(LC_ALL, "");
-	if (local)
-	{
-		if (_gameListener)
-			_gameListener->onMessage(std::string("Initializing : Local : ") + local);
-	}
-
-	if (_gameListener)
-		_gameListener->onMessage("Initializing : Game Application.");
-
-	if (_gameListener)
-		_gameListener->onMessage("Initializing : RTTI.");
-
-	if (!rtti::Factory::instance()->open())
-	{
-		if (_gameListener)
-			_gameListener->onMessage("Could not initialize with RTTI.");
-
-		return false;
-	}
-
-	if (_gameListener)
-		_gameListener->onMessage("Initializing : IO Server.");
-
-	if (!_ioInterface->open())
-	{
-		if (_gameListener)
-			_gameListener->onMessage("Could not initialize with IO Server.");
-	}
-
-	if (_gameListener)
-		_gameListener->onMessage("Initializing : Game Server.");
-
-	_gameServer = GameServer::instance();
-	_gameServer->_setGameApp(this);
-	_gameServer->setGameListener(_gameListener);
-
-	if (!_gameServer->open())
+	if (!this->openServer())
 		return false;
 
 #if defined(_BUILD_INPUT)
@@ -210,12 +174,62 @@ GameApplication::open(WindHandle hwnd, std::uint32_t w, std::uint32_t h, std::ui
 	return _isInitialize;
 }
 
+bool
+GameApplication::openHeadless() noexcept
+{
+	if (_isInitialize)
+	{
+		if (_gameListener)
+			_gameListener->onMessage("Game Application has already opened.");
+
+		return false;
+	}
+
+	if (!this->openServer())
+		return false;
+
+#if defined(_BUILD_INPUT)
+	_inputFeature = std::make_shared<InputFeature>();
+#endif
+#if defined(_BUILD_SCRIPT)
+	_scriptFeature = std::make_shared<ScriptFeatures>();
+#endif
+#if defined(_BUILD_BASEGAME)
+	_gameBaseFeature = std::make_shared<GameBaseFeatures>();
+#endif
+#if defined(_BUILD_PHYSIC)
+	_physicFeature = std::make_shared<PhysicFeatures>();
+#endif
+
+#if defined(_BUILD_INPUT)
+	this->addFeatures(_inputFeature);
+#endif
+#if defined(_BUILD_SCRIPT)
+	this->addFeatures(_scriptFeature);
+#endif
+#if defined(_BUILD_BASEGAME)
+	this->addFeatures(_gameBaseFeature);
+#endif
+#if defined(_BUILD_PHYSIC)
+	this->addFeatures(_physicFeature);
+#endif
+
+	_isInitialize = this->start();
+	return _isInitialize;
+}
+
 void
 GameApplication::close() noexcept
 {
 	if (_gameListener)
 		_gameListener->onMessage("Shutdown : Game Server.");
 
+	if (_gameServer && _gameServer->getGameRecorder())
+	{
+		_gameServer->getGameRecorder()->close();
+		_gameServer->setGameRecorder(nullptr);
+	}
+
 	if (_gameServer)
 	{
 		_gameServer->close();
@@ -232,6 +246,52 @@ GameApplication::close() noexcept
 	}
 }
 
+bool
+GameApplication::openServer() noexcept
+{
+	auto local = setlocale(LC_ALL, "");
+	if (local)
+	{
+		if (_gameListener)
+			_gameListener->onMessage(std::string("Initializing : Local : ") + local);
+	}
+
+	if (_gameListener)
+		_gameListener->onMessage("Initializing : Game Application.");
+
+	if (_gameListener)
+		_gameListener->onMessage("Initializing : RTTI.");
+
+	if (!rtti::Factory::instance()->open())
+	{
+		if (_gameListener)
+			_gameListener->onMessage("Could not initialize with RTTI.");
+
+		return false;
+	}
+
+	if (_gameListener)
+		_gameListener->onMessage("Initializing : IO Server.");
+
+	if (!_ioInterface->open())
+	{
+		if (_gameListener)
+			_gameListener->onMessage("Could not initialize with IO Server.");
+	}
+
+	if (_gameListener)
+		_gameListener->onMessage("Initializing : Game Server.");
+
+	_gameServer = GameServer::instance();
+	_gameServer->_setGameApp(this);
+	_gameServer->setGameListener(_gameListener);
+
+	if (!_gameServer->open())
+		return false;
+
+	return true;
+}
+
 void
 GameApplication::setGameListener(const GameListenerPtr& listener) noexcept
 {
@@ -407,10 +467,56 @@ GameApplication::setResDownloadURL(const util::string& filepath) noexcept
 	return true;
 }
 
+bool
+GameApplication::record(const util::string& path) noexcept
+{
+	assert(_gameServer);
+
+	auto recorder = std::make_shared<GameRecorder>();
+	if (!recorder->record(path))
+	{
+		if (_gameListener)
+			_gameListener->onMessage("Could not open the record file : " + path);
+
+		return false;
+	}
+
+	_gameServer->setGameRecorder(recorder);
+	return true;
+}
+
+bool
+GameApplication::replay(const util::string& path) noexcept
+{
+	assert(_gameServer);
+
+	auto recorder = std::make_shared<GameRecorder>();
+	if (!recorder->replay(path))
+	{
+		if (_gameListener)
+			_gameListener->onMessage("Could not open the replay file : " + path);
+
+		return false;
+	}
+
+	_gameServer->setGameRecorder(recorder);
+	return true;
+}
+
 bool
 GameApplication::sendMessage(const MessagePtr& message) noexcept
 {
 	assert(_gameServer);
+
+	auto& recorder = _gameServer->getGameRecorder();
+	if (recorder)
+	{
+		if (recorder->isReplaying())
+			return true;
+		if (recorder->isRecording())
+			recorder->addMessage(message, false);
+	}
+
 	return _gameServer->sendMessage(message);
 }
 
@@ -424,6 +530,15 @@ GameApplication::postMessage(const MessagePtr& message) noexcept
 bool
 GameApplication::sendInputEvent(const InputEvent& event) noexcept
 {
+	auto& recorder = _gameServer->getGameRecorder();
+	if (recorder)
+	{
+		if (recorder->isReplaying())
+			return true;
+		if (recorder->isRecording())
+			recorder->addInputEvent(event, false);
+	}
+
 	if (_inputFeature)
 		return _inputFeature->downcast<InputFeature>()->sendInputEvent(event);
 	return false;
@@ -432,6 +547,15 @@ GameApplication::sendInputEvent(const InputEvent& event) noexcept
 bool
 GameApplication::postInputEvent(const InputEvent& event) noexcept
 {
+	auto& recorder = _gameServer->getGameRecorder();
+	if (recorder)
+	{
+		if (recorder->isReplaying())
+			return true;
+		if (recorder->isRecording())
+			recorder->addInputEvent(event, true);
+	}
+
 	if (_inputFeature)
 		return _inputFeature->downcast<InputFeature>()->postInputEvent(event);
 	return false;
@@ -253,6 +253,12 @@ GameComponent::onDeactivate() noexcept
 {
 }
 
+GameAccessFlags
+GameComponent::getAccessFlags() const noexcept
+{
+	return GameAccessFlagBits::GameAccessFlagNone;
+}
+
 void
 GameComponent::onFrameBegin() except
 {
@@ -53,6 +53,7 @@ GameObject::GameObject() noexcept
 	, _worldRotation(Quaternion::Zero)
 	, _localNeedUpdates(true)
 	, _worldNeedUpdates(true)
+	, _isMoveAfterDeferred(false)
 {
 	GameObjectManager::instance()->_instanceObject(this, _instanceID);
 }
@@ -1047,33 +1048,42 @@ GameObject::clone() const except
 }
 
 void
-GameObject::_onFrameBegin() except
+GameObject::_onFrameBegin(bool parallel) except
 {
 	assert(!_dispatchComponents.empty());
 
 	auto& components = _dispatchComponents[GameDispatchType::GameDispatchTypeFrameBegin];
 	for (auto& it : components)
-		it->onFrameBegin();
+	{
+		if ((it->getAccessFlags() != GameAccessFlagBits::GameAccessFlagNone) == parallel)
+			it->onFrameBegin();
+	}
 }
 
 void
-GameObject::_onFrame() except
+GameObject::_onFrame(bool parallel) except
 {
 	assert(!_dispatchComponents.empty());
 
 	auto& components = _dispatchComponents[GameDispatchType::GameDispatchTypeFrame];
 	for (auto& it : components)
-		it->onFrame();
+	{
+		if ((it->getAccessFlags() != GameAccessFlagBits::GameAccessFlagNone) == parallel)
+			it->onFrame();
+	}
 }
 
 void
-GameObject::_onFrameEnd() except
+GameObject::_onFrameEnd(bool parallel) except
 {
 	assert(!_dispatchComponents.empty());
 
 	auto& components = _dispatchComponents[GameDispatchType::GameDispatchTypeFrameEnd];
 	for (auto& it : components)
-		it->onFrameEnd();
+	{
+		if ((it->getAccessFlags() != GameAccessFlagBits::GameAccessFlagNone) == parallel)
+			it->onFrameEnd();
+	}
 }
 
 void
@@ -1116,6 +1126,37 @@ GameObject::_onDeactivate() noexcept
 	}
 }
 
+GameAccessFlags
+GameObject::_getDispatchAccess(GameDispatchType type, bool& serial) const noexcept
+{
+	assert(!_dispatchComponents.empty());
+
+	GameAccessFlags flags = GameAccessFlagBits::GameAccessFlagNone;
+
+	serial = false;
+
+	for (auto& it : _dispatchComponents[type])
+	{
+		auto access = it->getAccessFlags();
+		if (access == GameAccessFlagBits::GameAccessFlagNone)
+			serial = true;
+		else
+			flags |= access;
+	}
+
+	// Components listening to moves run whenever a parent moves, so the object has to stay with its hierarchy.
+	if (flags != GameAccessFlagBits::GameAccessFlagNone)
+	{
+		if (!_dispatchComponents[GameDispatchType::GameDispatchTypeMoveBefore].empty() ||
+			!_dispatchComponents[GameDispatchType::GameDispatchTypeMoveAfter].empty())
+		{
+			flags |= GameAccessFlagBits::GameAccessFlagTransformReadBit;
+		}
+	}
+
+	return flags;
+}
+
 void
 GameObject::_onMoveBefore() except
 {
@@ -1147,10 +1188,18 @@ GameObject::_onMoveAfter() except
 
 	if (!_dispatchComponents.empty())
 	{
+		bool parallel = GameObjectManager::instance()->_isParallelDispatch;
+
 		auto& components = _dispatchComponents[GameDispatchType::GameDispatchTypeMoveAfter];
 		for (auto& it : components)
 		{
-			if (it->getActive())
+			if (!it->getActive())
+				continue;
+
+			// Components that did not opt in must not run on a worker, they are notified on the main thread after the batch.
+			if (parallel && it->getAccessFlags() == GameAccessFlagBits::GameAccessFlagNone)
+				GameObjectManager::instance()->_deferMoveAfter(this);
+			else
 				it->onMoveAfter();
 		}
 	}
@@ -1162,6 +1211,43 @@ GameObject::_onMoveAfter() except
 	}
 }
 
+void
+GameObject::_onMoveAfterDeferred() except
+{
+	_isMoveAfterDeferred = false;
+
+	if (!this->getActive())
+		return;
+
+	auto& components = _dispatchComponents[GameDispatchType::GameDispatchTypeMoveAfter];
+	for (auto& it : components)
+	{
+		if (it->getActive() && it->getAccessFlags() == GameAccessFlagBits::GameAccessFlagNone)
+			it->onMoveAfter();
+	}
+}
+
+bool
+GameObject::_hasSerialMoveBefore() const noexcept
+{
+	if (!_dispatchComponents.empty())
+	{
+		for (auto& it : _dispatchComponents[GameDispatchType::GameDispatchTypeMoveBefore])
+		{
+			if (it->getAccessFlags() == GameAccessFlagBits::GameAccessFlagNone)
+				return true;
+		}
+	}
+
+	for (auto& it : _children)
+	{
+		if (it->_hasSerialMoveBefore())
+			return true;
+	}
+
+	return false;
+}
+
 void
 GameObject::_onLayerChangeBefore() except
 {
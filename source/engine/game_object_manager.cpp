@@ -54,6 +54,9 @@ RaycastHit::RaycastHit() noexcept
 }
 
 GameObjectManager::GameObjectManager() noexcept
+	: _hasEmptyActors(false)
+	, _numThreads(0)
+	, _isParallelDispatch(false)
 {
 }
 
@@ -169,6 +172,18 @@ GameObjectManager::activeObject(const util::string& name) noexcept
 	return false;
 }
 
+void
+GameObjectManager::setNumThreads(std::uint32_t numThreads) noexcept
+{
+	_numThreads = numThreads;
+}
+
+std::uint32_t
+GameObjectManager::getNumThreads() const noexcept
+{
+	return _numThreads ? _numThreads : std::max(1U, std::thread::hardware_concurrency());
+}
+
 std::size_t
 GameObjectManager::raycastHit(const Raycast3& ray, RaycastHit& hit, std::function<bool(GameObject*)> comp) noexcept
 {
@@ -233,33 +248,156 @@ GameObjectManager::raycastHit(const Vector3& orgin, const Vector3& end, RaycastH
 }
 
 void
-GameObjectManager::onFrameBegin() noexcept
+GameObjectManager::_dispatch(GameObject* object, GameDispatchType type, bool parallel) noexcept
 {
-	for (std::size_t i = 0; i < _activeActors.size(); i++)
+	switch (type)
 	{
-		if (_activeActors[i])
-			_activeActors[i]->_onFrameBegin();
+	case GameDispatchType::GameDispatchTypeFrameBegin:
+		object->_onFrameBegin(parallel);
+		break;
+	case GameDispatchType::GameDispatchTypeFrame:
+		object->_onFrame(parallel);
+		break;
+	case GameDispatchType::GameDispatchTypeFrameEnd:
+		object->_onFrameEnd(parallel);
+		break;
+	default:
+		assert(false);
 	}
 }
 
 void
-GameObjectManager::onFrame() noexcept
+GameObjectManager::_dispatch(GameDispatchType type) noexcept
 {
+	std::size_t numGroups = 0;
+
+	_parallelGroupIndices.clear();
+
+	for (std::size_t i = 0; i < _activeActors.size(); i++)
+	{
+		auto actor = _activeActors[i];
+		if (!actor)
+			continue;
+
+		bool serial = false;
+		auto flags = actor->_getDispatchAccess(type, serial);
+		if (flags == GameAccessFlagBits::GameAccessFlagNone)
+			continue;
+
+		// Transforms are shared along a hierarchy, every object of it is updated in order by the same worker.
+		auto key = actor;
+		if (flags & GameAccessFlagBits::GameAccessFlagTransformBit)
+		{
+			while (key->getParent())
+				key = key->getParent();
+		}
+
+		auto it = _parallelGroupIndices.find(key);
+		if (it == _parallelGroupIndices.end())
+		{
+			it = _parallelGroupIndices.insert(std::make_pair(key, numGroups++)).first;
+
+			if (_parallelGroups.size() < numGroups)
+			{
+				_parallelGroups.emplace_back();
+				_parallelMoves.emplace_back();
+				_parallelGroupFlags.emplace_back();
+				_parallelGroupSerial.emplace_back();
+			}
+
+			_parallelGroups[it->second].clear();
+			_parallelMoves[it->second].clear();
+			_parallelGroupFlags[it->second] = GameAccessFlagBits::GameAccessFlagNone;
+		}
+
+		_parallelGroups[it->second].push_back(actor);
+		_parallelGroupFlags[it->second] |= flags;
+	}
+
+	// onMoveBefore can't be deferred until after the batch, hierarchies with serial listeners of it stay on the main thread.
+	for (auto& it : _parallelGroupIndices)
+	{
+		bool writes = (_parallelGroupFlags[it.second] & GameAccessFlagBits::GameAccessFlagTransformWriteBit) != 0;
+		_parallelGroupSerial[it.second] = writes && it.first->_hasSerialMoveBefore();
+	}
+
+	if (numGroups > 0)
+	{
+		if (_threadPool.getNumThreads() != this->getNumThreads())
+			_threadPool.start(this->getNumThreads());
+
+		_isParallelDispatch = true;
+
+		_threadPool.parallelFor(numGroups, [this, type](std::size_t index)
+		{
+			if (_parallelGroupSerial[index])
+				return;
+
+			for (auto& actor : _parallelGroups[index])
+				this->_dispatch(actor, type, true);
+		});
+
+		_isParallelDispatch = false;
+
+		for (std::size_t i = 0; i < numGroups; i++)
+		{
+			if (_parallelGroupSerial[i])
+			{
+				for (auto& actor : _parallelGroups[i])
+					this->_dispatch(actor, type, true);
+			}
+
+			for (auto& object : _parallelMoves[i])
+				object->_onMoveAfterDeferred();
+		}
+	}
+
+	// Components that did not opt in keep running on the main thread, in the order the objects were activated.
+	// Within one object they run after its opted-in components, which have finished for every object by now.
 	for (std::size_t i = 0; i < _activeActors.size(); i++)
 	{
 		if (_activeActors[i])
-			_activeActors[i]->_onFrame();
+			this->_dispatch(_activeActors[i], type, false);
 	}
 }
 
 void
-GameObjectManager::onFrameEnd() noexcept
+GameObjectManager::_deferMoveAfter(GameObject* object) noexcept
 {
-	for (std::size_t i = 0; i < _activeActors.size(); i++)
+	if (object->_isMoveAfterDeferred)
+		return;
+
+	auto key = object;
+	while (key->getParent())
+		key = key->getParent();
+
+	// Only the worker updating this hierarchy gets here, the list of its group is not shared.
+	auto it = _parallelGroupIndices.find(key);
+	assert(it != _parallelGroupIndices.end());
+
+	if (it != _parallelGroupIndices.end())
 	{
-		if (_activeActors[i])
-			_activeActors[i]->_onFrameEnd();
+		object->_isMoveAfterDeferred = true;
+		_parallelMoves[it->second].push_back(object);
 	}
+}
+
+void
+GameObjectManager::onFrameBegin() noexcept
+{
+	this->_dispatch(GameDispatchType::GameDispatchTypeFrameBegin);
+}
+
+void
+GameObjectManager::onFrame() noexcept
+{
+	this->_dispatch(GameDispatchType::GameDispatchTypeFrame);
+}
+
+void
+GameObjectManager::onFrameEnd() noexcept
+{
+	this->_dispatch(GameDispatchType::GameDispatchTypeFrameEnd);
 
 	if (_hasEmptyActors)
 	{
@@ -0,0 +1,373 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include <ray/game_recorder.h>
+#include <ray/rtti_factory.h>
+
+_NAME_BEGIN
+
+// Every log starts with the magic and the version, frames follow as a tagged stream:
+// [Frame][delta] then the entries of the frame until the next [Frame] tag or the end of file.
+static const std::uint32_t RECORD_MAGIC = 0x52594152; // "RAYR"
+static const std::uint32_t RECORD_VERSION = 1;
+static const std::size_t RECORD_MAX_PAYLOAD = 65536;
+
+GameRecorder::GameRecorder() noexcept
+	: _mode(GameRecordMode::GameRecordModeNone)
+	, _numFrames(0)
+	, _offset(0)
+{
+}
+
+GameRecorder::~GameRecorder() noexcept
+{
+	this->close();
+}
+
+bool
+GameRecorder::record(const util::string& path) noexcept
+{
+	this->close();
+
+	if (!_stream.open(path))
+		return false;
+
+	std::vector<char> header;
+	write(header, RECORD_MAGIC);
+	write(header, RECORD_VERSION);
+
+	_stream.write(header.data(), header.size());
+	_payload.resize(RECORD_MAX_PAYLOAD);
+	_mode = GameRecordMode::GameRecordModeRecord;
+
+	return true;
+}
+
+bool
+GameRecorder::replay(const util::string& path) noexcept
+{
+	this->close();
+
+	ifstream stream;
+	if (!stream.open(path))
+		return false;
+
+	auto size = stream.size();
+	if (size < (streamsize)(sizeof(RECORD_MAGIC) + sizeof(RECORD_VERSION)))
+		return false;
+
+	_replay.resize((std::size_t)size);
+	stream.read(_replay.data(), size);
+
+	if (stream.gcount() != size)
+	{
+		_replay.clear();
+		return false;
+	}
+
+	std::uint32_t magic = 0, version = 0;
+	if (!this->read(magic) || !this->read(version))
+		return false;
+
+	if (magic != RECORD_MAGIC || version != RECORD_VERSION)
+	{
+		_replay.clear();
+		_offset = 0;
+		return false;
+	}
+
+	_mode = GameRecordMode::GameRecordModeReplay;
+	return true;
+}
+
+void
+GameRecorder::close() noexcept
+{
+	if (_mode == GameRecordMode::GameRecordModeRecord)
+	{
+		this->flush();
+
+		// Entries which arrived after the last frame still belong to the session.
+		if (!_pending.empty())
+		{
+			_stream.write(_pending.data(), _pending.size());
+			_pending.clear();
+		}
+
+		_stream.close();
+	}
+
+	_mode = GameRecordMode::GameRecordModeNone;
+	_numFrames = 0;
+	_offset = 0;
+
+	_frame.clear();
+	_pending.clear();
+	_replay.clear();
+	_replay.shrink_to_fit();
+}
+
+GameRecordMode
+GameRecorder::getRecordMode() const noexcept
+{
+	return _mode;
+}
+
+bool
+GameRecorder::isRecording() const noexcept
+{
+	return _mode == GameRecordMode::GameRecordModeRecord;
+}
+
+bool
+GameRecorder::isReplaying() const noexcept
+{
+	return _mode == GameRecordMode::GameRecordModeReplay;
+}
+
+std::uint32_t
+GameRecorder::getNumFrames() const noexcept
+{
+	return _numFrames;
+}
+
+void
+GameRecorder::addInputEvent(const InputEvent& event, bool post) noexcept
+{
+	if (this->isRecording())
+		this->writeInputEvent(_pending, event, post);
+}
+
+void
+GameRecorder::addMessage(const MessagePtr& message, bool post) noexcept
+{
+	assert(message);
+
+	// Posted messages are taken while the frame runs, sent messages arrive between two frames.
+	if (this->isRecording())
+		this->writeMessage(post ? _frame : _pending, message, post);
+}
+
+void
+GameRecorder::addFrame(float delta) noexcept
+{
+	if (!this->isRecording())
+		return;
+
+	this->flush();
+
+	write(_frame, GameRecordEntryType::GameRecordEntryTypeFrame);
+	write(_frame, delta);
+
+	_frame.insert(_frame.end(), _pending.begin(), _pending.end());
+	_pending.clear();
+
+	_numFrames++;
+}
+
+bool
+GameRecorder::readFrame(GameRecordFrame& frame) noexcept
+{
+	if (!this->isReplaying())
+		return false;
+
+	frame.entries.clear();
+
+	GameRecordEntryType type;
+	if (!this->read(type) || type != GameRecordEntryType::GameRecordEntryTypeFrame)
+		return false;
+
+	if (!this->read(frame.delta))
+		return false;
+
+	while (_offset < _replay.size())
+	{
+		type = (GameRecordEntryType)_replay[_offset];
+		if (type == GameRecordEntryType::GameRecordEntryTypeFrame)
+			break;
+
+		_offset++;
+
+		GameRecordEntry entry;
+		entry.type = type;
+
+		switch (type)
+		{
+		case GameRecordEntryType::GameRecordEntryTypeInputSend:
+		case GameRecordEntryType::GameRecordEntryTypeInputPost:
+			if (!this->readInputEvent(entry))
+				return false;
+			break;
+		case GameRecordEntryType::GameRecordEntryTypeMessageSend:
+		case GameRecordEntryType::GameRecordEntryTypeMessagePost:
+			if (!this->readMessage(entry))
+				return false;
+			break;
+		default:
+			return false;
+		}
+
+		frame.entries.push_back(std::move(entry));
+	}
+
+	// Drop events point into the entry, fix them up once the entries stop moving.
+	for (auto& it : frame.entries)
+	{
+		if (!it.files.empty())
+		{
+			it.filenames.clear();
+			for (auto& file : it.files)
+				it.filenames.push_back(file.c_str());
+
+			it.event.drop.files = it.filenames.data();
+		}
+	}
+
+	_numFrames++;
+	return true;
+}
+
+void
+GameRecorder::flush() noexcept
+{
+	if (!_frame.empty())
+	{
+		_stream.write(_frame.data(), _frame.size());
+		_frame.clear();
+	}
+}
+
+void
+GameRecorder::writeInputEvent(std::vector<char>& buffer, const InputEvent& event, bool post) noexcept
+{
+	write(buffer, post ? GameRecordEntryType::GameRecordEntryTypeInputPost : GameRecordEntryType::GameRecordEntryTypeInputSend);
+	write(buffer, event);
+
+	if (event.event == InputEvent::Drop)
+	{
+		for (std::uint32_t i = 0; i < event.drop.count; i++)
+		{
+			auto length = (std::uint16_t)std::min<std::size_t>(std::strlen(event.drop.files[i]), std::numeric_limits<std::uint16_t>::max());
+			write(buffer, length);
+			buffer.insert(buffer.end(), event.drop.files[i], event.drop.files[i] + length);
+		}
+	}
+}
+
+void
+GameRecorder::writeMessage(std::vector<char>& buffer, const MessagePtr& message, bool post) noexcept
+{
+	auto& name = message->rtti()->type_name();
+	auto length = (std::uint8_t)std::min<std::size_t>(name.size(), std::numeric_limits<std::uint8_t>::max());
+
+	auto size = message->read(_payload.data(), _payload.size());
+	auto payloadSize = (std::uint32_t)std::max<std::streamsize>(size, 0);
+
+	write(buffer, post ? GameRecordEntryType::GameRecordEntryTypeMessagePost : GameRecordEntryType::GameRecordEntryTypeMessageSend);
+	write(buffer, length);
+	buffer.insert(buffer.end(), name.begin(), name.begin() + length);
+	write(buffer, payloadSize);
+	buffer.insert(buffer.end(), _payload.begin(), _payload.begin() + payloadSize);
+}
+
+bool
+GameRecorder::readInputEvent(GameRecordEntry& entry) noexcept
+{
+	if (!this->read(entry.event))
+		return false;
+
+	if (entry.event.event == InputEvent::Drop)
+	{
+		for (std::uint32_t i = 0; i < entry.event.drop.count; i++)
+		{
+			std::uint16_t length = 0;
+			if (!this->read(length) || _offset + length > _replay.size())
+				return false;
+
+			entry.files.emplace_back(_replay.data() + _offset, length);
+			_offset += length;
+		}
+
+		entry.event.drop.files = nullptr;
+	}
+
+	return true;
+}
+
+bool
+GameRecorder::readMessage(GameRecordEntry& entry) noexcept
+{
+	std::uint8_t length = 0;
+	if (!this->read(length) || _offset + length > _replay.size())
+		return false;
+
+	std::string name(_replay.data() + _offset, length);
+	_offset += length;
+
+	std::uint32_t payloadSize = 0;
+	if (!this->read(payloadSize) || _offset + payloadSize > _replay.size())
+		return false;
+
+	try
+	{
+		entry.message = rtti::Factory::instance()->make_shared<Message>(name);
+	}
+	catch (...)
+	{
+		entry.message = nullptr;
+	}
+
+	// A message that can no longer be created is skipped rather than breaking the rest of the session.
+	if (entry.message && payloadSize > 0)
+		entry.message->write(_replay.data() + _offset, payloadSize);
+
+	_offset += payloadSize;
+	return true;
+}
+
+bool
+GameRecorder::read(void* data, std::size_t size) noexcept
+{
+	if (_offset + size > _replay.size())
+		return false;
+
+	std::memcpy(data, _replay.data() + _offset, size);
+	_offset += size;
+
+	return true;
+}
+
+_NAME_END
@@ -38,6 +38,12 @@
 #include <ray/game_scene.h>
 #include <ray/game_features.h>
 #include <ray/game_listener.h>
+#include <ray/game_recorder.h>
+#include <ray/profiler.h>
+
+#if defined(_BUILD_INPUT)
+#	include <ray/input_feature.h>
+#endif
 
 _NAME_BEGIN
 
@@ -166,6 +172,18 @@ GameServer::getGameListener() const noexcept
 	return _gameListener;
 }
 
+void
+GameServer::setGameRecorder(const GameRecorderPtr& recorder) noexcept
+{
+	_gameRecorder = recorder;
+}
+
+const GameRecorderPtr&
+GameServer::getGameRecorder() const noexcept
+{
+	return _gameRecorder;
+}
+
 bool
 GameServer::isActive() const noexcept
 {
@@ -545,27 +563,126 @@ GameServer::update() noexcept
 	if (this->isQuitRequest() || !this->isActive() || this->isStopping())
 		return;
 
+	__ProfileScope("GameServer::update");
+
 	try
 	{
-		_timer->update();
+		GameRecordFrame frame;
 
-		MessagePtr event;
-		while (_dispatcher.pollMessages(event))
+		bool isRecording = _gameRecorder && _gameRecorder->isRecording();
+		bool isReplaying = _gameRecorder && _gameRecorder->isReplaying();
+
+		if (isReplaying)
 		{
-			if (!this->sendMessage(event))
+			if (!_gameRecorder->readFrame(frame))
+			{
+				if (_gameListener)
+					_gameListener->onMessage("GameServer : Replay finished.");
+
 				_isQuitRequest = true;
+				return;
+			}
+
+			// Everything which reached the server between two frames is fed back before the frame starts.
+			for (auto& it : frame.entries)
+			{
+				switch (it.type)
+				{
+#if defined(_BUILD_INPUT)
+				case GameRecordEntryType::GameRecordEntryTypeInputSend:
+				case GameRecordEntryType::GameRecordEntryTypeInputPost:
+				{
+					auto inputFeature = this->getFeature<InputFeature>();
+					if (inputFeature)
+					{
+						if (it.type == GameRecordEntryType::GameRecordEntryTypeInputSend)
+							inputFeature->sendInputEvent(it.event);
+						else
+							inputFeature->postInputEvent(it.event);
+					}
+				}
+				break;
+#endif
+				case GameRecordEntryType::GameRecordEntryTypeMessageSend:
+					if (it.message)
+						this->sendMessage(it.message);
+					break;
+				default:
+					break;
+				}
+			}
+
+			_timer->update(frame.delta);
+		}
+		else
+		{
+			_timer->update();
+
+			if (isRecording)
+				_gameRecorder->addFrame(_timer->delta());
+		}
+
+		{
+			__ProfileScope("GameServer::pollMessages");
+
+			MessagePtr event;
+			while (_dispatcher.pollMessages(event))
+			{
+				// The posted messages of a replayed frame come from the log, what the session posts again is dropped.
+				if (isReplaying)
+					continue;
+
+				if (isRecording)
+					_gameRecorder->addMessage(event, true);
+
+				if (!this->sendMessage(event))
+					_isQuitRequest = true;
+			}
+
+			if (isReplaying)
+			{
+				for (auto& it : frame.entries)
+				{
+					if (it.type == GameRecordEntryType::GameRecordEntryTypeMessagePost && it.message)
+					{
+						if (!this->sendMessage(it.message))
+							_isQuitRequest = true;
+					}
+				}
+			}
 		}
 
 		if (!_isQuitRequest)
 		{
-			for (auto& it : _features)
-				it->onFrameBegin();
+			{
+				__ProfileScope("GameServer::onFrameBegin");
 
-			for (auto& it : _features)
-				it->onFrame();
+				for (auto& it : _features)
+				{
+					__ProfileScope(it->rtti()->type_name().c_str());
+					it->onFrameBegin();
+				}
+			}
+
+			{
+				__ProfileScope("GameServer::onFrame");
 
-			for (auto& it : _features)
-				it->onFrameEnd();
+				for (auto& it : _features)
+				{
+					__ProfileScope(it->rtti()->type_name().c_str());
+					it->onFrame();
+				}
+			}
+
+			{
+				__ProfileScope("GameServer::onFrameEnd");
+
+				for (auto& it : _features)
+				{
+					__ProfileScope(it->rtti()->type_name().c_str());
+					it->onFrameEnd();
+				}
+			}
 		}
 	}
 	catch (const exception& e)
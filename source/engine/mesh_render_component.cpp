@@ -41,9 +41,12 @@
 #include <ray/render_system.h>
 #include <ray/geometry.h>
 #include <ray/material.h>
+#include <ray/camera.h>
 
 #include <ray/game_server.h>
+#include <ray/game_listener.h>
 #include <ray/graphics_context.h>
+#include <ray/graphics_input_layout.h>
 
 #include <ray/res_manager.h>
 
@@ -51,14 +54,23 @@ _NAME_BEGIN
 
 __ImplementSubClass(MeshRenderComponent, RenderComponent, "MeshRender")
 
+const float kLodPixelError = 1.0f;
+const float kLodHysteresis = 0.1f;
+
 MeshRenderComponent::MeshRenderComponent() noexcept
 	: _isCastShadow(true)
 	, _isReceiveShadow(true)
+	, _quantize(0)
+	, _isClusterCulling(false)
+	, _lodLevel(0)
+	, _lodRadius(0.0f)
 	, _onMeshChange(std::bind(&MeshRenderComponent::onMeshChange, this))
+	, _renderMeshQuantize(0)
 {
 }
 
 MeshRenderComponent::MeshRenderComponent(const MaterialPtr& material, bool shared) noexcept
+	: MeshRenderComponent()
 {
 	if (shared)
 		this->setSharedMaterial(material);
@@ -67,6 +79,7 @@ MeshRenderComponent::MeshRenderComponent(const MaterialPtr& material, bool share
 }
 
 MeshRenderComponent::MeshRenderComponent(const MaterialPtr&& material, bool shared) noexcept
+	: MeshRenderComponent()
 {
 	if (shared)
 		this->setSharedMaterial(material);
@@ -75,6 +88,7 @@ MeshRenderComponent::MeshRenderComponent(const MaterialPtr&& material, bool shar
 }
 
 MeshRenderComponent::MeshRenderComponent(const Materials& materials, bool shared) noexcept
+	: MeshRenderComponent()
 {
 	if (shared)
 		this->setSharedMaterials(materials);
@@ -83,6 +97,7 @@ MeshRenderComponent::MeshRenderComponent(const Materials& materials, bool shared
 }
 
 MeshRenderComponent::MeshRenderComponent(Materials&& materials, bool shared) noexcept
+	: MeshRenderComponent()
 {
 	if (shared)
 		this->setSharedMaterials(materials);
@@ -126,6 +141,30 @@ MeshRenderComponent::getReceiveShadow() const noexcept
 	return _isReceiveShadow;
 }
 
+void
+MeshRenderComponent::setQuantize(ModelQuantizeFlags quantize) noexcept
+{
+	_quantize = quantize;
+}
+
+ModelQuantizeFlags
+MeshRenderComponent::getQuantize() const noexcept
+{
+	return _quantize;
+}
+
+void
+MeshRenderComponent::setClusterCulling(bool enable) noexcept
+{
+	_isClusterCulling = enable;
+}
+
+bool
+MeshRenderComponent::getClusterCulling() const noexcept
+{
+	return _isClusterCulling;
+}
+
 void
 MeshRenderComponent::setMaterial(const MaterialPtr& material) noexcept
 {
@@ -293,6 +332,8 @@ MeshRenderComponent::load(const archivebuf& reader) noexcept
 	reader["material"] >> _material;
 	reader["castshadow"] >> _isCastShadow;
 	reader["receiveshadow"] >> _isReceiveShadow;
+	reader["quantize"] >> _quantize;
+	reader["clusterculling"] >> _isClusterCulling;
 }
 
 void
@@ -303,6 +344,8 @@ MeshRenderComponent::save(archivebuf& write) noexcept
 	write["material"] << _material;
 	write["castshadow"] << _isCastShadow;
 	write["receiveshadow"] << _isReceiveShadow;
+	write["quantize"] << _quantize;
+	write["clusterculling"] << _isClusterCulling;
 }
 
 GameComponentPtr
@@ -313,9 +356,12 @@ MeshRenderComponent::clone() const noexcept
 	result->setActive(this->getActive());
 	result->setCastShadow(this->getCastShadow());
 	result->setReceiveShadow(this->getReceiveShadow());
+	result->setQuantize(this->getQuantize());
+	result->setClusterCulling(this->getClusterCulling());
 	result->setSharedMaterials(this->getMaterials());
 	result->_material = this->_material;
 	result->_renderMeshVbo = this->_renderMeshVbo;
+	result->_renderMeshQuantize = this->_renderMeshQuantize;
 	result->_renderMeshIbo = this->_renderMeshIbo;
 
 	for (auto& material : this->getMaterials())
@@ -468,10 +514,17 @@ MeshRenderComponent::_buildRenderObjects(const MeshProperty& mesh, ModelMakerFla
 		_renderObjects.clear();
 	}
 
+	ModelQuantizeFlags quantize = this->_selectQuantize();
+	if (quantize != _renderMeshQuantize)
+	{
+		_renderMeshVbo.reset();
+		_renderMeshQuantize = quantize;
+	}
+
 	if (mesh.getNumVertices())
 	{
 		if (!_renderMeshVbo)
-			_renderMeshVbo = ResManager::instance()->createVertexBuffer(mesh, flags);
+			_renderMeshVbo = ResManager::instance()->createVertexBuffer(mesh, flags, quantize);
 
 		if (!_renderMeshVbo)
 			return false;
@@ -486,12 +539,38 @@ MeshRenderComponent::_buildRenderObjects(const MeshProperty& mesh, ModelMakerFla
 			return false;
 	}
 
+	float3 positionScale, positionBias;
+	float4 texcoordScaleBias;
+	ResManager::instance()->getQuantizeRange(mesh, quantize, positionScale, positionBias, texcoordScaleBias);
+
+	const auto& levels = mesh.getMeshLevels();
+
+	_lodLevel = 0;
+	_lodRadius = 0.0f;
+	_lodErrors.clear();
+
+	if (!levels.empty())
+	{
+		BoundingBox bound;
+		for (auto& it : mesh.getMeshSubsets())
+			bound.encapsulate(it.boundingBox);
+
+		_lodRadius = bound.radius();
+		_lodErrors.push_back(0.0f);
+
+		for (auto& it : levels)
+			_lodErrors.push_back(it.error);
+	}
+
 	auto& meshes = mesh.getMeshSubsets();
-	for (auto& it : meshes)
+	for (std::size_t i = 0; i < meshes.size(); i++)
 	{
+		auto& it = meshes[i];
+
 		auto renderObject = std::make_shared<Geometry>();
 		renderObject->setVertexBuffer(_renderMeshVbo, it.offsetVertices);
-		renderObject->setIndexBuffer(_renderMeshIbo, it.offsetIndices, GraphicsIndexType::GraphicsIndexTypeUInt32);
+		renderObject->setIndexBuffer(_renderMeshIbo, it.offsetIndices, ResManager::instance()->getIndexType(mesh));
+		renderObject->setQuantize(positionScale, positionBias, texcoordScaleBias);
 		renderObject->setBoundingBox(it.boundingBox);
 		renderObject->setOwnerListener(this);
 		renderObject->setCastShadow(this->getCastShadow());
@@ -500,6 +579,34 @@ MeshRenderComponent::_buildRenderObjects(const MeshProperty& mesh, ModelMakerFla
 		renderObject->setTransform(this->getGameObject()->getWorldTransform(), this->getGameObject()->getWorldTransformInverse());
 		renderObject->setGraphicsIndirect(std::make_shared<GraphicsIndirect>(it.indicesCount * 3, it.indicesCount, 1, it.startVertices, it.startIndices));
 
+		if (!levels.empty())
+		{
+			GraphicsIndirects renderables;
+			renderables.push_back(renderObject->getGraphicsIndirect());
+
+			for (std::size_t level = 0; level < levels.size(); level++)
+			{
+				auto& subset = levels[level].subsets[i];
+				auto startIndice = ResManager::instance()->getLevelStartIndice(mesh, level + 1) + subset.startIndices;
+				renderables.push_back(std::make_shared<GraphicsIndirect>(subset.indicesCount * 3, subset.indicesCount, 1, subset.startVertices, startIndice));
+			}
+
+			renderObject->setGraphicsIndirectLevels(renderables);
+		}
+
+		if (_isClusterCulling)
+		{
+			GraphicsClusters clusters;
+
+			for (auto& cluster : mesh.getMeshClusters())
+			{
+				if (cluster.startIndices >= it.startIndices && cluster.startIndices + cluster.indicesCount <= it.startIndices + it.indicesCount)
+					clusters.push_back(GraphicsCluster(cluster.center, cluster.radius, cluster.coneAxis, cluster.coneCutoff, cluster.startIndices, cluster.indicesCount));
+			}
+
+			renderObject->setGraphicsClusters(clusters);
+		}
+
 		_renderObjects.push_back(renderObject);
 	};
 
@@ -507,6 +614,91 @@ MeshRenderComponent::_buildRenderObjects(const MeshProperty& mesh, ModelMakerFla
 	return true;
 }
 
+void
+MeshRenderComponent::onRenderObjectVisiable(RenderObject& object, const Camera& camera, float distanceSqrt) noexcept
+{
+	if (_lodErrors.empty() || camera.getCameraOrder() != CameraOrder::CameraOrder3D)
+		return;
+
+	const float3& scale = this->getGameObject()->getWorldScale();
+	float radius = _lodRadius * std::max(std::abs(scale.x), std::max(std::abs(scale.y), std::abs(scale.z)));
+	float screenRadius = radius * camera.getProject().b2 * camera.getPixelViewport().w * 0.5f;
+
+	if (camera.getCameraType() != CameraType::CameraTypeOrtho)
+		screenRadius /= std::max(std::sqrt(distanceSqrt), camera.getNear());
+
+	screenRadius *= RenderSystem::instance()->getRenderSetting().lodBias;
+
+	std::size_t level = this->_selectLevel(screenRadius);
+	if (level > _lodLevel)
+		level = std::max(_lodLevel, this->_selectLevel(screenRadius * (1.0f + kLodHysteresis)));
+	else if (level < _lodLevel)
+		level = std::min(_lodLevel, this->_selectLevel(screenRadius * (1.0f - kLodHysteresis)));
+
+	if (level != _lodLevel)
+	{
+		for (auto& it : _renderObjects)
+			it->setLevel(level);
+
+		_lodLevel = level;
+	}
+}
+
+ModelQuantizeFlags
+MeshRenderComponent::_selectQuantize() const noexcept
+{
+	ModelQuantizeFlags quantize = 0;
+	ModelQuantizeFlags quantizeMask = 0;
+
+	auto& materials = _materials.empty() ? _sharedMaterials : _materials;
+	for (auto& material : materials)
+	{
+		for (auto& technique : material->getTechs())
+		{
+			for (auto& pass : technique->getPassList())
+			{
+				auto& inputLayout = pass->getGraphicsInputLayout();
+				if (!inputLayout)
+					continue;
+
+				ModelQuantizeFlags mask = 0;
+				ModelQuantizeFlags flags = ResManager::instance()->getQuantizeFlags(inputLayout->getGraphicsInputLayoutDesc(), mask);
+
+				if ((flags ^ quantize) & mask & quantizeMask)
+				{
+					auto& listener = GameServer::instance()->getGameListener();
+					if (listener)
+						listener->onMessage("MeshRenderComponent : Materials of " + this->getGameObject()->getName() + " read different vertex formats, using float vertices.");
+
+					return 0;
+				}
+
+				quantize |= flags;
+				quantizeMask |= mask;
+			}
+		}
+	}
+
+	// a profile may cover attributes the material doesn't read, such as colors, only the ones it reads have to match
+	if (_quantize && (_quantize ^ quantize) & quantizeMask)
+	{
+		auto& listener = GameServer::instance()->getGameListener();
+		if (listener)
+			listener->onMessage("MeshRenderComponent : Quantize flags of " + this->getGameObject()->getName() + " don't match the input layout of its material, using the input layout.");
+	}
+
+	return quantize;
+}
+
+std::size_t
+MeshRenderComponent::_selectLevel(float screenRadius) const noexcept
+{
+	std::size_t level = 0;
+	while (level + 1 < _lodErrors.size() && _lodErrors[level + 1] * screenRadius <= kLodPixelError)
+		level++;
+	return level;
+}
+
 void
 MeshRenderComponent::_updateMaterial(std::size_t n) noexcept
 {
@@ -42,6 +42,14 @@ _NAME_BEGIN
 __ImplementSubClass(PhysicFeatures, GameFeature, "PhysicFeatures")
 
 PhysicFeatures::PhysicFeatures() noexcept
+{
+	_setting.aabb.min = Vector3(-10000.0f, -10000.0f, -10000.0f);
+	_setting.aabb.max = Vector3(10000.0f, 10000.0f, 10000.0f);
+	_setting.gravity = Vector3(0.0f, -9.81f * 2.0f, 0.0f);
+}
+
+PhysicFeatures::PhysicFeatures(const PhysicsScene::Setting& setting) noexcept
+	: _setting(setting)
 {
 }
 
@@ -49,10 +57,22 @@ PhysicFeatures::~PhysicFeatures() noexcept
 {
 }
 
+void
+PhysicFeatures::setPhysicsSetting(const PhysicsScene::Setting& setting) noexcept
+{
+	_setting = setting;
+}
+
+const PhysicsScene::Setting&
+PhysicFeatures::getPhysicsSetting() const noexcept
+{
+	return _setting;
+}
+
 void
 PhysicFeatures::onActivate() except
 {
-	if (!PhysicsSystem::instance()->open())
+	if (!PhysicsSystem::instance()->open(_setting))
 		throw failure("PhysicsSystem::instance() fail.");
 }
 
@@ -62,6 +82,12 @@ PhysicFeatures::onDeactivate() noexcept
 	PhysicsSystem::instance()->close();
 }
 
+void
+PhysicFeatures::onFrameBegin() noexcept
+{
+	PhysicsSystem::instance()->fetchResult();
+}
+
 void
 PhysicFeatures::onFrameEnd() noexcept
 {
@@ -71,7 +97,7 @@ PhysicFeatures::onFrameEnd() noexcept
 GameFeaturePtr
 PhysicFeatures::clone() const noexcept
 {
-	return std::make_shared<PhysicFeatures>();
+	return std::make_shared<PhysicFeatures>(_setting);
 }
 
 _NAME_END
\ No newline at end of file
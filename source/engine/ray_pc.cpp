@@ -38,6 +38,7 @@
 #include <ray/ray_main.h>
 
 #include <ray/game_application.h>
+#include <ray/game_recorder.h>
 
 #include <ray/fcntl.h>
 
@@ -63,6 +64,8 @@ ray::InputMousePtr _inputMessage;
 
 ray::util::string _gameRootPath;
 ray::util::string _gameScenePath;
+ray::util::string _gameRecordPath;
+ray::GameRecordMode _gameRecordMode = ray::GameRecordModeNone;
 
 ray::InputKey::Code KeyCodetoInputKey(int key) noexcept
 {
@@ -410,6 +413,72 @@ void RAY_CALL rayInit(const char* gamedir, const char* scenename) noexcept
 		_gameScenePath = scenename;
 }
 
+void RAY_CALL rayRecord(const char* path) noexcept
+{
+	_gameRecordPath = path ? path : "";
+	_gameRecordMode = path ? ray::GameRecordModeRecord : ray::GameRecordModeNone;
+}
+
+void RAY_CALL rayReplay(const char* path) noexcept
+{
+	_gameRecordPath = path ? path : "";
+	_gameRecordMode = path ? ray::GameRecordModeReplay : ray::GameRecordModeNone;
+}
+
+bool rayOpenRecorder() noexcept
+{
+	switch (_gameRecordMode)
+	{
+	case ray::GameRecordModeRecord:
+		return _gameApp->record(_gameRecordPath);
+	case ray::GameRecordModeReplay:
+		return _gameApp->replay(_gameRecordPath);
+	default:
+		return true;
+	}
+}
+
+bool RAY_CALL rayOpenHeadless() noexcept
+{
+	assert(!_gameApp && !_window);
+
+	try
+	{
+		_gameApp = std::make_shared<ray::GameApplication>();
+		_gameApp->setFileService(true);
+		_gameApp->setFileServiceListener(true);
+		_gameApp->setFileServicePath(_gameRootPath);
+
+		if (!_gameApp->openHeadless())
+		{
+			rayCloseWindow();
+			return false;
+		}
+
+		if (!_gameScenePath.empty())
+		{
+			if (!_gameApp->openScene(_gameScenePath))
+			{
+				rayCloseWindow();
+				return false;
+			}
+		}
+
+		if (!rayOpenRecorder())
+		{
+			rayCloseWindow();
+			return false;
+		}
+
+		return _gameApp->start();
+	}
+	catch (...)
+	{
+		rayCloseWindow();
+		return false;
+	}
+}
+
 bool RAY_CALL rayOpenWindow(const char* title, int w, int h) noexcept
 {
 	assert(!_gameApp && !_window);
@@ -479,10 +548,18 @@ bool RAY_CALL rayOpenWindow(const char* title, int w, int h) noexcept
 				}
 			}
 
+			if (!rayOpenRecorder())
+			{
+				rayCloseWindow();
+				return false;
+			}
+
 			if (!_gameApp->start())
 				return false;
 
-			::glfwShowWindow(_window);
+			if (_gameRecordMode != ray::GameRecordModeReplay)
+				::glfwShowWindow(_window);
+
 			return true;
 		}
 
@@ -517,7 +594,10 @@ bool RAY_CALL rayIsQuitRequest() noexcept
 	if (!_gameApp)
 		return true;
 
-	if (glfwWindowShouldClose(_window) || _gameApp->isQuitRequest())
+	if (_window && glfwWindowShouldClose(_window))
+		return true;
+
+	if (_gameApp->isQuitRequest())
 		return true;
 
 	return false;
@@ -525,7 +605,8 @@ bool RAY_CALL rayIsQuitRequest() noexcept
 
 void RAY_CALL rayUpdate() noexcept
 {
-	::glfwPollEvents();
+	if (_window)
+		::glfwPollEvents();
 
 	if (_gameApp)
 		_gameApp->update();
@@ -57,6 +57,10 @@
 #include <ray/image.h>
 #include <ray/material.h>
 #include <ray/anim_component.h>
+#include <ray/game_server.h>
+#include <ray/game_listener.h>
+
+#include <cstdio>
 
 _NAME_BEGIN
 
@@ -228,7 +232,7 @@ ResManager::addTextureCache(const char* name, const GraphicsTexturePtr& texture)
 }
 
 bool
-ResManager::createModel(const util::string& filename, ModelPtr& model) noexcept
+ResManager::createModel(const util::string& filename, ModelPtr& model, MeshOptimizeFlags optimize, std::size_t levels) noexcept
 {
 	StreamReaderPtr stream;
 	if (IoServer::instance()->openFileURL(stream, filename))
@@ -236,7 +240,38 @@ ResManager::createModel(const util::string& filename, ModelPtr& model) noexcept
 		if (!model)
 			model = std::make_shared<Model>();
 
-		return model->load(*stream);
+		if (!model->load(*stream))
+			return false;
+
+		if (optimize)
+		{
+			auto& listener = GameServer::instance()->getGameListener();
+
+			for (auto& mesh : model->getMeshsList())
+			{
+				MeshOptimizeStats stats;
+				optimizeMesh(*mesh, optimize, &stats);
+
+				if (listener)
+				{
+					char message[128];
+					std::snprintf(message, sizeof(message), "vertices %zu -> %zu, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f.",
+						stats.numVerticesBefore, stats.numVerticesAfter,
+						stats.acmrBefore, stats.acmrAfter,
+						stats.atvrBefore, stats.atvrAfter);
+
+					listener->onMessage("ResManager : Optimized mesh " + mesh->getName() + " of " + filename + " : " + message);
+				}
+			}
+		}
+
+		if (levels)
+		{
+			for (auto& mesh : model->getMeshsList())
+				makeMeshLevels(*mesh, levels);
+		}
+
+		return true;
 	}
 
 	return false;
@@ -333,28 +368,99 @@ ResManager::createIndexBuffer(const MeshProperty& mesh) noexcept
 	GraphicsDataDesc _ib;
 	_ib.setType(GraphicsDataType::GraphicsDataTypeStorageIndexBuffer);
 	_ib.setUsage(GraphicsUsageFlagBits::GraphicsUsageFlagReadBit);
+
+	const auto& levels = mesh.getMeshLevels();
+
+	if (this->getIndexType(mesh) == GraphicsIndexType::GraphicsIndexTypeUInt16)
+	{
+		std::vector<std::uint16_t> indices(mesh.getIndicesArray().begin(), mesh.getIndicesArray().end());
+		for (auto& it : levels)
+			indices.insert(indices.end(), it.indices.begin(), it.indices.end());
+
+		_ib.setStream((std::uint8_t*)indices.data());
+		_ib.setStreamSize(indices.size() * sizeof(std::uint16_t));
+
+		return RenderSystem::instance()->createGraphicsData(_ib);
+	}
+
+	if (!levels.empty())
+	{
+		std::vector<std::uint32_t> indices(mesh.getIndicesArray().begin(), mesh.getIndicesArray().end());
+		for (auto& it : levels)
+			indices.insert(indices.end(), it.indices.begin(), it.indices.end());
+
+		_ib.setStream((std::uint8_t*)indices.data());
+		_ib.setStreamSize(indices.size() * sizeof(std::uint32_t));
+
+		return RenderSystem::instance()->createGraphicsData(_ib);
+	}
+
 	_ib.setStream((std::uint8_t*)mesh.getIndicesArray().data());
 	_ib.setStreamSize(numIndices * sizeof(std::uint32_t));
 
 	return RenderSystem::instance()->createGraphicsData(_ib);
 }
 
+std::size_t
+ResManager::getLevelStartIndice(const MeshProperty& mesh, std::size_t level) const noexcept
+{
+	const auto& levels = mesh.getMeshLevels();
+	assert(level <= levels.size());
+
+	if (level == 0)
+		return 0;
+
+	std::size_t start = mesh.getNumIndices();
+	for (std::size_t i = 0; i < level - 1; i++)
+		start += levels[i].indices.size();
+
+	return start;
+}
+
+GraphicsIndexType
+ResManager::getIndexType(const MeshProperty& mesh) const noexcept
+{
+	if (mesh.getNumVertices() < std::numeric_limits<std::uint16_t>::max() + 1)
+		return GraphicsIndexType::GraphicsIndexTypeUInt16;
+	return GraphicsIndexType::GraphicsIndexTypeUInt32;
+}
+
 GraphicsDataPtr
-ResManager::createVertexBuffer(const MeshProperty& mesh, ModelMakerFlags flags) noexcept
+ResManager::createVertexBuffer(const MeshProperty& mesh, ModelMakerFlags flags, ModelQuantizeFlags quantize) noexcept
 {
 	std::size_t numVertex = mesh.getNumVertices();
 	if (numVertex == 0)
 		return nullptr;
 
+	GraphicsFormat positionFormat = GraphicsFormat::GraphicsFormatR32G32B32SFloat;
+	if (quantize & ModelQuantizeFlagBits::ModelQuantizeFlagBitPositionHalf)
+		positionFormat = GraphicsFormat::GraphicsFormatR16G16B16A16SFloat;
+	else if (quantize & ModelQuantizeFlagBits::ModelQuantizeFlagBitPositionUNorm16)
+		positionFormat = GraphicsFormat::GraphicsFormatR16G16B16A16UNorm;
+
+	GraphicsFormat colorFormat = GraphicsFormat::GraphicsFormatR32G32B32A32SFloat;
+	if (quantize & ModelQuantizeFlagBits::ModelQuantizeFlagBitColorUNorm8)
+		colorFormat = GraphicsFormat::GraphicsFormatR8G8B8A8UNorm;
+
+	GraphicsFormat texcoordFormat = GraphicsFormat::GraphicsFormatR32G32SFloat;
+	if (quantize & ModelQuantizeFlagBits::ModelQuantizeFlagBitTexcoordHalf)
+		texcoordFormat = GraphicsFormat::GraphicsFormatR16G16SFloat;
+	else if (quantize & ModelQuantizeFlagBits::ModelQuantizeFlagBitTexcoordUNorm16)
+		texcoordFormat = GraphicsFormat::GraphicsFormatR16G16UNorm;
+
+	float3 positionScale, positionBias;
+	float4 texcoordScaleBias;
+	this->getQuantizeRange(mesh, quantize, positionScale, positionBias, texcoordScaleBias);
+
 	std::uint32_t inputSize = 0;
 	if (!mesh.getVertexArray().empty() && flags & ModelMakerFlagBits::ModelMakerFlagBitVertex)
-		inputSize += GraphicsVertexLayout::getVertexSize(GraphicsFormat::GraphicsFormatR32G32B32SFloat);
+		inputSize += GraphicsVertexLayout::getVertexSize(positionFormat);
 	if (!mesh.getTangentArray().empty() && flags & ModelMakerFlagBits::ModelMakerFlagBitTangentQuat)
 		inputSize += GraphicsVertexLayout::getVertexSize(GraphicsFormat::GraphicsFormatR8G8B8A8UNorm);
 	if (!mesh.getColorArray().empty() && flags & ModelMakerFlagBits::ModelMakerFlagBitColor)
-		inputSize += GraphicsVertexLayout::getVertexSize(GraphicsFormat::GraphicsFormatR32G32B32A32SFloat);
+		inputSize += GraphicsVertexLayout::getVertexSize(colorFormat);
 	if (!mesh.getTexcoordArray().empty() && flags & ModelMakerFlagBits::ModelMakerFlagBitTexcoord)
-		inputSize += GraphicsVertexLayout::getVertexSize(GraphicsFormat::GraphicsFormatR32G32SFloat);
+		inputSize += GraphicsVertexLayout::getVertexSize(texcoordFormat);
 	if (!mesh.getWeightArray().empty() && flags & ModelMakerFlagBits::ModelMakerFlagBitWeight)
 	{
 		inputSize += GraphicsVertexLayout::getVertexSize(GraphicsFormat::GraphicsFormatR8G8B8A8UNorm);
@@ -378,11 +484,33 @@ ResManager::createVertexBuffer(const MeshProperty& mesh, ModelMakerFlags flags)
 			std::uint8_t* data = mapBuffer + offset1 + offsetVertices;
 			for (auto& it : vertices)
 			{
-				*(float3*)data = it;
+				float3 v = (it - positionBias) / positionScale;
+
+				if (positionFormat == GraphicsFormat::GraphicsFormatR16G16B16A16SFloat)
+				{
+					std::uint16_t* half = (std::uint16_t*)data;
+					half[0] = math::fpToHalf(v.x);
+					half[1] = math::fpToHalf(v.y);
+					half[2] = math::fpToHalf(v.z);
+					half[3] = math::fpToHalf(1.0f);
+				}
+				else if (positionFormat == GraphicsFormat::GraphicsFormatR16G16B16A16UNorm)
+				{
+					std::uint16_t* unorm = (std::uint16_t*)data;
+					unorm[0] = math::fpToInt16UNORM(math::saturate(v.x) + 0.5f / 65535.0f);
+					unorm[1] = math::fpToInt16UNORM(math::saturate(v.y) + 0.5f / 65535.0f);
+					unorm[2] = math::fpToInt16UNORM(math::saturate(v.z) + 0.5f / 65535.0f);
+					unorm[3] = std::numeric_limits<std::uint16_t>::max();
+				}
+				else
+				{
+					*(float3*)data = it;
+				}
+
 				data += inputSize;
 			}
 
-			offset1 += sizeof(float3);
+			offset1 += GraphicsVertexLayout::getVertexSize(positionFormat);
 		}
 
 		if (!tangents.empty() && flags & ModelMakerFlagBits::ModelMakerFlagBitTangentQuat)
@@ -412,11 +540,22 @@ ResManager::createVertexBuffer(const MeshProperty& mesh, ModelMakerFlags flags)
 			std::uint8_t* data = mapBuffer + offset1 + offsetVertices;
 			for (auto& it : colors)
 			{
-				*(float4*)data = it;
+				if (colorFormat == GraphicsFormat::GraphicsFormatR8G8B8A8UNorm)
+				{
+					data[0] = math::fpToInt8UNORM(math::saturate(it.x) + 0.5f / 255.0f);
+					data[1] = math::fpToInt8UNORM(math::saturate(it.y) + 0.5f / 255.0f);
+					data[2] = math::fpToInt8UNORM(math::saturate(it.z) + 0.5f / 255.0f);
+					data[3] = math::fpToInt8UNORM(math::saturate(it.w) + 0.5f / 255.0f);
+				}
+				else
+				{
+					*(float4*)data = it;
+				}
+
 				data += inputSize;
 			}
 
-			offset1 += sizeof(float4);
+			offset1 += GraphicsVertexLayout::getVertexSize(colorFormat);
 		}
 
 		if (!texcoords.empty() && flags & ModelMakerFlagBits::ModelMakerFlagBitTexcoord)
@@ -424,11 +563,29 @@ ResManager::createVertexBuffer(const MeshProperty& mesh, ModelMakerFlags flags)
 			std::uint8_t* data = mapBuffer + offset1 + offsetVertices;
 			for (auto& it : texcoords)
 			{
-				*(float2*)data = it;
+				float2 uv = (it - texcoordScaleBias.zw()) / texcoordScaleBias.xy();
+
+				if (texcoordFormat == GraphicsFormat::GraphicsFormatR16G16SFloat)
+				{
+					std::uint16_t* half = (std::uint16_t*)data;
+					half[0] = math::fpToHalf(uv.x);
+					half[1] = math::fpToHalf(uv.y);
+				}
+				else if (texcoordFormat == GraphicsFormat::GraphicsFormatR16G16UNorm)
+				{
+					std::uint16_t* unorm = (std::uint16_t*)data;
+					unorm[0] = math::fpToInt16UNORM(math::saturate(uv.x) + 0.5f / 65535.0f);
+					unorm[1] = math::fpToInt16UNORM(math::saturate(uv.y) + 0.5f / 65535.0f);
+				}
+				else
+				{
+					*(float2*)data = it;
+				}
+
 				data += inputSize;
 			}
 
-			offset1 += sizeof(float2);
+			offset1 += GraphicsVertexLayout::getVertexSize(texcoordFormat);
 		}
 
 		if (!weight.empty() && flags & ModelMakerFlagBits::ModelMakerFlagBitWeight)
@@ -468,6 +625,94 @@ ResManager::createVertexBuffer(const MeshProperty& mesh, ModelMakerFlags flags)
 	return RenderSystem::instance()->createGraphicsData(_vb);
 }
 
+void
+ResManager::getQuantizeRange(const MeshProperty& mesh, ModelQuantizeFlags quantize, float3& positionScale, float3& positionBias, float4& texcoordScaleBias) const noexcept
+{
+	positionScale = float3::One;
+	positionBias = float3::Zero;
+	texcoordScaleBias = float4(1.0f, 1.0f, 0.0f, 0.0f);
+
+	auto& vertices = mesh.getVertexArray();
+	if (!vertices.empty() && quantize & (ModelQuantizeFlagBits::ModelQuantizeFlagBitPositionHalf | ModelQuantizeFlagBits::ModelQuantizeFlagBitPositionUNorm16))
+	{
+		float3 minimum = vertices.front();
+		float3 maximum = vertices.front();
+
+		for (auto& it : vertices)
+		{
+			minimum = math::min(minimum, it);
+			maximum = math::max(maximum, it);
+		}
+
+		float3 size = math::max(maximum - minimum, float3(1e-6f));
+
+		if (quantize & ModelQuantizeFlagBits::ModelQuantizeFlagBitPositionHalf)
+		{
+			positionScale = size * 0.5f;
+			positionBias = (minimum + maximum) * 0.5f;
+		}
+		else
+		{
+			positionScale = size;
+			positionBias = minimum;
+		}
+	}
+
+	auto& texcoords = mesh.getTexcoordArray();
+	if (!texcoords.empty() && quantize & ModelQuantizeFlagBits::ModelQuantizeFlagBitTexcoordUNorm16)
+	{
+		float2 minimum = texcoords.front();
+		float2 maximum = texcoords.front();
+
+		for (auto& it : texcoords)
+		{
+			minimum = math::min(minimum, it);
+			maximum = math::max(maximum, it);
+		}
+
+		float2 size = math::max(maximum - minimum, float2(1e-6f));
+		texcoordScaleBias = float4(size.x, size.y, minimum.x, minimum.y);
+	}
+}
+
+ModelQuantizeFlags
+ResManager::getQuantizeFlags(const GraphicsInputLayoutDesc& inputLayout, ModelQuantizeFlags& mask) const noexcept
+{
+	ModelQuantizeFlags quantize = 0;
+	mask = 0;
+
+	for (auto& it : inputLayout.getVertexLayouts())
+	{
+		if (it.getSemantic() == "POSITION")
+		{
+			mask |= ModelQuantizeFlagBits::ModelQuantizeFlagBitPosition;
+
+			if (it.getVertexFormat() == GraphicsFormat::GraphicsFormatR16G16B16A16SFloat)
+				quantize |= ModelQuantizeFlagBits::ModelQuantizeFlagBitPositionHalf;
+			else if (it.getVertexFormat() == GraphicsFormat::GraphicsFormatR16G16B16A16UNorm)
+				quantize |= ModelQuantizeFlagBits::ModelQuantizeFlagBitPositionUNorm16;
+		}
+		else if (it.getSemantic() == "COLOR" && it.getSemanticIndex() == 0)
+		{
+			mask |= ModelQuantizeFlagBits::ModelQuantizeFlagBitColor;
+
+			if (it.getVertexFormat() == GraphicsFormat::GraphicsFormatR8G8B8A8UNorm)
+				quantize |= ModelQuantizeFlagBits::ModelQuantizeFlagBitColorUNorm8;
+		}
+		else if (it.getSemantic() == "TEXCOORD" && it.getSemanticIndex() == 0)
+		{
+			mask |= ModelQuantizeFlagBits::ModelQuantizeFlagBitTexcoord;
+
+			if (it.getVertexFormat() == GraphicsFormat::GraphicsFormatR16G16SFloat)
+				quantize |= ModelQuantizeFlagBits::ModelQuantizeFlagBitTexcoordHalf;
+			else if (it.getVertexFormat() == GraphicsFormat::GraphicsFormatR16G16UNorm)
+				quantize |= ModelQuantizeFlagBits::ModelQuantizeFlagBitTexcoordUNorm16;
+		}
+	}
+
+	return quantize;
+}
+
 bool
 ResManager::createBones(const Model& model, GameObjects& bones) noexcept
 {
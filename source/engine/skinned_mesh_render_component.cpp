@@ -115,7 +115,7 @@ SkinnedMeshRenderComponent::onActivate() except
 	{
 		GraphicsDataDesc jointDesc;
 		jointDesc.setStreamSize(sizeof(float4x4) * static_cast<std::uint16_t>(_transforms.size()));
-		jointDesc.setUsage(GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit);
+		jointDesc.setUsage(GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit | GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit);
 		jointDesc.setType(GraphicsDataType::GraphicsDataTypeUniformBuffer);
 
 		_jointData = RenderSystem::instance()->createGraphicsData(jointDesc);
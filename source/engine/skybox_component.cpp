@@ -447,7 +447,7 @@ SkyboxComponent::_buildSphereRenderObject(const MeshProperty& mesh, MaterialPtr
 	_sphereObject->setCastShadow(false);
 	_sphereObject->setReceiveShadow(false);
 	_sphereObject->setVertexBuffer(_renderSphereVbo, 0);
-	_sphereObject->setIndexBuffer(_renderSphereIbo, 0, GraphicsIndexType::GraphicsIndexTypeUInt32);
+	_sphereObject->setIndexBuffer(_renderSphereIbo, 0, ResManager::instance()->getIndexType(mesh));
 	_sphereObject->setBoundingBox(mesh.getBoundingBox());
 	_sphereObject->setOwnerListener(this);
 	_sphereObject->setCastShadow(this->getCastShadow());
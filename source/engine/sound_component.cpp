@@ -49,6 +49,7 @@ SoundComponent::SoundComponent() noexcept
 	, _pitch(1.0)
 	, _distanceMin(1.0)
 	, _distanceMax(5.0)
+	, _priority(128)
 	, _isLoop(false)
 	, _isPlayOnActivate(false)
 	, _isPause(false)
@@ -186,6 +187,23 @@ SoundComponent::getMinDistance() const noexcept
 	return _distanceMin;
 }
 
+void
+SoundComponent::setPriority(std::uint8_t priority) noexcept
+{
+	if (_priority != priority)
+	{
+		if (_sound)
+			_sound->setPriority(priority);
+		_priority = priority;
+	}
+}
+
+std::uint8_t
+SoundComponent::getPriority() const noexcept
+{
+	return _priority;
+}
+
 void
 SoundComponent::setSoundClip(const SoundClip& clip) noexcept
 {
@@ -227,6 +245,8 @@ SoundComponent::play() noexcept
 				_sound->setMinDistance(_distanceMin);
 				_sound->setMinDistance(_distanceMax);
 
+				_sound->setPriority(_priority);
+
 				_sound->setTranslate(actor->getTranslate());
 				_sound->setOrientation(actor->getForward(), actor->getUpVector());
 
@@ -325,6 +345,7 @@ SoundComponent::load(const archivebuf& reader) noexcept
 	reader["pitch"] >> _pitch;
 	reader["_distanceMin"] >> _distanceMin;
 	reader["_distanceMax"] >> _distanceMax;
+	reader["priority"] >> _priority;
 	reader["play"] >> _isPlayOnActivate;
 	reader["loop"] >> _isLoop;
 	reader["source"] >> _sourceName;
@@ -341,6 +362,7 @@ SoundComponent::save(archivebuf& write) noexcept
 	write["pitch"] << _pitch;
 	write["_distanceMin"] << _distanceMin;
 	write["_distanceMax"] << _distanceMax;
+	write["priority"] << _priority;
 	write["play"] << _isPlayOnActivate;
 	write["loop"] << _isLoop;
 	write["source"] << _sourceName;
@@ -356,6 +378,7 @@ SoundComponent::clone() const noexcept
 	component->_distanceMin = this->_distanceMin;
 	component->_distanceMax = this->_distanceMax;
 	component->_pitch = this->_pitch;
+	component->_priority = this->_priority;
 	component->_sourceName = this->_sourceName;
 	return component;
 }
@@ -36,6 +36,8 @@
 // +----------------------------------------------------------------------
 #include <ray/sound_feature.h>
 #include <ray/sound_system.h>
+#include <ray/game_server.h>
+#include <ray/timer.h>
 
 _NAME_BEGIN
 
@@ -62,4 +64,10 @@ SoundFeature::onDeactivate() noexcept
 	SoundSystem::instance()->close();
 }
 
+void
+SoundFeature::onFrameEnd() noexcept
+{
+	SoundSystem::instance()->update(this->getGameServer()->getTimer()->delta());
+}
+
 _NAME_END
\ No newline at end of file
@@ -204,7 +204,10 @@ OGLCoreDescriptorSet::apply(const OGLProgram& shaderObject) noexcept
 			if (buffer)
 			{
 				auto ubo = buffer->downcast<OGLCoreGraphicsData>();
-				glBindBufferBase(GL_UNIFORM_BUFFER, location, ubo->getInstanceID());
+				if (ubo->getGraphicsDataDesc().getUsage() & GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit)
+					glBindBufferRange(GL_UNIFORM_BUFFER, location, ubo->getInstanceID(), ubo->getBufferOffset(), ubo->getGraphicsDataDesc().getStreamSize());
+				else
+					glBindBufferBase(GL_UNIFORM_BUFFER, location, ubo->getInstanceID());
 			}
 		}
 		break;
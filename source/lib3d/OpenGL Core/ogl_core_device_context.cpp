@@ -91,12 +91,16 @@ OGLCoreDeviceContext::setup(const GraphicsContextDesc& desc) noexcept
 	if (!this->initStateSystem())
 		return false;
 
+	_timerQuery.setup();
+
 	return true;
 }
 
 void
 OGLCoreDeviceContext::close() noexcept
 {
+	_timerQuery.close();
+
 	_framebuffer.reset();
 	_program.reset();
 	_pipeline.reset();
@@ -370,7 +374,10 @@ OGLCoreDeviceContext::setVertexBufferData(std::uint32_t i, const GraphicsDataPtr
 	assert(_vertexBuffers.size() > i);
 	assert(_glcontext->getActive());
 
+	// streamed data moves to a new region on every map, so the binding offset is captured here
 	auto vbo = data->downcast_pointer<OGLCoreGraphicsData>();
+	offset += vbo->getBufferOffset();
+
 	if (_vertexBuffers[i].vbo != vbo || _vertexBuffers[i].offset != offset)
 	{
 		_vertexBuffers[i].vbo = vbo;
@@ -404,7 +411,7 @@ OGLCoreDeviceContext::setIndexBufferData(const GraphicsDataPtr& data, std::intpt
 	}
 
 	_indexType = OGLTypes::asIndexType(indexType);
-	_indexOffset = offset;
+	_indexOffset = offset + ibo->getBufferOffset();
 
 	if (_indexType == GL_INVALID_ENUM) this->getDevice()->downcast<OGLDevice>()->message("Invalid index type");
 }
@@ -745,7 +752,23 @@ OGLCoreDeviceContext::drawIndirect(const GraphicsDataPtr& data, std::size_t offs
 	assert(_glcontext->getActive());
 	assert(data && data->getGraphicsDataDesc().getType() == GraphicsDataType::GraphicsDataTypeIndirectBiffer);
 
-	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, data->downcast<OGLCoreGraphicsData>()->getInstanceID());
+	if (_needUpdatePipeline || _needUpdateVertexBuffers)
+	{
+		_pipeline->bindVertexBuffers(_vertexBuffers, _needUpdatePipeline);
+		_needUpdatePipeline = false;
+		_needUpdateVertexBuffers = false;
+	}
+
+	if (_needUpdateDescriptor)
+	{
+		_descriptorSet->apply(*_program);
+		_needUpdateDescriptor = false;
+	}
+
+	auto indirect = data->downcast<OGLCoreGraphicsData>();
+	offset += indirect->getBufferOffset();
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect->getInstanceID());
 
 	if (drawCount > 0)
 	{
@@ -764,23 +787,55 @@ OGLCoreDeviceContext::drawIndexedIndirect(const GraphicsDataPtr& data, std::size
 	assert(_glcontext->getActive());
 	assert(data && data->getGraphicsDataDesc().getType() == GraphicsDataType::GraphicsDataTypeIndirectBiffer);
 
-	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, data->downcast<OGLCoreGraphicsData>()->getInstanceID());
+	if (_needUpdatePipeline || _needUpdateVertexBuffers)
+	{
+		_pipeline->bindVertexBuffers(_vertexBuffers, _needUpdatePipeline);
+		_needUpdatePipeline = false;
+		_needUpdateVertexBuffers = false;
+	}
+
+	if (_needUpdateDescriptor)
+	{
+		_descriptorSet->apply(*_program);
+		_needUpdateDescriptor = false;
+	}
+
+	auto indirect = data->downcast<OGLCoreGraphicsData>();
+	offset += indirect->getBufferOffset();
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect->getInstanceID());
 
 	if (drawCount > 0)
 	{
 		GLenum drawType = OGLTypes::asVertexType(_stateCaptured.getPrimitiveType());
 		if (drawType != GL_INVALID_ENUM)
-			glMultiDrawElementsIndirect(drawType, GL_UNSIGNED_INT, (char*)nullptr + offset, drawCount, stride);
+			glMultiDrawElementsIndirect(drawType, _indexType, (char*)nullptr + offset, drawCount, stride);
 		else
 			this->getDevice()->downcast<OGLDevice>()->message("Invalid vertex type");
 	}
 }
 
+void
+OGLCoreDeviceContext::beginProfile(const char* name) noexcept
+{
+	_timerQuery.beginProfile(name);
+}
+
+void
+OGLCoreDeviceContext::endProfile() noexcept
+{
+	_timerQuery.endProfile();
+}
+
 void
 OGLCoreDeviceContext::present() noexcept
 {
 	assert(_glcontext->getActive());
 	_glcontext->present();
+
+	this->getDevice()->downcast<OGLDevice>()->nextFrame();
+
+	_timerQuery.resolve();
 }
 
 bool
@@ -38,6 +38,7 @@
 #define _H_OGL_CORE_DEVICE_CONTEXT_H_
 
 #include "ogl_types.h"
+#include "ogl_timer_query.h"
 
 _NAME_BEGIN
 
@@ -101,6 +102,9 @@ public:
 	void startDebugControl() noexcept;
 	void stopDebugControl() noexcept;
 
+	void beginProfile(const char* name) noexcept;
+	void endProfile() noexcept;
+
 	void present() noexcept;
 
 private:
@@ -146,6 +150,8 @@ private:
 	std::vector<Viewport> _viewports;
 	std::vector<Scissor> _scissors;
 
+	OGLTimerQuery _timerQuery;
+
 	GraphicsDeviceWeakPtr _device;
 };
 
@@ -45,7 +45,13 @@ OGLCoreGraphicsData::OGLCoreGraphicsData() noexcept
 	: _buffer(GL_NONE)
 	, _bufferAddr(GL_NONE)
 	, _data(nullptr)
+	, _streamSize(0)
+	, _streamCursor(0)
+	, _streamOffset(0)
+	, _streamFrame(0)
+	, _streamFrameCount(0)
 {
+	std::memset(_streamFences, 0, sizeof(_streamFences));
 }
 
 OGLCoreGraphicsData::~OGLCoreGraphicsData() noexcept
@@ -90,23 +96,52 @@ OGLCoreGraphicsData::setup(const GraphicsDataDesc& desc) noexcept
 
 	auto usage = desc.getUsage();
 
-	GLbitfield flags = GL_MAP_READ_BIT;
-	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagReadBit)
-		flags |= GL_MAP_READ_BIT;
-	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit)
-		flags |= GL_MAP_WRITE_BIT;
-	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagPersistentBit)
-		flags |= GL_MAP_PERSISTENT_BIT;
-	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagCoherentBit)
-		flags |= GL_MAP_COHERENT_BIT;
-	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagFlushExplicitBit)
-		flags |= GL_MAP_FLUSH_EXPLICIT_BIT;
-	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagDynamicStorageBit)
-		flags |= GL_DYNAMIC_STORAGE_BIT;
-	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagClientStorageBit)
-		flags |= GL_CLIENT_STORAGE_BIT;
+	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit)
+	{
+		// one region per frame in flight, each holds GL_STREAM_FRAME_MAPS maps, written through a single persistent mapping
+		_streamSize = (desc.getStreamSize() + GL_STREAM_FRAME_ALIGNMENT - 1) & ~(GL_STREAM_FRAME_ALIGNMENT - 1);
+		_streamCursor = 0;
+		_streamOffset = 0;
+		_streamFrame = 0;
+		_streamFrameCount = this->getDevice()->downcast<OGLDevice>()->getFrameCount();
+
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glNamedBufferStorage(_buffer, _streamSize * GL_STREAM_FRAME_MAPS * GL_STREAM_FRAME_COUNT, nullptr, flags);
 
-	glNamedBufferStorage(_buffer, desc.getStreamSize(), desc.getStream(), flags);
+		_data = glMapNamedBufferRange(_buffer, 0, _streamSize * GL_STREAM_FRAME_MAPS * GL_STREAM_FRAME_COUNT, flags);
+		if (!_data)
+		{
+			this->getDevice()->downcast<OGLDevice>()->message("glMapNamedBufferRange() fail.");
+			return false;
+		}
+
+		if (desc.getStream())
+		{
+			std::memcpy(_data, desc.getStream(), desc.getStreamSize());
+			_streamCursor = _streamSize;
+		}
+	}
+	else
+	{
+		GLbitfield flags = GL_MAP_READ_BIT;
+		if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagReadBit)
+			flags |= GL_MAP_READ_BIT;
+		if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit)
+			flags |= GL_MAP_WRITE_BIT;
+		if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagPersistentBit)
+			flags |= GL_MAP_PERSISTENT_BIT;
+		if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagCoherentBit)
+			flags |= GL_MAP_COHERENT_BIT;
+		if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagFlushExplicitBit)
+			flags |= GL_MAP_FLUSH_EXPLICIT_BIT;
+		if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagDynamicStorageBit)
+			flags |= GL_DYNAMIC_STORAGE_BIT;
+		if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagClientStorageBit)
+			flags |= GL_CLIENT_STORAGE_BIT;
+
+		glNamedBufferStorage(_buffer, desc.getStreamSize(), desc.getStream(), flags);
+	}
 
 	if (GLEW_NV_vertex_buffer_unified_memory && type == GraphicsDataType::GraphicsDataTypeStorageVertexBuffer)
 	{
@@ -121,8 +156,20 @@ OGLCoreGraphicsData::setup(const GraphicsDataDesc& desc) noexcept
 void
 OGLCoreGraphicsData::close() noexcept
 {
+	for (auto& fence : _streamFences)
+	{
+		if (fence)
+		{
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+
 	if (_data)
+	{
 		glUnmapNamedBuffer(_buffer);
+		_data = nullptr;
+	}
 
 	if (_buffer)
 	{
@@ -149,9 +196,19 @@ OGLCoreGraphicsData::map(std::ptrdiff_t offset, std::ptrdiff_t count, void** dat
 {
 	assert(data);
 
+	auto usage = _desc.getUsage();
+	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit)
+	{
+		assert(offset + count <= _streamSize);
+
+		this->allocStreamRange(offset + count);
+
+		*data = (std::uint8_t*)_data + _streamOffset + offset;
+		return true;
+	}
+
 	GLbitfield flags = 0;
 
-	auto usage = _desc.getUsage();
 	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagReadBit)
 		flags |= GL_MAP_READ_BIT;
 	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit)
@@ -180,11 +237,51 @@ void
 OGLCoreGraphicsData::unmap() noexcept
 {
 	auto usage = _desc.getUsage();
+	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit)
+		return;
+
 	if (!(usage & GraphicsUsageFlagBits::GraphicsUsageFlagPersistentBit))
 		glUnmapNamedBuffer(_buffer);
 	_data = nullptr;
 }
 
+void
+OGLCoreGraphicsData::nextStreamFrame() noexcept
+{
+	// commands reading the current region are all issued by now, fence it before moving on
+	_streamFences[_streamFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	_streamFrame = (_streamFrame + 1) % GL_STREAM_FRAME_COUNT;
+	_streamCursor = 0;
+
+	auto& fence = _streamFences[_streamFrame];
+	if (fence)
+	{
+		GLenum result = glClientWaitSync(fence, 0, 0);
+		while (result == GL_TIMEOUT_EXPIRED)
+			result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+}
+
+void
+OGLCoreGraphicsData::allocStreamRange(GLsizeiptr size) noexcept
+{
+	size = (size + GL_STREAM_FRAME_ALIGNMENT - 1) & ~(GL_STREAM_FRAME_ALIGNMENT - 1);
+
+	// the first map of a frame moves to the next region, later maps of the same frame are placed behind the previous ones
+	auto frameCount = this->getDevice()->downcast<OGLDevice>()->getFrameCount();
+	if (_streamFrameCount != frameCount || _streamCursor + size > _streamSize * GL_STREAM_FRAME_MAPS)
+	{
+		this->nextStreamFrame();
+		_streamFrameCount = frameCount;
+	}
+
+	_streamOffset = _streamSize * GL_STREAM_FRAME_MAPS * _streamFrame + _streamCursor;
+	_streamCursor += size;
+}
+
 GLuint
 OGLCoreGraphicsData::getInstanceID() const noexcept
 {
@@ -197,6 +294,12 @@ OGLCoreGraphicsData::getInstanceAddr() const noexcept
 	return _bufferAddr;
 }
 
+GLintptr
+OGLCoreGraphicsData::getBufferOffset() const noexcept
+{
+	return _streamOffset;
+}
+
 const GraphicsDataDesc&
 OGLCoreGraphicsData::getGraphicsDataDesc() const noexcept
 {
@@ -59,6 +59,7 @@ public:
 
 	GLuint getInstanceID() const noexcept;
 	GLuint64 getInstanceAddr() const noexcept;
+	GLintptr getBufferOffset() const noexcept;
 
 	const GraphicsDataDesc& getGraphicsDataDesc() const noexcept;
 
@@ -71,10 +72,20 @@ private:
 	OGLCoreGraphicsData(const OGLCoreGraphicsData&) noexcept = delete;
 	OGLCoreGraphicsData& operator=(const OGLCoreGraphicsData&) noexcept = delete;
 
+private:
+	void nextStreamFrame() noexcept;
+	void allocStreamRange(GLsizeiptr size) noexcept;
+
 private:
 	GLuint _buffer;
 	GLuint64 _bufferAddr;
 	GLvoid* _data;
+	GLsizeiptr _streamSize;
+	GLsizeiptr _streamCursor;
+	GLintptr _streamOffset;
+	GLuint _streamFrame;
+	std::uint32_t _streamFrameCount;
+	GLsync _streamFences[GL_STREAM_FRAME_COUNT];
 	GraphicsDataDesc _desc;
 	GraphicsDeviceWeakPtr _device;
 };
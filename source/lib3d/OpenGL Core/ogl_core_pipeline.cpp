@@ -185,7 +185,7 @@ OGLCorePipeline::bindVertexBuffers(OGLCoreVertexBuffers& vbos, bool forceUpdate)
 			if (vbos[it.slot].needUpdate)
 			{
 				GLuint64 addr = vbos[it.slot].vbo->getInstanceAddr() + vbos[it.slot].offset;
-				GLsizeiptr size = vbos[it.slot].vbo->getGraphicsDataDesc().getStreamSize() - vbos[it.slot].offset;
+				GLsizeiptr size = vbos[it.slot].vbo->getBufferOffset() + vbos[it.slot].vbo->getGraphicsDataDesc().getStreamSize() - vbos[it.slot].offset;
 				glBufferAddressRangeNV(GL_VERTEX_ATTRIB_ARRAY_ADDRESS_NV, it.slot, addr, size);
 				vbos[it.slot].needUpdate = false;
 			}
@@ -78,6 +78,8 @@ EGL2GraphicsData::setup(const GraphicsDataDesc& desc) noexcept
 		flags = GL_STATIC_DRAW;
 	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit)
 		flags = GL_DYNAMIC_DRAW;
+	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit)
+		flags = GL_STREAM_DRAW;
 
 	GL_CHECK(glGenBuffers(1, &_buffer));
 	GL_CHECK(glBindBuffer(_target, _buffer));
@@ -126,7 +128,12 @@ EGL2GraphicsData::map(std::intptr_t offset, std::intptr_t count, void** data) no
 {
 	assert(data);
 	GL_CHECK(glBindBuffer(_target, _buffer));
-	*data = (char*)glMapBufferOES(_target, GL_WRITE_ONLY_OES) + offset;
+
+	// orphan the storage so the driver hands out fresh memory instead of waiting on pending draws
+	if (_usage & GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit)
+		GL_CHECK(glBufferData(_target, _dataSize, nullptr, GL_STREAM_DRAW));
+
+	*data = glMapBufferOES(_target, GL_WRITE_ONLY_OES);
 	if (!*data)
 		return false;
 	*(char**)data += offset;
@@ -81,6 +81,8 @@ EGL3GraphicsData::setup(const GraphicsDataDesc& desc) noexcept
 		flags = GL_STATIC_DRAW;
 	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit)
 		flags = GL_DYNAMIC_READ;
+	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit)
+		flags = GL_STREAM_DRAW;
 
 	GL_CHECK(glGenBuffers(1, &_buffer));
 	GL_CHECK(glBindBuffer(_target, _buffer));
@@ -118,7 +120,18 @@ EGL3GraphicsData::map(std::ptrdiff_t offset, std::ptrdiff_t count, void** data)
 {
 	assert(data);
 	GL_CHECK(glBindBuffer(_target, _buffer));
-	*data = glMapBufferRange(_target, offset, count, GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
+
+	// orphan the storage so the driver hands out fresh memory instead of waiting on pending draws
+	if (_desc.getUsage() & GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit)
+	{
+		GL_CHECK(glBufferData(_target, _desc.getStreamSize(), nullptr, GL_STREAM_DRAW));
+		*data = glMapBufferRange(_target, offset, count, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+	}
+	else
+	{
+		*data = glMapBufferRange(_target, offset, count, GL_MAP_READ_BIT | GL_MAP_WRITE_BIT);
+	}
+
 	return *data ? true : false;
 }
 
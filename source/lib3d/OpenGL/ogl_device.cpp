@@ -60,6 +60,7 @@ _NAME_BEGIN
 __ImplementSubClass(OGLDevice, GraphicsDevice, "OGLDevice")
 
 OGLDevice::OGLDevice() noexcept
+	: _frameCount(0)
 {
 }
 
@@ -361,4 +362,16 @@ OGLDevice::message(const char* message, ...) noexcept
 	va_end(va);
 }
 
+void
+OGLDevice::nextFrame() noexcept
+{
+	_frameCount++;
+}
+
+std::uint32_t
+OGLDevice::getFrameCount() const noexcept
+{
+	return _frameCount;
+}
+
 _NAME_END
\ No newline at end of file
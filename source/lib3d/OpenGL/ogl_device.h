@@ -76,11 +76,16 @@ public:
 
 	void message(const char* message, ...) noexcept;
 
+	void nextFrame() noexcept;
+	std::uint32_t getFrameCount() const noexcept;
+
 private:
 	OGLDevice(const OGLDevice&) noexcept = delete;
 	OGLDevice& operator=(const OGLDevice&) noexcept = delete;
 
 private:
+	std::uint32_t _frameCount;
+
 	GraphicsDeviceDesc _deviceDesc;
 	GraphicsContextWeaks _deviceContexts;
 	GraphicsDevicePropertyPtr _deviceProperty;
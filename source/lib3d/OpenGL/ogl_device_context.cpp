@@ -100,12 +100,16 @@ OGLDeviceContext::setup(const GraphicsContextDesc& desc) noexcept
 	if (!this->initStateSystem())
 		return false;
 
+	_timerQuery.setup();
+
 	return true;
 }
 
 void
 OGLDeviceContext::close() noexcept
 {
+	_timerQuery.close();
+
 	_framebuffer = nullptr;
 	_program = nullptr;
 	_pipeline = nullptr;
@@ -400,7 +404,10 @@ OGLDeviceContext::setVertexBufferData(std::uint32_t i, const GraphicsDataPtr& da
 	assert(_vertexBuffers.size() > i);
 	assert(_glcontext->getActive());
 
+	// streamed data moves to a new region on every map, so the binding offset is captured here
 	auto vbo = data->downcast_pointer<OGLGraphicsData>();
+	offset += vbo->getBufferOffset();
+
 	if (_vertexBuffers[i].vbo != vbo || _vertexBuffers[i].offset != offset)
 	{
 		_vertexBuffers[i].vbo = vbo;
@@ -434,7 +441,7 @@ OGLDeviceContext::setIndexBufferData(const GraphicsDataPtr& data, std::intptr_t
 	}
 
 	_indexType = OGLTypes::asIndexType(indexType);
-	_indexOffset = offset;
+	_indexOffset = offset + ibo->getBufferOffset();
 
 	if (_indexType == GL_INVALID_ENUM) this->getDevice()->downcast<OGLDevice>()->message("Invalid index type");
 }
@@ -783,7 +790,23 @@ OGLDeviceContext::drawIndirect(const GraphicsDataPtr& data, std::size_t offset,
 	assert(_glcontext->getActive());
 	assert(data && data->getGraphicsDataDesc().getType() == GraphicsDataType::GraphicsDataTypeIndirectBiffer);
 
-	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, data->downcast<OGLGraphicsData>()->getInstanceID());
+	if (_needUpdatePipeline || _needUpdateVertexBuffers)
+	{
+		_pipeline->bindVertexBuffers(_vertexBuffers, _needUpdatePipeline);
+		_needUpdatePipeline = false;
+		_needUpdateVertexBuffers = false;
+	}
+
+	if (_needUpdateDescriptor)
+	{
+		_descriptorSet->apply(*_program);
+		_needUpdateDescriptor = false;
+	}
+
+	auto indirect = data->downcast<OGLGraphicsData>();
+	offset += indirect->getBufferOffset();
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect->getInstanceID());
 
 	if (drawCount > 0)
 	{
@@ -802,7 +825,23 @@ OGLDeviceContext::drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t o
 	assert(_glcontext->getActive());
 	assert(data && data->getGraphicsDataDesc().getType() == GraphicsDataType::GraphicsDataTypeIndirectBiffer);
 
-	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, data->downcast<OGLGraphicsData>()->getInstanceID());
+	if (_needUpdatePipeline || _needUpdateVertexBuffers)
+	{
+		_pipeline->bindVertexBuffers(_vertexBuffers, _needUpdatePipeline);
+		_needUpdatePipeline = false;
+		_needUpdateVertexBuffers = false;
+	}
+
+	if (_needUpdateDescriptor)
+	{
+		_descriptorSet->apply(*_program);
+		_needUpdateDescriptor = false;
+	}
+
+	auto indirect = data->downcast<OGLGraphicsData>();
+	offset += indirect->getBufferOffset();
+
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect->getInstanceID());
 
 	if (drawCount > 0)
 	{
@@ -814,11 +853,27 @@ OGLDeviceContext::drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t o
 	}
 }
 
+void
+OGLDeviceContext::beginProfile(const char* name) noexcept
+{
+	_timerQuery.beginProfile(name);
+}
+
+void
+OGLDeviceContext::endProfile() noexcept
+{
+	_timerQuery.endProfile();
+}
+
 void
 OGLDeviceContext::present() noexcept
 {
 	assert(_glcontext->getActive());
 	_glcontext->present();
+
+	this->getDevice()->downcast<OGLDevice>()->nextFrame();
+
+	_timerQuery.resolve();
 }
 
 bool
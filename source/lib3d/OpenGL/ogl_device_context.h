@@ -38,6 +38,7 @@
 #define _H_OGL_DEVICE_CONTEXT_H_
 
 #include "ogl_types.h"
+#include "ogl_timer_query.h"
 
 _NAME_BEGIN
 
@@ -97,6 +98,9 @@ public:
 	void drawIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept;
 	void drawIndexedIndirect(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept;
 
+	void beginProfile(const char* name) noexcept;
+	void endProfile() noexcept;
+
 	void present() noexcept;
 
 	void enableDebugControl(bool enable) noexcept;
@@ -148,6 +152,8 @@ private:
 	bool _needEnableDebugControl;
 	bool _needDisableDebugControl;
 
+	OGLTimerQuery _timerQuery;
+
 	GraphicsDeviceWeakPtr _device;
 };
 
@@ -226,7 +226,7 @@ OGLFramebuffer::bindRenderTexture(GraphicsTexturePtr renderTexture, GLenum attac
 	if (textureDesc.getTexDim() == GraphicsTextureDim::GraphicsTextureDim2DArray)
 		glFramebufferTextureLayer(GL_FRAMEBUFFER, attachment, textureID, level, layer);
 	else if (textureDesc.getTexDim() == GraphicsTextureDim::GraphicsTextureDimCube)
-		glFramebufferTexture(GL_FRAMEBUFFER, attachment, textureID, level);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_CUBE_MAP_POSITIVE_X + layer, textureID, level);
 	else if (textureDesc.getTexDim() == GraphicsTextureDim::GraphicsTextureDimCubeArray)
 		glFramebufferTexture3D(GL_FRAMEBUFFER, attachment, textureTarget, textureID, level, layer);
 	else
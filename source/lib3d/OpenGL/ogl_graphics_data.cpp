@@ -44,7 +44,14 @@ __ImplementSubClass(OGLGraphicsData, GraphicsData, "OGLGraphicsData")
 OGLGraphicsData::OGLGraphicsData() noexcept
 	: _buffer(GL_NONE)
 	, _data(nullptr)
+	, _streamData(nullptr)
+	, _streamSize(0)
+	, _streamCursor(0)
+	, _streamOffset(0)
+	, _streamFrame(0)
+	, _streamFrameCount(0)
 {
+	std::memset(_streamFences, 0, sizeof(_streamFences));
 }
 
 OGLGraphicsData::~OGLGraphicsData() noexcept
@@ -97,7 +104,43 @@ OGLGraphicsData::setup(const GraphicsDataDesc& desc) noexcept
 
 	glGenBuffers(1, &_buffer);
 	glBindBuffer(_target, _buffer);
-	glBufferData(_target, desc.getStreamSize(), desc.getStream(), flags);
+
+	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit)
+	{
+		_streamSize = (desc.getStreamSize() + GL_STREAM_FRAME_ALIGNMENT - 1) & ~(GL_STREAM_FRAME_ALIGNMENT - 1);
+		_streamCursor = 0;
+		_streamOffset = 0;
+		_streamFrame = 0;
+		_streamFrameCount = this->getDevice()->downcast<OGLDevice>()->getFrameCount();
+
+		// one region per frame in flight, each holds GL_STREAM_FRAME_MAPS maps
+		GLsizeiptr size = _streamSize * GL_STREAM_FRAME_MAPS * GL_STREAM_FRAME_COUNT;
+
+		// with ARB_buffer_storage the ring stays mapped, otherwise every range is mapped unsynchronized
+		if (GLEW_ARB_buffer_storage)
+		{
+			GLbitfield storage = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+			glBufferStorage(_target, size, nullptr, storage);
+			_streamData = glMapBufferRange(_target, 0, size, storage);
+		}
+		else
+		{
+			glBufferData(_target, size, nullptr, GL_STREAM_DRAW);
+		}
+
+		if (desc.getStream())
+		{
+			if (_streamData)
+				std::memcpy(_streamData, desc.getStream(), desc.getStreamSize());
+			else
+				glBufferSubData(_target, 0, desc.getStreamSize(), desc.getStream());
+			_streamCursor = _streamSize;
+		}
+	}
+	else
+	{
+		glBufferData(_target, desc.getStreamSize(), desc.getStream(), flags);
+	}
 
 	return true;
 }
@@ -116,6 +159,22 @@ OGLGraphicsData::close() noexcept
 	if (_data)
 		this->unmap();
 
+	for (auto& fence : _streamFences)
+	{
+		if (fence)
+		{
+			glDeleteSync(fence);
+			fence = nullptr;
+		}
+	}
+
+	if (_streamData)
+	{
+		glBindBuffer(_target, _buffer);
+		glUnmapBuffer(_target);
+		_streamData = nullptr;
+	}
+
 	if (_buffer)
 	{
 		glDeleteBuffers(1, &_buffer);
@@ -129,11 +188,29 @@ OGLGraphicsData::map(std::ptrdiff_t offset, std::ptrdiff_t count, void** data) n
 	assert(data);
 	assert(!_data);
 
+	auto usage = _desc.getUsage();
+	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit)
+	{
+		assert(offset + count <= _streamSize);
+
+		this->allocStreamRange(offset + count);
+
+		if (_streamData)
+		{
+			*data = (std::uint8_t*)_streamData + _streamOffset + offset;
+			return true;
+		}
+
+		glBindBuffer(_target, _buffer);
+
+		_data = *data = glMapBufferRange(_target, _streamOffset + offset, count, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		return _data ? true : false;
+	}
+
 	glBindBuffer(_target, _buffer);
 
 	GLbitfield flags = 0;
 
-	auto usage = _desc.getUsage();
 	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagReadBit)
 		flags |= GL_MAP_READ_BIT;
 	if (usage & GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit)
@@ -154,12 +231,55 @@ OGLGraphicsData::unmap() noexcept
 	}
 }
 
+void
+OGLGraphicsData::nextStreamFrame() noexcept
+{
+	// commands reading the current region are all issued by now, fence it before moving on
+	_streamFences[_streamFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	_streamFrame = (_streamFrame + 1) % GL_STREAM_FRAME_COUNT;
+	_streamCursor = 0;
+
+	auto& fence = _streamFences[_streamFrame];
+	if (fence)
+	{
+		GLenum result = glClientWaitSync(fence, 0, 0);
+		while (result == GL_TIMEOUT_EXPIRED)
+			result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+
+		glDeleteSync(fence);
+		fence = nullptr;
+	}
+}
+
+void
+OGLGraphicsData::allocStreamRange(GLsizeiptr size) noexcept
+{
+	size = (size + GL_STREAM_FRAME_ALIGNMENT - 1) & ~(GL_STREAM_FRAME_ALIGNMENT - 1);
+
+	// the first map of a frame moves to the next region, later maps of the same frame are placed behind the previous ones
+	auto frameCount = this->getDevice()->downcast<OGLDevice>()->getFrameCount();
+	if (_streamFrameCount != frameCount || _streamCursor + size > _streamSize * GL_STREAM_FRAME_MAPS)
+	{
+		this->nextStreamFrame();
+		_streamFrameCount = frameCount;
+	}
+
+	_streamOffset = _streamSize * GL_STREAM_FRAME_MAPS * _streamFrame + _streamCursor;
+	_streamCursor += size;
+}
+
 GLuint
 OGLGraphicsData::getInstanceID() const noexcept
 {
 	return _buffer;
 }
 
+GLintptr
+OGLGraphicsData::getBufferOffset() const noexcept
+{
+	return _streamOffset;
+}
+
 const GraphicsDataDesc&
 OGLGraphicsData::getGraphicsDataDesc() const noexcept
 {
@@ -57,6 +57,7 @@ public:
 	void unmap() noexcept;
 
 	GLuint getInstanceID() const noexcept;
+	GLintptr getBufferOffset() const noexcept;
 
 	const GraphicsDataDesc& getGraphicsDataDesc() const noexcept;
 
@@ -69,10 +70,21 @@ private:
 	OGLGraphicsData(const OGLGraphicsData&) noexcept = delete;
 	OGLGraphicsData& operator=(const OGLGraphicsData&) noexcept = delete;
 
+private:
+	void nextStreamFrame() noexcept;
+	void allocStreamRange(GLsizeiptr size) noexcept;
+
 private:
 	GLuint _buffer;
 	GLenum _target;
 	GLvoid* _data;
+	GLvoid* _streamData;
+	GLsizeiptr _streamSize;
+	GLsizeiptr _streamCursor;
+	GLintptr _streamOffset;
+	GLuint _streamFrame;
+	std::uint32_t _streamFrameCount;
+	GLsync _streamFences[GL_STREAM_FRAME_COUNT];
 	GraphicsDataDesc _desc;
 	GraphicsDeviceWeakPtr _device;
 };
@@ -0,0 +1,163 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include "ogl_timer_query.h"
+#include <ray/profiler.h>
+
+_NAME_BEGIN
+
+OGLTimerQuery::OGLTimerQuery() noexcept
+	: _isSupport(false)
+{
+}
+
+OGLTimerQuery::~OGLTimerQuery() noexcept
+{
+	this->close();
+}
+
+bool
+OGLTimerQuery::setup() noexcept
+{
+	_isSupport = GLEW_ARB_timer_query ? true : false;
+	return _isSupport;
+}
+
+void
+OGLTimerQuery::close() noexcept
+{
+	for (auto& it : _pending)
+	{
+		_queries.push_back(it.begin);
+		if (it.end)
+			_queries.push_back(it.end);
+	}
+
+	if (!_queries.empty())
+	{
+		glDeleteQueries(static_cast<GLsizei>(_queries.size()), _queries.data());
+		_queries.clear();
+	}
+
+	_stack.clear();
+	_pending.clear();
+}
+
+GLuint
+OGLTimerQuery::allocQuery() noexcept
+{
+	if (_queries.empty())
+	{
+		GLuint queries[32];
+		glGenQueries(32, queries);
+		_queries.insert(_queries.end(), queries, queries + 32);
+	}
+
+	GLuint query = _queries.back();
+	_queries.pop_back();
+	return query;
+}
+
+void
+OGLTimerQuery::beginProfile(const char* name) noexcept
+{
+	assert(name);
+
+	if (!_isSupport)
+		return;
+
+	Marker marker;
+	marker.name = name;
+	marker.begin = this->allocQuery();
+	marker.end = 0;
+
+	glQueryCounter(marker.begin, GL_TIMESTAMP);
+
+	_pending.push_back(marker);
+	_stack.push_back(&_pending.back());
+}
+
+void
+OGLTimerQuery::endProfile() noexcept
+{
+	if (!_isSupport || _stack.empty())
+		return;
+
+	auto marker = _stack.back();
+	marker->end = this->allocQuery();
+
+	glQueryCounter(marker->end, GL_TIMESTAMP);
+
+	_stack.pop_back();
+}
+
+void
+OGLTimerQuery::resolve() noexcept
+{
+	if (!_isSupport || _pending.empty())
+		return;
+
+	// GPU timestamps live in their own clock domain, map them onto Timer::clock once per frame.
+	GLint64 gpuTime = 0;
+	glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+	std::int64_t offset = static_cast<std::int64_t>(Timer::clock()) - gpuTime;
+
+	auto profiler = Profiler::instance();
+
+	while (!_pending.empty())
+	{
+		auto& marker = _pending.front();
+		if (!marker.end)
+			break;
+
+		GLint available = GL_FALSE;
+		glGetQueryObjectiv(marker.end, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+			break;
+
+		GLuint64 begin = 0, end = 0;
+		glGetQueryObjectui64v(marker.begin, GL_QUERY_RESULT, &begin);
+		glGetQueryObjectui64v(marker.end, GL_QUERY_RESULT, &end);
+
+		profiler->addGpuEvent(marker.name, begin + offset, end + offset);
+
+		_queries.push_back(marker.begin);
+		_queries.push_back(marker.end);
+		_pending.pop_front();
+	}
+}
+
+_NAME_END
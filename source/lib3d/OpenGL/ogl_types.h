@@ -90,6 +90,11 @@ extern GLEWContext _glewctx;
 #	define GL_PLATFORM_ASSERT(expr, format)
 #endif
 
+// every stream buffer owns its ring: GL_STREAM_FRAME_COUNT regions of GL_STREAM_FRAME_MAPS aligned maps, so 6x its stream size
+#define GL_STREAM_FRAME_COUNT 3
+#define GL_STREAM_FRAME_MAPS 2
+#define GL_STREAM_FRAME_ALIGNMENT 256
+
 typedef std::shared_ptr<class OGLDevice> OGLDevicePtr;
 typedef std::shared_ptr<class OGLDeviceProperty> OGLDevicePropertyPtr;
 typedef std::shared_ptr<class OGLSurface> OGLSurfacePtr;
@@ -449,7 +449,7 @@ VulkanCommandList::setVertexBuffers(const GraphicsDataPtr data[], std::uint32_t
 	for (std::uint32_t i = 0; i < count; i++)
 	{
 		_vertexBuffers[i] = data[i]->downcast<VulkanGraphicsData>()->getBuffer();
-		_vertexOffsets[i] = 0;
+		_vertexOffsets[i] = data[i]->downcast<VulkanGraphicsData>()->getBufferOffset();
 	}
 
 	vkCmdBindVertexBuffers(_commandBuffer, first, count, _vertexBuffers.data(), _vertexOffsets.data());
@@ -461,6 +461,8 @@ VulkanCommandList::setIndexBuffer(const GraphicsDataPtr& data, std::intptr_t off
 	assert(indexType == GraphicsIndexType::GraphicsIndexTypeUInt16 || indexType == GraphicsIndexType::GraphicsIndexTypeUInt32);
 
 	VkBuffer buffer = data->downcast<VulkanGraphicsData>()->getBuffer();
+	offset += data->downcast<VulkanGraphicsData>()->getBufferOffset();
+
 	if (indexType == GraphicsIndexType::GraphicsIndexTypeUInt16)
 		vkCmdBindIndexBuffer(_commandBuffer, buffer, offset, VkIndexType::VK_INDEX_TYPE_UINT16);
 	else if (indexType == GraphicsIndexType::GraphicsIndexTypeUInt32)
@@ -483,6 +485,7 @@ void
 VulkanCommandList::drawIndirect(GraphicsDataPtr data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept
 {
 	VkBuffer buffer = data->downcast<VulkanGraphicsData>()->getBuffer();
+	offset += data->downcast<VulkanGraphicsData>()->getBufferOffset();
 	vkCmdDrawIndirect(_commandBuffer, buffer, offset, drawCount, stride);
 }
 
@@ -490,6 +493,7 @@ void
 VulkanCommandList::drawIndexedIndirect(GraphicsDataPtr data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride) noexcept
 {
 	VkBuffer buffer = data->downcast<VulkanGraphicsData>()->getBuffer();
+	offset += data->downcast<VulkanGraphicsData>()->getBufferOffset();
 	vkCmdDrawIndexedIndirect(_commandBuffer, buffer, offset, drawCount, stride);
 }
 
@@ -956,7 +956,7 @@ VulkanDescriptorSet::setup(const GraphicsDescriptorSetDesc& descriptorSetDesc) n
 
 		VkDescriptorBufferInfo bufferInfo;
 		bufferInfo.buffer = data->getBuffer();
-		bufferInfo.offset = 0;
+		bufferInfo.offset = data->getBufferOffset();
 		bufferInfo.range = data->getGraphicsDataDesc().getStreamSize();
 
 		VkWriteDescriptorSet write;
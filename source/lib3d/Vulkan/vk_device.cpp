@@ -136,6 +136,9 @@ VulkanDevice::setup(const GraphicsDeviceDesc& deviceDesc) noexcept
 		return false;
 	}
 
+	if (!_memoryAllocator.setup(_device, physicalDevice))
+		return false;
+
 	_deviceDesc = deviceDesc;
 	return true;
 }
@@ -143,6 +146,8 @@ VulkanDevice::setup(const GraphicsDeviceDesc& deviceDesc) noexcept
 void
 VulkanDevice::close() noexcept
 {
+	_memoryAllocator.close();
+
 	if (_device != VK_NULL_HANDLE)
 	{
 		vkDestroyDevice(_device, nullptr);
@@ -371,4 +376,16 @@ VulkanDevice::getPhysicalDevice() const noexcept
 	return _physicalDevice->getPhysicalDevice();
 }
 
+VulkanMemoryAllocator&
+VulkanDevice::getMemoryAllocator() noexcept
+{
+	return _memoryAllocator;
+}
+
+void
+VulkanDevice::getMemoryStats(VulkanMemoryStats& stats) const noexcept
+{
+	_memoryAllocator.getStats(stats);
+}
+
 _NAME_END
\ No newline at end of file
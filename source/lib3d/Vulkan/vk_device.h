@@ -37,7 +37,7 @@
 #ifndef _H_VK_DEVICE_H_
 #define _H_VK_DEVICE_H_
 
-#include "vk_types.h"
+#include "vk_memory.h"
 
 _NAME_BEGIN
 
@@ -54,6 +54,9 @@ public:
 	VkDevice getDevice() const noexcept;
 	VkPhysicalDevice getPhysicalDevice() const noexcept;
 
+	VulkanMemoryAllocator& getMemoryAllocator() noexcept;
+	void getMemoryStats(VulkanMemoryStats& stats) const noexcept;
+
 	GraphicsSwapchainPtr createSwapchain(const GraphicsSwapchainDesc& desc) noexcept;
 	GraphicsContextPtr createDeviceContext(const GraphicsContextDesc& desc) noexcept;
 	GraphicsInputLayoutPtr createInputLayout(const GraphicsInputLayoutDesc& desc) noexcept;
@@ -85,6 +88,7 @@ private:
 
 private:
 	VkDevice _device;
+	VulkanMemoryAllocator _memoryAllocator;
 	GraphicsDeviceDesc _deviceDesc;
 	VulkanDevicePropertyPtr _physicalDevice;
 };
@@ -44,6 +44,9 @@ __ImplementSubClass(VulkanGraphicsData, GraphicsData, "VulkanGraphicsData")
 
 VulkanGraphicsData::VulkanGraphicsData() noexcept
 	: _vkBuffer(VK_NULL_HANDLE)
+	, _streamData(nullptr)
+	, _streamSize(0)
+	, _streamFrame(0)
 {
 }
 
@@ -71,10 +74,17 @@ VulkanGraphicsData::setup(const GraphicsDataDesc& dataDesc) noexcept
 		return false;
 	}
 
+	bool isStream = (dataDesc.getUsage() & GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit) ? true : false;
+	if (isStream)
+	{
+		_streamSize = (streamSize + 255) & ~255;
+		_streamFrame = 0;
+	}
+
 	VkBufferCreateInfo info;
 	info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
 	info.pNext = nullptr;
-	info.size = streamSize;
+	info.size = isStream ? _streamSize * VK_STREAM_FRAME_COUNT : streamSize;
 	info.usage = usage;
 	info.flags = 0;
 	info.sharingMode = VkSharingMode::VK_SHARING_MODE_EXCLUSIVE;
@@ -90,15 +100,35 @@ VulkanGraphicsData::setup(const GraphicsDataDesc& dataDesc) noexcept
 	VkMemoryRequirements memReq;
 	vkGetBufferMemoryRequirements(this->getDevice()->downcast<VulkanDevice>()->getDevice(), _vkBuffer, &memReq);
 
-	if (!_memory.setup(memReq.size, memReq.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+	VkMemoryPropertyFlags memFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+	if (isStream)
+		memFlags |= VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+	if (!_memory.setup(memReq, memFlags, VulkanMemoryPoolTypeLinear))
 		return false;
 
-	if (vkBindBufferMemory(this->getDevice()->downcast<VulkanDevice>()->getDevice(), _vkBuffer, _memory.getDeviceMemory(), 0) != VK_SUCCESS)
+	if (vkBindBufferMemory(this->getDevice()->downcast<VulkanDevice>()->getDevice(), _vkBuffer, _memory.getDeviceMemory(), _memory.getDeviceMemoryOffset()) != VK_SUCCESS)
 	{
 		VK_PLATFORM_LOG("vkBindBufferMemory() fail.");
 		return false;
 	}
 
+	if (isStream)
+	{
+		// coherent memory stays mapped for the lifetime of the buffer
+		if (!_memory.map(0, _streamSize * VK_STREAM_FRAME_COUNT, GraphicsAccessFlagBits::GraphicsAccessFlagMapWriteBit, &_streamData))
+		{
+			VK_PLATFORM_LOG("vkMapMemory() fail.");
+			return false;
+		}
+
+		if (dataDesc.getStream())
+			std::memcpy(_streamData, dataDesc.getStream(), streamSize);
+
+		_dataDesc = dataDesc;
+		return true;
+	}
+
 	auto stream = dataDesc.getStream();
 	if (stream)
 	{
@@ -117,11 +147,19 @@ VulkanGraphicsData::setup(const GraphicsDataDesc& dataDesc) noexcept
 void
 VulkanGraphicsData::close() noexcept
 {
+	if (_streamData)
+	{
+		_memory.unmap();
+		_streamData = nullptr;
+	}
+
 	if (_vkBuffer != VK_NULL_HANDLE)
 	{
 		vkDestroyBuffer(this->getDevice()->downcast<VulkanDevice>()->getDevice(), _vkBuffer, nullptr);
 		_vkBuffer = VK_NULL_HANDLE;
 	}
+
+	_memory.close();
 }
 
 VkBuffer
@@ -136,16 +174,34 @@ VulkanGraphicsData::getDeviceMemory() const noexcept
 	return _memory.getDeviceMemory();
 }
 
+VkDeviceSize
+VulkanGraphicsData::getBufferOffset() const noexcept
+{
+	return _streamSize * _streamFrame;
+}
+
 bool
 VulkanGraphicsData::map(std::ptrdiff_t offset, std::ptrdiff_t count, void** data) noexcept
 {
+	if (_streamData)
+	{
+		assert(offset + count <= (std::ptrdiff_t)_streamSize);
+
+		// VulkanDeviceContext::renderEnd waits for the queue to go idle, so the next region is never in flight
+		_streamFrame = (_streamFrame + 1) % VK_STREAM_FRAME_COUNT;
+
+		*data = (std::uint8_t*)_streamData + this->getBufferOffset() + offset;
+		return true;
+	}
+
 	return _memory.map(offset, count, GraphicsAccessFlagBits::GraphicsAccessFlagMapWriteBit, data);
 }
 
 void
 VulkanGraphicsData::unmap() noexcept
 {
-	_memory.unmap();
+	if (!_streamData)
+		_memory.unmap();
 }
 
 void
@@ -56,6 +56,7 @@ public:
 
 	VkBuffer getBuffer() const noexcept;
 	VkDeviceMemory getDeviceMemory() const noexcept;
+	VkDeviceSize getBufferOffset() const noexcept;
 
 	void setDevice(GraphicsDevicePtr device) noexcept;
 	GraphicsDevicePtr getDevice() noexcept;
@@ -71,6 +72,10 @@ private:
 	VkBuffer _vkBuffer;
 	VulkanMemory _memory;
 
+	void* _streamData;
+	VkDeviceSize _streamSize;
+	std::uint32_t _streamFrame;
+
 	GraphicsDataDesc _dataDesc;
 };
 
@@ -41,107 +41,558 @@
 
 _NAME_BEGIN
 
-VulkanMemory::VulkanMemory() noexcept
-	: _vkMemory(VK_NULL_HANDLE)
+namespace
 {
+	VkDeviceSize roundPow2(VkDeviceSize size) noexcept
+	{
+		VkDeviceSize result = 1;
+		while (result < size)
+			result <<= 1;
+		return result;
+	}
+
+	std::size_t log2Pow2(VkDeviceSize size) noexcept
+	{
+		std::size_t level = 0;
+		while (size > 1)
+		{
+			size >>= 1;
+			level++;
+		}
+		return level;
+	}
 }
 
-VulkanMemory::~VulkanMemory() noexcept
+VulkanMemoryBlock::VulkanMemoryBlock() noexcept
+	: _device(VK_NULL_HANDLE)
+	, _vkMemory(VK_NULL_HANDLE)
+	, _size(0)
+	, _usedSize(0)
+	, _typeIndex(0)
+	, _allocationCount(0)
+	, _mappedData(nullptr)
+	, _isDedicated(false)
+{
+}
+
+VulkanMemoryBlock::~VulkanMemoryBlock() noexcept
 {
 	this->close();
 }
 
 bool
-VulkanMemory::setup(VkDeviceSize streamSize, std::uint32_t typeBits, std::uint32_t mask) noexcept
+VulkanMemoryBlock::setup(VkDevice device, VkDeviceSize size, std::uint32_t typeIndex, bool hostVisible, bool dedicated) noexcept
 {
-	assert(streamSize > 0);
+	assert(size > 0);
+	assert(dedicated || roundPow2(size) == size);
 
 	VkMemoryAllocateInfo memInfo;
 	memInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
 	memInfo.pNext = nullptr;
-	memInfo.allocationSize = streamSize;
-	memInfo.memoryTypeIndex = 0;
+	memInfo.allocationSize = size;
+	memInfo.memoryTypeIndex = typeIndex;
 
-	VkPhysicalDeviceMemoryProperties memoryProperties;
-	vkGetPhysicalDeviceMemoryProperties(_device.lock()->getPhysicalDevice(), &memoryProperties);
-
-	if (!memory_type_from_properties(memoryProperties.memoryTypes, typeBits, mask, &memInfo.memoryTypeIndex))
+	if (vkAllocateMemory(device, &memInfo, nullptr, &_vkMemory) != VK_SUCCESS)
 	{
-		VK_PLATFORM_LOG("memory_type_from_properties() fail.");
+		VK_PLATFORM_LOG("vkAllocateMemory() fail.");
 		return false;
 	}
 
-	if (vkAllocateMemory(_device.lock()->getDevice(), &memInfo, nullptr, &_vkMemory) != VK_SUCCESS)
+	_device = device;
+
+	if (hostVisible)
+	{
+		// a VkDeviceMemory can only be mapped once, so host visible blocks stay mapped for their whole lifetime
+		void* data = nullptr;
+		if (vkMapMemory(device, _vkMemory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS)
+		{
+			VK_PLATFORM_LOG("vkMapMemory() fail.");
+			return false;
+		}
+
+		_mappedData = (std::uint8_t*)data;
+	}
+
+	_size = size;
+	_typeIndex = typeIndex;
+	_isDedicated = dedicated;
+
+	if (!dedicated)
 	{
-		VK_PLATFORM_LOG("vkAllocateMemory() fail.");
-		return false;
+		_freeLists.resize(log2Pow2(size / VK_MEMORY_MIN_ALLOCATION) + 1);
+		_freeLists[0].insert(0);
 	}
 
 	return true;
 }
 
 void
-VulkanMemory::close() noexcept
+VulkanMemoryBlock::close() noexcept
 {
+	if (_mappedData)
+	{
+		vkUnmapMemory(_device, _vkMemory);
+		_mappedData = nullptr;
+	}
+
 	if (_vkMemory != VK_NULL_HANDLE)
 	{
-		vkFreeMemory(_device.lock()->getDevice(), _vkMemory, nullptr);
+		vkFreeMemory(_device, _vkMemory, nullptr);
 		_vkMemory = VK_NULL_HANDLE;
 	}
+
+	_freeLists.clear();
 }
 
 bool
-VulkanMemory::map(std::ptrdiff_t offset, std::ptrdiff_t cnt, GraphicsAccessFlags flags, void** data) noexcept
+VulkanMemoryBlock::alloc(VkDeviceSize size, VkDeviceSize& offset) noexcept
 {
-	assert(_vkMemory != VK_NULL_HANDLE);
-	return vkMapMemory(_device.lock()->getDevice(), _vkMemory, offset, cnt, 0, data) == VK_SUCCESS;
+	if (_isDedicated)
+	{
+		if (_allocationCount > 0 || size > _size)
+			return false;
+
+		offset = 0;
+		_usedSize = _size;
+		_allocationCount++;
+		return true;
+	}
+
+	if (size > _size)
+		return false;
+
+	std::size_t level = this->levelOf(size);
+
+	std::size_t found = level + 1;
+	while (found > 0)
+	{
+		if (!_freeLists[found - 1].empty())
+			break;
+		found--;
+	}
+
+	if (found == 0)
+		return false;
+
+	found--;
+
+	auto it = _freeLists[found].begin();
+	VkDeviceSize start = *it;
+	_freeLists[found].erase(it);
+
+	// split down to the requested level, leaving the upper buddy of each split free
+	while (found < level)
+	{
+		found++;
+		_freeLists[found].insert(start + (_size >> found));
+	}
+
+	offset = start;
+	_usedSize += size;
+	_allocationCount++;
+	return true;
 }
 
 void
-VulkanMemory::unmap() noexcept
+VulkanMemoryBlock::free(VkDeviceSize offset, VkDeviceSize size) noexcept
+{
+	assert(_allocationCount > 0);
+
+	_allocationCount--;
+
+	if (_isDedicated)
+	{
+		_usedSize = 0;
+		return;
+	}
+
+	_usedSize -= size;
+
+	std::size_t level = this->levelOf(size);
+	while (level > 0)
+	{
+		VkDeviceSize buddy = offset ^ (_size >> level);
+
+		auto it = _freeLists[level].find(buddy);
+		if (it == _freeLists[level].end())
+			break;
+
+		_freeLists[level].erase(it);
+		offset = std::min(offset, buddy);
+		level--;
+	}
+
+	_freeLists[level].insert(offset);
+}
+
+bool
+VulkanMemoryBlock::empty() const noexcept
+{
+	return _allocationCount == 0;
+}
+
+bool
+VulkanMemoryBlock::isDedicated() const noexcept
 {
-	assert(_vkMemory != VK_NULL_HANDLE);
-	vkUnmapMemory(_device.lock()->getDevice(), _vkMemory);
+	return _isDedicated;
+}
+
+std::uint32_t
+VulkanMemoryBlock::getMemoryTypeIndex() const noexcept
+{
+	return _typeIndex;
+}
+
+VkDeviceSize
+VulkanMemoryBlock::getSize() const noexcept
+{
+	return _size;
 }
 
 VkDeviceMemory
-VulkanMemory::getDeviceMemory() const noexcept
+VulkanMemoryBlock::getDeviceMemory() const noexcept
 {
 	return _vkMemory;
 }
 
+std::uint8_t*
+VulkanMemoryBlock::getMappedData() const noexcept
+{
+	return _mappedData;
+}
+
 void
-VulkanMemory::setDevice(GraphicsDevicePtr device) noexcept
+VulkanMemoryBlock::getStats(VulkanMemoryStats& stats) const noexcept
 {
-	assert(device);
-	_device = device->downcast_pointer<VulkanDevice>();
+	stats.blockCount++;
+	stats.allocationCount += _allocationCount;
+	stats.blockBytes += _size;
+	stats.usedBytes += _usedSize;
+
+	if (_isDedicated)
+	{
+		stats.dedicatedBlockCount++;
+		return;
+	}
+
+	for (std::size_t level = 0; level < _freeLists.size(); level++)
+	{
+		if (_freeLists[level].empty())
+			continue;
+
+		stats.freeRangeCount += _freeLists[level].size();
+		stats.largestFreeRange = std::max(stats.largestFreeRange, _size >> level);
+	}
 }
 
-GraphicsDevicePtr
-VulkanMemory::getDevice() noexcept
+std::size_t
+VulkanMemoryBlock::levelOf(VkDeviceSize size) const noexcept
 {
-	return _device.lock();
+	assert(size >= VK_MEMORY_MIN_ALLOCATION && size <= _size);
+	return log2Pow2(_size) - log2Pow2(size);
+}
+
+VulkanMemoryAllocator::VulkanMemoryAllocator() noexcept
+	: _device(VK_NULL_HANDLE)
+	, _requestedBytes(0)
+	, _nonCoherentAtomSize(1)
+{
+	std::memset(&_memoryProperties, 0, sizeof(_memoryProperties));
+	std::memset(_blockSizes, 0, sizeof(_blockSizes));
+}
+
+VulkanMemoryAllocator::~VulkanMemoryAllocator() noexcept
+{
+	this->close();
+}
+
+bool
+VulkanMemoryAllocator::setup(VkDevice device, VkPhysicalDevice physicalDevice) noexcept
+{
+	assert(device != VK_NULL_HANDLE);
+
+	VkPhysicalDeviceProperties properties;
+	vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &_memoryProperties);
+
+	_nonCoherentAtomSize = std::max<VkDeviceSize>(properties.limits.nonCoherentAtomSize, 1);
+
+	// small heaps (integrated parts, the host visible window on discrete cards) get proportionally smaller blocks
+	for (std::uint32_t i = 0; i < _memoryProperties.memoryTypeCount; i++)
+	{
+		VkDeviceSize heapSize = _memoryProperties.memoryHeaps[_memoryProperties.memoryTypes[i].heapIndex].size;
+		VkDeviceSize blockSize = VK_MEMORY_BLOCK_SIZE;
+		while (blockSize > VK_MEMORY_MIN_ALLOCATION * 2 && blockSize > heapSize / 8)
+			blockSize >>= 1;
+
+		_blockSizes[i] = blockSize;
+	}
+
+	_device = device;
+	return true;
+}
+
+void
+VulkanMemoryAllocator::close() noexcept
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	for (auto& pools : _pools)
+	{
+		for (auto& pool : pools)
+			pool.clear();
+	}
+
+	_dedicatedBlocks.clear();
+	_requestedBytes = 0;
+	_device = VK_NULL_HANDLE;
+}
+
+VulkanMemoryBlock*
+VulkanMemoryAllocator::alloc(const VkMemoryRequirements& requirements, std::uint32_t mask, VulkanMemoryPoolType poolType, VkDeviceSize& offset, VkDeviceSize& size) noexcept
+{
+	assert(requirements.size > 0);
+	assert(poolType >= VulkanMemoryPoolTypeBeginRange && poolType <= VulkanMemoryPoolTypeEndRange);
+
+	std::uint32_t typeIndex = 0;
+	if (!this->findMemoryType(requirements.memoryTypeBits, mask, typeIndex))
+	{
+		VK_PLATFORM_LOG("findMemoryType() fail.");
+		return nullptr;
+	}
+
+	bool hostVisible = (_memoryProperties.memoryTypes[typeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) ? true : false;
+
+	// buddy ranges are aligned to their own size, so rounding up to the alignment is all that is needed
+	VkDeviceSize allocSize = roundPow2(std::max<VkDeviceSize>(std::max<VkDeviceSize>(requirements.size, requirements.alignment), VK_MEMORY_MIN_ALLOCATION));
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (allocSize > _blockSizes[typeIndex] / 2)
+	{
+		auto block = std::make_unique<VulkanMemoryBlock>();
+		if (!block->setup(_device, requirements.size, typeIndex, hostVisible, true))
+			return nullptr;
+
+		block->alloc(requirements.size, offset);
+
+		size = requirements.size;
+		_requestedBytes += requirements.size;
+		_dedicatedBlocks.push_back(std::move(block));
+		return _dedicatedBlocks.back().get();
+	}
+
+	auto& pool = _pools[typeIndex][poolType];
+	for (auto& it : pool)
+	{
+		if (it->alloc(allocSize, offset))
+		{
+			size = allocSize;
+			_requestedBytes += requirements.size;
+			return it.get();
+		}
+	}
+
+	auto block = std::make_unique<VulkanMemoryBlock>();
+	if (!block->setup(_device, _blockSizes[typeIndex], typeIndex, hostVisible, false))
+		return nullptr;
+
+	if (!block->alloc(allocSize, offset))
+		return nullptr;
+
+	size = allocSize;
+	_requestedBytes += requirements.size;
+	pool.push_back(std::move(block));
+	return pool.back().get();
+}
+
+void
+VulkanMemoryAllocator::free(VulkanMemoryBlock* block, VkDeviceSize offset, VkDeviceSize size, VkDeviceSize requestedSize) noexcept
+{
+	assert(block);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_requestedBytes -= requestedSize;
+
+	if (block->isDedicated())
+	{
+		auto it = std::find_if(_dedicatedBlocks.begin(), _dedicatedBlocks.end(), [block](const std::unique_ptr<VulkanMemoryBlock>& ptr) { return ptr.get() == block; });
+		if (it != _dedicatedBlocks.end())
+			_dedicatedBlocks.erase(it);
+		return;
+	}
+
+	block->free(offset, size);
+
+	if (!block->empty())
+		return;
+
+	// keep one empty block per pool around so a resource recreated every frame doesn't hit vkAllocateMemory
+	for (auto& pool : _pools[block->getMemoryTypeIndex()])
+	{
+		auto it = std::find_if(pool.begin(), pool.end(), [block](const std::unique_ptr<VulkanMemoryBlock>& ptr) { return ptr.get() == block; });
+		if (it == pool.end())
+			continue;
+
+		std::size_t emptyCount = std::count_if(pool.begin(), pool.end(), [](const std::unique_ptr<VulkanMemoryBlock>& ptr) { return ptr->empty(); });
+		if (emptyCount > 1)
+			pool.erase(it);
+
+		break;
+	}
+}
+
+void
+VulkanMemoryAllocator::flush(VulkanMemoryBlock* block, VkDeviceSize offset, VkDeviceSize size) noexcept
+{
+	assert(block);
+
+	if (_memoryProperties.memoryTypes[block->getMemoryTypeIndex()].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+		return;
+
+	VkDeviceSize begin = offset / _nonCoherentAtomSize * _nonCoherentAtomSize;
+	VkDeviceSize end = std::min(block->getSize(), (offset + size + _nonCoherentAtomSize - 1) / _nonCoherentAtomSize * _nonCoherentAtomSize);
+
+	VkMappedMemoryRange range;
+	range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+	range.pNext = nullptr;
+	range.memory = block->getDeviceMemory();
+	range.offset = begin;
+	range.size = end == block->getSize() ? VK_WHOLE_SIZE : end - begin;
+
+	vkFlushMappedMemoryRanges(_device, 1, &range);
+}
+
+void
+VulkanMemoryAllocator::getStats(VulkanMemoryStats& stats) const noexcept
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	std::memset(&stats, 0, sizeof(stats));
+
+	for (auto& pools : _pools)
+	{
+		for (auto& pool : pools)
+		{
+			for (auto& block : pool)
+				block->getStats(stats);
+		}
+	}
+
+	for (auto& block : _dedicatedBlocks)
+		block->getStats(stats);
+
+	stats.requestedBytes = _requestedBytes;
 }
 
 bool
-VulkanMemory::memory_type_from_properties(VkMemoryType memoryTypes[], uint32_t typeBits, VkFlags requirements_mask, uint32_t *typeIndex)
+VulkanMemoryAllocator::findMemoryType(std::uint32_t typeBits, VkMemoryPropertyFlags mask, std::uint32_t& typeIndex) const noexcept
 {
-	// Search memtypes to find first index with those properties
-	for (uint32_t i = 0; i < 32; i++)
+	for (std::uint32_t i = 0; i < _memoryProperties.memoryTypeCount; i++)
 	{
-		if ((typeBits & 1) == 1)
+		if ((typeBits & (1 << i)) && (_memoryProperties.memoryTypes[i].propertyFlags & mask) == mask)
 		{
-			// Type is available, does it match user properties?
-			if ((memoryTypes[i].propertyFlags & requirements_mask) == requirements_mask)
-			{
-				*typeIndex = i;
-				return true;
-			}
+			typeIndex = i;
+			return true;
 		}
-		typeBits >>= 1;
 	}
-	// No memory types matched, return failure
+
 	return false;
 }
 
-_NAME_END
\ No newline at end of file
+VulkanMemory::VulkanMemory() noexcept
+	: _block(nullptr)
+	, _offset(0)
+	, _size(0)
+	, _requestedSize(0)
+	, _mapOffset(0)
+	, _mapSize(0)
+{
+}
+
+VulkanMemory::~VulkanMemory() noexcept
+{
+	this->close();
+}
+
+bool
+VulkanMemory::setup(const VkMemoryRequirements& requirements, std::uint32_t mask, VulkanMemoryPoolType poolType) noexcept
+{
+	assert(!_block);
+	assert(requirements.size > 0);
+
+	_block = _device.lock()->getMemoryAllocator().alloc(requirements, mask, poolType, _offset, _size);
+	if (!_block)
+		return false;
+
+	_requestedSize = requirements.size;
+	return true;
+}
+
+void
+VulkanMemory::close() noexcept
+{
+	if (_block)
+	{
+		auto device = _device.lock();
+		if (device)
+			device->getMemoryAllocator().free(_block, _offset, _size, _requestedSize);
+
+		_block = nullptr;
+	}
+}
+
+bool
+VulkanMemory::map(std::ptrdiff_t offset, std::ptrdiff_t cnt, GraphicsAccessFlags flags, void** data) noexcept
+{
+	assert(_block);
+	assert(offset + cnt <= (std::ptrdiff_t)_size);
+
+	std::uint8_t* mappedData = _block->getMappedData();
+	if (!mappedData)
+	{
+		VK_PLATFORM_LOG("Memory is not host visible.");
+		return false;
+	}
+
+	_mapOffset = offset;
+	_mapSize = cnt;
+
+	*data = mappedData + _offset + offset;
+	return true;
+}
+
+void
+VulkanMemory::unmap() noexcept
+{
+	assert(_block);
+	_device.lock()->getMemoryAllocator().flush(_block, _offset + _mapOffset, _mapSize);
+}
+
+VkDeviceMemory
+VulkanMemory::getDeviceMemory() const noexcept
+{
+	return _block ? _block->getDeviceMemory() : VK_NULL_HANDLE;
+}
+
+VkDeviceSize
+VulkanMemory::getDeviceMemoryOffset() const noexcept
+{
+	return _offset;
+}
+
+void
+VulkanMemory::setDevice(GraphicsDevicePtr device) noexcept
+{
+	assert(device);
+	_device = device->downcast_pointer<VulkanDevice>();
+}
+
+GraphicsDevicePtr
+VulkanMemory::getDevice() noexcept
+{
+	return _device.lock();
+}
+
+_NAME_END
@@ -39,15 +39,120 @@
 
 #include "vk_types.h"
 
+#include <set>
+#include <mutex>
+
 _NAME_BEGIN
 
+enum VulkanMemoryPoolType
+{
+	VulkanMemoryPoolTypeLinear = 0,
+	VulkanMemoryPoolTypeOptimal = 1,
+	VulkanMemoryPoolTypeBeginRange = VulkanMemoryPoolTypeLinear,
+	VulkanMemoryPoolTypeEndRange = VulkanMemoryPoolTypeOptimal,
+	VulkanMemoryPoolTypeRangeSize = (VulkanMemoryPoolTypeEndRange - VulkanMemoryPoolTypeBeginRange + 1)
+};
+
+struct VulkanMemoryStats
+{
+	std::size_t blockCount;
+	std::size_t dedicatedBlockCount;
+	std::size_t allocationCount;
+	std::size_t freeRangeCount;
+	VkDeviceSize blockBytes;
+	VkDeviceSize usedBytes;
+	VkDeviceSize requestedBytes;
+	VkDeviceSize largestFreeRange;
+};
+
+class VulkanMemoryBlock final
+{
+public:
+	VulkanMemoryBlock() noexcept;
+	~VulkanMemoryBlock() noexcept;
+
+	bool setup(VkDevice device, VkDeviceSize size, std::uint32_t typeIndex, bool hostVisible, bool dedicated) noexcept;
+	void close() noexcept;
+
+	bool alloc(VkDeviceSize size, VkDeviceSize& offset) noexcept;
+	void free(VkDeviceSize offset, VkDeviceSize size) noexcept;
+
+	bool empty() const noexcept;
+	bool isDedicated() const noexcept;
+
+	std::uint32_t getMemoryTypeIndex() const noexcept;
+	VkDeviceSize getSize() const noexcept;
+	VkDeviceMemory getDeviceMemory() const noexcept;
+	std::uint8_t* getMappedData() const noexcept;
+
+	void getStats(VulkanMemoryStats& stats) const noexcept;
+
+private:
+	std::size_t levelOf(VkDeviceSize size) const noexcept;
+
+private:
+	VulkanMemoryBlock(const VulkanMemoryBlock&) noexcept = delete;
+	VulkanMemoryBlock& operator=(const VulkanMemoryBlock&) noexcept = delete;
+
+private:
+	VkDevice _device;
+	VkDeviceMemory _vkMemory;
+	VkDeviceSize _size;
+	VkDeviceSize _usedSize;
+	std::uint32_t _typeIndex;
+	std::uint32_t _allocationCount;
+	std::uint8_t* _mappedData;
+	bool _isDedicated;
+
+	// buddy free lists, level 0 is the whole block and each level halves the range size
+	std::vector<std::set<VkDeviceSize>> _freeLists;
+};
+
+class VulkanMemoryAllocator final
+{
+public:
+	VulkanMemoryAllocator() noexcept;
+	~VulkanMemoryAllocator() noexcept;
+
+	bool setup(VkDevice device, VkPhysicalDevice physicalDevice) noexcept;
+	void close() noexcept;
+
+	VulkanMemoryBlock* alloc(const VkMemoryRequirements& requirements, std::uint32_t mask, VulkanMemoryPoolType poolType, VkDeviceSize& offset, VkDeviceSize& size) noexcept;
+	void free(VulkanMemoryBlock* block, VkDeviceSize offset, VkDeviceSize size, VkDeviceSize requestedSize) noexcept;
+
+	void flush(VulkanMemoryBlock* block, VkDeviceSize offset, VkDeviceSize size) noexcept;
+
+	void getStats(VulkanMemoryStats& stats) const noexcept;
+
+private:
+	bool findMemoryType(std::uint32_t typeBits, VkMemoryPropertyFlags mask, std::uint32_t& typeIndex) const noexcept;
+
+private:
+	VulkanMemoryAllocator(const VulkanMemoryAllocator&) noexcept = delete;
+	VulkanMemoryAllocator& operator=(const VulkanMemoryAllocator&) noexcept = delete;
+
+private:
+	typedef std::vector<std::unique_ptr<VulkanMemoryBlock>> VulkanMemoryBlocks;
+
+	VkDevice _device;
+	VkDeviceSize _requestedBytes;
+	VkDeviceSize _nonCoherentAtomSize;
+	VkPhysicalDeviceMemoryProperties _memoryProperties;
+	VkDeviceSize _blockSizes[VK_MAX_MEMORY_TYPES];
+
+	VulkanMemoryBlocks _pools[VK_MAX_MEMORY_TYPES][VulkanMemoryPoolTypeRangeSize];
+	VulkanMemoryBlocks _dedicatedBlocks;
+
+	mutable std::mutex _mutex;
+};
+
 class VulkanMemory final
 {
 public:
 	VulkanMemory() noexcept;
 	virtual ~VulkanMemory() noexcept;
 
-	bool setup(VkDeviceSize datasize, std::uint32_t typeBits, std::uint32_t mask) noexcept;
+	bool setup(const VkMemoryRequirements& requirements, std::uint32_t mask, VulkanMemoryPoolType poolType) noexcept;
 	void close() noexcept;
 
 	void setDevice(GraphicsDevicePtr device) noexcept;
@@ -57,19 +162,24 @@ public:
 	void unmap() noexcept;
 
 	VkDeviceMemory getDeviceMemory() const noexcept;
-
-private:
-	bool memory_type_from_properties(VkMemoryType memoryTypes[], uint32_t typeBits, VkFlags requirements_mask, uint32_t *typeIndex);
+	VkDeviceSize getDeviceMemoryOffset() const noexcept;
 
 private:
 	VulkanMemory(const VulkanMemory&) noexcept = delete;
 	VulkanMemory& operator=(const VulkanMemory&) noexcept = delete;
 
 private:
-	VkDeviceMemory _vkMemory;
+	VulkanMemoryBlock* _block;
+	VkDeviceSize _offset;
+	VkDeviceSize _size;
+	VkDeviceSize _requestedSize;
+
+	VkDeviceSize _mapOffset;
+	VkDeviceSize _mapSize;
+
 	VulkanDeviceWeakPtr _device;
 };
 
 _NAME_END
 
-#endif
\ No newline at end of file
+#endif
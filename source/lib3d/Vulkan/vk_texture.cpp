@@ -122,11 +122,13 @@ VulkanTexture::setup(const GraphicsTextureDesc& textureDesc) noexcept
 		VkMemoryRequirements memReqs;
 		vkGetImageMemoryRequirements(device->getDevice(), _vkImage, &memReqs);
 
-		std::uint32_t mask = image.tiling == VK_IMAGE_TILING_LINEAR ? VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT : 0;
-		if (!_vkMemory.setup(memReqs.size, memReqs.memoryTypeBits, mask))
+		bool isLinear = image.tiling == VK_IMAGE_TILING_LINEAR;
+
+		std::uint32_t mask = isLinear ? VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT : 0;
+		if (!_vkMemory.setup(memReqs, mask, isLinear ? VulkanMemoryPoolTypeLinear : VulkanMemoryPoolTypeOptimal))
 			return false;
 
-		if (vkBindImageMemory(device->getDevice(), _vkImage, _vkMemory.getDeviceMemory(), 0) != VK_SUCCESS)
+		if (vkBindImageMemory(device->getDevice(), _vkImage, _vkMemory.getDeviceMemory(), _vkMemory.getDeviceMemoryOffset()) != VK_SUCCESS)
 		{
 			VK_PLATFORM_LOG("vkBindImageMemory() fail.");
 			return false;
@@ -199,6 +201,8 @@ VulkanTexture::close() noexcept
 			vkDestroyImage(device->getDevice(), _vkImage, nullptr);
 			_vkImage = VK_NULL_HANDLE;
 		}
+
+		_vkMemory.close();
 	}
 
 	if (_vkImageView != VK_NULL_HANDLE)
@@ -81,6 +81,9 @@
 #define VK_MAX_VIEWPORT_ARRAY 8
 #define VK_MAX_ATTACHMENT 8
 #define VK_MAX_PRESENT 8
+#define VK_STREAM_FRAME_COUNT 3
+#define VK_MEMORY_BLOCK_SIZE (64 * 1024 * 1024)
+#define VK_MEMORY_MIN_ALLOCATION 256
 
 _NAME_BEGIN
 
@@ -73,4 +73,14 @@ GraphicsContext::~GraphicsContext() noexcept
 {
 }
 
+void
+GraphicsContext::beginProfile(const char* name) noexcept
+{
+}
+
+void
+GraphicsContext::endProfile() noexcept
+{
+}
+
 _NAME_END
\ No newline at end of file
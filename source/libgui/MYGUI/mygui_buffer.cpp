@@ -37,13 +37,10 @@
 #if defined(_BUILD_MYGUI)
 #include "mygui_buffer.h"
 
-#include <ray/graphics_data.h>
-
 _NAME_BEGIN
 
 MyGuiVertexBuffer::MyGuiVertexBuffer() noexcept
-	: _vertexCount(0)
-	, _needVertexCount(0)
+	: _needVertexCount(0)
 {
 }
 
@@ -66,42 +63,22 @@ MyGuiVertexBuffer::getVertexCount() noexcept
 MyGUI::Vertex*
 MyGuiVertexBuffer::lock() noexcept
 {
-	if (!_vbo || _needVertexCount != _vertexCount)
-	{
-		std::uint32_t inputSize = 0;
-		inputSize += GraphicsVertexLayout::getVertexSize(GraphicsFormat::GraphicsFormatR32G32B32SFloat);
-		inputSize += GraphicsVertexLayout::getVertexSize(GraphicsFormat::GraphicsFormatR8G8B8A8UNorm);
-		inputSize += GraphicsVertexLayout::getVertexSize(GraphicsFormat::GraphicsFormatR32G32SFloat);
-
-		GraphicsDataDesc vb;
-		vb.setUsage(GraphicsUsageFlagBits::GraphicsUsageFlagReadBit | GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit);
-		vb.setType(GraphicsDataType::GraphicsDataTypeStorageVertexBuffer);
-		vb.setStreamSize(inputSize * _needVertexCount);
-
-		_vbo = RenderSystem::instance()->createGraphicsData(vb);
-		if (!_vbo)
-			return nullptr;
-
-		_vertexCount = _needVertexCount;
-	}
-
-	MyGUI::Vertex* data;
-	if (_vbo->map(0, _vbo->getGraphicsDataDesc().getStreamSize(), (void**)&data))
-		return data;
+	// vertices stay on the cpu, MyGuiRenderer::doRender copies them into the shared gui batch
+	if (_vertices.size() != _needVertexCount)
+		_vertices.resize(_needVertexCount);
 
-	return nullptr;
+	return _vertices.data();
 }
 
 void
 MyGuiVertexBuffer::unlock() noexcept
 {
-	_vbo->unmap();
 }
 
-GraphicsDataPtr
-MyGuiVertexBuffer::getBuffer() const
+const MyGUI::Vertex*
+MyGuiVertexBuffer::getVertices() const noexcept
 {
-	return _vbo;
+	return _vertices.data();
 }
 
 _NAME_END
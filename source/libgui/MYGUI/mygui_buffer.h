@@ -53,16 +53,11 @@ public:
 	virtual MyGUI::Vertex* lock() noexcept;
 	virtual void unlock() noexcept;
 
-	GraphicsDataPtr getBuffer() const;
+	const MyGUI::Vertex* getVertices() const noexcept;
 
 private:
-
-	MemoryStream _stream;
-
-	GraphicsDataPtr _vbo;
-
-	std::size_t _vertexCount;
 	std::size_t _needVertexCount;
+	std::vector<MyGUI::Vertex> _vertices;
 };
 
 _NAME_END
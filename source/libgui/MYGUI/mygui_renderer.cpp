@@ -38,7 +38,7 @@
 #include "mygui_renderer.h"
 #include "mygui_texture.h"
 #include "mygui_buffer.h"
-#include <ray/material.h>
+#include "../gui_batch_renderer.h"
 
 _NAME_BEGIN
 
@@ -72,6 +72,10 @@ MyGuiRenderer::open() except
 {
 	MYGUI_PLATFORM_ASSERT(!_isInitialise, getClassTypeName() << " initialised twice");
 	MYGUI_PLATFORM_LOG(Info, "* Initialise: " << getClassTypeName());
+
+	if (!GuiBatchRenderer::instance()->open())
+		MYGUI_PLATFORM_EXCEPT("Failed to create the gui batch renderer");
+
 	MYGUI_PLATFORM_LOG(Info, getClassTypeName() << " successfully initialized");
 
 	_isInitialise = true;
@@ -86,6 +90,8 @@ MyGuiRenderer::close() noexcept
 
 		destroyAllResources();
 
+		GuiBatchRenderer::instance()->close();
+
 		_isInitialise = false;
 
 		MYGUI_PLATFORM_LOG(Info, getClassTypeName() << " successfully shutdown");
@@ -190,33 +196,47 @@ MyGuiRenderer::doRender(MyGUI::IVertexBuffer* _buffer, MyGUI::ITexture* _texture
 		return;
 	}
 
-	auto renderBuffer = buffer->getBuffer();
-	if (!renderBuffer)
-	{
-		MYGUI_PLATFORM_ASSERT(renderBuffer, "render buffer is not created");
-		return;
-	}
+	auto batch = GuiBatchRenderer::instance();
 
-	auto materialPass = texture->getMaterialPass();
-	if (!materialPass)
+	GraphicsTexturePtr graphicsTexture = texture->getTexture();
+
+	float4 atlasRect(0.0f, 0.0f, 1.0f, 1.0f);
+	if (texture->getAtlasRect(atlasRect))
+		graphicsTexture = batch->getTextureAtlas().getTexture();
+
+	std::uint32_t width, height;
+	batch->getViewport(width, height);
+
+	float halfWidth = width * 0.5f;
+	float halfHeight = height * 0.5f;
+
+	// MyGUI emits clipped triangles in normalized device coordinates, the batch works in pixels
+	std::uint32_t baseVertex = 0;
+	GuiBatchVertex* vertices = batch->addVertices(_count, baseVertex);
+	const MyGUI::Vertex* source = buffer->getVertices();
+
+	for (std::size_t i = 0; i < _count; i++)
 	{
-		MYGUI_PLATFORM_ASSERT(materialPass, "material is not created");
-		return;
+		vertices[i].x = (source[i].x + 1.0f) * halfWidth;
+		vertices[i].y = (1.0f - source[i].y) * halfHeight;
+		vertices[i].u = atlasRect.x + source[i].u * atlasRect.z;
+		vertices[i].v = atlasRect.y + source[i].v * atlasRect.w;
+		vertices[i].color = source[i].colour;
 	}
 
-	RenderSystem::instance()->setMaterialPass(materialPass);
-	RenderSystem::instance()->setVertexBuffer(0, renderBuffer, 0);
-	RenderSystem::instance()->draw(_count, 1, 0, 0);
+	batch->addTriangles(graphicsTexture, baseVertex, _count);
 }
 
 void
 MyGuiRenderer::begin() noexcept
 {
+	GuiBatchRenderer::instance()->begin(_viewport.width, _viewport.height);
 }
 
 void
 MyGuiRenderer::end() noexcept
 {
+	GuiBatchRenderer::instance()->end();
 }
 
 const MyGUI::RenderTargetInfo&
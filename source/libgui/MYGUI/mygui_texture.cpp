@@ -38,6 +38,7 @@
 #include "mygui_texture.h"
 #include "mygui_renderer.h"
 #include "mygui_system.h"
+#include "../gui_batch_renderer.h"
 
 #include <ray/material.h>
 #include <ray/graphics_framebuffer.h>
@@ -49,6 +50,7 @@ using namespace MyGUI;
 MyGuiTexture::MyGuiTexture(const std::string& _name, GuiImageLoaderPtr _loader) noexcept
 	: _name(_name)
 	, _lock(false)
+	, _isAtlas(false)
 	, _width(0)
 	, _height(0)
 	, _numElemBytes(0)
@@ -157,6 +159,7 @@ MyGuiTexture::destroy() noexcept
 	_width = 0;
 	_height = 0;
 	_lock = false;
+	_isAtlas = false;
 	_dataSize = 0;
 	_stream.clear();
 	_numElemBytes = 0;
@@ -208,6 +211,10 @@ MyGuiTexture::loadFromFile(const std::string& _filename)
 				assert(false);
 
 			this->createManual(width, height, TextureUsage::Static | TextureUsage::Write, pfd, _stream.map());
+
+			// small static skins share one atlas so widgets using different skins still batch together
+			if (pfd == MyGUI::PixelFormat::R8G8B8 || pfd == MyGUI::PixelFormat::R8G8B8A8)
+				_isAtlas = GuiBatchRenderer::instance()->getTextureAtlas().insert((std::uint8_t*)_stream.map(), width, height, _numElemBytes, _atlasRect);
 		}
 	}
 }
@@ -260,6 +267,14 @@ MyGuiTexture::getMaterialPass() const noexcept
 	return _material->getTechs().front()->getPass(0);
 }
 
+bool
+MyGuiTexture::getAtlasRect(float4& rect) const noexcept
+{
+	if (_isAtlas)
+		rect = _atlasRect;
+	return _isAtlas;
+}
+
 int
 MyGuiTexture::getWidth() noexcept
 {
@@ -300,6 +315,9 @@ MyGuiRenderTexture::MyGuiRenderTexture(GraphicsTexturePtr texture) noexcept
 {
 	auto& textureDes = texture->getGraphicsTextureDesc();
 
+	_width = textureDes.getWidth();
+	_height = textureDes.getHeight();
+
 	_renderTargetInfo.maximumDepth = 1.0f;
 	_renderTargetInfo.hOffset = 0;
 	_renderTargetInfo.vOffset = 0;
@@ -326,11 +344,15 @@ MyGuiRenderTexture::begin() noexcept
 {
 	RenderSystem::instance()->setFramebuffer(_framebuffer);
 	RenderSystem::instance()->clearFramebuffer(0, GraphicsClearFlagBits::GraphicsClearFlagAllBit, Vector4::Zero, 1.0, 0);
+
+	GuiBatchRenderer::instance()->begin(_width, _height);
 }
 
 void
 MyGuiRenderTexture::end() noexcept
 {
+	GuiBatchRenderer::instance()->end();
+
 	RenderSystem::instance()->setFramebuffer(nullptr);
 }
 
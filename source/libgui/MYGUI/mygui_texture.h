@@ -76,12 +76,15 @@ public:
 	GraphicsTexturePtr getTexture() const noexcept;
 	MaterialPassPtr getMaterialPass() const noexcept;
 
+	bool getAtlasRect(float4& rect) const noexcept;
+
 	void createManual(int _width, int _height, MyGUI::TextureUsage _usage, MyGUI::PixelFormat _format, void* stream) except;
 
 private:
 	std::string _name;
 
 	bool _lock;
+	bool _isAtlas;
 
 	std::uint32_t _width;
 	std::uint32_t _height;
@@ -99,6 +102,8 @@ private:
 
 	MemoryStream _stream;
 
+	float4 _atlasRect;
+
 	GraphicsTexturePtr _texture;
 	GuiImageLoaderPtr _imageLoader;
 
@@ -119,6 +124,8 @@ public:
 	virtual const MyGUI::RenderTargetInfo& getInfo() noexcept;
 
 private:
+	std::uint32_t _width;
+	std::uint32_t _height;
 
 	GraphicsFramebufferPtr _framebuffer;
 	GraphicsFramebufferLayoutPtr _framebufferLayout;
@@ -0,0 +1,412 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2016.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include "gui_batch_renderer.h"
+
+#include <ray/render_system.h>
+#include <ray/graphics_data.h>
+#include <ray/graphics_texture.h>
+#include <ray/material.h>
+
+_NAME_BEGIN
+
+__ImplementSingleton(GuiBatchRenderer)
+
+GuiTextureAtlas::GuiTextureAtlas() noexcept
+	: _isDirty(false)
+	, _shelfX(0)
+	, _shelfY(0)
+	, _shelfHeight(0)
+{
+}
+
+GuiTextureAtlas::~GuiTextureAtlas() noexcept
+{
+}
+
+bool
+GuiTextureAtlas::insert(const std::uint8_t* pixels, std::uint32_t width, std::uint32_t height, std::uint32_t channel, float4& rect) noexcept
+{
+	assert(pixels);
+	assert(channel == 3 || channel == 4);
+
+	if (width == 0 || height == 0 || width > GUI_ATLAS_MAX_IMAGE_SIZE || height > GUI_ATLAS_MAX_IMAGE_SIZE)
+		return false;
+
+	// one texel of gutter on every side, filled with the edge color so linear filtering never bleeds
+	std::uint32_t w = width + 2;
+	std::uint32_t h = height + 2;
+
+	if (_shelfX + w > GUI_ATLAS_SIZE)
+	{
+		_shelfX = 0;
+		_shelfY += _shelfHeight;
+		_shelfHeight = 0;
+	}
+
+	if (_shelfY + h > GUI_ATLAS_SIZE)
+		return false;
+
+	if (_pixels.empty())
+		_pixels.resize(GUI_ATLAS_SIZE * GUI_ATLAS_SIZE * 4, 0);
+
+	for (std::uint32_t y = 0; y < h; y++)
+	{
+		std::uint32_t sy = std::min(std::max(y, 1u) - 1, height - 1);
+
+		std::uint8_t* dst = _pixels.data() + ((_shelfY + y) * GUI_ATLAS_SIZE + _shelfX) * 4;
+		for (std::uint32_t x = 0; x < w; x++, dst += 4)
+		{
+			std::uint32_t sx = std::min(std::max(x, 1u) - 1, width - 1);
+
+			const std::uint8_t* src = pixels + (sy * width + sx) * channel;
+			dst[0] = src[0];
+			dst[1] = src[1];
+			dst[2] = src[2];
+			dst[3] = channel == 4 ? src[3] : 0xFF;
+		}
+	}
+
+	rect.x = float(_shelfX + 1) / GUI_ATLAS_SIZE;
+	rect.y = float(_shelfY + 1) / GUI_ATLAS_SIZE;
+	rect.z = float(width) / GUI_ATLAS_SIZE;
+	rect.w = float(height) / GUI_ATLAS_SIZE;
+
+	_shelfX += w;
+	_shelfHeight = std::max(_shelfHeight, h);
+	_isDirty = true;
+
+	return true;
+}
+
+void
+GuiTextureAtlas::clear() noexcept
+{
+	_shelfX = 0;
+	_shelfY = 0;
+	_shelfHeight = 0;
+	_isDirty = false;
+	_pixels.clear();
+	_pixels.shrink_to_fit();
+	_texture.reset();
+}
+
+const GraphicsTexturePtr&
+GuiTextureAtlas::getTexture() noexcept
+{
+	if (_isDirty)
+	{
+		GraphicsTextureDesc textureDesc;
+		textureDesc.setSize(GUI_ATLAS_SIZE, GUI_ATLAS_SIZE);
+		textureDesc.setTexDim(GraphicsTextureDim::GraphicsTextureDim2D);
+		textureDesc.setTexFormat(GraphicsFormat::GraphicsFormatR8G8B8A8UNorm);
+		textureDesc.setTexTiling(GraphicsImageTiling::GraphicsImageTilingLinear);
+		textureDesc.setSamplerFilter(GraphicsSamplerFilter::GraphicsSamplerFilterLinear, GraphicsSamplerFilter::GraphicsSamplerFilterLinear);
+		textureDesc.setSamplerWrap(GraphicsSamplerWrap::GraphicsSamplerWrapClampToEdge);
+		textureDesc.setStream(_pixels.data());
+		textureDesc.setStreamSize(_pixels.size());
+
+		_texture = RenderSystem::instance()->createTexture(textureDesc);
+		_isDirty = false;
+	}
+
+	return _texture;
+}
+
+GuiBatchRenderer::GuiBatchRenderer() noexcept
+	: _refCount(0)
+	, _isBegin(false)
+	, _width(0)
+	, _height(0)
+	, _numDrawCommands(0)
+	, _numDrawCalls(0)
+	, _numPendingCommands(0)
+{
+}
+
+GuiBatchRenderer::~GuiBatchRenderer() noexcept
+{
+	assert(_refCount == 0);
+}
+
+bool
+GuiBatchRenderer::open() noexcept
+{
+	if (_refCount++ > 0)
+		return true;
+
+	_material = RenderSystem::instance()->createMaterial("sys:fx/uilayout.fxml");
+	if (!_material)
+	{
+		_refCount = 0;
+		return false;
+	}
+
+	_materialTech = _material->getTech("IMGUI");
+	_materialDecal = _material->getParameter("decal");
+	_materialProj = _material->getParameter("proj");
+
+	return true;
+}
+
+void
+GuiBatchRenderer::close() noexcept
+{
+	if (_refCount == 0 || --_refCount > 0)
+		return;
+
+	_batches.clear();
+	_vertices.clear();
+	_indices.clear();
+
+	_atlas.clear();
+
+	_vbo.reset();
+	_ibo.reset();
+	_material.reset();
+	_materialTech.reset();
+	_materialDecal.reset();
+	_materialProj.reset();
+}
+
+void
+GuiBatchRenderer::begin(std::uint32_t width, std::uint32_t height) noexcept
+{
+	assert(_refCount > 0);
+	assert(!_isBegin);
+
+	_width = std::max(width, 1u);
+	_height = std::max(height, 1u);
+	_isBegin = true;
+
+	_batches.clear();
+	_vertices.clear();
+	_indices.clear();
+
+	_numPendingCommands = 0;
+}
+
+void
+GuiBatchRenderer::end() noexcept
+{
+	assert(_isBegin);
+
+	_isBegin = false;
+	_numDrawCommands = _numPendingCommands;
+	_numDrawCalls = 0;
+
+	if (_batches.empty())
+		return;
+
+	if (!this->reserveBuffer(_vbo, GraphicsDataType::GraphicsDataTypeStorageVertexBuffer, _vertices.size() * sizeof(GuiBatchVertex)))
+		return;
+
+	if (!this->reserveBuffer(_ibo, GraphicsDataType::GraphicsDataTypeStorageIndexBuffer, _indices.size() * sizeof(std::uint32_t)))
+		return;
+
+	void* data = nullptr;
+	if (!_vbo->map(0, _vertices.size() * sizeof(GuiBatchVertex), &data))
+		return;
+
+	std::memcpy(data, _vertices.data(), _vertices.size() * sizeof(GuiBatchVertex));
+	_vbo->unmap();
+
+	if (!_ibo->map(0, _indices.size() * sizeof(std::uint32_t), &data))
+		return;
+
+	std::memcpy(data, _indices.data(), _indices.size() * sizeof(std::uint32_t));
+	_ibo->unmap();
+
+	auto renderer = RenderSystem::instance();
+
+	float4x4 project;
+	if (renderer->getRenderSetting().deviceType == GraphicsDeviceType::GraphicsDeviceTypeVulkan)
+		project.makeOrtho_lh(0, _width, 0, _height, 0, 1);
+	else
+		project.makeOrtho_lh(0, _width, _height, 0, 0, 1);
+
+	_materialProj->uniform4fmat(project);
+
+	renderer->setViewport(0, Viewport(0, 0, _width, _height));
+	renderer->setVertexBuffer(0, _vbo, 0);
+	renderer->setIndexBuffer(_ibo, 0, GraphicsIndexType::GraphicsIndexTypeUInt32);
+
+	const GraphicsTexture* texture = nullptr;
+
+	for (auto& batch : _batches)
+	{
+		renderer->setScissor(0, batch.scissor);
+
+		if (_numDrawCalls == 0 || batch.texture.get() != texture)
+		{
+			texture = batch.texture.get();
+			_materialDecal->uniformTexture(batch.texture);
+			renderer->setMaterialPass(_materialTech->getPass(0));
+		}
+
+		renderer->drawIndexed(batch.numIndices, 1, batch.startIndice, 0, 0);
+		_numDrawCalls++;
+	}
+
+	_batches.clear();
+}
+
+void
+GuiBatchRenderer::getViewport(std::uint32_t& width, std::uint32_t& height) const noexcept
+{
+	width = _width;
+	height = _height;
+}
+
+GuiBatchVertex*
+GuiBatchRenderer::addVertices(std::size_t count, std::uint32_t& baseVertex) noexcept
+{
+	assert(_isBegin);
+
+	baseVertex = (std::uint32_t)_vertices.size();
+	_vertices.resize(_vertices.size() + count);
+	return _vertices.data() + baseVertex;
+}
+
+void
+GuiBatchRenderer::addTriangles(const GraphicsTexturePtr& texture, std::uint32_t baseVertex, std::size_t count) noexcept
+{
+	assert(_isBegin);
+	assert(baseVertex + count <= _vertices.size());
+
+	std::size_t start = _indices.size();
+	_indices.resize(start + count);
+
+	for (std::size_t i = 0; i < count; i++)
+		_indices[start + i] = baseVertex + (std::uint32_t)i;
+
+	this->addBatch(texture, Scissor(0, 0, _width, _height), count);
+}
+
+void
+GuiBatchRenderer::addIndices(const GraphicsTexturePtr& texture, const Scissor& scissor, const std::uint16_t* indices, std::size_t count, std::uint32_t baseVertex) noexcept
+{
+	assert(_isBegin);
+	assert(indices);
+
+	float minX = FLT_MAX, minY = FLT_MAX;
+	float maxX = -FLT_MAX, maxY = -FLT_MAX;
+
+	std::size_t start = _indices.size();
+	_indices.resize(start + count);
+
+	for (std::size_t i = 0; i < count; i++)
+	{
+		std::uint32_t index = baseVertex + indices[i];
+		assert(index < _vertices.size());
+
+		auto& v = _vertices[index];
+		minX = std::min(minX, v.x);
+		minY = std::min(minY, v.y);
+		maxX = std::max(maxX, v.x);
+		maxY = std::max(maxY, v.y);
+
+		_indices[start + i] = index;
+	}
+
+	// geometry already inside its clip rect needs no scissor, so it can merge with its neighbours
+	bool inside =
+		minX >= scissor.left && maxX <= scissor.left + scissor.width &&
+		minY >= scissor.top && maxY <= scissor.top + scissor.height;
+
+	this->addBatch(texture, inside ? Scissor(0, 0, _width, _height) : scissor, count);
+}
+
+void
+GuiBatchRenderer::addBatch(const GraphicsTexturePtr& texture, const Scissor& scissor, std::size_t count) noexcept
+{
+	_numPendingCommands++;
+
+	if (!_batches.empty())
+	{
+		auto& last = _batches.back();
+		if (last.texture == texture && last.scissor == scissor)
+		{
+			last.numIndices += (std::uint32_t)count;
+			return;
+		}
+	}
+
+	GuiBatch batch;
+	batch.texture = texture;
+	batch.scissor = scissor;
+	batch.startIndice = (std::uint32_t)(_indices.size() - count);
+	batch.numIndices = (std::uint32_t)count;
+
+	_batches.push_back(std::move(batch));
+}
+
+bool
+GuiBatchRenderer::reserveBuffer(GraphicsDataPtr& buffer, GraphicsDataType type, std::size_t size) noexcept
+{
+	std::size_t streamSize = buffer ? buffer->getGraphicsDataDesc().getStreamSize() : 0;
+	if (streamSize >= size)
+		return true;
+
+	GraphicsDataDesc dataDesc;
+	dataDesc.setType(type);
+	dataDesc.setStream(nullptr);
+	dataDesc.setStreamSize(std::max<std::size_t>(std::max(size, streamSize * 2), 64 * 1024));
+	dataDesc.setUsage(GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit | GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit);
+
+	buffer = RenderSystem::instance()->createGraphicsData(dataDesc);
+	return buffer ? true : false;
+}
+
+GuiTextureAtlas&
+GuiBatchRenderer::getTextureAtlas() noexcept
+{
+	return _atlas;
+}
+
+std::size_t
+GuiBatchRenderer::getNumDrawCommands() const noexcept
+{
+	return _numDrawCommands;
+}
+
+std::size_t
+GuiBatchRenderer::getNumDrawCalls() const noexcept
+{
+	return _numDrawCalls;
+}
+
+_NAME_END
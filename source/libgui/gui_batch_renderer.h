@@ -0,0 +1,151 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2016.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#ifndef _H_GUI_BATCH_RENDERER_H_
+#define _H_GUI_BATCH_RENDERER_H_
+
+#include <ray/render_types.h>
+
+_NAME_BEGIN
+
+#define GUI_ATLAS_SIZE 2048
+#define GUI_ATLAS_MAX_IMAGE_SIZE 512
+
+struct GuiBatchVertex
+{
+	float x, y;
+	float u, v;
+	std::uint32_t color;
+};
+
+class GuiTextureAtlas final
+{
+public:
+	GuiTextureAtlas() noexcept;
+	~GuiTextureAtlas() noexcept;
+
+	bool insert(const std::uint8_t* pixels, std::uint32_t width, std::uint32_t height, std::uint32_t channel, float4& rect) noexcept;
+	void clear() noexcept;
+
+	const GraphicsTexturePtr& getTexture() noexcept;
+
+private:
+	GuiTextureAtlas(const GuiTextureAtlas&) noexcept = delete;
+	GuiTextureAtlas& operator=(const GuiTextureAtlas&) noexcept = delete;
+
+private:
+	bool _isDirty;
+
+	std::uint32_t _shelfX;
+	std::uint32_t _shelfY;
+	std::uint32_t _shelfHeight;
+
+	std::vector<std::uint8_t> _pixels;
+
+	GraphicsTexturePtr _texture;
+};
+
+class GuiBatchRenderer final
+{
+	__DeclareSingleton(GuiBatchRenderer)
+public:
+	GuiBatchRenderer() noexcept;
+	~GuiBatchRenderer() noexcept;
+
+	bool open() noexcept;
+	void close() noexcept;
+
+	void begin(std::uint32_t width, std::uint32_t height) noexcept;
+	void end() noexcept;
+
+	void getViewport(std::uint32_t& width, std::uint32_t& height) const noexcept;
+
+	GuiBatchVertex* addVertices(std::size_t count, std::uint32_t& baseVertex) noexcept;
+
+	void addTriangles(const GraphicsTexturePtr& texture, std::uint32_t baseVertex, std::size_t count) noexcept;
+	void addIndices(const GraphicsTexturePtr& texture, const Scissor& scissor, const std::uint16_t* indices, std::size_t count, std::uint32_t baseVertex) noexcept;
+
+	GuiTextureAtlas& getTextureAtlas() noexcept;
+
+	std::size_t getNumDrawCommands() const noexcept;
+	std::size_t getNumDrawCalls() const noexcept;
+
+private:
+	bool reserveBuffer(GraphicsDataPtr& buffer, GraphicsDataType type, std::size_t size) noexcept;
+	void addBatch(const GraphicsTexturePtr& texture, const Scissor& scissor, std::size_t count) noexcept;
+
+private:
+	GuiBatchRenderer(const GuiBatchRenderer&) noexcept = delete;
+	GuiBatchRenderer& operator=(const GuiBatchRenderer&) noexcept = delete;
+
+private:
+	struct GuiBatch
+	{
+		GraphicsTexturePtr texture;
+		Scissor scissor;
+		std::uint32_t startIndice;
+		std::uint32_t numIndices;
+	};
+
+	std::uint32_t _refCount;
+
+	bool _isBegin;
+
+	std::uint32_t _width;
+	std::uint32_t _height;
+
+	std::size_t _numDrawCommands;
+	std::size_t _numDrawCalls;
+	std::size_t _numPendingCommands;
+
+	std::vector<GuiBatch> _batches;
+	std::vector<GuiBatchVertex> _vertices;
+	std::vector<std::uint32_t> _indices;
+
+	GuiTextureAtlas _atlas;
+
+	MaterialPtr _material;
+	MaterialTechPtr _materialTech;
+	MaterialParamPtr _materialDecal;
+	MaterialParamPtr _materialProj;
+
+	GraphicsDataPtr _vbo;
+	GraphicsDataPtr _ibo;
+};
+
+_NAME_END
+
+#endif
@@ -43,6 +43,8 @@
 #include <imgui.h>
 #include <imgui_dock.h>
 
+#include "gui_batch_renderer.h"
+
 _NAME_BEGIN
 
 __ImplementSingleton(IMGUISystem)
@@ -132,34 +134,9 @@ IMGUISystem::open(void* _window, float dpi) except
 
 	io.Fonts->TexID = (void*)_texture.get();
 
-	ray::GraphicsDataDesc dataDesc;
-	dataDesc.setType(ray::GraphicsDataType::GraphicsDataTypeStorageVertexBuffer);
-	dataDesc.setStream(0);
-	dataDesc.setStreamSize(4096 * sizeof(ImDrawVert));
-	dataDesc.setUsage(ray::GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit);
-	_vbo = RenderSystem::instance()->createGraphicsData(dataDesc);
-	if (!_vbo)
-		return false;
-
-	ray::GraphicsDataDesc elementDesc;
-	elementDesc.setType(ray::GraphicsDataType::GraphicsDataTypeStorageIndexBuffer);
-	elementDesc.setStream(0);
-	elementDesc.setStreamSize(4096 * sizeof(ImDrawIdx));
-	elementDesc.setUsage(ray::GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit);
-	_ibo = RenderSystem::instance()->createGraphicsData(elementDesc);
-	if (!_ibo)
-		return false;
-
-	_material = RenderSystem::instance()->createMaterial("sys:fx/uilayout.fxml");
-	if (!_material)
+	if (!GuiBatchRenderer::instance()->open())
 		return false;
 
-	_materialTech = _material->getTech("IMGUI");
-	_materialDecal = _material->getParameter("decal");
-	_materialDecal->uniformTexture(_texture);
-
-	_materialProj = _material->getParameter("proj");
-
 	ImGui::LoadDock(_imguiDockPath.c_str());
 
 	_initialize = true;
@@ -169,13 +146,12 @@ IMGUISystem::open(void* _window, float dpi) except
 void
 IMGUISystem::close() noexcept
 {
-	_vbo.reset();
-	_ibo.reset();
 	_texture.reset();
-	_material.reset();
 
 	if (_initialize)
 	{
+		GuiBatchRenderer::instance()->close();
+
 		std::string path;
 		ray::IoServer::instance()->getAssign("sys", path);
 
@@ -304,14 +280,6 @@ IMGUISystem::setFramebufferScale(std::uint32_t w, std::uint32_t h) noexcept
 	ImGuiIO& io = ImGui::GetIO();
 	io.DisplayFramebufferScale.x = w;
 	io.DisplayFramebufferScale.y = h;
-
-	ray::float4x4 project;
-	if (RenderSystem::instance()->getRenderSetting().deviceType == GraphicsDeviceType::GraphicsDeviceTypeVulkan)
-		project.makeOrtho_lh(0, w, 0, h, 0, 1);
-	else
-		project.makeOrtho_lh(0, w, h, 0, 0, 1);
-
-	_materialProj->uniform4fmat(project);
 }
 
 void
@@ -325,96 +293,43 @@ IMGUISystem::getFramebufferScale(std::uint32_t& w, std::uint32_t& h) noexcept
 void
 IMGUISystem::render(float delta) except
 {
-	auto renderer = RenderSystem::instance();
+	static_assert(sizeof(ImDrawVert) == sizeof(GuiBatchVertex), "ImDrawVert must match GuiBatchVertex");
+	static_assert(sizeof(ImDrawIdx) == sizeof(std::uint16_t), "ImDrawIdx must be 16 bits");
 
 	auto drawData = ImGui::GetDrawData();
-
-	std::size_t totalVertexSize = drawData->TotalVtxCount * sizeof(ImDrawVert);
-	std::size_t totalIndirectSize = drawData->TotalIdxCount * sizeof(ImDrawIdx);
-	if (totalVertexSize == 0 || totalIndirectSize == 0)
+	if (drawData->TotalVtxCount == 0 || drawData->TotalIdxCount == 0)
 		return;
 
-	if (!_vbo || _vbo->getGraphicsDataDesc().getStreamSize() < totalVertexSize)
-	{
-		ray::GraphicsDataDesc dataDesc;
-		dataDesc.setType(ray::GraphicsDataType::GraphicsDataTypeStorageVertexBuffer);
-		dataDesc.setStream(0);
-		dataDesc.setStreamSize(totalVertexSize);
-		dataDesc.setUsage(_vbo->getGraphicsDataDesc().getUsage());
-		_vbo = renderer->createGraphicsData(dataDesc);
-		if (!_vbo)
-			return;
-	}
-
-	if (!_ibo || _ibo->getGraphicsDataDesc().getStreamSize() < totalIndirectSize)
-	{
-		ray::GraphicsDataDesc elementDesc;
-		elementDesc.setType(ray::GraphicsDataType::GraphicsDataTypeStorageIndexBuffer);
-		elementDesc.setStream(0);
-		elementDesc.setStreamSize(totalIndirectSize);
-		elementDesc.setUsage(_ibo->getGraphicsDataDesc().getUsage());
-		_ibo = renderer->createGraphicsData(elementDesc);
-		if (!_ibo)
-			return;
-	}
-
-	ImDrawVert* vbo;
-	ImDrawIdx* ibo;
+	auto& io = ImGui::GetIO();
 
-	if (!_vbo->map(0, totalVertexSize, (void**)&vbo))
-		return;
+	RenderSystem::instance()->clearFramebuffer(0, ray::GraphicsClearFlagBits::GraphicsClearFlagColorBit, float4::Zero, 1, 0);
 
-	if (!_ibo->map(0, totalIndirectSize, (void**)&ibo))
-		return;
+	auto batch = GuiBatchRenderer::instance();
+	batch->begin(io.DisplayFramebufferScale.x, io.DisplayFramebufferScale.y);
 
 	for (int n = 0; n < drawData->CmdListsCount; n++)
 	{
 		const ImDrawList* cmd_list = drawData->CmdLists[n];
-		std::memcpy(vbo, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
-		std::memcpy(ibo, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx));
-		vbo += cmd_list->VtxBuffer.size();
-		ibo += cmd_list->IdxBuffer.size();
-	}
-
-	_vbo->unmap();
-	_ibo->unmap();
-
-	auto& io = ImGui::GetIO();
 
-	renderer->clearFramebuffer(0, ray::GraphicsClearFlagBits::GraphicsClearFlagColorBit, float4::Zero, 1, 0);
-	renderer->setViewport(0, ray::Viewport(0, 0, io.DisplayFramebufferScale.x, io.DisplayFramebufferScale.y));
-	renderer->setScissor(0, ray::Scissor(0, 0, io.DisplayFramebufferScale.x, io.DisplayFramebufferScale.y));
+		std::uint32_t baseVertex = 0;
+		auto vertices = batch->addVertices(cmd_list->VtxBuffer.size(), baseVertex);
+		std::memcpy(vertices, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
 
-	renderer->setVertexBuffer(0, _vbo, 0);
-	renderer->setIndexBuffer(_ibo, 0, ray::GraphicsIndexType::GraphicsIndexTypeUInt16);
-
-	std::uint32_t vdx_buffer_offset = 0;
-	std::uint32_t idx_buffer_offset = 0;
-
-	for (int n = 0; n < drawData->CmdListsCount; n++)
-	{
-		const ImDrawList* cmd_list = drawData->CmdLists[n];
+		const ImDrawIdx* indices = cmd_list->IdxBuffer.Data;
 
 		for (const ImDrawCmd* pcmd = cmd_list->CmdBuffer.begin(); pcmd != cmd_list->CmdBuffer.end(); pcmd++)
 		{
 			auto texture = (ray::GraphicsTexture*)pcmd->TextureId;
-			if (texture)
-				_materialDecal->uniformTexture(texture->downcast_pointer<ray::GraphicsTexture>());
-			else
-				_materialDecal->uniformTexture(nullptr);
-
-			ImVec4 scissor((int)pcmd->ClipRect.x, (int)pcmd->ClipRect.y, (int)(pcmd->ClipRect.z - pcmd->ClipRect.x), (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
 
-			renderer->setScissor(0, ray::Scissor(scissor.x, scissor.y, scissor.z, scissor.w));
-			renderer->setMaterialPass(_materialTech->getPass(0));
+			ray::Scissor scissor((int)pcmd->ClipRect.x, (int)pcmd->ClipRect.y, (int)(pcmd->ClipRect.z - pcmd->ClipRect.x), (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
 
-			renderer->drawIndexed(pcmd->ElemCount, 1, idx_buffer_offset, vdx_buffer_offset, 0);
+			batch->addIndices(texture ? texture->downcast_pointer<ray::GraphicsTexture>() : nullptr, scissor, indices, pcmd->ElemCount, baseVertex);
 
-			idx_buffer_offset += pcmd->ElemCount;
+			indices += pcmd->ElemCount;
 		}
-
-		vdx_buffer_offset += cmd_list->VtxBuffer.size();
 	}
+
+	batch->end();
 }
 
 _NAME_END
\ No newline at end of file
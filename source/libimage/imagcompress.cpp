@@ -0,0 +1,2525 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2015.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include <ray/imagcompress.h>
+#include <ray/mathutil.h>
+#include <ray/thread.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+_NAME_BEGIN
+
+namespace image
+{
+	namespace
+	{
+		enum class block_t : std::uint8_t
+		{
+			BC1,
+			BC1A,
+			BC2,
+			BC3,
+			BC4,
+			BC5,
+			BC6H,
+			BC6HS,
+			BC7,
+		};
+
+		enum class source_t : std::uint8_t
+		{
+			UNorm8,
+			Float16,
+			Float32,
+		};
+
+		struct SourceLayout
+		{
+			source_t value;
+			bool sign;
+			std::uint32_t pixelSize;
+
+			// Element of R, G, B and A inside a texel, -1 when the source has no such channel.
+			std::int32_t offset[4];
+		};
+
+		struct CompressLevel
+		{
+			std::uint32_t width;
+			std::uint32_t height;
+			std::uint32_t blocksX;
+			std::uint32_t blocksY;
+			std::size_t srcOffset;
+			std::size_t dstOffset;
+			std::size_t firstTask;
+		};
+
+		struct Subsets
+		{
+			std::uint32_t count[3];
+			std::uint8_t texels[3][16];
+		};
+
+		const float MaxError = std::numeric_limits<float>::max();
+
+		const std::uint8_t Weights2[4] = { 0, 21, 43, 64 };
+		const std::uint8_t Weights3[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+		const std::uint8_t Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+		// Texels in subset 1 of the two subset partitions shared by BC6H and BC7, bit i is texel i.
+		const std::uint16_t Partition2[64] =
+		{
+			0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+			0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+			0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+			0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+			0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+			0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+			0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+			0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+		};
+
+		const std::uint8_t Partition3[64][16] =
+		{
+			{ 0,0,1,1, 0,0,1,1, 0,2,2,1, 2,2,2,2 }, { 0,0,0,1, 0,0,1,1, 2,2,1,1, 2,2,2,1 },
+			{ 0,0,0,0, 2,0,0,1, 2,2,1,1, 2,2,1,1 }, { 0,2,2,2, 0,0,2,2, 0,0,1,1, 0,1,1,1 },
+			{ 0,0,0,0, 0,0,0,0, 1,1,2,2, 1,1,2,2 }, { 0,0,1,1, 0,0,1,1, 0,0,2,2, 0,0,2,2 },
+			{ 0,0,2,2, 0,0,2,2, 1,1,1,1, 1,1,1,1 }, { 0,0,1,1, 0,0,1,1, 2,2,1,1, 2,2,1,1 },
+			{ 0,0,0,0, 0,0,0,0, 1,1,1,1, 2,2,2,2 }, { 0,0,0,0, 1,1,1,1, 1,1,1,1, 2,2,2,2 },
+			{ 0,0,0,0, 1,1,1,1, 2,2,2,2, 2,2,2,2 }, { 0,0,1,2, 0,0,1,2, 0,0,1,2, 0,0,1,2 },
+			{ 0,1,1,2, 0,1,1,2, 0,1,1,2, 0,1,1,2 }, { 0,1,2,2, 0,1,2,2, 0,1,2,2, 0,1,2,2 },
+			{ 0,0,1,1, 0,1,1,2, 1,1,2,2, 1,2,2,2 }, { 0,0,1,1, 2,0,0,1, 2,2,0,0, 2,2,2,0 },
+			{ 0,0,0,1, 0,0,1,1, 0,1,1,2, 1,1,2,2 }, { 0,1,1,1, 0,0,1,1, 2,0,0,1, 2,2,0,0 },
+			{ 0,0,0,0, 1,1,2,2, 1,1,2,2, 1,1,2,2 }, { 0,0,2,2, 0,0,2,2, 0,0,2,2, 1,1,1,1 },
+			{ 0,1,1,1, 0,1,1,1, 0,2,2,2, 0,2,2,2 }, { 0,0,0,1, 0,0,0,1, 2,2,2,1, 2,2,2,1 },
+			{ 0,0,0,0, 0,0,1,1, 0,1,2,2, 0,1,2,2 }, { 0,0,0,0, 1,1,0,0, 2,2,1,0, 2,2,1,0 },
+			{ 0,1,2,2, 0,1,2,2, 0,0,1,1, 0,0,0,0 }, { 0,0,1,2, 0,0,1,2, 1,1,2,2, 2,2,2,2 },
+			{ 0,1,1,0, 1,2,2,1, 1,2,2,1, 0,1,1,0 }, { 0,0,0,0, 0,1,1,0, 1,2,2,1, 1,2,2,1 },
+			{ 0,0,2,2, 1,1,0,2, 1,1,0,2, 0,0,2,2 }, { 0,1,1,0, 0,1,1,0, 2,0,0,2, 2,2,2,2 },
+			{ 0,0,1,1, 0,1,2,2, 0,1,2,2, 0,0,1,1 }, { 0,0,0,0, 2,0,0,0, 2,2,1,1, 2,2,2,1 },
+			{ 0,0,0,0, 0,0,0,2, 1,1,2,2, 1,2,2,2 }, { 0,2,2,2, 0,0,2,2, 0,0,1,2, 0,0,1,1 },
+			{ 0,0,1,1, 0,0,1,2, 0,0,2,2, 0,2,2,2 }, { 0,1,2,0, 0,1,2,0, 0,1,2,0, 0,1,2,0 },
+			{ 0,0,0,0, 1,1,1,1, 2,2,2,2, 0,0,0,0 }, { 0,1,2,0, 1,2,0,1, 2,0,1,2, 0,1,2,0 },
+			{ 0,1,2,0, 2,0,1,2, 1,2,0,1, 0,1,2,0 }, { 0,0,1,1, 2,2,0,0, 1,1,2,2, 0,0,1,1 },
+			{ 0,0,1,1, 1,1,2,2, 2,2,0,0, 0,0,1,1 }, { 0,1,0,1, 0,1,0,1, 2,2,2,2, 2,2,2,2 },
+			{ 0,0,0,0, 0,0,0,0, 2,1,2,1, 2,1,2,1 }, { 0,0,2,2, 1,1,2,2, 0,0,2,2, 1,1,2,2 },
+			{ 0,0,2,2, 0,0,1,1, 0,0,2,2, 0,0,1,1 }, { 0,2,2,0, 1,2,2,1, 0,2,2,0, 1,2,2,1 },
+			{ 0,1,0,1, 2,2,2,2, 2,2,2,2, 0,1,0,1 }, { 0,0,0,0, 2,1,2,1, 2,1,2,1, 2,1,2,1 },
+			{ 0,1,0,1, 0,1,0,1, 0,1,0,1, 2,2,2,2 }, { 0,2,2,2, 0,1,1,1, 0,2,2,2, 0,1,1,1 },
+			{ 0,0,0,2, 1,1,1,2, 0,0,0,2, 1,1,1,2 }, { 0,0,0,0, 2,1,1,2, 2,1,1,2, 2,1,1,2 },
+			{ 0,2,2,2, 0,1,1,1, 0,1,1,1, 0,2,2,2 }, { 0,0,0,2, 1,1,1,2, 1,1,1,2, 0,0,0,2 },
+			{ 0,1,1,0, 0,1,1,0, 0,1,1,0, 2,2,2,2 }, { 0,0,0,0, 0,0,0,0, 2,1,1,2, 2,1,1,2 },
+			{ 0,1,1,0, 0,1,1,0, 2,2,2,2, 2,2,2,2 }, { 0,0,2,2, 0,0,1,1, 0,0,1,1, 0,0,2,2 },
+			{ 0,0,2,2, 1,1,2,2, 1,1,2,2, 0,0,2,2 }, { 0,0,0,0, 0,0,0,0, 0,0,0,0, 2,1,1,2 },
+			{ 0,0,0,2, 0,0,0,1, 0,0,0,2, 0,0,0,1 }, { 0,2,2,2, 1,2,2,2, 0,2,2,2, 1,2,2,2 },
+			{ 0,1,0,1, 2,2,2,2, 2,2,2,2, 2,2,2,2 }, { 0,1,1,1, 2,0,1,1, 2,2,0,1, 2,2,2,0 },
+		};
+
+		// Texel whose index drops its implicit high bit in subset 1 of two subsets, and subsets 1 and 2 of three.
+		const std::uint8_t Anchor2[64] =
+		{
+			15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+			15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+			15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+			 6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+		};
+
+		const std::uint8_t Anchor3a[64] =
+		{
+			 3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+			 3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+			 8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+			 3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+		};
+
+		const std::uint8_t Anchor3b[64] =
+		{
+			15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+			15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+			15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+			15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+		};
+
+		// 128 bit blocks are packed from the least significant bit of the first byte.
+		struct BlockWriter
+		{
+			std::uint64_t data[2] = { 0, 0 };
+			std::uint32_t pos = 0;
+
+			void write(std::uint32_t value, std::uint32_t bits) noexcept
+			{
+				if (bits == 0)
+					return;
+
+				std::uint64_t v = value & ((1ULL << bits) - 1);
+				std::uint32_t word = pos >> 6;
+				std::uint32_t shift = pos & 63;
+
+				data[word] |= v << shift;
+				if (shift + bits > 64)
+					data[word + 1] |= v >> (64 - shift);
+
+				pos += bits;
+			}
+
+			void store(std::uint8_t* dst) const noexcept
+			{
+				for (std::uint32_t i = 0; i < 16; i++)
+					dst[i] = (std::uint8_t)(data[i >> 3] >> ((i & 7) * 8));
+			}
+		};
+
+		struct BlockReader
+		{
+			std::uint64_t data[2] = { 0, 0 };
+			std::uint32_t pos = 0;
+
+			explicit BlockReader(const std::uint8_t* src) noexcept
+			{
+				for (std::uint32_t i = 0; i < 16; i++)
+					data[i >> 3] |= (std::uint64_t)src[i] << ((i & 7) * 8);
+			}
+
+			std::uint32_t read(std::uint32_t bits) noexcept
+			{
+				if (bits == 0)
+					return 0;
+
+				std::uint32_t word = pos >> 6;
+				std::uint32_t shift = pos & 63;
+
+				std::uint64_t v = data[word] >> shift;
+				if (shift + bits > 64)
+					v |= data[word + 1] << (64 - shift);
+
+				pos += bits;
+
+				return (std::uint32_t)(v & ((1ULL << bits) - 1));
+			}
+		};
+
+		inline std::int32_t clampInt(std::int32_t value, std::int32_t lo, std::int32_t hi) noexcept
+		{
+			return value < lo ? lo : (value > hi ? hi : value);
+		}
+
+		inline std::int32_t roundInt(float value) noexcept
+		{
+			return (std::int32_t)std::floor(value + 0.5f);
+		}
+
+		inline const std::uint8_t* getWeights(std::uint32_t bits) noexcept
+		{
+			return bits == 2 ? Weights2 : (bits == 3 ? Weights3 : Weights4);
+		}
+
+		inline std::uint32_t getSubset(std::uint32_t subsets, std::uint32_t partition, std::uint32_t texel) noexcept
+		{
+			if (subsets == 2)
+				return (Partition2[partition] >> texel) & 1;
+			if (subsets == 3)
+				return Partition3[partition][texel];
+			return 0;
+		}
+
+		inline std::uint32_t getAnchor(std::uint32_t subsets, std::uint32_t partition, std::uint32_t subset) noexcept
+		{
+			if (subset == 0)
+				return 0;
+			if (subsets == 2)
+				return Anchor2[partition];
+			return subset == 1 ? Anchor3a[partition] : Anchor3b[partition];
+		}
+
+		inline bool isAnchor(std::uint32_t subsets, std::uint32_t partition, std::uint32_t texel) noexcept
+		{
+			for (std::uint32_t i = 0; i < subsets; i++)
+			{
+				if (getAnchor(subsets, partition, i) == texel)
+					return true;
+			}
+
+			return false;
+		}
+
+		void makeSubsets(Subsets& result, std::uint32_t subsets, std::uint32_t partition) noexcept
+		{
+			result.count[0] = result.count[1] = result.count[2] = 0;
+
+			for (std::uint32_t i = 0; i < 16; i++)
+			{
+				std::uint32_t subset = getSubset(subsets, partition, i);
+				result.texels[subset][result.count[subset]++] = (std::uint8_t)i;
+			}
+		}
+
+		// Dominant eigenvector of a symmetric matrix by power iteration, zero when the matrix is.
+		void principalAxis(const float covariance[4][4], std::uint32_t first, std::uint32_t channel, float axis[4]) noexcept
+		{
+			std::uint32_t row = first;
+			for (std::uint32_t c = first; c < first + channel; c++)
+			{
+				if (covariance[c][c] > covariance[row][row])
+					row = c;
+			}
+
+			for (std::uint32_t c = 0; c < 4; c++)
+				axis[c] = (c >= first && c < first + channel) ? covariance[row][c] : 0.0f;
+
+			for (std::uint32_t i = 0; i < 8; i++)
+			{
+				float next[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+				float length = 0.0f;
+
+				for (std::uint32_t a = first; a < first + channel; a++)
+				{
+					for (std::uint32_t b = first; b < first + channel; b++)
+						next[a] += covariance[a][b] * axis[b];
+
+					length = std::max(length, std::abs(next[a]));
+				}
+
+				if (length < 1e-12f)
+					break;
+
+				for (std::uint32_t a = first; a < first + channel; a++)
+					axis[a] = next[a] / length;
+			}
+
+			float length = 0.0f;
+			for (std::uint32_t c = first; c < first + channel; c++)
+				length += axis[c] * axis[c];
+
+			length = length > 1e-12f ? 1.0f / std::sqrt(length) : 0.0f;
+
+			for (std::uint32_t c = first; c < first + channel; c++)
+				axis[c] *= length;
+		}
+
+		// Endpoints of the listed texels on their principal axis in channels [first, first + channel),
+		// returns the squared distance of the texels to that line.
+		float fitSubset(const float texels[16][4], const std::uint8_t* list, std::uint32_t count, std::uint32_t first, std::uint32_t channel, float e0[4], float e1[4]) noexcept
+		{
+			float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float covariance[4][4] = {};
+
+			for (std::uint32_t k = 0; k < count; k++)
+			{
+				for (std::uint32_t c = first; c < first + channel; c++)
+					mean[c] += texels[list[k]][c];
+			}
+
+			for (std::uint32_t c = first; c < first + channel; c++)
+				mean[c] /= count;
+
+			for (std::uint32_t k = 0; k < count; k++)
+			{
+				for (std::uint32_t a = first; a < first + channel; a++)
+				{
+					float da = texels[list[k]][a] - mean[a];
+					for (std::uint32_t b = a; b < first + channel; b++)
+						covariance[a][b] += da * (texels[list[k]][b] - mean[b]);
+				}
+			}
+
+			for (std::uint32_t a = first; a < first + channel; a++)
+			{
+				for (std::uint32_t b = first; b < a; b++)
+					covariance[a][b] = covariance[b][a];
+			}
+
+			float axis[4];
+			principalAxis(covariance, first, channel, axis);
+
+			float lo = 0.0f;
+			float hi = 0.0f;
+			float error = 0.0f;
+
+			for (std::uint32_t k = 0; k < count; k++)
+			{
+				float t = 0.0f;
+				float distance = 0.0f;
+
+				for (std::uint32_t c = first; c < first + channel; c++)
+				{
+					float d = texels[list[k]][c] - mean[c];
+					t += d * axis[c];
+					distance += d * d;
+				}
+
+				lo = std::min(lo, t);
+				hi = std::max(hi, t);
+				error += std::max(distance - t * t, 0.0f);
+			}
+
+			for (std::uint32_t c = first; c < first + channel; c++)
+			{
+				e0[c] = mean[c] + axis[c] * lo;
+				e1[c] = mean[c] + axis[c] * hi;
+			}
+
+			return error;
+		}
+
+		// Least squares endpoints for fixed interpolation weights, fails when every texel has the same weight.
+		bool solveEndpoints(const float texels[16][4], const std::uint8_t* list, std::uint32_t count, std::uint32_t first, std::uint32_t channel, const float* weights, float e0[4], float e1[4]) noexcept
+		{
+			float aa = 0.0f;
+			float ab = 0.0f;
+			float bb = 0.0f;
+			float ax[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			float bx[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+			for (std::uint32_t k = 0; k < count; k++)
+			{
+				float b = weights[k];
+				float a = 1.0f - b;
+
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+
+				for (std::uint32_t c = first; c < first + channel; c++)
+				{
+					ax[c] += a * texels[list[k]][c];
+					bx[c] += b * texels[list[k]][c];
+				}
+			}
+
+			float det = aa * bb - ab * ab;
+			if (std::abs(det) < 1e-6f)
+				return false;
+
+			float invDet = 1.0f / det;
+
+			for (std::uint32_t c = first; c < first + channel; c++)
+			{
+				e0[c] = (ax[c] * bb - bx[c] * ab) * invDet;
+				e1[c] = (bx[c] * aa - ax[c] * ab) * invDet;
+			}
+
+			return true;
+		}
+
+		inline void clampEndpoints(float e0[4], float e1[4], std::uint32_t first, std::uint32_t channel, float lo, float hi) noexcept
+		{
+			for (std::uint32_t c = first; c < first + channel; c++)
+			{
+				e0[c] = std::min(std::max(e0[c], lo), hi);
+				e1[c] = std::min(std::max(e1[c], lo), hi);
+			}
+		}
+
+		// Squared distance of the texels of one subset to their principal axis, from the running sums alone.
+		float lineError(const float sum[4], const float product[4][4], std::uint32_t count, std::uint32_t channel) noexcept
+		{
+			if (count < 2)
+				return 0.0f;
+
+			float covariance[4][4];
+			float trace = 0.0f;
+
+			for (std::uint32_t a = 0; a < channel; a++)
+			{
+				for (std::uint32_t b = 0; b < channel; b++)
+					covariance[a][b] = product[a][b] - sum[a] * sum[b] / count;
+
+				trace += covariance[a][a];
+			}
+
+			float axis[4];
+			principalAxis(covariance, 0, channel, axis);
+
+			float variance = 0.0f;
+			for (std::uint32_t a = 0; a < channel; a++)
+			{
+				for (std::uint32_t b = 0; b < channel; b++)
+					variance += axis[a] * covariance[a][b] * axis[b];
+			}
+
+			return std::max(trace - variance, 0.0f);
+		}
+
+		// Ranks the first partitionCount partitions by how well a line fits every subset and keeps the best ones.
+		std::uint32_t selectPartitions(const float texels[16][4], std::uint32_t subsets, std::uint32_t partitionCount, std::uint32_t channel, std::uint32_t count, std::uint32_t* partitions) noexcept
+		{
+			float errors[64];
+			std::uint32_t selected = 0;
+
+			for (std::uint32_t partition = 0; partition < partitionCount; partition++)
+			{
+				float sum[3][4] = {};
+				float product[3][4][4] = {};
+				std::uint32_t texelCount[3] = { 0, 0, 0 };
+
+				for (std::uint32_t i = 0; i < 16; i++)
+				{
+					std::uint32_t subset = getSubset(subsets, partition, i);
+
+					texelCount[subset]++;
+
+					for (std::uint32_t a = 0; a < channel; a++)
+					{
+						sum[subset][a] += texels[i][a];
+						for (std::uint32_t b = 0; b < channel; b++)
+							product[subset][a][b] += texels[i][a] * texels[i][b];
+					}
+				}
+
+				float error = 0.0f;
+				for (std::uint32_t subset = 0; subset < subsets; subset++)
+					error += lineError(sum[subset], product[subset], texelCount[subset], channel);
+
+				std::uint32_t slot = selected < count ? selected++ : count;
+				while (slot > 0 && errors[slot - 1] > error)
+				{
+					if (slot < count)
+					{
+						errors[slot] = errors[slot - 1];
+						partitions[slot] = partitions[slot - 1];
+					}
+
+					slot--;
+				}
+
+				if (slot < count)
+				{
+					errors[slot] = error;
+					partitions[slot] = partition;
+				}
+			}
+
+			return selected;
+		}
+
+		inline std::uint16_t packColor(const std::int32_t color[3]) noexcept
+		{
+			return (std::uint16_t)((color[0] << 11) | (color[1] << 5) | color[2]);
+		}
+
+		inline void unpackColor(std::uint16_t color, std::int32_t components[3]) noexcept
+		{
+			components[0] = (color >> 11) & 31;
+			components[1] = (color >> 5) & 63;
+			components[2] = color & 31;
+		}
+
+		inline void quantizeColor(const float rgb[4], std::int32_t color[3]) noexcept
+		{
+			color[0] = clampInt(roundInt(rgb[0] * (31.0f / 255.0f)), 0, 31);
+			color[1] = clampInt(roundInt(rgb[1] * (63.0f / 255.0f)), 0, 63);
+			color[2] = clampInt(roundInt(rgb[2] * (31.0f / 255.0f)), 0, 31);
+		}
+
+		inline void expandColor(std::uint16_t color, std::int32_t rgb[3]) noexcept
+		{
+			std::int32_t r = (color >> 11) & 31;
+			std::int32_t g = (color >> 5) & 63;
+			std::int32_t b = color & 31;
+
+			rgb[0] = (r << 3) | (r >> 2);
+			rgb[1] = (g << 2) | (g >> 4);
+			rgb[2] = (b << 3) | (b >> 2);
+		}
+
+		void makeColorPalette(std::uint16_t color0, std::uint16_t color1, bool fourColor, std::int32_t palette[4][3]) noexcept
+		{
+			expandColor(color0, palette[0]);
+			expandColor(color1, palette[1]);
+
+			for (std::uint32_t c = 0; c < 3; c++)
+			{
+				if (fourColor)
+				{
+					palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+					palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+				}
+				else
+				{
+					palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+					palette[3][c] = 0;
+				}
+			}
+		}
+
+		struct ColorEndpoints
+		{
+			std::uint16_t color0;
+			std::uint16_t color1;
+			std::uint32_t indices;
+			float error;
+		};
+
+		// Picks the nearest palette entry for the opaque texels, the others take the transparent index 3.
+		void evaluateColors(const float texels[16][4], std::uint32_t opaque, bool fourColor, std::uint16_t color0, std::uint16_t color1, ColorEndpoints& result) noexcept
+		{
+			std::int32_t palette[4][3];
+			makeColorPalette(color0, color1, fourColor, palette);
+
+			const std::uint32_t levels = fourColor ? 4 : 3;
+
+			result.color0 = color0;
+			result.color1 = color1;
+			result.indices = 0;
+			result.error = 0.0f;
+
+			for (std::uint32_t i = 0; i < 16; i++)
+			{
+				if (!(opaque & (1 << i)))
+				{
+					result.indices |= 3u << (i * 2);
+					continue;
+				}
+
+				std::uint32_t best = 0;
+				float bestError = MaxError;
+
+				for (std::uint32_t k = 0; k < levels; k++)
+				{
+					float dr = texels[i][0] - palette[k][0];
+					float dg = texels[i][1] - palette[k][1];
+					float db = texels[i][2] - palette[k][2];
+					float error = dr * dr + dg * dg + db * db;
+
+					if (error < bestError)
+					{
+						best = k;
+						bestError = error;
+					}
+				}
+
+				result.indices |= best << (i * 2);
+				result.error += bestError;
+			}
+		}
+
+		struct SingleColorTable
+		{
+			std::uint8_t color5[256][2];
+			std::uint8_t color6[256][2];
+		};
+
+		void makeSingleColorTable(std::uint8_t table[256][2], std::uint32_t bits) noexcept
+		{
+			const std::int32_t count = 1 << bits;
+
+			for (std::int32_t value = 0; value < 256; value++)
+			{
+				std::int32_t bestError = 256;
+
+				for (std::int32_t a = 0; a < count && bestError > 0; a++)
+				{
+					std::int32_t ea = bits == 5 ? (a << 3) | (a >> 2) : (a << 2) | (a >> 4);
+
+					for (std::int32_t b = 0; b < count; b++)
+					{
+						std::int32_t eb = bits == 5 ? (b << 3) | (b >> 2) : (b << 2) | (b >> 4);
+						std::int32_t error = std::abs((2 * ea + eb) / 3 - value);
+
+						if (error < bestError)
+						{
+							table[value][0] = (std::uint8_t)a;
+							table[value][1] = (std::uint8_t)b;
+							bestError = error;
+						}
+					}
+				}
+			}
+		}
+
+		// Endpoints whose one third interpolant lands nearest to every 8 bit value, so flat blocks stay flat.
+		const SingleColorTable& getSingleColorTable() noexcept
+		{
+			static const SingleColorTable table = []()
+			{
+				SingleColorTable result;
+				makeSingleColorTable(result.color5, 5);
+				makeSingleColorTable(result.color6, 6);
+				return result;
+			}();
+
+			return table;
+		}
+
+		// Steps every 5:6:5 component of both endpoints by one while the error keeps dropping.
+		void searchColors(const float texels[16][4], std::uint32_t opaque, bool fourColor, ColorEndpoints& best) noexcept
+		{
+			static const std::int32_t limits[3] = { 31, 63, 31 };
+
+			std::int32_t colors[2][3];
+			unpackColor(best.color0, colors[0]);
+			unpackColor(best.color1, colors[1]);
+
+			for (std::uint32_t pass = 0; pass < 8; pass++)
+			{
+				bool improved = false;
+
+				for (std::uint32_t e = 0; e < 2; e++)
+				{
+					for (std::uint32_t c = 0; c < 3; c++)
+					{
+						for (std::int32_t step = -1; step <= 1; step += 2)
+						{
+							std::int32_t value = colors[e][c] + step;
+							if (value < 0 || value > limits[c])
+								continue;
+
+							std::int32_t trial[2][3];
+							std::memcpy(trial, colors, sizeof(trial));
+							trial[e][c] = value;
+
+							ColorEndpoints result;
+							evaluateColors(texels, opaque, fourColor, packColor(trial[0]), packColor(trial[1]), result);
+
+							if (result.error < best.error)
+							{
+								best = result;
+								std::memcpy(colors, trial, sizeof(colors));
+								improved = true;
+							}
+						}
+					}
+				}
+
+				if (!improved)
+					break;
+			}
+		}
+
+		// BC1 colour block, also the colour half of BC2 and BC3 which always decode four colours.
+		void encodeColorBlock(const float texels[16][4], bool punchThrough, compress_quality_t quality, std::uint8_t* dst) noexcept
+		{
+			static const float fourWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+			static const float threeWeights[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+
+			std::uint8_t list[16];
+			std::uint32_t count = 0;
+			std::uint32_t opaque = 0;
+			bool flat = true;
+
+			for (std::uint32_t i = 0; i < 16; i++)
+			{
+				if (punchThrough && texels[i][3] < 128.0f)
+					continue;
+
+				if (count > 0)
+				{
+					const float* texel = texels[list[0]];
+					flat &= texels[i][0] == texel[0] && texels[i][1] == texel[1] && texels[i][2] == texel[2];
+				}
+
+				list[count++] = (std::uint8_t)i;
+				opaque |= 1 << i;
+			}
+
+			const bool fourColor = count == 16;
+
+			ColorEndpoints best;
+
+			if (count == 0)
+			{
+				best.color0 = 0;
+				best.color1 = 0;
+				best.indices = 0xFFFFFFFF;
+			}
+			else if (flat && fourColor && quality != compress_quality_t::Fast)
+			{
+				auto& table = getSingleColorTable();
+
+				std::int32_t r = clampInt(roundInt(texels[0][0]), 0, 255);
+				std::int32_t g = clampInt(roundInt(texels[0][1]), 0, 255);
+				std::int32_t b = clampInt(roundInt(texels[0][2]), 0, 255);
+
+				std::int32_t color0[3] = { table.color5[r][0], table.color6[g][0], table.color5[b][0] };
+				std::int32_t color1[3] = { table.color5[r][1], table.color6[g][1], table.color5[b][1] };
+
+				best.color0 = packColor(color0);
+				best.color1 = packColor(color1);
+				best.indices = 0xAAAAAAAA;
+			}
+			else
+			{
+				float e0[4];
+				float e1[4];
+				fitSubset(texels, list, count, 0, 3, e0, e1);
+
+				std::int32_t color0[3];
+				std::int32_t color1[3];
+				quantizeColor(e0, color0);
+				quantizeColor(e1, color1);
+
+				evaluateColors(texels, opaque, fourColor, packColor(color0), packColor(color1), best);
+
+				std::uint32_t iterations = quality == compress_quality_t::Fast ? 0 : (quality == compress_quality_t::Normal ? 2 : 4);
+
+				for (std::uint32_t it = 0; it < iterations && best.error > 0.0f; it++)
+				{
+					float weights[16];
+					for (std::uint32_t k = 0; k < count; k++)
+					{
+						std::uint32_t index = (best.indices >> (list[k] * 2)) & 3;
+						weights[k] = fourColor ? fourWeights[index] : threeWeights[index];
+					}
+
+					if (!solveEndpoints(texels, list, count, 0, 3, weights, e0, e1))
+						break;
+
+					clampEndpoints(e0, e1, 0, 3, 0.0f, 255.0f);
+					quantizeColor(e0, color0);
+					quantizeColor(e1, color1);
+
+					ColorEndpoints result;
+					evaluateColors(texels, opaque, fourColor, packColor(color0), packColor(color1), result);
+
+					if (result.error >= best.error)
+						break;
+
+					best = result;
+				}
+
+				if (quality == compress_quality_t::High && best.error > 0.0f)
+					searchColors(texels, opaque, fourColor, best);
+			}
+
+			// color0 > color1 selects four colours, swapping the endpoints mirrors the indices.
+			if (fourColor)
+			{
+				if (best.color0 < best.color1)
+				{
+					std::swap(best.color0, best.color1);
+					best.indices ^= 0x55555555;
+				}
+				else if (best.color0 == best.color1)
+				{
+					best.indices = 0;
+				}
+			}
+			else if (best.color0 > best.color1)
+			{
+				std::swap(best.color0, best.color1);
+
+				for (std::uint32_t i = 0; i < 16; i++)
+				{
+					if (((best.indices >> (i * 2)) & 3) < 2)
+						best.indices ^= 1u << (i * 2);
+				}
+			}
+
+			dst[0] = (std::uint8_t)best.color0;
+			dst[1] = (std::uint8_t)(best.color0 >> 8);
+			dst[2] = (std::uint8_t)best.color1;
+			dst[3] = (std::uint8_t)(best.color1 >> 8);
+
+			for (std::uint32_t i = 0; i < 4; i++)
+				dst[4 + i] = (std::uint8_t)(best.indices >> (i * 8));
+		}
+
+		void makeAlphaPalette(std::int32_t alpha0, std::int32_t alpha1, std::int32_t palette[8]) noexcept
+		{
+			palette[0] = alpha0;
+			palette[1] = alpha1;
+
+			if (alpha0 > alpha1)
+			{
+				for (std::int32_t i = 1; i < 7; i++)
+					palette[i + 1] = ((7 - i) * alpha0 + i * alpha1) / 7;
+			}
+			else
+			{
+				for (std::int32_t i = 1; i < 5; i++)
+					palette[i + 1] = ((5 - i) * alpha0 + i * alpha1) / 5;
+
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+		}
+
+		struct AlphaEndpoints
+		{
+			std::int32_t alpha0;
+			std::int32_t alpha1;
+			std::uint64_t indices;
+			float error;
+		};
+
+		void evaluateAlpha(const float texels[16][4], std::uint32_t channel, std::int32_t alpha0, std::int32_t alpha1, AlphaEndpoints& result) noexcept
+		{
+			std::int32_t palette[8];
+			makeAlphaPalette(alpha0, alpha1, palette);
+
+			result.alpha0 = alpha0;
+			result.alpha1 = alpha1;
+			result.indices = 0;
+			result.error = 0.0f;
+
+			for (std::uint32_t i = 0; i < 16; i++)
+			{
+				std::uint32_t best = 0;
+				float bestError = MaxError;
+
+				for (std::uint32_t k = 0; k < 8; k++)
+				{
+					float d = texels[i][channel] - palette[k];
+					if (d * d < bestError)
+					{
+						best = k;
+						bestError = d * d;
+					}
+				}
+
+				result.indices |= (std::uint64_t)best << (i * 3);
+				result.error += bestError;
+			}
+		}
+
+		// BC4 block, also the alpha half of BC3 and each half of BC5.
+		void encodeAlphaBlock(const float texels[16][4], std::uint32_t channel, compress_quality_t quality, std::uint8_t* dst) noexcept
+		{
+			float lo = 255.0f;
+			float hi = 0.0f;
+			float innerLo = 255.0f;
+			float innerHi = 0.0f;
+
+			for (std::uint32_t i = 0; i < 16; i++)
+			{
+				float value = texels[i][channel];
+
+				lo = std::min(lo, value);
+				hi = std::max(hi, value);
+
+				if (value > 0.5f && value < 254.5f)
+				{
+					innerLo = std::min(innerLo, value);
+					innerHi = std::max(innerHi, value);
+				}
+			}
+
+			std::int32_t alpha0 = clampInt(roundInt(hi), 0, 255);
+			std::int32_t alpha1 = clampInt(roundInt(lo), 0, 255);
+
+			AlphaEndpoints best;
+			evaluateAlpha(texels, channel, alpha0, alpha1, best);
+
+			if (quality != compress_quality_t::Fast && best.error > 0.0f)
+			{
+				std::uint32_t iterations = quality == compress_quality_t::Normal ? 1 : 2;
+
+				static const std::uint8_t all[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+				for (std::uint32_t it = 0; it < iterations && best.alpha0 > best.alpha1; it++)
+				{
+					float weights[16];
+					for (std::uint32_t i = 0; i < 16; i++)
+					{
+						std::uint32_t index = (std::uint32_t)(best.indices >> (i * 3)) & 7;
+						weights[i] = index == 0 ? 0.0f : (index == 1 ? 1.0f : (index - 1) / 7.0f);
+					}
+
+					float e0[4];
+					float e1[4];
+					if (!solveEndpoints(texels, all, 16, channel, 1, weights, e0, e1))
+						break;
+
+					alpha0 = clampInt(roundInt(e0[channel]), 0, 255);
+					alpha1 = clampInt(roundInt(e1[channel]), 0, 255);
+					if (alpha0 <= alpha1)
+						break;
+
+					AlphaEndpoints result;
+					evaluateAlpha(texels, channel, alpha0, alpha1, result);
+
+					if (result.error >= best.error)
+						break;
+
+					best = result;
+				}
+
+				// Blocks touching 0 or 255 can spend the six value mode on the texels in between.
+				if ((lo < 0.5f || hi > 254.5f) && innerLo <= innerHi)
+				{
+					AlphaEndpoints result;
+					evaluateAlpha(texels, channel, clampInt(roundInt(innerLo), 0, 255), clampInt(roundInt(innerHi), 0, 255), result);
+
+					if (result.error < best.error)
+						best = result;
+				}
+			}
+
+			if (quality == compress_quality_t::High && best.error > 0.0f)
+			{
+				const std::int32_t center0 = best.alpha0;
+				const std::int32_t center1 = best.alpha1;
+
+				for (std::int32_t a = std::max(center0 - 2, 0); a <= std::min(center0 + 2, 255); a++)
+				{
+					for (std::int32_t b = std::max(center1 - 2, 0); b <= std::min(center1 + 2, 255); b++)
+					{
+						if ((a > b) != (center0 > center1))
+							continue;
+
+						AlphaEndpoints result;
+						evaluateAlpha(texels, channel, a, b, result);
+
+						if (result.error < best.error)
+							best = result;
+					}
+				}
+			}
+
+			dst[0] = (std::uint8_t)best.alpha0;
+			dst[1] = (std::uint8_t)best.alpha1;
+
+			for (std::uint32_t i = 0; i < 6; i++)
+				dst[2 + i] = (std::uint8_t)(best.indices >> (i * 8));
+		}
+
+		void encodeExplicitAlpha(const float texels[16][4], std::uint8_t* dst) noexcept
+		{
+			for (std::uint32_t i = 0; i < 8; i++)
+			{
+				std::int32_t lo = clampInt(roundInt(texels[i * 2][3] * (15.0f / 255.0f)), 0, 15);
+				std::int32_t hi = clampInt(roundInt(texels[i * 2 + 1][3] * (15.0f / 255.0f)), 0, 15);
+				dst[i] = (std::uint8_t)(lo | (hi << 4));
+			}
+		}
+
+		void decodeColorBlock(const std::uint8_t* src, bool forceFour, bool punchThrough, std::uint8_t texels[16][4]) noexcept
+		{
+			std::uint16_t color0 = (std::uint16_t)(src[0] | (src[1] << 8));
+			std::uint16_t color1 = (std::uint16_t)(src[2] | (src[3] << 8));
+			std::uint32_t indices = src[4] | (src[5] << 8) | (src[6] << 16) | ((std::uint32_t)src[7] << 24);
+
+			const bool fourColor = forceFour || color0 > color1;
+
+			std::int32_t palette[4][3];
+			makeColorPalette(color0, color1, fourColor, palette);
+
+			for (std::uint32_t i = 0; i < 16; i++)
+			{
+				std::uint32_t index = (indices >> (i * 2)) & 3;
+
+				for (std::uint32_t c = 0; c < 3; c++)
+					texels[i][c] = (std::uint8_t)palette[index][c];
+
+				texels[i][3] = (!fourColor && index == 3 && punchThrough) ? 0 : 255;
+			}
+		}
+
+		void decodeAlphaBlock(const std::uint8_t* src, std::uint32_t channel, std::uint8_t texels[16][4]) noexcept
+		{
+			std::int32_t palette[8];
+			makeAlphaPalette(src[0], src[1], palette);
+
+			std::uint64_t indices = 0;
+			for (std::uint32_t i = 0; i < 6; i++)
+				indices |= (std::uint64_t)src[2 + i] << (i * 8);
+
+			for (std::uint32_t i = 0; i < 16; i++)
+				texels[i][channel] = (std::uint8_t)palette[(indices >> (i * 3)) & 7];
+		}
+
+		void decodeExplicitAlpha(const std::uint8_t* src, std::uint8_t texels[16][4]) noexcept
+		{
+			for (std::uint32_t i = 0; i < 16; i++)
+				texels[i][3] = (std::uint8_t)(((src[i >> 1] >> ((i & 1) * 4)) & 15) * 17);
+		}
+
+		// BC6H endpoint fields, endpoint * 3 + channel for the w, x, y and z endpoints, then the partition.
+		enum bc6_field_t : std::uint8_t
+		{
+			RW, GW, BW,
+			RX, GX, BX,
+			RY, GY, BY,
+			RZ, GZ, BZ,
+			PT,
+		};
+
+		// Bits first to last of a field in the order they are stored, last < first stores them reversed.
+		struct BC6Segment
+		{
+			std::uint8_t field;
+			std::uint8_t first;
+			std::uint8_t last;
+		};
+
+		struct BC6Mode
+		{
+			std::uint8_t value;
+			std::uint8_t modeBits;
+			std::uint8_t regions;
+			bool transformed;
+			std::uint8_t endpointBits;
+			std::uint8_t deltaBits[3];
+			const BC6Segment* segments;
+			std::uint32_t segmentCount;
+		};
+
+		const BC6Segment BC6Layout1[] =
+		{
+			{ GY, 4, 4 }, { BY, 4, 4 }, { BZ, 4, 4 }, { RW, 0, 9 }, { GW, 0, 9 }, { BW, 0, 9 }, { RX, 0, 4 }, { GZ, 4, 4 },
+			{ GY, 0, 3 }, { GX, 0, 4 }, { BZ, 0, 0 }, { GZ, 0, 3 }, { BX, 0, 4 }, { BZ, 1, 1 }, { BY, 0, 3 }, { RY, 0, 4 },
+			{ BZ, 2, 2 }, { RZ, 0, 4 }, { BZ, 3, 3 }, { PT, 0, 4 },
+		};
+
+		const BC6Segment BC6Layout2[] =
+		{
+			{ GY, 5, 5 }, { GZ, 4, 4 }, { GZ, 5, 5 }, { RW, 0, 6 }, { BZ, 0, 0 }, { BZ, 1, 1 }, { BY, 4, 4 }, { GW, 0, 6 },
+			{ BY, 5, 5 }, { BZ, 2, 2 }, { GY, 4, 4 }, { BW, 0, 6 }, { BZ, 3, 3 }, { BZ, 5, 5 }, { BZ, 4, 4 }, { RX, 0, 5 },
+			{ GY, 0, 3 }, { GX, 0, 5 }, { GZ, 0, 3 }, { BX, 0, 5 }, { BY, 0, 3 }, { RY, 0, 5 }, { RZ, 0, 5 }, { PT, 0, 4 },
+		};
+
+		const BC6Segment BC6Layout3[] =
+		{
+			{ RW, 0, 9 }, { GW, 0, 9 }, { BW, 0, 9 }, { RX, 0, 4 }, { RW, 10, 10 }, { GY, 0, 3 }, { GX, 0, 3 }, { GW, 10, 10 },
+			{ BZ, 0, 0 }, { GZ, 0, 3 }, { BX, 0, 3 }, { BW, 10, 10 }, { BZ, 1, 1 }, { BY, 0, 3 }, { RY, 0, 4 }, { BZ, 2, 2 },
+			{ RZ, 0, 4 }, { BZ, 3, 3 }, { PT, 0, 4 },
+		};
+
+		const BC6Segment BC6Layout4[] =
+		{
+			{ RW, 0, 9 }, { GW, 0, 9 }, { BW, 0, 9 }, { RX, 0, 3 }, { RW, 10, 10 }, { GZ, 4, 4 }, { GY, 0, 3 }, { GX, 0, 4 },
+			{ GW, 10, 10 }, { GZ, 0, 3 }, { BX, 0, 3 }, { BW, 10, 10 }, { BZ, 1, 1 }, { BY, 0, 3 }, { RY, 0, 3 }, { BZ, 0, 0 },
+			{ BZ, 2, 2 }, { RZ, 0, 3 }, { GY, 4, 4 }, { BZ, 3, 3 }, { PT, 0, 4 },
+		};
+
+		const BC6Segment BC6Layout5[] =
+		{
+			{ RW, 0, 9 }, { GW, 0, 9 }, { BW, 0, 9 }, { RX, 0, 3 }, { RW, 10, 10 }, { BY, 4, 4 }, { GY, 0, 3 }, { GX, 0, 3 },
+			{ GW, 10, 10 }, { BZ, 0, 0 }, { GZ, 0, 3 }, { BX, 0, 4 }, { BW, 10, 10 }, { BY, 0, 3 }, { RY, 0, 3 }, { BZ, 1, 1 },
+			{ BZ, 2, 2 }, { RZ, 0, 3 }, { BZ, 4, 4 }, { BZ, 3, 3 }, { PT, 0, 4 },
+		};
+
+		const BC6Segment BC6Layout6[] =
+		{
+			{ RW, 0, 8 }, { BY, 4, 4 }, { GW, 0, 8 }, { GY, 4, 4 }, { BW, 0, 8 }, { BZ, 4, 4 }, { RX, 0, 4 }, { GZ, 4, 4 },
+			{ GY, 0, 3 }, { GX, 0, 4 }, { BZ, 0, 0 }, { GZ, 0, 3 }, { BX, 0, 4 }, { BZ, 1, 1 }, { BY, 0, 3 }, { RY, 0, 4 },
+			{ BZ, 2, 2 }, { RZ, 0, 4 }, { BZ, 3, 3 }, { PT, 0, 4 },
+		};
+
+		const BC6Segment BC6Layout7[] =
+		{
+			{ RW, 0, 7 }, { GZ, 4, 4 }, { BY, 4, 4 }, { GW, 0, 7 }, { BZ, 2, 2 }, { GY, 4, 4 }, { BW, 0, 7 }, { BZ, 3, 3 },
+			{ BZ, 4, 4 }, { RX, 0, 5 }, { GY, 0, 3 }, { GX, 0, 4 }, { BZ, 0, 0 }, { GZ, 0, 3 }, { BX, 0, 4 }, { BZ, 1, 1 },
+			{ BY, 0, 3 }, { RY, 0, 5 }, { RZ, 0, 5 }, { PT, 0, 4 },
+		};
+
+		const BC6Segment BC6Layout8[] =
+		{
+			{ RW, 0, 7 }, { BZ, 0, 0 }, { BY, 4, 4 }, { GW, 0, 7 }, { GY, 5, 5 }, { GY, 4, 4 }, { BW, 0, 7 }, { GZ, 5, 5 },
+			{ BZ, 4, 4 }, { RX, 0, 4 }, { GZ, 4, 4 }, { GY, 0, 3 }, { GX, 0, 5 }, { GZ, 0, 3 }, { BX, 0, 4 }, { BZ, 1, 1 },
+			{ BY, 0, 3 }, { RY, 0, 4 }, { BZ, 2, 2 }, { RZ, 0, 4 }, { BZ, 3, 3 }, { PT, 0, 4 },
+		};
+
+		const BC6Segment BC6Layout9[] =
+		{
+			{ RW, 0, 7 }, { BZ, 1, 1 }, { BY, 4, 4 }, { GW, 0, 7 }, { BY, 5, 5 }, { GY, 4, 4 }, { BW, 0, 7 }, { BZ, 5, 5 },
+			{ BZ, 4, 4 }, { RX, 0, 4 }, { GZ, 4, 4 }, { GY, 0, 3 }, { GX, 0, 4 }, { BZ, 0, 0 }, { GZ, 0, 3 }, { BX, 0, 5 },
+			{ BY, 0, 3 }, { RY, 0, 4 }, { BZ, 2, 2 }, { RZ, 0, 4 }, { BZ, 3, 3 }, { PT, 0, 4 },
+		};
+
+		const BC6Segment BC6Layout10[] =
+		{
+			{ RW, 0, 5 }, { GZ, 4, 4 }, { BZ, 0, 0 }, { BZ, 1, 1 }, { BY, 4, 4 }, { GW, 0, 5 }, { GY, 5, 5 }, { BY, 5, 5 },
+			{ BZ, 2, 2 }, { GY, 4, 4 }, { BW, 0, 5 }, { GZ, 5, 5 }, { BZ, 3, 3 }, { BZ, 5, 5 }, { BZ, 4, 4 }, { RX, 0, 5 },
+			{ GY, 0, 3 }, { GX, 0, 5 }, { GZ, 0, 3 }, { BX, 0, 5 }, { BY, 0, 3 }, { RY, 0, 5 }, { RZ, 0, 5 }, { PT, 0, 4 },
+		};
+
+		const BC6Segment BC6Layout11[] =
+		{
+			{ RW, 0, 9 }, { GW, 0, 9 }, { BW, 0, 9 }, { RX, 0, 9 }, { GX, 0, 9 }, { BX, 0, 9 },
+		};
+
+		const BC6Segment BC6Layout12[] =
+		{
+			{ RW, 0, 9 }, { GW, 0, 9 }, { BW, 0, 9 }, { RX, 0, 8 }, { RW, 10, 10 }, { GX, 0, 8 }, { GW, 10, 10 }, { BX, 0, 8 },
+			{ BW, 10, 10 },
+		};
+
+		const BC6Segment BC6Layout13[] =
+		{
+			{ RW, 0, 9 }, { GW, 0, 9 }, { BW, 0, 9 }, { RX, 0, 7 }, { RW, 11, 10 }, { GX, 0, 7 }, { GW, 11, 10 }, { BX, 0, 7 },
+			{ BW, 11, 10 },
+		};
+
+		const BC6Segment BC6Layout14[] =
+		{
+			{ RW, 0, 9 }, { GW, 0, 9 }, { BW, 0, 9 }, { RX, 0, 3 }, { RW, 15, 10 }, { GX, 0, 3 }, { GW, 15, 10 }, { BX, 0, 3 },
+			{ BW, 15, 10 },
+		};
+
+		template<std::size_t N>
+		constexpr std::uint32_t countOf(const BC6Segment (&)[N]) noexcept
+		{
+			return N;
+		}
+
+		// Modes 1 to 14 of the format, the first ten split the block into two regions.
+		const BC6Mode BC6Modes[14] =
+		{
+			{ 0x00, 2, 2, true, 10, { 5, 5, 5 }, BC6Layout1, countOf(BC6Layout1) },
+			{ 0x01, 2, 2, true, 7, { 6, 6, 6 }, BC6Layout2, countOf(BC6Layout2) },
+			{ 0x02, 5, 2, true, 11, { 5, 4, 4 }, BC6Layout3, countOf(BC6Layout3) },
+			{ 0x06, 5, 2, true, 11, { 4, 5, 4 }, BC6Layout4, countOf(BC6Layout4) },
+			{ 0x0A, 5, 2, true, 11, { 4, 4, 5 }, BC6Layout5, countOf(BC6Layout5) },
+			{ 0x0E, 5, 2, true, 9, { 5, 5, 5 }, BC6Layout6, countOf(BC6Layout6) },
+			{ 0x12, 5, 2, true, 8, { 6, 5, 5 }, BC6Layout7, countOf(BC6Layout7) },
+			{ 0x16, 5, 2, true, 8, { 5, 6, 5 }, BC6Layout8, countOf(BC6Layout8) },
+			{ 0x1A, 5, 2, true, 8, { 5, 5, 6 }, BC6Layout9, countOf(BC6Layout9) },
+			{ 0x1E, 5, 2, false, 6, { 6, 6, 6 }, BC6Layout10, countOf(BC6Layout10) },
+			{ 0x03, 5, 1, false, 10, { 10, 10, 10 }, BC6Layout11, countOf(BC6Layout11) },
+			{ 0x07, 5, 1, true, 11, { 9, 9, 9 }, BC6Layout12, countOf(BC6Layout12) },
+			{ 0x0B, 5, 1, true, 12, { 8, 8, 8 }, BC6Layout13, countOf(BC6Layout13) },
+			{ 0x0F, 5, 1, true, 16, { 4, 4, 4 }, BC6Layout14, countOf(BC6Layout14) },
+		};
+
+		struct BC6Block
+		{
+			std::uint32_t mode;
+			std::uint32_t partition;
+			std::int32_t endpoints[4][3];
+			std::uint8_t indices[16];
+			float error;
+		};
+
+		inline std::int32_t signExtend(std::int32_t value, std::uint32_t bits) noexcept
+		{
+			std::int32_t sign = 1 << (bits - 1);
+			value &= (1 << bits) - 1;
+			return (value ^ sign) - sign;
+		}
+
+		std::int32_t bc6Unquantize(std::int32_t value, std::uint32_t bits, bool sign) noexcept
+		{
+			if (!sign)
+			{
+				if (bits >= 15 || value == 0)
+					return value;
+				if (value == (1 << bits) - 1)
+					return 0xFFFF;
+				return ((value << 16) + 0x8000) >> bits;
+			}
+
+			if (bits >= 16)
+				return value;
+
+			std::int32_t magnitude = std::abs(value);
+			std::int32_t result;
+
+			if (magnitude == 0)
+				result = 0;
+			else if (magnitude >= (1 << (bits - 1)) - 1)
+				result = 0x7FFF;
+			else
+				result = ((magnitude << 15) + 0x4000) >> (bits - 1);
+
+			return value < 0 ? -result : result;
+		}
+
+		// Inverse of bc6Unquantize, the neighbours are tried because the reconstruction is not linear at the ends.
+		std::int32_t bc6Quantize(float value, std::uint32_t bits, bool sign) noexcept
+		{
+			const std::int32_t maxValue = sign ? (1 << (bits - 1)) - 1 : (1 << bits) - 1;
+			const std::int32_t minValue = sign ? -maxValue : 0;
+			const float scale = sign ? (float)(1 << (bits - 1)) / 32768.0f : (float)(1 << bits) / 65536.0f;
+
+			std::int32_t center = clampInt((std::int32_t)(value * scale), minValue, maxValue);
+			std::int32_t best = center;
+			float bestError = MaxError;
+
+			for (std::int32_t q = std::max(center - 1, minValue); q <= std::min(center + 1, maxValue); q++)
+			{
+				float error = std::abs(bc6Unquantize(q, bits, sign) - value);
+				if (error < bestError)
+				{
+					best = q;
+					bestError = error;
+				}
+			}
+
+			return best;
+		}
+
+		inline std::uint16_t bc6Finish(std::int32_t value, bool sign) noexcept
+		{
+			if (!sign)
+				return (std::uint16_t)((value * 31) >> 6);
+			if (value < 0)
+				return (std::uint16_t)(0x8000 | ((-value * 31) >> 5));
+			return (std::uint16_t)((value * 31) >> 5);
+		}
+
+		// BC6H interpolates in a scaled half float space, this maps a half into it so that bc6Finish returns it.
+		inline float bc6Target(std::uint16_t half, bool sign) noexcept
+		{
+			std::int32_t magnitude = std::min(half & 0x7FFF, 0x7BFF);
+
+			if (!sign)
+				return (half & 0x8000) ? 0.0f : magnitude * (64.0f / 31.0f);
+
+			return (half & 0x8000 ? -magnitude : magnitude) * (32.0f / 31.0f);
+		}
+
+		float encodeBC6Mode(const float texels[16][4], bool sign, std::uint32_t modeIndex, std::uint32_t partition, const float fit[2][2][4], std::uint32_t iterations, BC6Block& block) noexcept
+		{
+			const BC6Mode& mode = BC6Modes[modeIndex];
+			const std::uint32_t regions = mode.regions;
+			const std::uint32_t indexBits = regions == 1 ? 4 : 3;
+			const std::uint8_t* weights = getWeights(indexBits);
+			const float lo = sign ? -0x7BFF * (32.0f / 31.0f) : 0.0f;
+			const float hi = sign ? 0x7BFF * (32.0f / 31.0f) : 0x7BFF * (64.0f / 31.0f);
+
+			Subsets subsets;
+			makeSubsets(subsets, regions, partition);
+
+			float endpoints[2][2][4];
+			std::memcpy(endpoints, fit, sizeof(endpoints));
+
+			// Orient every region so that its anchor texel sits on the low half of the indices.
+			for (std::uint32_t r = 0; r < regions; r++)
+			{
+				const float* texel = texels[getAnchor(regions, partition, r)];
+
+				float dot = 0.0f;
+				float length = 0.0f;
+
+				for (std::uint32_t c = 0; c < 3; c++)
+				{
+					float d = endpoints[r][1][c] - endpoints[r][0][c];
+					dot += (texel[c] - endpoints[r][0][c]) * d;
+					length += d * d;
+				}
+
+				if (dot > length * 0.5f)
+					std::swap(endpoints[r][0], endpoints[r][1]);
+			}
+
+			block.mode = modeIndex;
+			block.partition = partition;
+			block.error = MaxError;
+
+			for (std::uint32_t it = 0; it <= iterations; it++)
+			{
+				std::int32_t q[4][3];
+
+				for (std::uint32_t k = 0; k < regions * 2; k++)
+				{
+					for (std::uint32_t c = 0; c < 3; c++)
+						q[k][c] = bc6Quantize(endpoints[k >> 1][k & 1][c], mode.endpointBits, sign);
+				}
+
+				// Transformed modes store the other endpoints as deltas from the first, clamped to what fits.
+				if (mode.transformed)
+				{
+					for (std::uint32_t k = 1; k < regions * 2; k++)
+					{
+						for (std::uint32_t c = 0; c < 3; c++)
+						{
+							std::int32_t limit = 1 << (mode.deltaBits[c] - 1);
+							q[k][c] = q[0][c] + clampInt(q[k][c] - q[0][c], -limit, limit - 1);
+						}
+					}
+				}
+
+				std::int32_t palette[2][16][3];
+
+				for (std::uint32_t r = 0; r < regions; r++)
+				{
+					for (std::uint32_t c = 0; c < 3; c++)
+					{
+						std::int32_t u0 = bc6Unquantize(q[r * 2][c], mode.endpointBits, sign);
+						std::int32_t u1 = bc6Unquantize(q[r * 2 + 1][c], mode.endpointBits, sign);
+
+						for (std::uint32_t j = 0; j < (1u << indexBits); j++)
+							palette[r][j][c] = (u0 * (64 - weights[j]) + u1 * weights[j] + 32) >> 6;
+					}
+				}
+
+				std::uint8_t indices[16];
+				float error = 0.0f;
+
+				for (std::uint32_t i = 0; i < 16; i++)
+				{
+					std::uint32_t r = getSubset(regions, partition, i);
+					std::uint32_t levels = isAnchor(regions, partition, i) ? 1 << (indexBits - 1) : 1 << indexBits;
+
+					float bestError = MaxError;
+
+					for (std::uint32_t j = 0; j < levels; j++)
+					{
+						float dr = texels[i][0] - palette[r][j][0];
+						float dg = texels[i][1] - palette[r][j][1];
+						float db = texels[i][2] - palette[r][j][2];
+						float e = dr * dr + dg * dg + db * db;
+
+						if (e < bestError)
+						{
+							indices[i] = (std::uint8_t)j;
+							bestError = e;
+						}
+					}
+
+					error += bestError;
+				}
+
+				if (error < block.error)
+				{
+					std::memcpy(block.endpoints, q, sizeof(q));
+					std::memcpy(block.indices, indices, sizeof(indices));
+					block.error = error;
+				}
+
+				if (it == iterations || error == 0.0f)
+					break;
+
+				for (std::uint32_t r = 0; r < regions; r++)
+				{
+					float w[16];
+					for (std::uint32_t k = 0; k < subsets.count[r]; k++)
+						w[k] = weights[indices[subsets.texels[r][k]]] / 64.0f;
+
+					if (solveEndpoints(texels, subsets.texels[r], subsets.count[r], 0, 3, w, endpoints[r][0], endpoints[r][1]))
+						clampEndpoints(endpoints[r][0], endpoints[r][1], 0, 3, lo, hi);
+				}
+			}
+
+			return block.error;
+		}
+
+		void writeBC6(const BC6Block& block, std::uint8_t* dst) noexcept
+		{
+			const BC6Mode& mode = BC6Modes[block.mode];
+			const std::uint32_t indexBits = mode.regions == 1 ? 4 : 3;
+
+			BlockWriter writer;
+			writer.write(mode.value, mode.modeBits);
+
+			for (std::uint32_t i = 0; i < mode.segmentCount; i++)
+			{
+				const BC6Segment& segment = mode.segments[i];
+
+				std::int32_t value;
+
+				if (segment.field == PT)
+					value = block.partition;
+				else
+				{
+					std::uint32_t k = segment.field / 3;
+					std::uint32_t c = segment.field % 3;
+
+					if (k > 0 && mode.transformed)
+						value = block.endpoints[k][c] - block.endpoints[0][c];
+					else
+						value = block.endpoints[k][c];
+				}
+
+				if (segment.first <= segment.last)
+				{
+					for (std::uint32_t b = segment.first; b <= segment.last; b++)
+						writer.write((value >> b) & 1, 1);
+				}
+				else
+				{
+					for (std::int32_t b = segment.first; b >= segment.last; b--)
+						writer.write((value >> b) & 1, 1);
+				}
+			}
+
+			for (std::uint32_t i = 0; i < 16; i++)
+				writer.write(block.indices[i], isAnchor(mode.regions, block.partition, i) ? indexBits - 1 : indexBits);
+
+			writer.store(dst);
+		}
+
+		void encodeBC6Block(const float texels[16][4], bool sign, compress_quality_t quality, std::uint8_t* dst) noexcept
+		{
+			static const std::uint8_t all[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+			const std::uint32_t iterations = quality == compress_quality_t::Fast ? 0 : (quality == compress_quality_t::Normal ? 1 : 2);
+
+			float fit[2][2][4];
+			fitSubset(texels, all, 16, 0, 3, fit[0][0], fit[0][1]);
+
+			BC6Block best;
+			BC6Block block;
+
+			// Mode 11 keeps 10 bit endpoints without deltas, modes 12 to 14 trade delta range for precision.
+			encodeBC6Mode(texels, sign, 10, 0, fit, iterations, best);
+
+			if (quality != compress_quality_t::Fast)
+			{
+				for (std::uint32_t mode = 11; mode < 14 && best.error > 0.0f; mode++)
+				{
+					if (encodeBC6Mode(texels, sign, mode, 0, fit, iterations, block) < best.error)
+						best = block;
+				}
+			}
+
+			if (quality == compress_quality_t::High && best.error > 0.0f)
+			{
+				std::uint32_t partitions[4];
+				std::uint32_t count = selectPartitions(texels, 2, 32, 3, 4, partitions);
+
+				for (std::uint32_t i = 0; i < count; i++)
+				{
+					Subsets subsets;
+					makeSubsets(subsets, 2, partitions[i]);
+
+					for (std::uint32_t r = 0; r < 2; r++)
+						fitSubset(texels, subsets.texels[r], subsets.count[r], 0, 3, fit[r][0], fit[r][1]);
+
+					for (std::uint32_t mode = 0; mode < 10; mode++)
+					{
+						if (encodeBC6Mode(texels, sign, mode, partitions[i], fit, iterations, block) < best.error)
+							best = block;
+					}
+				}
+			}
+
+			writeBC6(best, dst);
+		}
+
+		void decodeBC6(const std::uint8_t* src, bool sign, std::uint16_t texels[16][3]) noexcept
+		{
+			BlockReader reader(src);
+
+			std::uint32_t value = reader.read(2);
+			if (value > 1)
+				value |= reader.read(3) << 2;
+
+			const BC6Mode* mode = nullptr;
+			for (auto& it : BC6Modes)
+			{
+				if (it.value == value)
+				{
+					mode = &it;
+					break;
+				}
+			}
+
+			if (!mode)
+			{
+				std::memset(texels, 0, sizeof(std::uint16_t) * 16 * 3);
+				return;
+			}
+
+			std::int32_t endpoints[4][3] = {};
+			std::uint32_t partition = 0;
+
+			for (std::uint32_t i = 0; i < mode->segmentCount; i++)
+			{
+				const BC6Segment& segment = mode->segments[i];
+				const std::int32_t step = segment.first <= segment.last ? 1 : -1;
+
+				for (std::int32_t b = segment.first; ; b += step)
+				{
+					std::uint32_t bit = reader.read(1);
+
+					if (segment.field == PT)
+						partition |= bit << b;
+					else
+						endpoints[segment.field / 3][segment.field % 3] |= bit << b;
+
+					if (b == segment.last)
+						break;
+				}
+			}
+
+			const std::uint32_t regions = mode->regions;
+			const std::uint32_t bits = mode->endpointBits;
+
+			for (std::uint32_t k = 0; k < regions * 2; k++)
+			{
+				for (std::uint32_t c = 0; c < 3; c++)
+				{
+					if (k > 0 && mode->transformed)
+						endpoints[k][c] = (endpoints[0][c] + signExtend(endpoints[k][c], mode->deltaBits[c])) & ((1 << bits) - 1);
+				}
+			}
+
+			if (sign)
+			{
+				for (std::uint32_t k = 0; k < regions * 2; k++)
+				{
+					for (std::uint32_t c = 0; c < 3; c++)
+						endpoints[k][c] = signExtend(endpoints[k][c], bits);
+				}
+			}
+
+			const std::uint32_t indexBits = regions == 1 ? 4 : 3;
+			const std::uint8_t* weights = getWeights(indexBits);
+
+			for (std::uint32_t i = 0; i < 16; i++)
+			{
+				std::uint32_t r = getSubset(regions, partition, i);
+				std::uint32_t index = reader.read(isAnchor(regions, partition, i) ? indexBits - 1 : indexBits);
+
+				for (std::uint32_t c = 0; c < 3; c++)
+				{
+					std::int32_t u0 = bc6Unquantize(endpoints[r * 2][c], bits, sign);
+					std::int32_t u1 = bc6Unquantize(endpoints[r * 2 + 1][c], bits, sign);
+
+					texels[i][c] = bc6Finish((u0 * (64 - weights[index]) + u1 * weights[index] + 32) >> 6, sign);
+				}
+			}
+		}
+
+		struct BC7Mode
+		{
+			std::uint8_t subsets;
+			std::uint8_t partitionBits;
+			std::uint8_t rotationBits;
+			std::uint8_t selectionBits;
+			std::uint8_t colorBits;
+			std::uint8_t alphaBits;
+			std::uint8_t endpointPBits;
+			std::uint8_t sharedPBits;
+			std::uint8_t indexBits;
+			std::uint8_t secondaryBits;
+		};
+
+		const BC7Mode BC7Modes[8] =
+		{
+			{ 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+			{ 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+			{ 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+			{ 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+			{ 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+			{ 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+			{ 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+			{ 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+		};
+
+		struct BC7Block
+		{
+			std::uint32_t mode;
+			std::uint32_t partition;
+			std::uint32_t rotation;
+			std::uint32_t selection;
+			std::int32_t endpoints[3][2][4];
+			std::int32_t pbits[3][2];
+			std::uint8_t indices[16];
+			std::uint8_t secondary[16];
+			float error;
+		};
+
+		inline std::int32_t bc7Expand(std::int32_t value, std::uint32_t bits) noexcept
+		{
+			value <<= 8 - bits;
+			return value | (value >> bits);
+		}
+
+		inline std::int32_t bc7Unquantize(std::int32_t value, std::uint32_t bits, std::int32_t pbit) noexcept
+		{
+			return pbit < 0 ? bc7Expand(value, bits) : bc7Expand((value << 1) | pbit, bits + 1);
+		}
+
+		inline std::int32_t bc7Quantize(float value, std::uint32_t bits, std::int32_t pbit) noexcept
+		{
+			if (pbit < 0)
+				return clampInt(roundInt(value * ((1 << bits) - 1) / 255.0f), 0, (1 << bits) - 1);
+
+			float scaled = value * ((1 << (bits + 1)) - 1) / 255.0f;
+			return clampInt(roundInt((scaled - pbit) * 0.5f), 0, (1 << bits) - 1);
+		}
+
+		// Quantizes the endpoints of one subset with every p-bit choice the mode has and keeps the best indices.
+		float quantizeBC7Subset(const BC7Mode& mode, const float texels[16][4], const std::uint8_t* list, std::uint32_t count, std::uint32_t first, std::uint32_t channel, std::uint32_t bits, const float e0[4], const float e1[4], std::uint32_t indexBits, std::int32_t endpoints[2][4], std::int32_t pbits[2], std::uint8_t* indices) noexcept
+		{
+			const std::uint8_t* weights = getWeights(indexBits);
+			const std::uint32_t levels = 1 << indexBits;
+			const std::uint32_t combinations = mode.endpointPBits ? 4 : (mode.sharedPBits ? 2 : 1);
+
+			float bestError = MaxError;
+
+			for (std::uint32_t combination = 0; combination < combinations; combination++)
+			{
+				std::int32_t p0 = -1;
+				std::int32_t p1 = -1;
+
+				if (mode.endpointPBits)
+				{
+					p0 = combination & 1;
+					p1 = combination >> 1;
+				}
+				else if (mode.sharedPBits)
+				{
+					p0 = p1 = combination;
+				}
+
+				std::int32_t q[2][4] = {};
+				std::int32_t palette[16][4];
+
+				for (std::uint32_t c = first; c < first + channel; c++)
+				{
+					q[0][c] = bc7Quantize(e0[c], bits, p0);
+					q[1][c] = bc7Quantize(e1[c], bits, p1);
+
+					std::int32_t c0 = bc7Unquantize(q[0][c], bits, p0);
+					std::int32_t c1 = bc7Unquantize(q[1][c], bits, p1);
+
+					for (std::uint32_t j = 0; j < levels; j++)
+						palette[j][c] = (c0 * (64 - weights[j]) + c1 * weights[j] + 32) >> 6;
+				}
+
+				std::uint8_t trial[16];
+				float error = 0.0f;
+
+				for (std::uint32_t k = 0; k < count && error < bestError; k++)
+				{
+					const float* texel = texels[list[k]];
+					float texelError = MaxError;
+
+					for (std::uint32_t j = 0; j < levels; j++)
+					{
+						float e = 0.0f;
+						for (std::uint32_t c = first; c < first + channel; c++)
+						{
+							float d = texel[c] - palette[j][c];
+							e += d * d;
+						}
+
+						if (e < texelError)
+						{
+							trial[k] = (std::uint8_t)j;
+							texelError = e;
+						}
+					}
+
+					error += texelError;
+				}
+
+				if (error < bestError)
+				{
+					bestError = error;
+
+					for (std::uint32_t c = first; c < first + channel; c++)
+					{
+						endpoints[0][c] = q[0][c];
+						endpoints[1][c] = q[1][c];
+					}
+
+					pbits[0] = std::max(p0, 0);
+					pbits[1] = std::max(p1, 0);
+
+					for (std::uint32_t k = 0; k < count; k++)
+						indices[list[k]] = trial[k];
+				}
+			}
+
+			return bestError;
+		}
+
+		// Mirrors the indices of a subset whose anchor texel has the high index bit set, which BC7 cannot store.
+		void orientBC7Subset(std::int32_t endpoints[2][4], std::int32_t pbits[2], bool swapPBits, std::uint32_t first, std::uint32_t channel, const std::uint8_t* list, std::uint32_t count, std::uint32_t anchor, std::uint32_t indexBits, std::uint8_t* indices) noexcept
+		{
+			const std::uint32_t levels = 1 << indexBits;
+
+			if (indices[anchor] < levels / 2)
+				return;
+
+			for (std::uint32_t c = first; c < first + channel; c++)
+				std::swap(endpoints[0][c], endpoints[1][c]);
+
+			if (swapPBits)
+				std::swap(pbits[0], pbits[1]);
+
+			for (std::uint32_t k = 0; k < count; k++)
+				indices[list[k]] = (std::uint8_t)(levels - 1 - indices[list[k]]);
+		}
+
+		void refineBC7Subset(const float texels[16][4], const std::uint8_t* list, std::uint32_t count, std::uint32_t first, std::uint32_t channel, std::uint32_t indexBits, const std::uint8_t* indices, float e0[4], float e1[4]) noexcept
+		{
+			const std::uint8_t* weights = getWeights(indexBits);
+
+			float w[16];
+			for (std::uint32_t k = 0; k < count; k++)
+				w[k] = weights[indices[list[k]]] / 64.0f;
+
+			if (solveEndpoints(texels, list, count, first, channel, w, e0, e1))
+				clampEndpoints(e0, e1, first, channel, 0.0f, 255.0f);
+		}
+
+		// Modes whose endpoints carry every channel, 0 to 3 decode alpha as opaque.
+		float encodeBC7Mode(const float texels[16][4], std::uint32_t modeIndex, std::uint32_t partition, std::uint32_t iterations, BC7Block& block) noexcept
+		{
+			const BC7Mode& mode = BC7Modes[modeIndex];
+			const std::uint32_t channel = mode.alphaBits ? 4 : 3;
+
+			Subsets subsets;
+			makeSubsets(subsets, mode.subsets, partition);
+
+			float endpoints[3][2][4];
+			for (std::uint32_t s = 0; s < mode.subsets; s++)
+				fitSubset(texels, subsets.texels[s], subsets.count[s], 0, channel, endpoints[s][0], endpoints[s][1]);
+
+			float alphaError = 0.0f;
+			if (channel == 3)
+			{
+				for (std::uint32_t i = 0; i < 16; i++)
+					alphaError += (texels[i][3] - 255.0f) * (texels[i][3] - 255.0f);
+			}
+
+			BC7Block trial = {};
+			trial.mode = modeIndex;
+			trial.partition = partition;
+
+			block.error = MaxError;
+
+			for (std::uint32_t it = 0; it <= iterations; it++)
+			{
+				float error = alphaError;
+
+				for (std::uint32_t s = 0; s < mode.subsets; s++)
+					error += quantizeBC7Subset(mode, texels, subsets.texels[s], subsets.count[s], 0, channel, mode.colorBits, endpoints[s][0], endpoints[s][1], mode.indexBits, trial.endpoints[s], trial.pbits[s], trial.indices);
+
+				if (error < block.error)
+				{
+					block = trial;
+					block.error = error;
+				}
+
+				if (it == iterations || error == 0.0f)
+					break;
+
+				for (std::uint32_t s = 0; s < mode.subsets; s++)
+					refineBC7Subset(texels, subsets.texels[s], subsets.count[s], 0, channel, mode.indexBits, trial.indices, endpoints[s][0], endpoints[s][1]);
+			}
+
+			for (std::uint32_t s = 0; s < mode.subsets; s++)
+				orientBC7Subset(block.endpoints[s], block.pbits[s], mode.endpointPBits != 0, 0, channel, subsets.texels[s], subsets.count[s], getAnchor(mode.subsets, partition, s), mode.indexBits, block.indices);
+
+			return block.error;
+		}
+
+		// Modes 4 and 5 index colour and alpha separately, the rotation swaps alpha with one colour channel first.
+		float encodeBC7Separate(const float texels[16][4], std::uint32_t modeIndex, std::uint32_t rotation, std::uint32_t selection, std::uint32_t iterations, BC7Block& block) noexcept
+		{
+			static const std::uint8_t all[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+			const BC7Mode& mode = BC7Modes[modeIndex];
+			const std::uint32_t colorIndexBits = selection ? mode.secondaryBits : mode.indexBits;
+			const std::uint32_t alphaIndexBits = selection ? mode.indexBits : mode.secondaryBits;
+
+			float rotated[16][4];
+			std::memcpy(rotated, texels, sizeof(rotated));
+
+			if (rotation > 0)
+			{
+				for (std::uint32_t i = 0; i < 16; i++)
+					std::swap(rotated[i][rotation - 1], rotated[i][3]);
+			}
+
+			float endpoints[2][4];
+			fitSubset(rotated, all, 16, 0, 3, endpoints[0], endpoints[1]);
+			fitSubset(rotated, all, 16, 3, 1, endpoints[0], endpoints[1]);
+
+			BC7Block trial = {};
+			trial.mode = modeIndex;
+			trial.rotation = rotation;
+			trial.selection = selection;
+
+			std::uint8_t colorIndices[16];
+			std::uint8_t alphaIndices[16];
+			std::uint8_t bestColor[16];
+			std::uint8_t bestAlpha[16];
+
+			block.error = MaxError;
+
+			for (std::uint32_t it = 0; it <= iterations; it++)
+			{
+				float error = quantizeBC7Subset(mode, rotated, all, 16, 0, 3, mode.colorBits, endpoints[0], endpoints[1], colorIndexBits, trial.endpoints[0], trial.pbits[0], colorIndices);
+				error += quantizeBC7Subset(mode, rotated, all, 16, 3, 1, mode.alphaBits, endpoints[0], endpoints[1], alphaIndexBits, trial.endpoints[0], trial.pbits[0], alphaIndices);
+
+				if (error < block.error)
+				{
+					block = trial;
+					block.error = error;
+					std::memcpy(bestColor, colorIndices, sizeof(bestColor));
+					std::memcpy(bestAlpha, alphaIndices, sizeof(bestAlpha));
+				}
+
+				if (it == iterations || error == 0.0f)
+					break;
+
+				refineBC7Subset(rotated, all, 16, 0, 3, colorIndexBits, colorIndices, endpoints[0], endpoints[1]);
+				refineBC7Subset(rotated, all, 16, 3, 1, alphaIndexBits, alphaIndices, endpoints[0], endpoints[1]);
+			}
+
+			orientBC7Subset(block.endpoints[0], block.pbits[0], false, 0, 3, all, 16, 0, colorIndexBits, bestColor);
+			orientBC7Subset(block.endpoints[0], block.pbits[0], false, 3, 1, all, 16, 0, alphaIndexBits, bestAlpha);
+
+			std::memcpy(block.indices, selection ? bestAlpha : bestColor, sizeof(block.indices));
+			std::memcpy(block.secondary, selection ? bestColor : bestAlpha, sizeof(block.secondary));
+
+			return block.error;
+		}
+
+		void writeBC7(const BC7Block& block, std::uint8_t* dst) noexcept
+		{
+			const BC7Mode& mode = BC7Modes[block.mode];
+
+			BlockWriter writer;
+			writer.write(1 << block.mode, block.mode + 1);
+			writer.write(block.partition, mode.partitionBits);
+			writer.write(block.rotation, mode.rotationBits);
+			writer.write(block.selection, mode.selectionBits);
+
+			for (std::uint32_t c = 0; c < 3; c++)
+			{
+				for (std::uint32_t s = 0; s < mode.subsets; s++)
+				{
+					writer.write(block.endpoints[s][0][c], mode.colorBits);
+					writer.write(block.endpoints[s][1][c], mode.colorBits);
+				}
+			}
+
+			for (std::uint32_t s = 0; s < mode.subsets && mode.alphaBits; s++)
+			{
+				writer.write(block.endpoints[s][0][3], mode.alphaBits);
+				writer.write(block.endpoints[s][1][3], mode.alphaBits);
+			}
+
+			for (std::uint32_t s = 0; s < mode.subsets; s++)
+			{
+				if (mode.endpointPBits)
+				{
+					writer.write(block.pbits[s][0], 1);
+					writer.write(block.pbits[s][1], 1);
+				}
+				else if (mode.sharedPBits)
+				{
+					writer.write(block.pbits[s][0], 1);
+				}
+			}
+
+			for (std::uint32_t i = 0; i < 16; i++)
+				writer.write(block.indices[i], isAnchor(mode.subsets, block.partition, i) ? mode.indexBits - 1 : mode.indexBits);
+
+			for (std::uint32_t i = 0; i < 16 && mode.secondaryBits; i++)
+				writer.write(block.secondary[i], i == 0 ? mode.secondaryBits - 1 : mode.secondaryBits);
+
+			writer.store(dst);
+		}
+
+		void encodeBC7Block(const float texels[16][4], compress_quality_t quality, std::uint8_t* dst) noexcept
+		{
+			bool opaque = true;
+			for (std::uint32_t i = 0; i < 16; i++)
+				opaque &= texels[i][3] >= 254.5f;
+
+			const std::uint32_t iterations = quality == compress_quality_t::High ? 2 : 1;
+
+			BC7Block best;
+			BC7Block block;
+
+			encodeBC7Mode(texels, 6, 0, iterations, best);
+
+			if (quality == compress_quality_t::Fast || best.error == 0.0f)
+			{
+				writeBC7(best, dst);
+				return;
+			}
+
+			const bool high = quality == compress_quality_t::High;
+			const std::uint32_t rotations = high ? 4 : 1;
+
+			for (std::uint32_t rotation = 0; rotation < rotations; rotation++)
+			{
+				if (encodeBC7Separate(texels, 5, rotation, 0, iterations, block) < best.error)
+					best = block;
+
+				for (std::uint32_t selection = 0; selection < 2 && (high || !opaque); selection++)
+				{
+					if (encodeBC7Separate(texels, 4, rotation, selection, iterations, block) < best.error)
+						best = block;
+				}
+			}
+
+			std::uint32_t partitions[8];
+			std::uint32_t count = selectPartitions(texels, 2, 64, opaque ? 3 : 4, high ? 8 : 2, partitions);
+
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				if (opaque)
+				{
+					if (encodeBC7Mode(texels, 1, partitions[i], iterations, block) < best.error)
+						best = block;
+					if (encodeBC7Mode(texels, 3, partitions[i], iterations, block) < best.error)
+						best = block;
+				}
+				else
+				{
+					if (encodeBC7Mode(texels, 7, partitions[i], iterations, block) < best.error)
+						best = block;
+				}
+			}
+
+			if (high && opaque)
+			{
+				count = selectPartitions(texels, 3, 64, 3, 4, partitions);
+
+				for (std::uint32_t i = 0; i < count; i++)
+				{
+					if (encodeBC7Mode(texels, 2, partitions[i], iterations, block) < best.error)
+						best = block;
+				}
+
+				count = selectPartitions(texels, 3, 16, 3, 4, partitions);
+
+				for (std::uint32_t i = 0; i < count; i++)
+				{
+					if (encodeBC7Mode(texels, 0, partitions[i], iterations, block) < best.error)
+						best = block;
+				}
+			}
+
+			writeBC7(best, dst);
+		}
+
+		void decodeBC7(const std::uint8_t* src, std::uint8_t texels[16][4]) noexcept
+		{
+			BlockReader reader(src);
+
+			std::uint32_t modeIndex = 0;
+			while (modeIndex < 8 && reader.read(1) == 0)
+				modeIndex++;
+
+			if (modeIndex == 8)
+			{
+				std::memset(texels, 0, 16 * 4);
+				return;
+			}
+
+			const BC7Mode& mode = BC7Modes[modeIndex];
+
+			std::uint32_t partition = reader.read(mode.partitionBits);
+			std::uint32_t rotation = reader.read(mode.rotationBits);
+			std::uint32_t selection = reader.read(mode.selectionBits);
+
+			std::int32_t endpoints[3][2][4] = {};
+
+			for (std::uint32_t c = 0; c < 3; c++)
+			{
+				for (std::uint32_t s = 0; s < mode.subsets; s++)
+				{
+					endpoints[s][0][c] = reader.read(mode.colorBits);
+					endpoints[s][1][c] = reader.read(mode.colorBits);
+				}
+			}
+
+			for (std::uint32_t s = 0; s < mode.subsets && mode.alphaBits; s++)
+			{
+				endpoints[s][0][3] = reader.read(mode.alphaBits);
+				endpoints[s][1][3] = reader.read(mode.alphaBits);
+			}
+
+			std::int32_t pbits[3][2] = { { -1, -1 }, { -1, -1 }, { -1, -1 } };
+
+			for (std::uint32_t s = 0; s < mode.subsets; s++)
+			{
+				if (mode.endpointPBits)
+				{
+					pbits[s][0] = reader.read(1);
+					pbits[s][1] = reader.read(1);
+				}
+				else if (mode.sharedPBits)
+				{
+					pbits[s][0] = pbits[s][1] = reader.read(1);
+				}
+			}
+
+			for (std::uint32_t s = 0; s < mode.subsets; s++)
+			{
+				for (std::uint32_t e = 0; e < 2; e++)
+				{
+					for (std::uint32_t c = 0; c < 3; c++)
+						endpoints[s][e][c] = bc7Unquantize(endpoints[s][e][c], mode.colorBits, pbits[s][e]);
+
+					endpoints[s][e][3] = mode.alphaBits ? bc7Unquantize(endpoints[s][e][3], mode.alphaBits, pbits[s][e]) : 255;
+				}
+			}
+
+			std::uint8_t indices[16];
+			std::uint8_t secondary[16];
+
+			for (std::uint32_t i = 0; i < 16; i++)
+				indices[i] = (std::uint8_t)reader.read(isAnchor(mode.subsets, partition, i) ? mode.indexBits - 1 : mode.indexBits);
+
+			for (std::uint32_t i = 0; i < 16 && mode.secondaryBits; i++)
+				secondary[i] = (std::uint8_t)reader.read(i == 0 ? mode.secondaryBits - 1 : mode.secondaryBits);
+
+			for (std::uint32_t i = 0; i < 16; i++)
+			{
+				const std::int32_t (*e)[4] = endpoints[getSubset(mode.subsets, partition, i)];
+
+				std::uint32_t colorWeight;
+				std::uint32_t alphaWeight;
+
+				if (!mode.secondaryBits)
+					colorWeight = alphaWeight = getWeights(mode.indexBits)[indices[i]];
+				else if (selection)
+				{
+					colorWeight = getWeights(mode.secondaryBits)[secondary[i]];
+					alphaWeight = getWeights(mode.indexBits)[indices[i]];
+				}
+				else
+				{
+					colorWeight = getWeights(mode.indexBits)[indices[i]];
+					alphaWeight = getWeights(mode.secondaryBits)[secondary[i]];
+				}
+
+				for (std::uint32_t c = 0; c < 4; c++)
+				{
+					std::uint32_t w = c < 3 ? colorWeight : alphaWeight;
+					texels[i][c] = (std::uint8_t)((e[0][c] * (64 - w) + e[1][c] * w + 32) >> 6);
+				}
+
+				if (rotation > 0)
+					std::swap(texels[i][rotation - 1], texels[i][3]);
+			}
+		}
+
+		bool getBlockType(format_t format, block_t& type) noexcept
+		{
+			switch (format)
+			{
+			case format_t::BC1RGBUNormBlock:
+			case format_t::BC1RGBSRGBBlock:
+				type = block_t::BC1;
+				return true;
+			case format_t::BC1RGBAUNormBlock:
+			case format_t::BC1RGBASRGBBlock:
+				type = block_t::BC1A;
+				return true;
+			case format_t::BC2UNormBlock:
+			case format_t::BC2SRGBBlock:
+				type = block_t::BC2;
+				return true;
+			case format_t::BC3UNormBlock:
+			case format_t::BC3SRGBBlock:
+				type = block_t::BC3;
+				return true;
+			case format_t::BC4UNormBlock:
+				type = block_t::BC4;
+				return true;
+			case format_t::BC5UNormBlock:
+				type = block_t::BC5;
+				return true;
+			case format_t::BC6HUFloatBlock:
+				type = block_t::BC6H;
+				return true;
+			case format_t::BC6HSFloatBlock:
+				type = block_t::BC6HS;
+				return true;
+			case format_t::BC7UNormBlock:
+			case format_t::BC7SRGBBlock:
+				type = block_t::BC7;
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		inline std::uint32_t getBlockSize(block_t type) noexcept
+		{
+			return (type == block_t::BC1 || type == block_t::BC1A || type == block_t::BC4) ? 8 : 16;
+		}
+
+		bool makeSourceLayout(SourceLayout& layout, const Image& image, bool hdr, bool sign) noexcept
+		{
+			auto value = image.value_type();
+			auto size = image.type_size();
+
+			if (hdr)
+			{
+				if (value != value_t::Float || (size != 2 && size != 4))
+					return false;
+
+				layout.value = size == 2 ? source_t::Float16 : source_t::Float32;
+			}
+			else
+			{
+				if ((value != value_t::UNorm && value != value_t::SRGB) || size != 1)
+					return false;
+
+				layout.value = source_t::UNorm8;
+			}
+
+			layout.sign = sign;
+			layout.pixelSize = image.channel() * size;
+
+			static const std::int32_t luminance[4] = { 0, 0, 0, -1 };
+			static const std::int32_t alpha[4] = { -1, -1, -1, 0 };
+			static const std::int32_t luminanceAlpha[4] = { 0, 0, 0, 1 };
+			static const std::int32_t r[4] = { 0, -1, -1, -1 };
+			static const std::int32_t rg[4] = { 0, 1, -1, -1 };
+			static const std::int32_t rgb[4] = { 0, 1, 2, -1 };
+			static const std::int32_t bgr[4] = { 2, 1, 0, -1 };
+			static const std::int32_t rgba[4] = { 0, 1, 2, 3 };
+			static const std::int32_t bgra[4] = { 2, 1, 0, 3 };
+
+			const std::int32_t* offset;
+
+			switch (image.format())
+			{
+			case format_t::L8UNorm:
+			case format_t::L8SRGB:
+				offset = luminance;
+				break;
+			case format_t::A8UNorm:
+			case format_t::A8SRGB:
+				offset = alpha;
+				break;
+			case format_t::L8A8UNorm:
+			case format_t::L8A8SRGB:
+				offset = luminanceAlpha;
+				break;
+			default:
+				switch (image.swizzle_type())
+				{
+				case swizzle_t::R: offset = r; break;
+				case swizzle_t::RG: offset = rg; break;
+				case swizzle_t::RGB: offset = rgb; break;
+				case swizzle_t::BGR: offset = bgr; break;
+				case swizzle_t::RGBA: offset = rgba; break;
+				case swizzle_t::BGRA: offset = bgra; break;
+				default:
+					return false;
+				}
+			}
+
+			for (std::uint32_t c = 0; c < 4; c++)
+			{
+				if (offset[c] >= (std::int32_t)image.channel())
+					return false;
+
+				layout.offset[c] = offset[c];
+			}
+
+			return true;
+		}
+
+		// Reads a 4x4 block, texels past the edge repeat the last row and column so they do not pull the fit.
+		void fetchBlock(const SourceLayout& layout, const std::uint8_t* data, std::uint32_t width, std::uint32_t height, std::uint32_t x, std::uint32_t y, float texels[16][4]) noexcept
+		{
+			for (std::uint32_t j = 0; j < 4; j++)
+			{
+				std::uint32_t sy = std::min(y + j, height - 1);
+
+				for (std::uint32_t i = 0; i < 4; i++)
+				{
+					std::uint32_t sx = std::min(x + i, width - 1);
+
+					const std::uint8_t* texel = data + ((std::size_t)sy * width + sx) * layout.pixelSize;
+					float* out = texels[j * 4 + i];
+
+					for (std::uint32_t c = 0; c < 4; c++)
+					{
+						std::int32_t offset = layout.offset[c];
+
+						if (offset < 0)
+						{
+							out[c] = c == 3 ? 255.0f : 0.0f;
+							continue;
+						}
+
+						switch (layout.value)
+						{
+						case source_t::UNorm8:
+							out[c] = texel[offset];
+							break;
+						case source_t::Float16:
+							out[c] = bc6Target(((const std::uint16_t*)texel)[offset], layout.sign);
+							break;
+						case source_t::Float32:
+							out[c] = bc6Target(math::fpToHalf(((const float*)texel)[offset]), layout.sign);
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		void encodeBlock(block_t type, const float texels[16][4], compress_quality_t quality, std::uint8_t* dst) noexcept
+		{
+			switch (type)
+			{
+			case block_t::BC1:
+				encodeColorBlock(texels, false, quality, dst);
+				break;
+			case block_t::BC1A:
+				encodeColorBlock(texels, true, quality, dst);
+				break;
+			case block_t::BC2:
+				encodeExplicitAlpha(texels, dst);
+				encodeColorBlock(texels, false, quality, dst + 8);
+				break;
+			case block_t::BC3:
+				encodeAlphaBlock(texels, 3, quality, dst);
+				encodeColorBlock(texels, false, quality, dst + 8);
+				break;
+			case block_t::BC4:
+				encodeAlphaBlock(texels, 0, quality, dst);
+				break;
+			case block_t::BC5:
+				encodeAlphaBlock(texels, 0, quality, dst);
+				encodeAlphaBlock(texels, 1, quality, dst + 8);
+				break;
+			case block_t::BC6H:
+				encodeBC6Block(texels, false, quality, dst);
+				break;
+			case block_t::BC6HS:
+				encodeBC6Block(texels, true, quality, dst);
+				break;
+			case block_t::BC7:
+				encodeBC7Block(texels, quality, dst);
+				break;
+			}
+		}
+
+		void decodeBlock(block_t type, const std::uint8_t* src, std::uint8_t texels[16][4]) noexcept
+		{
+			switch (type)
+			{
+			case block_t::BC1:
+				decodeColorBlock(src, false, false, texels);
+				break;
+			case block_t::BC1A:
+				decodeColorBlock(src, false, true, texels);
+				break;
+			case block_t::BC2:
+				decodeColorBlock(src + 8, true, false, texels);
+				decodeExplicitAlpha(src, texels);
+				break;
+			case block_t::BC3:
+				decodeColorBlock(src + 8, true, false, texels);
+				decodeAlphaBlock(src, 3, texels);
+				break;
+			case block_t::BC4:
+				decodeAlphaBlock(src, 0, texels);
+				break;
+			case block_t::BC5:
+				decodeAlphaBlock(src, 0, texels);
+				decodeAlphaBlock(src + 8, 1, texels);
+				break;
+			case block_t::BC7:
+				decodeBC7(src, texels);
+				break;
+			default:
+				break;
+			}
+		}
+
+		std::size_t makeLevels(std::vector<CompressLevel>& levels, const Image& image, std::uint32_t pixelSize, std::uint32_t blockSize) noexcept
+		{
+			const std::uint32_t sliceCount = image.depth() * image.layerLevel();
+
+			std::size_t srcOffset = 0;
+			std::size_t dstOffset = 0;
+			std::size_t taskCount = 0;
+
+			levels.resize(image.mipLevel());
+
+			for (std::uint32_t mip = 0; mip < image.mipLevel(); mip++)
+			{
+				CompressLevel& level = levels[mip];
+				level.width = std::max(image.width() >> mip, 1U);
+				level.height = std::max(image.height() >> mip, 1U);
+				level.blocksX = (level.width + 3) / 4;
+				level.blocksY = (level.height + 3) / 4;
+				level.srcOffset = srcOffset;
+				level.dstOffset = dstOffset;
+				level.firstTask = taskCount;
+
+				srcOffset += (std::size_t)level.width * level.height * pixelSize * sliceCount;
+				dstOffset += (std::size_t)level.blocksX * level.blocksY * blockSize * sliceCount;
+				taskCount += (std::size_t)level.blocksY * sliceCount;
+			}
+
+			return taskCount;
+		}
+	}
+
+	bool compress(Image& dst, const Image& src, format_t format, const CompressDesc& desc) noexcept
+	{
+		if (&dst == &src || src.empty())
+			return false;
+
+		block_t type;
+		if (!getBlockType(format, type))
+			return false;
+
+		const bool hdr = type == block_t::BC6H || type == block_t::BC6HS;
+
+		SourceLayout layout;
+		if (!makeSourceLayout(layout, src, hdr, type == block_t::BC6HS))
+			return false;
+
+		try
+		{
+			if (!dst.create(src.width(), src.height(), src.depth(), format, src.mipLevel(), src.layerLevel(), src.mipBase(), src.layerBase(), false))
+				return false;
+
+			const std::uint32_t blockSize = getBlockSize(type);
+
+			std::vector<CompressLevel> levels;
+			std::size_t taskCount = makeLevels(levels, src, layout.pixelSize, blockSize);
+
+			ThreadPool& threadPool = desc.threadPool ? *desc.threadPool : *ThreadPool::instance();
+
+			// One task per row of blocks, rows of every mip and slice share the same pool.
+			threadPool.parallelFor(taskCount, [&](std::size_t task)
+			{
+				std::size_t mip = levels.size() - 1;
+				while (levels[mip].firstTask > task)
+					mip--;
+
+				const CompressLevel& level = levels[mip];
+
+				std::size_t slice = (task - level.firstTask) / level.blocksY;
+				std::uint32_t y = (std::uint32_t)((task - level.firstTask) % level.blocksY);
+
+				const std::uint8_t* in = (const std::uint8_t*)src.data() + level.srcOffset + slice * level.width * level.height * layout.pixelSize;
+				std::uint8_t* out = (std::uint8_t*)dst.data() + level.dstOffset + (slice * level.blocksY + y) * level.blocksX * blockSize;
+
+				float texels[16][4];
+
+				for (std::uint32_t x = 0; x < level.blocksX; x++, out += blockSize)
+				{
+					fetchBlock(layout, in, level.width, level.height, x * 4, y * 4, texels);
+					encodeBlock(type, texels, desc.quality, out);
+				}
+			});
+
+			return true;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
+
+	bool decompress(Image& dst, const Image& src) noexcept
+	{
+		if (&dst == &src || src.empty())
+			return false;
+
+		block_t type;
+		if (!getBlockType(src.format(), type))
+			return false;
+
+		format_t format;
+
+		switch (src.format())
+		{
+		case format_t::BC4UNormBlock:
+			format = format_t::R8UNorm;
+			break;
+		case format_t::BC5UNormBlock:
+			format = format_t::R8G8UNorm;
+			break;
+		case format_t::BC6HUFloatBlock:
+		case format_t::BC6HSFloatBlock:
+			format = format_t::R16G16B16SFloat;
+			break;
+		case format_t::BC1RGBSRGBBlock:
+		case format_t::BC1RGBASRGBBlock:
+		case format_t::BC2SRGBBlock:
+		case format_t::BC3SRGBBlock:
+		case format_t::BC7SRGBBlock:
+			format = format_t::R8G8B8A8SRGB;
+			break;
+		default:
+			format = format_t::R8G8B8A8UNorm;
+		}
+
+		if (!dst.create(src.width(), src.height(), src.depth(), format, src.mipLevel(), src.layerLevel(), src.mipBase(), src.layerBase(), false))
+			return false;
+
+		const std::uint32_t blockSize = getBlockSize(type);
+		const std::uint32_t channel = Image::channel(format);
+		const std::uint32_t pixelSize = channel * Image::type_size(format);
+		const std::uint32_t sliceCount = src.depth() * src.layerLevel();
+
+		std::vector<CompressLevel> levels;
+		makeLevels(levels, dst, pixelSize, blockSize);
+
+		for (auto& level : levels)
+		{
+			const std::uint8_t* in = (const std::uint8_t*)src.data() + level.dstOffset;
+
+			for (std::uint32_t slice = 0; slice < sliceCount; slice++)
+			{
+				std::uint8_t* out = (std::uint8_t*)dst.data() + level.srcOffset + (std::size_t)slice * level.width * level.height * pixelSize;
+
+				for (std::uint32_t y = 0; y < level.blocksY; y++)
+				{
+					for (std::uint32_t x = 0; x < level.blocksX; x++, in += blockSize)
+					{
+						std::uint8_t texels[16][4];
+						std::uint16_t halfs[16][3];
+
+						if (type == block_t::BC6H || type == block_t::BC6HS)
+							decodeBC6(in, type == block_t::BC6HS, halfs);
+						else
+							decodeBlock(type, in, texels);
+
+						for (std::uint32_t j = 0; j < 4 && y * 4 + j < level.height; j++)
+						{
+							for (std::uint32_t i = 0; i < 4 && x * 4 + i < level.width; i++)
+							{
+								std::uint8_t* texel = out + ((std::size_t)(y * 4 + j) * level.width + x * 4 + i) * pixelSize;
+
+								if (type == block_t::BC6H || type == block_t::BC6HS)
+									std::memcpy(texel, halfs[j * 4 + i], pixelSize);
+								else
+									std::memcpy(texel, texels[j * 4 + i], channel);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+}
+
+_NAME_END
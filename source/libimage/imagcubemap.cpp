@@ -36,6 +36,10 @@
 // +----------------------------------------------------------------------
 #include <ray/imagcubemap.h>
 #include <ray/SH.h>
+#include <ray/thread.h>
+
+#include <thread>
+#include <vector>
 
 _NAME_BEGIN
 
@@ -458,6 +462,627 @@ namespace image
 			return false;
 		}
 	}
+
+	inline void cubeFaceVector(float _vec[3], std::uint8_t _faceIdx, float _u, float _v)
+	{
+		const float (&uv)[3][3] = s_faceUvVectors[_faceIdx];
+		_vec[0] = uv[2][0] + uv[0][0] * _u + uv[1][0] * _v;
+		_vec[1] = uv[2][1] + uv[0][1] * _u + uv[1][1] * _v;
+		_vec[2] = uv[2][2] + uv[0][2] * _u + uv[1][2] * _v;
+	}
+
+	// Rows are processed in tiles of struct-of-arrays data so the basis loops stay branch free and vectorize.
+	static const std::uint32_t SHTileSize = 64;
+
+	struct SHTile
+	{
+		float x[SHTileSize];
+		float y[SHTileSize];
+		float z[SHTileSize];
+		float r[SHTileSize];
+		float g[SHTileSize];
+		float b[SHTileSize];
+		float basis[SHTileSize];
+	};
+
+#define SH_BASIS(k, expr) \
+	case k: \
+		for (std::uint32_t i = 0; i < count; i++) \
+		{ \
+			const float x = tile.x[i]; const float y = tile.y[i]; const float z = tile.z[i]; \
+			(void)x; (void)y; (void)z; \
+			tile.basis[i] = (expr); \
+		} \
+		break;
+
+	void evalSHBasis(SHTile& tile, std::uint8_t k, std::uint32_t count) noexcept
+	{
+		switch (k)
+		{
+		SH_BASIS(0, 0.282095f)
+		SH_BASIS(1, -0.488603f * y)
+		SH_BASIS(2, 0.488603f * z)
+		SH_BASIS(3, -0.488603f * x)
+		SH_BASIS(4, 1.092548f * x * y)
+		SH_BASIS(5, -1.092548f * y * z)
+		SH_BASIS(6, 0.315392f * (3.0f * z * z - 1.0f))
+		SH_BASIS(7, -1.092548f * x * z)
+		SH_BASIS(8, 0.546274f * (x * x - y * y))
+		SH_BASIS(9, -0.590044f * y * (3.0f * x * x - y * y))
+		SH_BASIS(10, 2.890611f * x * y * z)
+		SH_BASIS(11, -0.457046f * y * (5.0f * z * z - 1.0f))
+		SH_BASIS(12, 0.373176f * z * (5.0f * z * z - 3.0f))
+		SH_BASIS(13, -0.457046f * x * (5.0f * z * z - 1.0f))
+		SH_BASIS(14, 1.445306f * z * (x * x - y * y))
+		SH_BASIS(15, -0.590044f * x * (x * x - 3.0f * y * y))
+		SH_BASIS(16, 2.503343f * x * y * (x * x - y * y))
+		SH_BASIS(17, -1.770131f * y * z * (3.0f * x * x - y * y))
+		SH_BASIS(18, 0.946175f * x * y * (7.0f * z * z - 1.0f))
+		SH_BASIS(19, -0.669047f * y * z * (7.0f * z * z - 3.0f))
+		SH_BASIS(20, 0.105786f * (35.0f * z * z * z * z - 30.0f * z * z + 3.0f))
+		SH_BASIS(21, -0.669047f * x * z * (7.0f * z * z - 3.0f))
+		SH_BASIS(22, 0.473087f * (x * x - y * y) * (7.0f * z * z - 1.0f))
+		SH_BASIS(23, -1.770131f * x * z * (x * x - 3.0f * y * y))
+		SH_BASIS(24, 0.625836f * (x * x * (x * x - 3.0f * y * y) - y * y * (3.0f * x * x - y * y)))
+		default:
+			assert(false);
+		}
+	}
+
+#undef SH_BASIS
+
+	template<std::uint8_t N>
+	void accumulateSH(SHTile& tile, std::uint32_t count, double* result) noexcept
+	{
+		for (std::uint8_t k = 0; k < N; k++)
+		{
+			evalSHBasis(tile, k, count);
+
+			float rr = 0.0f;
+			float gg = 0.0f;
+			float bb = 0.0f;
+
+			for (std::uint32_t i = 0; i < count; i++)
+			{
+				rr += tile.basis[i] * tile.r[i];
+				gg += tile.basis[i] * tile.g[i];
+				bb += tile.basis[i] * tile.b[i];
+			}
+
+			result[k * 3 + 0] += rr;
+			result[k * 3 + 1] += gg;
+			result[k * 3 + 2] += bb;
+		}
+	}
+
+	template<std::uint8_t N>
+	bool makeSHFromImage(SH<float3, N>& sh, const Image& src, bool latlong) noexcept
+	{
+		if (src.value_type() != image::value_t::Float || src.type_size() != 4)
+			return false;
+
+		if (src.channel() != 3 && src.channel() != 4)
+			return false;
+
+		if (latlong ? !isLatLong(src) : !isCubemap(src))
+			return false;
+
+		const std::uint32_t width = src.width();
+		const std::uint32_t height = src.height();
+		const std::uint32_t channel = src.channel();
+		const std::uint32_t rowCount = latlong ? height : height * 6;
+
+		const float invWidth = 1.0f / width;
+		const float invHeight = 1.0f / height;
+
+		try
+		{
+			ThreadPool& threadPool = *ThreadPool::instance();
+
+			const std::uint32_t numThreads = threadPool.getNumThreads();
+
+			std::vector<double> results(numThreads * (N * 3 + 1), 0.0);
+
+			threadPool.parallelFor(rowCount, [&](std::uint32_t row, std::uint32_t thread)
+			{
+				double* result = results.data() + thread * (N * 3 + 1);
+
+				const std::uint8_t faceIdx = latlong ? 0 : static_cast<std::uint8_t>(row / height);
+				const std::uint32_t yy = latlong ? row : row % height;
+				const float* data = (const float*)src.data() + (faceIdx * height + yy) * width * channel;
+
+				const float v = (yy + 0.5f) * invHeight;
+				const float theta = v * M_PI;
+				const float sinTheta = std::sin(theta);
+				const float cosTheta = std::cos(theta);
+
+				SHTile tile;
+
+				for (std::uint32_t x0 = 0; x0 < width; x0 += SHTileSize)
+				{
+					const std::uint32_t count = std::min(SHTileSize, width - x0);
+
+					double weights = 0.0;
+
+					for (std::uint32_t i = 0; i < count; i++)
+					{
+						const float u = (x0 + i + 0.5f) * invWidth;
+
+						float vec[3];
+						float weight;
+
+						if (latlong)
+						{
+							const float phi = u * M_TWO_PI;
+							vec[0] = -sinTheta * std::sin(phi);
+							vec[1] = cosTheta;
+							vec[2] = -sinTheta * std::cos(phi);
+							weight = sinTheta;
+						}
+						else
+						{
+							const float uu = u * 2.0f - 1.0f;
+							const float vv = v * 2.0f - 1.0f;
+							const float temp = 1.0f + uu * uu + vv * vv;
+							const float invLength = 1.0f / std::sqrt(temp);
+
+							cubeFaceVector(vec, faceIdx, uu, vv);
+							vec3Mul(vec, vec, invLength);
+							weight = invLength / temp;
+						}
+
+						const float* pixel = data + (x0 + i) * channel;
+
+						tile.x[i] = vec[0];
+						tile.y[i] = vec[1];
+						tile.z[i] = vec[2];
+						tile.r[i] = pixel[0] * weight;
+						tile.g[i] = pixel[1] * weight;
+						tile.b[i] = pixel[2] * weight;
+
+						weights += weight;
+					}
+
+					accumulateSH<N>(tile, count, result);
+
+					result[N * 3] += weights;
+				}
+			});
+
+			for (std::uint32_t thread = 1; thread < numThreads; thread++)
+			{
+				for (std::uint32_t i = 0; i < N * 3 + 1; i++)
+					results[i] += results[thread * (N * 3 + 1) + i];
+			}
+
+			if (results[N * 3] <= 0.0)
+				return false;
+
+			const double norm = (4.0 * M_PI) / results[N * 3];
+
+			for (std::uint8_t k = 0; k < N; k++)
+			{
+				sh.coeff[k].x = static_cast<float>(results[k * 3 + 0] * norm);
+				sh.coeff[k].y = static_cast<float>(results[k * 3 + 1] * norm);
+				sh.coeff[k].z = static_cast<float>(results[k * 3 + 2] * norm);
+			}
+
+			return true;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
+
+	bool makeSHFromCubemap(SH9Color& sh, const Image& src) noexcept
+	{
+		return makeSHFromImage<9>(sh, src, false);
+	}
+
+	bool makeSHFromCubemap(SH16Color& sh, const Image& src) noexcept
+	{
+		return makeSHFromImage<16>(sh, src, false);
+	}
+
+	bool makeSHFromCubemap(SH25Color& sh, const Image& src) noexcept
+	{
+		return makeSHFromImage<25>(sh, src, false);
+	}
+
+	bool makeSHFromLatLong(SH9Color& sh, const Image& src) noexcept
+	{
+		return makeSHFromImage<9>(sh, src, true);
+	}
+
+	bool makeSHFromLatLong(SH16Color& sh, const Image& src) noexcept
+	{
+		return makeSHFromImage<16>(sh, src, true);
+	}
+
+	bool makeSHFromLatLong(SH25Color& sh, const Image& src) noexcept
+	{
+		return makeSHFromImage<25>(sh, src, true);
+	}
+
+	template<std::uint8_t N>
+	bool makeIrradianceFromSHImpl(Image& dst, const SH<float3, N>& sh, std::uint32_t size) noexcept
+	{
+		assert(size > 0);
+
+		// Cosine lobe convolution per band divided by PI, band 3 vanishes
+		static const float bandScale[] = { 1.0f, 2.0f / 3.0f, 1.0f / 4.0f, 0.0f, -1.0f / 24.0f };
+
+		if (!dst.create(size, size, 6, image::format_t::R32G32B32SFloat))
+			return false;
+
+		float3 coeff[N];
+		for (std::uint8_t k = 0; k < N; k++)
+		{
+			const std::uint8_t band = static_cast<std::uint8_t>(std::sqrt(static_cast<float>(k)));
+			coeff[k] = sh.coeff[k] * bandScale[band];
+		}
+
+		const float invSize = 1.0f / size;
+
+		try
+		{
+			ThreadPool& threadPool = *ThreadPool::instance();
+
+			threadPool.parallelFor(size * 6, [&](std::uint32_t row, std::uint32_t)
+			{
+				const std::uint8_t faceIdx = static_cast<std::uint8_t>(row / size);
+				const std::uint32_t yy = row % size;
+
+				float* data = (float*)dst.data() + (faceIdx * size + yy) * size * 3;
+
+				SHTile tile;
+
+				for (std::uint32_t x0 = 0; x0 < size; x0 += SHTileSize)
+				{
+					const std::uint32_t count = std::min(SHTileSize, size - x0);
+
+					for (std::uint32_t i = 0; i < count; i++)
+					{
+						float vec[3];
+						cubeFaceVector(vec, faceIdx, (x0 + i + 0.5f) * invSize * 2.0f - 1.0f, (yy + 0.5f) * invSize * 2.0f - 1.0f);
+						vec3Mul(vec, vec, 1.0f / std::sqrt(vec3Dot(vec, vec)));
+
+						tile.x[i] = vec[0];
+						tile.y[i] = vec[1];
+						tile.z[i] = vec[2];
+						tile.r[i] = tile.g[i] = tile.b[i] = 0.0f;
+					}
+
+					for (std::uint8_t k = 0; k < N; k++)
+					{
+						evalSHBasis(tile, k, count);
+
+						for (std::uint32_t i = 0; i < count; i++)
+						{
+							tile.r[i] += tile.basis[i] * coeff[k].x;
+							tile.g[i] += tile.basis[i] * coeff[k].y;
+							tile.b[i] += tile.basis[i] * coeff[k].z;
+						}
+					}
+
+					for (std::uint32_t i = 0; i < count; i++)
+					{
+						float* pixel = data + (x0 + i) * 3;
+						pixel[0] = std::max(tile.r[i], 0.0f);
+						pixel[1] = std::max(tile.g[i], 0.0f);
+						pixel[2] = std::max(tile.b[i], 0.0f);
+					}
+				}
+			});
+
+			return true;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
+
+	bool makeIrradianceFromSH(Image& dst, const SH9Color& sh, std::uint32_t size) noexcept
+	{
+		return makeIrradianceFromSHImpl<9>(dst, sh, size);
+	}
+
+	bool makeIrradianceFromSH(Image& dst, const SH16Color& sh, std::uint32_t size) noexcept
+	{
+		return makeIrradianceFromSHImpl<16>(dst, sh, size);
+	}
+
+	bool makeIrradianceFromSH(Image& dst, const SH25Color& sh, std::uint32_t size) noexcept
+	{
+		return makeIrradianceFromSHImpl<25>(dst, sh, size);
+	}
+
+	struct CubemapLevel
+	{
+		std::uint32_t size;
+		std::vector<float> data;
+	};
+
+	inline const float* cubemapTexel(const CubemapLevel& level, std::uint8_t faceIdx, std::uint32_t x, std::uint32_t y)
+	{
+		return level.data.data() + ((faceIdx * level.size + y) * level.size + x) * 3;
+	}
+
+	void sampleCubemapLevel(float _color[3], const CubemapLevel& level, std::uint8_t faceIdx, float u, float v)
+	{
+		const float maxCoord = static_cast<float>(level.size - 1);
+
+		const float xf = std::min(std::max(u * level.size - 0.5f, 0.0f), maxCoord);
+		const float yf = std::min(std::max(v * level.size - 0.5f, 0.0f), maxCoord);
+
+		const std::uint32_t x0 = static_cast<std::uint32_t>(xf);
+		const std::uint32_t y0 = static_cast<std::uint32_t>(yf);
+		const std::uint32_t x1 = std::min(x0 + 1, level.size - 1);
+		const std::uint32_t y1 = std::min(y0 + 1, level.size - 1);
+
+		const float tx = xf - x0;
+		const float ty = yf - y0;
+
+		const float* src0 = cubemapTexel(level, faceIdx, x0, y0);
+		const float* src1 = cubemapTexel(level, faceIdx, x1, y0);
+		const float* src2 = cubemapTexel(level, faceIdx, x0, y1);
+		const float* src3 = cubemapTexel(level, faceIdx, x1, y1);
+
+		for (std::uint8_t i = 0; i < 3; i++)
+		{
+			const float top = src0[i] + (src1[i] - src0[i]) * tx;
+			const float bottom = src2[i] + (src3[i] - src2[i]) * tx;
+			_color[i] = top + (bottom - top) * ty;
+		}
+	}
+
+	void sampleCubemap(float _color[3], const std::vector<CubemapLevel>& levels, const float _vec[3], float lod)
+	{
+		float u, v;
+		std::uint8_t faceIdx;
+		vecToTexelCoord(u, v, faceIdx, _vec);
+
+		lod = std::min(std::max(lod, 0.0f), static_cast<float>(levels.size() - 1));
+
+		const std::uint32_t lod0 = static_cast<std::uint32_t>(lod);
+		const std::uint32_t lod1 = std::min<std::uint32_t>(lod0 + 1, static_cast<std::uint32_t>(levels.size() - 1));
+
+		sampleCubemapLevel(_color, levels[lod0], faceIdx, u, v);
+
+		const float t = lod - lod0;
+		if (t > 0.0f && lod1 != lod0)
+		{
+			float color1[3];
+			sampleCubemapLevel(color1, levels[lod1], faceIdx, u, v);
+
+			for (std::uint8_t i = 0; i < 3; i++)
+				_color[i] += (color1[i] - _color[i]) * t;
+		}
+	}
+
+	struct GGXSample
+	{
+		float x, y, z;
+		float weight;
+		float lod;
+	};
+
+	void makeGGXSamples(std::vector<GGXSample>& samples, float roughness, std::uint32_t sampleCount, std::uint32_t srcSize)
+	{
+		const float alpha = roughness * roughness;
+		const float alpha2 = alpha * alpha;
+
+		const float texelSolidAngle = 4.0f * M_PI / (6.0f * srcSize * srcSize);
+
+		samples.clear();
+		samples.reserve(sampleCount);
+
+		for (std::uint32_t i = 0; i < sampleCount; i++)
+		{
+			std::uint32_t bits = i;
+			bits = (bits << 16u) | (bits >> 16u);
+			bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+			bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+			bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+			bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+
+			const float e1 = static_cast<float>(i) / sampleCount;
+			const float e2 = bits * 2.3283064365386963e-10f;
+
+			const float phi = M_TWO_PI * e1;
+			const float cosTheta = std::sqrt((1.0f - e2) / (1.0f + (alpha2 - 1.0f) * e2));
+			const float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+
+			const float hx = sinTheta * std::cos(phi);
+			const float hy = sinTheta * std::sin(phi);
+			const float hz = cosTheta;
+
+			// N == V == R, so L is H reflected about the normal
+			GGXSample sample;
+			sample.x = 2.0f * hz * hx;
+			sample.y = 2.0f * hz * hy;
+			sample.z = 2.0f * hz * hz - 1.0f;
+			sample.weight = sample.z;
+
+			if (sample.weight <= 0.0f)
+				continue;
+
+			const float d = (hz * hz) * (alpha2 - 1.0f) + 1.0f;
+			const float pdf = alpha2 / (M_PI * d * d) * 0.25f;
+			const float sampleSolidAngle = 1.0f / (sampleCount * pdf + 1e-6f);
+
+			sample.lod = roughness > 0.0f ? std::max(0.5f * std::log2(sampleSolidAngle / texelSolidAngle) + 1.0f, 0.0f) : 0.0f;
+
+			samples.push_back(sample);
+		}
+	}
+
+	bool makePrefilteredCubemap(Image& dst, const Image& src, std::uint32_t size, std::uint32_t mipLevel, std::uint32_t sampleCount) noexcept
+	{
+		if (src.value_type() != image::value_t::Float || src.type_size() != 4)
+			return false;
+
+		if (src.channel() != 3 && src.channel() != 4)
+			return false;
+
+		Image cubemap;
+		const Image* source = &src;
+
+		if (!isCubemap(src))
+		{
+			if (!isLatLong(src) || !makeCubemapFromLatLong(cubemap, src, true))
+				return false;
+
+			source = &cubemap;
+		}
+
+		const std::uint32_t srcSize = source->width();
+		const std::uint32_t srcChannel = source->channel();
+
+		if (size == 0)
+			size = srcSize;
+
+		std::uint32_t maxMipLevel = 1;
+		while ((size >> maxMipLevel) > 0)
+			maxMipLevel++;
+
+		mipLevel = mipLevel == 0 ? maxMipLevel : std::min(mipLevel, maxMipLevel);
+		sampleCount = std::max(sampleCount, 1U);
+
+		try
+		{
+			std::vector<CubemapLevel> levels;
+			levels.reserve(maxMipLevel);
+
+			CubemapLevel base;
+			base.size = srcSize;
+			base.data.resize(6 * srcSize * srcSize * 3);
+
+			const float* srcData = (const float*)source->data();
+			for (std::size_t i = 0; i < 6 * srcSize * srcSize; i++)
+			{
+				base.data[i * 3 + 0] = srcData[i * srcChannel + 0];
+				base.data[i * 3 + 1] = srcData[i * srcChannel + 1];
+				base.data[i * 3 + 2] = srcData[i * srcChannel + 2];
+			}
+
+			levels.push_back(std::move(base));
+
+			while (levels.back().size > 1)
+			{
+				const CubemapLevel& parent = levels.back();
+
+				CubemapLevel level;
+				level.size = parent.size / 2;
+				level.data.resize(6 * level.size * level.size * 3);
+
+				for (std::uint8_t faceIdx = 0; faceIdx < 6; faceIdx++)
+				{
+					for (std::uint32_t y = 0; y < level.size; y++)
+					{
+						for (std::uint32_t x = 0; x < level.size; x++)
+						{
+							const float* src0 = cubemapTexel(parent, faceIdx, x * 2 + 0, y * 2 + 0);
+							const float* src1 = cubemapTexel(parent, faceIdx, x * 2 + 1, y * 2 + 0);
+							const float* src2 = cubemapTexel(parent, faceIdx, x * 2 + 0, y * 2 + 1);
+							const float* src3 = cubemapTexel(parent, faceIdx, x * 2 + 1, y * 2 + 1);
+
+							float* texel = level.data.data() + ((faceIdx * level.size + y) * level.size + x) * 3;
+							for (std::uint8_t i = 0; i < 3; i++)
+								texel[i] = (src0[i] + src1[i] + src2[i] + src3[i]) * 0.25f;
+						}
+					}
+				}
+
+				levels.push_back(std::move(level));
+			}
+
+			if (!dst.create(size, size, 6, image::format_t::R32G32B32SFloat, mipLevel, 1))
+				return false;
+
+			float* dstData = (float*)dst.data();
+
+			std::vector<GGXSample> samples;
+
+			ThreadPool& threadPool = *ThreadPool::instance();
+
+			for (std::uint32_t mip = 0; mip < mipLevel; mip++)
+			{
+				const std::uint32_t mipSize = std::max(size >> mip, 1U);
+				const float invMipSize = 1.0f / mipSize;
+				const float roughness = mipLevel > 1 ? static_cast<float>(mip) / (mipLevel - 1) : 0.0f;
+
+				// Mirror mips only resample the source, at the level matching the destination footprint
+				const float baseLod = std::max(std::log2(static_cast<float>(srcSize) / mipSize), 0.0f);
+
+				makeGGXSamples(samples, roughness, roughness > 0.0f ? sampleCount : 1, srcSize);
+
+				threadPool.parallelFor(mipSize * 6, [&](std::uint32_t row, std::uint32_t)
+				{
+					const std::uint8_t faceIdx = static_cast<std::uint8_t>(row / mipSize);
+					const std::uint32_t yy = row % mipSize;
+
+					float* data = dstData + (faceIdx * mipSize + yy) * mipSize * 3;
+
+					for (std::uint32_t xx = 0; xx < mipSize; xx++)
+					{
+						float n[3];
+						cubeFaceVector(n, faceIdx, (xx + 0.5f) * invMipSize * 2.0f - 1.0f, (yy + 0.5f) * invMipSize * 2.0f - 1.0f);
+						vec3Mul(n, n, 1.0f / std::sqrt(vec3Dot(n, n)));
+
+						float* pixel = data + xx * 3;
+
+						if (roughness == 0.0f)
+						{
+							sampleCubemap(pixel, levels, n, baseLod);
+							continue;
+						}
+
+						const float up[3] = { std::abs(n[2]) < 0.999f ? 0.0f : 1.0f, 0.0f, std::abs(n[2]) < 0.999f ? 1.0f : 0.0f };
+
+						float t[3] = { up[1] * n[2] - up[2] * n[1], up[2] * n[0] - up[0] * n[2], up[0] * n[1] - up[1] * n[0] };
+						vec3Mul(t, t, 1.0f / std::sqrt(vec3Dot(t, t)));
+
+						const float b[3] = { n[1] * t[2] - n[2] * t[1], n[2] * t[0] - n[0] * t[2], n[0] * t[1] - n[1] * t[0] };
+
+						float color[3] = { 0.0f, 0.0f, 0.0f };
+						float weights = 0.0f;
+
+						for (auto& sample : samples)
+						{
+							const float l[3] =
+							{
+								t[0] * sample.x + b[0] * sample.y + n[0] * sample.z,
+								t[1] * sample.x + b[1] * sample.y + n[1] * sample.z,
+								t[2] * sample.x + b[2] * sample.y + n[2] * sample.z,
+							};
+
+							float radiance[3];
+							sampleCubemap(radiance, levels, l, std::max(sample.lod, baseLod));
+
+							color[0] += radiance[0] * sample.weight;
+							color[1] += radiance[1] * sample.weight;
+							color[2] += radiance[2] * sample.weight;
+
+							weights += sample.weight;
+						}
+
+						vec3Mul(pixel, color, weights > 0.0f ? 1.0f / weights : 0.0f);
+					}
+				});
+
+				dstData += 6 * mipSize * mipSize * 3;
+			}
+
+			return true;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
 }
 
 _NAME_END
\ No newline at end of file
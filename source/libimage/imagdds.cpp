@@ -689,7 +689,7 @@ static DDS_FORMAT DDS_FormatTable[] =
 
 	{ DDPF_FOURCC, D3DFMT_R32F, DXGI_FORMAT_R32_FLOAT, image::format_t::R32SFloat, 0xFFFFFFFF, 0, 0, 0 },					//R32_FLOAT,
 	{ DDPF_FOURCC, D3DFMT_G32R32F, DXGI_FORMAT_R32G32_FLOAT, image::format_t::R32G32SFloat, 0, 0, 0, 0 },					//RG32_FLOAT,
-	{ DDPF_FOURCC, D3DFMT_DX10, DXGI_FORMAT_UNKNOWN, image::format_t::R32G32SFloat, 0, 0, 0, 0 },							//RGB32_FLOAT,
+	{ DDPF_FOURCC, D3DFMT_DX10, DXGI_FORMAT_R32G32B32_FLOAT, image::format_t::R32G32B32SFloat, 0, 0, 0, 0 },				//RGB32_FLOAT,
 	{ DDPF_FOURCC, D3DFMT_A32B32G32R32F, DXGI_FORMAT_R32G32B32A32_FLOAT, image::format_t::R32G32B32A32SFloat, 0, 0, 0, 0 },	//RGBA32_FLOAT,
 
 	// sRGB formats
@@ -805,60 +805,6 @@ static DDS_FORMAT DDS_FormatTable[] =
 	{ DDPF_FOURCC, D3DFMT_DX10, DXGI_FORMAT_ASTC_12X12_UNORM_SRGB, image::format_t::ASTC12x12SRGBBlock, 0, 0, 0, 0 }, //RGBA_ASTC_12x12,
 };
 
-inline bool DDStoCubeMap(char* buffer, std::size_t mipBase, std::size_t mipLevel, std::size_t width, std::size_t height, std::size_t depth, std::size_t bpp, char* stream) noexcept
-{
-	std::size_t offset1 = 0;
-	std::size_t offset2 = 0;
-	std::size_t allLayerSize = 0;
-
-	std::size_t w = width;
-	std::size_t h = height;
-
-	std::size_t pixelSize = 0;
-	if (bpp == 24)
-		pixelSize = 3;
-	else if (bpp == 32)
-		pixelSize = 4;
-	else if (bpp == 64)
-		pixelSize = 8;
-	else if (bpp == 128)
-		pixelSize = 16;
-	else
-		return false;
-
-	for (std::size_t mip = mipBase; mip < mipBase + mipLevel; mip++)
-	{
-		std::size_t mipSize = w * h * pixelSize;
-
-		w = std::max(w >> 1, (std::size_t)1);
-		h = std::max(h >> 1, (std::size_t)1);
-
-		allLayerSize += mipSize;
-	}
-
-	w = width;
-	h = height;
-
-	for (std::size_t mip = mipBase; mip < mipBase + mipLevel; mip++)
-	{
-		std::size_t mipSize = w * h * pixelSize;
-
-		for (std::size_t i = 0; i < depth; i++)
-		{
-			std::size_t offset = allLayerSize * i + offset1;
-			std::memcpy(buffer + offset2, (char*)stream + offset, mipSize);
-			offset2 += mipSize;
-		}
-
-		w = std::max(w >> 1, (std::size_t)1);
-		h = std::max(h >> 1, (std::size_t)1);
-
-		offset1 += mipSize;
-	}
-
-	return true;
-}
-
 inline bool DDS_MaskCmp(dds_uint mask[4], DDS_Format format)
 {
 	auto& dstmask = DDS_FormatTable[format].mask;
@@ -873,16 +819,24 @@ inline bool DDS_MaskCmp(dds_uint mask[4], DDS_Format format)
 	return false;
 }
 
-inline image::format_t DDS_Find(D3DFORMAT fourcc) noexcept
+inline image::format_t DDS_Find(D3DFORMAT fourcc, dds_uint flags) noexcept
 {
+	image::format_t format = image::format_t::Undefined;
+
+	// DXT1 is listed with and without alpha, the pixel format flags tell them apart.
 	for (int i = 0; i < FORMAT_COUNT; ++i)
 	{
 		if (DDS_FormatTable[i].D3DFormat != fourcc)
 			continue;
-		return DDS_FormatTable[i].Format;
+
+		if ((dds_uint)DDS_FormatTable[i].DDPixelFormat == flags)
+			return DDS_FormatTable[i].Format;
+
+		if (format == image::format_t::Undefined)
+			format = DDS_FormatTable[i].Format;
 	}
 
-	return image::format_t::Undefined;
+	return format;
 }
 
 inline image::format_t DDS_Find(DXGI_FORMAT format)
@@ -898,6 +852,31 @@ inline image::format_t DDS_Find(DXGI_FORMAT format)
 	return image::format_t::Undefined;
 }
 
+inline std::uint32_t DDS_BlockSize(image::format_t format) noexcept
+{
+	if (Image::value_type(format) != image::value_t::Compressed)
+		return 0;
+
+	if (format == image::format_t::BC1RGBUNormBlock ||
+		format == image::format_t::BC1RGBSRGBBlock ||
+		format == image::format_t::BC1RGBAUNormBlock ||
+		format == image::format_t::BC1RGBASRGBBlock ||
+		format == image::format_t::BC4UNormBlock ||
+		format == image::format_t::BC4SNormBlock)
+	{
+		return 8;
+	}
+
+	return 16;
+}
+
+inline std::size_t DDS_SliceSize(std::uint32_t width, std::uint32_t height, std::uint32_t pixelSize, std::uint32_t blockSize) noexcept
+{
+	if (blockSize > 0)
+		return ((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+	return (std::size_t)width * height * pixelSize;
+}
+
 DDSHandler::DDSHandler() noexcept
 {
 }
@@ -932,8 +911,6 @@ DDSHandler::doLoad(StreamReader& stream, Image& image) noexcept
 	if (!stream.read((char*)&info, sizeof(info)))
 		return false;
 
-	std::size_t offset = sizeof(info);
-
 	DDS_HEADER_DXT10 info10;
 	std::memset(&info10, 0, sizeof(info10));
 
@@ -941,13 +918,11 @@ DDSHandler::doLoad(StreamReader& stream, Image& image) noexcept
 	{
 		if (!stream.read((char*)&info10, sizeof(info10)))
 			return false;
-
-		offset += sizeof(info10);
 	}
 
 	image::format_t format = image::format_t::Undefined;
 	if ((info.format.flags & DDPF_FOURCC) && (info.format.fourcc != D3DFMT_DX10))
-		format = DDS_Find(info.format.fourcc);
+		format = DDS_Find(info.format.fourcc, info.format.flags);
 	else if ((info.format.fourcc == D3DFMT_DX10) && (info10.format != DXGI_FORMAT_UNKNOWN))
 		format = DDS_Find(info10.format);
 	else if ((info.format.flags & (DDPF_RGB | DDPF_ALPHAPIXELS | DDPF_ALPHA | DDPF_YUV | DDPF_LUMINANCE)) && info.format.flags != DDPF_FOURCC_ALPHAPIXELS)
@@ -1033,27 +1008,49 @@ DDSHandler::doLoad(StreamReader& stream, Image& image) noexcept
 			faceCount++;
 	}
 
-	if (info.mip_level > 1 && faceCount > 1 && info.flags & DDSD_PITCH)
-	{
-		auto length = (std::size_t)(stream.size() - offset);
+	if (!image.create(info.width, info.height, info.depth * faceCount, format, info.mip_level, info10.arraySize))
+		return false;
 
-		auto data = std::make_unique<char[]>(length);
-		if (!stream.read((char*)data.get(), length))
-			return false;
+	const std::uint32_t layerCount = info10.arraySize;
 
-		if (!image.create(info.width, info.height, info.depth * faceCount, format, info.mip_level, info10.arraySize))
+	if (info.mip_level == 1 || (faceCount == 1 && layerCount == 1))
+	{
+		if (!stream.read((char*)image.data(), image.size()))
 			return false;
 
-		if (!DDStoCubeMap((char*)image.data(), 0, info.mip_level, info.width, info.height, faceCount, info.format.bpp, data.get()))
-			return false;
+		return true;
 	}
-	else
+
+	// DDS stores the whole mip chain of each face in turn, Image keeps every face of a mip level together.
+	const std::uint32_t pixelSize = image.value_type() == image::value_t::Compressed ? 0 : image.channel() * image.type_size();
+	const std::uint32_t blockSize = DDS_BlockSize(format);
+
+	std::vector<std::size_t> mipOffsets(info.mip_level);
+	std::vector<std::size_t> mipSlices(info.mip_level);
+
+	std::size_t offset = 0;
+	for (std::uint32_t mip = 0; mip < info.mip_level; mip++)
 	{
-		if (!image.create(info.width, info.height, info.depth * faceCount, format, info.mip_level, info10.arraySize))
-			return false;
+		const std::uint32_t w = std::max(info.width >> mip, 1U);
+		const std::uint32_t h = std::max(info.height >> mip, 1U);
 
-		if (!stream.read((char*)image.data(), image.size()))
-			return false;
+		mipOffsets[mip] = offset;
+		mipSlices[mip] = DDS_SliceSize(w, h, pixelSize, blockSize) * info.depth;
+
+		offset += mipSlices[mip] * faceCount * layerCount;
+	}
+
+	for (std::uint32_t layer = 0; layer < layerCount; layer++)
+	{
+		for (std::uint32_t face = 0; face < faceCount; face++)
+		{
+			for (std::uint32_t mip = 0; mip < info.mip_level; mip++)
+			{
+				char* data = (char*)image.data() + mipOffsets[mip] + (layer * faceCount + face) * mipSlices[mip];
+				if (!stream.read(data, mipSlices[mip]))
+					return false;
+			}
+		}
 	}
 
 	return true;
@@ -1062,6 +1059,35 @@ DDSHandler::doLoad(StreamReader& stream, Image& image) noexcept
 bool
 DDSHandler::doSave(StreamWrite& stream, const Image& image) noexcept
 {
+	const DDS_FORMAT* entry = nullptr;
+	for (auto& it : DDS_FormatTable)
+	{
+		if (it.Format != image.format())
+			continue;
+
+		if (it.D3DFormat == D3DFMT_UNKNOWN || (it.D3DFormat == D3DFMT_DX10 && it.DXGIFormat == DXGI_FORMAT_UNKNOWN))
+			continue;
+
+		entry = &it;
+		break;
+	}
+
+	if (!entry)
+		return false;
+
+	const bool compressed = image.value_type() == image::value_t::Compressed;
+	const bool cubemap = image.depth() == 6 && image.width() == image.height();
+
+	const std::uint32_t pixelSize = compressed ? 0 : image.channel() * image.type_size();
+	const std::uint32_t blockSize = DDS_BlockSize(image.format());
+	const std::uint32_t faceCount = cubemap ? 6 : 1;
+	const std::uint32_t depth = cubemap ? 1 : image.depth();
+	const std::uint32_t mipLevel = image.mipLevel();
+	const std::uint32_t layerLevel = image.layerLevel();
+
+	if (entry->D3DFormat == D3DFMT_DX10 && !compressed && image.channel() == 3 && image.type_size() != 4)
+		return false;
+
 	DDS_HEADER hdr;
 	std::memset((char*)&hdr, 0, sizeof(hdr));
 
@@ -1070,26 +1096,100 @@ DDSHandler::doSave(StreamWrite& stream, const Image& image) noexcept
 	hdr.header[2] = 'S';
 	hdr.header[3] = 0x20;
 	hdr.size = sizeof(hdr) - sizeof(hdr.header);
-	hdr.flags = 0x100f;
+	hdr.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT;
+	hdr.flags |= compressed ? DDSD_LINEARSIZE : DDSD_PITCH;
 	hdr.width = image.width();
 	hdr.height = image.height();
-	hdr.mip_level = image.mipLevel();
-	hdr.pitch = 0x3200;
+	hdr.pitch = compressed ? DDS_SliceSize(image.width(), image.height(), 0, blockSize) : image.width() * pixelSize;
+	hdr.mip_level = mipLevel;
+
+	if (mipLevel > 1)
+		hdr.flags |= DDSD_MIPMAPCOUNT;
+
+	if (depth > 1)
+	{
+		hdr.flags |= DDSD_DEPTH;
+		hdr.depth = depth;
+	}
 
 	hdr.format.size = sizeof(DDPixelFormat);
-	hdr.format.flags = DDPF::DDPF_RGBAPIXELS;
-	hdr.format.fourcc = D3DFORMAT::D3DFMT_A8B8G8R8;
-	hdr.format.bpp = 0x20;
-	hdr.format.mask[0] = 0x00ff0000;
-	hdr.format.mask[1] = 0x0000ff00;
-	hdr.format.mask[2] = 0x000000ff;
-	hdr.format.mask[3] = 0xff000000;
-	hdr.caps.surface = DDSCAPS::DDSCAPS_TEXTURE | DDSCAPS::DDSCAPS_COMPLEX;
-
-	stream.write((char*)&hdr, sizeof(hdr));
-	stream.write((char*)image.data(), image.size());
+	hdr.format.flags = entry->DDPixelFormat;
+	hdr.format.bpp = pixelSize * 8;
 
-	return false;
+	if (entry->DDPixelFormat & DDPF_FOURCC)
+		hdr.format.fourcc = entry->D3DFormat;
+	else
+	{
+		hdr.format.fourcc = D3DFMT_UNKNOWN;
+		std::memcpy(hdr.format.mask, entry->mask, sizeof(hdr.format.mask));
+	}
+
+	hdr.caps.surface = DDSCAPS_TEXTURE;
+	if (mipLevel > 1)
+		hdr.caps.surface |= DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+	if (cubemap || depth > 1)
+		hdr.caps.surface |= DDSCAPS_COMPLEX;
+
+	if (cubemap)
+		hdr.caps.cubemap = DDSCAPS2_CUBEMAP | DDSCAPS2_CUBEMAP_ALLFACES;
+	else if (depth > 1)
+		hdr.caps.cubemap = DDSCAPS2_VOLUME;
+
+	if (!stream.write((char*)&hdr, sizeof(hdr)))
+		return false;
+
+	if (entry->D3DFormat == D3DFMT_DX10)
+	{
+		DDS_HEADER_DXT10 hdr10;
+		std::memset((char*)&hdr10, 0, sizeof(hdr10));
+
+		hdr10.format = entry->DXGIFormat;
+		hdr10.dimension = depth > 1 ? D3D10_RESOURCE_DIMENSION_TEXTURE3D : D3D10_RESOURCE_DIMENSION_TEXTURE2D;
+		hdr10.miscFlag = cubemap ? 0x4 : 0;
+		hdr10.arraySize = layerLevel;
+
+		if (!stream.write((char*)&hdr10, sizeof(hdr10)))
+			return false;
+	}
+
+	if (mipLevel == 1 || (faceCount == 1 && layerLevel == 1))
+	{
+		if (!stream.write(image.data(), image.size()))
+			return false;
+
+		return true;
+	}
+
+	// Image keeps every face of a mip level together, DDS stores the whole mip chain of each face in turn.
+	std::vector<std::size_t> mipOffsets(mipLevel);
+	std::vector<std::size_t> mipSlices(mipLevel);
+
+	std::size_t offset = 0;
+	for (std::uint32_t mip = 0; mip < mipLevel; mip++)
+	{
+		const std::uint32_t w = std::max(image.width() >> mip, 1U);
+		const std::uint32_t h = std::max(image.height() >> mip, 1U);
+
+		mipOffsets[mip] = offset;
+		mipSlices[mip] = DDS_SliceSize(w, h, pixelSize, blockSize) * depth;
+
+		offset += mipSlices[mip] * faceCount * layerLevel;
+	}
+
+	for (std::uint32_t layer = 0; layer < layerLevel; layer++)
+	{
+		for (std::uint32_t face = 0; face < faceCount; face++)
+		{
+			for (std::uint32_t mip = 0; mip < mipLevel; mip++)
+			{
+				const char* data = image.data() + mipOffsets[mip] + (layer * faceCount + face) * mipSlices[mip];
+				if (!stream.write(data, mipSlices[mip]))
+					return false;
+			}
+		}
+	}
+
+	return true;
 }
 
 }
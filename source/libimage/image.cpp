@@ -128,7 +128,9 @@ Image::create(std::uint32_t width, std::uint32_t height, std::uint32_t depth, fo
 		if (format == format_t::BC1RGBUNormBlock ||
 			format == format_t::BC1RGBSRGBBlock ||
 			format == format_t::BC1RGBAUNormBlock ||
-			format == format_t::BC1RGBASRGBBlock)
+			format == format_t::BC1RGBASRGBBlock ||
+			format == format_t::BC4UNormBlock ||
+			format == format_t::BC4SNormBlock)
 		{
 			blockSize = 8;
 		}
@@ -185,27 +187,70 @@ Image::create(const Image& image, format_t format) noexcept
 {
 	assert(format >= format_t::BeginRange && format <= format_t::EndRange);
 
-	if (_format != format && format != format_t::Undefined)
+	if (image.format() != format && format != format_t::Undefined)
 	{
 		if (!this->create(image.width(), image.height(), image.depth(), format, image.mipLevel(), image.layerLevel(), image.mipBase(), image.layerBase(), true))
 			return false;
 
-		if (_format == format_t::R32G32B32SFloat && format == format_t::R8G8B8UInt)
+		auto srcFormat = image.format();
+		auto srcSwizzle = image.swizzle_type();
+		auto dstSwizzle = this->swizzle_type();
+		auto srcValue = image.value_type();
+		auto dstValue = this->value_type();
+
+		auto src = (const std::uint8_t*)image.data();
+		auto dst = (std::uint8_t*)this->data();
+		auto count = image.size() / (image.channel() * image.type_size());
+
+		if (srcFormat == format_t::R32G32B32SFloat && format == format_t::R8G8B8UInt)
 			rgb32f_to_rgb8uint(image, *this);
-		else if (_format == format_t::R32G32B32A32SFloat && format == format_t::R8G8B8A8UInt)
+		else if (srcFormat == format_t::R32G32B32A32SFloat && format == format_t::R8G8B8A8UInt)
 			rgba32f_to_rgba8uint(image, *this);
-		else if (_format == format_t::R64G64B64A64SFloat && format == format_t::R8G8B8UInt)
+		else if (srcFormat == format_t::R64G64B64SFloat && format == format_t::R8G8B8UInt)
 			rgb64f_to_rgb8uint(image, *this);
-		else if (_format == format_t::R64G64B64A64SFloat && format == format_t::R8G8B8A8UInt)
+		else if (srcFormat == format_t::R64G64B64A64SFloat && format == format_t::R8G8B8A8UInt)
 			rgba64f_to_rgba8uint(image, *this);
-		else if (_format == format_t::R32G32B32SFloat && format == format_t::R8G8B8SInt)
+		else if (srcFormat == format_t::R32G32B32SFloat && format == format_t::R8G8B8SInt)
 			rgb32f_to_rgb8sint(image, *this);
-		else if (_format == format_t::R32G32B32A32SFloat && format == format_t::R8G8B8A8SInt)
+		else if (srcFormat == format_t::R32G32B32A32SFloat && format == format_t::R8G8B8A8SInt)
 			rgba32f_to_rgba8sint(image, *this);
-		else if (_format == format_t::R64G64B64A64SFloat && format == format_t::R8G8B8SInt)
+		else if (srcFormat == format_t::R64G64B64SFloat && format == format_t::R8G8B8SInt)
 			rgb64f_to_rgb8sint(image, *this);
-		else if (_format == format_t::R64G64B64A64SFloat && format == format_t::R8G8B8A8SInt)
+		else if (srcFormat == format_t::R64G64B64A64SFloat && format == format_t::R8G8B8A8SInt)
 			rgba64f_to_rgba8sint(image, *this);
+		else if (srcValue == dstValue && image.type_size() == 1 && this->type_size() == 1)
+		{
+			if ((srcSwizzle == swizzle_t::RGB && dstSwizzle == swizzle_t::RGBA) || (srcSwizzle == swizzle_t::BGR && dstSwizzle == swizzle_t::BGRA))
+				rgb8_to_rgba8(src, dst, count);
+			else if ((srcSwizzle == swizzle_t::RGBA && dstSwizzle == swizzle_t::RGB) || (srcSwizzle == swizzle_t::BGRA && dstSwizzle == swizzle_t::BGR))
+				rgba8_to_rgb8(src, dst, count);
+			else if ((srcSwizzle == swizzle_t::RGB && dstSwizzle == swizzle_t::BGR) || (srcSwizzle == swizzle_t::BGR && dstSwizzle == swizzle_t::RGB))
+				rgb8_to_bgr8(src, dst, count);
+			else if ((srcSwizzle == swizzle_t::RGBA && dstSwizzle == swizzle_t::BGRA) || (srcSwizzle == swizzle_t::BGRA && dstSwizzle == swizzle_t::RGBA))
+				rgba8_to_bgra8(src, dst, count);
+			else if ((srcSwizzle == swizzle_t::BGR && dstSwizzle == swizzle_t::RGBA) || (srcSwizzle == swizzle_t::RGB && dstSwizzle == swizzle_t::BGRA))
+				bgr8_to_rgba8(src, dst, count);
+			else
+				return false;
+		}
+		else if (srcValue == value_t::Float && dstValue == value_t::Float && srcSwizzle == dstSwizzle && image.channel() == this->channel())
+		{
+			if (image.type_size() == 4 && this->type_size() == 2)
+				r32f_to_r16f((const float*)src, (std::uint16_t*)dst, count * image.channel());
+			else if (image.type_size() == 2 && this->type_size() == 4)
+				r16f_to_r32f((const std::uint16_t*)src, (float*)dst, count * image.channel());
+			else
+				return false;
+		}
+		else if (srcSwizzle == dstSwizzle && image.channel() == this->channel())
+		{
+			if (srcValue == value_t::UNorm && image.type_size() == 1 && dstValue == value_t::Float && this->type_size() == 4)
+				r8_to_r32f(src, (float*)dst, count * image.channel());
+			else if (srcValue == value_t::Float && image.type_size() == 4 && dstValue == value_t::UNorm && this->type_size() == 1)
+				r32f_to_r8((const float*)src, dst, count * image.channel());
+			else
+				return false;
+		}
 		else
 			return false;
 
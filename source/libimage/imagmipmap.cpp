@@ -0,0 +1,542 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2015.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include <ray/imagmipmap.h>
+#include <ray/imagutil.h>
+#include <ray/mathutil.h>
+#include <ray/thread.h>
+
+#include <cmath>
+#include <vector>
+
+_NAME_BEGIN
+
+namespace image
+{
+	namespace
+	{
+		const std::uint32_t MipBandSize = 32;
+
+		enum class mip_value_t : std::uint8_t
+		{
+			UNorm8,
+			UNorm16,
+			Float16,
+			Float32,
+		};
+
+		struct MipLayout
+		{
+			mip_value_t value;
+			std::uint32_t channel;
+			std::int32_t alpha;
+			bool sRGB;
+			std::uint32_t pixelSize;
+		};
+
+		struct MipLevel
+		{
+			std::uint32_t width;
+			std::uint32_t height;
+			std::vector<float> data;
+		};
+
+		// Source taps of every destination texel along one axis, index is already clamped to the edge.
+		struct MipKernel
+		{
+			std::vector<std::uint32_t> first;
+			std::vector<std::uint32_t> index;
+			std::vector<float> weight;
+		};
+
+		inline float srgbToLinear(float x) noexcept
+		{
+			return x <= 0.04045f ? x / 12.92f : std::pow((x + 0.055f) / 1.055f, 2.4f);
+		}
+
+		inline float linearToSRGB(float x) noexcept
+		{
+			return x <= 0.0031308f ? x * 12.92f : 1.055f * std::pow(x, 1.0f / 2.4f) - 0.055f;
+		}
+
+		inline float saturate(float x) noexcept
+		{
+			return x > 0.0f ? (x < 1.0f ? x : 1.0f) : 0.0f;
+		}
+
+		float bessel0(float x) noexcept
+		{
+			float sum = 1.0f;
+			float term = 1.0f;
+			float halfX = x * 0.5f;
+
+			for (std::uint32_t i = 1; i < 32; i++)
+			{
+				term *= halfX / i;
+				sum += term * term;
+
+				if (term * term < sum * 1e-8f)
+					break;
+			}
+
+			return sum;
+		}
+
+		// Kaiser windowed sinc with the same width and alpha as the NVIDIA texture tools.
+		const float KaiserWidth = 3.0f;
+		const float KaiserAlpha = 4.0f;
+
+		float kaiser(float x) noexcept
+		{
+			x = std::abs(x);
+			if (x >= KaiserWidth)
+				return 0.0f;
+
+			float t = x / KaiserWidth;
+			float window = bessel0(KaiserAlpha * std::sqrt(1.0f - t * t)) / bessel0(KaiserAlpha);
+			float sinc = x < 1e-6f ? 1.0f : std::sin(M_PI * x) / (M_PI * x);
+
+			return sinc * window;
+		}
+
+		void makeKernel(MipKernel& kernel, std::uint32_t srcSize, std::uint32_t dstSize, mip_filter_t filter)
+		{
+			const float scale = (float)srcSize / dstSize;
+			const float radius = filter == mip_filter_t::Box ? scale * 0.5f : scale * KaiserWidth;
+
+			kernel.first.resize(dstSize + 1);
+			kernel.index.clear();
+			kernel.weight.clear();
+
+			for (std::uint32_t i = 0; i < dstSize; i++)
+			{
+				const float center = (i + 0.5f) * scale;
+				const std::int32_t begin = (std::int32_t)std::floor(center - radius);
+				const std::int32_t end = (std::int32_t)std::ceil(center + radius);
+
+				kernel.first[i] = (std::uint32_t)kernel.index.size();
+
+				float total = 0.0f;
+
+				for (std::int32_t j = begin; j < end; j++)
+				{
+					float weight;
+					if (filter == mip_filter_t::Box)
+						weight = std::max(0.0f, std::min<float>(j + 1, center + radius) - std::max<float>(j, center - radius));
+					else
+						weight = kaiser((j + 0.5f - center) / scale);
+
+					if (weight == 0.0f)
+						continue;
+
+					kernel.index.push_back((std::uint32_t)std::min<std::int32_t>(std::max<std::int32_t>(j, 0), srcSize - 1));
+					kernel.weight.push_back(weight);
+
+					total += weight;
+				}
+
+				for (std::size_t k = kernel.first[i]; k < kernel.weight.size(); k++)
+					kernel.weight[k] /= total;
+			}
+
+			kernel.first[dstSize] = (std::uint32_t)kernel.index.size();
+		}
+
+		template<std::uint32_t Channel>
+		void filterRow(const MipKernel& kernel, const float* in, float* out, std::uint32_t width) noexcept
+		{
+			for (std::uint32_t x = 0; x < width; x++, out += Channel)
+			{
+				float sum[Channel] = {};
+
+				for (std::uint32_t k = kernel.first[x]; k < kernel.first[x + 1]; k++)
+				{
+					const float* texel = in + kernel.index[k] * Channel;
+					const float weight = kernel.weight[k];
+
+					for (std::uint32_t c = 0; c < Channel; c++)
+						sum[c] += texel[c] * weight;
+				}
+
+				for (std::uint32_t c = 0; c < Channel; c++)
+					out[c] = sum[c];
+			}
+		}
+
+		void filterRow(const MipKernel& kernel, const float* in, float* out, std::uint32_t width, std::uint32_t channel) noexcept
+		{
+			switch (channel)
+			{
+			case 1: filterRow<1>(kernel, in, out, width); break;
+			case 2: filterRow<2>(kernel, in, out, width); break;
+			case 3: filterRow<3>(kernel, in, out, width); break;
+			default:
+				filterRow<4>(kernel, in, out, width);
+			}
+		}
+
+		bool makeLayout(MipLayout& layout, const Image& image, bool sRGB) noexcept
+		{
+			auto format = image.format();
+			auto value = image.value_type();
+			auto size = image.type_size();
+
+			if ((value == value_t::UNorm || value == value_t::SRGB) && size == 1)
+				layout.value = mip_value_t::UNorm8;
+			else if (value == value_t::UNorm && size == 2)
+				layout.value = mip_value_t::UNorm16;
+			else if (value == value_t::Float && size == 2)
+				layout.value = mip_value_t::Float16;
+			else if (value == value_t::Float && size == 4)
+				layout.value = mip_value_t::Float32;
+			else
+				return false;
+
+			layout.channel = image.channel();
+			layout.pixelSize = layout.channel * size;
+			layout.sRGB = value == value_t::SRGB || (sRGB && layout.value == mip_value_t::UNorm8);
+
+			switch (format)
+			{
+			case format_t::A8UNorm:
+			case format_t::A8SRGB:
+			case format_t::A16UNorm:
+			case format_t::A16SFloat:
+				layout.alpha = 0;
+				layout.sRGB = false;
+				break;
+			case format_t::L8A8UNorm:
+			case format_t::L8A8SRGB:
+			case format_t::L16A16UNorm:
+				layout.alpha = 1;
+				break;
+			default:
+				if (layout.channel == 4)
+					layout.alpha = image.swizzle_type() == swizzle_t::ABGR ? 0 : 3;
+				else
+					layout.alpha = -1;
+			}
+
+			return true;
+		}
+
+		void decodeRow(const MipLayout& layout, const float* srgbTable, const std::uint8_t* src, float* dst, std::size_t count) noexcept
+		{
+			switch (layout.value)
+			{
+			case mip_value_t::UNorm8:
+				for (std::size_t i = 0; i < count; i++)
+				{
+					for (std::uint32_t c = 0; c < layout.channel; c++, src++, dst++)
+						*dst = (layout.sRGB && (std::int32_t)c != layout.alpha) ? srgbTable[*src] : *src / 255.0f;
+				}
+				break;
+			case mip_value_t::UNorm16:
+				for (std::size_t i = 0; i < count * layout.channel; i++)
+					dst[i] = ((const std::uint16_t*)src)[i] / 65535.0f;
+				break;
+			case mip_value_t::Float16:
+				r16f_to_r32f((const std::uint16_t*)src, dst, count * layout.channel);
+				break;
+			case mip_value_t::Float32:
+				std::memcpy(dst, src, count * layout.pixelSize);
+				break;
+			}
+		}
+
+		void encodeRow(const MipLayout& layout, float alphaScale, const float* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				for (std::uint32_t c = 0; c < layout.channel; c++, src++)
+				{
+					float value = *src;
+
+					if ((std::int32_t)c == layout.alpha && alphaScale != 1.0f)
+						value = std::min(value * alphaScale, 1.0f);
+
+					switch (layout.value)
+					{
+					case mip_value_t::UNorm8:
+						value = saturate(value);
+						if (layout.sRGB && (std::int32_t)c != layout.alpha)
+							value = linearToSRGB(value);
+						*dst = (std::uint8_t)(value * 255.0f + 0.5f);
+						dst += 1;
+						break;
+					case mip_value_t::UNorm16:
+						*(std::uint16_t*)dst = (std::uint16_t)(saturate(value) * 65535.0f + 0.5f);
+						dst += 2;
+						break;
+					case mip_value_t::Float16:
+						*(std::uint16_t*)dst = math::fpToHalf(value);
+						dst += 2;
+						break;
+					case mip_value_t::Float32:
+						std::memcpy(dst, &value, sizeof(float));
+						dst += 4;
+						break;
+					}
+				}
+			}
+		}
+
+		std::size_t alphaCoverage(const MipLayout& layout, const float* data, std::size_t count, float cutoff, float scale) noexcept
+		{
+			std::size_t covered = 0;
+
+			for (std::size_t i = 0; i < count; i++)
+			{
+				if (data[i * layout.channel + layout.alpha] * scale > cutoff)
+					covered++;
+			}
+
+			return covered;
+		}
+
+		// Coverage only grows with the scale, so a bisection finds the scale that matches the top level.
+		float alphaCoverageScale(const MipLayout& layout, const float* data, std::size_t count, float cutoff, float coverage) noexcept
+		{
+			float lo = 0.0f;
+			float hi = 4.0f;
+
+			for (std::uint32_t i = 0; i < 12; i++)
+			{
+				float mid = (lo + hi) * 0.5f;
+
+				if ((float)alphaCoverage(layout, data, count, cutoff, mid) / count < coverage)
+					lo = mid;
+				else
+					hi = mid;
+			}
+
+			return hi;
+		}
+	}
+
+	std::uint32_t getMipLevelCount(std::uint32_t width, std::uint32_t height) noexcept
+	{
+		std::uint32_t size = std::max(width, height);
+		std::uint32_t mipLevel = 1;
+
+		while (size > 1)
+		{
+			size >>= 1;
+			mipLevel++;
+		}
+
+		return mipLevel;
+	}
+
+	bool makeMipmap(Image& dst, const Image& src, const MipmapDesc& desc) noexcept
+	{
+		if (&dst == &src || src.empty())
+			return false;
+
+		MipLayout layout;
+		if (!makeLayout(layout, src, desc.sRGB))
+			return false;
+
+		const std::uint32_t width = src.width();
+		const std::uint32_t height = src.height();
+		const std::uint32_t sliceCount = src.depth() * src.layerLevel();
+
+		std::uint32_t mipLevel = getMipLevelCount(width, height);
+		if (desc.mipLevel > 0)
+			mipLevel = std::min(mipLevel, desc.mipLevel);
+
+		const bool preserveCoverage = desc.alphaCutoff > 0.0f && layout.alpha >= 0;
+
+		try
+		{
+			if (!dst.create(width, height, src.depth(), src.format(), mipLevel, src.layerLevel(), 0, src.layerBase(), false))
+				return false;
+
+			ThreadPool& threadPool = desc.threadPool ? *desc.threadPool : *ThreadPool::instance();
+
+			float srgbTable[256];
+			for (std::uint32_t i = 0; i < 256; i++)
+				srgbTable[i] = srgbToLinear(i / 255.0f);
+
+			const std::size_t baseSize = (std::size_t)width * height * layout.pixelSize;
+
+			std::memcpy((std::uint8_t*)dst.data(), src.data(), baseSize * sliceCount);
+
+			MipLevel parent;
+			parent.width = width;
+			parent.height = height;
+
+			std::vector<float> coverages(sliceCount, 0.0f);
+			std::vector<float> alphaScales(sliceCount, 1.0f);
+
+			if (preserveCoverage)
+			{
+				threadPool.parallelFor(sliceCount, [&](std::size_t slice)
+				{
+					std::vector<float> row((std::size_t)width * layout.channel);
+					std::size_t covered = 0;
+
+					for (std::uint32_t y = 0; y < height; y++)
+					{
+						decodeRow(layout, srgbTable, (const std::uint8_t*)src.data() + (slice * height + y) * width * layout.pixelSize, row.data(), width);
+						covered += alphaCoverage(layout, row.data(), width, desc.alphaCutoff, 1.0f);
+					}
+
+					coverages[slice] = (float)covered / ((std::size_t)width * height);
+				});
+			}
+
+			MipKernel kernelX;
+			MipKernel kernelY;
+
+			MipLevel level;
+			std::vector<float> temp;
+
+			std::size_t offset = baseSize * sliceCount;
+
+			for (std::uint32_t mip = 1; mip < mipLevel; mip++)
+			{
+				const std::uint32_t srcWidth = parent.width;
+				const std::uint32_t srcHeight = parent.height;
+				const std::uint32_t dstWidth = std::max(width >> mip, 1U);
+				const std::uint32_t dstHeight = std::max(height >> mip, 1U);
+				const std::uint32_t channel = layout.channel;
+
+				makeKernel(kernelX, srcWidth, dstWidth, desc.filter);
+				makeKernel(kernelY, srcHeight, dstHeight, desc.filter);
+
+				temp.resize((std::size_t)sliceCount * srcHeight * dstWidth * channel);
+
+				level.width = dstWidth;
+				level.height = dstHeight;
+				level.data.resize((std::size_t)sliceCount * dstWidth * dstHeight * channel);
+
+				std::uint32_t srcBands = (srcHeight + MipBandSize - 1) / MipBandSize;
+
+				threadPool.parallelFor(sliceCount * srcBands, [&](std::size_t task)
+				{
+					std::size_t slice = task / srcBands;
+					std::uint32_t y0 = (std::uint32_t)(task % srcBands) * MipBandSize;
+					std::uint32_t y1 = std::min(y0 + MipBandSize, srcHeight);
+
+					std::vector<float> row;
+
+					for (std::uint32_t y = y0; y < y1; y++)
+					{
+						const float* in;
+
+						if (mip == 1)
+						{
+							row.resize((std::size_t)srcWidth * channel);
+							decodeRow(layout, srgbTable, (const std::uint8_t*)src.data() + (slice * srcHeight + y) * srcWidth * layout.pixelSize, row.data(), srcWidth);
+							in = row.data();
+						}
+						else
+						{
+							in = parent.data.data() + (slice * srcHeight + y) * srcWidth * channel;
+						}
+
+						filterRow(kernelX, in, temp.data() + (slice * srcHeight + y) * dstWidth * channel, dstWidth, channel);
+					}
+				});
+
+				std::uint32_t dstBands = (dstHeight + MipBandSize - 1) / MipBandSize;
+
+				threadPool.parallelFor(sliceCount * dstBands, [&](std::size_t task)
+				{
+					std::size_t slice = task / dstBands;
+					std::uint32_t y0 = (std::uint32_t)(task % dstBands) * MipBandSize;
+					std::uint32_t y1 = std::min(y0 + MipBandSize, dstHeight);
+
+					for (std::uint32_t y = y0; y < y1; y++)
+					{
+						float* out = level.data.data() + (slice * dstHeight + y) * dstWidth * channel;
+
+						for (std::size_t i = 0; i < (std::size_t)dstWidth * channel; i++)
+							out[i] = 0.0f;
+
+						for (std::uint32_t k = kernelY.first[y]; k < kernelY.first[y + 1]; k++)
+						{
+							const float* in = temp.data() + (slice * srcHeight + kernelY.index[k]) * dstWidth * channel;
+							const float weight = kernelY.weight[k];
+
+							for (std::size_t i = 0; i < (std::size_t)dstWidth * channel; i++)
+								out[i] += in[i] * weight;
+						}
+					}
+				});
+
+				const std::size_t dstPixels = (std::size_t)dstWidth * dstHeight;
+
+				// The scale is only applied to the stored texels, the next mip is filtered from the unscaled alpha.
+				if (preserveCoverage)
+				{
+					threadPool.parallelFor(sliceCount, [&](std::size_t slice)
+					{
+						alphaScales[slice] = alphaCoverageScale(layout, level.data.data() + slice * dstPixels * channel, dstPixels, desc.alphaCutoff, coverages[slice]);
+					});
+				}
+
+				std::uint8_t* data = (std::uint8_t*)dst.data() + offset;
+
+				threadPool.parallelFor(sliceCount * dstBands, [&](std::size_t task)
+				{
+					std::size_t slice = task / dstBands;
+					std::uint32_t y0 = (std::uint32_t)(task % dstBands) * MipBandSize;
+					std::uint32_t y1 = std::min(y0 + MipBandSize, dstHeight);
+
+					for (std::uint32_t y = y0; y < y1; y++)
+					{
+						std::size_t row = slice * dstHeight + y;
+						encodeRow(layout, alphaScales[slice], level.data.data() + row * dstWidth * channel, data + row * dstWidth * layout.pixelSize, dstWidth);
+					}
+				});
+
+				offset += dstPixels * layout.pixelSize * sliceCount;
+
+				std::swap(parent, level);
+			}
+
+			return true;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	}
+}
+
+_NAME_END
@@ -37,19 +37,983 @@
 #include <ray/imagutil.h>
 #include <ray/math.h>
 
+#include <atomic>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define _IMAGE_SIMD_X86 1
+#	include <immintrin.h>
+#	if defined(_VISUAL_STUDIO_) || defined(_MSC_VER)
+#		include <intrin.h>
+#	endif
+#	if defined(__GNUC__) || defined(__clang__)
+#		define _IMAGE_TARGET_AVX2 __attribute__((target("avx2")))
+#	else
+#		define _IMAGE_TARGET_AVX2
+#	endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#	define _IMAGE_SIMD_NEON 1
+#	include <arm_neon.h>
+#endif
+
 _NAME_BEGIN
 
 namespace image
 {
+	namespace
+	{
+		void rgb8_to_rgba8_scalar(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				dst[i * 4 + 0] = src[i * 3 + 0];
+				dst[i * 4 + 1] = src[i * 3 + 1];
+				dst[i * 4 + 2] = src[i * 3 + 2];
+				dst[i * 4 + 3] = alpha;
+			}
+		}
+
+		void rgba8_to_rgb8_scalar(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				dst[i * 3 + 0] = src[i * 4 + 0];
+				dst[i * 3 + 1] = src[i * 4 + 1];
+				dst[i * 3 + 2] = src[i * 4 + 2];
+			}
+		}
+
+		void rgb8_to_bgr8_scalar(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				std::uint8_t r = src[i * 3 + 0];
+				std::uint8_t g = src[i * 3 + 1];
+				std::uint8_t b = src[i * 3 + 2];
+
+				dst[i * 3 + 0] = b;
+				dst[i * 3 + 1] = g;
+				dst[i * 3 + 2] = r;
+			}
+		}
+
+		void rgba8_to_bgra8_scalar(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				std::uint8_t r = src[i * 4 + 0];
+				std::uint8_t g = src[i * 4 + 1];
+				std::uint8_t b = src[i * 4 + 2];
+				std::uint8_t a = src[i * 4 + 3];
+
+				dst[i * 4 + 0] = b;
+				dst[i * 4 + 1] = g;
+				dst[i * 4 + 2] = r;
+				dst[i * 4 + 3] = a;
+			}
+		}
+
+		void bgr8_to_rgba8_scalar(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				dst[i * 4 + 0] = src[i * 3 + 2];
+				dst[i * 4 + 1] = src[i * 3 + 1];
+				dst[i * 4 + 2] = src[i * 3 + 0];
+				dst[i * 4 + 3] = alpha;
+			}
+		}
+
+		void r8_to_r32f_scalar(const std::uint8_t* src, float* dst, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+				dst[i] = src[i] / 255.0f;
+		}
+
+		// Same rounding as r32f_to_r8uint has always had, truncated to 16 bits and clamped to 255.
+		void r32f_to_r8_scalar(const float* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+				dst[i] = (std::uint8_t)math::clamp<std::uint16_t>((std::uint16_t)(src[i] * 255), 0, 255);
+		}
+
+		// Same as the element-wise cast of Vector3t<std::uint8_t>(v * 255.0f) in rgb(a)32f_to_rgb(a)8uint.
+		void r32f_to_r8cast_scalar(const float* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+				dst[i] = (std::uint8_t)(src[i] * 255.0f);
+		}
+
+		void r32f_to_r16f_scalar(const float* src, std::uint16_t* dst, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+				dst[i] = math::fpToHalf(src[i]);
+		}
+
+		void r16f_to_r32f_scalar(const std::uint16_t* src, float* dst, std::size_t count) noexcept
+		{
+			for (std::size_t i = 0; i < count; i++)
+				dst[i] = math::fpFromHalf(src[i]);
+		}
+
+#if defined(_IMAGE_SIMD_X86)
+		inline void store_u32(std::uint8_t* dst, __m128i v) noexcept
+		{
+			std::int32_t value = _mm_cvtsi128_si32(v);
+			std::memcpy(dst, &value, sizeof(value));
+		}
+
+		// Spreads the 4 packed 24 bit pixels at the start of v to the low 3 bytes of each 32 bit lane.
+		inline __m128i expand_rgb8_sse2(__m128i v) noexcept
+		{
+			__m128i p01 = _mm_unpacklo_epi32(v, _mm_srli_si128(v, 3));
+			__m128i p23 = _mm_unpacklo_epi32(_mm_srli_si128(v, 6), _mm_srli_si128(v, 9));
+			return _mm_and_si128(_mm_unpacklo_epi64(p01, p23), _mm_set1_epi32(0x00FFFFFF));
+		}
+
+		// Packs the low 3 bytes of each 32 bit lane into 12 bytes, the upper byte of every lane has to be zero.
+		inline void store_rgb8_sse2(std::uint8_t* dst, __m128i v) noexcept
+		{
+			__m128i t = _mm_or_si128(
+				_mm_and_si128(v, _mm_set_epi32(0, -1, 0, -1)),
+				_mm_and_si128(_mm_srli_epi64(v, 8), _mm_set_epi32(0x0000FFFF, (int)0xFF000000, 0x0000FFFF, (int)0xFF000000)));
+
+			__m128i r = _mm_or_si128(
+				_mm_and_si128(t, _mm_set_epi32(0, 0, 0x0000FFFF, -1)),
+				_mm_and_si128(_mm_srli_si128(t, 2), _mm_set_epi32(0, -1, (int)0xFFFF0000, 0)));
+
+			_mm_storel_epi64((__m128i*)dst, r);
+			store_u32(dst + 8, _mm_srli_si128(r, 8));
+		}
+
+		inline __m128i swap_rb_sse2(__m128i v) noexcept
+		{
+			__m128i ga = _mm_and_si128(v, _mm_set1_epi32((int)0xFF00FF00));
+			__m128i r = _mm_and_si128(_mm_srli_epi32(v, 16), _mm_set1_epi32(0x000000FF));
+			__m128i b = _mm_and_si128(_mm_slli_epi32(v, 16), _mm_set1_epi32(0x00FF0000));
+			return _mm_or_si128(ga, _mm_or_si128(r, b));
+		}
+
+		void rgb8_to_rgba8_sse2(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) noexcept
+		{
+			__m128i a = _mm_set1_epi32((int)((std::uint32_t)alpha << 24));
+
+			std::size_t i = 0;
+			for (; i * 3 + 16 <= count * 3; i += 4)
+			{
+				__m128i v = expand_rgb8_sse2(_mm_loadu_si128((const __m128i*)(src + i * 3)));
+				_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(v, a));
+			}
+
+			rgb8_to_rgba8_scalar(src + i * 3, dst + i * 4, count - i, alpha);
+		}
+
+		void rgba8_to_rgb8_sse2(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)(src + i * 4));
+				store_rgb8_sse2(dst + i * 3, _mm_and_si128(v, _mm_set1_epi32(0x00FFFFFF)));
+			}
+
+			rgba8_to_rgb8_scalar(src + i * 4, dst + i * 3, count - i);
+		}
+
+		void rgb8_to_bgr8_sse2(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			std::size_t i = 0;
+			for (; i * 3 + 16 <= count * 3; i += 4)
+			{
+				__m128i v = expand_rgb8_sse2(_mm_loadu_si128((const __m128i*)(src + i * 3)));
+				store_rgb8_sse2(dst + i * 3, swap_rb_sse2(v));
+			}
+
+			rgb8_to_bgr8_scalar(src + i * 3, dst + i * 3, count - i);
+		}
+
+		void rgba8_to_bgra8_sse2(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)(src + i * 4));
+				_mm_storeu_si128((__m128i*)(dst + i * 4), swap_rb_sse2(v));
+			}
+
+			rgba8_to_bgra8_scalar(src + i * 4, dst + i * 4, count - i);
+		}
+
+		void bgr8_to_rgba8_sse2(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) noexcept
+		{
+			__m128i a = _mm_set1_epi32((int)((std::uint32_t)alpha << 24));
+
+			std::size_t i = 0;
+			for (; i * 3 + 16 <= count * 3; i += 4)
+			{
+				__m128i v = expand_rgb8_sse2(_mm_loadu_si128((const __m128i*)(src + i * 3)));
+				_mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(swap_rb_sse2(v), a));
+			}
+
+			bgr8_to_rgba8_scalar(src + i * 3, dst + i * 4, count - i, alpha);
+		}
+
+		void r8_to_r32f_sse2(const std::uint8_t* src, float* dst, std::size_t count) noexcept
+		{
+			__m128i zero = _mm_setzero_si128();
+			__m128 scale = _mm_set1_ps(255.0f);
+
+			std::size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+				__m128i lo = _mm_unpacklo_epi8(v, zero);
+				__m128i hi = _mm_unpackhi_epi8(v, zero);
+
+				_mm_storeu_ps(dst + i + 0, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+				_mm_storeu_ps(dst + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+				_mm_storeu_ps(dst + i + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+				_mm_storeu_ps(dst + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+			}
+
+			r8_to_r32f_scalar(src + i, dst + i, count - i);
+		}
+
+		// cvttps gives the same 32 bit integer as the scalar cast, the low 16 bits are then clamped to 255.
+		inline __m128i r32f_to_r16_sse2(const float* src, __m128 scale) noexcept
+		{
+			__m128i mask = _mm_set1_epi32(0xFFFF);
+			__m128i a = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + 0), scale)), mask);
+			__m128i b = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + 4), scale)), mask);
+			return _mm_min_epi16(_mm_packs_epi32(a, b), _mm_set1_epi16(255));
+		}
+
+		void r32f_to_r8_sse2(const float* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			__m128 scale = _mm_set1_ps(255.0f);
+
+			std::size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i lo = r32f_to_r16_sse2(src + i + 0, scale);
+				__m128i hi = r32f_to_r16_sse2(src + i + 8, scale);
+				_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+			}
+
+			r32f_to_r8_scalar(src + i, dst + i, count - i);
+		}
+
+		inline __m128i r32f_to_r8cast_sse2(const float* src, __m128 scale) noexcept
+		{
+			__m128i mask = _mm_set1_epi32(0xFF);
+			__m128i a = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + 0), scale)), mask);
+			__m128i b = _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src + 4), scale)), mask);
+			return _mm_packs_epi32(a, b);
+		}
+
+		void r32f_to_r8cast_sse2(const float* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			__m128 scale = _mm_set1_ps(255.0f);
+
+			std::size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i lo = r32f_to_r8cast_sse2(src + i + 0, scale);
+				__m128i hi = r32f_to_r8cast_sse2(src + i + 8, scale);
+				_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+			}
+
+			r32f_to_r8cast_scalar(src + i, dst + i, count - i);
+		}
+
+		// Round to nearest even like math::fpToHalf, subnormals are rounded by a float add of a magic value
+		// that moves the 10 mantissa bits to the bottom of the float.
+		inline __m128i r32f_to_r16f_sse2(__m128 value) noexcept
+		{
+			__m128i x = _mm_castps_si128(value);
+			__m128i sign = _mm_and_si128(x, _mm_set1_epi32((int)0x80000000));
+			__m128i f = _mm_xor_si128(x, sign);
+
+			__m128i infnan = _mm_cmpgt_epi32(f, _mm_set1_epi32(0x477FFFFF));
+			__m128i nan = _mm_cmpgt_epi32(f, _mm_set1_epi32(0x7F800000));
+			__m128i special = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(nan, _mm_set1_epi32(0x0200)));
+
+			__m128i subnormal = _mm_cmplt_epi32(f, _mm_set1_epi32(113 << 23));
+			__m128i magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+			__m128i tiny = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(f), _mm_castsi128_ps(magic))), magic);
+
+			__m128i odd = _mm_and_si128(_mm_srli_epi32(f, 13), _mm_set1_epi32(1));
+			__m128i normal = _mm_add_epi32(f, _mm_set1_epi32((int)(((std::uint32_t)(15 - 127) << 23) + 0xFFF)));
+			normal = _mm_srli_epi32(_mm_add_epi32(normal, odd), 13);
+
+			__m128i half = _mm_or_si128(_mm_and_si128(subnormal, tiny), _mm_andnot_si128(subnormal, normal));
+			half = _mm_or_si128(_mm_and_si128(infnan, special), _mm_andnot_si128(infnan, half));
+			half = _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+
+			return _mm_srai_epi32(_mm_slli_epi32(half, 16), 16);
+		}
+
+		void r32f_to_r16f_sse2(const float* src, std::uint16_t* dst, std::size_t count) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m128i lo = r32f_to_r16f_sse2(_mm_loadu_ps(src + i + 0));
+				__m128i hi = r32f_to_r16f_sse2(_mm_loadu_ps(src + i + 4));
+				_mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(lo, hi));
+			}
+
+			r32f_to_r16f_scalar(src + i, dst + i, count - i);
+		}
+
+		inline __m128 r16f_to_r32f_sse2(__m128i h) noexcept
+		{
+			__m128i exponentMask = _mm_set1_epi32(0x7C00 << 13);
+
+			__m128i o = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7FFF)), 13);
+			__m128i exponent = _mm_and_si128(o, exponentMask);
+			o = _mm_add_epi32(o, _mm_set1_epi32((127 - 15) << 23));
+
+			__m128i infnan = _mm_cmpeq_epi32(exponent, exponentMask);
+			o = _mm_add_epi32(o, _mm_and_si128(infnan, _mm_set1_epi32((128 - 16) << 23)));
+
+			__m128i zero = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+			__m128 subnormal = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o, _mm_set1_epi32(1 << 23))), _mm_castsi128_ps(_mm_set1_epi32(113 << 23)));
+			o = _mm_or_si128(_mm_and_si128(zero, _mm_castps_si128(subnormal)), _mm_andnot_si128(zero, o));
+
+			return _mm_castsi128_ps(_mm_or_si128(o, _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16)));
+		}
+
+		void r16f_to_r32f_sse2(const std::uint16_t* src, float* dst, std::size_t count) noexcept
+		{
+			__m128i zero = _mm_setzero_si128();
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+				_mm_storeu_ps(dst + i + 0, r16f_to_r32f_sse2(_mm_unpacklo_epi16(v, zero)));
+				_mm_storeu_ps(dst + i + 4, r16f_to_r32f_sse2(_mm_unpackhi_epi16(v, zero)));
+			}
+
+			r16f_to_r32f_scalar(src + i, dst + i, count - i);
+		}
+
+		_IMAGE_TARGET_AVX2 inline __m256i load_rgb8_avx2(const std::uint8_t* src) noexcept
+		{
+			__m128i lo = _mm_loadu_si128((const __m128i*)(src + 0));
+			__m128i hi = _mm_loadu_si128((const __m128i*)(src + 12));
+			return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+		}
+
+		_IMAGE_TARGET_AVX2 inline void store_rgb8_avx2(std::uint8_t* dst, __m256i v) noexcept
+		{
+			__m128i lo = _mm256_castsi256_si128(v);
+			__m128i hi = _mm256_extracti128_si256(v, 1);
+
+			_mm_storel_epi64((__m128i*)(dst + 0), lo);
+			store_u32(dst + 8, _mm_srli_si128(lo, 8));
+			_mm_storel_epi64((__m128i*)(dst + 12), hi);
+			store_u32(dst + 20, _mm_srli_si128(hi, 8));
+		}
+
+		// The AVX2 kernels below finish their tails with the SSE2 ones, so they clear the upper halves first
+		// to avoid the AVX to SSE transition penalty.
+		_IMAGE_TARGET_AVX2 void rgb8_to_rgba8_avx2(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) noexcept
+		{
+			__m256i shuffle = _mm256_setr_epi8(
+				0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+				0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+			__m256i a = _mm256_set1_epi32((int)((std::uint32_t)alpha << 24));
+
+			std::size_t i = 0;
+			for (; i * 3 + 28 <= count * 3; i += 8)
+			{
+				__m256i v = _mm256_shuffle_epi8(load_rgb8_avx2(src + i * 3), shuffle);
+				_mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_or_si256(v, a));
+			}
+
+			_mm256_zeroupper();
+
+			rgb8_to_rgba8_sse2(src + i * 3, dst + i * 4, count - i, alpha);
+		}
+
+		_IMAGE_TARGET_AVX2 void rgba8_to_rgb8_avx2(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			__m256i shuffle = _mm256_setr_epi8(
+				0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+				0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256i v = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+				store_rgb8_avx2(dst + i * 3, _mm256_shuffle_epi8(v, shuffle));
+			}
+
+			_mm256_zeroupper();
+
+			rgba8_to_rgb8_sse2(src + i * 4, dst + i * 3, count - i);
+		}
+
+		_IMAGE_TARGET_AVX2 void rgb8_to_bgr8_avx2(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			__m256i shuffle = _mm256_setr_epi8(
+				2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, -1, -1, -1, -1,
+				2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, -1, -1, -1, -1);
+
+			std::size_t i = 0;
+			for (; i * 3 + 28 <= count * 3; i += 8)
+				store_rgb8_avx2(dst + i * 3, _mm256_shuffle_epi8(load_rgb8_avx2(src + i * 3), shuffle));
+
+			_mm256_zeroupper();
+
+			rgb8_to_bgr8_sse2(src + i * 3, dst + i * 3, count - i);
+		}
+
+		_IMAGE_TARGET_AVX2 void rgba8_to_bgra8_avx2(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			__m256i shuffle = _mm256_setr_epi8(
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+				2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256i v = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+				_mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_shuffle_epi8(v, shuffle));
+			}
+
+			_mm256_zeroupper();
+
+			rgba8_to_bgra8_sse2(src + i * 4, dst + i * 4, count - i);
+		}
+
+		_IMAGE_TARGET_AVX2 void bgr8_to_rgba8_avx2(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) noexcept
+		{
+			__m256i shuffle = _mm256_setr_epi8(
+				2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1,
+				2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+			__m256i a = _mm256_set1_epi32((int)((std::uint32_t)alpha << 24));
+
+			std::size_t i = 0;
+			for (; i * 3 + 28 <= count * 3; i += 8)
+			{
+				__m256i v = _mm256_shuffle_epi8(load_rgb8_avx2(src + i * 3), shuffle);
+				_mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_or_si256(v, a));
+			}
+
+			_mm256_zeroupper();
+
+			bgr8_to_rgba8_sse2(src + i * 3, dst + i * 4, count - i, alpha);
+		}
+
+		_IMAGE_TARGET_AVX2 void r8_to_r32f_avx2(const std::uint8_t* src, float* dst, std::size_t count) noexcept
+		{
+			__m256 scale = _mm256_set1_ps(255.0f);
+
+			std::size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				__m256i lo = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i + 0)));
+				__m256i hi = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + i + 8)));
+
+				_mm256_storeu_ps(dst + i + 0, _mm256_div_ps(_mm256_cvtepi32_ps(lo), scale));
+				_mm256_storeu_ps(dst + i + 8, _mm256_div_ps(_mm256_cvtepi32_ps(hi), scale));
+			}
+
+			_mm256_zeroupper();
+
+			r8_to_r32f_sse2(src + i, dst + i, count - i);
+		}
+
+		_IMAGE_TARGET_AVX2 void r32f_to_r8_avx2(const float* src, std::uint8_t* dst, std::size_t count, bool cast) noexcept
+		{
+			__m256 scale = _mm256_set1_ps(255.0f);
+			__m256i mask = _mm256_set1_epi32(cast ? 0xFF : 0xFFFF);
+			__m256i limit = _mm256_set1_epi16(cast ? 0x7FFF : 255);
+			__m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+			std::size_t i = 0;
+			for (; i + 32 <= count; i += 32)
+			{
+				__m256i a = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + i + 0), scale)), mask);
+				__m256i b = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + i + 8), scale)), mask);
+				__m256i c = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + i + 16), scale)), mask);
+				__m256i d = _mm256_and_si256(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_loadu_ps(src + i + 24), scale)), mask);
+
+				__m256i ab = _mm256_min_epi16(_mm256_packs_epi32(a, b), limit);
+				__m256i cd = _mm256_min_epi16(_mm256_packs_epi32(c, d), limit);
+
+				__m256i v = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(ab, cd), order);
+				_mm256_storeu_si256((__m256i*)(dst + i), v);
+			}
+
+			_mm256_zeroupper();
+
+			if (cast)
+				r32f_to_r8cast_sse2(src + i, dst + i, count - i);
+			else
+				r32f_to_r8_sse2(src + i, dst + i, count - i);
+		}
+
+		_IMAGE_TARGET_AVX2 void r32f_to_r8_avx2(const float* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			r32f_to_r8_avx2(src, dst, count, false);
+		}
+
+		_IMAGE_TARGET_AVX2 void r32f_to_r8cast_avx2(const float* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			r32f_to_r8_avx2(src, dst, count, true);
+		}
+
+		_IMAGE_TARGET_AVX2 inline __m256i r32f_to_r16f_avx2(__m256 value) noexcept
+		{
+			__m256i x = _mm256_castps_si256(value);
+			__m256i sign = _mm256_and_si256(x, _mm256_set1_epi32((int)0x80000000));
+			__m256i f = _mm256_xor_si256(x, sign);
+
+			__m256i infnan = _mm256_cmpgt_epi32(f, _mm256_set1_epi32(0x477FFFFF));
+			__m256i nan = _mm256_cmpgt_epi32(f, _mm256_set1_epi32(0x7F800000));
+			__m256i special = _mm256_or_si256(_mm256_set1_epi32(0x7C00), _mm256_and_si256(nan, _mm256_set1_epi32(0x0200)));
+
+			__m256i subnormal = _mm256_cmpgt_epi32(_mm256_set1_epi32(113 << 23), f);
+			__m256i magic = _mm256_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+			__m256i tiny = _mm256_sub_epi32(_mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(f), _mm256_castsi256_ps(magic))), magic);
+
+			__m256i odd = _mm256_and_si256(_mm256_srli_epi32(f, 13), _mm256_set1_epi32(1));
+			__m256i normal = _mm256_add_epi32(f, _mm256_set1_epi32((int)(((std::uint32_t)(15 - 127) << 23) + 0xFFF)));
+			normal = _mm256_srli_epi32(_mm256_add_epi32(normal, odd), 13);
+
+			__m256i half = _mm256_blendv_epi8(normal, tiny, subnormal);
+			half = _mm256_blendv_epi8(half, special, infnan);
+			half = _mm256_or_si256(half, _mm256_srli_epi32(sign, 16));
+
+			return _mm256_srai_epi32(_mm256_slli_epi32(half, 16), 16);
+		}
+
+		_IMAGE_TARGET_AVX2 void r32f_to_r16f_avx2(const float* src, std::uint16_t* dst, std::size_t count) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				__m256i lo = r32f_to_r16f_avx2(_mm256_loadu_ps(src + i + 0));
+				__m256i hi = r32f_to_r16f_avx2(_mm256_loadu_ps(src + i + 8));
+				__m256i v = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+				_mm256_storeu_si256((__m256i*)(dst + i), v);
+			}
+
+			_mm256_zeroupper();
+
+			r32f_to_r16f_sse2(src + i, dst + i, count - i);
+		}
+
+		_IMAGE_TARGET_AVX2 void r16f_to_r32f_avx2(const std::uint16_t* src, float* dst, std::size_t count) noexcept
+		{
+			__m256i exponentMask = _mm256_set1_epi32(0x7C00 << 13);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + i)));
+
+				__m256i o = _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(0x7FFF)), 13);
+				__m256i exponent = _mm256_and_si256(o, exponentMask);
+				o = _mm256_add_epi32(o, _mm256_set1_epi32((127 - 15) << 23));
+
+				__m256i infnan = _mm256_cmpeq_epi32(exponent, exponentMask);
+				o = _mm256_add_epi32(o, _mm256_and_si256(infnan, _mm256_set1_epi32((128 - 16) << 23)));
+
+				__m256i zero = _mm256_cmpeq_epi32(exponent, _mm256_setzero_si256());
+				__m256 subnormal = _mm256_sub_ps(_mm256_castsi256_ps(_mm256_add_epi32(o, _mm256_set1_epi32(1 << 23))), _mm256_castsi256_ps(_mm256_set1_epi32(113 << 23)));
+				o = _mm256_blendv_epi8(o, _mm256_castps_si256(subnormal), zero);
+
+				o = _mm256_or_si256(o, _mm256_slli_epi32(_mm256_and_si256(h, _mm256_set1_epi32(0x8000)), 16));
+				_mm256_storeu_ps(dst + i, _mm256_castsi256_ps(o));
+			}
+
+			_mm256_zeroupper();
+
+			r16f_to_r32f_sse2(src + i, dst + i, count - i);
+		}
+
+		bool cpu_support_avx2() noexcept
+		{
+#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+				return false;
+
+			__cpuid(info, 1);
+			if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)))
+				return false;
+
+			if ((_xgetbv(0) & 0x6) != 0x6)
+				return false;
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) ? true : false;
+#else
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") ? true : false;
+#endif
+		}
+#endif
+
+#if defined(_IMAGE_SIMD_NEON)
+		void rgb8_to_rgba8_neon(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				uint8x16x3_t v = vld3q_u8(src + i * 3);
+				uint8x16x4_t o;
+				o.val[0] = v.val[0];
+				o.val[1] = v.val[1];
+				o.val[2] = v.val[2];
+				o.val[3] = vdupq_n_u8(alpha);
+				vst4q_u8(dst + i * 4, o);
+			}
+
+			rgb8_to_rgba8_scalar(src + i * 3, dst + i * 4, count - i, alpha);
+		}
+
+		void rgba8_to_rgb8_neon(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				uint8x16x4_t v = vld4q_u8(src + i * 4);
+				uint8x16x3_t o;
+				o.val[0] = v.val[0];
+				o.val[1] = v.val[1];
+				o.val[2] = v.val[2];
+				vst3q_u8(dst + i * 3, o);
+			}
+
+			rgba8_to_rgb8_scalar(src + i * 4, dst + i * 3, count - i);
+		}
+
+		void rgb8_to_bgr8_neon(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				uint8x16x3_t v = vld3q_u8(src + i * 3);
+				uint8x16_t r = v.val[0];
+				v.val[0] = v.val[2];
+				v.val[2] = r;
+				vst3q_u8(dst + i * 3, v);
+			}
+
+			rgb8_to_bgr8_scalar(src + i * 3, dst + i * 3, count - i);
+		}
+
+		void rgba8_to_bgra8_neon(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				uint8x16x4_t v = vld4q_u8(src + i * 4);
+				uint8x16_t r = v.val[0];
+				v.val[0] = v.val[2];
+				v.val[2] = r;
+				vst4q_u8(dst + i * 4, v);
+			}
+
+			rgba8_to_bgra8_scalar(src + i * 4, dst + i * 4, count - i);
+		}
+
+		void bgr8_to_rgba8_neon(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) noexcept
+		{
+			std::size_t i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				uint8x16x3_t v = vld3q_u8(src + i * 3);
+				uint8x16x4_t o;
+				o.val[0] = v.val[2];
+				o.val[1] = v.val[1];
+				o.val[2] = v.val[0];
+				o.val[3] = vdupq_n_u8(alpha);
+				vst4q_u8(dst + i * 4, o);
+			}
+
+			bgr8_to_rgba8_scalar(src + i * 3, dst + i * 4, count - i, alpha);
+		}
+
+		void r8_to_r32f_neon(const std::uint8_t* src, float* dst, std::size_t count) noexcept
+		{
+			std::size_t i = 0;
+#if defined(__aarch64__)
+			float32x4_t scale = vdupq_n_f32(255.0f);
+
+			for (; i + 8 <= count; i += 8)
+			{
+				uint16x8_t v = vmovl_u8(vld1_u8(src + i));
+				vst1q_f32(dst + i + 0, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v))), scale));
+				vst1q_f32(dst + i + 4, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v))), scale));
+			}
+#endif
+			r8_to_r32f_scalar(src + i, dst + i, count - i);
+		}
+
+		// vcvtq_s32_f32 saturates where cvttss2si returns 0x80000000, both agree for |x * 255| < 2^31.
+		void r32f_to_r8_neon(const float* src, std::uint8_t* dst, std::size_t count, bool cast) noexcept
+		{
+			float32x4_t scale = vdupq_n_f32(255.0f);
+			uint32x4_t mask = vdupq_n_u32(cast ? 0xFF : 0xFFFF);
+			uint32x4_t limit = vdupq_n_u32(cast ? 0xFF : 255);
+
+			std::size_t i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				uint32x4_t a = vandq_u32(vreinterpretq_u32_s32(vcvtq_s32_f32(vmulq_f32(vld1q_f32(src + i + 0), scale))), mask);
+				uint32x4_t b = vandq_u32(vreinterpretq_u32_s32(vcvtq_s32_f32(vmulq_f32(vld1q_f32(src + i + 4), scale))), mask);
+
+				uint16x8_t v = vcombine_u16(vmovn_u32(vminq_u32(a, limit)), vmovn_u32(vminq_u32(b, limit)));
+				vst1_u8(dst + i, vmovn_u16(v));
+			}
+
+			if (cast)
+				r32f_to_r8cast_scalar(src + i, dst + i, count - i);
+			else
+				r32f_to_r8_scalar(src + i, dst + i, count - i);
+		}
+
+		void r32f_to_r8_neon(const float* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			r32f_to_r8_neon(src, dst, count, false);
+		}
+
+		void r32f_to_r8cast_neon(const float* src, std::uint8_t* dst, std::size_t count) noexcept
+		{
+			r32f_to_r8_neon(src, dst, count, true);
+		}
+
+		void r32f_to_r16f_neon(const float* src, std::uint16_t* dst, std::size_t count) noexcept
+		{
+			uint32x4_t magic = vdupq_n_u32(((127 - 15) + (23 - 10) + 1) << 23);
+
+			std::size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				uint32x4_t x = vreinterpretq_u32_f32(vld1q_f32(src + i));
+				uint32x4_t sign = vandq_u32(x, vdupq_n_u32(0x80000000));
+				uint32x4_t f = veorq_u32(x, sign);
+
+				uint32x4_t infnan = vcgtq_u32(f, vdupq_n_u32(0x477FFFFF));
+				uint32x4_t nan = vcgtq_u32(f, vdupq_n_u32(0x7F800000));
+				uint32x4_t special = vorrq_u32(vdupq_n_u32(0x7C00), vandq_u32(nan, vdupq_n_u32(0x0200)));
+
+				uint32x4_t subnormal = vcltq_u32(f, vdupq_n_u32(113 << 23));
+				uint32x4_t tiny = vsubq_u32(vreinterpretq_u32_f32(vaddq_f32(vreinterpretq_f32_u32(f), vreinterpretq_f32_u32(magic))), magic);
+
+				uint32x4_t odd = vandq_u32(vshrq_n_u32(f, 13), vdupq_n_u32(1));
+				uint32x4_t normal = vaddq_u32(f, vdupq_n_u32((std::uint32_t)((15 - 127) << 23) + 0xFFF));
+				normal = vshrq_n_u32(vaddq_u32(normal, odd), 13);
+
+				uint32x4_t half = vbslq_u32(subnormal, tiny, normal);
+				half = vbslq_u32(infnan, special, half);
+				half = vorrq_u32(half, vshrq_n_u32(sign, 16));
+
+				vst1_u16(dst + i, vmovn_u32(half));
+			}
+
+			r32f_to_r16f_scalar(src + i, dst + i, count - i);
+		}
+
+		void r16f_to_r32f_neon(const std::uint16_t* src, float* dst, std::size_t count) noexcept
+		{
+			uint32x4_t exponentMask = vdupq_n_u32(0x7C00 << 13);
+
+			std::size_t i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				uint32x4_t h = vmovl_u16(vld1_u16(src + i));
+
+				uint32x4_t o = vshlq_n_u32(vandq_u32(h, vdupq_n_u32(0x7FFF)), 13);
+				uint32x4_t exponent = vandq_u32(o, exponentMask);
+				o = vaddq_u32(o, vdupq_n_u32((127 - 15) << 23));
+
+				uint32x4_t infnan = vceqq_u32(exponent, exponentMask);
+				o = vaddq_u32(o, vandq_u32(infnan, vdupq_n_u32((128 - 16) << 23)));
+
+				uint32x4_t zero = vceqq_u32(exponent, vdupq_n_u32(0));
+				float32x4_t subnormal = vsubq_f32(vreinterpretq_f32_u32(vaddq_u32(o, vdupq_n_u32(1 << 23))), vreinterpretq_f32_u32(vdupq_n_u32(113 << 23)));
+				o = vbslq_u32(zero, vreinterpretq_u32_f32(subnormal), o);
+
+				o = vorrq_u32(o, vshlq_n_u32(vandq_u32(h, vdupq_n_u32(0x8000)), 16));
+				vst1q_f32(dst + i, vreinterpretq_f32_u32(o));
+			}
+
+			r16f_to_r32f_scalar(src + i, dst + i, count - i);
+		}
+#endif
+
+		struct converters
+		{
+			void(*rgb8_to_rgba8)(const std::uint8_t*, std::uint8_t*, std::size_t, std::uint8_t) noexcept;
+			void(*rgba8_to_rgb8)(const std::uint8_t*, std::uint8_t*, std::size_t) noexcept;
+			void(*rgb8_to_bgr8)(const std::uint8_t*, std::uint8_t*, std::size_t) noexcept;
+			void(*rgba8_to_bgra8)(const std::uint8_t*, std::uint8_t*, std::size_t) noexcept;
+			void(*bgr8_to_rgba8)(const std::uint8_t*, std::uint8_t*, std::size_t, std::uint8_t) noexcept;
+			void(*r8_to_r32f)(const std::uint8_t*, float*, std::size_t) noexcept;
+			void(*r32f_to_r8)(const float*, std::uint8_t*, std::size_t) noexcept;
+			void(*r32f_to_r8cast)(const float*, std::uint8_t*, std::size_t) noexcept;
+			void(*r32f_to_r16f)(const float*, std::uint16_t*, std::size_t) noexcept;
+			void(*r16f_to_r32f)(const std::uint16_t*, float*, std::size_t) noexcept;
+		};
+
+		const converters scalarConverters =
+		{
+			rgb8_to_rgba8_scalar, rgba8_to_rgb8_scalar, rgb8_to_bgr8_scalar, rgba8_to_bgra8_scalar, bgr8_to_rgba8_scalar,
+			r8_to_r32f_scalar, r32f_to_r8_scalar, r32f_to_r8cast_scalar, r32f_to_r16f_scalar, r16f_to_r32f_scalar
+		};
+
+#if defined(_IMAGE_SIMD_X86)
+		const converters sse2Converters =
+		{
+			rgb8_to_rgba8_sse2, rgba8_to_rgb8_sse2, rgb8_to_bgr8_sse2, rgba8_to_bgra8_sse2, bgr8_to_rgba8_sse2,
+			r8_to_r32f_sse2, r32f_to_r8_sse2, r32f_to_r8cast_sse2, r32f_to_r16f_sse2, r16f_to_r32f_sse2
+		};
+
+		const converters avx2Converters =
+		{
+			rgb8_to_rgba8_avx2, rgba8_to_rgb8_avx2, rgb8_to_bgr8_avx2, rgba8_to_bgra8_avx2, bgr8_to_rgba8_avx2,
+			r8_to_r32f_avx2, r32f_to_r8_avx2, r32f_to_r8cast_avx2, r32f_to_r16f_avx2, r16f_to_r32f_avx2
+		};
+#endif
+
+#if defined(_IMAGE_SIMD_NEON)
+		const converters neonConverters =
+		{
+			rgb8_to_rgba8_neon, rgba8_to_rgb8_neon, rgb8_to_bgr8_neon, rgba8_to_bgra8_neon, bgr8_to_rgba8_neon,
+			r8_to_r32f_neon, r32f_to_r8_neon, r32f_to_r8cast_neon, r32f_to_r16f_neon, r16f_to_r32f_neon
+		};
+#endif
+
+		const converters* select_converters(simd_t level) noexcept
+		{
+			switch (level)
+			{
+#if defined(_IMAGE_SIMD_X86)
+			case simd_t::SSE2: return &sse2Converters;
+			case simd_t::AVX2: return &avx2Converters;
+#endif
+#if defined(_IMAGE_SIMD_NEON)
+			case simd_t::NEON: return &neonConverters;
+#endif
+			default:
+				return &scalarConverters;
+			}
+		}
+
+		std::atomic<simd_t>& simd_current() noexcept
+		{
+			static std::atomic<simd_t> level(simd_support());
+			return level;
+		}
+
+		const converters& dispatch() noexcept
+		{
+			return *select_converters(simd_current().load(std::memory_order_relaxed));
+		}
+	}
+
+	simd_t simd_support() noexcept
+	{
+#if defined(_IMAGE_SIMD_X86)
+		static const simd_t support = cpu_support_avx2() ? simd_t::AVX2 : simd_t::SSE2;
+		return support;
+#elif defined(_IMAGE_SIMD_NEON)
+		return simd_t::NEON;
+#else
+		return simd_t::None;
+#endif
+	}
+
+	simd_t get_simd_level() noexcept
+	{
+		return simd_current();
+	}
+
+	void set_simd_level(simd_t level) noexcept
+	{
+		auto support = simd_support();
+
+		bool supported = false;
+		switch (level)
+		{
+		case simd_t::None: supported = true; break;
+		case simd_t::SSE2: supported = support == simd_t::SSE2 || support == simd_t::AVX2; break;
+		case simd_t::AVX2: supported = support == simd_t::AVX2; break;
+		case simd_t::NEON: supported = support == simd_t::NEON; break;
+		}
+
+		simd_current() = supported ? level : support;
+	}
+
+	void rgb8_to_rgba8(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) noexcept
+	{
+		assert(src && dst);
+		dispatch().rgb8_to_rgba8(src, dst, count, alpha);
+	}
+
+	void rgba8_to_rgb8(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+	{
+		assert(src && dst);
+		dispatch().rgba8_to_rgb8(src, dst, count);
+	}
+
+	void rgb8_to_bgr8(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+	{
+		assert(src && dst);
+		dispatch().rgb8_to_bgr8(src, dst, count);
+	}
+
+	void rgba8_to_bgra8(const std::uint8_t* src, std::uint8_t* dst, std::size_t count) noexcept
+	{
+		assert(src && dst);
+		dispatch().rgba8_to_bgra8(src, dst, count);
+	}
+
+	void bgr8_to_rgba8(const std::uint8_t* src, std::uint8_t* dst, std::size_t count, std::uint8_t alpha) noexcept
+	{
+		assert(src && dst);
+		dispatch().bgr8_to_rgba8(src, dst, count, alpha);
+	}
+
+	void r8_to_r32f(const std::uint8_t* src, float* dst, std::size_t count) noexcept
+	{
+		assert(src && dst);
+		dispatch().r8_to_r32f(src, dst, count);
+	}
+
+	void r32f_to_r8(const float* src, std::uint8_t* dst, std::size_t count) noexcept
+	{
+		assert(src && dst);
+		dispatch().r32f_to_r8(src, dst, count);
+	}
+
+	void r32f_to_r16f(const float* src, std::uint16_t* dst, std::size_t count) noexcept
+	{
+		assert(src && dst);
+		dispatch().r32f_to_r16f(src, dst, count);
+	}
+
+	void r16f_to_r32f(const std::uint16_t* src, float* dst, std::size_t count) noexcept
+	{
+		assert(src && dst);
+		dispatch().r16f_to_r32f(src, dst, count);
+	}
+
 	void r32f_to_r8uint(const float* src, std::uint8_t* dst, std::uint32_t w, std::uint32_t h, std::uint8_t channel)
 	{
 		assert(src && dst);
 		assert(w > 0 && h > 0 && channel > 0 && channel <= 4);
 
-		for (std::size_t i = 0; i < w * h * channel; i++)
-		{
-			dst[i] = (std::uint8_t)math::clamp<std::uint16_t>((std::uint16_t)(src[i] * 255), 0, 255);
-		}
+		dispatch().r32f_to_r8(src, dst, (std::size_t)w * h * channel);
 	}
 
 	void r32f_to_r8sint(const float* src, std::int8_t* dst, std::uint32_t w, std::uint32_t h, std::uint8_t channel)
@@ -130,20 +1094,11 @@ namespace image
 		assert(dstImage.height() == srcImage.height());
 		assert(dstImage.depth() == srcImage.depth());
 
-		auto src = (float3*)srcImage.data();
-		auto dst = (Vector3t<std::uint8_t>*)dstImage.data();
-
 		auto width = dstImage.width();
 		auto height = dstImage.height();
 		auto depth = dstImage.depth();
 
-		constexpr std::uint8_t minLimit = std::numeric_limits<std::uint8_t>::min();
-		constexpr std::uint8_t maxLimit = std::numeric_limits<std::uint8_t>::max();
-
-		for (std::size_t i = 0; i < width * height * depth; i++)
-		{
-			dst[i] = math::clamp<std::uint8_t>(Vector3t<std::uint8_t>(src[i] * 255.0f), minLimit, maxLimit);
-		}
+		dispatch().r32f_to_r8cast((const float*)srcImage.data(), (std::uint8_t*)dstImage.data(), (std::size_t)width * height * depth * 3);
 	}
 
 	void rgb64f_to_rgb8uint(const Image& srcImage, Image& dstImage)
@@ -180,20 +1135,11 @@ namespace image
 		assert(dstImage.height() == srcImage.height());
 		assert(dstImage.depth() == srcImage.depth());
 
-		auto src = (float4*)srcImage.data();
-		auto dst = (Vector4t<std::uint8_t>*)dstImage.data();
-
 		auto width = dstImage.width();
 		auto height = dstImage.height();
 		auto depth = dstImage.depth();
 
-		constexpr std::uint8_t minLimit = std::numeric_limits<std::uint8_t>::min();
-		constexpr std::uint8_t maxLimit = std::numeric_limits<std::uint8_t>::max();
-
-		for (std::size_t i = 0; i < width * height * depth; i++)
-		{
-			dst[i] = math::clamp<std::uint8_t>(Vector4t<std::uint8_t>(src[i] * 255.0f), minLimit, maxLimit);
-		}
+		dispatch().r32f_to_r8cast((const float*)srcImage.data(), (std::uint8_t*)dstImage.data(), (std::size_t)width * height * depth * 4);
 	}
 
 	void rgba64f_to_rgba8uint(const Image& srcImage, Image& dstImage)
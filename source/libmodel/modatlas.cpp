@@ -0,0 +1,690 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2016.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include <ray/modatlas.h>
+#include <ray/thread.h>
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cstring>
+#include <thread>
+
+_NAME_BEGIN
+
+namespace
+{
+	const float kMinChartCosine = 0.25f;
+	const std::uint32_t kScaleSearchSteps = 12;
+
+	struct AtlasChart
+	{
+		std::vector<std::uint32_t> faces;
+		std::vector<std::uint32_t> vertices;
+		std::vector<float2> coords;
+		float2 size;
+		float area;
+	};
+
+	struct AtlasRect
+	{
+		std::uint32_t x;
+		std::uint32_t y;
+		bool rotated;
+	};
+
+	struct SkylineSegment
+	{
+		std::uint32_t x;
+		std::uint32_t y;
+		std::uint32_t width;
+	};
+
+	float
+	cross2(const float2& o, const float2& a, const float2& b) noexcept
+	{
+		return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+	}
+
+	void
+	computeConvexHull(std::vector<float2> points, std::vector<float2>& hull) noexcept
+	{
+		std::sort(points.begin(), points.end(), [](const float2& a, const float2& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); });
+
+		hull.resize(points.size() * 2);
+
+		std::size_t k = 0;
+		for (std::size_t i = 0; i < points.size(); i++)
+		{
+			while (k >= 2 && cross2(hull[k - 2], hull[k - 1], points[i]) <= 0.0f) k--;
+			hull[k++] = points[i];
+		}
+
+		for (std::size_t i = points.size() - 1, t = k + 1; i > 0; i--)
+		{
+			while (k >= t && cross2(hull[k - 2], hull[k - 1], points[i - 1]) <= 0.0f) k--;
+			hull[k++] = points[i - 1];
+		}
+
+		hull.resize(k > 1 ? k - 1 : k);
+	}
+
+	void
+	parameterizeChart(const Float3Array& vertices, const float3& axis, AtlasChart& chart) noexcept
+	{
+		float3 tangent = std::abs(axis.x) < 0.9f ? float3::UnitX : float3::UnitY;
+		float3 bitangent = math::normalize(math::cross(axis, tangent));
+		tangent = math::cross(bitangent, axis);
+
+		chart.coords.resize(chart.vertices.size());
+		for (std::size_t i = 0; i < chart.vertices.size(); i++)
+		{
+			const float3& p = vertices[chart.vertices[i]];
+			chart.coords[i] = float2(math::dot(p, tangent), math::dot(p, bitangent));
+		}
+
+		// Rotate the chart to the smallest bounding rectangle, one of its sides lies on an edge of the convex hull.
+		std::vector<float2> hull;
+		computeConvexHull(chart.coords, hull);
+
+		float bestArea = FLT_MAX;
+		float2 bestDir(1.0f, 0.0f);
+
+		for (std::size_t i = 0; i < hull.size(); i++)
+		{
+			float2 edge = hull[(i + 1) % hull.size()] - hull[i];
+			float length = math::length(edge);
+			if (length <= 0.0f)
+				continue;
+
+			float2 dir = edge / length;
+			float2 minimum(FLT_MAX, FLT_MAX);
+			float2 maximum(-FLT_MAX, -FLT_MAX);
+
+			for (auto& it : hull)
+			{
+				float2 p(math::dot(it, dir), dir.x * it.y - dir.y * it.x);
+				minimum = math::min(minimum, p);
+				maximum = math::max(maximum, p);
+			}
+
+			float area = (maximum.x - minimum.x) * (maximum.y - minimum.y);
+			if (area < bestArea)
+			{
+				bestArea = area;
+				bestDir = dir;
+			}
+		}
+
+		float2 minimum(FLT_MAX, FLT_MAX);
+		float2 maximum(-FLT_MAX, -FLT_MAX);
+
+		for (auto& it : chart.coords)
+		{
+			it = float2(math::dot(it, bestDir), bestDir.x * it.y - bestDir.y * it.x);
+			minimum = math::min(minimum, it);
+			maximum = math::max(maximum, it);
+		}
+
+		for (auto& it : chart.coords)
+			it -= minimum;
+
+		chart.size = maximum - minimum;
+	}
+
+	void
+	segmentCharts(const Float3Array& vertices, const UintArray& indices, const std::vector<std::uint32_t>& faces, float cosLimit, std::vector<AtlasChart>& charts) noexcept
+	{
+		std::size_t numFaces = faces.size();
+		if (numFaces == 0)
+			return;
+
+		// Weld corners by position so charts also grow across normal and texcoord seams.
+		std::vector<std::uint32_t> corners(numFaces * 3);
+		for (std::size_t i = 0; i < numFaces; i++)
+		{
+			corners[i * 3 + 0] = indices[faces[i] * 3 + 0];
+			corners[i * 3 + 1] = indices[faces[i] * 3 + 1];
+			corners[i * 3 + 2] = indices[faces[i] * 3 + 2];
+		}
+
+		std::vector<std::uint32_t> unique(corners);
+		std::sort(unique.begin(), unique.end());
+		unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+		std::vector<std::uint32_t> sorted(unique);
+		std::sort(sorted.begin(), sorted.end(), [&](std::uint32_t a, std::uint32_t b)
+		{
+			const float3& pa = vertices[a];
+			const float3& pb = vertices[b];
+			if (pa.x != pb.x) return pa.x < pb.x;
+			if (pa.y != pb.y) return pa.y < pb.y;
+			return pa.z < pb.z;
+		});
+
+		std::vector<std::uint32_t> positionIds(unique.size());
+		for (std::size_t i = 0, id = 0; i < sorted.size(); i++)
+		{
+			if (i > 0 && vertices[sorted[i]] != vertices[sorted[i - 1]])
+				id++;
+
+			std::size_t slot = std::lower_bound(unique.begin(), unique.end(), sorted[i]) - unique.begin();
+			positionIds[slot] = (std::uint32_t)id;
+		}
+
+		auto positionId = [&](std::uint32_t vertex) -> std::uint32_t
+		{
+			return positionIds[std::lower_bound(unique.begin(), unique.end(), vertex) - unique.begin()];
+		};
+
+		std::vector<std::pair<std::uint64_t, std::uint32_t>> edges(numFaces * 3);
+		for (std::size_t i = 0; i < numFaces; i++)
+		{
+			for (std::size_t j = 0; j < 3; j++)
+			{
+				std::uint64_t a = positionId(corners[i * 3 + j]);
+				std::uint64_t b = positionId(corners[i * 3 + (j + 1) % 3]);
+				edges[i * 3 + j] = std::make_pair(std::min(a, b) << 32 | std::max(a, b), (std::uint32_t)(i * 3 + j));
+			}
+		}
+
+		std::sort(edges.begin(), edges.end());
+
+		// Only manifold edges connect faces, charts never grow across an edge shared by more than two faces.
+		std::vector<std::uint32_t> neighbors(numFaces * 3, UINT32_MAX);
+		for (std::size_t i = 0; i < edges.size();)
+		{
+			std::size_t j = i + 1;
+			while (j < edges.size() && edges[j].first == edges[i].first)
+				j++;
+
+			if (j - i == 2 && (edges[i].first >> 32) != (edges[i].first & 0xFFFFFFFF))
+			{
+				neighbors[edges[i].second] = edges[i + 1].second / 3;
+				neighbors[edges[i + 1].second] = edges[i].second / 3;
+			}
+
+			i = j;
+		}
+
+		std::vector<float3> normals(numFaces);
+		std::vector<float> areas(numFaces);
+
+		for (std::size_t i = 0; i < numFaces; i++)
+		{
+			const float3& p0 = vertices[corners[i * 3 + 0]];
+			const float3& p1 = vertices[corners[i * 3 + 1]];
+			const float3& p2 = vertices[corners[i * 3 + 2]];
+
+			float3 n = math::cross(p1 - p0, p2 - p0);
+			float length = math::length(n);
+
+			areas[i] = length * 0.5f;
+			normals[i] = length > 0.0f ? n / length : float3::Zero;
+		}
+
+		std::vector<std::uint32_t> order(numFaces);
+		for (std::size_t i = 0; i < numFaces; i++)
+			order[i] = (std::uint32_t)i;
+
+		std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) { return areas[a] > areas[b]; });
+
+		std::vector<bool> visited(numFaces, false);
+		std::vector<std::uint32_t> stamps(vertices.size(), UINT32_MAX);
+		std::vector<std::uint32_t> queue;
+
+		for (auto seed : order)
+		{
+			if (visited[seed])
+				continue;
+
+			// The seed normal stays the projection axis, every face in the cone projects without flipping.
+			float3 axis = areas[seed] > 0.0f ? normals[seed] : float3::UnitZ;
+
+			AtlasChart chart;
+			chart.area = 0.0f;
+
+			visited[seed] = true;
+			queue.clear();
+			queue.push_back(seed);
+
+			for (std::size_t head = 0; head < queue.size(); head++)
+			{
+				std::uint32_t face = queue[head];
+
+				chart.faces.push_back(faces[face]);
+				chart.area += areas[face] * std::max(0.0f, math::dot(normals[face], axis));
+
+				for (std::size_t j = 0; j < 3; j++)
+				{
+					std::uint32_t next = neighbors[face * 3 + j];
+					if (next == UINT32_MAX || visited[next])
+						continue;
+
+					if (areas[next] > 0.0f && math::dot(normals[next], axis) < cosLimit)
+						continue;
+
+					visited[next] = true;
+					queue.push_back(next);
+				}
+			}
+
+			std::uint32_t chartIndex = (std::uint32_t)charts.size();
+
+			for (auto face : chart.faces)
+			{
+				for (std::size_t j = 0; j < 3; j++)
+				{
+					std::uint32_t vertex = indices[face * 3 + j];
+					if (stamps[vertex] != chartIndex)
+					{
+						stamps[vertex] = chartIndex;
+						chart.vertices.push_back(vertex);
+					}
+				}
+			}
+
+			parameterizeChart(vertices, axis, chart);
+
+			charts.push_back(std::move(chart));
+		}
+	}
+
+	bool
+	packCharts(const std::vector<AtlasChart>& charts, const std::vector<std::uint32_t>& order, std::uint32_t width, std::uint32_t height, std::uint32_t margin, float scale, std::vector<AtlasRect>& rects) noexcept
+	{
+		std::vector<SkylineSegment> skyline;
+		skyline.push_back({ 0, 0, width });
+
+		rects.resize(charts.size());
+
+		for (auto index : order)
+		{
+			const AtlasChart& chart = charts[index];
+
+			std::uint32_t w = (std::uint32_t)std::ceil(chart.size.x * scale) + 1 + margin;
+			std::uint32_t h = (std::uint32_t)std::ceil(chart.size.y * scale) + 1 + margin;
+
+			std::size_t bestSegment = SIZE_MAX;
+			std::uint32_t bestTop = UINT32_MAX;
+			std::uint32_t bestY = 0;
+			std::uint32_t bestWaste = UINT32_MAX;
+			bool bestRotated = false;
+
+			for (std::uint32_t rotation = 0; rotation < 2; rotation++)
+			{
+				std::uint32_t rw = rotation ? h : w;
+				std::uint32_t rh = rotation ? w : h;
+
+				for (std::size_t i = 0; i < skyline.size(); i++)
+				{
+					if (skyline[i].x + rw > width)
+						break;
+
+					std::uint32_t y = 0;
+					std::uint32_t covered = 0;
+					for (std::size_t j = i; covered < rw; j++)
+					{
+						y = std::max(y, skyline[j].y);
+						covered += skyline[j].width;
+					}
+
+					if (y + rh > height)
+						continue;
+
+					std::uint32_t waste = 0;
+					covered = 0;
+					for (std::size_t j = i; covered < rw; j++)
+					{
+						std::uint32_t span = std::min(skyline[j].width, rw - covered);
+						waste += (y - skyline[j].y) * span;
+						covered += span;
+					}
+
+					if (y + rh < bestTop || (y + rh == bestTop && waste < bestWaste))
+					{
+						bestSegment = i;
+						bestTop = y + rh;
+						bestY = y;
+						bestWaste = waste;
+						bestRotated = rotation != 0;
+					}
+				}
+			}
+
+			if (bestSegment == SIZE_MAX)
+				return false;
+
+			std::uint32_t rw = bestRotated ? h : w;
+			std::uint32_t x = skyline[bestSegment].x;
+
+			rects[index].x = x;
+			rects[index].y = bestY;
+			rects[index].rotated = bestRotated;
+
+			SkylineSegment segment = { x, bestTop, rw };
+
+			std::size_t last = bestSegment;
+			while (last < skyline.size() && skyline[last].x + skyline[last].width <= x + rw)
+				last++;
+
+			if (last < skyline.size() && skyline[last].x < x + rw)
+			{
+				std::uint32_t shrink = x + rw - skyline[last].x;
+				skyline[last].x += shrink;
+				skyline[last].width -= shrink;
+			}
+
+			skyline.erase(skyline.begin() + bestSegment, skyline.begin() + last);
+			skyline.insert(skyline.begin() + bestSegment, segment);
+
+			for (std::size_t i = 0; i + 1 < skyline.size();)
+			{
+				if (skyline[i].y == skyline[i + 1].y)
+				{
+					skyline[i].width += skyline[i + 1].width;
+					skyline.erase(skyline.begin() + i + 1);
+				}
+				else
+				{
+					i++;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	template<typename T>
+	void
+	gatherArray(std::vector<T>& array, const UintArray& remap, std::size_t numVertices) noexcept
+	{
+		if (array.size() != numVertices)
+			return;
+
+		std::vector<T> result(remap.size());
+		for (std::size_t i = 0; i < remap.size(); i++)
+			result[i] = array[remap[i]];
+
+		array.swap(result);
+	}
+}
+
+MeshAtlasParams::MeshAtlasParams() noexcept
+	: width(1024)
+	, height(1024)
+	, margin(2)
+	, maxStretch(0.16667f)
+	, maxCharts(0)
+{
+}
+
+bool
+makeAtlasUV(const Float3Array& vertices, const UintArray& indices, const MeshSubsets& subsets, const MeshAtlasParams& params, UintArray& remap, UintArray& outIndices, Float2Array& texcoords, MeshAtlasStats* stats) noexcept
+{
+	assert(params.width > 0 && params.height > 0);
+	assert(params.maxStretch >= 0.0f);
+
+	std::size_t numFaces = indices.size() / 3;
+	if (numFaces == 0 || vertices.empty())
+		return false;
+
+	std::vector<std::vector<std::uint32_t>> groups;
+	std::vector<bool> covered(numFaces, false);
+
+	for (auto& subset : subsets)
+	{
+		std::vector<std::uint32_t> faces;
+		for (std::size_t i = subset.startIndices / 3; i < std::min<std::size_t>(numFaces, (subset.startIndices + subset.indicesCount) / 3); i++)
+		{
+			if (!covered[i])
+			{
+				covered[i] = true;
+				faces.push_back((std::uint32_t)i);
+			}
+		}
+
+		if (!faces.empty())
+			groups.push_back(std::move(faces));
+	}
+
+	std::vector<std::uint32_t> remaining;
+	for (std::size_t i = 0; i < numFaces; i++)
+	{
+		if (!covered[i])
+			remaining.push_back((std::uint32_t)i);
+	}
+
+	if (!remaining.empty())
+		groups.push_back(std::move(remaining));
+
+	for (auto it : indices)
+	{
+		if (it >= vertices.size())
+			return false;
+	}
+
+	float stretch = std::min(params.maxStretch, 1.0f);
+
+	std::vector<AtlasChart> charts;
+
+	ThreadPool& threadPool = *ThreadPool::instance();
+
+	for (;;)
+	{
+		float cosLimit = std::max(1.0f - stretch, kMinChartCosine);
+
+		std::vector<std::vector<AtlasChart>> groupCharts(groups.size());
+		std::atomic<std::uint32_t> finished(0);
+		std::atomic<bool> cancelled(false);
+
+		threadPool.parallelFor(groups.size(), [&](std::size_t index, std::uint32_t thread)
+		{
+			if (cancelled)
+				return;
+
+			segmentCharts(vertices, indices, groups[index], cosLimit, groupCharts[index]);
+
+			finished++;
+
+			if (thread == 0 && params.progress && !params.progress(0.5f * finished / groups.size()))
+				cancelled = true;
+		});
+
+		if (cancelled)
+			return false;
+
+		charts.clear();
+		for (auto& it : groupCharts)
+			std::move(it.begin(), it.end(), std::back_inserter(charts));
+
+		if (params.maxCharts == 0 || charts.size() <= params.maxCharts || cosLimit <= kMinChartCosine)
+			break;
+
+		stretch = std::min(1.0f, stretch * 2.0f + 0.01f);
+	}
+
+	float totalArea = 0.0f;
+	for (auto& chart : charts)
+		totalArea += std::max(chart.area, 0.0f);
+
+	if (totalArea <= 0.0f)
+		totalArea = 1.0f;
+
+	std::vector<std::uint32_t> order(charts.size());
+	for (std::size_t i = 0; i < charts.size(); i++)
+		order[i] = (std::uint32_t)i;
+
+	std::sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b)
+	{
+		float sa = std::max(charts[a].size.x, charts[a].size.y);
+		float sb = std::max(charts[b].size.x, charts[b].size.y);
+		if (sa != sb)
+			return sa > sb;
+		return charts[a].size.x * charts[a].size.y > charts[b].size.x * charts[b].size.y;
+	});
+
+	// Binary search the largest texel density that still packs, the upper bound is a perfect fit without margins.
+	float lo = 0.0f;
+	float hi = std::sqrt((float)params.width * params.height / totalArea);
+
+	std::vector<AtlasRect> rects;
+	std::vector<AtlasRect> bestRects;
+
+	for (std::uint32_t i = 0; i < kScaleSearchSteps; i++)
+	{
+		float scale = (lo + hi) * 0.5f;
+
+		if (packCharts(charts, order, params.width, params.height, params.margin, scale, rects))
+		{
+			lo = scale;
+			bestRects.swap(rects);
+		}
+		else
+		{
+			hi = scale;
+		}
+
+		if (params.progress && !params.progress(0.5f + 0.5f * (i + 1) / kScaleSearchSteps))
+			return false;
+	}
+
+	if (bestRects.empty())
+	{
+		if (!packCharts(charts, order, params.width, params.height, params.margin, 0.0f, bestRects))
+			return false;
+	}
+
+	float scale = lo;
+	float offset = (1 + params.margin) * 0.5f;
+	float2 invSize(1.0f / params.width, 1.0f / params.height);
+
+	std::size_t numVertices = 0;
+	for (auto& chart : charts)
+		numVertices += chart.vertices.size();
+
+	remap.resize(numVertices);
+	texcoords.resize(numVertices);
+	outIndices.resize(numFaces * 3);
+
+	std::vector<std::uint32_t> stamps(vertices.size(), UINT32_MAX);
+	std::vector<std::uint32_t> local(vertices.size());
+
+	std::size_t base = 0;
+
+	for (std::size_t i = 0; i < charts.size(); i++)
+	{
+		const AtlasChart& chart = charts[i];
+		const AtlasRect& rect = bestRects[i];
+
+		for (std::size_t j = 0; j < chart.vertices.size(); j++)
+		{
+			float2 coord = chart.coords[j] * scale;
+			if (rect.rotated)
+				coord = float2(coord.y, chart.size.x * scale - coord.x);
+
+			remap[base + j] = chart.vertices[j];
+			texcoords[base + j] = (float2(rect.x + offset, rect.y + offset) + coord) * invSize;
+
+			stamps[chart.vertices[j]] = (std::uint32_t)i;
+			local[chart.vertices[j]] = (std::uint32_t)(base + j);
+		}
+
+		for (auto face : chart.faces)
+		{
+			for (std::size_t j = 0; j < 3; j++)
+			{
+				assert(stamps[indices[face * 3 + j]] == i);
+				outIndices[face * 3 + j] = local[indices[face * 3 + j]];
+			}
+		}
+
+		base += chart.vertices.size();
+	}
+
+	if (stats)
+	{
+		float utilization = 0.0f;
+		for (std::size_t i = 0; i < numFaces; i++)
+		{
+			const float2& a = texcoords[outIndices[i * 3 + 0]];
+			const float2& b = texcoords[outIndices[i * 3 + 1]];
+			const float2& c = texcoords[outIndices[i * 3 + 2]];
+			utilization += std::abs(cross2(a, b, c)) * 0.5f;
+		}
+
+		stats->numCharts = charts.size();
+		stats->numVertices = numVertices;
+		stats->texelsPerUnit = scale;
+		stats->utilization = utilization;
+	}
+
+	return true;
+}
+
+bool
+makeAtlasUV(MeshProperty& mesh, std::uint8_t slot, const MeshAtlasParams& params, MeshAtlasStats* stats) noexcept
+{
+	if (slot >= TEXTURE_ARRAY_COUNT)
+		return false;
+
+	UintArray remap;
+	UintArray indices;
+	Float2Array texcoords;
+
+	if (!makeAtlasUV(mesh.getVertexArray(), mesh.getIndicesArray(), mesh.getMeshSubsets(), params, remap, indices, texcoords, stats))
+		return false;
+
+	std::size_t numVertices = mesh.getNumVertices();
+
+	gatherArray(mesh.getNormalArray(), remap, numVertices);
+	gatherArray(mesh.getColorArray(), remap, numVertices);
+	gatherArray(mesh.getTangentArray(), remap, numVertices);
+	gatherArray(mesh.getWeightArray(), remap, numVertices);
+
+	for (std::uint8_t i = 0; i < TEXTURE_ARRAY_COUNT; i++)
+		gatherArray(mesh.getTexcoordArray(i), remap, numVertices);
+
+	gatherArray(mesh.getVertexArray(), remap, numVertices);
+
+	mesh.setTexcoordArray(std::move(texcoords), slot);
+	mesh.setIndicesArray(std::move(indices));
+	mesh.setMeshLevels(MeshLevels());
+	mesh.setMeshClusters(MeshClusters());
+
+	return true;
+}
+
+_NAME_END
@@ -393,8 +393,10 @@ Model::hasAnimations() const noexcept
 }
 
 void
-Model::applyProcess(int) noexcept
+Model::applyProcess(int flags) noexcept
 {
+	for (auto& it : _meshes)
+		optimizeMesh(*it, flags);
 }
 
 bool
@@ -35,6 +35,7 @@
 // | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // +----------------------------------------------------------------------
 #include <ray/modhelp.h>
+#include <ray/modopt.h>
 
 _NAME_BEGIN
 
@@ -466,6 +467,18 @@ MeshProperty::setMeshSubsets(const MeshSubsets& subsets) noexcept
 	_meshSubsets = subsets;
 }
 
+void
+MeshProperty::setMeshLevels(const MeshLevels& levels) noexcept
+{
+	_meshLevels = levels;
+}
+
+void
+MeshProperty::setMeshClusters(const MeshClusters& clusters) noexcept
+{
+	_meshClusters = clusters;
+}
+
 void
 MeshProperty::setWeightArray(const VertexWeights& array) noexcept
 {
@@ -527,6 +540,18 @@ MeshProperty::setMeshSubsets(MeshSubsets&& subsets) noexcept
 	_meshSubsets = std::move(subsets);
 }
 
+void
+MeshProperty::setMeshLevels(MeshLevels&& levels) noexcept
+{
+	_meshLevels = std::move(levels);
+}
+
+void
+MeshProperty::setMeshClusters(MeshClusters&& clusters) noexcept
+{
+	_meshClusters = std::move(clusters);
+}
+
 Float3Array&
 MeshProperty::getVertexArray() noexcept
 {
@@ -582,6 +607,18 @@ MeshProperty::getMeshSubsets() noexcept
 	return _meshSubsets;
 }
 
+MeshLevels&
+MeshProperty::getMeshLevels() noexcept
+{
+	return _meshLevels;
+}
+
+MeshClusters&
+MeshProperty::getMeshClusters() noexcept
+{
+	return _meshClusters;
+}
+
 const Float3Array&
 MeshProperty::getVertexArray() const noexcept
 {
@@ -631,6 +668,18 @@ MeshProperty::getMeshSubsets() const noexcept
 	return _meshSubsets;
 }
 
+const MeshLevels&
+MeshProperty::getMeshLevels() const noexcept
+{
+	return _meshLevels;
+}
+
+const MeshClusters&
+MeshProperty::getMeshClusters() const noexcept
+{
+	return _meshClusters;
+}
+
 const Bones&
 MeshProperty::getBoneArray(const Bones& array) const noexcept
 {
@@ -657,6 +706,8 @@ MeshProperty::clear() noexcept
 	_colors = Float4Array();
 	_tangents = Float4Array();
 	_indices = UintArray();
+	_meshLevels = MeshLevels();
+	_meshClusters = MeshClusters();
 
 	for (std::size_t i = 0; i < 8; i++)
 		_texcoords[i] = Float2Array();
@@ -677,6 +728,8 @@ MeshProperty::clone() noexcept
 	mesh->setIndicesArray(this->getIndicesArray());
 	mesh->_boundingBox = this->_boundingBox;
 	mesh->_meshSubsets = this->_meshSubsets;
+	mesh->_meshLevels = this->_meshLevels;
+	mesh->_meshClusters = this->_meshClusters;
 
 	return mesh;
 }
@@ -1356,37 +1409,7 @@ MeshProperty::mergeVertices() noexcept
 	if (_normals.empty())
 		this->computeVertexNormals();
 
-	std::map<std::pair<float, float>, std::uint32_t> vectorMap;
-
-	Float3Array changeVertex;
-	Float3Array changeNormal;
-
-	for (auto& it : _indices)
-	{
-		const Vector3& v = (_vertices)[it];
-		const Vector3& n = (_normals)[it];
-
-		float vkey = math::hash_float(v.x, v.y, v.z);
-		float nkey = math::hash_float(n.z, n.y, n.x);
-
-		std::uint32_t value = vectorMap[std::make_pair(vkey, nkey)];
-		if (value == 0)
-		{
-			changeVertex.push_back(v);
-			changeNormal.push_back(n);
-
-			std::size_t size = changeVertex.size();
-			it = size - 1;
-			vectorMap[std::make_pair(vkey, nkey)] = size;
-		}
-		else
-		{
-			it = value - 1;
-		}
-	}
-
-	_vertices.swap(changeVertex);
-	_normals.swap(changeNormal);
+	weldVertices(*this);
 }
 
 void
@@ -0,0 +1,594 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2016.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include <ray/modlod.h>
+#include <ray/modopt.h>
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include <unordered_map>
+
+_NAME_BEGIN
+
+namespace
+{
+	const float kBorderWeight = 10.0f;
+	const float kMaxNormalTurn = 0.25f;
+
+	enum VertexKind
+	{
+		VertexKindManifold,
+		VertexKindBorder,
+		VertexKindLocked,
+	};
+
+	struct Quadric
+	{
+		double a00, a11, a22;
+		double a01, a02, a12;
+		double b0, b1, b2;
+		double c;
+		double w;
+	};
+
+	struct Collapse
+	{
+		std::uint32_t u;
+		std::uint32_t v;
+		double error;
+	};
+
+	void
+	quadricFromPlane(Quadric& q, const float3& n, float d, float weight) noexcept
+	{
+		double a = n.x, b = n.y, c = n.z;
+
+		q.a00 = a * a * weight;
+		q.a11 = b * b * weight;
+		q.a22 = c * c * weight;
+		q.a01 = a * b * weight;
+		q.a02 = a * c * weight;
+		q.a12 = b * c * weight;
+		q.b0 = a * d * weight;
+		q.b1 = b * d * weight;
+		q.b2 = c * d * weight;
+		q.c = (double)d * d * weight;
+		q.w = weight;
+	}
+
+	void
+	quadricAdd(Quadric& q, const Quadric& r) noexcept
+	{
+		q.a00 += r.a00; q.a11 += r.a11; q.a22 += r.a22;
+		q.a01 += r.a01; q.a02 += r.a02; q.a12 += r.a12;
+		q.b0 += r.b0; q.b1 += r.b1; q.b2 += r.b2;
+		q.c += r.c;
+		q.w += r.w;
+	}
+
+	double
+	quadricError(const Quadric& q, const float3& p) noexcept
+	{
+		double x = p.x, y = p.y, z = p.z;
+
+		double rx = q.a00 * x + q.a01 * y + q.a02 * z + q.b0 * 2.0;
+		double ry = q.a01 * x + q.a11 * y + q.a12 * z + q.b1 * 2.0;
+		double rz = q.a02 * x + q.a12 * y + q.a22 * z + q.b2 * 2.0;
+
+		double error = x * rx + y * ry + z * rz + q.c;
+		return q.w > 0.0 ? std::abs(error) / q.w : 0.0;
+	}
+
+	std::uint32_t
+	hashPosition(const float3& v) noexcept
+	{
+		std::uint32_t bits[3];
+		std::memcpy(bits, v.ptr(), sizeof(bits));
+
+		std::uint32_t hash = 2166136261u;
+		for (auto it : bits)
+		{
+			hash ^= it;
+			hash *= 16777619u;
+		}
+
+		return hash;
+	}
+
+	void
+	buildPositionRemap(const Float3Array& vertices, std::vector<std::uint32_t>& remap, std::vector<std::uint32_t>& wedges) noexcept
+	{
+		std::size_t tableSize = 16;
+		while (tableSize < vertices.size() * 2)
+			tableSize <<= 1;
+
+		std::vector<std::uint32_t> table(tableSize, UINT32_MAX);
+
+		remap.resize(vertices.size());
+		wedges.assign(vertices.size(), 0);
+
+		for (std::size_t i = 0; i < vertices.size(); i++)
+		{
+			std::size_t bucket = hashPosition(vertices[i]) & (tableSize - 1);
+			for (std::size_t probe = 1; ; probe++)
+			{
+				std::uint32_t& entry = table[bucket];
+				if (entry == UINT32_MAX)
+				{
+					entry = (std::uint32_t)i;
+					break;
+				}
+
+				if (std::memcmp(vertices[entry].ptr(), vertices[i].ptr(), sizeof(float3)) == 0)
+					break;
+
+				bucket = (bucket + probe) & (tableSize - 1);
+			}
+
+			remap[i] = table[bucket];
+			wedges[remap[i]]++;
+		}
+	}
+
+	std::uint64_t
+	edgeKey(std::uint32_t a, std::uint32_t b) noexcept
+	{
+		return ((std::uint64_t)a << 32) | b;
+	}
+
+	bool
+	isBorderEdge(const std::unordered_map<std::uint64_t, std::uint32_t>& edges, std::uint32_t a, std::uint32_t b) noexcept
+	{
+		if (edges.count(edgeKey(a, b)) && !edges.count(edgeKey(b, a)))
+			return true;
+		if (edges.count(edgeKey(b, a)) && !edges.count(edgeKey(a, b)))
+			return true;
+		return false;
+	}
+
+	void
+	classifyVertices(const std::vector<std::uint32_t>& triangles, const std::vector<std::uint32_t>& remap, const std::vector<std::uint32_t>& wedges, std::unordered_map<std::uint64_t, std::uint32_t>& edges, std::vector<std::uint8_t>& kinds) noexcept
+	{
+		edges.clear();
+
+		for (std::size_t i = 0; i < triangles.size(); i += 3)
+		{
+			for (std::size_t e = 0; e < 3; e++)
+			{
+				std::uint32_t a = remap[triangles[i + e]];
+				std::uint32_t b = remap[triangles[i + (e + 1) % 3]];
+				edges[edgeKey(a, b)]++;
+			}
+		}
+
+		std::vector<std::uint8_t> borderOut(remap.size(), 0);
+		std::vector<std::uint8_t> borderIn(remap.size(), 0);
+
+		kinds.assign(remap.size(), VertexKindManifold);
+
+		for (auto& it : edges)
+		{
+			std::uint32_t a = (std::uint32_t)(it.first >> 32);
+			std::uint32_t b = (std::uint32_t)(it.first & 0xFFFFFFFF);
+
+			if (it.second > 1)
+			{
+				kinds[a] = VertexKindLocked;
+				kinds[b] = VertexKindLocked;
+			}
+			else if (!edges.count(edgeKey(b, a)))
+			{
+				borderOut[a] = std::min(borderOut[a] + 1, 2);
+				borderIn[b] = std::min(borderIn[b] + 1, 2);
+			}
+		}
+
+		for (std::size_t i = 0; i < remap.size(); i++)
+		{
+			if (remap[i] != i || kinds[i] == VertexKindLocked)
+				continue;
+
+			if (wedges[i] > 1)
+				kinds[i] = VertexKindLocked;
+			else if (borderOut[i] || borderIn[i])
+				kinds[i] = (borderOut[i] == 1 && borderIn[i] == 1) ? VertexKindBorder : VertexKindLocked;
+		}
+	}
+
+	void
+	buildQuadrics(const std::vector<std::uint32_t>& triangles, const std::vector<std::uint32_t>& remap, const Float3Array& vertices, const std::unordered_map<std::uint64_t, std::uint32_t>& edges, std::vector<Quadric>& quadrics) noexcept
+	{
+		Quadric zero;
+		std::memset(&zero, 0, sizeof(zero));
+
+		quadrics.assign(vertices.size(), zero);
+
+		for (std::size_t i = 0; i < triangles.size(); i += 3)
+		{
+			const float3& p0 = vertices[triangles[i]];
+			const float3& p1 = vertices[triangles[i + 1]];
+			const float3& p2 = vertices[triangles[i + 2]];
+
+			float3 n = math::cross(p1 - p0, p2 - p0);
+			float area = math::length(n);
+			if (area == 0.0f)
+				continue;
+
+			n /= area;
+
+			Quadric q;
+			quadricFromPlane(q, n, -math::dot(n, p0), area * 0.5f);
+
+			for (std::size_t e = 0; e < 3; e++)
+			{
+				std::uint32_t a = remap[triangles[i + e]];
+				std::uint32_t b = remap[triangles[i + (e + 1) % 3]];
+
+				quadricAdd(quadrics[a], q);
+
+				if (edges.count(edgeKey(b, a)))
+					continue;
+
+				const float3& pa = vertices[a];
+				const float3& pb = vertices[b];
+
+				float3 edge = pb - pa;
+				float length = math::length(edge);
+				if (length == 0.0f)
+					continue;
+
+				float3 normal = math::normalize(math::cross(edge, n));
+
+				Quadric border;
+				quadricFromPlane(border, normal, -math::dot(normal, pa), length * length * kBorderWeight);
+
+				quadricAdd(quadrics[a], border);
+				quadricAdd(quadrics[b], border);
+			}
+		}
+	}
+
+	void
+	buildAdjacency(const std::vector<std::uint32_t>& triangles, const std::vector<std::uint32_t>& remap, std::vector<std::uint32_t>& offsets, std::vector<std::uint32_t>& adjacency) noexcept
+	{
+		offsets.assign(remap.size() + 1, 0);
+
+		for (auto& it : triangles)
+			offsets[remap[it] + 1]++;
+
+		for (std::size_t i = 1; i < offsets.size(); i++)
+			offsets[i] += offsets[i - 1];
+
+		std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+
+		adjacency.resize(triangles.size());
+		for (std::size_t i = 0; i < triangles.size(); i++)
+			adjacency[fill[remap[triangles[i]]]++] = (std::uint32_t)(i / 3);
+	}
+
+	void
+	gatherNeighbors(const std::vector<std::uint32_t>& triangles, const std::vector<std::uint32_t>& remap, const std::uint32_t* begin, const std::uint32_t* end, std::uint32_t center, std::vector<std::uint32_t>& neighbors) noexcept
+	{
+		neighbors.clear();
+
+		for (auto it = begin; it != end; ++it)
+		{
+			for (std::size_t k = 0; k < 3; k++)
+			{
+				std::uint32_t pos = remap[triangles[*it * 3 + k]];
+				if (pos != center)
+					neighbors.push_back(pos);
+			}
+		}
+
+		std::sort(neighbors.begin(), neighbors.end());
+		neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+	}
+
+	bool
+	hasFlip(const std::vector<std::uint32_t>& triangles, const std::vector<std::uint32_t>& remap, const Float3Array& vertices, const std::uint32_t* begin, const std::uint32_t* end, std::uint32_t u, std::uint32_t v) noexcept
+	{
+		for (auto it = begin; it != end; ++it)
+		{
+			const std::uint32_t* tri = &triangles[*it * 3];
+			if (tri[0] == v || tri[1] == v || tri[2] == v)
+				continue;
+
+			if (remap[tri[0]] == remap[v] || remap[tri[1]] == remap[v] || remap[tri[2]] == remap[v])
+				return true;
+
+			float3 p[3] = { vertices[tri[0]], vertices[tri[1]], vertices[tri[2]] };
+
+			float3 before = math::cross(p[1] - p[0], p[2] - p[0]);
+
+			for (std::size_t k = 0; k < 3; k++)
+			{
+				if (tri[k] == u)
+					p[k] = vertices[v];
+			}
+
+			float3 after = math::cross(p[1] - p[0], p[2] - p[0]);
+
+			if (math::dot(before, after) <= kMaxNormalTurn * math::length(before) * math::length(after))
+				return true;
+		}
+
+		return false;
+	}
+}
+
+float
+simplifyMesh(const MeshProperty& mesh, const UintArray& source, const MeshSubsets& sourceSubsets, float ratio, float targetError, UintArray& indices, MeshSubsets& subsets) noexcept
+{
+	const auto& vertices = mesh.getVertexArray();
+
+	std::vector<std::uint32_t> triangles;
+	std::vector<std::uint32_t> triangleSubsets;
+
+	for (std::size_t i = 0; i < sourceSubsets.size(); i++)
+	{
+		const auto& subset = sourceSubsets[i];
+		if (subset.startIndices + subset.indicesCount > source.size())
+			continue;
+
+		for (std::size_t j = 0; j + 2 < subset.indicesCount; j += 3)
+		{
+			triangles.insert(triangles.end(), &source[subset.startIndices + j], &source[subset.startIndices + j] + 3);
+			triangleSubsets.push_back((std::uint32_t)i);
+		}
+	}
+
+	float3 minimum = float3(FLT_MAX);
+	float3 maximum = float3(-FLT_MAX);
+
+	for (auto& it : triangles)
+	{
+		minimum = math::min(minimum, vertices[it]);
+		maximum = math::max(maximum, vertices[it]);
+	}
+
+	float radius = triangles.empty() ? 0.0f : math::length(maximum - minimum) * 0.5f;
+	double errorLimit = (double)targetError * radius * targetError * radius;
+	double errorReached = 0.0;
+
+	std::size_t numTriangles = triangles.size() / 3;
+	std::size_t targetTriangles = (std::size_t)(numTriangles * ratio);
+
+	std::vector<std::uint32_t> remap;
+	std::vector<std::uint32_t> wedges;
+	buildPositionRemap(vertices, remap, wedges);
+
+	std::unordered_map<std::uint64_t, std::uint32_t> edges;
+	std::vector<std::uint8_t> kinds;
+	classifyVertices(triangles, remap, wedges, edges, kinds);
+
+	std::vector<Quadric> quadrics;
+	buildQuadrics(triangles, remap, vertices, edges, quadrics);
+
+	std::vector<std::uint32_t> offsets;
+	std::vector<std::uint32_t> adjacency;
+	std::vector<std::uint8_t> locked;
+	std::vector<Collapse> collapses;
+	std::vector<std::uint32_t> neighborsU;
+	std::vector<std::uint32_t> neighborsV;
+
+	while (numTriangles > targetTriangles && radius > 0.0f)
+	{
+		buildAdjacency(triangles, remap, offsets, adjacency);
+
+		collapses.clear();
+
+		for (std::size_t i = 0; i < triangles.size(); i += 3)
+		{
+			for (std::size_t e = 0; e < 3; e++)
+			{
+				std::uint32_t i0 = triangles[i + e];
+				std::uint32_t i1 = triangles[i + (e + 1) % 3];
+
+				for (std::size_t k = 0; k < 2; k++)
+				{
+					std::uint32_t u = k ? i1 : i0;
+					std::uint32_t v = k ? i0 : i1;
+
+					std::uint32_t pu = remap[u];
+					std::uint32_t pv = remap[v];
+
+					if (pu == pv || kinds[pu] == VertexKindLocked)
+						continue;
+
+					if (kinds[pu] == VertexKindBorder && !isBorderEdge(edges, pu, pv))
+						continue;
+
+					Quadric q = quadrics[pu];
+					quadricAdd(q, quadrics[pv]);
+
+					Collapse collapse;
+					collapse.u = u;
+					collapse.v = v;
+					collapse.error = quadricError(q, vertices[v]);
+					collapses.push_back(collapse);
+				}
+			}
+		}
+
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.error < b.error; });
+
+		locked.assign(vertices.size(), 0);
+
+		std::size_t collapsed = 0;
+
+		for (auto& it : collapses)
+		{
+			if (numTriangles <= targetTriangles || it.error > errorLimit)
+				break;
+
+			std::uint32_t pu = remap[it.u];
+			std::uint32_t pv = remap[it.v];
+
+			if (locked[pu] || locked[pv])
+				continue;
+
+			const std::uint32_t* beginU = adjacency.data() + offsets[pu];
+			const std::uint32_t* endU = adjacency.data() + offsets[pu + 1];
+
+			gatherNeighbors(triangles, remap, beginU, endU, pu, neighborsU);
+			gatherNeighbors(triangles, remap, adjacency.data() + offsets[pv], adjacency.data() + offsets[pv + 1], pv, neighborsV);
+
+			std::size_t shared = 0;
+			for (auto& n : neighborsU)
+			{
+				if (std::binary_search(neighborsV.begin(), neighborsV.end(), n))
+					shared++;
+			}
+
+			if (shared > (kinds[pu] == VertexKindBorder ? 1u : 2u))
+				continue;
+
+			if (hasFlip(triangles, remap, vertices, beginU, endU, it.u, it.v))
+				continue;
+
+			for (auto t = beginU; t != endU; ++t)
+			{
+				std::uint32_t* tri = &triangles[*t * 3];
+				if (tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0])
+					continue;
+
+				for (std::size_t k = 0; k < 3; k++)
+				{
+					if (tri[k] == it.u)
+						tri[k] = it.v;
+				}
+
+				if (tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0])
+					numTriangles--;
+			}
+
+			locked[pu] = 1;
+			locked[pv] = 1;
+
+			for (auto& n : neighborsU)
+				locked[n] = 1;
+
+			quadricAdd(quadrics[pv], quadrics[pu]);
+
+			errorReached = std::max(errorReached, it.error);
+			collapsed++;
+		}
+
+		std::size_t write = 0;
+		for (std::size_t i = 0; i < triangles.size(); i += 3)
+		{
+			if (triangles[i] == triangles[i + 1] || triangles[i + 1] == triangles[i + 2] || triangles[i + 2] == triangles[i])
+				continue;
+
+			triangles[write * 3] = triangles[i];
+			triangles[write * 3 + 1] = triangles[i + 1];
+			triangles[write * 3 + 2] = triangles[i + 2];
+			triangleSubsets[write++] = triangleSubsets[i / 3];
+		}
+
+		triangles.resize(write * 3);
+		triangleSubsets.resize(write);
+
+		numTriangles = write;
+
+		if (collapsed == 0)
+			break;
+
+		classifyVertices(triangles, remap, wedges, edges, kinds);
+	}
+
+	indices.clear();
+	indices.reserve(triangles.size());
+
+	subsets = sourceSubsets;
+
+	for (std::size_t i = 0; i < subsets.size(); i++)
+	{
+		std::size_t start = indices.size();
+
+		for (std::size_t j = 0; j < triangleSubsets.size(); j++)
+		{
+			if (triangleSubsets[j] == i)
+				indices.insert(indices.end(), &triangles[j * 3], &triangles[j * 3] + 3);
+		}
+
+		subsets[i].startIndices = (std::uint32_t)start;
+		subsets[i].indicesCount = (std::uint32_t)(indices.size() - start);
+
+		if (subsets[i].indicesCount)
+			optimizeVertexCache(indices.data() + start, subsets[i].indicesCount, vertices.size());
+	}
+
+	return radius > 0.0f ? (float)(std::sqrt(errorReached) / radius) : 0.0f;
+}
+
+std::size_t
+makeMeshLevels(MeshProperty& mesh, std::size_t count, float ratio, float targetError) noexcept
+{
+	auto& levels = mesh.getMeshLevels();
+	levels.clear();
+
+	if (mesh.getNumIndices() == 0 || mesh.getNumVertices() == 0)
+		return 0;
+
+	MeshSubsets subsets = mesh.getMeshSubsets();
+	if (subsets.empty())
+		subsets.push_back(MeshSubset(0, 0, (std::uint32_t)mesh.getNumIndices(), 0, 0));
+
+	float error = 0.0f;
+
+	for (std::size_t i = 0; i < count && error < targetError; i++)
+	{
+		const auto& source = levels.empty() ? mesh.getIndicesArray() : levels.back().indices;
+		const auto& sourceSubsets = levels.empty() ? subsets : levels.back().subsets;
+
+		MeshLevel level;
+		float levelError = simplifyMesh(mesh, source, sourceSubsets, ratio, targetError - error, level.indices, level.subsets);
+
+		if (level.indices.size() * 10 > source.size() * 9)
+			break;
+
+		error += levelError;
+
+		level.error = error;
+		levels.push_back(std::move(level));
+	}
+
+	return levels.size();
+}
+
+_NAME_END
@@ -36,11 +36,346 @@
 // +----------------------------------------------------------------------
 #include "modobj.h"
 
-#include <fstream>
-#include <sstream>
+#include <ray/ioserver.h>
+
+#include <thread>
+#include <unordered_map>
 
 _NAME_BEGIN
 
+// Files above this size are split on line boundaries and parsed on several threads.
+constexpr std::size_t ObjParallelThreshold = 1 << 22;
+constexpr std::size_t ObjParallelChunkSize = 1 << 20;
+
+struct ObjIndex
+{
+	std::int32_t v;
+	std::int32_t vt;
+	std::int32_t vn;
+
+	bool operator==(const ObjIndex& other) const noexcept
+	{
+		return v == other.v && vt == other.vt && vn == other.vn;
+	}
+};
+
+struct ObjIndexHash
+{
+	std::size_t operator()(const ObjIndex& index) const noexcept
+	{
+		std::size_t hash = (std::size_t)index.v * 73856093;
+		hash ^= (std::size_t)index.vt * 19349663;
+		hash ^= (std::size_t)index.vn * 83492791;
+		return hash;
+	}
+};
+
+struct ObjChunk
+{
+	const char* begin;
+	const char* end;
+
+	std::size_t numVertices;
+	std::size_t numTexcoords;
+	std::size_t numNormals;
+
+	std::size_t baseVertices;
+	std::size_t baseTexcoords;
+	std::size_t baseNormals;
+
+	std::vector<ObjIndex> faces;
+	std::vector<std::pair<std::size_t, std::string>> usemtl;
+	std::vector<std::string> mtllib;
+};
+
+static inline bool
+IsSpace(char ch) noexcept
+{
+	return ch == ' ' || ch == '\t';
+}
+
+static inline bool
+IsDigit(char ch) noexcept
+{
+	return ch >= '0' && ch <= '9';
+}
+
+static inline const char*
+SkipSpace(const char* it, const char* end) noexcept
+{
+	while (it < end && IsSpace(*it))
+		it++;
+	return it;
+}
+
+static inline const char*
+SkipLine(const char* it, const char* end) noexcept
+{
+	it = (const char*)std::memchr(it, '\n', end - it);
+	return it ? it + 1 : end;
+}
+
+static inline const char*
+LineEnd(const char* it, const char* end) noexcept
+{
+	while (it < end && *it != '\n' && *it != '\r')
+		it++;
+	return it;
+}
+
+static inline std::string
+LineArgument(const char* it, const char* end) noexcept
+{
+	it = SkipSpace(it, end);
+	while (end > it && IsSpace(end[-1]))
+		end--;
+	return std::string(it, end - it);
+}
+
+static const char*
+ParseFloat(const char* it, const char* end, float& out) noexcept
+{
+	static const double powers[] =
+	{
+		1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+		1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19,
+		1e20, 1e21, 1e22
+	};
+
+	it = SkipSpace(it, end);
+
+	bool negative = false;
+	if (it < end && (*it == '-' || *it == '+'))
+		negative = *it++ == '-';
+
+	std::uint64_t mantissa = 0;
+	std::int32_t exponent = 0;
+	std::int32_t digits = 0;
+
+	for (; it < end && IsDigit(*it); it++)
+	{
+		if (digits < 19)
+		{
+			mantissa = mantissa * 10 + (*it - '0');
+			digits += mantissa ? 1 : 0;
+		}
+		else
+		{
+			exponent++;
+		}
+	}
+
+	if (it < end && *it == '.')
+	{
+		for (it++; it < end && IsDigit(*it); it++)
+		{
+			if (digits < 19)
+			{
+				mantissa = mantissa * 10 + (*it - '0');
+				digits += mantissa ? 1 : 0;
+				exponent--;
+			}
+		}
+	}
+
+	if (it < end && (*it == 'e' || *it == 'E'))
+	{
+		const char* mark = it++;
+
+		bool negativeExp = false;
+		if (it < end && (*it == '-' || *it == '+'))
+			negativeExp = *it++ == '-';
+
+		if (it < end && IsDigit(*it))
+		{
+			std::int32_t value = 0;
+			for (; it < end && IsDigit(*it); it++)
+			{
+				if (value < 10000)
+					value = value * 10 + (*it - '0');
+			}
+
+			exponent += negativeExp ? -value : value;
+		}
+		else
+		{
+			it = mark;
+		}
+	}
+
+	double value = (double)mantissa;
+	if (exponent < 0)
+		value = -exponent <= 22 ? value / powers[-exponent] : value * std::pow(10.0, exponent);
+	else if (exponent > 0)
+		value = exponent <= 22 ? value * powers[exponent] : value * std::pow(10.0, exponent);
+
+	out = (float)(negative ? -value : value);
+	return it;
+}
+
+static const char*
+ParseInt(const char* it, const char* end, std::int32_t& out) noexcept
+{
+	bool negative = false;
+	if (it < end && (*it == '-' || *it == '+'))
+		negative = *it++ == '-';
+
+	std::int32_t value = 0;
+	for (; it < end && IsDigit(*it); it++)
+		value = value * 10 + (*it - '0');
+
+	out = negative ? -value : value;
+	return it;
+}
+
+static inline std::int32_t
+ResolveIndex(std::int32_t index, std::size_t count) noexcept
+{
+	if (index > 0)
+		return index - 1;
+	if (index < 0)
+		return (std::int32_t)count + index;
+	return -1;
+}
+
+static inline bool
+IsToken(const char* it, const char* end, const char* token, std::size_t length) noexcept
+{
+	return (std::size_t)(end - it) > length && std::memcmp(it, token, length) == 0 && IsSpace(it[length]);
+}
+
+static void
+CountChunk(ObjChunk& chunk) noexcept
+{
+	chunk.numVertices = 0;
+	chunk.numTexcoords = 0;
+	chunk.numNormals = 0;
+
+	for (const char* it = chunk.begin; it < chunk.end; it = SkipLine(it, chunk.end))
+	{
+		it = SkipSpace(it, chunk.end);
+		if (chunk.end - it < 2 || it[0] != 'v')
+			continue;
+
+		if (IsSpace(it[1]))
+			chunk.numVertices++;
+		else if (it[1] == 't')
+			chunk.numTexcoords++;
+		else if (it[1] == 'n')
+			chunk.numNormals++;
+	}
+}
+
+static void
+ParseChunk(ObjChunk& chunk, Float3Array& vertices, Float2Array& texcoords, Float3Array& normals) noexcept
+{
+	std::size_t numVertices = chunk.baseVertices;
+	std::size_t numTexcoords = chunk.baseTexcoords;
+	std::size_t numNormals = chunk.baseNormals;
+
+	ObjIndex polygon[3];
+
+	for (const char* it = chunk.begin; it < chunk.end; it = SkipLine(it, chunk.end))
+	{
+		it = SkipSpace(it, chunk.end);
+		if (it >= chunk.end)
+			break;
+
+		const char* end = LineEnd(it, chunk.end);
+
+		switch (*it)
+		{
+		case 'v':
+		{
+			if (end - it < 2)
+				break;
+
+			if (IsSpace(it[1]))
+			{
+				float3& v = vertices[numVertices++];
+				it = ParseFloat(it + 1, end, v.x);
+				it = ParseFloat(it, end, v.y);
+				it = ParseFloat(it, end, v.z);
+			}
+			else if (it[1] == 't')
+			{
+				float2& vt = texcoords[numTexcoords++];
+				it = ParseFloat(it + 2, end, vt.x);
+				it = ParseFloat(it, end, vt.y);
+			}
+			else if (it[1] == 'n')
+			{
+				float3& vn = normals[numNormals++];
+				it = ParseFloat(it + 2, end, vn.x);
+				it = ParseFloat(it, end, vn.y);
+				it = ParseFloat(it, end, vn.z);
+			}
+		}
+		break;
+		case 'f':
+		{
+			if (end - it < 2 || !IsSpace(it[1]))
+				break;
+
+			std::size_t count = 0;
+
+			for (it = SkipSpace(it + 1, end); it < end; it = SkipSpace(it, end))
+			{
+				std::int32_t v = 0, vt = 0, vn = 0;
+
+				it = ParseInt(it, end, v);
+				if (it < end && *it == '/')
+				{
+					if (++it < end && *it != '/')
+						it = ParseInt(it, end, vt);
+					if (it < end && *it == '/')
+						it = ParseInt(it + 1, end, vn);
+				}
+
+				if (v == 0)
+					break;
+
+				ObjIndex index;
+				index.v = ResolveIndex(v, numVertices);
+				index.vt = ResolveIndex(vt, numTexcoords);
+				index.vn = ResolveIndex(vn, numNormals);
+
+				// polygons are triangulated as a fan around their first vertex
+				if (count < 3)
+					polygon[count] = index;
+				else
+				{
+					polygon[1] = polygon[2];
+					polygon[2] = index;
+				}
+
+				if (++count >= 3)
+				{
+					chunk.faces.push_back(polygon[0]);
+					chunk.faces.push_back(polygon[1]);
+					chunk.faces.push_back(polygon[2]);
+				}
+			}
+		}
+		break;
+		case 'u':
+		{
+			if (IsToken(it, end, "usemtl", 6))
+				chunk.usemtl.emplace_back(chunk.faces.size() / 3, LineArgument(it + 6, end));
+		}
+		break;
+		case 'm':
+		{
+			if (IsToken(it, end, "mtllib", 6))
+				chunk.mtllib.push_back(LineArgument(it + 6, end));
+		}
+		break;
+		default:
+			break;
+		}
+	}
+}
+
 ObjHandler::ObjHandler() noexcept
 {
 }
@@ -112,16 +447,23 @@ ObjHandler::doCanRead(const char* type) const noexcept
 bool
 ObjHandler::doLoad(StreamReader& stream, Model& model) noexcept
 {
-	streamsize size = stream.gcount();
+	streamsize size = stream.size();
 	if (size < 16)
 		return false;
 
-	std::unique_ptr<char> data(new char[(std::size_t)size]);
-	stream.read(data.get(), size);
+	std::vector<char> data((std::size_t)size);
+	if (!stream.read(data.data(), size))
+		return false;
 
 	_model = &model;
+	_materials.clear();
+
+	bool result = this->parser(data.data(), data.size());
 
-	return this->parser(data.get(), (std::size_t)size);
+	_model = nullptr;
+	_materials.clear();
+
+	return result;
 }
 
 bool
@@ -131,136 +473,369 @@ ObjHandler::doSave(StreamWrite& stream, const Model& model) noexcept
 }
 
 bool
-ObjHandler::parser(char* data, std::size_t)
+ObjHandler::parser(const char* data, std::size_t size) noexcept
 {
-	std::ifstream infile(data);
-	std::string line;
+	std::size_t numChunks = 1;
+	if (size > ObjParallelThreshold)
+		numChunks = std::max<std::size_t>(1, std::min<std::size_t>(std::thread::hardware_concurrency(), size / ObjParallelChunkSize));
 
-	std::string s1;
+	std::vector<ObjChunk> chunks(numChunks);
 
-	Float3Array _vn;
-	Float2Array _vt;
-	Float3Array _v;
+	const char* end = data + size;
+	const char* begin = data;
 
-	std::vector<float> _fv;
-	std::vector<float> _ft;
-	std::vector<float> _fn;
+	for (std::size_t i = 0; i < numChunks; i++)
+	{
+		const char* next = (i + 1 < numChunks) ? SkipLine(data + size * (i + 1) / numChunks, end) : end;
+		chunks[i].begin = begin;
+		chunks[i].end = std::max(begin, next);
+		begin = chunks[i].end;
+	}
 
-	while (std::getline(infile, line))
+	auto parallelFor = [&](const std::function<void(ObjChunk&)>& func)
 	{
-		switch (line[0])
+		if (numChunks == 1)
 		{
-		case 'v':
+			func(chunks.front());
+			return;
+		}
+
+		std::vector<std::thread> threads;
+		threads.reserve(numChunks);
+
+		for (auto& chunk : chunks)
+			threads.emplace_back(func, std::ref(chunk));
+
+		for (auto& thread : threads)
+			thread.join();
+	};
+
+	parallelFor(CountChunk);
+
+	std::size_t numVertices = 0;
+	std::size_t numTexcoords = 0;
+	std::size_t numNormals = 0;
+
+	for (auto& chunk : chunks)
+	{
+		chunk.baseVertices = numVertices;
+		chunk.baseTexcoords = numTexcoords;
+		chunk.baseNormals = numNormals;
+
+		numVertices += chunk.numVertices;
+		numTexcoords += chunk.numTexcoords;
+		numNormals += chunk.numNormals;
+	}
+
+	if (numVertices == 0)
+		return false;
+
+	Float3Array vertices(numVertices);
+	Float2Array texcoords(numTexcoords);
+	Float3Array normals(numNormals);
+
+	parallelFor([&](ObjChunk& chunk) { ParseChunk(chunk, vertices, texcoords, normals); });
+
+	for (auto& chunk : chunks)
+	{
+		for (auto& name : chunk.mtllib)
 		{
-			if (line[1] == ' ')
-			{
-				_v.push_back(this->parseVector3(line));
+			StreamReaderPtr stream;
+			if (!IoServer::instance()->openFileURL(stream, _model->getDirectory() + name))
 				continue;
-			}
-			if (line[1] == 't')
-			{
-				_vt.push_back(this->parseVector2(line));
-				continue;
-			}
-			if (line[1] == 'n')
-			{
-				_vn.push_back(this->parseVector3(line));
+
+			std::vector<char> library((std::size_t)stream->size());
+			if (library.empty() || !stream->read(library.data(), library.size()))
 				continue;
-			}
+
+			this->parserMaterial(library.data(), library.size());
 		}
-		case 'p':
-		case 'l':
-		case 'f':
-		{
-			std::istringstream in(line);
-			float a;
+	}
 
-			for (std::size_t i = 0; i < 3; i++)
-			{
-				in >> s1;
-				a = 0;
-				std::size_t k;
+	std::vector<std::string> materialNames;
+	std::vector<std::uint32_t> faceMaterials;
 
-				for (k = 0; s1[k] != '/'; k++)
-					a = a * 10 + (s1[k] - 48);
+	std::size_t numFaces = 0;
+	for (auto& chunk : chunks)
+		numFaces += chunk.faces.size() / 3;
 
-				_fv.push_back(a);
+	if (numFaces == 0)
+		return false;
 
-				for (k = k + 1; s1[k] != '/'; k++)
-					a = a * 10 + (s1[k] - 48);
+	faceMaterials.reserve(numFaces);
 
-				_ft.push_back(a);
+	std::uint32_t material = 0;
 
-				a = 0;
-				for (k = k + 2; s1[k]; k++)
-					a = a * 10 + (s1[k] - 48);
+	for (auto& chunk : chunks)
+	{
+		auto usemtl = chunk.usemtl.begin();
+		auto numChunkFaces = chunk.faces.size() / 3;
 
-				_fn.push_back(a);
+		for (std::size_t i = 0; i <= numChunkFaces; i++)
+		{
+			for (; usemtl != chunk.usemtl.end() && usemtl->first == i; ++usemtl)
+			{
+				auto it = std::find(materialNames.begin(), materialNames.end(), usemtl->second);
+				material = (std::uint32_t)std::distance(materialNames.begin(), it);
+				if (it == materialNames.end())
+					materialNames.push_back(usemtl->second);
 			}
+
+			if (i < numChunkFaces)
+				faceMaterials.push_back(material);
 		}
-		continue;
-		case '#':
+	}
+
+	if (materialNames.empty())
+		materialNames.push_back("default");
+
+	bool hasTexcoord = false;
+	bool hasNormal = false;
+	bool isPositionOnly = true;
+
+	for (auto& chunk : chunks)
+	{
+		for (auto& it : chunk.faces)
 		{
+			if (it.v < 0 || it.v >= (std::int32_t)numVertices)
+				return false;
+
+			if (it.vt >= (std::int32_t)numTexcoords)
+				it.vt = -1;
+			if (it.vn >= (std::int32_t)numNormals)
+				it.vn = -1;
+
+			hasTexcoord |= it.vt >= 0;
+			hasNormal |= it.vn >= 0;
+			isPositionOnly &= (it.vt < 0 || it.vt == it.v) && (it.vn < 0 || it.vn == it.v);
 		}
-		break;
-		case 'u':
+	}
+
+	// sort triangles by material with a counting sort, so every material maps to one contiguous subset
+	std::vector<std::uint32_t> offsets(materialNames.size() + 1, 0);
+	for (auto& it : faceMaterials)
+		offsets[it + 1]++;
+
+	for (std::size_t i = 1; i < offsets.size(); i++)
+		offsets[i] += offsets[i - 1];
+
+	MeshSubsets subsets;
+	for (std::size_t i = 0; i < materialNames.size(); i++)
+		subsets.push_back(MeshSubset(0, offsets[i] * 3, (offsets[i + 1] - offsets[i]) * 3, 0, 0));
+
+	UintArray indices(numFaces * 3);
+
+	Float3Array meshVertices;
+	Float3Array meshNormals;
+	Float2Array meshTexcoords;
+
+	std::unordered_map<ObjIndex, std::uint32_t, ObjIndexHash> uniqueIndices;
+
+	if (isPositionOnly)
+	{
+		// each position is referenced with its own texcoord and normal, the arrays can be used without welding
+		meshVertices = std::move(vertices);
+
+		if (hasTexcoord)
 		{
+			meshTexcoords = std::move(texcoords);
+			meshTexcoords.resize(numVertices);
 		}
-		break;
-		case 'g':
+
+		if (hasNormal)
 		{
+			meshNormals = std::move(normals);
+			meshNormals.resize(numVertices);
 		}
-		break;
-		case 's':
+	}
+	else
+	{
+		uniqueIndices.reserve(numVertices);
+
+		meshVertices.reserve(numVertices);
+		if (hasTexcoord) meshTexcoords.reserve(numVertices);
+		if (hasNormal) meshNormals.reserve(numVertices);
+	}
+
+	std::size_t face = 0;
+
+	for (auto& chunk : chunks)
+	{
+		for (std::size_t i = 0; i < chunk.faces.size(); i += 3, face++)
 		{
+			std::size_t offset = offsets[faceMaterials[face]]++ * 3;
+
+			for (std::size_t j = 0; j < 3; j++)
+			{
+				const ObjIndex& index = chunk.faces[i + j];
+
+				if (isPositionOnly)
+				{
+					indices[offset + j] = index.v;
+					continue;
+				}
+
+				auto it = uniqueIndices.find(index);
+				if (it != uniqueIndices.end())
+				{
+					indices[offset + j] = it->second;
+					continue;
+				}
+
+				std::uint32_t n = (std::uint32_t)meshVertices.size();
+
+				meshVertices.push_back(vertices[index.v]);
+
+				if (hasTexcoord)
+					meshTexcoords.push_back(index.vt >= 0 ? texcoords[index.vt] : float2::Zero);
+				if (hasNormal)
+					meshNormals.push_back(index.vn >= 0 ? normals[index.vn] : float3::Zero);
+
+				uniqueIndices.emplace(index, n);
+				indices[offset + j] = n;
+			}
 		}
-		break;
-		case 'o':
+	}
+
+	for (auto& name : materialNames)
+	{
+		auto it = _materials.find(name);
+		if (it != _materials.end())
 		{
+			_model->addMaterial(it->second);
 		}
-		break;
-		default:
-			break;
+		else
+		{
+			auto material = std::make_shared<MaterialProperty>();
+			material->set(MATKEY_NAME, name);
+			material->set(MATKEY_COLOR_DIFFUSE, Vector3::One);
+			_model->addMaterial(std::move(material));
 		}
 	}
 
+	MeshPropertyPtr mesh = std::make_shared<MeshProperty>();
+	mesh->setVertexArray(std::move(meshVertices));
+	mesh->setIndicesArray(std::move(indices));
+	mesh->setMeshSubsets(std::move(subsets));
+
+	if (hasTexcoord)
+		mesh->setTexcoordArray(std::move(meshTexcoords));
+
+	if (hasNormal)
+		mesh->setNormalArray(std::move(meshNormals));
+	else
+		mesh->computeVertexNormals();
+
+	_model->addMesh(std::move(mesh));
+
 	return true;
 }
 
-Vector2
-ObjHandler::parseVector2(const std::string& line)
+bool
+ObjHandler::parserMaterial(const char* data, std::size_t size) noexcept
 {
-	std::string s1;
-	float f1, f2;
+	MaterialPropertyPtr material;
 
-	std::istringstream sin(line);
-	sin >> s1 >> f1 >> f2;
+	const char* end = data + size;
 
-	return Vector2(f1, f2);
-}
+	for (const char* it = data; it < end; it = SkipLine(it, end))
+	{
+		it = SkipSpace(it, end);
 
-Vector3
-ObjHandler::parseVector3(const std::string& line)
-{
-	std::string s1;
-	float f1, f2, f3;
+		const char* last = LineEnd(it, end);
+		while (last > it && IsSpace(last[-1]))
+			last--;
 
-	std::istringstream sin(line);
-	sin >> s1 >> f1 >> f2 >> f3;
+		if (it >= last || *it == '#')
+			continue;
 
-	return Vector3(f1, f2, f3);
-}
+		const char* token = it;
+		while (it < last && !IsSpace(*it))
+			it++;
 
-Vector4
-ObjHandler::parseVector4(const std::string& line)
-{
-	std::string s1;
-	float f1, f2, f3, f4;
+		std::size_t length = it - token;
+
+		it = SkipSpace(it, last);
+
+		if (length == 6 && std::memcmp(token, "newmtl", 6) == 0)
+		{
+			material = std::make_shared<MaterialProperty>();
+			material->set(MATKEY_NAME, std::string(it, last - it));
+
+			_materials[std::string(it, last - it)] = material;
+			continue;
+		}
+
+		if (!material)
+			continue;
+
+		if (length == 2 && (token[0] == 'K' || token[0] == 'k'))
+		{
+			Vector3 color;
+			it = ParseFloat(it, last, color.x);
+			it = ParseFloat(it, last, color.y);
+			it = ParseFloat(it, last, color.z);
+
+			color = math::srgb2linear(color);
+
+			if (token[1] == 'd')
+				material->set(MATKEY_COLOR_DIFFUSE, color);
+			else if (token[1] == 'a')
+				material->set(MATKEY_COLOR_AMBIENT, color);
+			else if (token[1] == 's')
+				material->set(MATKEY_COLOR_SPECULAR, color);
+			else if (token[1] == 'e')
+				material->set(MATKEY_COLOR_EMISSIVE, color);
+		}
+		else if (length == 2 && std::memcmp(token, "Ns", 2) == 0)
+		{
+			float shininess = 0.0f;
+			ParseFloat(it, last, shininess);
+			material->set(MATKEY_SHININESS, math::clamp(shininess / 1000.0f, 0.0f, 1.0f));
+		}
+		else if (length == 1 && token[0] == 'd')
+		{
+			float opacity = 1.0f;
+			ParseFloat(it, last, opacity);
+			material->set(MATKEY_OPACITY, opacity);
+		}
+		else if (length == 2 && std::memcmp(token, "Tr", 2) == 0)
+		{
+			float transparent = 0.0f;
+			ParseFloat(it, last, transparent);
+			material->set(MATKEY_OPACITY, 1.0f - transparent);
+		}
+		else if ((length > 4 && std::memcmp(token, "map_", 4) == 0) || (length == 4 && std::memcmp(token, "bump", 4) == 0) || (length == 4 && std::memcmp(token, "norm", 4) == 0))
+		{
+			// texture options come before the filename, which is taken as the last argument of the line
+			const char* name = last;
+			while (name > it && !IsSpace(name[-1]))
+				name--;
 
-	std::istringstream sin(line);
-	sin >> s1 >> f1 >> f2 >> f3 >> f4;
+			std::string filename(name, last - name);
+			std::string type = length > 4 ? std::string(token + 4, length - 4) : std::string(token, length);
 
-	return Vector4(f1, f2, f3, f4);
+			if (type == "Kd")
+			{
+				material->set(MATKEY_TEXTURE_DIFFUSE(0), filename);
+				material->set(MATKEY_TEXTURE_AMBIENT(0), filename);
+			}
+			else if (type == "Ks")
+				material->set(MATKEY_TEXTURE_SPECULAR(0), filename);
+			else if (type == "Ke")
+				material->set(MATKEY_TEXTURE_EMISSIVE(0), filename);
+			else if (type == "Ns")
+				material->set(MATKEY_TEXTURE_SHININESS(0), filename);
+			else if (type == "d")
+				material->set(MATKEY_TEXTURE_OPACITY(0), filename);
+			else if (type == "Bump" || type == "bump" || type == "norm")
+				material->set(MATKEY_TEXTURE_NORMALS(0), filename);
+			else if (type == "disp")
+				material->set(MATKEY_TEXTURE_DISPLACEMENT(0), filename);
+		}
+	}
+
+	return true;
 }
 
 _NAME_END
\ No newline at end of file
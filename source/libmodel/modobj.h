@@ -57,13 +57,12 @@ private:
 
 	static bool SearchFileHeaderForToken(StreamReader* stream, const char** tokens, unsigned int numTokens, unsigned int searchBytes = 200, bool tokensSol = false);
 
-	bool parser(char* data, std::size_t size);
-
-	static Vector2 parseVector2(const std::string& line);
-	static Vector3 parseVector3(const std::string& line);
-	static Vector4 parseVector4(const std::string& line);
+	bool parser(const char* data, std::size_t size) noexcept;
+	bool parserMaterial(const char* data, std::size_t size) noexcept;
 
 	Model* _model;
+
+	std::map<std::string, MaterialPropertyPtr> _materials;
 };
 
 _NAME_END
@@ -0,0 +1,855 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2016.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include <ray/modopt.h>
+#include <algorithm>
+#include <cstring>
+
+_NAME_BEGIN
+
+namespace
+{
+	const std::uint32_t kCacheSize = 32;
+	const float kCacheDecayPower = 1.5f;
+	const float kLastTriScore = 0.75f;
+	const float kValenceBoostScale = 2.0f;
+	const float kValenceBoostPower = 0.5f;
+
+	const std::uint32_t kFifoCacheSize = 16;
+
+	float
+	vertexScore(std::int32_t cachePosition, std::uint32_t remaining) noexcept
+	{
+		if (remaining == 0)
+			return -1.0f;
+
+		float score = 0.0f;
+		if (cachePosition >= 0)
+		{
+			if (cachePosition < 3)
+				score = kLastTriScore;
+			else
+			{
+				float scaler = 1.0f / (kCacheSize - 3);
+				score = std::pow(1.0f - (cachePosition - 3) * scaler, kCacheDecayPower);
+			}
+		}
+
+		return score + kValenceBoostScale * std::pow((float)remaining, -kValenceBoostPower);
+	}
+
+	std::uint32_t
+	updateCache(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t cacheSize, std::uint32_t* timestamps, std::uint32_t& timestamp) noexcept
+	{
+		std::uint32_t misses = 0;
+
+		if (timestamp - timestamps[a] > cacheSize) { timestamps[a] = timestamp++; misses++; }
+		if (timestamp - timestamps[b] > cacheSize) { timestamps[b] = timestamp++; misses++; }
+		if (timestamp - timestamps[c] > cacheSize) { timestamps[c] = timestamp++; misses++; }
+
+		return misses;
+	}
+
+	template<typename T>
+	void
+	remapArray(std::vector<T>& array, const std::vector<std::uint32_t>& remap, std::size_t count) noexcept
+	{
+		if (array.size() != remap.size())
+			return;
+
+		std::vector<T> result(count);
+		for (std::size_t i = 0; i < remap.size(); i++)
+		{
+			if (remap[i] != UINT32_MAX)
+				result[remap[i]] = array[i];
+		}
+
+		array.swap(result);
+	}
+
+	void
+	remapVertices(MeshProperty& mesh, const std::vector<std::uint32_t>& remap, std::size_t count) noexcept
+	{
+		remapArray(mesh.getNormalArray(), remap, count);
+		remapArray(mesh.getColorArray(), remap, count);
+		remapArray(mesh.getTangentArray(), remap, count);
+		remapArray(mesh.getWeightArray(), remap, count);
+
+		for (std::uint8_t i = 0; i < TEXTURE_ARRAY_COUNT; i++)
+			remapArray(mesh.getTexcoordArray(i), remap, count);
+
+		remapArray(mesh.getVertexArray(), remap, count);
+	}
+
+	template<typename T>
+	void
+	appendStream(std::vector<std::pair<const std::uint8_t*, std::size_t>>& streams, const std::vector<T>& array, std::size_t numVertices) noexcept
+	{
+		if (array.size() == numVertices)
+			streams.push_back(std::make_pair((const std::uint8_t*)array.data(), sizeof(T)));
+	}
+
+	std::uint32_t
+	hashBytes(const std::uint8_t* data, std::size_t length) noexcept
+	{
+		std::uint32_t hash = 2166136261u;
+		for (std::size_t i = 0; i < length; i++)
+		{
+			hash ^= data[i];
+			hash *= 16777619u;
+		}
+
+		return hash;
+	}
+
+	void
+	optimizeVertexCacheSubset(std::uint32_t* indices, std::size_t numIndices, std::vector<std::uint32_t>& localRemap) noexcept
+	{
+		std::size_t numTriangles = numIndices / 3;
+		if (numTriangles < 2)
+			return;
+
+		std::vector<std::uint32_t> vertices;
+		std::vector<std::uint32_t> local(numTriangles * 3);
+
+		for (std::size_t i = 0; i < local.size(); i++)
+		{
+			std::uint32_t index = indices[i];
+			if (localRemap[index] == UINT32_MAX)
+			{
+				localRemap[index] = (std::uint32_t)vertices.size();
+				vertices.push_back(index);
+			}
+
+			local[i] = localRemap[index];
+		}
+
+		for (auto& it : vertices)
+			localRemap[it] = UINT32_MAX;
+
+		std::size_t numVertices = vertices.size();
+
+		std::vector<std::uint32_t> remaining(numVertices, 0);
+		for (auto& it : local)
+			remaining[it]++;
+
+		std::vector<std::uint32_t> offsets(numVertices + 1, 0);
+		for (std::size_t i = 0; i < numVertices; i++)
+			offsets[i + 1] = offsets[i] + remaining[i];
+
+		std::vector<std::uint32_t> adjacency(local.size());
+		std::vector<std::uint32_t> filled(offsets.begin(), offsets.end() - 1);
+		for (std::size_t i = 0; i < local.size(); i++)
+			adjacency[filled[local[i]]++] = (std::uint32_t)(i / 3);
+
+		std::vector<float> vertexScores(numVertices);
+		for (std::size_t i = 0; i < numVertices; i++)
+			vertexScores[i] = vertexScore(-1, remaining[i]);
+
+		std::vector<float> triangleScores(numTriangles);
+		std::vector<std::uint8_t> emitted(numTriangles, 0);
+
+		std::uint32_t best = 0;
+		for (std::size_t i = 0; i < numTriangles; i++)
+		{
+			triangleScores[i] = vertexScores[local[i * 3]] + vertexScores[local[i * 3 + 1]] + vertexScores[local[i * 3 + 2]];
+			if (triangleScores[i] > triangleScores[best])
+				best = (std::uint32_t)i;
+		}
+
+		std::uint32_t cache[kCacheSize + 3];
+		std::uint32_t cacheNew[kCacheSize + 3];
+		std::uint32_t cacheCount = 0;
+
+		std::vector<std::uint32_t> result(numTriangles * 3);
+		std::size_t cursor = 0;
+
+		for (std::size_t t = 0; t < numTriangles; t++)
+		{
+			if (best == UINT32_MAX)
+			{
+				while (emitted[cursor])
+					cursor++;
+				best = (std::uint32_t)cursor;
+			}
+
+			const std::uint32_t* tri = &local[best * 3];
+
+			result[t * 3] = vertices[tri[0]];
+			result[t * 3 + 1] = vertices[tri[1]];
+			result[t * 3 + 2] = vertices[tri[2]];
+
+			emitted[best] = 1;
+
+			std::uint32_t cacheNewCount = 0;
+
+			for (std::uint8_t k = 0; k < 3; k++)
+			{
+				std::uint32_t v = tri[k];
+
+				std::uint32_t* begin = &adjacency[offsets[v]];
+				std::uint32_t* end = begin + remaining[v];
+				std::uint32_t* it = std::find(begin, end, best);
+				if (it != end)
+				{
+					*it = *(end - 1);
+					remaining[v]--;
+				}
+
+				if (std::find(cacheNew, cacheNew + cacheNewCount, v) == cacheNew + cacheNewCount)
+					cacheNew[cacheNewCount++] = v;
+			}
+
+			for (std::uint32_t i = 0; i < cacheCount; i++)
+			{
+				std::uint32_t v = cache[i];
+				if (v != tri[0] && v != tri[1] && v != tri[2])
+					cacheNew[cacheNewCount++] = v;
+			}
+
+			for (std::uint32_t i = 0; i < cacheNewCount; i++)
+			{
+				std::uint32_t v = cacheNew[i];
+				std::int32_t position = i < kCacheSize ? (std::int32_t)i : -1;
+
+				float score = vertexScore(position, remaining[v]);
+				float delta = score - vertexScores[v];
+
+				vertexScores[v] = score;
+
+				for (std::uint32_t j = offsets[v]; j < offsets[v] + remaining[v]; j++)
+					triangleScores[adjacency[j]] += delta;
+			}
+
+			cacheCount = std::min(cacheNewCount, kCacheSize);
+			std::copy(cacheNew, cacheNew + cacheCount, cache);
+
+			best = UINT32_MAX;
+			float bestScore = 0.0f;
+
+			for (std::uint32_t i = 0; i < cacheCount; i++)
+			{
+				std::uint32_t v = cache[i];
+				for (std::uint32_t j = offsets[v]; j < offsets[v] + remaining[v]; j++)
+				{
+					std::uint32_t triangle = adjacency[j];
+					if (triangleScores[triangle] > bestScore)
+					{
+						best = triangle;
+						bestScore = triangleScores[triangle];
+					}
+				}
+			}
+		}
+
+		std::copy(result.begin(), result.end(), indices);
+	}
+
+	void
+	optimizeOverdrawSubset(std::uint32_t* indices, std::size_t numIndices, const float3* vertices, std::uint32_t* timestamps, std::uint32_t& timestamp, float threshold) noexcept
+	{
+		std::size_t numTriangles = numIndices / 3;
+		if (numTriangles < 2)
+			return;
+
+		std::vector<std::uint32_t> hardClusters;
+		std::vector<std::uint32_t> hardMisses;
+
+		timestamp += kFifoCacheSize + 1;
+
+		for (std::size_t i = 0; i < numTriangles; i++)
+		{
+			std::uint32_t misses = updateCache(indices[i * 3], indices[i * 3 + 1], indices[i * 3 + 2], kFifoCacheSize, timestamps, timestamp);
+			if (i == 0 || misses == 3)
+			{
+				hardClusters.push_back((std::uint32_t)i);
+				hardMisses.push_back(0);
+			}
+
+			hardMisses.back() += misses;
+		}
+
+		std::vector<std::uint32_t> clusters;
+
+		for (std::size_t i = 0; i < hardClusters.size(); i++)
+		{
+			std::uint32_t start = hardClusters[i];
+			std::uint32_t end = i + 1 < hardClusters.size() ? hardClusters[i + 1] : (std::uint32_t)numTriangles;
+
+			float clusterThreshold = threshold * hardMisses[i] / (end - start);
+
+			std::uint32_t clusterStart = start;
+			std::uint32_t clusterMisses = 0;
+
+			timestamp += kFifoCacheSize + 1;
+
+			for (std::uint32_t j = start; j < end; j++)
+			{
+				clusterMisses += updateCache(indices[j * 3], indices[j * 3 + 1], indices[j * 3 + 2], kFifoCacheSize, timestamps, timestamp);
+
+				if (j + 1 < end && clusterMisses <= (j + 1 - clusterStart) * clusterThreshold)
+				{
+					clusters.push_back(clusterStart);
+
+					clusterStart = j + 1;
+					clusterMisses = 0;
+
+					timestamp += kFifoCacheSize + 1;
+				}
+			}
+
+			clusters.push_back(clusterStart);
+		}
+
+		if (clusters.size() < 2)
+			return;
+
+		std::vector<float3> centroids(clusters.size(), float3::Zero);
+		std::vector<float3> normals(clusters.size(), float3::Zero);
+
+		float3 meshCentroid = float3::Zero;
+		float meshArea = 0.0f;
+
+		for (std::size_t i = 0; i < clusters.size(); i++)
+		{
+			std::uint32_t start = clusters[i];
+			std::uint32_t end = i + 1 < clusters.size() ? clusters[i + 1] : (std::uint32_t)numTriangles;
+
+			float clusterArea = 0.0f;
+
+			for (std::uint32_t j = start; j < end; j++)
+			{
+				const float3& a = vertices[indices[j * 3]];
+				const float3& b = vertices[indices[j * 3 + 1]];
+				const float3& c = vertices[indices[j * 3 + 2]];
+
+				float3 normal = math::cross(b - a, c - a);
+				float area = math::length(normal);
+
+				centroids[i] += (a + b + c) * (area / 3.0f);
+				normals[i] += normal;
+				clusterArea += area;
+			}
+
+			meshCentroid += centroids[i];
+			meshArea += clusterArea;
+
+			centroids[i] = clusterArea > 0.0f ? centroids[i] / clusterArea : vertices[indices[start * 3]];
+			normals[i] = math::normalize(normals[i]);
+		}
+
+		if (meshArea > 0.0f)
+			meshCentroid /= meshArea;
+
+		std::vector<float> sortKeys(clusters.size());
+		for (std::size_t i = 0; i < clusters.size(); i++)
+			sortKeys[i] = math::dot(centroids[i] - meshCentroid, normals[i]);
+
+		std::vector<std::uint32_t> order(clusters.size());
+		for (std::size_t i = 0; i < order.size(); i++)
+			order[i] = (std::uint32_t)i;
+
+		std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+		std::vector<std::uint32_t> result;
+		result.reserve(numTriangles * 3);
+
+		for (auto& it : order)
+		{
+			std::uint32_t start = clusters[it];
+			std::uint32_t end = it + 1 < clusters.size() ? clusters[it + 1] : (std::uint32_t)numTriangles;
+			result.insert(result.end(), indices + start * 3, indices + end * 3);
+		}
+
+		std::copy(result.begin(), result.end(), indices);
+	}
+
+	void
+	computeClusterBounds(const MeshProperty& mesh, const std::uint32_t* indices, MeshCluster& cluster) noexcept
+	{
+		const auto& vertices = mesh.getVertexArray();
+		const auto& normals = mesh.getNormalArray();
+
+		float3 minimum = vertices[indices[0]];
+		float3 maximum = vertices[indices[0]];
+
+		for (std::size_t i = 0; i < cluster.indicesCount; i++)
+		{
+			minimum = math::min(minimum, vertices[indices[i]]);
+			maximum = math::max(maximum, vertices[indices[i]]);
+		}
+
+		cluster.center = (minimum + maximum) * 0.5f;
+		cluster.radius = 0.0f;
+
+		for (std::size_t i = 0; i < cluster.indicesCount; i++)
+			cluster.radius = std::max(cluster.radius, math::distance(cluster.center, vertices[indices[i]]));
+
+		cluster.coneAxis = float3::UnitZ;
+		cluster.coneCutoff = 1.0f;
+
+		if (normals.size() != vertices.size())
+			return;
+
+		std::size_t numTriangles = cluster.indicesCount / 3;
+
+		std::vector<float3> faceNormals;
+		faceNormals.reserve(numTriangles);
+
+		float3 axis = float3::Zero;
+
+		for (std::size_t i = 0; i < numTriangles; i++)
+		{
+			const std::uint32_t* tri = indices + i * 3;
+
+			float3 n = math::cross(vertices[tri[1]] - vertices[tri[0]], vertices[tri[2]] - vertices[tri[0]]);
+			float length = math::length(n);
+			if (length == 0.0f)
+				continue;
+
+			n /= length;
+
+			if (math::dot(n, normals[tri[0]] + normals[tri[1]] + normals[tri[2]]) < 0.0f)
+				n = -n;
+
+			faceNormals.push_back(n);
+			axis += n;
+		}
+
+		float length = math::length(axis);
+		if (faceNormals.empty() || length == 0.0f)
+			return;
+
+		axis /= length;
+
+		float minDot = 1.0f;
+		for (auto& it : faceNormals)
+			minDot = std::min(minDot, math::dot(axis, it));
+
+		if (minDot <= 0.0f)
+			return;
+
+		cluster.coneAxis = axis;
+		cluster.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+	}
+}
+
+float
+computeACMR(const std::uint32_t* indices, std::size_t numIndices, std::size_t numVertices, std::uint32_t cacheSize) noexcept
+{
+	std::size_t numTriangles = numIndices / 3;
+	if (numTriangles == 0)
+		return 0.0f;
+
+	std::vector<std::uint32_t> timestamps(numVertices, 0);
+	std::uint32_t timestamp = cacheSize + 1;
+
+	std::size_t misses = 0;
+	for (std::size_t i = 0; i < numTriangles; i++)
+		misses += updateCache(indices[i * 3], indices[i * 3 + 1], indices[i * 3 + 2], cacheSize, timestamps.data(), timestamp);
+
+	return (float)misses / numTriangles;
+}
+
+float
+computeATVR(const std::uint32_t* indices, std::size_t numIndices, std::size_t numVertices, std::uint32_t cacheSize) noexcept
+{
+	std::size_t numTriangles = numIndices / 3;
+	if (numTriangles == 0)
+		return 0.0f;
+
+	std::vector<std::uint32_t> timestamps(numVertices, 0);
+	std::uint32_t timestamp = cacheSize + 1;
+
+	std::size_t misses = 0;
+	for (std::size_t i = 0; i < numTriangles; i++)
+		misses += updateCache(indices[i * 3], indices[i * 3 + 1], indices[i * 3 + 2], cacheSize, timestamps.data(), timestamp);
+
+	std::size_t referenced = 0;
+	for (auto& it : timestamps)
+		referenced += it != 0 ? 1 : 0;
+
+	return referenced > 0 ? (float)misses / referenced : 0.0f;
+}
+
+std::size_t
+weldVertices(MeshProperty& mesh) noexcept
+{
+	std::size_t numVertices = mesh.getNumVertices();
+	if (numVertices == 0)
+		return 0;
+
+	std::vector<std::pair<const std::uint8_t*, std::size_t>> streams;
+	appendStream(streams, mesh.getVertexArray(), numVertices);
+	appendStream(streams, mesh.getNormalArray(), numVertices);
+	appendStream(streams, mesh.getColorArray(), numVertices);
+	appendStream(streams, mesh.getTangentArray(), numVertices);
+	appendStream(streams, mesh.getWeightArray(), numVertices);
+
+	for (std::uint8_t i = 0; i < TEXTURE_ARRAY_COUNT; i++)
+		appendStream(streams, mesh.getTexcoordArray(i), numVertices);
+
+	std::size_t stride = 0;
+	for (auto& it : streams)
+		stride += it.second;
+
+	std::vector<std::uint8_t> packed(numVertices * stride);
+	for (std::size_t i = 0; i < numVertices; i++)
+	{
+		std::uint8_t* data = packed.data() + i * stride;
+		for (auto& it : streams)
+		{
+			std::memcpy(data, it.first + i * it.second, it.second);
+			data += it.second;
+		}
+	}
+
+	std::size_t tableSize = 16;
+	while (tableSize < numVertices * 2)
+		tableSize <<= 1;
+
+	std::vector<std::uint32_t> table(tableSize, UINT32_MAX);
+	std::vector<std::uint32_t> remap(numVertices);
+
+	std::size_t count = 0;
+
+	for (std::size_t i = 0; i < numVertices; i++)
+	{
+		const std::uint8_t* data = packed.data() + i * stride;
+
+		std::size_t bucket = hashBytes(data, stride) & (tableSize - 1);
+		for (std::size_t probe = 1; ; probe++)
+		{
+			std::uint32_t& entry = table[bucket];
+			if (entry == UINT32_MAX)
+			{
+				entry = (std::uint32_t)i;
+				remap[i] = (std::uint32_t)count++;
+				break;
+			}
+
+			if (std::memcmp(packed.data() + entry * stride, data, stride) == 0)
+			{
+				remap[i] = remap[entry];
+				break;
+			}
+
+			bucket = (bucket + probe) & (tableSize - 1);
+		}
+	}
+
+	if (count == numVertices)
+		return count;
+
+	for (auto& it : mesh.getIndicesArray())
+		it = remap[it];
+
+	for (auto& level : mesh.getMeshLevels())
+	{
+		for (auto& it : level.indices)
+			it = remap[it];
+	}
+
+	remapVertices(mesh, remap, count);
+
+	return count;
+}
+
+void
+optimizeVertexCache(MeshProperty& mesh) noexcept
+{
+	auto& indices = mesh.getIndicesArray();
+	if (indices.empty())
+		return;
+
+	mesh.getMeshClusters().clear();
+
+	std::vector<std::uint32_t> localRemap(mesh.getNumVertices(), UINT32_MAX);
+
+	for (auto& it : mesh.getMeshSubsets())
+	{
+		if (it.startIndices + it.indicesCount <= indices.size())
+			optimizeVertexCacheSubset(indices.data() + it.startIndices, it.indicesCount, localRemap);
+	}
+}
+
+void
+optimizeVertexCache(std::uint32_t* indices, std::size_t numIndices, std::size_t numVertices) noexcept
+{
+	std::vector<std::uint32_t> localRemap(numVertices, UINT32_MAX);
+	optimizeVertexCacheSubset(indices, numIndices, localRemap);
+}
+
+void
+optimizeOverdraw(MeshProperty& mesh, float threshold) noexcept
+{
+	auto& indices = mesh.getIndicesArray();
+	if (indices.empty())
+		return;
+
+	mesh.getMeshClusters().clear();
+
+	std::vector<std::uint32_t> timestamps(mesh.getNumVertices(), 0);
+	std::uint32_t timestamp = 0;
+
+	for (auto& it : mesh.getMeshSubsets())
+	{
+		if (it.startIndices + it.indicesCount <= indices.size())
+			optimizeOverdrawSubset(indices.data() + it.startIndices, it.indicesCount, mesh.getVertexArray().data(), timestamps.data(), timestamp, threshold);
+	}
+}
+
+std::size_t
+optimizeVertexFetch(MeshProperty& mesh) noexcept
+{
+	std::size_t numVertices = mesh.getNumVertices();
+
+	auto& indices = mesh.getIndicesArray();
+	if (indices.empty())
+		return numVertices;
+
+	std::vector<std::uint32_t> remap(numVertices, UINT32_MAX);
+
+	std::size_t count = 0;
+	for (auto& it : indices)
+	{
+		if (remap[it] == UINT32_MAX)
+			remap[it] = (std::uint32_t)count++;
+
+		it = remap[it];
+	}
+
+	for (auto& level : mesh.getMeshLevels())
+	{
+		for (auto& it : level.indices)
+		{
+			if (remap[it] == UINT32_MAX)
+				remap[it] = (std::uint32_t)count++;
+
+			it = remap[it];
+		}
+	}
+
+	remapVertices(mesh, remap, count);
+
+	return count;
+}
+
+std::size_t
+buildMeshClusters(MeshProperty& mesh, std::size_t maxVertices, std::size_t maxTriangles) noexcept
+{
+	auto& clusters = mesh.getMeshClusters();
+	clusters.clear();
+
+	auto& indices = mesh.getIndicesArray();
+	if (indices.empty())
+		return 0;
+
+	assert(maxVertices >= 3 && maxTriangles >= 1);
+
+	std::size_t numVertices = mesh.getNumVertices();
+
+	std::vector<std::uint32_t> stamps(numVertices, UINT32_MAX);
+	std::vector<std::uint32_t> localRemap(numVertices, UINT32_MAX);
+	std::vector<std::uint32_t> offsets(numVertices + 1);
+	std::vector<std::uint32_t> adjacency;
+	std::vector<std::uint8_t> emitted;
+	std::vector<std::uint8_t> queued;
+	std::vector<std::uint32_t> candidates;
+	std::vector<std::uint32_t> result;
+
+	for (auto& subset : mesh.getMeshSubsets())
+	{
+		if (subset.startIndices + subset.indicesCount > indices.size())
+			continue;
+
+		std::uint32_t* source = indices.data() + subset.startIndices;
+		std::size_t numTriangles = subset.indicesCount / 3;
+
+		std::fill(offsets.begin(), offsets.end(), 0);
+		for (std::size_t i = 0; i < numTriangles * 3; i++)
+			offsets[source[i] + 1]++;
+
+		for (std::size_t i = 0; i < numVertices; i++)
+			offsets[i + 1] += offsets[i];
+
+		std::vector<std::uint32_t> filled(offsets.begin(), offsets.end() - 1);
+
+		adjacency.resize(numTriangles * 3);
+		for (std::size_t i = 0; i < numTriangles * 3; i++)
+			adjacency[filled[source[i]]++] = (std::uint32_t)(i / 3);
+
+		emitted.assign(numTriangles, 0);
+		queued.assign(numTriangles, 0);
+		result.clear();
+
+		std::size_t cursor = 0;
+		std::size_t firstCluster = clusters.size();
+
+		while (result.size() < numTriangles * 3)
+		{
+			while (emitted[cursor])
+				cursor++;
+
+			std::uint32_t stamp = (std::uint32_t)clusters.size();
+			std::size_t clusterStart = result.size();
+			std::size_t clusterVertices = 0;
+			std::size_t clusterTriangles = 0;
+
+			candidates.clear();
+
+			std::uint32_t next = (std::uint32_t)cursor;
+
+			while (next != UINT32_MAX)
+			{
+				const std::uint32_t* tri = source + next * 3;
+
+				for (std::size_t k = 0; k < 3; k++)
+				{
+					std::uint32_t v = tri[k];
+					if (stamps[v] != stamp)
+					{
+						stamps[v] = stamp;
+						clusterVertices++;
+					}
+
+					for (std::uint32_t j = offsets[v]; j < offsets[v + 1]; j++)
+					{
+						std::uint32_t t = adjacency[j];
+						if (!emitted[t] && !queued[t])
+						{
+							queued[t] = 1;
+							candidates.push_back(t);
+						}
+					}
+
+					result.push_back(v);
+				}
+
+				emitted[next] = 1;
+				clusterTriangles++;
+
+				next = UINT32_MAX;
+
+				if (clusterTriangles >= maxTriangles)
+					break;
+
+				std::size_t bestExtra = 4;
+				std::size_t write = 0;
+
+				for (std::size_t i = 0; i < candidates.size(); i++)
+				{
+					std::uint32_t t = candidates[i];
+					if (emitted[t])
+						continue;
+
+					candidates[write++] = t;
+
+					std::size_t extra = 0;
+					for (std::size_t k = 0; k < 3; k++)
+					{
+						if (stamps[source[t * 3 + k]] != stamp)
+							extra++;
+					}
+
+					if (extra < bestExtra && clusterVertices + extra <= maxVertices)
+					{
+						bestExtra = extra;
+						next = t;
+					}
+				}
+
+				candidates.resize(write);
+			}
+
+			for (auto& it : candidates)
+				queued[it] = 0;
+
+			MeshCluster cluster;
+			cluster.startIndices = (std::uint32_t)(subset.startIndices + clusterStart);
+			cluster.indicesCount = (std::uint32_t)(result.size() - clusterStart);
+
+			optimizeVertexCacheSubset(result.data() + clusterStart, cluster.indicesCount, localRemap);
+
+			clusters.push_back(cluster);
+		}
+
+		std::copy(result.begin(), result.end(), source);
+
+		for (std::size_t i = firstCluster; i < clusters.size(); i++)
+			computeClusterBounds(mesh, indices.data() + clusters[i].startIndices, clusters[i]);
+	}
+
+	return clusters.size();
+}
+
+void
+optimizeMesh(MeshProperty& mesh, MeshOptimizeFlags flags, MeshOptimizeStats* stats) noexcept
+{
+	if (mesh.getMeshSubsets().empty())
+		mesh.computeBoundingBox();
+
+	if (stats)
+	{
+		stats->numVerticesBefore = mesh.getNumVertices();
+		stats->acmrBefore = computeACMR(mesh.getIndicesArray().data(), mesh.getNumIndices(), mesh.getNumVertices());
+		stats->atvrBefore = computeATVR(mesh.getIndicesArray().data(), mesh.getNumIndices(), mesh.getNumVertices());
+	}
+
+	if (flags & MeshOptimizeFlagBits::MeshOptimizeFlagBitWeldVertices)
+		weldVertices(mesh);
+
+	if (flags & MeshOptimizeFlagBits::MeshOptimizeFlagBitVertexCache)
+		optimizeVertexCache(mesh);
+
+	if (flags & MeshOptimizeFlagBits::MeshOptimizeFlagBitOverdraw)
+		optimizeOverdraw(mesh);
+
+	if (flags & MeshOptimizeFlagBits::MeshOptimizeFlagBitVertexFetch)
+		optimizeVertexFetch(mesh);
+
+	if (flags & MeshOptimizeFlagBits::MeshOptimizeFlagBitClusters)
+		buildMeshClusters(mesh);
+
+	if (stats)
+	{
+		stats->numVerticesAfter = mesh.getNumVertices();
+		stats->acmrAfter = computeACMR(mesh.getIndicesArray().data(), mesh.getNumIndices(), mesh.getNumVertices());
+		stats->atvrAfter = computeATVR(mesh.getIndicesArray().data(), mesh.getNumIndices(), mesh.getNumVertices());
+	}
+}
+
+_NAME_END
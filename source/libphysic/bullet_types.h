@@ -48,6 +48,18 @@
 #include <BulletCollision/CollisionShapes/btCapsuleShape.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 #include <BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h>
+#include <BulletCollision/CollisionDispatch/btSimulationIslandManager.h>
+
+#if defined(_BUILD_PHYSIC_MULTITHREADING)
+#	include <BulletMultiThreaded/btParallelConstraintSolver.h>
+#	include <BulletMultiThreaded/SpuGatheringCollisionDispatcher.h>
+#	include <BulletMultiThreaded/SpuNarrowPhaseCollisionTask/SpuGatheringCollisionTask.h>
+#	if defined(_BUILD_PLATFORM_WINDOWS)
+#		include <BulletMultiThreaded/Win32ThreadSupport.h>
+#	else
+#		include <BulletMultiThreaded/PosixThreadSupport.h>
+#	endif
+#endif
 #pragma warning (pop)
 
 #endif
\ No newline at end of file
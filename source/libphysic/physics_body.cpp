@@ -96,6 +96,8 @@ PhysicsBody::PhysicsBody() noexcept
 	, _linearVelocity(Vector3::Zero)
 	, _angularVelocity(Vector3::Zero)
 	, _sleep(false)
+	, _isEnableCollisionStay(false)
+	, _collisionStamp(0)
 	, _rigidbody(nullptr)
 	, _listener(nullptr)
 {
@@ -152,6 +154,8 @@ PhysicsBody::close() noexcept
 void
 PhysicsBody::setMass(float value) noexcept
 {
+	this->waitSimulation();
+
 	if (_rigidbody)
 	{
 		btVector3 btv3LocalInertia;
@@ -172,6 +176,8 @@ PhysicsBody::setMass(float value) noexcept
 void
 PhysicsBody::setRestitution(float value) noexcept
 {
+	this->waitSimulation();
+
 	if (_rigidbody)
 		_rigidbody->setRestitution(value);
 	_restitution = value;
@@ -180,6 +186,8 @@ PhysicsBody::setRestitution(float value) noexcept
 void
 PhysicsBody::setLinearVelocity(const Vector3& value) noexcept
 {
+	this->waitSimulation();
+
 	if (_rigidbody)
 	{
 		btVector3 velocity;
@@ -196,6 +204,8 @@ PhysicsBody::setLinearVelocity(const Vector3& value) noexcept
 void
 PhysicsBody::setAngularVelocity(const Vector3& value) noexcept
 {
+	this->waitSimulation();
+
 	if (_rigidbody)
 	{
 		btVector3 velocity;
@@ -212,6 +222,8 @@ PhysicsBody::setAngularVelocity(const Vector3& value) noexcept
 void
 PhysicsBody::setLinearDamping(float damping) noexcept
 {
+	this->waitSimulation();
+
 	if (damping < 0.f)
 		damping = 0.f;
 
@@ -224,6 +236,8 @@ PhysicsBody::setLinearDamping(float damping) noexcept
 void
 PhysicsBody::setAngularDamping(float damping) noexcept
 {
+	this->waitSimulation();
+
 	if (damping < 0.f)
 		damping = 0.f;
 
@@ -236,6 +250,8 @@ PhysicsBody::setAngularDamping(float damping) noexcept
 void
 PhysicsBody::setFriction(float value) noexcept
 {
+	this->waitSimulation();
+
 	if (_rigidbody)
 		_rigidbody->setFriction(value);
 	_friction = value;
@@ -244,6 +260,8 @@ PhysicsBody::setFriction(float value) noexcept
 void
 PhysicsBody::setGravity(const Vector3& value) noexcept
 {
+	this->waitSimulation();
+
 	if (_rigidbody)
 	{
 		btVector3 gravity;
@@ -260,12 +278,19 @@ PhysicsBody::setGravity(const Vector3& value) noexcept
 void
 PhysicsBody::setWorldTransform(const float4x4& value) noexcept
 {
+	// Kinematic bodies are moved every frame, so the transform is queued instead of waiting for the running step
+	auto scene = _scene.lock();
+	if (scene && scene->setPendingTransform(this, value))
+		return;
+
 	_motion->setFromOpenGLMatrix(value);
 }
 
 void
 PhysicsBody::isKinematic(bool isKinematic) noexcept
 {
+	this->waitSimulation();
+
 	if (_rigidbody)
 	{
 		if (isKinematic)
@@ -286,6 +311,8 @@ PhysicsBody::isKinematic() const noexcept
 void
 PhysicsBody::sleep(bool sleep) noexcept
 {
+	this->waitSimulation();
+
 	if (_rigidbody)
 	{
 		if (sleep)
@@ -307,6 +334,8 @@ PhysicsBody::getMass() const noexcept
 float
 PhysicsBody::getRestitution() const noexcept
 {
+	this->waitSimulation();
+
 	assert(_rigidbody);
 	return _rigidbody->getRestitution();
 }
@@ -314,6 +343,8 @@ PhysicsBody::getRestitution() const noexcept
 float
 PhysicsBody::getFriction() const noexcept
 {
+	this->waitSimulation();
+
 	assert(_rigidbody);
 	return _rigidbody->getFriction();
 }
@@ -357,6 +388,8 @@ PhysicsBody::getWorldTransform(float4x4& m) const noexcept
 void
 PhysicsBody::addForce(const Vector3& value) noexcept
 {
+	this->waitSimulation();
+
 	assert(_rigidbody);
 
 	btVector3 force;
@@ -370,6 +403,8 @@ PhysicsBody::addForce(const Vector3& value) noexcept
 void
 PhysicsBody::addRelativeForce(const Vector3& value, const Vector3& axis) noexcept
 {
+	this->waitSimulation();
+
 	assert(_rigidbody);
 
 	btVector3 force;
@@ -388,6 +423,8 @@ PhysicsBody::addRelativeForce(const Vector3& value, const Vector3& axis) noexcep
 void
 PhysicsBody::addTorque(const Vector3& value) noexcept
 {
+	this->waitSimulation();
+
 	assert(_rigidbody);
 
 	btVector3 torque;
@@ -401,6 +438,8 @@ PhysicsBody::addTorque(const Vector3& value) noexcept
 void
 PhysicsBody::addImpulse(const Vector3& value, const Vector3& axis) noexcept
 {
+	this->waitSimulation();
+
 	assert(_rigidbody);
 
 	btVector3 force;
@@ -419,11 +458,37 @@ PhysicsBody::addImpulse(const Vector3& value, const Vector3& axis) noexcept
 bool
 PhysicsBody::isSleep() const noexcept
 {
+	this->waitSimulation();
+
 	if (_rigidbody)
 		return _rigidbody->wantsSleeping();
 	return _sleep;
 }
 
+void
+PhysicsBody::enableCollisionStay(bool enable) noexcept
+{
+	if (_isEnableCollisionStay != enable)
+	{
+		auto scene = _scene.lock();
+		if (scene)
+		{
+			if (enable)
+				scene->addCollisionListener(this);
+			else
+				scene->removeCollisionListener(this);
+		}
+
+		_isEnableCollisionStay = enable;
+	}
+}
+
+bool
+PhysicsBody::isEnableCollisionStay() const noexcept
+{
+	return _isEnableCollisionStay;
+}
+
 void
 PhysicsBody::setLayer(std::uint8_t layer) noexcept
 {
@@ -451,13 +516,24 @@ PhysicsBody::getLayerMask() const noexcept
 void
 PhysicsBody::setPhysicsScene(PhysicsScenePtr scene) noexcept
 {
-	if (_scene.lock())
-		_scene.lock()->removeRigidbody(this);
+	auto oldScene = _scene.lock();
+	if (oldScene)
+	{
+		if (_isEnableCollisionStay)
+			oldScene->removeCollisionListener(this);
+
+		oldScene->removeRigidbody(this);
+	}
 
 	_scene = scene;
 
 	if (scene)
+	{
 		scene->addRigidbody(this);
+
+		if (_isEnableCollisionStay)
+			scene->addCollisionListener(this);
+	}
 }
 
 void
@@ -472,6 +548,14 @@ PhysicsBody::getRigidbodyListener() noexcept
 	return _listener;
 }
 
+void
+PhysicsBody::waitSimulation() const noexcept
+{
+	auto scene = _scene.lock();
+	if (scene)
+		scene->waitSimulation();
+}
+
 btRigidBody*
 PhysicsBody::getRigidbody() noexcept
 {
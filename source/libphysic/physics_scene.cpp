@@ -40,12 +40,62 @@
 
 _NAME_BEGIN
 
+#if defined(_BUILD_PHYSIC_MULTITHREADING)
+template<typename ThreadFunc, typename MemoryFunc>
+btThreadSupportInterface*
+createThreadSupport(const char* name, ThreadFunc func, MemoryFunc memory, std::uint32_t numThreads) noexcept
+{
+#	if defined(_BUILD_PLATFORM_WINDOWS)
+	Win32ThreadSupport::Win32ThreadConstructionInfo info(name, func, memory, numThreads);
+	return new Win32ThreadSupport(info);
+#	else
+	PosixThreadSupport::ThreadConstructionInfo info(name, func, memory, numThreads);
+	return new PosixThreadSupport(info);
+#	endif
+}
+#endif
+
+class DynamicsWorld final : public btDiscreteDynamicsWorld
+{
+public:
+	DynamicsWorld(btDispatcher* dispatcher, btBroadphaseInterface* pairCache, btConstraintSolver* constraintSolver, btCollisionConfiguration* collisionConfiguration)
+		: btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration)
+		, _isDeferSynchronize(false)
+	{
+	}
+
+	void setDeferSynchronize(bool defer)
+	{
+		_isDeferSynchronize = defer;
+	}
+
+	void fetchMotionStates()
+	{
+		btDiscreteDynamicsWorld::synchronizeMotionStates();
+	}
+
+	virtual void synchronizeMotionStates() override
+	{
+		// In async mode the step runs on a worker, the motion states are fetched later on the main thread
+		if (!_isDeferSynchronize)
+			btDiscreteDynamicsWorld::synchronizeMotionStates();
+	}
+
+private:
+	bool _isDeferSynchronize;
+};
+
 PhysicsScene::Setting::Setting() noexcept
 	: length(1.0f)
 	, mass(1000.0f)
 	, speed(10.0f)
 	, skinWidth(0.0001f)
 	, gravity(0.0f, -9.81f, 0.0f)
+	, fixedTimeStep(1.0f / 60.0f)
+	, maxSubSteps(1)
+	, numThreads(0)
+	, broadphase(PhysicsBroadphaseType::PhysicsBroadphaseTypeAxisSweep3)
+	, enableAsyncSimulation(false)
 {
 	aabb.min = Vector3(-1000, -1000, -1000);
 	aabb.max = Vector3(1000, 1000, 1000);
@@ -57,7 +107,12 @@ PhysicsScene::PhysicsScene() noexcept
 	, _broadphase(nullptr)
 	, _solver(nullptr)
 	, _dynamicsWorld(nullptr)
+	, _threadSupportCollision(nullptr)
+	, _threadSupportSolver(nullptr)
 	, _isFetchResult(false)
+	, _isSimulating(false)
+	, _isFetchPending(false)
+	, _collisionStamp(0)
 {
 }
 
@@ -72,35 +127,78 @@ PhysicsScene::setup(const Setting& setting) noexcept
 	_setting = setting;
 
 	_collisionConfiguration = new btDefaultCollisionConfiguration();
-	_dispatcher = new btCollisionDispatcher(_collisionConfiguration);
 
-	btVector3 min(setting.aabb.min.x, setting.aabb.min.y, setting.aabb.min.z);
-	btVector3 max(setting.aabb.max.x, setting.aabb.max.y, setting.aabb.max.z);
+#if defined(_BUILD_PHYSIC_MULTITHREADING)
+	if (setting.numThreads > 1)
+	{
+		_threadSupportCollision = createThreadSupport("collision", processCollisionTask, createCollisionLocalStoreMemory, setting.numThreads);
+		_threadSupportSolver = createThreadSupport("solver", SolverThreadFunc, SolverlsMemoryFunc, setting.numThreads);
+
+		_dispatcher = new SpuGatheringCollisionDispatcher(_threadSupportCollision, setting.numThreads, _collisionConfiguration);
+		_dispatcher->setDispatcherFlags(btCollisionDispatcher::CD_DISABLE_CONTACTPOOL_DYNAMIC_ALLOCATION);
+
+		_solver = new btParallelConstraintSolver(_threadSupportSolver);
+	}
+	else
+#endif
+	{
+		_dispatcher = new btCollisionDispatcher(_collisionConfiguration);
+		_solver = new btSequentialImpulseConstraintSolver;
+	}
+
+	if (setting.broadphase == PhysicsBroadphaseType::PhysicsBroadphaseTypeDbvt)
+	{
+		_broadphase = new btDbvtBroadphase();
+	}
+	else
+	{
+		btVector3 min(setting.aabb.min.x, setting.aabb.min.y, setting.aabb.min.z);
+		btVector3 max(setting.aabb.max.x, setting.aabb.max.y, setting.aabb.max.z);
+
+		_broadphase = new btAxisSweep3(min, max);
+	}
 
-	_broadphase = new btAxisSweep3(min, max);
 	_broadphase->getOverlappingPairCache()->setInternalGhostPairCallback(new btGhostPairCallback());
 
-	_solver = new btSequentialImpulseConstraintSolver;
+	auto dynamicsWorld = new DynamicsWorld(_dispatcher, _broadphase, _solver, _collisionConfiguration);
+	dynamicsWorld->setDeferSynchronize(setting.enableAsyncSimulation);
 
-	_dynamicsWorld = new btDiscreteDynamicsWorld(_dispatcher, _broadphase, _solver, _collisionConfiguration);
+	_dynamicsWorld = dynamicsWorld;
 	_dynamicsWorld->getDispatchInfo().m_allowedCcdPenetration = setting.skinWidth;
 
+	if (_threadSupportSolver)
+	{
+		_dynamicsWorld->getSimulationIslandManager()->setSplitIslands(false);
+		_dynamicsWorld->getSolverInfo().m_solverMode = SOLVER_SIMD | SOLVER_USE_WARMSTARTING;
+		_dynamicsWorld->getDispatchInfo().m_enableSPU = true;
+	}
+
+	if (setting.enableAsyncSimulation)
+	{
+		_simulationThread = std::make_unique<ThreadLambda>();
+		_simulationThread->start();
+	}
+
 	this->setGravity(setting.gravity);
 }
 
 void
 PhysicsScene::close() noexcept
 {
-	if (_collisionConfiguration)
+	if (_simulationThread)
 	{
-		delete _collisionConfiguration;
-		_collisionConfiguration = nullptr;
+		_simulationThread->stop();
+		_simulationThread.reset();
 	}
 
-	if (_dispatcher)
+	_isSimulating = false;
+	_isFetchPending = false;
+	_pendingTransforms.clear();
+
+	if (_dynamicsWorld)
 	{
-		delete _dispatcher;
-		_dispatcher = nullptr;
+		delete _dynamicsWorld;
+		_dynamicsWorld = nullptr;
 	}
 
 	if (_solver)
@@ -115,10 +213,30 @@ PhysicsScene::close() noexcept
 		_broadphase = nullptr;
 	}
 
-	if (_dynamicsWorld)
+	if (_dispatcher)
 	{
-		delete _dynamicsWorld;
-		_dynamicsWorld = nullptr;
+		delete _dispatcher;
+		_dispatcher = nullptr;
+	}
+
+#if defined(_BUILD_PHYSIC_MULTITHREADING)
+	if (_threadSupportSolver)
+	{
+		delete _threadSupportSolver;
+		_threadSupportSolver = nullptr;
+	}
+
+	if (_threadSupportCollision)
+	{
+		delete _threadSupportCollision;
+		_threadSupportCollision = nullptr;
+	}
+#endif
+
+	if (_collisionConfiguration)
+	{
+		delete _collisionConfiguration;
+		_collisionConfiguration = nullptr;
 	}
 }
 
@@ -149,12 +267,27 @@ PhysicsScene::setSkitWindow(float width) noexcept
 void
 PhysicsScene::setGravity(const Vector3& v) noexcept
 {
+	this->waitSimulation();
+
 	if (_dynamicsWorld)
 		_dynamicsWorld->setGravity(btVector3(v.x, v.y, v.z));
 
 	_setting.gravity = v;
 }
 
+void
+PhysicsScene::setFixedTimeStep(float step) noexcept
+{
+	assert(step > 0.0f);
+	_setting.fixedTimeStep = step;
+}
+
+void
+PhysicsScene::setMaxSubSteps(std::uint32_t steps) noexcept
+{
+	_setting.maxSubSteps = steps;
+}
+
 float
 PhysicsScene::getLength() const noexcept
 {
@@ -185,12 +318,48 @@ PhysicsScene::getGravity() const noexcept
 	return _setting.gravity;
 }
 
+float
+PhysicsScene::getFixedTimeStep() const noexcept
+{
+	return _setting.fixedTimeStep;
+}
+
+std::uint32_t
+PhysicsScene::getMaxSubSteps() const noexcept
+{
+	return _setting.maxSubSteps;
+}
+
+std::uint32_t
+PhysicsScene::getNumThreads() const noexcept
+{
+	return _setting.numThreads;
+}
+
+PhysicsBroadphaseType
+PhysicsScene::getBroadphaseType() const noexcept
+{
+	return _setting.broadphase;
+}
+
 bool 
 PhysicsScene::isFetchResult() const noexcept
 {
 	return _isFetchResult;
 }
 
+bool
+PhysicsScene::isSimulating() const noexcept
+{
+	return _isSimulating;
+}
+
+bool
+PhysicsScene::isAsyncSimulation() const noexcept
+{
+	return _simulationThread ? true : false;
+}
+
 /*int
 PhysicsScene::raycast(const Vector3& rayFromWorld, const Vector3& rayToWorld, RaycastHit& hit)
 {
@@ -277,18 +446,22 @@ PhysicsScene::raycastAll(const Vector3& rayFromWorld, const Vector3& rayToWorld,
 void 
 PhysicsScene::addJoint(btTypedConstraint* joint) noexcept
 {
+	this->waitSimulation();
 	_dynamicsWorld->addConstraint(joint);
 }
 
 void 
 PhysicsScene::removeJoint(btTypedConstraint* joint) noexcept
 {
+	this->waitSimulation();
 	_dynamicsWorld->removeConstraint(joint);
 }
 
 void
 PhysicsScene::addRigidbody(PhysicsBody* body) noexcept
 {
+	this->waitSimulation();
+
 	_dynamicsWorld->addRigidBody(body->getRigidbody(), 1 << body->getLayer(), body->getLayerMask());
 	_rigidbodys.push_back(body);
 }
@@ -296,6 +469,9 @@ PhysicsScene::addRigidbody(PhysicsBody* body) noexcept
 void
 PhysicsScene::removeRigidbody(PhysicsBody* body) noexcept
 {
+	this->waitSimulation();
+	this->removePendingTransform(body);
+
 	_dynamicsWorld->removeRigidBody(body->getRigidbody());
 
 	auto it = std::find(_rigidbodys.begin(), _rigidbodys.end(), body);
@@ -308,32 +484,102 @@ PhysicsScene::removeRigidbody(PhysicsBody* body) noexcept
 void
 PhysicsScene::addCharacter(btCollisionObject* object) noexcept
 {
+	this->waitSimulation();
 	_dynamicsWorld->addCollisionObject(object, btBroadphaseProxy::CharacterFilter, btBroadphaseProxy::StaticFilter | btBroadphaseProxy::DefaultFilter);
 }
 
 void
 PhysicsScene::removeCharacter(btCollisionObject* object) noexcept
 {
+	this->waitSimulation();
 	_dynamicsWorld->removeCollisionObject(object);
 }
 
 void
 PhysicsScene::addAction(btActionInterface* action) noexcept
 {
+	this->waitSimulation();
 	_dynamicsWorld->addAction(action);
 }
 
 void
 PhysicsScene::removeAction(btActionInterface* action) noexcept
 {
+	this->waitSimulation();
 	_dynamicsWorld->removeAction(action);
 }
 
 void
-PhysicsScene::simulation(float delta) noexcept
+PhysicsScene::addCollisionListener(PhysicsBody* body) noexcept
 {
-	_isFetchResult = true;
+	assert(std::find(_collisionListeners.begin(), _collisionListeners.end(), body) == _collisionListeners.end());
+	_collisionListeners.push_back(body);
+}
+
+void
+PhysicsScene::removeCollisionListener(PhysicsBody* body) noexcept
+{
+	auto it = std::find(_collisionListeners.begin(), _collisionListeners.end(), body);
+	if (it != _collisionListeners.end())
+	{
+		_collisionListeners.erase(it);
+	}
+}
+
+bool
+PhysicsScene::setPendingTransform(PhysicsBody* body, const float4x4& transform) noexcept
+{
+	std::lock_guard<std::mutex> lock(_pendingLock);
+
+	if (!_isSimulating)
+		return false;
+
+	for (auto& it : _pendingTransforms)
+	{
+		if (it.first == body)
+		{
+			it.second = transform;
+			return true;
+		}
+	}
+
+	_pendingTransforms.push_back(std::make_pair(body, transform));
+	return true;
+}
+
+void
+PhysicsScene::removePendingTransform(PhysicsBody* body) noexcept
+{
+	std::lock_guard<std::mutex> lock(_pendingLock);
+
+	auto it = std::find_if(_pendingTransforms.begin(), _pendingTransforms.end(), [body](const std::pair<PhysicsBody*, float4x4>& it) { return it.first == body; });
+	if (it != _pendingTransforms.end())
+		_pendingTransforms.erase(it);
+}
+
+void
+PhysicsScene::waitSimulation() noexcept
+{
+	if (!_isSimulating)
+		return;
+
+	_simulationThread->finish();
+
+	std::vector<std::pair<PhysicsBody*, float4x4>> transforms;
+
+	{
+		std::lock_guard<std::mutex> lock(_pendingLock);
+		_isSimulating = false;
+		_pendingTransforms.swap(transforms);
+	}
+
+	for (auto& it : transforms)
+		it.first->setWorldTransform(it.second);
+}
 
+void
+PhysicsScene::simulation(float delta) noexcept
+{
 	/*if (_isEnableForce)
 	{
 		_body->addForce(_constantForce);
@@ -342,43 +588,96 @@ PhysicsScene::simulation(float delta) noexcept
 		_body->setAngularVelocity(_body->getAngularVelocity() + _constantAngularVelocity);
 	}*/
 
-	_dynamicsWorld->stepSimulation(delta);
-
-	auto dispatcher = _dynamicsWorld->getDispatcher();
-	if (dispatcher)
+	if (_simulationThread)
 	{
-		auto numManifolds = _dispatcher->getNumManifolds();
-		for (int i = 0; i < numManifolds; i++)
+		// The step of the next frame overlaps with rendering, results are picked up by fetchResult
+		this->fetchResult();
+
+		_simulationThread->exce([this, delta]()
 		{
-			auto contactManifold = _dispatcher->getManifoldByIndexInternal(i);
-			if (contactManifold->getNumContacts() == 0)
-				continue;
+			_dynamicsWorld->stepSimulation(delta, _setting.maxSubSteps, _setting.fixedTimeStep);
+		});
 
-			auto objA = contactManifold->getBody0();
-			auto objB = contactManifold->getBody1();
+		_simulationThread->flush();
 
-			auto objAPointer = objA->getUserPointer();
-			auto objBPointer = objB->getUserPointer();
+		{
+			std::lock_guard<std::mutex> lock(_pendingLock);
+			_isSimulating = true;
+		}
 
-			if (objAPointer)
-			{
-				PhysicsBody* bodyA = (PhysicsBody*)objAPointer;
-				auto listenerA = bodyA->getRigidbodyListener();
-				if (listenerA)
-					listenerA->onCollisionStay();
-			}
+		_isFetchPending = true;
+	}
+	else
+	{
+		_isFetchResult = true;
+
+		// With maxSubSteps > 0 bullet advances the world in fixedTimeStep increments and
+		// hands the motion states a transform interpolated by the remaining time.
+		_dynamicsWorld->stepSimulation(delta, _setting.maxSubSteps, _setting.fixedTimeStep);
+
+		this->dispatchCollisionStay();
+
+		_isFetchResult = false;
+	}
+}
+
+void
+PhysicsScene::fetchResult() noexcept
+{
+	this->waitSimulation();
+
+	if (!_isFetchPending)
+		return;
 
-			if (objBPointer)
+	_isFetchPending = false;
+
+	_isFetchResult = true;
+
+	static_cast<DynamicsWorld*>(_dynamicsWorld)->fetchMotionStates();
+
+	this->dispatchCollisionStay();
+
+	_isFetchResult = false;
+}
+
+void
+PhysicsScene::dispatchCollisionStay() noexcept
+{
+	if (_collisionListeners.empty())
+		return;
+
+	_collisionStamp++;
+
+	auto numManifolds = _dispatcher->getNumManifolds();
+	for (int i = 0; i < numManifolds; i++)
+	{
+		auto contactManifold = _dispatcher->getManifoldByIndexInternal(i);
+		if (contactManifold->getNumContacts() == 0)
+			continue;
+
+		const btCollisionObject* objects[] = { contactManifold->getBody0(), contactManifold->getBody1() };
+		for (auto object : objects)
+		{
+			auto body = (PhysicsBody*)object->getUserPointer();
+			if (!body || !body->_isEnableCollisionStay)
+				continue;
+
+			if (body->_collisionStamp != _collisionStamp)
 			{
-				PhysicsBody* bodyB = (PhysicsBody*)objBPointer;
-				auto listenerB = bodyB->getRigidbodyListener();
-				if (listenerB)
-					listenerB->onCollisionStay();
+				body->_collisionStamp = _collisionStamp;
+				_collisionStays.push_back(body);
 			}
 		}
 	}
 
-	_isFetchResult = false;
+	for (auto& body : _collisionStays)
+	{
+		auto listener = body->getRigidbodyListener();
+		if (listener)
+			listener->onCollisionStay();
+	}
+
+	_collisionStays.clear();
 }
 
 _NAME_END
\ No newline at end of file
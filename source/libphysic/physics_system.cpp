@@ -60,6 +60,12 @@ PhysicsSystem::open() noexcept
 	setting.skinWidth = 0.0001f;
 	setting.speed = 10.0f;
 
+	return this->open(setting);
+}
+
+bool
+PhysicsSystem::open(const PhysicsScene::Setting& setting) noexcept
+{
 	_scene = std::make_shared<PhysicsScene>();
 	_scene->setup(setting);
 	return true;
@@ -91,4 +97,11 @@ PhysicsSystem::simulation(float delta) noexcept
 		_scene->simulation(delta);
 }
 
+void
+PhysicsSystem::fetchResult() noexcept
+{
+	if (_scene)
+		_scene->fetchResult();
+}
+
 _NAME_END
\ No newline at end of file
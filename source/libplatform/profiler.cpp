@@ -0,0 +1,327 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include <ray/profiler.h>
+#include <ray/fstream.h>
+#include <cstdio>
+#include <map>
+
+_NAME_BEGIN
+
+std::atomic<bool> Profiler::_isEnabled(false);
+
+Profiler*
+Profiler::instance()
+{
+	static Profiler profiler;
+	return &profiler;
+}
+
+Profiler::Profiler() noexcept
+	: _startTime(Timer::clock())
+{
+	_gpuEvents.track = 0;
+	_gpuEvents.name = "GPU";
+}
+
+Profiler::~Profiler() noexcept
+{
+	_isEnabled = false;
+}
+
+void
+Profiler::setEnable(bool enable) noexcept
+{
+	_isEnabled.store(enable, std::memory_order_relaxed);
+}
+
+void
+Profiler::setThreadName(const char* name) noexcept
+{
+	assert(name);
+
+	auto thread = this->getThreadEvents();
+	std::lock_guard<std::mutex> guard(thread->lock);
+	thread->name = name;
+}
+
+Profiler::ThreadEvents*
+Profiler::getThreadEvents() noexcept
+{
+	static thread_local ThreadEvents* thread = nullptr;
+	if (!thread)
+	{
+		// Buffers stay owned by the profiler, so events of finished worker threads survive until save.
+		std::lock_guard<std::mutex> guard(_mutex);
+
+		auto events = std::make_unique<ThreadEvents>();
+		events->track = static_cast<std::uint32_t>(_threads.size() + 1);
+		events->name = "Thread " + std::to_string(events->track);
+		events->events.reserve(4096);
+
+		thread = events.get();
+		_threads.push_back(std::move(events));
+	}
+
+	return thread;
+}
+
+void
+Profiler::addEvent(const char* name, std::uint64_t begin, std::uint64_t end) noexcept
+{
+	assert(name && begin <= end);
+
+	auto thread = this->getThreadEvents();
+	std::lock_guard<std::mutex> guard(thread->lock);
+	thread->events.push_back(Event{ name, begin, end });
+}
+
+void
+Profiler::addGpuEvent(const char* name, std::uint64_t begin, std::uint64_t end) noexcept
+{
+	assert(name);
+
+	std::lock_guard<std::mutex> guard(_gpuEvents.lock);
+	_gpuEvents.events.push_back(Event{ name, begin, std::max(begin, end) });
+}
+
+std::size_t
+Profiler::getEventCount() const noexcept
+{
+	std::lock_guard<std::mutex> guard(_mutex);
+
+	std::size_t count = 0;
+
+	for (auto& it : _threads)
+	{
+		std::lock_guard<std::mutex> threadGuard(it->lock);
+		count += it->events.size();
+	}
+
+	{
+		std::lock_guard<std::mutex> gpuGuard(_gpuEvents.lock);
+		count += _gpuEvents.events.size();
+	}
+
+	return count;
+}
+
+static void
+buildTrackStatistics(std::vector<Profiler::Statistic>& statistics, std::map<std::string, std::size_t>& indices, const char* root, const std::vector<Profiler::Event>& events, std::uint64_t startTime) noexcept
+{
+	// Scopes close before their parents, so sorting by begin (and longest first on ties) restores the nesting order.
+	std::vector<const Profiler::Event*> sorted;
+	sorted.reserve(events.size());
+
+	for (auto& it : events)
+	{
+		if (it.begin >= startTime)
+			sorted.push_back(&it);
+	}
+
+	std::stable_sort(sorted.begin(), sorted.end(), [](const Profiler::Event* a, const Profiler::Event* b)
+	{
+		if (a->begin != b->begin)
+			return a->begin < b->begin;
+		return a->end > b->end;
+	});
+
+	std::vector<std::pair<const Profiler::Event*, std::string>> stack;
+
+	for (auto& it : sorted)
+	{
+		while (!stack.empty() && stack.back().first->end <= it->begin)
+			stack.pop_back();
+
+		std::string path = stack.empty() ? std::string(root ? root : "") : stack.back().second + "/";
+		path += it->name;
+
+		auto index = indices.find(path);
+		if (index == indices.end())
+		{
+			Profiler::Statistic statistic;
+			statistic.path = path;
+			statistic.count = 0;
+			statistic.total = 0;
+			statistic.max = 0;
+
+			index = indices.insert(std::make_pair(path, statistics.size())).first;
+			statistics.push_back(std::move(statistic));
+		}
+
+		auto& statistic = statistics[index->second];
+		statistic.count++;
+		statistic.total += it->end - it->begin;
+		statistic.max = std::max(statistic.max, it->end - it->begin);
+
+		stack.push_back(std::make_pair(it, std::move(path)));
+	}
+}
+
+void
+Profiler::getStatistics(std::vector<Statistic>& statistics) const noexcept
+{
+	statistics.clear();
+
+	std::map<std::string, std::size_t> indices;
+
+	{
+		std::lock_guard<std::mutex> guard(_mutex);
+
+		for (auto& it : _threads)
+		{
+			std::lock_guard<std::mutex> threadGuard(it->lock);
+			buildTrackStatistics(statistics, indices, nullptr, it->events, _startTime);
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> gpuGuard(_gpuEvents.lock);
+		buildTrackStatistics(statistics, indices, "GPU/", _gpuEvents.events, _startTime);
+	}
+}
+
+void
+Profiler::clear() noexcept
+{
+	std::lock_guard<std::mutex> guard(_mutex);
+
+	for (auto& it : _threads)
+	{
+		std::lock_guard<std::mutex> threadGuard(it->lock);
+		it->events.clear();
+	}
+
+	{
+		std::lock_guard<std::mutex> gpuGuard(_gpuEvents.lock);
+		_gpuEvents.events.clear();
+	}
+
+	_startTime = Timer::clock();
+}
+
+static void
+writeJsonString(std::string& out, const char* str) noexcept
+{
+	out += '"';
+
+	for (; *str; str++)
+	{
+		char c = *str;
+		if (c == '"' || c == '\\')
+		{
+			out += '\\';
+			out += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+		{
+			char escape[8];
+			std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+			out += escape;
+		}
+		else
+		{
+			out += c;
+		}
+	}
+
+	out += '"';
+}
+
+static void
+writeTrackEvents(std::string& out, bool& first, std::uint32_t track, const std::string& name, const std::vector<Profiler::Event>& events, std::uint64_t startTime) noexcept
+{
+	if (!first)
+		out += ",\n";
+	first = false;
+
+	out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":";
+	out += std::to_string(track);
+	out += ",\"args\":{\"name\":";
+	writeJsonString(out, name.c_str());
+	out += "}}";
+
+	char buffer[128];
+
+	for (auto& it : events)
+	{
+		// Events recorded before the last clear can still arrive from GPU queries in flight.
+		if (it.begin < startTime)
+			continue;
+
+		out += ",\n{\"name\":";
+		writeJsonString(out, it.name);
+		std::snprintf(buffer, sizeof(buffer), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u}",
+			(it.begin - startTime) / 1000.0, (it.end - it.begin) / 1000.0, track);
+		out += buffer;
+	}
+}
+
+bool
+Profiler::save(const std::string& path) const noexcept
+{
+	std::string json;
+	json.reserve(1 << 20);
+	json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	bool first = true;
+
+	{
+		std::lock_guard<std::mutex> guard(_mutex);
+
+		for (auto& it : _threads)
+		{
+			std::lock_guard<std::mutex> threadGuard(it->lock);
+			writeTrackEvents(json, first, it->track, it->name, it->events, _startTime);
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> gpuGuard(_gpuEvents.lock);
+		writeTrackEvents(json, first, _gpuEvents.track, _gpuEvents.name, _gpuEvents.events, _startTime);
+	}
+
+	json += "\n]}\n";
+
+	ofstream stream;
+	if (!stream.open(path))
+		return false;
+
+	stream.write(json.c_str(), json.size());
+	return stream.good();
+}
+
+_NAME_END
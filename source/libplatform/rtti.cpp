@@ -47,6 +47,7 @@ Rtti::Rtti(const std::string& name, RttiConstruct creator, const Rtti* parent) n
 	: _name(name)
 	, _parent(parent)
 	, _construct(creator)
+	, _index(0)
 {
 	Factory::instance()->add(this);
 }
@@ -75,10 +76,8 @@ Rtti::type_name() const noexcept
 }
 
 bool
-Rtti::isDerivedFrom(const Rtti* other) const
+Rtti::isDerivedFromParent(const Rtti* other) const noexcept
 {
-	assert(other);
-
 	for (const Rtti* cur = this; cur != 0; cur = cur->getParent())
 	{
 		if (cur == other)
@@ -90,6 +89,25 @@ Rtti::isDerivedFrom(const Rtti* other) const
 	return false;
 }
 
+bool
+Rtti::isDerivedFrom(const Rtti* other) const
+{
+	assert(other);
+
+	auto snapshot = Factory::getSnapshot();
+	if (snapshot && _index < snapshot->intervals.size() && other->_index < snapshot->intervals.size())
+	{
+		auto& interval = snapshot->intervals[_index];
+		auto& otherInterval = snapshot->intervals[other->_index];
+
+		// zero marks a type that was never numbered
+		if (interval.end && otherInterval.end)
+			return otherInterval.begin <= interval.begin && interval.begin < otherInterval.end;
+	}
+
+	return this->isDerivedFromParent(other);
+}
+
 bool
 Rtti::isDerivedFrom(const Rtti& other) const
 {
@@ -99,6 +117,10 @@ Rtti::isDerivedFrom(const Rtti& other) const
 bool
 Rtti::isDerivedFrom(const std::string& name) const
 {
+	auto other = static_cast<const Factory*>(Factory::instance())->getRTTI(name);
+	if (other)
+		return this->isDerivedFrom(other);
+
 	for (const Rtti* cur = this; cur != 0; cur = cur->getParent())
 	{
 		if (cur->_name == name)
@@ -40,9 +40,19 @@ _NAME_BEGIN
 
 using namespace rtti;
 
-__ImplementSingleton(Factory)
+std::atomic<const Factory::Snapshot*> Factory::_snapshot(nullptr);
+
+// Rtti objects register themselves from static initializers in every module,
+// so the factory must be constructed on first use rather than as a template static.
+Factory*
+Factory::instance()
+{
+	static Factory factory;
+	return &factory;
+}
 
 Factory::Factory() noexcept
+	: _isOpened(false)
 {
 }
 
@@ -53,50 +63,135 @@ Factory::~Factory() noexcept
 bool
 Factory::open() noexcept
 {
-	for (auto& it : _rttis)
-	{
-		if (it)
-			_rtti_lists[it->type_name()] = it;
-	}
+	std::lock_guard<std::mutex> guard(_mutex);
+
+	this->buildSnapshot();
+
+	_isOpened = true;
 	return true;
 }
 
 bool
 Factory::add(Rtti* rtti) noexcept
 {
+	std::lock_guard<std::mutex> guard(_mutex);
+
+	if (rtti)
+		rtti->_index = (std::uint32_t)_rttis.size();
+
 	_rttis.push_back(rtti);
+
+	// Types registered after open (late loaded modules) renumber the whole tree into a new snapshot.
+	if (_isOpened && rtti)
+		this->buildSnapshot();
+
 	return true;
 }
 
+void
+Factory::buildSnapshot() noexcept
+{
+	auto snapshot = std::make_unique<Snapshot>();
+	snapshot->intervals.resize(_rttis.size(), Interval{ 0, 0 });
+
+	std::unordered_map<const Rtti*, std::vector<Rtti*>> children;
+	std::vector<Rtti*> roots;
+
+	for (auto& it : _rttis)
+	{
+		if (!it)
+			continue;
+
+		snapshot->names[it->type_name()] = it;
+
+		if (it->_parent)
+			children[it->_parent].push_back(it);
+		else
+			roots.push_back(it);
+	}
+
+	// Intervals start at one, zero marks a type that was never numbered and falls back to the parent chain.
+	std::uint32_t index = 1;
+
+	std::vector<std::pair<Rtti*, std::size_t>> stack;
+
+	for (auto& root : roots)
+	{
+		snapshot->intervals[root->_index].begin = index++;
+		stack.push_back(std::make_pair(root, 0));
+
+		while (!stack.empty())
+		{
+			auto& top = stack.back();
+
+			auto it = children.find(top.first);
+			if (it != children.end() && top.second < it->second.size())
+			{
+				Rtti* child = it->second[top.second++];
+				snapshot->intervals[child->_index].begin = index++;
+				stack.push_back(std::make_pair(child, 0));
+			}
+			else
+			{
+				snapshot->intervals[top.first->_index].end = index;
+				stack.pop_back();
+			}
+		}
+	}
+
+	_snapshot.store(snapshot.get(), std::memory_order_release);
+	_snapshots.push_back(std::move(snapshot));
+}
+
 Rtti*
 Factory::getRTTI(const std::string& name) noexcept
 {
-	return _rtti_lists[name];
+	auto snapshot = this->getSnapshot();
+	if (!snapshot)
+		return nullptr;
+
+	auto it = snapshot->names.find(name);
+	if (it != snapshot->names.end())
+		return it->second;
+	return nullptr;
 }
 
 Rtti*
 Factory::getRTTI(const char* name) noexcept
 {
-	return _rtti_lists[name];
+	auto snapshot = this->getSnapshot();
+	if (!snapshot)
+		return nullptr;
+
+	auto it = snapshot->names.find(name);
+	if (it != snapshot->names.end())
+		return it->second;
+	return nullptr;
 }
 
 const Rtti*
 Factory::getRTTI(const std::string& name) const noexcept
 {
-	auto it = _rtti_lists.lower_bound(name);
-	for (; it != _rtti_lists.end(); ++it)
-		if ((*it).first == name)
-			return (*it).second;
+	auto snapshot = this->getSnapshot();
+	if (!snapshot)
+		return nullptr;
+
+	auto it = snapshot->names.find(name);
+	if (it != snapshot->names.end())
+		return it->second;
 	return nullptr;
 }
 
 const Rtti*
 Factory::getRTTI(const char* name) const noexcept
 {
-	auto it = _rtti_lists.lower_bound(name);
-	for (; it != _rtti_lists.end(); ++it)
-		if ((*it).first == name)
-			return (*it).second;
+	auto snapshot = this->getSnapshot();
+	if (!snapshot)
+		return nullptr;
+
+	auto it = snapshot->names.find(name);
+	if (it != snapshot->names.end())
+		return it->second;
 	return nullptr;
 }
 
@@ -207,4 +207,172 @@ ThreadLambda::dispose() noexcept
 	}
 }
 
+// The pool a thread is running a batch of, so a nested parallelFor on the same pool does not wait on itself.
+static thread_local ThreadPool* _currentThreadPool = nullptr;
+
+// Shared by every loader that only needs a batch spread over the cores, so concurrent callers queue
+// on one set of workers instead of each starting hardware_concurrency() threads of its own.
+ThreadPool*
+ThreadPool::instance()
+{
+	static ThreadPool threadPool;
+	static std::once_flag once;
+	std::call_once(once, []() { threadPool.start(std::max(1U, std::thread::hardware_concurrency())); });
+	return &threadPool;
+}
+
+ThreadPool::ThreadPool() noexcept
+	: _isQuitRequest(false)
+	, _generation(0)
+	, _numTasks(0)
+	, _numBusyThreads(0)
+	, _nextTask(0)
+	, _task(nullptr)
+{
+}
+
+ThreadPool::~ThreadPool() noexcept
+{
+	this->stop();
+}
+
+void
+ThreadPool::start(std::uint32_t numThreads) noexcept
+{
+	this->stop();
+
+	_isQuitRequest = false;
+
+	for (std::uint32_t i = 1; i < numThreads; i++)
+		_threads.push_back(std::thread(std::bind(&ThreadPool::dispose, this, _generation, i)));
+}
+
+void
+ThreadPool::stop() noexcept
+{
+	_mutex.lock();
+	_isQuitRequest = true;
+	_taskRequest.notify_all();
+	_mutex.unlock();
+
+	for (auto& it : _threads)
+		it.join();
+
+	_threads.clear();
+}
+
+std::uint32_t
+ThreadPool::getNumThreads() const noexcept
+{
+	return (std::uint32_t)_threads.size() + 1;
+}
+
+void
+ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& func) except
+{
+	this->parallelFor(count, [&func](std::size_t index, std::uint32_t) { func(index); });
+}
+
+void
+ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t, std::uint32_t)>& func) except
+{
+	if (count == 0)
+		return;
+
+	if (_threads.empty() || count == 1 || _currentThreadPool == this)
+	{
+		for (std::size_t i = 0; i < count; i++)
+			func(i, 0);
+		return;
+	}
+
+	std::lock_guard<std::mutex> batch(_batchMutex);
+
+	auto currentThreadPool = _currentThreadPool;
+	_currentThreadPool = this;
+
+	_mutex.lock();
+	_task = &func;
+	_numTasks = count;
+	_numBusyThreads = _threads.size();
+	_nextTask = 0;
+	_exception = nullptr;
+	_generation++;
+	_taskRequest.notify_all();
+	_mutex.unlock();
+
+	this->execute(func, count, 0);
+
+	std::exception_ptr exception;
+
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		while (_numBusyThreads > 0)
+			_finishRequest.wait(lock);
+
+		_task = nullptr;
+		exception = std::move(_exception);
+	}
+
+	_currentThreadPool = currentThreadPool;
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
+
+void
+ThreadPool::execute(const std::function<void(std::size_t, std::uint32_t)>& func, std::size_t count, std::uint32_t thread) noexcept
+{
+	for (;;)
+	{
+		auto index = _nextTask.fetch_add(1);
+		if (index >= count)
+			break;
+
+		try
+		{
+			func(index, thread);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (!_exception)
+				_exception = std::current_exception();
+
+			_nextTask = count;
+		}
+	}
+}
+
+void
+ThreadPool::dispose(std::uint64_t generation, std::uint32_t thread) noexcept
+{
+	_currentThreadPool = this;
+
+	for (;;)
+	{
+		const std::function<void(std::size_t, std::uint32_t)>* task = nullptr;
+		std::size_t count = 0;
+
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			while (!_isQuitRequest && _generation == generation)
+				_taskRequest.wait(lock);
+
+			if (_isQuitRequest)
+				return;
+
+			generation = _generation;
+			task = _task;
+			count = _numTasks;
+		}
+
+		this->execute(*task, count, thread);
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (--_numBusyThreads == 0)
+			_finishRequest.notify_one();
+	}
+}
+
 _NAME_END
\ No newline at end of file
@@ -39,6 +39,7 @@
 #include <cmath>
 #include <limits>
 #include <thread>
+#include <chrono>
 
 _NAME_BEGIN
 
@@ -91,6 +92,12 @@ Timer::elapsed_min() const noexcept
 	return float(1) / float(CLOCKS_PER_SEC);
 }
 
+std::uint64_t
+Timer::clock() noexcept
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 float
 Timer::fps() const noexcept
 {
@@ -151,7 +158,13 @@ Timer::sleep(float fps) const noexcept
 void
 Timer::update() noexcept
 {
-	_frameTime = this->elapsed() - _lastTime;
+	this->update(this->elapsed() - _lastTime);
+}
+
+void
+Timer::update(float delta) noexcept
+{
+	_frameTime = delta;
 
 	_numFrames++;
 	_accumulateTime += _frameTime;
@@ -41,6 +41,12 @@
 #include <ray/graphics_data.h>
 #include <ray/camera.h>
 
+#include <cstring>
+
+#if defined(__SSE2__)
+#	include <emmintrin.h>
+#endif
+
 _NAME_BEGIN
 
 __ImplementSubClass(Geometry, RenderObject, "Geometry")
@@ -65,12 +71,36 @@ GraphicsIndirect::GraphicsIndirect(std::uint32_t _numVertices, std::uint32_t _nu
 {
 }
 
+GraphicsCluster::GraphicsCluster() noexcept
+	: center(float3::Zero)
+	, radius(0.0f)
+	, coneAxis(float3::UnitZ)
+	, coneCutoff(1.0f)
+	, startIndice(0)
+	, numIndices(0)
+{
+}
+
+GraphicsCluster::GraphicsCluster(const float3& _center, float _radius, const float3& _coneAxis, float _coneCutoff, std::uint32_t _startIndice, std::uint32_t _numIndices) noexcept
+	: center(_center)
+	, radius(_radius)
+	, coneAxis(_coneAxis)
+	, coneCutoff(_coneCutoff)
+	, startIndice(_startIndice)
+	, numIndices(_numIndices)
+{
+}
+
 Geometry::Geometry() noexcept
 	: _isCastShadow(true)
 	, _isReceiveShadow(true)
 	, _indexType(GraphicsIndexType::GraphicsIndexTypeUInt32)
 	, _vertexOffset(0)
 	, _indexOffset(0)
+	, _quantizePositionScale(float3::One)
+	, _quantizePositionBias(float3::Zero)
+	, _quantizeTexcoord(1.0f, 1.0f, 0.0f, 0.0f)
+	, _level(0)
 {
 }
 
@@ -164,6 +194,32 @@ Geometry::getIndexBuffer() const noexcept
 	return _ibo;
 }
 
+void
+Geometry::setQuantize(const float3& positionScale, const float3& positionBias, const float4& texcoordScaleBias) noexcept
+{
+	_quantizePositionScale = positionScale;
+	_quantizePositionBias = positionBias;
+	_quantizeTexcoord = texcoordScaleBias;
+}
+
+const float3&
+Geometry::getQuantizePositionScale() const noexcept
+{
+	return _quantizePositionScale;
+}
+
+const float3&
+Geometry::getQuantizePositionBias() const noexcept
+{
+	return _quantizePositionBias;
+}
+
+const float4&
+Geometry::getQuantizeTexcoord() const noexcept
+{
+	return _quantizeTexcoord;
+}
+
 void
 Geometry::setGraphicsIndirect(GraphicsIndirectPtr&& renderable) noexcept
 {
@@ -182,6 +238,209 @@ Geometry::getGraphicsIndirect() noexcept
 	return _renderable;
 }
 
+void
+Geometry::setGraphicsIndirectLevels(const GraphicsIndirects& levels) noexcept
+{
+	_renderableLevels = levels;
+	_level = 0;
+
+	if (!_renderableLevels.empty())
+		_renderable = _renderableLevels.front();
+}
+
+const GraphicsIndirects&
+Geometry::getGraphicsIndirectLevels() const noexcept
+{
+	return _renderableLevels;
+}
+
+void
+Geometry::setLevel(std::size_t level) noexcept
+{
+	if (_renderableLevels.empty())
+		return;
+
+	_level = std::min(level, _renderableLevels.size() - 1);
+	_renderable = _renderableLevels[_level];
+}
+
+std::size_t
+Geometry::getLevel() const noexcept
+{
+	return _level;
+}
+
+void
+Geometry::setGraphicsClusters(const GraphicsClusters& clusters) noexcept
+{
+	std::size_t count = (clusters.size() + 3) & ~3;
+
+	_clusters = clusters;
+	_clusterBounds.assign(count * 8, 0.0f);
+	_clusterVisibilities.clear();
+
+	for (std::size_t i = 0; i < clusters.size(); i++)
+	{
+		_clusterBounds[count * 0 + i] = clusters[i].center.x;
+		_clusterBounds[count * 1 + i] = clusters[i].center.y;
+		_clusterBounds[count * 2 + i] = clusters[i].center.z;
+		_clusterBounds[count * 3 + i] = clusters[i].radius;
+		_clusterBounds[count * 4 + i] = clusters[i].coneAxis.x;
+		_clusterBounds[count * 5 + i] = clusters[i].coneAxis.y;
+		_clusterBounds[count * 6 + i] = clusters[i].coneAxis.z;
+		_clusterBounds[count * 7 + i] = clusters[i].coneCutoff;
+	}
+}
+
+const GraphicsClusters&
+Geometry::getGraphicsClusters() const noexcept
+{
+	return _clusters;
+}
+
+std::size_t
+Geometry::getVisibleClusterCount(const Camera& camera) const noexcept
+{
+	auto it = _clusterVisibilities.find(camera.weak_from_this());
+	if (it == _clusterVisibilities.end())
+		return _clusters.size();
+
+	return it->second.drawCount;
+}
+
+bool
+Geometry::cullClusters(const Camera& camera) noexcept
+{
+	Frustum fru;
+	fru.extract(camera.getViewProject() * this->getTransform(), true);
+
+	const Plane3* planes[] = { &fru.getLeftPlane(), &fru.getRightPlane(), &fru.getTopPlane(), &fru.getBottomPlane(), &fru.getNearPlane(), &fru.getFarPlane() };
+
+	const float4x4& transform = this->getTransform();
+	float3 scale(
+		math::length(float3(transform.a1, transform.a2, transform.a3)),
+		math::length(float3(transform.b1, transform.b2, transform.b3)),
+		math::length(float3(transform.c1, transform.c2, transform.c3)));
+
+	// cones are only valid while the transform keeps angles
+	bool coneCulling = camera.getCameraType() == CameraType::CameraTypePerspective;
+	coneCulling &= math::max(scale) <= math::min(scale) * 1.01f;
+
+	float3 eye = this->getTransformInverse() * camera.getTranslate();
+
+	std::size_t numClusters = _clusters.size();
+	std::size_t count = (numClusters + 3) & ~3;
+
+	const float* cx = _clusterBounds.data();
+	const float* cy = cx + count;
+	const float* cz = cy + count;
+	const float* cr = cz + count;
+	const float* ax = cr + count;
+	const float* ay = ax + count;
+	const float* az = ay + count;
+	const float* cut = az + count;
+
+	auto key = camera.weak_from_this();
+	auto entry = _clusterVisibilities.find(key);
+	if (entry == _clusterVisibilities.end())
+	{
+		// results are keyed by the camera's lifetime, so a destroyed camera's entry is dropped before a new one is added
+		for (auto it = _clusterVisibilities.begin(); it != _clusterVisibilities.end();)
+		{
+			if (it->first.expired())
+				it = _clusterVisibilities.erase(it);
+			else
+				++it;
+		}
+
+		entry = _clusterVisibilities.emplace(key, ClusterVisibility()).first;
+	}
+
+	auto& visibility = entry->second;
+	visibility.viewProject = camera.getViewProject();
+	visibility.transform = transform;
+	visibility.commands.resize(numClusters * 5);
+	visibility.drawCount = 0;
+
+	std::uint32_t startVertice = _renderable ? _renderable->startVertice : 0;
+	std::uint32_t* commands = visibility.commands.data();
+
+	for (std::size_t i = 0; i < count; i += 4)
+	{
+		std::uint32_t mask = 0;
+
+#if defined(__SSE2__)
+		__m128 x = _mm_loadu_ps(cx + i);
+		__m128 y = _mm_loadu_ps(cy + i);
+		__m128 z = _mm_loadu_ps(cz + i);
+		__m128 r = _mm_loadu_ps(cr + i);
+		__m128 negr = _mm_sub_ps(_mm_setzero_ps(), r);
+
+		__m128 outside = _mm_setzero_ps();
+
+		for (auto plane : planes)
+		{
+			__m128 d = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane->normal.x)), _mm_mul_ps(y, _mm_set1_ps(plane->normal.y)));
+			d = _mm_add_ps(d, _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane->normal.z)), _mm_set1_ps(plane->distance)));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(d, negr));
+		}
+
+		if (coneCulling)
+		{
+			__m128 dx = _mm_sub_ps(x, _mm_set1_ps(eye.x));
+			__m128 dy = _mm_sub_ps(y, _mm_set1_ps(eye.y));
+			__m128 dz = _mm_sub_ps(z, _mm_set1_ps(eye.z));
+
+			__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+			__m128 facing = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(ax + i)), _mm_mul_ps(dy, _mm_loadu_ps(ay + i))), _mm_mul_ps(dz, _mm_loadu_ps(az + i)));
+			__m128 limit = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(cut + i), length), r);
+
+			outside = _mm_or_ps(outside, _mm_cmpge_ps(facing, limit));
+		}
+
+		mask = ~_mm_movemask_ps(outside) & 0xF;
+#else
+		for (std::size_t k = 0; k < 4; k++)
+		{
+			float3 center(cx[i + k], cy[i + k], cz[i + k]);
+
+			bool outside = false;
+			for (auto plane : planes)
+				outside |= math::dot(plane->normal, center) + plane->distance < -cr[i + k];
+
+			if (coneCulling)
+			{
+				float3 view = center - eye;
+				outside |= math::dot(view, float3(ax[i + k], ay[i + k], az[i + k])) >= cut[i + k] * math::length(view) + cr[i + k];
+			}
+
+			if (!outside)
+				mask |= 1 << k;
+		}
+#endif
+
+		for (std::size_t k = 0; k < 4 && i + k < numClusters; k++)
+		{
+			if (mask & (1 << k))
+			{
+				const GraphicsCluster& cluster = _clusters[i + k];
+				commands[0] = cluster.numIndices;
+				commands[1] = 1;
+				commands[2] = cluster.startIndice;
+				commands[3] = startVertice;
+				commands[4] = 0;
+				commands += 5;
+
+				visibility.drawCount++;
+			}
+		}
+	}
+
+	visibility.needUpload = visibility.drawCount > 0;
+
+	return visibility.drawCount > 0;
+}
+
 bool
 Geometry::onVisiableTest(const Camera& camera, const Frustum& fru) noexcept
 {
@@ -193,8 +452,17 @@ Geometry::onVisiableTest(const Camera& camera, const Frustum& fru) noexcept
 
 	if (camera.getCameraType() == CameraType::CameraTypeCube)
 		return math::sqrDistance(camera.getTranslate(), this->getTranslate()) < (camera.getFar() * camera.getFar());
-	else
-		return fru.contains(this->getBoundingBoxInWorld().aabb());
+
+	if (!fru.contains(this->getBoundingBoxInWorld().aabb()))
+		return false;
+
+	if (_clusters.empty() || _level != 0 || camera.getCameraOrder() != CameraOrder::CameraOrder3D)
+	{
+		_clusterVisibilities.erase(camera.weak_from_this());
+		return true;
+	}
+
+	return this->cullClusters(camera);
 }
 
 void
@@ -222,10 +490,14 @@ Geometry::onAddRenderData(RenderDataManager& manager) noexcept
 void
 Geometry::onRenderObject(RenderPipeline& pipeline, RenderQueue queue, MaterialTech* tech) noexcept
 {
+	if (!_renderable || _renderable->numIndices == 0)
+		return;
+
 	if (_techniques[queue] || tech)
 	{
 		pipeline.setTransform(this->getTransform());
 		pipeline.setTransformInverse(this->getTransformInverse());
+		pipeline.setQuantize(_quantizePositionScale, _quantizePositionBias, _quantizeTexcoord);
 
 		if (_vbo)
 			pipeline.setVertexBuffer(0, _vbo, _vertexOffset);
@@ -233,13 +505,53 @@ Geometry::onRenderObject(RenderPipeline& pipeline, RenderQueue queue, MaterialTe
 		if (_ibo)
 			pipeline.setIndexBuffer(_ibo, _indexOffset, _indexType);
 
+		ClusterVisibility* visibility = nullptr;
+		if (!_clusters.empty() && _level == 0 && pipeline.getCamera())
+		{
+			auto it = _clusterVisibilities.find(pipeline.getCamera()->weak_from_this());
+			if (it != _clusterVisibilities.end())
+			{
+				// results from a test against another view or transform are stale
+				if (it->second.viewProject == pipeline.getCamera()->getViewProject() && it->second.transform == this->getTransform())
+					visibility = &it->second;
+			}
+		}
+
+		if (visibility && visibility->needUpload)
+		{
+			if (!visibility->indirect)
+			{
+				GraphicsDataDesc indirectDesc;
+				indirectDesc.setType(GraphicsDataType::GraphicsDataTypeIndirectBiffer);
+				indirectDesc.setUsage(GraphicsUsageFlagBits::GraphicsUsageFlagWriteBit | GraphicsUsageFlagBits::GraphicsUsageFlagStreamBit);
+				indirectDesc.setStreamSize(visibility->commands.size() * sizeof(std::uint32_t));
+
+				visibility->indirect = pipeline.createGraphicsData(indirectDesc);
+			}
+
+			void* data = nullptr;
+			if (visibility->indirect && visibility->indirect->map(0, visibility->drawCount * 5 * sizeof(std::uint32_t), &data))
+			{
+				std::memcpy(data, visibility->commands.data(), visibility->drawCount * 5 * sizeof(std::uint32_t));
+				visibility->indirect->unmap();
+			}
+
+			visibility->needUpload = false;
+		}
+
+		bool indirect = visibility && visibility->indirect;
+
 		if (_techniques[queue])
 		{
 			auto& passList = _techniques[queue]->getPassList();
 			for (auto& pass : passList)
 			{
 				pipeline.setMaterialPass(pass);
-				pipeline.drawIndexedLayer(_renderable->numIndices, _renderable->numInstances, _renderable->startIndice, _renderable->startVertice, _renderable->startInstances, this->getLayer());
+
+				if (indirect)
+					pipeline.drawIndexedIndirectLayer(visibility->indirect, 0, visibility->drawCount, 5 * sizeof(std::uint32_t), this->getLayer());
+				else
+					pipeline.drawIndexedLayer(_renderable->numIndices, _renderable->numInstances, _renderable->startIndice, _renderable->startVertice, _renderable->startInstances, this->getLayer());
 			}
 		}
 		else if (tech)
@@ -248,7 +560,11 @@ Geometry::onRenderObject(RenderPipeline& pipeline, RenderQueue queue, MaterialTe
 			for (auto& pass : passList)
 			{
 				pipeline.setMaterialPass(pass);
-				pipeline.drawIndexedLayer(_renderable->numIndices, _renderable->numInstances, _renderable->startIndice, _renderable->startVertice, _renderable->startInstances, this->getLayer());
+
+				if (indirect)
+					pipeline.drawIndexedIndirectLayer(visibility->indirect, 0, visibility->drawCount, 5 * sizeof(std::uint32_t), this->getLayer());
+				else
+					pipeline.drawIndexedLayer(_renderable->numIndices, _renderable->numInstances, _renderable->startIndice, _renderable->startVertice, _renderable->startInstances, this->getLayer());
 			}
 		}
 	}
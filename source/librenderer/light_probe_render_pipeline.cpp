@@ -47,6 +47,8 @@
 #include <ray/camera.h>
 #include <ray/light_probe.h>
 
+#include <queue>
+
 _NAME_BEGIN
 
 __ImplementSubClass(LightProbeRenderPipeline, RenderPipelineController, "LightProbeRenderPipeline")
@@ -61,6 +63,9 @@ const float4x4 viewMatrixs[] = {
 };
 
 LightProbeRenderPipeline::LightProbeRenderPipeline() noexcept
+	: _probeMapSize(0)
+	, _faceBudget(6)
+	, _frame(0)
 {
 }
 
@@ -155,8 +160,10 @@ LightProbeRenderPipeline::setup(const RenderPipelinePtr& pipeline, std::uint32_t
 	_camera->setFar(10.0f);
 	_camera->setAperture(90.0f);
 	_camera->setClearFlags(CameraClearFlagBits::CameraClearColorBit | CameraClearFlagBits::CameraClearDepthBit);
+	_camera->setCameraOrder(CameraOrder::CameraOrderLightProbe);
 
 	_pipeline = pipeline;
+	_probeMapSize = probeMapSize;
 
 	return true;
 }
@@ -164,81 +171,220 @@ LightProbeRenderPipeline::setup(const RenderPipelinePtr& pipeline, std::uint32_t
 void
 LightProbeRenderPipeline::close() noexcept
 {
+	_probeCaptures.clear();
+
+	if (_camera)
+		_camera->setRenderScene(nullptr);
+
 	_pipeline = nullptr;
 }
 
+void
+LightProbeRenderPipeline::setFaceBudget(std::uint32_t faces) noexcept
+{
+	_faceBudget = faces;
+}
+
+std::uint32_t
+LightProbeRenderPipeline::getFaceBudget() const noexcept
+{
+	return _faceBudget;
+}
+
+bool
+LightProbeRenderPipeline::setupProbeViews(const LightProbe& lightProbe, ProbeCapture& capture) noexcept
+{
+	auto framebuffers = lightProbe.getCamera()->getRenderPipelineFramebuffer()->downcast<LightProbeRenderFramebuffer>();
+	if (capture.colorMap == framebuffers->getColorMap())
+		return true;
+
+	capture.colorMap = framebuffers->getColorMap();
+
+	for (std::uint8_t i = 0; i < 6; i++)
+		capture.views[i] = nullptr;
+
+	// the shared depth array can only be attached next to cube faces of the same size, other probes fall back to a copy
+	if (capture.colorMap->getGraphicsTextureDesc().getWidth() != _probeMapSize)
+		return true;
+
+	for (std::uint8_t i = 0; i < 6; i++)
+	{
+		GraphicsFramebufferDesc probeViewDesc;
+		probeViewDesc.setWidth(_probeMapSize);
+		probeViewDesc.setHeight(_probeMapSize);
+		probeViewDesc.addColorAttachment(GraphicsAttachmentBinding(framebuffers->getColorMap(), 0, i));
+		probeViewDesc.addColorAttachment(GraphicsAttachmentBinding(framebuffers->getNormalMap(), 0, i));
+		probeViewDesc.setDepthStencilAttachment(GraphicsAttachmentBinding(_probeDepthMap, 0, i));
+		probeViewDesc.setGraphicsFramebufferLayout(_probeRSMViewLayout);
+		capture.views[i] = _pipeline->createFramebuffer(probeViewDesc);
+		if (!capture.views[i])
+			return false;
+	}
+
+	return true;
+}
+
+void
+LightProbeRenderPipeline::renderProbeFace(const Camera& mainCamera, const LightProbe& lightProbe, ProbeCapture& capture) noexcept
+{
+	static const float3 lookat[] = { float3::UnitX, -float3::UnitX, float3::UnitY, -float3::UnitY, float3::UnitZ, -float3::UnitZ };
+	static const float3 up[] = { -float3::UnitY, -float3::UnitY, float3::UnitZ, -float3::UnitZ, -float3::UnitY, -float3::UnitY };
+
+	auto& camera = lightProbe.getCamera();
+	auto face = capture.face;
+
+	ray::float4x4 transform;
+	transform.makeLookAt_lh(lightProbe.getTranslate(), lightProbe.getTranslate() + lookat[face], up[face]);
+
+	if (_camera->getRenderScene() != camera->getRenderScene())
+		_camera->setRenderScene(camera->getRenderScene());
+
+	_camera->setTransform(math::transformInverse(transform), transform);
+	_camera->setRenderPipelineFramebuffer(camera->getRenderPipelineFramebuffer());
+
+	// cull against this face's frustum with the face camera's own render data
+	_camera->onRenderBefore(mainCamera);
+
+	auto& framebuffer = capture.views[face] ? capture.views[face] : _probeRSMViews[face];
+
+	_pipeline->setCamera(_camera.get(), true);
+	_pipeline->setFramebuffer(framebuffer);
+
+	if (_camera->getClearFlags() & CameraClearFlagBits::CameraClearColorBit)
+	{
+		_pipeline->clearFramebuffer(0, CameraClearFlagBits::CameraClearColorBit, _camera->getClearColor());
+		_pipeline->clearFramebuffer(1, CameraClearFlagBits::CameraClearColorBit, _camera->getClearColor());
+	}
+
+	if (_camera->getClearFlags() & CameraClearFlagBits::CameraClearDepthBit ||
+		_camera->getClearFlags() & CameraClearFlagBits::CameraClearStencilBit)
+	{
+		if (_camera->getClearFlags() & CameraClearFlagBits::CameraClearDepthStencilBit)
+			_pipeline->clearFramebuffer(2, CameraClearFlagBits::CameraClearDepthStencilBit, _camera->getClearColor());
+		else if (_camera->getClearFlags() & CameraClearFlagBits::CameraClearDepthBit)
+			_pipeline->clearFramebuffer(2, CameraClearFlagBits::CameraClearDepthBit, _camera->getClearColor());
+		else if (_camera->getClearFlags() & CameraClearFlagBits::CameraClearStencilBit)
+			_pipeline->clearFramebuffer(2, CameraClearFlagBits::CameraClearStencilBit, _camera->getClearColor());
+	}
+
+	_pipeline->drawRenderQueue(RenderQueue::RenderQueueOpaque);
+
+	if (!capture.views[face])
+	{
+		auto framebuffers = camera->getRenderPipelineFramebuffer()->downcast<LightProbeRenderFramebuffer>();
+
+		_pipeline->readFramebufferToCube(0, face, framebuffers->getColorMap(), 0, 0, 0, framebuffers->getColorMap()->getGraphicsTextureDesc().getWidth(), framebuffers->getColorMap()->getGraphicsTextureDesc().getHeight());
+		_pipeline->readFramebufferToCube(1, face, framebuffers->getNormalMap(), 0, 0, 0, framebuffers->getNormalMap()->getGraphicsTextureDesc().getWidth(), framebuffers->getNormalMap()->getGraphicsTextureDesc().getHeight());
+	}
+
+	_pipeline->discardFramebuffer(2);
+
+	_camera->onRenderAfter(mainCamera);
+}
+
 void
 LightProbeRenderPipeline::onRenderPipeline(const Camera* mainCamera) noexcept
 {
 	assert(mainCamera);
 
-	_pipeline->setCamera(mainCamera);
+	_frame++;
+
+	std::priority_queue<ProbeCandidate> candidates;
 
 	const auto& lightProbes = mainCamera->getRenderDataManager()->getRenderData(RenderQueue::RenderQueueLightProbes);
 	for (auto& it : lightProbes)
 	{
-		auto lightProbe = it->downcast<LightProbe>();
-		if (!lightProbe->needUpdateProbeMap())
-			continue;
+		auto lightProbe = it->downcast_pointer<LightProbe>();
 
 		auto& camera = lightProbe->getCamera();
-		if (camera)
+		if (!camera || !camera->getRenderPipelineFramebuffer() || !camera->getRenderScene())
+			continue;
+
+		auto& capture = _probeCaptures[lightProbe];
+		capture.lastFrame = _frame;
+
+		if (lightProbe->needUpdateProbeMap())
 		{
-			if (!camera->getRenderPipelineFramebuffer())
-				continue;
+			lightProbe->needUpdateProbeMap(false);
+
+			// a change during a capture finishes the current pass and queues another one
+			capture.changes++;
+			if (capture.pending)
+				capture.dirty = true;
+			else
+				capture.pending = true;
+		}
+	}
 
-			if (!camera->getRenderScene())
-				continue;
+	for (auto it = _probeCaptures.begin(); it != _probeCaptures.end();)
+	{
+		auto lightProbe = it->first.lock();
+		auto& capture = it->second;
+
+		// a probe that left the view keeps its entry until its queued or half done capture has finished
+		if (!lightProbe || (capture.lastFrame != _frame && !capture.pending))
+		{
+			it = _probeCaptures.erase(it);
+			continue;
+		}
 
-			camera->onRenderBefore(*mainCamera);
+		++it;
+
+		if (!capture.pending)
+			continue;
+
+		auto& camera = lightProbe->getCamera();
+		if (!camera || !camera->getRenderPipelineFramebuffer() || !camera->getRenderScene())
+			continue;
 
-			static float3 lookat[] = { float3::UnitX, -float3::UnitX, float3::UnitY, -float3::UnitY, float3::UnitZ, -float3::UnitZ };
-			static float3 up[] = { -float3::UnitY, -float3::UnitY, float3::UnitZ, -float3::UnitZ, -float3::UnitY, -float3::UnitY };
+		capture.waitFrames++;
 
-			for (std::uint8_t i = 0; i < 6; i++)
-			{
-				ray::float4x4 transform;
-				transform.makeLookAt_lh(it->getTranslate(), it->getTranslate() + lookat[i], up[i]);
+		float distance = math::distance(mainCamera->getTranslate(), lightProbe->getTranslate());
 
-				_camera->setTransform(math::transformInverse(transform), transform);
-				_camera->setRenderDataManager(camera->getRenderDataManager());
-				_camera->setRenderPipelineFramebuffer(camera->getRenderPipelineFramebuffer());
+		ProbeCandidate candidate;
+		candidate.priority = float(capture.changes + capture.waitFrames) / (1.0f + distance);
+		candidate.lightProbe = lightProbe;
+		candidate.capture = &capture;
 
-				_pipeline->setCamera(_camera.get(), true);
-				_pipeline->setFramebuffer(_probeRSMViews[i]);
+		// half-captured probes finish first so no cube is left mixing two states for long
+		if (capture.face > 0)
+			candidate.priority += 1e6f;
 
-				if (_camera->getClearFlags() & CameraClearFlagBits::CameraClearColorBit)
-				{
-					_pipeline->clearFramebuffer(0, CameraClearFlagBits::CameraClearColorBit, _camera->getClearColor());
-					_pipeline->clearFramebuffer(1, CameraClearFlagBits::CameraClearColorBit, _camera->getClearColor());
-				}
+		candidates.push(candidate);
+	}
 
-				if (_camera->getClearFlags() & CameraClearFlagBits::CameraClearDepthBit ||
-					_camera->getClearFlags() & CameraClearFlagBits::CameraClearStencilBit)
-				{
-					if (_camera->getClearFlags() & CameraClearFlagBits::CameraClearDepthStencilBit)
-						_pipeline->clearFramebuffer(2, CameraClearFlagBits::CameraClearDepthStencilBit, _camera->getClearColor());
-					else if (_camera->getClearFlags() & CameraClearFlagBits::CameraClearDepthBit)
-						_pipeline->clearFramebuffer(2, CameraClearFlagBits::CameraClearDepthBit, _camera->getClearColor());
-					else if (_camera->getClearFlags() & CameraClearFlagBits::CameraClearStencilBit)
-						_pipeline->clearFramebuffer(2, CameraClearFlagBits::CameraClearStencilBit, _camera->getClearColor());
-				}
+	if (candidates.empty())
+		return;
 
-				_pipeline->drawRenderQueue(RenderQueue::RenderQueueOpaque);
+	std::uint32_t budget = _faceBudget > 0 ? _faceBudget : std::numeric_limits<std::uint32_t>::max();
 
-				auto framebuffers = camera->getRenderPipelineFramebuffer()->downcast<LightProbeRenderFramebuffer>();
+	while (budget > 0 && !candidates.empty())
+	{
+		auto candidate = candidates.top();
+		candidates.pop();
 
-				_pipeline->readFramebufferToCube(0, i, framebuffers->getColorMap(), 0, 0, 0, framebuffers->getColorMap()->getGraphicsTextureDesc().getWidth(), framebuffers->getColorMap()->getGraphicsTextureDesc().getHeight());
-				_pipeline->readFramebufferToCube(1, i, framebuffers->getNormalMap(), 0, 0, 0, framebuffers->getNormalMap()->getGraphicsTextureDesc().getWidth(), framebuffers->getNormalMap()->getGraphicsTextureDesc().getHeight());
+		auto& capture = *candidate.capture;
+		if (!this->setupProbeViews(*candidate.lightProbe, capture))
+			continue;
 
-				_pipeline->discardFramebuffer(0);
-				_pipeline->discardFramebuffer(1);
-				_pipeline->discardFramebuffer(2);
-			}
+		while (budget > 0 && capture.face < 6)
+		{
+			this->renderProbeFace(*mainCamera, *candidate.lightProbe, capture);
+			capture.face++;
+			budget--;
+		}
 
-			camera->onRenderAfter(*mainCamera);
+		if (capture.face == 6)
+		{
+			capture.face = 0;
+			capture.changes = 0;
+			capture.waitFrames = 0;
+			capture.pending = capture.dirty;
+			capture.dirty = false;
 		}
 	}
+
+	_pipeline->setCamera(mainCamera);
 }
 
 void
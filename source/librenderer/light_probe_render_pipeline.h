@@ -51,6 +51,36 @@ public:
 	bool setup(const RenderPipelinePtr& pipeline, std::uint32_t probeMapSize = 64) noexcept;
 	void close() noexcept;
 
+	void setFaceBudget(std::uint32_t faces) noexcept;
+	std::uint32_t getFaceBudget() const noexcept;
+
+private:
+	struct ProbeCapture
+	{
+		bool pending;
+		bool dirty;
+
+		std::uint8_t face;
+		std::uint32_t changes;
+		std::uint32_t waitFrames;
+		std::uint32_t lastFrame;
+
+		GraphicsTexturePtr colorMap;
+		GraphicsFramebufferPtr views[6];
+	};
+
+	struct ProbeCandidate
+	{
+		float priority;
+		LightProbePtr lightProbe;
+		ProbeCapture* capture;
+
+		bool operator<(const ProbeCandidate& other) const noexcept { return priority < other.priority; }
+	};
+
+	bool setupProbeViews(const LightProbe& lightProbe, ProbeCapture& capture) noexcept;
+	void renderProbeFace(const Camera& mainCamera, const LightProbe& lightProbe, ProbeCapture& capture) noexcept;
+
 private:
 	virtual void onRenderBefore() noexcept;
 	virtual void onRenderPipeline(const Camera* camera) noexcept;
@@ -73,6 +103,13 @@ private:
 
 	GraphicsFramebufferPtr _probeRSMViews[6];
 	GraphicsFramebufferLayoutPtr _probeRSMViewLayout;
+
+	std::uint32_t _probeMapSize;
+	std::uint32_t _faceBudget;
+	std::uint32_t _frame;
+
+	// keyed by owner so a destroyed probe's entry can never be matched by a new probe at the same address
+	std::map<LightProbeWeakPtr, ProbeCapture, std::owner_less<LightProbeWeakPtr>> _probeCaptures;
 };
 
 _NAME_END
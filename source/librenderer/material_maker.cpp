@@ -1345,6 +1345,9 @@ MaterialMaker::GetSemanticType(const std::string& string, GlobalSemanticType& ty
 	if (string == "matModelView") { type = GlobalSemanticType::GlobalSemanticTypeModelView; return true; }
 	if (string == "matModelViewProject") { type = GlobalSemanticType::GlobalSemanticTypeModelViewProject; return true; }
 	if (string == "matModelViewInverse") { type = GlobalSemanticType::GlobalSemanticTypeModelViewInverse; return true; }
+	if (string == "quantPositionScale") { type = GlobalSemanticType::GlobalSemanticTypeQuantizePositionScale; return true; }
+	if (string == "quantPositionBias") { type = GlobalSemanticType::GlobalSemanticTypeQuantizePositionBias; return true; }
+	if (string == "quantTexcoord") { type = GlobalSemanticType::GlobalSemanticTypeQuantizeTexcoord; return true; }
 	if (string == "CameraAperture") { type = GlobalSemanticType::GlobalSemanticTypeCameraAperture; return true; }
 	if (string == "CameraNear") { type = GlobalSemanticType::GlobalSemanticTypeCameraNear; return true; }
 	if (string == "CameraFar") { type = GlobalSemanticType::GlobalSemanticTypeCameraFar; return true; }
@@ -676,6 +676,13 @@ MaterialSemanticManager::setup() noexcept
 	_parametes[GlobalSemanticType::GlobalSemanticTypeModelViewProject] = std::make_shared<MaterialSemantic>("matModelViewProject", GraphicsUniformType::GraphicsUniformTypeFloat4x4);
 	_parametes[GlobalSemanticType::GlobalSemanticTypeModelViewInverse] = std::make_shared<MaterialSemantic>("matModelViewInverse", GraphicsUniformType::GraphicsUniformTypeFloat4x4);
 
+	_parametes[GlobalSemanticType::GlobalSemanticTypeQuantizePositionScale] = std::make_shared<MaterialSemantic>("quantPositionScale", GraphicsUniformType::GraphicsUniformTypeFloat3);
+	_parametes[GlobalSemanticType::GlobalSemanticTypeQuantizePositionBias] = std::make_shared<MaterialSemantic>("quantPositionBias", GraphicsUniformType::GraphicsUniformTypeFloat3);
+	_parametes[GlobalSemanticType::GlobalSemanticTypeQuantizeTexcoord] = std::make_shared<MaterialSemantic>("quantTexcoord", GraphicsUniformType::GraphicsUniformTypeFloat4);
+	_parametes[GlobalSemanticType::GlobalSemanticTypeQuantizePositionScale]->uniform3f(float3::One);
+	_parametes[GlobalSemanticType::GlobalSemanticTypeQuantizePositionBias]->uniform3f(float3::Zero);
+	_parametes[GlobalSemanticType::GlobalSemanticTypeQuantizeTexcoord]->uniform4f(1.0f, 1.0f, 0.0f, 0.0f);
+
 	_parametes[GlobalSemanticType::GlobalSemanticTypeCameraAperture] = std::make_shared<MaterialSemantic>("CameraAperture", GraphicsUniformType::GraphicsUniformTypeFloat);
 	_parametes[GlobalSemanticType::GlobalSemanticTypeCameraNear] = std::make_shared<MaterialSemantic>("CameraNear", GraphicsUniformType::GraphicsUniformTypeFloat);
 	_parametes[GlobalSemanticType::GlobalSemanticTypeCameraFar] = std::make_shared<MaterialSemantic>("CameraFar", GraphicsUniformType::GraphicsUniformTypeFloat);
@@ -49,6 +49,11 @@ RenderListener::~RenderListener() noexcept
 {
 }
 
+void
+RenderListener::onRenderObjectVisiable(RenderObject& object, const Camera& camera, float distanceSqrt) noexcept
+{
+}
+
 RenderObject::RenderObject() noexcept
 	: _visible(true)
 	, _layer(0)
@@ -243,6 +248,14 @@ RenderObject::onVisiableTest(const Camera& camera, const Frustum& fru) noexcept
 	return fru.contains(this->getBoundingBoxInWorld().aabb());
 }
 
+void
+RenderObject::onVisiableDistance(const Camera& camera, float distanceSqrt) noexcept
+{
+	auto listener = this->getOwnerListener();
+	if (listener)
+		listener->onRenderObjectVisiable(*this, camera, distanceSqrt);
+}
+
 void
 RenderObject::onAddRenderData(RenderDataManager& manager) noexcept
 {
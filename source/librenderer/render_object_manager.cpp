@@ -87,6 +87,7 @@ DefaultRenderDataManager::assginVisiable(const Camera& camera) noexcept
 		for (auto& it : _visiable.iter())
 		{
 			auto object = it.getOcclusionCullNode();
+			object->onVisiableDistance(camera, it.getDistanceSqrt());
 			object->onAddRenderData(*this);
 		}
 	}
@@ -154,6 +154,15 @@ RenderPipeline::setTransformInverse(const float4x4& transform) noexcept
 	_semanticsManager->getSemantic(GlobalSemanticType::GlobalSemanticTypeModelInverse)->uniform4fmat(transform);
 }
 
+void
+RenderPipeline::setQuantize(const float3& positionScale, const float3& positionBias, const float4& texcoordScaleBias) noexcept
+{
+	assert(_semanticsManager);
+	_semanticsManager->getSemantic(GlobalSemanticType::GlobalSemanticTypeQuantizePositionScale)->uniform3f(positionScale);
+	_semanticsManager->getSemantic(GlobalSemanticType::GlobalSemanticTypeQuantizePositionBias)->uniform3f(positionBias);
+	_semanticsManager->getSemantic(GlobalSemanticType::GlobalSemanticTypeQuantizeTexcoord)->uniform4f(texcoordScaleBias);
+}
+
 const MaterialSemanticPtr&
 RenderPipeline::getSemanticParam(GlobalSemanticType type) const noexcept
 {
@@ -427,6 +436,13 @@ RenderPipeline::drawIndexed(std::uint32_t numIndices, std::uint32_t numInstances
 	_graphicsContext->drawIndexed(numIndices, numInstances, startIndice, startVertice, startInstances);
 }
 
+void
+RenderPipeline::drawIndexedIndirectLayer(const GraphicsDataPtr& data, std::size_t offset, std::uint32_t drawCount, std::uint32_t stride, std::uint32_t layer) noexcept
+{
+	_graphicsContext->setStencilReference(GraphicsStencilFaceFlagBits::GraphicsStencilFaceAllBit, 1 << layer);
+	_graphicsContext->drawIndexedIndirect(data, offset, drawCount, stride);
+}
+
 void
 RenderPipeline::drawLayer(std::uint32_t numVertices, std::uint32_t numInstances, std::uint32_t startVertice, std::uint32_t startInstances, std::uint32_t layer) noexcept
 {
@@ -517,6 +533,20 @@ RenderPipeline::present() noexcept
 	_graphicsContext->present();
 }
 
+void
+RenderPipeline::beginProfile(const char* name) noexcept
+{
+	assert(_graphicsContext);
+	_graphicsContext->beginProfile(name);
+}
+
+void
+RenderPipeline::endProfile() noexcept
+{
+	assert(_graphicsContext);
+	_graphicsContext->endProfile();
+}
+
 bool
 RenderPipeline::isTextureSupport(GraphicsFormat format) noexcept
 {
@@ -41,6 +41,7 @@
 #include <ray/camera.h>
 #include <ray/deferred_lighting_framebuffers.h>
 #include <ray/except.h>
+#include <ray/profiler.h>
 
 #include "deferred_lighting_pipeline.h"
 #include "forward_render_pipeline.h"
@@ -105,6 +106,7 @@ RenderPipelineManager::setup(const RenderSetting& setting) except
 	_forward = forwardShading;
 
 	auto lightProbeGen = std::make_shared<LightProbeRenderPipeline>();
+	lightProbeGen->setFaceBudget(setting.lightProbeFaceBudget);
 	if (!lightProbeGen->setup(_pipeline))
 		throw failure("Failed to create the LightProbeRenderPipeline");
 
@@ -317,6 +319,9 @@ RenderPipelineManager::setRenderSetting(const RenderSetting& setting) noexcept
 		_deferredLighting = deferredLighting;
 	}
 
+	if (_lightProbeGen)
+		_lightProbeGen->downcast<LightProbeRenderPipeline>()->setFaceBudget(setting.lightProbeFaceBudget);
+
 	_pipeline->setSwapInterval(setting.swapInterval);
 
 	_setting = setting;
@@ -437,6 +442,8 @@ RenderPipelineManager::render(const RenderScene& scene) noexcept
 {
 	assert(_pipeline);
 
+	__ProfileScope("RenderPipelineManager::render");
+
 	auto& cameras = scene.getCameraList();
 	for (auto& camera : cameras)
 	{
@@ -452,9 +459,14 @@ RenderPipelineManager::render(const RenderScene& scene) noexcept
 		{
 			camera->onRenderBefore(*camera);
 
-			_forward->onRenderBefore();
-			_forward->onRenderPipeline(camera);
-			_forward->onRenderAfter();
+			{
+				__ProfileScope("ForwardRenderPipeline");
+				__ProfileGpuScope(*_pipeline, "ForwardRenderPipeline");
+
+				_forward->onRenderBefore();
+				_forward->onRenderPipeline(camera);
+				_forward->onRenderAfter();
+			}
 
 			camera->onRenderAfter(*camera);
 		}
@@ -465,6 +477,9 @@ RenderPipelineManager::render(const RenderScene& scene) noexcept
 
 			if (_shadowMapGen)
 			{
+				__ProfileScope("ShadowRenderPipeline");
+				__ProfileGpuScope(*_pipeline, "ShadowRenderPipeline");
+
 				_shadowMapGen->onRenderBefore();
 				_shadowMapGen->onRenderPipeline(camera);
 				_shadowMapGen->onRenderAfter();
@@ -472,6 +487,9 @@ RenderPipelineManager::render(const RenderScene& scene) noexcept
 
 			if (_lightProbeGen)
 			{
+				__ProfileScope("LightProbeRenderPipeline");
+				__ProfileGpuScope(*_pipeline, "LightProbeRenderPipeline");
+
 				_lightProbeGen->onRenderBefore();
 				_lightProbeGen->onRenderPipeline(camera);
 				_lightProbeGen->onRenderAfter();
@@ -481,6 +499,9 @@ RenderPipelineManager::render(const RenderScene& scene) noexcept
 			{
 				if (_setting.pipelineType == RenderPipelineType::RenderPipelineTypeDeferredLighting)
 				{
+					__ProfileScope("DeferredLightingPipeline");
+					__ProfileGpuScope(*_pipeline, "DeferredLightingPipeline");
+
 					_deferredLighting->onRenderBefore();
 					_deferredLighting->onRenderPipeline(camera);
 					_deferredLighting->onRenderAfter();
@@ -488,6 +509,9 @@ RenderPipelineManager::render(const RenderScene& scene) noexcept
 			}
 			else
 			{
+				__ProfileScope("ForwardRenderPipeline");
+				__ProfileGpuScope(*_pipeline, "ForwardRenderPipeline");
+
 				_forward->onRenderBefore();
 				_forward->onRenderPipeline(camera);
 				_forward->onRenderAfter();
@@ -503,6 +527,8 @@ RenderPipelineManager::render(const RenderScene& scene) noexcept
 void
 RenderPipelineManager::renderEnd() noexcept
 {
+	__ProfileScope("RenderPipelineManager::present");
+
 	_pipeline->present();
 	_pipeline->renderEnd();
 }
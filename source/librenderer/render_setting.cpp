@@ -81,6 +81,8 @@ RenderSetting::RenderSetting() noexcept
 	, enableColorGrading(false)
 	, enableFXAA(true)
 	, enableGlobalIllumination(false)
+	, lightProbeFaceBudget(6)
+	, lodBias(1.0f)
 	, earthRadius(6360000.f, 6440000.f)
 	, earthScaleHeight(7994.f, 2000.f)
 	, minElevation(0.0f)
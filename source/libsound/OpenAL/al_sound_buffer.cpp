@@ -33,4 +33,70 @@
 // | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 // | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 // | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-// +----------------------------------------------------------------------
\ No newline at end of file
+// +----------------------------------------------------------------------
+#include "al_sound_buffer.h"
+
+_NAME_BEGIN
+
+ALSoundBuffer::ALSoundBuffer() noexcept
+	: _alBuffer(AL_NONE)
+	, _alBufferSize(0)
+{
+}
+
+ALSoundBuffer::~ALSoundBuffer() noexcept
+{
+	this->close();
+}
+
+bool
+ALSoundBuffer::setup(SoundReader& reader) noexcept
+{
+	assert(_alBuffer == AL_NONE);
+
+	ALenum format = ALSoundFormat(reader.getBufferType());
+	if (format == AL_NONE)
+		return false;
+
+	std::vector<char> data(reader.size());
+
+	reader.seekg(0, ios_base::beg);
+	reader.read(data.data(), data.size());
+
+	auto length = reader.gcount();
+	reader.seekg(0, ios_base::beg);
+
+	if (length <= 0)
+		return false;
+
+	::alGenBuffers(1, &_alBuffer);
+	::alBufferData(_alBuffer, format, data.data(), (ALsizei)length, reader.getBufferFrequency());
+
+	_alBufferSize = (ALsizei)length;
+
+	return ::alGetError() == AL_NO_ERROR;
+}
+
+void
+ALSoundBuffer::close() noexcept
+{
+	if (_alBuffer != AL_NONE)
+	{
+		::alDeleteBuffers(1, &_alBuffer);
+		_alBuffer = AL_NONE;
+	}
+}
+
+ALuint
+ALSoundBuffer::getInstanceID() const noexcept
+{
+	return _alBuffer;
+}
+
+ALsizei
+ALSoundBuffer::getBufferSize() const noexcept
+{
+	return _alBufferSize;
+}
+
+_NAME_END
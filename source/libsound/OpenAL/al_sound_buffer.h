@@ -41,6 +41,27 @@
 
 _NAME_BEGIN
 
+class ALSoundBuffer final
+{
+public:
+	ALSoundBuffer() noexcept;
+	~ALSoundBuffer() noexcept;
+
+	bool setup(SoundReader& reader) noexcept;
+	void close() noexcept;
+
+	ALuint getInstanceID() const noexcept;
+	ALsizei getBufferSize() const noexcept;
+
+private:
+	ALSoundBuffer(const ALSoundBuffer&) = delete;
+	ALSoundBuffer& operator=(const ALSoundBuffer&) = delete;
+
+private:
+	ALuint _alBuffer;
+	ALsizei _alBufferSize;
+};
+
 _NAME_END
 
 #endif
@@ -41,9 +41,19 @@
 
 _NAME_BEGIN
 
+// Decoded bytes the shared buffer cache keeps before buffers no source binds anymore are released.
+constexpr std::size_t ALSoundBufferCacheSize = 32 << 20;
+
+// Bound sources get this bonus when ranked, so two sources of near equal audibility don't swap voices every frame.
+constexpr float ALSoundVoiceHysteresis = 0.05f;
+
 ALSoundDevice::ALSoundDevice() noexcept
-	: _device(nullptr)
+	: _distanceModel(false)
+	, _device(nullptr)
 	, _context(nullptr)
+	, _soundBufferSize(0)
+	, _maxVoices(32)
+	, _isQuitRequest(false)
 {
 }
 
@@ -63,12 +73,45 @@ ALSoundDevice::open() noexcept
 	if (!::alcMakeContextCurrent(_context))
 		return false;
 
+	ALCint monoSources = 0;
+	::alcGetIntegerv(_device, ALC_MONO_SOURCES, 1, &monoSources);
+	if (monoSources > 0)
+		_maxVoices = std::min<std::uint32_t>(_maxVoices, monoSources);
+
+	_isQuitRequest = false;
+	_streamThread = std::make_unique<std::thread>(std::bind(&ALSoundDevice::streamThread, this));
+
 	return true;
 }
 
 void
 ALSoundDevice::close() noexcept
 {
+	if (_streamThread)
+	{
+		_isQuitRequest = true;
+
+		_streamThread->join();
+		_streamThread = nullptr;
+	}
+
+	for (auto& it : _sources)
+	{
+		if (it->_alSource != AL_NONE)
+			this->unbindVoice(it);
+	}
+
+	if (!_voices.empty())
+	{
+		::alDeleteSources(_voices.size(), _voices.data());
+		_voices.clear();
+	}
+
+	_freeVoices.clear();
+	_streams.clear();
+	_soundBuffers.clear();
+	_soundBufferSize = 0;
+
 	::alcMakeContextCurrent(AL_NONE);
 
 	if (_context)
@@ -109,10 +152,31 @@ ALSoundDevice::getDistanceModel() const noexcept
 	return _distanceModel;
 }
 
+void
+ALSoundDevice::setMaxVoices(std::uint32_t count) noexcept
+{
+	_maxVoices = count;
+
+	while (_voices.size() > _maxVoices && !_freeVoices.empty())
+	{
+		auto voice = _freeVoices.back();
+		_freeVoices.pop_back();
+
+		_voices.erase(std::find(_voices.begin(), _voices.end(), voice));
+		::alDeleteSources(1, &voice);
+	}
+}
+
+std::uint32_t
+ALSoundDevice::getMaxVoices() const noexcept
+{
+	return _maxVoices;
+}
+
 SoundSourcePtr
 ALSoundDevice::createSoundSource()
 {
-	return std::make_shared<ALSoundSource>();
+	return std::make_shared<ALSoundSource>(this->shared_from_this());
 }
 
 SoundListenerPtr
@@ -121,4 +185,221 @@ ALSoundDevice::createSoundListener() noexcept
 	return std::make_shared<ALSoundListener>();
 }
 
+ALSoundBufferPtr
+ALSoundDevice::getSoundBuffer(const SoundReaderPtr& reader) noexcept
+{
+	assert(reader);
+
+	auto it = _soundBuffers.find(reader);
+	if (it != _soundBuffers.end())
+		return it->second;
+
+	auto soundBuffer = std::make_shared<ALSoundBuffer>();
+	if (!soundBuffer->setup(*reader))
+		return nullptr;
+
+	this->evictSoundBuffers(soundBuffer->getBufferSize());
+
+	_soundBuffers[reader] = soundBuffer;
+	_soundBufferSize += soundBuffer->getBufferSize();
+
+	return soundBuffer;
+}
+
+void
+ALSoundDevice::evictSoundBuffers(std::size_t size) noexcept
+{
+	auto it = _soundBuffers.begin();
+	while (it != _soundBuffers.end() && _soundBufferSize + size > ALSoundBufferCacheSize)
+	{
+		// The cache holds the only reference once no source binds the buffer
+		if (it->second.use_count() == 1)
+		{
+			_soundBufferSize -= it->second->getBufferSize();
+			it = _soundBuffers.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+void
+ALSoundDevice::addSoundSource(ALSoundSource* source) noexcept
+{
+	auto it = std::find(_sources.begin(), _sources.end(), source);
+	if (it == _sources.end())
+		_sources.push_back(source);
+}
+
+void
+ALSoundDevice::removeSoundSource(ALSoundSource* source) noexcept
+{
+	auto it = std::find(_sources.begin(), _sources.end(), source);
+	if (it != _sources.end())
+		_sources.erase(it);
+}
+
+void
+ALSoundDevice::addSoundStream(ALSoundSource* source) noexcept
+{
+	std::lock_guard<std::mutex> lock(_streamLock);
+
+	auto it = std::find(_streams.begin(), _streams.end(), source);
+	if (it == _streams.end())
+		_streams.push_back(source);
+}
+
+void
+ALSoundDevice::removeSoundStream(ALSoundSource* source) noexcept
+{
+	std::lock_guard<std::mutex> lock(_streamLock);
+
+	auto it = std::find(_streams.begin(), _streams.end(), source);
+	if (it != _streams.end())
+		_streams.erase(it);
+}
+
+void
+ALSoundDevice::requestVoice(ALSoundSource* source) noexcept
+{
+	assert(source->_alSource == AL_NONE);
+
+	auto voice = this->allocVoice();
+	if (voice != AL_NONE)
+		this->bindVoice(source, voice);
+}
+
+void
+ALSoundDevice::releaseVoice(ALSoundSource* source) noexcept
+{
+	assert(source->_alSource != AL_NONE);
+	this->unbindVoice(source);
+}
+
+void
+ALSoundDevice::update(float delta) noexcept
+{
+	float3 listener;
+	::alGetListenerfv(AL_POSITION, listener.ptr());
+
+	std::uint32_t pinned = 0;
+
+	_ranks.clear();
+
+	for (auto& it : _sources)
+	{
+		it->_updateVirtual(delta);
+
+		if (!it->_isPlaying)
+			continue;
+
+		if (it->_isPaused)
+		{
+			if (it->_alSource != AL_NONE)
+				pinned++;
+			continue;
+		}
+
+		it->_audibility = it->_computeAudibility(listener);
+		if (it->_alSource != AL_NONE)
+			it->_audibility += ALSoundVoiceHysteresis;
+
+		_ranks.push_back(it);
+	}
+
+	std::size_t count = _maxVoices > pinned ? _maxVoices - pinned : 0;
+	if (_ranks.size() > count)
+	{
+		std::nth_element(_ranks.begin(), _ranks.begin() + count, _ranks.end(), [](const ALSoundSource* a, const ALSoundSource* b)
+		{
+			return a->_audibility > b->_audibility;
+		});
+
+		for (auto it = _ranks.begin() + count; it != _ranks.end(); ++it)
+		{
+			if ((*it)->_alSource != AL_NONE)
+				this->unbindVoice(*it);
+		}
+
+		_ranks.resize(count);
+	}
+
+	for (auto& it : _ranks)
+	{
+		if (it->_alSource != AL_NONE)
+			continue;
+
+		auto voice = this->allocVoice();
+		if (voice == AL_NONE)
+			break;
+
+		this->bindVoice(it, voice);
+	}
+}
+
+ALuint
+ALSoundDevice::allocVoice() noexcept
+{
+	if (!_freeVoices.empty())
+	{
+		auto voice = _freeVoices.back();
+		_freeVoices.pop_back();
+		return voice;
+	}
+
+	if (_voices.size() >= _maxVoices)
+		return AL_NONE;
+
+	::alGetError();
+
+	ALuint voice = AL_NONE;
+	::alGenSources(1, &voice);
+
+	if (::alGetError() != AL_NO_ERROR)
+	{
+		// the driver ran out of hardware sources before reaching the limit
+		_maxVoices = _voices.size();
+		return AL_NONE;
+	}
+
+	_voices.push_back(voice);
+	return voice;
+}
+
+void
+ALSoundDevice::bindVoice(ALSoundSource* source, ALuint voice) noexcept
+{
+	source->_bindVoice(voice);
+
+	if (source->isStreaming())
+		this->addSoundStream(source);
+}
+
+void
+ALSoundDevice::unbindVoice(ALSoundSource* source) noexcept
+{
+	if (source->isStreaming())
+		this->removeSoundStream(source);
+
+	_freeVoices.push_back(source->_unbindVoice());
+}
+
+void
+ALSoundDevice::streamThread() noexcept
+{
+	while (!_isQuitRequest)
+	{
+		{
+			std::lock_guard<std::mutex> lock(_streamLock);
+
+			for (auto& it : _streams)
+				it->_updateSoundStream();
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+}
+
 _NAME_END
\ No newline at end of file
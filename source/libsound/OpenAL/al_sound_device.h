@@ -39,9 +39,13 @@
 
 #include "al_sound_types.h"
 
+#include <thread>
+#include <mutex>
+#include <atomic>
+
 _NAME_BEGIN
 
-class EXPORT ALSoundDevice final : public SoundDevice
+class EXPORT ALSoundDevice final : public SoundDevice, public std::enable_shared_from_this<ALSoundDevice>
 {
 public:
 	ALSoundDevice() noexcept;
@@ -55,14 +59,55 @@ public:
 	virtual void setDistanceModel(bool enable) noexcept;
 	virtual bool getDistanceModel() const noexcept;
 
+	virtual void setMaxVoices(std::uint32_t count) noexcept;
+	virtual std::uint32_t getMaxVoices() const noexcept;
+
 	virtual SoundSourcePtr createSoundSource();
 	virtual SoundListenerPtr createSoundListener() noexcept;
 
+	virtual void update(float delta) noexcept;
+
+	ALSoundBufferPtr getSoundBuffer(const SoundReaderPtr& reader) noexcept;
+
+	void addSoundSource(class ALSoundSource* source) noexcept;
+	void removeSoundSource(class ALSoundSource* source) noexcept;
+
+	void addSoundStream(class ALSoundSource* source) noexcept;
+	void removeSoundStream(class ALSoundSource* source) noexcept;
+
+	void requestVoice(class ALSoundSource* source) noexcept;
+	void releaseVoice(class ALSoundSource* source) noexcept;
+
+private:
+	ALuint allocVoice() noexcept;
+
+	void evictSoundBuffers(std::size_t size) noexcept;
+
+	void bindVoice(class ALSoundSource* source, ALuint voice) noexcept;
+	void unbindVoice(class ALSoundSource* source) noexcept;
+
+	void streamThread() noexcept;
+
 private:
 	bool _distanceModel;
 
 	ALCdevice*      _device;
 	ALCcontext*     _context;
+
+	std::size_t _soundBufferSize;
+	std::map<SoundReaderPtr, ALSoundBufferPtr> _soundBuffers;
+
+	std::uint32_t _maxVoices;
+	std::vector<ALuint> _voices;
+	std::vector<ALuint> _freeVoices;
+
+	std::vector<class ALSoundSource*> _sources;
+	std::vector<class ALSoundSource*> _ranks;
+
+	std::mutex _streamLock;
+	std::atomic<bool> _isQuitRequest;
+	std::unique_ptr<std::thread> _streamThread;
+	std::vector<class ALSoundSource*> _streams;
 };
 
 _NAME_END
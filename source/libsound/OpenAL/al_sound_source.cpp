@@ -35,15 +35,39 @@
 // | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // +----------------------------------------------------------------------
 #include "al_sound_source.h"
+#include "al_sound_buffer.h"
+#include "al_sound_device.h"
 
 _NAME_BEGIN
 
-ALSoundSource::ALSoundSource() noexcept
-	: _alSource(AL_NONE)
-	, _alFormat(AL_NONE)
+ALSoundSource::ALSoundSource(const ALSoundDevicePtr& device) noexcept
+	: _isLoop(false)
 	, _isPlaying(false)
+	, _isPaused(false)
 	, _isPlayEnd(false)
-	, _isLoop(false)
+	, _isStreamStart(false)
+	, _isStreamEnd(false)
+	, _volume(1.0f)
+	, _volumeMin(0.0f)
+	, _volumeMax(1.0f)
+	, _pitch(1.0f)
+	, _distanceMin(1.0f)
+	, _distanceMax(std::numeric_limits<float>::max())
+	, _translate(float3::Zero)
+	, _velocity(float3::Zero)
+	, _forward(0.0f, 0.0f, -1.0f)
+	, _up(0.0f, 1.0f, 0.0f)
+	, _priority(128)
+	, _playTime(0.0f)
+	, _playLength(0.0f)
+	, _audibility(0.0f)
+	, _streamOffset(0)
+	, _alSource(AL_NONE)
+	, _alBufferSize(0)
+	, _alFormat(AL_NONE)
+	, _alSampleLength(0)
+	, _alSampleLengthTotal(0)
+	, _device(device)
 {
 	std::memset(_alBuffer, 0, sizeof(_alBuffer));
 }
@@ -56,26 +80,19 @@ ALSoundSource::~ALSoundSource() noexcept
 void
 ALSoundSource::open() noexcept
 {
-	assert(_alSource == AL_NONE);
-	::alGenSources(1, &_alSource);
-	::alSourcei(_alSource, AL_SOURCE_TYPE, AL_STREAMING);
-	::alSourcei(_alSource, AL_LOOPING, AL_FALSE);
-	::alSourcei(_alSource, AL_SOURCE_RELATIVE, AL_TRUE);
-
-	::alGenBuffers(1, &_alBuffer[0]);
-	::alGenBuffers(1, &_alBuffer[1]);
+	auto device = _device.lock();
+	if (device)
+		device->addSoundSource(this);
 }
 
 void
 ALSoundSource::close() noexcept
 {
-	if (_alSource != AL_NONE)
-	{
-		this->play(false);
+	this->play(false);
 
-		::alDeleteSources(1, &_alSource);
-		_alSource = AL_NONE;
-	}
+	auto device = _device.lock();
+	if (device)
+		device->removeSoundSource(this);
 
 	for (auto& it : _alBuffer)
 	{
@@ -87,6 +104,7 @@ ALSoundSource::close() noexcept
 	}
 
 	_soundReader = nullptr;
+	_soundBuffer = nullptr;
 }
 
 void
@@ -111,24 +129,26 @@ ALSoundSource::setSoundReader(SoundReaderPtr buffer) noexcept
 {
 	if (_soundReader != buffer)
 	{
+		this->play(false);
+
 		_soundReader = buffer;
+		_soundBuffer = nullptr;
+
+		_isPlayEnd = false;
 
 		if (buffer)
 		{
-			auto soundType = buffer->getBufferType();
-			_alFormat = AL_NONE;
-			if (soundType == SoundFormat::Mono8)
-				_alFormat = AL_FORMAT_MONO8;
-			else if (soundType == SoundFormat::Mono16)
-				_alFormat = AL_FORMAT_MONO16;
-			else if (soundType == SoundFormat::Stereo8)
-				_alFormat = AL_FORMAT_STEREO8;
-			else if (soundType == SoundFormat::Stereo16)
-				_alFormat = AL_FORMAT_STEREO16;
-			else if (soundType == SoundFormat::Quad16)
-				_alFormat = AL_FORMAT_QUAD16;
-			else if (soundType == SoundFormat::Chn16)
-				_alFormat = AL_FORMAT_51CHN16;
+			_alFormat = ALSoundFormat(buffer->getBufferType());
+
+			if ((std::size_t)buffer->size() <= SoundStaticBufferSize)
+			{
+				auto device = _device.lock();
+				if (device)
+					_soundBuffer = device->getSoundBuffer(buffer);
+			}
+
+			if (!_soundBuffer && _alBuffer[0] == AL_NONE)
+				::alGenBuffers(sizeof(_alBuffer) / sizeof(_alBuffer[0]), _alBuffer);
 
 			SoundClip clip;
 			clip.length = 0;
@@ -144,58 +164,91 @@ ALSoundSource::setSoundReader(SoundReaderPtr buffer) noexcept
 void
 ALSoundSource::setPitch(float pitch) noexcept
 {
-	assert(_alSource != AL_NONE);
-	alSourcef(_alSource, AL_PITCH, pitch);
+	if (_alSource != AL_NONE)
+		::alSourcef(_alSource, AL_PITCH, pitch);
+	_pitch = pitch;
 }
 
 void
 ALSoundSource::setVolume(float volume) noexcept
 {
-	assert(_alSource != AL_NONE);
-	alSourcef(_alSource, AL_GAIN, volume);
+	if (_alSource != AL_NONE)
+		::alSourcef(_alSource, AL_GAIN, volume);
+	_volume = volume;
 }
 
 void
 ALSoundSource::setMinVolume(float volume) noexcept
 {
-	assert(_alSource != AL_NONE);
-	alSourcef(_alSource, AL_MIN_GAIN, volume);
+	if (_alSource != AL_NONE)
+		::alSourcef(_alSource, AL_MIN_GAIN, volume);
+	_volumeMin = volume;
 }
 
 void
 ALSoundSource::setMaxVolume(float volume) noexcept
 {
-	assert(_alSource != AL_NONE);
-	alSourcef(_alSource, AL_MAX_GAIN, volume);
+	if (_alSource != AL_NONE)
+		::alSourcef(_alSource, AL_MAX_GAIN, volume);
+	_volumeMax = volume;
 }
 
 void
 ALSoundSource::setTranslate(const float3& translate) noexcept
 {
-	assert(_alSource != AL_NONE);
-	ALfloat pos[] = { translate.x, translate.y, translate.z };
-	alSourcefv(_alSource, AL_POSITION, pos);
+	if (_alSource != AL_NONE)
+		::alSourcefv(_alSource, AL_POSITION, translate.ptr());
+	_translate = translate;
 }
 
 void
 ALSoundSource::setVelocity(const float3& velocity) noexcept
 {
-	assert(_alSource != AL_NONE);
-	ALfloat vel[] = { velocity.x, velocity.y, velocity.z };
-	alSourcefv(_alSource, AL_VELOCITY, vel);
+	if (_alSource != AL_NONE)
+		::alSourcefv(_alSource, AL_VELOCITY, velocity.ptr());
+	_velocity = velocity;
 }
 
 void
 ALSoundSource::setOrientation(const float3& forward, const float3& up) noexcept
 {
-	assert(_alSource != AL_NONE);
-	ALfloat dir[] = { forward.x, forward.y, forward.z, up.x, up.y, up.z };
-	alSourcefv(_alSource, AL_DIRECTION, dir);
+	if (_alSource != AL_NONE)
+	{
+		ALfloat dir[] = { forward.x, forward.y, forward.z, up.x, up.y, up.z };
+		::alSourcefv(_alSource, AL_DIRECTION, dir);
+	}
+
+	_forward = forward;
+	_up = up;
+}
+
+void
+ALSoundSource::setMaxDistance(float maxdis) noexcept
+{
+	if (_alSource != AL_NONE)
+		::alSourcef(_alSource, AL_MAX_DISTANCE, maxdis);
+	_distanceMax = maxdis;
+}
+
+void
+ALSoundSource::setMinDistance(float mindis) noexcept
+{
+	if (_alSource != AL_NONE)
+		::alSourcef(_alSource, AL_REFERENCE_DISTANCE, mindis);
+	_distanceMin = mindis;
+}
+
+void
+ALSoundSource::setPriority(std::uint8_t priority) noexcept
+{
+	_priority = priority;
 }
 
 void
 ALSoundSource::setSoundClip(const SoundClip& clip) noexcept
 {
+	std::lock_guard<std::mutex> lock(_mutex);
+
 	if (clip.channels == 1)
 	{
 		_alBufferSize = clip.freq >> 1;
@@ -217,132 +270,92 @@ ALSoundSource::setSoundClip(const SoundClip& clip) noexcept
 		_alBufferSize -= (_alBufferSize % 12);
 	}
 
-	if (_data.size() < _alBufferSize)
-		_data.resize(_alBufferSize);
-
 	std::size_t size = _soundReader->size();
 
 	_soundClip = clip;
 	_soundClip.length = std::min(clip.length, size);
 	_soundClip.samples = std::min(clip.samples, size);
 
-	_soundReader->seekg(_soundClip.length, ios_base::beg);
+	_playTime = 0.0f;
+	_playLength = clip.freq > 0 ? (float)_soundClip.samples / clip.freq : 0.0f;
 
-	_alSampleLength = _soundClip.samples / (_soundReader->size() / _alBufferSize);
-	_alSampleLengthTotal = 0;
-}
+	if (!_soundBuffer)
+	{
+		if (_data.size() < (std::size_t)_alBufferSize)
+			_data.resize(_alBufferSize);
 
-void
-ALSoundSource::setMaxDistance(float maxdis) noexcept
-{
-	assert(_alSource != AL_NONE);
-	alSourcef(_alSource, AL_MAX_DISTANCE, maxdis);
-}
+		_soundReader->seekg(_soundClip.length, ios_base::beg);
 
-void
-ALSoundSource::setMinDistance(float mindis) noexcept
-{
-	assert(_alSource != AL_NONE);
-	alSourcef(_alSource, AL_REFERENCE_DISTANCE, mindis);
+		_alSampleLength = _soundClip.samples / (_soundReader->size() / _alBufferSize);
+		_alSampleLengthTotal = 0;
+	}
 }
 
 SoundReaderPtr
 ALSoundSource::getSoundBuffer() const noexcept
 {
-	assert(_alSource != AL_NONE);
-	ALint bufferData = 0;
-	::alGetSourceiv(_alSource, AL_BUFFER, &bufferData);
 	return _soundReader;
 }
 
 float
 ALSoundSource::getVolume() const noexcept
 {
-	assert(_alSource != AL_NONE);
-	float volume = -1.0f;
-	alGetSourcef(_alSource, AL_GAIN, &volume);
-	return volume;
+	return _volume;
 }
 
 float
 ALSoundSource::getMinVolume() const noexcept
 {
-	assert(_alSource != AL_NONE);
-	float volume = -1.0f;
-	alGetSourcef(_alSource, AL_MIN_GAIN, &volume);
-	return volume;
+	return _volumeMin;
 }
 
 float
 ALSoundSource::getMaxVolume() const noexcept
 {
-	assert(_alSource != AL_NONE);
-	float volume = -1.0f;
-	alGetSourcef(_alSource, AL_MAX_GAIN, &volume);
-	return volume;
+	return _volumeMax;
 }
 
 void
 ALSoundSource::getTranslate(float3& translate) noexcept
 {
-	assert(_alSource != AL_NONE);
-	ALfloat pos[3];
-	alGetSourcefv(_alSource, AL_POSITION, pos);
-	translate.x = pos[0];
-	translate.y = pos[1];
-	translate.z = pos[2];
+	translate = _translate;
 }
 
 void
 ALSoundSource::getVelocity(float3& velocity) noexcept
 {
-	assert(_alSource != AL_NONE);
-	ALfloat pos[3];
-	alGetSourcefv(_alSource, AL_VELOCITY, pos);
-	velocity.x = pos[0];
-	velocity.y = pos[1];
-	velocity.z = pos[2];
+	velocity = _velocity;
 }
 
 void
 ALSoundSource::getOrientation(float3& forward, float3& up) noexcept
 {
-	assert(_alSource != AL_NONE);
-	ALfloat dir[6];
-	alGetSourcefv(_alSource, AL_DIRECTION, dir);
-	forward.x = dir[0];
-	forward.y = dir[1];
-	forward.z = dir[2];
-	up.x = dir[3];
-	up.y = dir[4];
-	up.z = dir[5];
+	forward = _forward;
+	up = _up;
 }
 
 float
 ALSoundSource::getPitch(void) const noexcept
 {
-	assert(_alSource != AL_NONE);
-	float pitch = -1.0f;
-	alGetSourcef(_alSource, AL_PITCH, &pitch);
-	return pitch;
+	return _pitch;
 }
 
 float
 ALSoundSource::getMaxDistance() const noexcept
 {
-	assert(_alSource != AL_NONE);
-	float distance = false;
-	alGetSourcef(_alSource, AL_MAX_DISTANCE, &distance);
-	return distance;
+	return _distanceMax;
 }
 
 float
 ALSoundSource::getMinDistance() const noexcept
 {
-	assert(_alSource != AL_NONE);
-	float distance = false;
-	alGetSourcef(_alSource, AL_REFERENCE_DISTANCE, &distance);
-	return distance;
+	return _distanceMin;
+}
+
+std::uint8_t
+ALSoundSource::getPriority() const noexcept
+{
+	return _priority;
 }
 
 void
@@ -354,100 +367,225 @@ ALSoundSource::getSoundClip(SoundClip& clip) const noexcept
 void
 ALSoundSource::play(bool play) noexcept
 {
-	assert(_alSource != AL_NONE);
-	assert(_alBuffer != AL_NONE);
-	assert(_alFormat != AL_NONE);
-
 	if (play)
 	{
+		assert(_alFormat != AL_NONE);
+
 		if (_isPlayEnd)
 			return;
 
-		this->_updateSoundQueue();
+		if (_isPaused)
+		{
+			if (_alSource != AL_NONE)
+				::alSourcePlay(_alSource);
+
+			_isPaused = false;
+			return;
+		}
 
-		if (!this->isPlaying())
+		if (_isPlaying)
 		{
-			if (_isPlaying || _alSampleLengthTotal > _soundClip.samples || _soundReader->eof())
+			if (_alSource == AL_NONE)
 			{
-				if (!_isLoop)
-				{
+				if (!_isLoop && _playTime >= _playLength)
 					this->_playEnd();
-					return;
-				}
+			}
+			else if (_soundBuffer)
+			{
+				ALint state = AL_NONE;
+				::alGetSourcei(_alSource, AL_SOURCE_STATE, &state);
+				if (state == AL_STOPPED)
+					this->_playEnd();
+			}
+			else if (_isStreamEnd)
+			{
+				this->_playEnd();
 			}
 
-			this->_playStart();
+			return;
+		}
+
+		auto device = _device.lock();
+		if (device)
+		{
+			_isPlaying = true;
+			_playTime = 0.0f;
+
+			device->requestVoice(this);
 		}
 	}
 	else
 	{
-		::alSourceStop(_alSource);
+		auto device = _device.lock();
+		if (device && _alSource != AL_NONE)
+			device->releaseVoice(this);
+
+		_isStreamEnd = false;
+		_isPlaying = false;
+		_isPaused = false;
 	}
 }
 
 void
 ALSoundSource::loop(bool loop) noexcept
 {
+	if (_soundBuffer && _alSource != AL_NONE)
+		::alSourcei(_alSource, AL_LOOPING, loop ? AL_TRUE : AL_FALSE);
 	_isLoop = loop;
 }
 
 void
 ALSoundSource::pause() noexcept
 {
-	assert(_alSource != AL_NONE);
-	::alSourcePause(_alSource);
+	if (_alSource != AL_NONE)
+		::alSourcePause(_alSource);
+	_isPaused = true;
 }
 
 bool
 ALSoundSource::isPlaying() const noexcept
 {
-	if (_alSource != AL_NONE)
-	{
-		ALint state = AL_NONE;
-		alGetSourcei(_alSource, AL_SOURCE_STATE, &state);
-		return state == AL_PLAYING;
-	}
-
-	return false;
+	return _isPlaying && !_isPaused;
 }
 
 bool
 ALSoundSource::isStopped() const noexcept
 {
-	if (_alSource != AL_NONE)
+	return !_isPlaying;
+}
+
+bool
+ALSoundSource::isPaused() const noexcept
+{
+	return _isPlaying && _isPaused;
+}
+
+bool
+ALSoundSource::isLoop() const noexcept
+{
+	return _isLoop;
+}
+
+bool
+ALSoundSource::isStreaming() const noexcept
+{
+	return _soundBuffer ? false : true;
+}
+
+bool
+ALSoundSource::isVirtual() const noexcept
+{
+	return _isPlaying && _alSource == AL_NONE;
+}
+
+bool
+ALSoundSource::_bindVoice(ALuint source) noexcept
+{
+	assert(_alSource == AL_NONE);
+	assert(_soundReader);
+
+	_alSource = source;
+
+	ALfloat dir[] = { _forward.x, _forward.y, _forward.z, _up.x, _up.y, _up.z };
+
+	::alSourcei(_alSource, AL_SOURCE_RELATIVE, AL_FALSE);
+	::alSourcef(_alSource, AL_GAIN, _volume);
+	::alSourcef(_alSource, AL_MIN_GAIN, _volumeMin);
+	::alSourcef(_alSource, AL_MAX_GAIN, _volumeMax);
+	::alSourcef(_alSource, AL_PITCH, _pitch);
+	::alSourcef(_alSource, AL_REFERENCE_DISTANCE, _distanceMin);
+	::alSourcef(_alSource, AL_MAX_DISTANCE, _distanceMax);
+	::alSourcefv(_alSource, AL_POSITION, _translate.ptr());
+	::alSourcefv(_alSource, AL_VELOCITY, _velocity.ptr());
+	::alSourcefv(_alSource, AL_DIRECTION, dir);
+
+	if (_soundBuffer)
 	{
-		ALint state = AL_NONE;
-		alGetSourcei(_alSource, AL_SOURCE_STATE, &state);
-		return state == AL_STOPPED || state == AL_INITIAL;
+		::alSourcei(_alSource, AL_BUFFER, _soundBuffer->getInstanceID());
+		::alSourcei(_alSource, AL_LOOPING, _isLoop ? AL_TRUE : AL_FALSE);
+		if (_playTime < _playLength)
+			::alSourcef(_alSource, AL_SEC_OFFSET, _playTime);
+
+		if (!_isPaused)
+			::alSourcePlay(_alSource);
+	}
+	else
+	{
+		::alSourcei(_alSource, AL_LOOPING, AL_FALSE);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_streamOffset = (std::size_t)(_playTime * _soundClip.freq);
+		}
+
+		_isStreamStart = true;
 	}
 
 	return true;
 }
 
-bool
-ALSoundSource::isPaused() const noexcept
+ALuint
+ALSoundSource::_unbindVoice() noexcept
 {
-	if (_alSource != AL_NONE)
+	assert(_alSource != AL_NONE);
+
+	if (_soundBuffer)
+	{
+		ALfloat offset = 0.0f;
+		::alGetSourcef(_alSource, AL_SEC_OFFSET, &offset);
+		_playTime = offset;
+
+		::alSourceStop(_alSource);
+		::alSourcei(_alSource, AL_BUFFER, AL_NONE);
+	}
+	else
 	{
-		ALint state = AL_NONE;
-		alGetSourcei(_alSource, AL_SOURCE_STATE, &state);
-		return state == AL_PAUSED;
+		std::lock_guard<std::mutex> lock(_mutex);
+		this->_clearSoundQueue();
+
+		_isStreamStart = false;
 	}
 
-	return false;
+	auto source = _alSource;
+	_alSource = AL_NONE;
+	return source;
 }
 
-bool
-ALSoundSource::isLoop() const noexcept
+float
+ALSoundSource::_computeAudibility(const float3& listener) const noexcept
 {
-	return _isLoop;
+	float distance = math::distance(_translate, listener);
+	if (distance > _distanceMax)
+		return 0.0f;
+
+	float attenuation = _distanceMin / std::max(distance, _distanceMin);
+	float gain = std::max(_volumeMin, std::min(_volume * attenuation, _volumeMax));
+
+	// priority ranks first, the audible gain only orders sources of the same priority
+	return _priority + std::min(gain, 1.0f);
+}
+
+void
+ALSoundSource::_updateVirtual(float delta) noexcept
+{
+	if (!_isPlaying || _isPaused)
+		return;
+
+	_playTime += delta * _pitch;
+
+	if (_isLoop && _playLength > 0.0f && _playTime >= _playLength)
+		_playTime = std::fmod(_playTime, _playLength);
 }
 
 void
 ALSoundSource::_initSoundStream() noexcept
 {
-	_alSampleLengthTotal = _soundClip.length;
-	_soundReader->seekg(_soundClip.length, ios_base::beg);
+	std::size_t frame = _soundClip.samples > 0 ? _soundReader->size() / _soundClip.samples : 0;
+
+	_alSampleLengthTotal = _soundClip.length + _streamOffset;
+	_soundReader->seekg(_soundClip.length + _streamOffset * frame, ios_base::beg);
+
+	_streamOffset = 0;
 }
 
 void
@@ -458,7 +596,7 @@ ALSoundSource::_playStart() noexcept
 
 	for (auto it : _alBuffer)
 	{
-		_soundReader->read(_data.data(), _data.size());
+		_soundReader->read(_data.data(), _alBufferSize);
 		if (_soundReader->gcount() > 0)
 		{
 			::alBufferData(it, _alFormat, _data.data(), _soundReader->gcount(), _soundClip.freq);
@@ -469,19 +607,19 @@ ALSoundSource::_playStart() noexcept
 	}
 
 	::alSourcePlay(_alSource);
-
-	_isPlaying = true;
-	_isPlayEnd = false;
 }
 
 void
 ALSoundSource::_playEnd() noexcept
 {
+	auto device = _device.lock();
+	if (device && _alSource != AL_NONE)
+		device->releaseVoice(this);
+
 	for (auto& it : _listeners)
 		it->onPlayEnd();
 
-	this->_clearSoundQueue();
-
+	_isStreamEnd = false;
 	_isPlayEnd = true;
 	_isPlaying = false;
 }
@@ -489,14 +627,8 @@ ALSoundSource::_playEnd() noexcept
 void
 ALSoundSource::_clearSoundQueue() noexcept
 {
-	ALint processed = 0;
-	::alGetSourcei(_alSource, AL_BUFFERS_PROCESSED, &processed);
-
-	while (processed--)
-	{
-		ALuint buff;
-		::alSourceUnqueueBuffers(_alSource, 1, &buff);
-	}
+	::alSourceStop(_alSource);
+	::alSourcei(_alSource, AL_BUFFER, AL_NONE);
 }
 
 void
@@ -511,9 +643,9 @@ ALSoundSource::_updateSoundQueue() noexcept
 		::alSourceUnqueueBuffers(_alSource, 1, &buff);
 
 		if (_alSampleLengthTotal > _soundClip.samples || _soundReader->eof())
-			break;
+			continue;
 
-		_soundReader->read(_data.data(), _data.size());
+		_soundReader->read(_data.data(), _alBufferSize);
 		if (_soundReader->gcount() > 0)
 		{
 			::alBufferData(buff, _alFormat, _data.data(), _soundReader->gcount(), _soundClip.freq);
@@ -524,4 +656,37 @@ ALSoundSource::_updateSoundQueue() noexcept
 	}
 }
 
-_NAME_END
\ No newline at end of file
+void
+ALSoundSource::_updateSoundStream() noexcept
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	if (!_soundReader || _isStreamEnd || _alSource == AL_NONE)
+		return;
+
+	if (_isStreamStart)
+	{
+		_isStreamStart = false;
+		this->_playStart();
+		return;
+	}
+
+	this->_updateSoundQueue();
+
+	ALint state = AL_NONE;
+	::alGetSourcei(_alSource, AL_SOURCE_STATE, &state);
+	if (state != AL_STOPPED)
+		return;
+
+	ALint queued = 0;
+	::alGetSourcei(_alSource, AL_BUFFERS_QUEUED, &queued);
+
+	if (queued > 0)
+		::alSourcePlay(_alSource);
+	else if (_isLoop)
+		this->_playStart();
+	else
+		_isStreamEnd = true;
+}
+
+_NAME_END
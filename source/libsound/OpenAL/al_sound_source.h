@@ -39,12 +39,15 @@
 
 #include "al_sound_types.h"
 
+#include <mutex>
+#include <atomic>
+
 _NAME_BEGIN
 
 class EXPORT ALSoundSource final : public SoundSource
 {
 public:
-	ALSoundSource() noexcept;
+	ALSoundSource(const ALSoundDevicePtr& device) noexcept;
 	virtual ~ALSoundSource() noexcept;
 
 	virtual void open() noexcept;
@@ -65,6 +68,7 @@ public:
 	virtual void setPitch(float pitch) noexcept;
 	virtual void setMaxDistance(float maxdis) noexcept;
 	virtual void setMinDistance(float mindis) noexcept;
+	virtual void setPriority(std::uint8_t priority) noexcept;
 	virtual void setSoundClip(const SoundClip& clip) noexcept;
 
 	virtual void getTranslate(float3& translate) noexcept;
@@ -78,6 +82,7 @@ public:
 	virtual float getPitch() const noexcept;
 	virtual float getMaxDistance() const noexcept;
 	virtual float getMinDistance() const noexcept;
+	virtual std::uint8_t getPriority() const noexcept;
 
 	virtual void play(bool play) noexcept;
 	virtual void loop(bool loop) noexcept;
@@ -88,7 +93,18 @@ public:
 	virtual bool isPaused() const noexcept;
 	virtual bool isLoop() const noexcept;
 
+	bool isStreaming() const noexcept;
+	bool isVirtual() const noexcept;
+
 private:
+	friend class ALSoundDevice;
+
+	bool _bindVoice(ALuint source) noexcept;
+	ALuint _unbindVoice() noexcept;
+
+	float _computeAudibility(const float3& listener) const noexcept;
+
+	void _updateVirtual(float delta) noexcept;
 
 	void _playStart() noexcept;
 	void _playEnd() noexcept;
@@ -96,26 +112,55 @@ private:
 	void _initSoundStream() noexcept;
 	void _clearSoundQueue() noexcept;
 	void _updateSoundQueue() noexcept;
+	void _updateSoundStream() noexcept;
 
 private:
 
 	bool _isLoop;
 	bool _isPlaying;
+	bool _isPaused;
 	bool _isPlayEnd;
 
+	std::atomic<bool> _isStreamStart;
+	std::atomic<bool> _isStreamEnd;
+
+	float _volume;
+	float _volumeMin;
+	float _volumeMax;
+	float _pitch;
+	float _distanceMin;
+	float _distanceMax;
+
+	float3 _translate;
+	float3 _velocity;
+	float3 _forward;
+	float3 _up;
+
+	std::uint8_t _priority;
+
+	float _playTime;
+	float _playLength;
+	float _audibility;
+
+	std::size_t _streamOffset;
+
 	ALuint  _alSource;
-	ALuint  _alBuffer[2];
+	ALuint  _alBuffer[4];
 	ALsizei _alBufferSize;
 	ALenum  _alFormat;
 
 	ALsizei _alSampleLength;
 	ALsizei _alSampleLengthTotal;
 
+	std::mutex _mutex;
+
 	std::vector<char> _data;
 	std::vector<SoundSourceListener*> _listeners;
 
 	SoundClip _soundClip;
 	SoundReaderPtr _soundReader;
+	ALSoundBufferPtr _soundBuffer;
+	ALSoundDeviceWeakPtr _device;
 };
 
 _NAME_END
@@ -53,6 +53,29 @@ _NAME_BEGIN
 #define ALKEY_BUFFER_INSTANCE "$al.buffer",0,0
 
 typedef std::shared_ptr<class ALSoundBuffer> ALSoundBufferPtr;
+typedef std::shared_ptr<class ALSoundDevice> ALSoundDevicePtr;
+typedef std::weak_ptr<class ALSoundDevice> ALSoundDeviceWeakPtr;
+
+inline ALenum ALSoundFormat(SoundFormat format) noexcept
+{
+	switch (format)
+	{
+	case SoundFormat::Mono8:
+		return AL_FORMAT_MONO8;
+	case SoundFormat::Mono16:
+		return AL_FORMAT_MONO16;
+	case SoundFormat::Stereo8:
+		return AL_FORMAT_STEREO8;
+	case SoundFormat::Stereo16:
+		return AL_FORMAT_STEREO16;
+	case SoundFormat::Quad16:
+		return AL_FORMAT_QUAD16;
+	case SoundFormat::Chn16:
+		return AL_FORMAT_51CHN16;
+	default:
+		return AL_NONE;
+	}
+}
 
 _NAME_END
 
@@ -110,6 +110,27 @@ SoundSystem::getDistanceModel() const noexcept
 	return _soundDevice->getDistanceModel();
 }
 
+void
+SoundSystem::setMaxVoices(std::uint32_t count) noexcept
+{
+	assert(_soundDevice);
+	_soundDevice->setMaxVoices(count);
+}
+
+std::uint32_t
+SoundSystem::getMaxVoices() const noexcept
+{
+	assert(_soundDevice);
+	return _soundDevice->getMaxVoices();
+}
+
+void
+SoundSystem::update(float delta) noexcept
+{
+	assert(_soundDevice);
+	_soundDevice->update(delta);
+}
+
 SoundListenerPtr
 SoundSystem::createSoundListener() noexcept
 {
@@ -149,16 +170,19 @@ SoundSystem::createSoundReader(const std::string& filename, SoundFile::Type type
 {
 	assert(this->isOpened());
 
-	auto soundReader = _soundReaders[filename];
-	if (!soundReader)
-	{
-		StreamReaderPtr stream;
-		if (IoServer::instance()->openFileURL(stream, filename))
-			soundReader = createSoundReader(stream, type);
+	auto it = _soundReaders.find(filename);
+	if (it != _soundReaders.end())
+		return it->second;
 
-		if (soundReader)
-			_soundReaders[filename] = soundReader;
-	}
+	SoundReaderPtr soundReader;
+
+	StreamReaderPtr stream;
+	if (IoServer::instance()->openFileURL(stream, filename))
+		soundReader = createSoundReader(stream, type);
+
+	// A streamed source seeks and decodes its reader on the audio thread, so long sounds get a reader of their own per call
+	if (soundReader && (std::size_t)soundReader->size() <= SoundStaticBufferSize)
+		_soundReaders[filename] = soundReader;
 
 	return soundReader;
 }
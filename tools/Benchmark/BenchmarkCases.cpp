@@ -0,0 +1,496 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include "BenchmarkCases.h"
+
+#include <ray/model.h>
+#include <ray/mstream.h>
+#include <ray/timer.h>
+#include <ray/rtti_factory.h>
+#include <ray/profiler.h>
+
+#include <cstdio>
+#include <cmath>
+#include <sstream>
+
+_NAME_BEGIN
+
+template<typename Func>
+static BenchmarkCaseResult
+measureCase(const BenchmarkParams& params, const char* name, const char* unit, double items, Func func) noexcept
+{
+	BenchmarkCaseResult result;
+	result.name = name;
+	result.unit = unit;
+	result.items = items;
+	result.iterations = std::max<std::uint32_t>(params.iterations, 1);
+	result.total = 0;
+	result.best = std::numeric_limits<std::uint64_t>::max();
+
+	func();
+
+	for (std::uint32_t i = 0; i < result.iterations; i++)
+	{
+		auto begin = Timer::clock();
+		func();
+		auto time = Timer::clock() - begin;
+
+		result.total += time;
+		result.best = std::min(result.best, time);
+	}
+
+	return result;
+}
+
+// A height field of grid * grid quads split into triangles, with a usemtl group per band of rows.
+static void
+makeObjSource(std::string& text, std::uint32_t grid, bool positionOnly) noexcept
+{
+	constexpr std::uint32_t numMaterials = 4;
+
+	char line[256];
+
+	std::uint32_t numVertices = grid + 1;
+	std::uint32_t numRows = std::max<std::uint32_t>(grid / numMaterials, 1);
+
+	text.clear();
+	text.reserve((std::size_t)numVertices * numVertices * (positionOnly ? 32 : 96) + (std::size_t)grid * grid * (positionOnly ? 48 : 112));
+	text += "# generated by Benchmark\n";
+
+	for (std::uint32_t y = 0; y < numVertices; y++)
+	{
+		for (std::uint32_t x = 0; x < numVertices; x++)
+		{
+			float height = std::sin(x * 0.05f) * std::cos(y * 0.05f);
+			std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", (float)x, height, (float)y);
+			text += line;
+		}
+	}
+
+	if (!positionOnly)
+	{
+		for (std::uint32_t y = 0; y < numVertices; y++)
+		{
+			for (std::uint32_t x = 0; x < numVertices; x++)
+			{
+				std::snprintf(line, sizeof(line), "vt %.6f %.6f\n", (float)x / grid, (float)y / grid);
+				text += line;
+			}
+		}
+
+		for (std::uint32_t y = 0; y < numVertices; y++)
+		{
+			for (std::uint32_t x = 0; x < numVertices; x++)
+			{
+				float nx = -std::cos(x * 0.05f) * std::cos(y * 0.05f) * 0.05f;
+				float nz = std::sin(x * 0.05f) * std::sin(y * 0.05f) * 0.05f;
+				float length = std::sqrt(nx * nx + 1.0f + nz * nz);
+				std::snprintf(line, sizeof(line), "vn %.6f %.6f %.6f\n", nx / length, 1.0f / length, nz / length);
+				text += line;
+			}
+		}
+	}
+
+	for (std::uint32_t y = 0; y < grid; y++)
+	{
+		if (y % numRows == 0)
+		{
+			std::snprintf(line, sizeof(line), "usemtl material%u\n", std::min(y / numRows, numMaterials - 1));
+			text += line;
+		}
+
+		for (std::uint32_t x = 0; x < grid; x++)
+		{
+			std::uint32_t a = y * numVertices + x + 1;
+			std::uint32_t b = a + 1;
+			std::uint32_t c = a + numVertices;
+			std::uint32_t d = c + 1;
+
+			if (positionOnly)
+				std::snprintf(line, sizeof(line), "f %u %u %u\nf %u %u %u\n", a, c, b, b, c, d);
+			else
+				std::snprintf(line, sizeof(line), "f %u/%u/%u %u/%u/%u %u/%u/%u\nf %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, c, c, c, b, b, b, b, b, b, c, c, c, d, d, d);
+
+			text += line;
+		}
+	}
+}
+
+// The line parser ObjHandler used before, a getline and istringstream per line, kept as the reference.
+static std::size_t
+parseObjIostream(const std::string& text) noexcept
+{
+	Float3Array v;
+	Float2Array vt;
+	Float3Array vn;
+
+	std::vector<std::uint32_t> fv;
+	std::vector<std::uint32_t> ft;
+	std::vector<std::uint32_t> fn;
+
+	std::istringstream infile(text);
+	std::string line;
+	std::string token;
+
+	while (std::getline(infile, line))
+	{
+		if (line.size() < 2)
+			continue;
+
+		if (line[0] == 'v')
+		{
+			std::istringstream in(line);
+			in >> token;
+
+			if (line[1] == ' ')
+			{
+				float3 value;
+				in >> value.x >> value.y >> value.z;
+				v.push_back(value);
+			}
+			else if (line[1] == 't')
+			{
+				float2 value;
+				in >> value.x >> value.y;
+				vt.push_back(value);
+			}
+			else if (line[1] == 'n')
+			{
+				float3 value;
+				in >> value.x >> value.y >> value.z;
+				vn.push_back(value);
+			}
+		}
+		else if (line[0] == 'f')
+		{
+			std::istringstream in(line);
+			in >> token;
+
+			for (std::size_t i = 0; i < 3; i++)
+			{
+				in >> token;
+
+				std::uint32_t index[3] = { 0, 0, 0 };
+				std::size_t slot = 0;
+
+				for (auto ch : token)
+				{
+					if (ch == '/')
+						slot = std::min<std::size_t>(slot + 1, 2);
+					else
+						index[slot] = index[slot] * 10 + (ch - '0');
+				}
+
+				fv.push_back(index[0]);
+				ft.push_back(index[1]);
+				fn.push_back(index[2]);
+			}
+		}
+	}
+
+	return fv.size() / 3;
+}
+
+static bool
+loadObj(const std::string& text) noexcept
+{
+	MemoryReader stream;
+	stream.resize(text.size());
+	std::memcpy(stream.map(), text.data(), text.size());
+	stream.unmap();
+
+	Model model;
+	return model.load(stream, "obj") && !model.getMeshsList().empty();
+}
+
+static bool
+runObjCase(const BenchmarkParams& params, BenchmarkCaseResults& results) noexcept
+{
+	std::uint32_t grid = std::max<std::uint32_t>(params.objGrid, 1);
+	double triangles = 2.0 * grid * grid;
+
+	std::string text;
+
+	for (std::uint32_t i = 0; i < 2; i++)
+	{
+		bool positionOnly = i == 0;
+
+		makeObjSource(text, grid, positionOnly);
+
+		if (!loadObj(text))
+		{
+			std::fprintf(stderr, "failed to parse the generated obj.\n");
+			return false;
+		}
+
+		std::size_t count = parseObjIostream(text);
+		if (count != (std::size_t)triangles)
+		{
+			std::fprintf(stderr, "the reference parser read %zu of %.0f triangles.\n", count, triangles);
+			return false;
+		}
+
+		results.push_back(measureCase(params, positionOnly ? "obj_position_iostream" : "obj_full_iostream", "triangles", triangles, [&]() { parseObjIostream(text); }));
+		results.push_back(measureCase(params, positionOnly ? "obj_position_load" : "obj_full_load", "triangles", triangles, [&]() { loadObj(text); }));
+	}
+
+	return true;
+}
+
+namespace
+{
+	// An eight level chain registered with the rtti factory, deep enough that the parent walk shows up.
+	class BenchmarkRtti0 : public rtti::Interface { __DeclareSubClass(BenchmarkRtti0, rtti::Interface) };
+	class BenchmarkRtti1 : public BenchmarkRtti0 { __DeclareSubClass(BenchmarkRtti1, BenchmarkRtti0) };
+	class BenchmarkRtti2 : public BenchmarkRtti1 { __DeclareSubClass(BenchmarkRtti2, BenchmarkRtti1) };
+	class BenchmarkRtti3 : public BenchmarkRtti2 { __DeclareSubClass(BenchmarkRtti3, BenchmarkRtti2) };
+	class BenchmarkRtti4 : public BenchmarkRtti3 { __DeclareSubClass(BenchmarkRtti4, BenchmarkRtti3) };
+	class BenchmarkRtti5 : public BenchmarkRtti4 { __DeclareSubClass(BenchmarkRtti5, BenchmarkRtti4) };
+	class BenchmarkRtti6 : public BenchmarkRtti5 { __DeclareSubClass(BenchmarkRtti6, BenchmarkRtti5) };
+	class BenchmarkRtti7 : public BenchmarkRtti6 { __DeclareSubClass(BenchmarkRtti7, BenchmarkRtti6) };
+
+	__ImplementSubClass(BenchmarkRtti0, rtti::Interface, "BenchmarkRtti0")
+	__ImplementSubClass(BenchmarkRtti1, BenchmarkRtti0, "BenchmarkRtti1")
+	__ImplementSubClass(BenchmarkRtti2, BenchmarkRtti1, "BenchmarkRtti2")
+	__ImplementSubClass(BenchmarkRtti3, BenchmarkRtti2, "BenchmarkRtti3")
+	__ImplementSubClass(BenchmarkRtti4, BenchmarkRtti3, "BenchmarkRtti4")
+	__ImplementSubClass(BenchmarkRtti5, BenchmarkRtti4, "BenchmarkRtti5")
+	__ImplementSubClass(BenchmarkRtti6, BenchmarkRtti5, "BenchmarkRtti6")
+	__ImplementSubClass(BenchmarkRtti7, BenchmarkRtti6, "BenchmarkRtti7")
+}
+
+// The chain walk isDerivedFrom did before the factory assigned intervals, kept as the reference.
+static bool
+isDerivedFromParent(const rtti::Rtti* rtti, const rtti::Rtti* other) noexcept
+{
+	for (const rtti::Rtti* cur = rtti; cur; cur = cur->getParent())
+	{
+		if (cur == other)
+			return true;
+	}
+
+	return false;
+}
+
+static bool
+runRttiCase(const BenchmarkParams& params, BenchmarkCaseResults& results) noexcept
+{
+	constexpr std::uint32_t numRounds = 1 << 17;
+
+	if (!rtti::Factory::instance()->open())
+	{
+		std::fprintf(stderr, "failed to open the rtti factory.\n");
+		return false;
+	}
+
+	std::vector<std::unique_ptr<rtti::Interface>> objects;
+	objects.push_back(std::make_unique<BenchmarkRtti0>());
+	objects.push_back(std::make_unique<BenchmarkRtti1>());
+	objects.push_back(std::make_unique<BenchmarkRtti2>());
+	objects.push_back(std::make_unique<BenchmarkRtti3>());
+	objects.push_back(std::make_unique<BenchmarkRtti4>());
+	objects.push_back(std::make_unique<BenchmarkRtti5>());
+	objects.push_back(std::make_unique<BenchmarkRtti6>());
+	objects.push_back(std::make_unique<BenchmarkRtti7>());
+
+	const rtti::Rtti* root = BenchmarkRtti0::getRtti();
+	const rtti::Rtti* leaf = BenchmarkRtti7::getRtti();
+
+	std::size_t expected = objects.size() + 1;
+	double checks = 2.0 * objects.size() * numRounds;
+
+	std::size_t hits[3] = { 0, 0, 0 };
+
+	for (auto& it : objects)
+	{
+		hits[0] += it->rtti()->isDerivedFrom(root) + it->rtti()->isDerivedFrom(leaf);
+		hits[1] += isDerivedFromParent(it->rtti(), root) + isDerivedFromParent(it->rtti(), leaf);
+		hits[2] += (dynamic_cast<BenchmarkRtti0*>(it.get()) != nullptr) + (dynamic_cast<BenchmarkRtti7*>(it.get()) != nullptr);
+	}
+
+	if (hits[0] != expected || hits[1] != expected || hits[2] != expected)
+	{
+		std::fprintf(stderr, "the type checks disagree: interval %zu, parent %zu, dynamic_cast %zu of %zu.\n", hits[0], hits[1], hits[2], expected);
+		return false;
+	}
+
+	volatile std::size_t sink = 0;
+
+	results.push_back(measureCase(params, "rtti_isDerivedFrom_parent", "checks", checks, [&]()
+	{
+		std::size_t count = 0;
+		for (std::uint32_t i = 0; i < numRounds; i++)
+		{
+			for (auto& it : objects)
+				count += isDerivedFromParent(it->rtti(), root) + isDerivedFromParent(it->rtti(), leaf);
+		}
+
+		sink = sink + count;
+	}));
+
+	results.push_back(measureCase(params, "rtti_isDerivedFrom_interval", "checks", checks, [&]()
+	{
+		std::size_t count = 0;
+		for (std::uint32_t i = 0; i < numRounds; i++)
+		{
+			for (auto& it : objects)
+				count += it->rtti()->isDerivedFrom(root) + it->rtti()->isDerivedFrom(leaf);
+		}
+
+		sink = sink + count;
+	}));
+
+	results.push_back(measureCase(params, "rtti_dynamic_cast", "checks", checks, [&]()
+	{
+		std::size_t count = 0;
+		for (std::uint32_t i = 0; i < numRounds; i++)
+		{
+			for (auto& it : objects)
+				count += (dynamic_cast<BenchmarkRtti0*>(it.get()) != nullptr) + (dynamic_cast<BenchmarkRtti7*>(it.get()) != nullptr);
+		}
+
+		sink = sink + count;
+	}));
+
+	return true;
+}
+
+// The empty loop is what __ProfileScope costs when _BUILD_PROFILER is off, the other two construct a
+// ProfileScope directly so it is compiled in whatever the build flags are.
+static bool
+runProfilerCase(const BenchmarkParams& params, BenchmarkCaseResults& results) noexcept
+{
+	constexpr std::uint32_t numScopes = 1 << 20;
+
+	auto profiler = Profiler::instance();
+	bool enable = Profiler::getEnable();
+
+	volatile std::uint32_t sink = 0;
+
+	profiler->setEnable(false);
+
+	results.push_back(measureCase(params, "profiler_empty_loop", "scopes", numScopes, [&]()
+	{
+		for (std::uint32_t i = 0; i < numScopes; i++)
+			sink = sink + i;
+	}));
+
+	results.push_back(measureCase(params, "profiler_scope_disabled", "scopes", numScopes, [&]()
+	{
+		for (std::uint32_t i = 0; i < numScopes; i++)
+		{
+			ProfileScope scope("profiler_scope_disabled");
+			sink = sink + i;
+		}
+	}));
+
+	if (profiler->getEventCount() != 0)
+	{
+		std::fprintf(stderr, "a disabled profiler recorded %zu events.\n", profiler->getEventCount());
+		return false;
+	}
+
+	profiler->setEnable(true);
+
+	// the events are cleared after every pass, the vectors keep their capacity so only the first pass grows them
+	results.push_back(measureCase(params, "profiler_scope_enabled", "scopes", numScopes, [&]()
+	{
+		for (std::uint32_t i = 0; i < numScopes; i++)
+		{
+			ProfileScope scope("profiler_scope_enabled");
+			sink = sink + i;
+		}
+
+		profiler->clear();
+	}));
+
+	profiler->setEnable(enable);
+
+	return true;
+}
+
+bool
+runBenchmarkCase(const BenchmarkParams& params, BenchmarkCaseResults& results) noexcept
+{
+	if (params.benchCase == "obj")
+		return runObjCase(params, results);
+
+	if (params.benchCase == "rtti")
+		return runRttiCase(params, results);
+
+	if (params.benchCase == "profiler")
+		return runProfilerCase(params, results);
+
+	std::fprintf(stderr, "unknown case %s.\n", params.benchCase.c_str());
+	return false;
+}
+
+void
+printBenchmarkCases(const BenchmarkParams& params, const BenchmarkCaseResults& results) noexcept
+{
+	if (params.csv)
+	{
+		std::printf("case,iterations,mean_ms,best_ms,items,unit,items_per_s\n");
+
+		for (auto& it : results)
+		{
+			double mean = it.total / 1000000.0 / it.iterations;
+			double best = std::max(it.best / 1000000.0, 1e-6);
+			std::printf("%s,%u,%.4f,%.4f,%.0f,%s,%.0f\n", it.name.c_str(), it.iterations, mean, best, it.items, it.unit.c_str(), it.items * 1000.0 / best);
+		}
+	}
+	else
+	{
+		std::printf("{\n");
+		std::printf("  \"case\": \"%s\",\n", params.benchCase.c_str());
+		std::printf("  \"results\": [\n");
+
+		for (std::size_t i = 0; i < results.size(); i++)
+		{
+			auto& it = results[i];
+			double mean = it.total / 1000000.0 / it.iterations;
+			double best = std::max(it.best / 1000000.0, 1e-6);
+			std::printf("    { \"name\": \"%s\", \"iterations\": %u, \"mean_ms\": %.4f, \"best_ms\": %.4f, \"items\": %.0f, \"unit\": \"%s\", \"items_per_s\": %.0f }%s\n",
+				it.name.c_str(), it.iterations, mean, best, it.items, it.unit.c_str(), it.items * 1000.0 / best,
+				i + 1 < results.size() ? "," : "");
+		}
+
+		std::printf("  ]\n");
+		std::printf("}\n");
+	}
+}
+
+_NAME_END
@@ -0,0 +1,309 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include "BenchmarkComponents.h"
+
+#include <ray/game_server.h>
+#include <ray/game_object.h>
+#include <ray/camera.h>
+#include <ray/geometry.h>
+#include <ray/profiler.h>
+
+_NAME_BEGIN
+
+__ImplementSubClass(BenchmarkRenderFeature, GameFeature, "BenchmarkRenderFeature")
+__ImplementSubClass(BenchmarkRenderObjectComponent, GameComponent, "BenchmarkRenderObject")
+__ImplementSubClass(BenchmarkSkinComponent, GameComponent, "BenchmarkSkin")
+__ImplementSubClass(BenchmarkAnimatorComponent, GameComponent, "BenchmarkAnimator")
+
+BenchmarkRenderFeature::BenchmarkRenderFeature() noexcept
+{
+}
+
+BenchmarkRenderFeature::~BenchmarkRenderFeature() noexcept
+{
+}
+
+const RenderScenePtr&
+BenchmarkRenderFeature::getRenderScene() const noexcept
+{
+	return _renderScene;
+}
+
+const CameraPtr&
+BenchmarkRenderFeature::getCamera() const noexcept
+{
+	return _camera;
+}
+
+std::size_t
+BenchmarkRenderFeature::getNumVisible() const noexcept
+{
+	return _visible.iter().size();
+}
+
+std::size_t
+BenchmarkRenderFeature::getNumVisibleLights() const noexcept
+{
+	return _visibleLights.iter().size();
+}
+
+void
+BenchmarkRenderFeature::onActivate() except
+{
+	_renderScene = std::make_shared<RenderScene>();
+
+	float4x4 transform;
+	transform.makeTransform(float3(0.0f, 40.0f, -120.0f), Quaternion(float3(15.0f, 0.0f, 0.0f)));
+
+	_camera = std::make_shared<Camera>();
+	_camera->setAperture(60.0f);
+	_camera->setRatio(16.0f / 9.0f);
+	_camera->setNear(0.1f);
+	_camera->setFar(1000.0f);
+	_camera->setTransform(transform);
+	_camera->setRenderScene(_renderScene);
+}
+
+void
+BenchmarkRenderFeature::onDeactivate() noexcept
+{
+	if (_camera)
+	{
+		_camera->setRenderScene(nullptr);
+		_camera.reset();
+	}
+
+	_visible.clear();
+	_visibleLights.clear();
+	_renderScene.reset();
+}
+
+void
+BenchmarkRenderFeature::onFrameEnd() noexcept
+{
+	__ProfileScope("BenchmarkRenderFeature::culling");
+
+	_visible.clear();
+	_renderScene->computVisiable(*_camera, _visible);
+	_visible.sort();
+
+	for (auto& it : _visible.iter())
+		it.getOcclusionCullNode()->onVisiableDistance(*_camera, it.getDistanceSqrt());
+
+	_visibleLights.clear();
+	_renderScene->computVisiableLight(*_camera, _visibleLights);
+}
+
+BenchmarkRenderObjectComponent::BenchmarkRenderObjectComponent() noexcept
+{
+}
+
+BenchmarkRenderObjectComponent::BenchmarkRenderObjectComponent(const RenderObjectPtr& object) noexcept
+	: _renderObject(object)
+{
+}
+
+BenchmarkRenderObjectComponent::~BenchmarkRenderObjectComponent() noexcept
+{
+	if (_renderObject)
+		_renderObject->setRenderScene(nullptr);
+}
+
+const RenderObjectPtr&
+BenchmarkRenderObjectComponent::getRenderObject() const noexcept
+{
+	return _renderObject;
+}
+
+GameComponentPtr
+BenchmarkRenderObjectComponent::clone() const noexcept
+{
+	return std::make_shared<BenchmarkRenderObjectComponent>(_renderObject);
+}
+
+void
+BenchmarkRenderObjectComponent::onActivate() noexcept
+{
+	if (!_renderObject)
+		return;
+
+	this->addComponentDispatch(GameDispatchType::GameDispatchTypeMoveAfter, this);
+
+	_renderObject->setRenderScene(GameServer::instance()->getFeature<BenchmarkRenderFeature>()->getRenderScene());
+	_renderObject->setTransform(this->getGameObject()->getWorldTransform(), this->getGameObject()->getWorldTransformInverse());
+}
+
+void
+BenchmarkRenderObjectComponent::onDeactivate() noexcept
+{
+	if (!_renderObject)
+		return;
+
+	this->removeComponentDispatch(GameDispatchType::GameDispatchTypeMoveAfter, this);
+
+	_renderObject->setRenderScene(nullptr);
+}
+
+void
+BenchmarkRenderObjectComponent::onMoveAfter() noexcept
+{
+	_renderObject->setTransform(this->getGameObject()->getWorldTransform(), this->getGameObject()->getWorldTransformInverse());
+}
+
+BenchmarkSkinComponent::BenchmarkSkinComponent() noexcept
+{
+	_geometry = std::make_shared<Geometry>();
+}
+
+BenchmarkSkinComponent::BenchmarkSkinComponent(const GameObjects& transforms, const Float4x4Array& bindposes) noexcept
+	: BenchmarkSkinComponent()
+{
+	_transforms = transforms;
+	_bindposes = bindposes;
+	_joints.resize(_transforms.size(), float4x4::One);
+}
+
+BenchmarkSkinComponent::~BenchmarkSkinComponent() noexcept
+{
+	_geometry->setRenderScene(nullptr);
+}
+
+const Float4x4Array&
+BenchmarkSkinComponent::getJoints() const noexcept
+{
+	return _joints;
+}
+
+GameAccessFlags
+BenchmarkSkinComponent::getAccessFlags() const noexcept
+{
+	return GameAccessFlagBits::GameAccessFlagSelfBit | GameAccessFlagBits::GameAccessFlagTransformReadBit;
+}
+
+GameComponentPtr
+BenchmarkSkinComponent::clone() const noexcept
+{
+	return std::make_shared<BenchmarkSkinComponent>(_transforms, _bindposes);
+}
+
+void
+BenchmarkSkinComponent::onActivate() noexcept
+{
+	this->addComponentDispatch(GameDispatchType::GameDispatchTypeFrameEnd, this);
+
+	_geometry->setRenderScene(GameServer::instance()->getFeature<BenchmarkRenderFeature>()->getRenderScene());
+}
+
+void
+BenchmarkSkinComponent::onDeactivate() noexcept
+{
+	this->removeComponentDispatch(GameDispatchType::GameDispatchTypeFrameEnd, this);
+
+	_geometry->setRenderScene(nullptr);
+}
+
+void
+BenchmarkSkinComponent::onFrameEnd() noexcept
+{
+	if (_transforms.empty())
+		return;
+
+	AABB aabb;
+
+	std::size_t index = 0;
+	for (auto& transform : _transforms)
+	{
+		if (_bindposes.size() == _transforms.size())
+			_joints[index] = math::transformMultiply(transform->getWorldTransform(), _bindposes[index]);
+		else
+			_joints[index] = float4x4::One;
+
+		aabb.encapsulate(transform->getWorldTranslate());
+		index++;
+	}
+
+	BoundingBox boundingBox;
+	boundingBox.set(aabb);
+
+	_geometry->setBoundingBox(boundingBox);
+}
+
+BenchmarkAnimatorComponent::BenchmarkAnimatorComponent() noexcept
+	: _degreesPerFrame(1.0f)
+{
+}
+
+BenchmarkAnimatorComponent::BenchmarkAnimatorComponent(float degreesPerFrame) noexcept
+	: _degreesPerFrame(degreesPerFrame)
+{
+}
+
+BenchmarkAnimatorComponent::~BenchmarkAnimatorComponent() noexcept
+{
+}
+
+GameAccessFlags
+BenchmarkAnimatorComponent::getAccessFlags() const noexcept
+{
+	return GameAccessFlagBits::GameAccessFlagTransformWriteBit;
+}
+
+GameComponentPtr
+BenchmarkAnimatorComponent::clone() const noexcept
+{
+	return std::make_shared<BenchmarkAnimatorComponent>(_degreesPerFrame);
+}
+
+void
+BenchmarkAnimatorComponent::onActivate() noexcept
+{
+	this->addComponentDispatch(GameDispatchType::GameDispatchTypeFrame, this);
+}
+
+void
+BenchmarkAnimatorComponent::onDeactivate() noexcept
+{
+	this->removeComponentDispatch(GameDispatchType::GameDispatchTypeFrame, this);
+}
+
+void
+BenchmarkAnimatorComponent::onFrame() noexcept
+{
+	this->getGameObject()->setQuaternionAccum(Quaternion(float3::UnitY, _degreesPerFrame));
+}
+
+_NAME_END
@@ -0,0 +1,159 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#ifndef _H_BENCHMARK_COMPONENTS_H_
+#define _H_BENCHMARK_COMPONENTS_H_
+
+#include <ray/game_features.h>
+#include <ray/game_component.h>
+#include <ray/render_scene.h>
+
+_NAME_BEGIN
+
+// Stands in for RenderFeature when no graphics device is available, it owns a render scene
+// and a camera so that the CPU side culling still runs every frame.
+class BenchmarkRenderFeature final : public GameFeature
+{
+	__DeclareSubClass(BenchmarkRenderFeature, GameFeature)
+public:
+	BenchmarkRenderFeature() noexcept;
+	~BenchmarkRenderFeature() noexcept;
+
+	const RenderScenePtr& getRenderScene() const noexcept;
+	const CameraPtr& getCamera() const noexcept;
+
+	std::size_t getNumVisible() const noexcept;
+	std::size_t getNumVisibleLights() const noexcept;
+
+private:
+	void onActivate() except;
+	void onDeactivate() noexcept;
+
+	void onFrameEnd() noexcept;
+
+private:
+	BenchmarkRenderFeature(const BenchmarkRenderFeature&) = delete;
+	BenchmarkRenderFeature& operator=(const BenchmarkRenderFeature&) = delete;
+
+private:
+	RenderScenePtr _renderScene;
+	CameraPtr _camera;
+
+	OcclusionCullList _visible;
+	OcclusionCullList _visibleLights;
+};
+
+// Attaches a geometry or light to the scene of BenchmarkRenderFeature and keeps its transform in sync,
+// the same way MeshRenderComponent and LightComponent do with RenderFeature.
+class BenchmarkRenderObjectComponent final : public GameComponent
+{
+	__DeclareSubClass(BenchmarkRenderObjectComponent, GameComponent)
+public:
+	BenchmarkRenderObjectComponent() noexcept;
+	BenchmarkRenderObjectComponent(const RenderObjectPtr& object) noexcept;
+	~BenchmarkRenderObjectComponent() noexcept;
+
+	const RenderObjectPtr& getRenderObject() const noexcept;
+
+	GameComponentPtr clone() const noexcept;
+
+private:
+	void onActivate() noexcept;
+	void onDeactivate() noexcept;
+
+	void onMoveAfter() noexcept;
+
+private:
+	RenderObjectPtr _renderObject;
+};
+
+// Computes the joint palette and bounds of a skinned character on the CPU,
+// mirroring what SkinnedMeshRenderComponent uploads before drawing.
+class BenchmarkSkinComponent final : public GameComponent
+{
+	__DeclareSubClass(BenchmarkSkinComponent, GameComponent)
+public:
+	BenchmarkSkinComponent() noexcept;
+	BenchmarkSkinComponent(const GameObjects& transforms, const Float4x4Array& bindposes) noexcept;
+	~BenchmarkSkinComponent() noexcept;
+
+	const Float4x4Array& getJoints() const noexcept;
+
+	GameAccessFlags getAccessFlags() const noexcept;
+
+	GameComponentPtr clone() const noexcept;
+
+private:
+	void onActivate() noexcept;
+	void onDeactivate() noexcept;
+
+	void onFrameEnd() noexcept;
+
+private:
+	GameObjects _transforms;
+	Float4x4Array _bindposes;
+	Float4x4Array _joints;
+
+	GeometryPtr _geometry;
+};
+
+// Scripted load, spins its object around the up axis by a fixed step every frame
+// so that runs are reproducible regardless of the frame time.
+class BenchmarkAnimatorComponent final : public GameComponent
+{
+	__DeclareSubClass(BenchmarkAnimatorComponent, GameComponent)
+public:
+	BenchmarkAnimatorComponent() noexcept;
+	BenchmarkAnimatorComponent(float degreesPerFrame) noexcept;
+	~BenchmarkAnimatorComponent() noexcept;
+
+	GameAccessFlags getAccessFlags() const noexcept;
+
+	GameComponentPtr clone() const noexcept;
+
+private:
+	void onActivate() noexcept;
+	void onDeactivate() noexcept;
+
+	void onFrame() noexcept;
+
+private:
+	float _degreesPerFrame;
+};
+
+_NAME_END
+
+#endif
@@ -0,0 +1,386 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include "BenchmarkScene.h"
+#include "BenchmarkComponents.h"
+
+#include <ray/mesh_component.h>
+#include <ray/mesh_render_component.h>
+#include <ray/skinned_mesh_render_component.h>
+#include <ray/light_component.h>
+#include <ray/camera_component.h>
+#include <ray/res_manager.h>
+#include <ray/material.h>
+#include <ray/geometry.h>
+#include <ray/light.h>
+
+_NAME_BEGIN
+
+BenchmarkParams::BenchmarkParams() noexcept
+	: headless(false)
+	, csv(false)
+	, frames(600)
+	, warmup(60)
+	, threads(0)
+	, meshes(2000)
+	, materials(16)
+	, lights(32)
+	, skinned(16)
+	, bones(32)
+	, hierarchies(8)
+	, depth(32)
+	, dynamic(0.25f)
+	, extent(200.0f)
+	, iterations(10)
+	, objGrid(512)
+{
+}
+
+BenchmarkScene::BenchmarkScene() noexcept
+	: _seed(0x9E3779B9)
+	, _numObjects(0)
+{
+}
+
+BenchmarkScene::~BenchmarkScene() noexcept
+{
+	this->close();
+}
+
+bool
+BenchmarkScene::setup(const BenchmarkParams& params) noexcept
+{
+	_params = params;
+	_params.materials = std::max<std::uint32_t>(_params.materials, 1);
+	_params.bones = std::min<std::uint32_t>(std::max<std::uint32_t>(_params.bones, 1), 256);
+	_params.depth = std::max<std::uint32_t>(_params.depth, 1);
+
+	if (!this->setupResources())
+		return false;
+
+	this->makeCamera();
+	this->makeMeshes();
+	this->makeLights();
+	this->makeSkinnedCharacters();
+	this->makeHierarchies();
+
+	return true;
+}
+
+void
+BenchmarkScene::close() noexcept
+{
+	for (auto& it : _objects)
+		it->destroy();
+
+	_objects.clear();
+	_materials.clear();
+	_skinnedMaterial.reset();
+	_cubeMesh.reset();
+	_skinnedMesh.reset();
+	_bindposes.clear();
+	_numObjects = 0;
+}
+
+std::size_t
+BenchmarkScene::getNumObjects() const noexcept
+{
+	return _numObjects;
+}
+
+bool
+BenchmarkScene::setupResources() noexcept
+{
+	_cubeMesh = std::make_shared<MeshProperty>();
+	_cubeMesh->makeCube(1.0f, 1.0f, 1.0f);
+	_cubeMesh->computeBoundingBox();
+
+	// A bone chain stands upright from the origin, one unit per bone, so the bind pose of each joint is a translation.
+	_bindposes.resize(_params.bones);
+	for (std::uint32_t i = 0; i < _params.bones; i++)
+		_bindposes[i].makeTranslate(0.0f, -(float)i, 0.0f);
+
+	_skinnedMesh = std::make_shared<MeshProperty>();
+	_skinnedMesh->makeCube(0.5f, (float)_params.bones, 0.5f, 1, _params.bones, 1);
+
+	VertexWeights weights;
+	weights.reserve(_skinnedMesh->getNumVertices());
+
+	for (auto& it : _skinnedMesh->getVertexArray())
+	{
+		it.y += _params.bones * 0.5f;
+
+		float height = std::min(std::max(it.y, 0.0f), (float)(_params.bones - 1));
+		std::uint32_t bone = std::min((std::uint32_t)height, _params.bones - 1);
+		float blend = height - bone;
+
+		VertexWeight weight;
+		weight.weight1 = 1.0f - blend;
+		weight.weight2 = blend;
+		weight.weight3 = 0.0f;
+		weight.weight4 = 0.0f;
+		weight.bone1 = (std::uint8_t)bone;
+		weight.bone2 = (std::uint8_t)std::min(bone + 1, _params.bones - 1);
+		weight.bone3 = 0;
+		weight.bone4 = 0;
+
+		weights.push_back(weight);
+	}
+
+	_skinnedMesh->setWeightArray(std::move(weights));
+	_skinnedMesh->setBindposes(_bindposes);
+	_skinnedMesh->computeBoundingBox();
+
+	if (_params.headless)
+		return true;
+
+	MaterialPtr material;
+	if (!ResManager::instance()->createMaterial("sys:fx/opacity.fxml", material))
+		return false;
+
+	for (std::uint32_t i = 0; i < _params.materials; i++)
+	{
+		auto instance = material->clone();
+
+		auto albedo = instance->getParameter("albedo");
+		if (albedo)
+			albedo->uniform3f((i % 3) / 2.0f, ((i / 3) % 3) / 2.0f, ((i / 9) % 3) / 2.0f);
+
+		_materials.push_back(std::move(instance));
+	}
+
+	const char* skinningEffect = "sys:fx/opacity_skinning256.fxml";
+	if (_params.bones <= 64)
+		skinningEffect = "sys:fx/opacity_skinning64.fxml";
+	else if (_params.bones <= 128)
+		skinningEffect = "sys:fx/opacity_skinning128.fxml";
+
+	return ResManager::instance()->createMaterial(skinningEffect, _skinnedMaterial);
+}
+
+void
+BenchmarkScene::makeCamera() noexcept
+{
+	// Headless runs use the camera owned by BenchmarkRenderFeature.
+	if (_params.headless)
+		return;
+
+	auto camera = std::make_shared<CameraComponent>();
+	camera->setAperture(60.0f);
+	camera->setRatio(16.0f / 9.0f);
+	camera->setNear(0.1f);
+	camera->setFar(1000.0f);
+
+	auto object = std::make_shared<GameObject>();
+	object->setName("camera");
+	object->addComponent(std::move(camera));
+	object->setTranslate(float3(0.0f, 40.0f, -120.0f));
+	object->setQuaternion(Quaternion(float3(15.0f, 0.0f, 0.0f)));
+	object->setActive(true);
+
+	_objects.push_back(std::move(object));
+	_numObjects++;
+}
+
+void
+BenchmarkScene::makeMeshes() noexcept
+{
+	std::uint32_t dynamicStride = _params.dynamic > 0.0f ? std::max<std::uint32_t>((std::uint32_t)(1.0f / _params.dynamic), 1) : 0;
+
+	for (std::uint32_t i = 0; i < _params.meshes; i++)
+	{
+		auto object = this->makeMeshObject(this->makeRandomPosition(), i);
+		if (dynamicStride && i % dynamicStride == 0)
+			object->addComponent(std::make_shared<BenchmarkAnimatorComponent>(1.0f + (i % 7)));
+
+		object->setActive(true);
+
+		_objects.push_back(std::move(object));
+		_numObjects++;
+	}
+}
+
+void
+BenchmarkScene::makeLights() noexcept
+{
+	for (std::uint32_t i = 0; i < _params.lights; i++)
+	{
+		auto object = std::make_shared<GameObject>();
+		object->setName("light_" + std::to_string(i));
+		object->setTranslate(this->makeRandomPosition() + float3(0.0f, 5.0f, 0.0f));
+
+		if (_params.headless)
+		{
+			auto light = std::make_shared<Light>();
+			light->setLightType(LightType::LightTypePoint);
+			light->setLightRange(20.0f);
+			light->setBoundingBox(BoundingBox(float3(-20.0f), float3(20.0f)));
+
+			object->addComponent(std::make_shared<BenchmarkRenderObjectComponent>(std::move(light)));
+		}
+		else
+		{
+			auto light = std::make_shared<LightComponent>();
+			light->setLightType(LightType::LightTypePoint);
+			light->setLightRange(20.0f);
+			light->setLightIntensity(1.0f);
+
+			object->addComponent(std::move(light));
+		}
+
+		object->setActive(true);
+
+		_objects.push_back(std::move(object));
+		_numObjects++;
+	}
+}
+
+void
+BenchmarkScene::makeSkinnedCharacters() noexcept
+{
+	for (std::uint32_t i = 0; i < _params.skinned; i++)
+	{
+		auto root = std::make_shared<GameObject>();
+		root->setName("character_" + std::to_string(i));
+
+		GameObjects joints;
+		GameObjectPtr parent = root;
+
+		for (std::uint32_t j = 0; j < _params.bones; j++)
+		{
+			auto joint = std::make_shared<GameObject>();
+			joint->setName("bone_" + std::to_string(j));
+			joint->setParent(parent);
+			joint->setTranslate(float3(0.0f, j == 0 ? 0.0f : 1.0f, 0.0f));
+			joint->addComponent(std::make_shared<BenchmarkAnimatorComponent>(j & 1 ? 0.5f : -0.5f));
+
+			joints.push_back(joint);
+			parent = std::move(joint);
+
+			_numObjects++;
+		}
+
+		if (_params.headless)
+		{
+			root->addComponent(std::make_shared<BenchmarkSkinComponent>(joints, _bindposes));
+		}
+		else
+		{
+			auto skinnedRender = std::make_shared<SkinnedMeshRenderComponent>();
+			skinnedRender->setSharedMaterial(_skinnedMaterial);
+			skinnedRender->setTransforms(std::move(joints));
+
+			root->addComponent(std::make_shared<MeshComponent>(_skinnedMesh));
+			root->addComponent(std::move(skinnedRender));
+		}
+
+		root->addComponent(std::make_shared<BenchmarkAnimatorComponent>(2.0f));
+		root->setTranslate(this->makeRandomPosition());
+		root->setActiveDownwards(true);
+
+		_objects.push_back(std::move(root));
+		_numObjects++;
+	}
+}
+
+void
+BenchmarkScene::makeHierarchies() noexcept
+{
+	for (std::uint32_t i = 0; i < _params.hierarchies; i++)
+	{
+		auto root = this->makeMeshObject(this->makeRandomPosition(), i);
+		root->addComponent(std::make_shared<BenchmarkAnimatorComponent>(1.0f));
+
+		// Only the root spins, every level below inherits the motion and has to refresh its world transform.
+		GameObjectPtr parent = root;
+		for (std::uint32_t j = 1; j < _params.depth; j++)
+		{
+			auto child = this->makeMeshObject(float3(1.0f, 0.5f, 0.0f), i + j);
+			child->setParent(parent);
+			child->setQuaternion(Quaternion(float3::UnitY, 10.0f));
+
+			parent = std::move(child);
+			_numObjects++;
+		}
+
+		root->setActiveDownwards(true);
+
+		_objects.push_back(std::move(root));
+		_numObjects++;
+	}
+}
+
+GameObjectPtr
+BenchmarkScene::makeMeshObject(const float3& translate, std::size_t material) noexcept
+{
+	auto object = std::make_shared<GameObject>();
+	object->setTranslate(translate);
+
+	if (_params.headless)
+	{
+		auto geometry = std::make_shared<Geometry>();
+		geometry->setBoundingBox(_cubeMesh->getBoundingBox());
+
+		object->addComponent(std::make_shared<BenchmarkRenderObjectComponent>(std::move(geometry)));
+	}
+	else
+	{
+		object->addComponent(std::make_shared<MeshComponent>(_cubeMesh));
+		object->addComponent(std::make_shared<MeshRenderComponent>(_materials[material % _materials.size()]));
+	}
+
+	return object;
+}
+
+float3
+BenchmarkScene::makeRandomPosition() noexcept
+{
+	float3 position;
+
+	for (std::uint8_t i = 0; i < 3; i++)
+	{
+		_seed ^= _seed << 13;
+		_seed ^= _seed >> 17;
+		_seed ^= _seed << 5;
+
+		position[i] = ((_seed & 0xFFFF) / 65535.0f - 0.5f) * _params.extent;
+	}
+
+	position.y *= 0.1f;
+	return position;
+}
+
+_NAME_END
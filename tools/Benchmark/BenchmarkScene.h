@@ -0,0 +1,122 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#ifndef _H_BENCHMARK_SCENE_H_
+#define _H_BENCHMARK_SCENE_H_
+
+#include <ray/game_object.h>
+#include <ray/modhelp.h>
+#include <ray/render_types.h>
+
+_NAME_BEGIN
+
+struct BenchmarkParams
+{
+	BenchmarkParams() noexcept;
+
+	bool headless;
+	bool csv;
+
+	std::uint32_t frames;
+	std::uint32_t warmup;
+	std::uint32_t threads;
+
+	std::uint32_t meshes;
+	std::uint32_t materials;
+	std::uint32_t lights;
+	std::uint32_t skinned;
+	std::uint32_t bones;
+	std::uint32_t hierarchies;
+	std::uint32_t depth;
+
+	float dynamic;
+	float extent;
+
+	std::string trace;
+
+	std::string benchCase;
+	std::uint32_t iterations;
+	std::uint32_t objGrid;
+};
+
+// Builds a synthetic scene procedurally from the params, with a fixed seed so that
+// two runs with the same params produce the same scene.
+class BenchmarkScene final
+{
+public:
+	BenchmarkScene() noexcept;
+	~BenchmarkScene() noexcept;
+
+	bool setup(const BenchmarkParams& params) noexcept;
+	void close() noexcept;
+
+	std::size_t getNumObjects() const noexcept;
+
+private:
+	bool setupResources() noexcept;
+
+	void makeCamera() noexcept;
+	void makeMeshes() noexcept;
+	void makeLights() noexcept;
+	void makeSkinnedCharacters() noexcept;
+	void makeHierarchies() noexcept;
+
+	GameObjectPtr makeMeshObject(const float3& translate, std::size_t material) noexcept;
+	float3 makeRandomPosition() noexcept;
+
+private:
+	BenchmarkScene(const BenchmarkScene&) = delete;
+	BenchmarkScene& operator=(const BenchmarkScene&) = delete;
+
+private:
+	BenchmarkParams _params;
+
+	std::uint32_t _seed;
+	std::size_t _numObjects;
+
+	MeshPropertyPtr _cubeMesh;
+	MeshPropertyPtr _skinnedMesh;
+	Float4x4Array _bindposes;
+
+	Materials _materials;
+	MaterialPtr _skinnedMaterial;
+
+	GameObjects _objects;
+};
+
+_NAME_END
+
+#endif
@@ -0,0 +1,319 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include <ray/ray.h>
+#include <ray/ray_main.h>
+#include <ray/game_server.h>
+#include <ray/game_base_features.h>
+#include <ray/game_object_manager.h>
+#include <ray/rtti_factory.h>
+#include <ray/profiler.h>
+
+#include "BenchmarkScene.h"
+#include "BenchmarkComponents.h"
+#include "BenchmarkCases.h"
+
+#include <cstdio>
+#include <cstring>
+
+static void
+printUsage(const char* name) noexcept
+{
+	std::printf("usage: %s [options]\n", name);
+	std::printf("  --headless          run without a graphics device, rendering is replaced by CPU culling\n");
+	std::printf("  --csv               print csv instead of json\n");
+	std::printf("  --frames <n>        measured frames\n");
+	std::printf("  --warmup <n>        frames to run before measuring\n");
+	std::printf("  --threads <n>       threads for parallel component updates, 0 uses every core\n");
+	std::printf("  --meshes <n>        static and animated meshes\n");
+	std::printf("  --materials <n>     distinct materials shared by the meshes\n");
+	std::printf("  --lights <n>        point lights\n");
+	std::printf("  --skinned <n>       skinned characters\n");
+	std::printf("  --bones <n>         bones per skinned character (max 256)\n");
+	std::printf("  --hierarchies <n>   nested object chains\n");
+	std::printf("  --depth <n>         levels per nested object chain\n");
+	std::printf("  --dynamic <ratio>   fraction of meshes animated every frame\n");
+	std::printf("  --trace <path>      also save a chrome trace of the measured frames\n");
+	std::printf("  --case <name>       run a micro benchmark instead of the scene: obj, rtti, profiler\n");
+	std::printf("  --iterations <n>    measured runs of a micro benchmark\n");
+	std::printf("  --obj-grid <n>      quads per side of the generated obj\n");
+}
+
+static bool
+parseParams(int argc, const char* argv[], ray::BenchmarkParams& params) noexcept
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+		if (std::strcmp(arg, "--headless") == 0)
+			params.headless = true;
+		else if (std::strcmp(arg, "--csv") == 0)
+			params.csv = true;
+		else if (value)
+		{
+			if (std::strcmp(arg, "--frames") == 0)
+				params.frames = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--warmup") == 0)
+				params.warmup = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--threads") == 0)
+				params.threads = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--meshes") == 0)
+				params.meshes = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--materials") == 0)
+				params.materials = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--lights") == 0)
+				params.lights = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--skinned") == 0)
+				params.skinned = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--bones") == 0)
+				params.bones = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--hierarchies") == 0)
+				params.hierarchies = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--depth") == 0)
+				params.depth = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--dynamic") == 0)
+				params.dynamic = (float)std::strtod(value, nullptr);
+			else if (std::strcmp(arg, "--trace") == 0)
+				params.trace = value;
+			else if (std::strcmp(arg, "--case") == 0)
+				params.benchCase = value;
+			else if (std::strcmp(arg, "--iterations") == 0)
+				params.iterations = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--obj-grid") == 0)
+				params.objGrid = std::strtoul(value, nullptr, 10);
+			else
+				return false;
+
+			i++;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return params.frames > 0;
+}
+
+static bool
+openHeadless() noexcept
+{
+	if (!ray::rtti::Factory::instance()->open())
+		return false;
+
+	auto server = ray::GameServer::instance();
+	if (!server->open())
+		return false;
+
+	ray::GameFeaturePtr baseFeature = std::make_shared<ray::GameBaseFeatures>();
+	if (!server->addFeature(baseFeature))
+		return false;
+
+	ray::GameFeaturePtr renderFeature = std::make_shared<ray::BenchmarkRenderFeature>();
+	if (!server->addFeature(renderFeature))
+		return false;
+
+	return server->start();
+}
+
+static void
+closeHeadless() noexcept
+{
+	auto server = ray::GameServer::instance();
+	server->stop();
+	server->close();
+}
+
+static void
+updateFrame(const ray::BenchmarkParams& params) noexcept
+{
+	if (params.headless)
+		ray::GameServer::instance()->update();
+	else
+		rayUpdate();
+}
+
+static double
+toMilliseconds(std::uint64_t nanoseconds) noexcept
+{
+	return nanoseconds / 1000000.0;
+}
+
+static void
+printReport(const ray::BenchmarkParams& params, std::size_t numObjects, std::vector<std::uint64_t>& frameTimes) noexcept
+{
+	std::sort(frameTimes.begin(), frameTimes.end());
+
+	std::uint64_t total = 0;
+	for (auto& it : frameTimes)
+		total += it;
+
+	std::size_t count = frameTimes.size();
+	double mean = toMilliseconds(total) / count;
+	double p50 = toMilliseconds(frameTimes[count / 2]);
+	double p95 = toMilliseconds(frameTimes[std::min(count - 1, count * 95 / 100)]);
+	double max = toMilliseconds(frameTimes.back());
+
+	std::vector<ray::Profiler::Statistic> statistics;
+	ray::Profiler::instance()->getStatistics(statistics);
+
+	if (params.csv)
+	{
+		std::printf("path,calls,mean_ms,max_ms,total_ms,per_frame_ms\n");
+		std::printf("frame,%zu,%.4f,%.4f,%.4f,%.4f\n", count, mean, max, toMilliseconds(total), mean);
+
+		for (auto& it : statistics)
+		{
+			std::printf("%s,%zu,%.4f,%.4f,%.4f,%.4f\n", it.path.c_str(), it.count,
+				toMilliseconds(it.total) / it.count,
+				toMilliseconds(it.max),
+				toMilliseconds(it.total),
+				toMilliseconds(it.total) / count);
+		}
+	}
+	else
+	{
+		std::printf("{\n");
+		std::printf("  \"mode\": \"%s\",\n", params.headless ? "headless" : "opengl");
+		std::printf("  \"frames\": %u,\n", params.frames);
+		std::printf("  \"warmup\": %u,\n", params.warmup);
+		std::printf("  \"threads\": %u,\n", ray::GameObjectManager::instance()->getNumThreads());
+		std::printf("  \"scene\": { \"objects\": %zu, \"meshes\": %u, \"materials\": %u, \"lights\": %u, \"skinned\": %u, \"bones\": %u, \"hierarchies\": %u, \"depth\": %u },\n",
+			numObjects, params.meshes, params.materials, params.lights, params.skinned, params.bones, params.hierarchies, params.depth);
+		std::printf("  \"frame_ms\": { \"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"max\": %.4f },\n", mean, p50, p95, max);
+		std::printf("  \"phases\": [\n");
+
+		for (std::size_t i = 0; i < statistics.size(); i++)
+		{
+			auto& it = statistics[i];
+			std::printf("    { \"path\": \"%s\", \"calls\": %zu, \"mean_ms\": %.4f, \"max_ms\": %.4f, \"total_ms\": %.4f, \"per_frame_ms\": %.4f }%s\n",
+				it.path.c_str(), it.count,
+				toMilliseconds(it.total) / it.count,
+				toMilliseconds(it.max),
+				toMilliseconds(it.total),
+				toMilliseconds(it.total) / count,
+				i + 1 < statistics.size() ? "," : "");
+		}
+
+		std::printf("  ]\n");
+		std::printf("}\n");
+	}
+}
+
+int main(int argc, const char* argv[])
+{
+	ray::BenchmarkParams params;
+	if (!parseParams(argc, argv, params))
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	if (!params.benchCase.empty())
+	{
+		ray::BenchmarkCaseResults results;
+		if (!ray::runBenchmarkCase(params, results))
+			return 1;
+
+		ray::printBenchmarkCases(params, results);
+		return 0;
+	}
+
+	if (params.headless)
+	{
+		if (!openHeadless())
+		{
+			std::fprintf(stderr, "failed to start the game server.\n");
+			return 1;
+		}
+	}
+	else
+	{
+		rayInit(argv[0], nullptr);
+
+		if (!rayOpenWindow("Benchmark", 1280, 720))
+		{
+			std::fprintf(stderr, "failed to open a window, try --headless.\n");
+			rayTerminate();
+			return 1;
+		}
+	}
+
+	ray::GameObjectManager::instance()->setNumThreads(params.threads);
+
+	ray::BenchmarkScene scene;
+	if (scene.setup(params))
+	{
+		auto profiler = ray::Profiler::instance();
+		profiler->setEnable(true);
+
+		for (std::uint32_t i = 0; i < params.warmup; i++)
+			updateFrame(params);
+
+		profiler->clear();
+
+		std::vector<std::uint64_t> frameTimes(params.frames);
+
+		for (std::uint32_t i = 0; i < params.frames; i++)
+		{
+			auto begin = ray::Timer::clock();
+			updateFrame(params);
+			frameTimes[i] = ray::Timer::clock() - begin;
+		}
+
+		profiler->setEnable(false);
+
+		printReport(params, scene.getNumObjects(), frameTimes);
+
+		if (!params.trace.empty())
+			profiler->save(params.trace);
+	}
+	else
+	{
+		std::fprintf(stderr, "failed to build the scene.\n");
+	}
+
+	scene.close();
+
+	if (params.headless)
+		closeHeadless();
+	else
+		rayTerminate();
+
+	return 0;
+}
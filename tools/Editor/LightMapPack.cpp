@@ -37,8 +37,7 @@
 #include "LightMapPack.h"
 
 #include <sstream>
-#include <UVAtlas/UVAtlas.h>
-#include <DirectXMesh/DirectXMesh.h>
+#include <ray/modatlas.h>
 
 _NAME_BEGIN
 
@@ -78,120 +77,99 @@ LightMapPack::getLightMapListener() const noexcept
 }
 
 bool
-LightMapPack::atlasUV(PMX& model, std::uint32_t w, std::uint32_t h, std::uint32_t chart, float stretch, float margin, std::function<HRESULT(float)> progress) noexcept
+LightMapPack::atlasUV(PMX& model, std::uint32_t w, std::uint32_t h, std::uint32_t chart, float stretch, float margin, std::function<bool(float)> progress) noexcept
 {
 	if (_lightMapListener)
 		_lightMapListener->onUvmapperStart();
 
-	std::vector<float3> atlasVertices;
-	std::vector<std::uint32_t> atlasIndices;
-
+	Float3Array vertices(model.numVertices);
 	for (std::size_t i = 0; i < model.numVertices; i++)
-		atlasVertices.push_back(model.vertices[i].position);
+		vertices[i] = model.vertices[i].position;
 
-	std::vector<uint32_t> adj(model.numIndices);
+	UintArray indices(model.numIndices);
+	for (std::size_t i = 0; i < model.numIndices; i++)
+		indices[i] = this->getFace(model, i);
 
-	if (model.header.sizeOfIndices == 1)
-	{
-		if (_lightMapListener)
-			_lightMapListener->onMessage("Failed to GenerateAdjacencyAndPointReps.");
-		return false;
-	}
-	else if (model.header.sizeOfIndices == 2)
-	{
-		HRESULT hr = DirectX::GenerateAdjacencyAndPointReps((std::uint16_t*)model.indices.data(), model.numIndices / 3, (DirectX::XMFLOAT3*)atlasVertices.data(), model.numVertices, 0.0, nullptr, adj.data());
-		if (FAILED(hr))
-		{
-			if (_lightMapListener)
-				_lightMapListener->onMessage("Failed to GenerateAdjacencyAndPointReps.");
-			return false;
-		}
-	}
-	else
+	MeshSubsets subsets;
+	std::uint32_t offset = 0;
+
+	for (std::size_t i = 0; i < model.numMaterials; i++)
 	{
-		HRESULT hr = DirectX::GenerateAdjacencyAndPointReps((std::uint32_t*)model.indices.data(), model.numIndices / 3, (DirectX::XMFLOAT3*)atlasVertices.data(), model.numVertices, 0.0, nullptr, adj.data());
-		if (FAILED(hr))
-		{
-			if (_lightMapListener)
-				_lightMapListener->onMessage("Failed to GenerateAdjacencyAndPointReps.");
-			return false;
-		}
+		subsets.push_back(MeshSubset(0, offset, model.materials[i].IndicesCount, 0, 0));
+		offset += model.materials[i].IndicesCount;
 	}
 
-	std::vector<DirectX::UVAtlasVertex> vb;
-	std::vector<uint8_t> ib;
-	std::vector<uint32_t> remap;
-
-	auto callback = [&](float percentComplete) -> HRESULT
+	auto callback = [&](float percentComplete) -> bool
 	{
 		if (_lightMapListener)
 			_lightMapListener->onUvmapperProgressing(percentComplete);
 
-		return S_OK;
+		return true;
 	};
 
-	if (model.header.sizeOfIndices == 1)
-		return false;
-	else if (model.header.sizeOfIndices == 2)
-	{
-		HRESULT hr = DirectX::UVAtlasCreate(
-			(DirectX::XMFLOAT3*)atlasVertices.data(),
-			atlasVertices.size(),
-			model.indices.data(),
-			DXGI_FORMAT::DXGI_FORMAT_R16_UINT,
-			model.numIndices / 3, chart, stretch, w, h, margin, adj.data(), 0, 0,
-			progress ? progress : callback,
-			1.0,
-			DirectX::UVATLAS_DEFAULT,
-			vb, ib, 0, &remap);
-
-		if (FAILED(hr))
-		{
-			if (_lightMapListener)
-				_lightMapListener->onMessage("Failed to UV Atlas.");
-			return false;
-		}
-	}
-	else
+	MeshAtlasParams params;
+	params.width = w;
+	params.height = h;
+	params.margin = static_cast<std::uint32_t>(std::ceil(margin));
+	params.maxStretch = stretch;
+	params.maxCharts = chart;
+	params.progress = progress ? progress : callback;
+
+	UintArray remap;
+	UintArray atlasIndices;
+	Float2Array atlasCoords;
+	MeshAtlasStats stats;
+
+	if (!makeAtlasUV(vertices, indices, subsets, params, remap, atlasIndices, atlasCoords, &stats))
 	{
-		HRESULT hr = DirectX::UVAtlasCreate(
-			(DirectX::XMFLOAT3*)atlasVertices.data(),
-			atlasVertices.size(),
-			model.indices.data(),
-			DXGI_FORMAT::DXGI_FORMAT_R32_UINT,
-			model.numIndices / 3, chart, stretch, w, h, margin, adj.data(), 0, 0,
-			progress ? progress : callback,
-			1.0,
-			DirectX::UVATLAS_DEFAULT,
-			vb, ib, 0, &remap);
-
-		if (FAILED(hr))
-		{
-			if (_lightMapListener)
-				_lightMapListener->onMessage("Failed to UV Atlas.");
-			return false;
-		}
+		if (_lightMapListener)
+			_lightMapListener->onMessage("Failed to UV Atlas.");
+		return false;
 	}
 
 	std::vector<PMX_Vertex> newVertices;
-	newVertices.resize(vb.size());
+	newVertices.resize(remap.size());
 
-	for (int i = 0; i < vb.size(); i++)
+	for (std::size_t i = 0; i < remap.size(); i++)
 	{
 		PMX_Vertex v = model.vertices[remap[i]];
-		v.addCoord->x = vb[i].uv.x;
-		v.addCoord->y = vb[i].uv.y;
+		v.addCoord->x = atlasCoords[i].x;
+		v.addCoord->y = atlasCoords[i].y;
 
 		newVertices[i] = v;
 	}
 
-	model.header.addUVCount = 1;
+	if (newVertices.size() > std::numeric_limits<std::uint16_t>::max())
+		model.header.sizeOfIndices = 4;
+	else if (newVertices.size() > std::numeric_limits<std::uint8_t>::max() && model.header.sizeOfIndices < 2)
+		model.header.sizeOfIndices = 2;
+
+	std::vector<PMX_Index> newIndices(atlasIndices.size() * model.header.sizeOfIndices);
+
+	for (std::size_t i = 0; i < atlasIndices.size(); i++)
+	{
+		if (model.header.sizeOfIndices == 1)
+			newIndices[i] = static_cast<std::uint8_t>(atlasIndices[i]);
+		else if (model.header.sizeOfIndices == 2)
+			((std::uint16_t*)newIndices.data())[i] = static_cast<std::uint16_t>(atlasIndices[i]);
+		else
+			((std::uint32_t*)newIndices.data())[i] = atlasIndices[i];
+	}
+
+	model.header.addUVCount = std::max<std::uint8_t>(model.header.addUVCount, 1);
 	model.numVertices = newVertices.size();
 	model.vertices = newVertices;
-	model.indices = ib;
+	model.indices = newIndices;
 
 	if (_lightMapListener)
+	{
+		std::ostringstream stream;
+		stream << "Packed " << stats.numCharts << " charts into " << w << "x" << h << " texels, ";
+		stream << "utilization " << stats.utilization * 100.0f << "%, " << stats.texelsPerUnit << " texels per unit.";
+
+		_lightMapListener->onMessage(stream.str());
 		_lightMapListener->onUvmapperEnd();
+	}
 
 	return true;
 }
@@ -37,6 +37,9 @@
 #include "LightMass.h"
 #include "LightMassAmbientOcclusion.h"
 #include "LightMassGlobalIllumination.h"
+#include "LightMassRayTracing.h"
+
+#include <chrono>
 
 _NAME_BEGIN
 
@@ -66,6 +69,30 @@ LightMass::open(const LightMassParams& params) noexcept
 {
 	assert(!_initialize);
 
+	LightBakingParams option;
+	option.model = params.model;
+	option.baking = params.baking;
+	option.lightMap = _lightMapData;
+
+	if (params.backend == LightBakingBackend::RayTracing)
+	{
+		auto lightMass = std::make_shared<LightBakingRT>();
+		lightMass->setLightMassListener(_lightMassListener);
+		if (!lightMass->open(option))
+			return false;
+
+		_lightMassTracing = std::move(lightMass);
+
+		if (!params.compareBackend)
+		{
+			_initialize = true;
+			return true;
+		}
+
+		_referenceData = std::make_shared<LightMapData>(_lightMapData->width, _lightMapData->height, _lightMapData->channel);
+		option.lightMap = _referenceData;
+	}
+
 	GraphicsDeviceDesc deviceDesc;
 	deviceDesc.setDeviceType(ray::GraphicsDeviceType::GraphicsDeviceTypeOpenGL);
 	_graphicsDevice = GraphicsSystem::instance()->createDevice(deviceDesc);
@@ -108,11 +135,6 @@ LightMass::open(const LightMassParams& params) noexcept
 		return false;
 	}
 
-	LightBakingParams option;
-	option.model = params.model;
-	option.baking = params.baking;
-	option.lightMap = _lightMapData;
-
 	if (option.lightMap->channel == 4)
 	{
 		auto lightMass = std::make_shared<LightBakingGI>();
@@ -139,6 +161,9 @@ LightMass::close() noexcept
 	if (_lightMassBaking)
 		_lightMassBaking->stop();
 
+	if (_lightMassTracing)
+		_lightMassTracing->stop();
+
 	if (_graphicsContext)
 		_graphicsContext.reset();
 
@@ -197,14 +222,47 @@ LightMass::start() noexcept
 	if (this->getLightMassListener())
 		this->getLightMassListener()->onBakingStart();
 
-	if (!_lightMassBaking->start())
+	if (_lightMassTracing)
 	{
+		auto begin = std::chrono::high_resolution_clock::now();
+
+		if (!_lightMassTracing->start())
+		{
+			if (_lightMassListener)
+				_lightMassListener->onMessage("Failed to baking the model");
+
+			return false;
+		}
+
 		if (_lightMassListener)
-			_lightMassListener->onMessage("Failed to baking the model");
+		{
+			std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - begin;
+			_lightMassListener->onMessage("Ray tracing baking time : " + std::to_string(elapsed.count()) + " seconds.");
+		}
+	}
 
-		return false;
+	if (_lightMassBaking)
+	{
+		auto begin = std::chrono::high_resolution_clock::now();
+
+		if (!_lightMassBaking->start())
+		{
+			if (_lightMassListener)
+				_lightMassListener->onMessage("Failed to baking the model");
+
+			return false;
+		}
+
+		if (_lightMassListener)
+		{
+			std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - begin;
+			_lightMassListener->onMessage("Hemisphere baking time : " + std::to_string(elapsed.count()) + " seconds.");
+		}
 	}
 
+	if (_lightMassTracing && _referenceData)
+		this->compareLightMapData(*_lightMapData, *_referenceData);
+
 	if (this->getLightMassListener())
 		this->getLightMassListener()->onBakingEnd();
 
@@ -219,8 +277,70 @@ LightMass::stop() noexcept
 		if (_lightMassBaking)
 			_lightMassBaking->stop();
 
+		if (_lightMassTracing)
+			_lightMassTracing->stop();
+
 		_isStopped = true;
 	}
 }
 
+void
+LightMass::compareLightMapData(const LightMapData& lightMap, const LightMapData& reference) noexcept
+{
+	assert(lightMap.width == reference.width && lightMap.height == reference.height && lightMap.channel == reference.channel);
+
+	std::size_t numTexels = 0;
+	std::size_t numMismatched = 0;
+
+	double sumError = 0.0;
+	double sumSquared = 0.0;
+	double maxError = 0.0;
+
+	for (std::size_t i = 0; i < (std::size_t)lightMap.width * lightMap.height; i++)
+	{
+		const float* a = lightMap.data.get() + i * lightMap.channel;
+		const float* b = reference.data.get() + i * reference.channel;
+
+		bool hasA = false, hasB = false;
+		for (std::uint8_t j = 0; j < lightMap.channel; j++)
+		{
+			hasA |= a[j] != 0.0f;
+			hasB |= b[j] != 0.0f;
+		}
+
+		if (hasA != hasB)
+		{
+			numMismatched++;
+			continue;
+		}
+
+		if (!hasA)
+			continue;
+
+		for (std::uint8_t j = 0; j < lightMap.channel; j++)
+		{
+			double error = std::abs((double)a[j] - (double)b[j]);
+			sumError += error;
+			sumSquared += error * error;
+			maxError = std::max(maxError, error);
+		}
+
+		numTexels++;
+	}
+
+	if (_lightMassListener)
+	{
+		double count = std::max<double>(1.0, (double)numTexels * lightMap.channel);
+
+		std::string message = "Per-texel error against the hemisphere baking : ";
+		message += "mean " + std::to_string(sumError / count);
+		message += ", rms " + std::to_string(std::sqrt(sumSquared / count));
+		message += ", max " + std::to_string(maxError);
+		message += " over " + std::to_string(numTexels) + " texels, ";
+		message += std::to_string(numMismatched) + " texels covered by only one backend.";
+
+		_lightMassListener->onMessage(message);
+	}
+}
+
 _NAME_END
\ No newline at end of file
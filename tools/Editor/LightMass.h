@@ -66,6 +66,9 @@ public:
 	void setLightMassListener(LightMassListenerPtr pointer) noexcept;
 	LightMassListenerPtr getLightMassListener() const noexcept;
 
+private:
+	void compareLightMapData(const LightMapData& lightMap, const LightMapData& reference) noexcept;
+
 private:
 	bool _initialize;
 	bool _isStopped;
@@ -75,8 +78,10 @@ private:
 	ray::GraphicsSwapchainPtr _graphicsSwapchain;
 
 	LightMassBakingPtr _lightMassBaking;
+	LightBakingRTPtr _lightMassTracing;
 	LightMassListenerPtr _lightMassListener;
 	LightMapDataPtr _lightMapData;
+	LightMapDataPtr _referenceData;
 };
 
 _NAME_END
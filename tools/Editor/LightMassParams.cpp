@@ -98,10 +98,14 @@ LightSampleParams::LightSampleParams() noexcept
 	, environmentColor(float3::One)
 	, interpolationPasses(1)
 	, interpolationThreshold(1e-4)
+	, raySamples(256)
+	, rayThreads(0)
 {
 }
 
 LightMassParams::LightMassParams() noexcept
+	: backend(LightBakingBackend::Hemisphere)
+	, compareBackend(false)
 {
 }
 
@@ -114,6 +114,9 @@ struct LightSampleParams
 	int interpolationPasses;
 	float interpolationThreshold;
 
+	std::uint32_t raySamples;
+	std::uint32_t rayThreads;
+
 	std::function<bool(float progress)> listener;
 };
 
@@ -124,10 +127,19 @@ struct LightBakingParams
 	LightSampleParams baking;
 };
 
+enum class LightBakingBackend
+{
+	Hemisphere,
+	RayTracing,
+};
+
 struct LightMassParams
 {
 	LightMassParams() noexcept;
 
+	LightBakingBackend backend;
+	bool compareBackend;
+
 	LightModelData model;
 	LightSampleParams baking;
 };
@@ -0,0 +1,843 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include "LightMassRayTracing.h"
+
+#include <ray/thread.h>
+
+#include <thread>
+
+_NAME_BEGIN
+
+namespace
+{
+	const std::uint32_t BVHBinCount = 12;
+	const std::uint32_t BVHLeafSize = 4;
+	const std::uint32_t BVHMaxLeafSize = 16;
+	const std::uint32_t BVHStackSize = 64;
+	const std::uint32_t SampleChunkSize = 64;
+
+	int leftOf(const float2& a, const float2& b, const float2& c) noexcept
+	{
+		float2 lv = b - a;
+		float2 rv = c - b;
+
+		float x = lv.x * rv.y - lv.y * rv.x;
+		return x < 0 ? -1 : x > 0;
+	}
+
+	int convexClip(float2* poly, int nPoly, const float2* clip, int nClip, float2* res) noexcept
+	{
+		int nRes = nPoly;
+		int dir = leftOf(clip[0], clip[1], clip[2]);
+		for (int i = 0, j = nClip - 1; i < nClip && nRes; j = i++)
+		{
+			if (i != 0)
+				for (nPoly = 0; nPoly < nRes; nPoly++)
+					poly[nPoly] = res[nPoly];
+			nRes = 0;
+			float2 v0 = poly[nPoly - 1];
+			int side0 = leftOf(clip[j], clip[i], v0);
+			if (side0 != -dir)
+				res[nRes++] = v0;
+			for (int k = 0; k < nPoly; k++)
+			{
+				float2 v1 = poly[k], x;
+				int side1 = leftOf(clip[j], clip[i], v1);
+				if (side0 + side1 == 0 && side0 && math::lineIntersection(clip[j], clip[i], v0, v1, x))
+					res[nRes++] = x;
+				if (k == nPoly - 1)
+					break;
+				if (side1 != -dir)
+					res[nRes++] = v1;
+				v0 = v1;
+				side0 = side1;
+			}
+		}
+
+		return nRes;
+	}
+
+	float surfaceArea(const float3& min, const float3& max) noexcept
+	{
+		float3 d = max - min;
+		return d.x * d.y + d.y * d.z + d.z * d.x;
+	}
+
+	float radicalInverse(std::uint32_t bits) noexcept
+	{
+		bits = (bits << 16u) | (bits >> 16u);
+		bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+		bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+		bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+		bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+		return bits * 2.3283064365386963e-10f;
+	}
+
+	std::uint32_t hashTexel(std::uint32_t x, std::uint32_t y) noexcept
+	{
+		std::uint32_t seed = x * 73856093u ^ y * 19349663u;
+		seed = (seed ^ 61u) ^ (seed >> 16u);
+		seed *= 9u;
+		seed = seed ^ (seed >> 4u);
+		seed *= 0x27d4eb2du;
+		seed = seed ^ (seed >> 15u);
+		return seed;
+	}
+
+	bool intersectBox(const float3& orig, const float3& invdir, const float3& min, const float3& max, float tmin, float tmax, float& tnear) noexcept
+	{
+		float tx1 = (min.x - orig.x) * invdir.x;
+		float tx2 = (max.x - orig.x) * invdir.x;
+		float ty1 = (min.y - orig.y) * invdir.y;
+		float ty2 = (max.y - orig.y) * invdir.y;
+		float tz1 = (min.z - orig.z) * invdir.z;
+		float tz2 = (max.z - orig.z) * invdir.z;
+
+		float t0 = std::max(std::max(std::min(tx1, tx2), std::min(ty1, ty2)), std::max(std::min(tz1, tz2), tmin));
+		float t1 = std::min(std::min(std::max(tx1, tx2), std::max(ty1, ty2)), std::min(std::max(tz1, tz2), tmax));
+
+		tnear = t0;
+		return t0 <= t1;
+	}
+
+}
+
+LightBakingRT::LightBakingRT() noexcept
+	: _world(float4x4::One)
+	, _tmin(0.1f)
+	, _tmax(100.0f)
+	, _environmentColor(float3::One)
+	, _numSamples(256)
+	, _numThreads(1)
+	, _isStopped(false)
+	, _tracedSamples(0)
+{
+	std::memset(&_lightmap, 0, sizeof(_lightmap));
+
+	_mesh.vertices = nullptr;
+	_mesh.indices = nullptr;
+	_mesh.numIndices = 0;
+	_mesh.strideVertices = 0;
+	_mesh.strideTexcoord = 0;
+	_mesh.sizeofVertices = 0;
+	_mesh.sizeofIndices = 0;
+}
+
+LightBakingRT::LightBakingRT(const LightBakingParams& params) noexcept
+	: LightBakingRT()
+{
+	this->open(params);
+}
+
+LightBakingRT::~LightBakingRT() noexcept
+{
+	this->close();
+}
+
+bool
+LightBakingRT::open(const LightBakingParams& params) noexcept
+{
+	assert(params.lightMap);
+	assert(params.lightMap->data);
+	assert(params.lightMap->width >= 0 && params.lightMap->height >= 0);
+	assert(params.lightMap->channel == 1 || params.lightMap->channel == 2 || params.lightMap->channel == 3 || params.lightMap->channel == 4);
+	assert(params.model.numVertices > 0 && params.model.numIndices > 0);
+	assert(params.model.sizeofIndices == 1 || params.model.sizeofIndices == 2 || params.model.sizeofIndices == 4);
+	assert(params.baking.hemisphereNear < params.baking.hemisphereFar && params.baking.hemisphereNear > 0.0f);
+
+	_tmin = params.baking.hemisphereNear;
+	_tmax = params.baking.hemisphereFar;
+	_environmentColor = params.baking.environmentColor;
+	_numSamples = std::max(1U, params.baking.raySamples);
+	_numThreads = params.baking.rayThreads ? params.baking.rayThreads : std::max(1U, std::thread::hardware_concurrency());
+	_progress = params.baking.listener;
+
+	this->setRenderTarget(params.lightMap->data.get(), params.lightMap->width, params.lightMap->height, params.lightMap->channel);
+	this->setGeometry(params.model);
+
+	return true;
+}
+
+void
+LightBakingRT::close() noexcept
+{
+	_triangles.clear();
+	_triangles.shrink_to_fit();
+	_triangleIndices.clear();
+	_triangleIndices.shrink_to_fit();
+	_nodes.clear();
+	_nodes.shrink_to_fit();
+	_samples.clear();
+	_samples.shrink_to_fit();
+}
+
+void
+LightBakingRT::setLightMassListener(LightMassListenerPtr pointer) noexcept
+{
+	_lightMassListener = pointer;
+}
+
+LightMassListenerPtr
+LightBakingRT::getLightMassListener() const noexcept
+{
+	return _lightMassListener;
+}
+
+void
+LightBakingRT::setWorldTransform(const float4x4& transform) noexcept
+{
+	_world = transform;
+}
+
+const float4x4&
+LightBakingRT::getWorldTransform() const noexcept
+{
+	return _world;
+}
+
+bool
+LightBakingRT::isStopped() const noexcept
+{
+	return _isStopped;
+}
+
+bool
+LightBakingRT::start() noexcept
+{
+	try
+	{
+		_isStopped = false;
+		_tracedSamples = 0;
+
+		if (_lightMassListener)
+			_lightMassListener->onMessage("Building the bounding volume hierarchy of the model.");
+
+		this->buildTriangles();
+		this->buildHierarchy();
+		this->buildSamples();
+
+		if (_lightMassListener)
+			_lightMassListener->onMessage("Tracing " + std::to_string(_samples.size()) + " texels with " + std::to_string(_numSamples) + " rays on " + std::to_string(_numThreads) + " threads.");
+
+		std::uint32_t numChunks = static_cast<std::uint32_t>((_samples.size() + SampleChunkSize - 1) / SampleChunkSize);
+		std::atomic<bool> cancelled(false);
+
+		ThreadPool threadPool;
+		threadPool.start(std::max(_numThreads, 1U));
+
+		threadPool.parallelFor(numChunks, [&](std::size_t chunk, std::uint32_t thread)
+		{
+			if (_isStopped || cancelled)
+				return;
+
+			std::size_t begin = chunk * SampleChunkSize;
+			std::size_t end = std::min(begin + SampleChunkSize, _samples.size());
+
+			for (std::size_t i = begin; i < end; i++)
+			{
+				const Sample& sample = _samples[i];
+				this->traceSample(sample, _lightmap.data + (sample.y * _lightmap.width + sample.x) * _lightmap.channels);
+			}
+
+			_tracedSamples += static_cast<std::uint32_t>(end - begin);
+
+			// The callbacks are not thread safe, only the calling thread reports the progress.
+			if (thread == 0)
+			{
+				if (_progress && !_progress(this->getSampleProcess()))
+					cancelled = true;
+
+				if (_lightMassListener)
+					_lightMassListener->onBakingProgressing(this->getSampleProcess());
+			}
+		});
+
+		this->close();
+
+		return !cancelled;
+	}
+	catch (...)
+	{
+		this->close();
+		return false;
+	}
+}
+
+void
+LightBakingRT::stop() noexcept
+{
+	if (!_isStopped)
+		_isStopped = true;
+}
+
+float
+LightBakingRT::getSampleProcess() const noexcept
+{
+	if (_samples.empty())
+		return 1.0f;
+
+	return (float)_tracedSamples / (float)_samples.size();
+}
+
+void
+LightBakingRT::setRenderTarget(float outLightmap[], int w, int h, int c)
+{
+	_lightmap.data = outLightmap;
+	_lightmap.width = w;
+	_lightmap.height = h;
+	_lightmap.channels = c;
+}
+
+void
+LightBakingRT::setGeometry(const LightModelData& model)
+{
+	_mesh.vertices = model.vertices;
+	_mesh.indices = model.indices;
+	_mesh.numIndices = model.numIndices;
+	_mesh.strideVertices = model.strideVertices;
+	_mesh.strideTexcoord = model.strideTexcoord;
+	_mesh.sizeofVertices = model.sizeofVertices;
+	_mesh.sizeofIndices = model.sizeofIndices;
+	_mesh.subsets = model.subsets;
+
+	if (_mesh.subsets.empty())
+	{
+		LightModelSubset subset;
+		subset.drawcall.count = model.numIndices;
+		_mesh.subsets.push_back(subset);
+	}
+}
+
+std::uint32_t
+LightBakingRT::getIndex(std::size_t n) const noexcept
+{
+	if (_mesh.sizeofIndices == 1)
+		return ((const std::uint8_t*)_mesh.indices)[n];
+	else if (_mesh.sizeofIndices == 2)
+		return ((const std::uint16_t*)_mesh.indices)[n];
+	else
+		return ((const std::uint32_t*)_mesh.indices)[n];
+}
+
+void
+LightBakingRT::buildTriangles() noexcept
+{
+	_triangles.clear();
+	_triangles.reserve(_mesh.numIndices / 3);
+
+	for (auto& subset : _mesh.subsets)
+	{
+		std::size_t first = subset.drawcall.firstIndex;
+		std::size_t last = std::min<std::size_t>(first + subset.drawcall.count, _mesh.numIndices);
+
+		for (std::size_t i = first; i + 2 < last; i += 3)
+		{
+			float3 p[3];
+			for (std::size_t j = 0; j < 3; j++)
+			{
+				std::uint32_t index = this->getIndex(i + j) + subset.drawcall.baseVertex;
+				p[j] = _world * *(const float3*)(_mesh.vertices + index * _mesh.sizeofVertices + _mesh.strideVertices);
+			}
+
+			Triangle triangle;
+			triangle.p0 = p[0];
+			triangle.e1 = p[1] - p[0];
+			triangle.e2 = p[2] - p[0];
+			triangle.emissive = _lightmap.channels >= 3 ? subset.emissive : float3::Zero;
+
+			_triangles.push_back(triangle);
+		}
+	}
+}
+
+void
+LightBakingRT::buildHierarchy() noexcept
+{
+	struct BuildTask
+	{
+		std::uint32_t node;
+		std::uint32_t begin;
+		std::uint32_t end;
+	};
+
+	struct Bin
+	{
+		float3 min;
+		float3 max;
+		std::uint32_t count;
+	};
+
+	std::uint32_t numTriangles = static_cast<std::uint32_t>(_triangles.size());
+
+	std::vector<float3> mins(numTriangles);
+	std::vector<float3> maxs(numTriangles);
+	std::vector<float3> centers(numTriangles);
+
+	for (std::uint32_t i = 0; i < numTriangles; i++)
+	{
+		const Triangle& triangle = _triangles[i];
+		float3 p1 = triangle.p0 + triangle.e1;
+		float3 p2 = triangle.p0 + triangle.e2;
+		mins[i] = math::min(triangle.p0, math::min(p1, p2));
+		maxs[i] = math::max(triangle.p0, math::max(p1, p2));
+		centers[i] = (mins[i] + maxs[i]) * 0.5f;
+	}
+
+	_triangleIndices.resize(numTriangles);
+	for (std::uint32_t i = 0; i < numTriangles; i++)
+		_triangleIndices[i] = i;
+
+	_nodes.clear();
+	_nodes.reserve(numTriangles * 2 + 1);
+	_nodes.emplace_back();
+
+	std::vector<BuildTask> tasks;
+	tasks.push_back({ 0, 0, numTriangles });
+
+	while (!tasks.empty())
+	{
+		BuildTask task = tasks.back();
+		tasks.pop_back();
+
+		float3 boundsMin(FLT_MAX, FLT_MAX, FLT_MAX);
+		float3 boundsMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		float3 centerMin(FLT_MAX, FLT_MAX, FLT_MAX);
+		float3 centerMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+		for (std::uint32_t i = task.begin; i < task.end; i++)
+		{
+			std::uint32_t index = _triangleIndices[i];
+			boundsMin = math::min(boundsMin, mins[index]);
+			boundsMax = math::max(boundsMax, maxs[index]);
+			centerMin = math::min(centerMin, centers[index]);
+			centerMax = math::max(centerMax, centers[index]);
+		}
+
+		Node& node = _nodes[task.node];
+		node.min = boundsMin;
+		node.max = boundsMax;
+		node.first = task.begin;
+		node.count = task.end - task.begin;
+
+		if (node.count <= BVHLeafSize)
+			continue;
+
+		float3 extent = centerMax - centerMin;
+		std::uint8_t axis = 0;
+		if (extent.y > extent[axis]) axis = 1;
+		if (extent.z > extent[axis]) axis = 2;
+
+		if (extent[axis] <= 0.0f)
+			continue;
+
+		Bin bins[BVHBinCount];
+		for (auto& bin : bins)
+		{
+			bin.min = float3(FLT_MAX, FLT_MAX, FLT_MAX);
+			bin.max = float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+			bin.count = 0;
+		}
+
+		float scale = BVHBinCount / extent[axis];
+
+		auto binIndex = [&](std::uint32_t index) -> std::uint32_t
+		{
+			std::uint32_t bin = static_cast<std::uint32_t>((centers[index][axis] - centerMin[axis]) * scale);
+			return std::min(bin, BVHBinCount - 1);
+		};
+
+		for (std::uint32_t i = task.begin; i < task.end; i++)
+		{
+			std::uint32_t index = _triangleIndices[i];
+			Bin& bin = bins[binIndex(index)];
+			bin.min = math::min(bin.min, mins[index]);
+			bin.max = math::max(bin.max, maxs[index]);
+			bin.count++;
+		}
+
+		float rightArea[BVHBinCount];
+		std::uint32_t rightCount[BVHBinCount];
+
+		float3 accumMin(FLT_MAX, FLT_MAX, FLT_MAX);
+		float3 accumMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		std::uint32_t accumCount = 0;
+
+		for (std::uint32_t i = BVHBinCount - 1; i > 0; i--)
+		{
+			accumMin = math::min(accumMin, bins[i].min);
+			accumMax = math::max(accumMax, bins[i].max);
+			accumCount += bins[i].count;
+			rightArea[i] = accumCount ? surfaceArea(accumMin, accumMax) : 0.0f;
+			rightCount[i] = accumCount;
+		}
+
+		float bestCost = FLT_MAX;
+		std::uint32_t bestSplit = 0;
+
+		accumMin = float3(FLT_MAX, FLT_MAX, FLT_MAX);
+		accumMax = float3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+		accumCount = 0;
+
+		for (std::uint32_t i = 0; i < BVHBinCount - 1; i++)
+		{
+			accumMin = math::min(accumMin, bins[i].min);
+			accumMax = math::max(accumMax, bins[i].max);
+			accumCount += bins[i].count;
+
+			if (accumCount == 0 || rightCount[i + 1] == 0)
+				continue;
+
+			float cost = surfaceArea(accumMin, accumMax) * accumCount + rightArea[i + 1] * rightCount[i + 1];
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestSplit = i + 1;
+			}
+		}
+
+		float leafCost = surfaceArea(boundsMin, boundsMax) * node.count;
+		if (bestSplit == 0 || (bestCost >= leafCost && node.count <= BVHMaxLeafSize))
+			continue;
+
+		auto it = std::partition(_triangleIndices.begin() + task.begin, _triangleIndices.begin() + task.end, [&](std::uint32_t index)
+		{
+			return binIndex(index) < bestSplit;
+		});
+
+		std::uint32_t middle = static_cast<std::uint32_t>(it - _triangleIndices.begin());
+		if (middle == task.begin || middle == task.end)
+			continue;
+
+		std::uint32_t left = static_cast<std::uint32_t>(_nodes.size());
+		_nodes[task.node].first = left;
+		_nodes[task.node].count = 0;
+		_nodes.emplace_back();
+		_nodes.emplace_back();
+
+		tasks.push_back({ left, task.begin, middle });
+		tasks.push_back({ left + 1, middle, task.end });
+	}
+
+	std::vector<Triangle> triangles(numTriangles);
+	for (std::uint32_t i = 0; i < numTriangles; i++)
+		triangles[i] = _triangles[_triangleIndices[i]];
+
+	_triangles.swap(triangles);
+}
+
+void
+LightBakingRT::buildSamples() noexcept
+{
+	assert(_lightmap.data);
+
+	_samples.clear();
+
+	std::vector<bool> covered(_lightmap.width * _lightmap.height, false);
+
+	for (std::int32_t y = 0; y < _lightmap.height; y++)
+	{
+		for (std::int32_t x = 0; x < _lightmap.width; x++)
+		{
+			const float* pixel = _lightmap.data + (y * _lightmap.width + x) * _lightmap.channels;
+			for (std::uint8_t j = 0; j < _lightmap.channels; j++)
+			{
+				if (pixel[j] != 0.0f)
+				{
+					covered[y * _lightmap.width + x] = true;
+					break;
+				}
+			}
+		}
+	}
+
+	float2 uvScale((float)_lightmap.width, (float)_lightmap.height);
+
+	for (auto& subset : _mesh.subsets)
+	{
+		std::size_t first = subset.drawcall.firstIndex;
+		std::size_t last = std::min<std::size_t>(first + subset.drawcall.count, _mesh.numIndices);
+
+		for (std::size_t i = first; i + 2 < last; i += 3)
+		{
+			float3 p[3];
+			float2 uv[3];
+
+			for (std::size_t j = 0; j < 3; j++)
+			{
+				std::uint32_t index = this->getIndex(i + j) + subset.drawcall.baseVertex;
+				const std::uint8_t* vertex = _mesh.vertices + index * _mesh.sizeofVertices;
+				p[j] = _world * *(const float3*)(vertex + _mesh.strideVertices);
+				uv[j] = *(const float2*)(vertex + _mesh.strideTexcoord) * uvScale;
+			}
+
+			float2 uvMin = math::min(uv[0], math::min(uv[1], uv[2]));
+			float2 uvMax = math::max(uv[0], math::max(uv[1], uv[2]));
+
+			std::int32_t minx = std::max((std::int32_t)std::floor(uvMin.x) - 1, 0);
+			std::int32_t miny = std::max((std::int32_t)std::floor(uvMin.y) - 1, 0);
+			std::int32_t maxx = std::min((std::int32_t)std::ceil(uvMax.x) + 1, _lightmap.width);
+			std::int32_t maxy = std::min((std::int32_t)std::ceil(uvMax.y) + 1, _lightmap.height);
+
+			float3 v1 = p[1] - p[0];
+			float3 v2 = p[2] - p[0];
+			float3 normal = math::normalize(math::cross(v1, v2));
+
+			if (!math::isfinite(normal) || math::length2(normal) < 0.5f)
+				continue;
+
+			for (std::int32_t y = miny; y < maxy; y++)
+			{
+				for (std::int32_t x = minx; x < maxx; x++)
+				{
+					if (covered[y * _lightmap.width + x])
+						continue;
+
+					float2 pixel[16];
+					pixel[0].set(x, y);
+					pixel[1].set(x + 1, y);
+					pixel[2].set(x + 1, y + 1);
+					pixel[3].set(x, y + 1);
+
+					float2 res[16];
+					int nRes = convexClip(pixel, 4, uv, 3, res);
+					if (nRes <= 0)
+						continue;
+
+					float2 centroid = res[0];
+					float area = res[nRes - 1].x * res[0].y - res[nRes - 1].y * res[0].x;
+					for (int k = 1; k < nRes; k++)
+					{
+						centroid = centroid + res[k];
+						area += res[k - 1].x * res[k].y - res[k - 1].y * res[k].x;
+					}
+
+					centroid = centroid / (float)nRes;
+
+					if (std::abs(area / 2.0f) <= 0.0f)
+						continue;
+
+					float2 coord = math::barycentric(uv[0], uv[1], uv[2], centroid);
+					if (!math::isfinite(coord))
+						continue;
+
+					Sample sample;
+					sample.x = x;
+					sample.y = y;
+					sample.position = p[0] + v2 * coord.x + v1 * coord.y;
+					sample.normal = normal;
+
+					if (!math::isfinite(sample.position))
+						continue;
+
+					covered[y * _lightmap.width + x] = true;
+
+					_samples.push_back(sample);
+				}
+			}
+		}
+	}
+}
+
+bool
+LightBakingRT::intersect(const float3& orig, const float3& dir, float tmin, float tmax, Hit& hit) const noexcept
+{
+	if (_nodes.empty())
+		return false;
+
+	float3 invdir(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+
+	hit.distance = tmax;
+	hit.triangle = std::numeric_limits<std::uint32_t>::max();
+	hit.backface = false;
+
+	std::uint32_t stack[BVHStackSize];
+	std::uint32_t stackSize = 0;
+
+	float tnear;
+	if (!intersectBox(orig, invdir, _nodes[0].min, _nodes[0].max, tmin, hit.distance, tnear))
+		return false;
+
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		const Node& node = _nodes[stack[--stackSize]];
+
+		if (!intersectBox(orig, invdir, node.min, node.max, tmin, hit.distance, tnear))
+			continue;
+
+		if (node.count > 0)
+		{
+			for (std::uint32_t i = node.first; i < node.first + node.count; i++)
+			{
+				const Triangle& triangle = _triangles[i];
+
+				float3 pvec = math::cross(dir, triangle.e2);
+				float det = math::dot(triangle.e1, pvec);
+				if (std::abs(det) < 1e-12f)
+					continue;
+
+				float invdet = 1.0f / det;
+
+				float3 tvec = orig - triangle.p0;
+				float u = math::dot(tvec, pvec) * invdet;
+				if (u < 0.0f || u > 1.0f)
+					continue;
+
+				float3 qvec = math::cross(tvec, triangle.e1);
+				float v = math::dot(dir, qvec) * invdet;
+				if (v < 0.0f || u + v > 1.0f)
+					continue;
+
+				float t = math::dot(triangle.e2, qvec) * invdet;
+				if (t > tmin && t < hit.distance)
+				{
+					hit.distance = t;
+					hit.triangle = i;
+					hit.backface = det < 0.0f;
+				}
+			}
+		}
+		else
+		{
+			float tleft, tright;
+			bool left = intersectBox(orig, invdir, _nodes[node.first].min, _nodes[node.first].max, tmin, hit.distance, tleft);
+			bool right = intersectBox(orig, invdir, _nodes[node.first + 1].min, _nodes[node.first + 1].max, tmin, hit.distance, tright);
+
+			if (left && right)
+			{
+				assert(stackSize + 2 <= BVHStackSize);
+
+				if (tleft < tright)
+				{
+					stack[stackSize++] = node.first + 1;
+					stack[stackSize++] = node.first;
+				}
+				else
+				{
+					stack[stackSize++] = node.first;
+					stack[stackSize++] = node.first + 1;
+				}
+			}
+			else if (left)
+			{
+				stack[stackSize++] = node.first;
+			}
+			else if (right)
+			{
+				stack[stackSize++] = node.first + 1;
+			}
+		}
+	}
+
+	return hit.triangle != std::numeric_limits<std::uint32_t>::max();
+}
+
+void
+LightBakingRT::traceSample(const Sample& sample, float* out) const noexcept
+{
+	const float3& normal = sample.normal;
+
+	float3 tangent = std::abs(normal.z) < 0.999f ? float3::UnitZ : float3::UnitX;
+	float3 bitangent = math::normalize(math::cross(tangent, normal));
+	tangent = math::cross(normal, bitangent);
+
+	std::uint32_t seed = hashTexel(sample.x, sample.y);
+	float rotateX = (seed & 0xFFFF) / 65536.0f;
+	float rotateY = (seed >> 16) / 65536.0f;
+
+	float3 color = float3::Zero;
+	std::uint32_t validity = 0;
+
+	for (std::uint32_t i = 0; i < _numSamples; i++)
+	{
+		float u1 = (i + 0.5f) / _numSamples + rotateX;
+		float u2 = radicalInverse(i) + rotateY;
+		u1 -= std::floor(u1);
+		u2 -= std::floor(u2);
+
+		float r = std::sqrt(u1);
+		float phi = 2.0f * M_PI * u2;
+
+		float3 dir = bitangent * (r * std::cos(phi)) + tangent * (r * std::sin(phi)) + normal * std::sqrt(std::max(0.0f, 1.0f - u1));
+
+		Hit hit;
+		if (!this->intersect(sample.position, dir, _tmin, _tmax, hit))
+		{
+			color += _environmentColor;
+			validity++;
+		}
+		else if (!hit.backface)
+		{
+			color += _triangles[hit.triangle].emissive;
+			validity++;
+		}
+	}
+
+	// Same rejection as the hemicube backends: texels which see too many back faces are inside geometry.
+	if (validity <= _numSamples * 0.9f)
+		return;
+
+	float3 c = color / (float)validity;
+
+	switch (_lightmap.channels)
+	{
+	case 1:
+		out[0] = std::max((c.x + c.y + c.z) / 3.0f, FLT_MIN);
+		break;
+	case 2:
+		out[0] = std::max((c.x + c.y + c.z) / 3.0f, FLT_MIN);
+		out[1] = 1.0f;
+		break;
+	case 3:
+		out[0] = std::max(c.x, FLT_MIN);
+		out[1] = std::max(c.y, FLT_MIN);
+		out[2] = std::max(c.z, FLT_MIN);
+		break;
+	case 4:
+		out[0] = std::max(c.x, FLT_MIN);
+		out[1] = std::max(c.y, FLT_MIN);
+		out[2] = std::max(c.z, FLT_MIN);
+		out[3] = 1.0f;
+		break;
+	default:
+		assert(false);
+		break;
+	}
+}
+
+_NAME_END
@@ -0,0 +1,161 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#ifndef _H_LIGHTMASS_RAY_TRACING_H_
+#define _H_LIGHTMASS_RAY_TRACING_H_
+
+#include <atomic>
+
+#include "LightMassParams.h"
+#include "LightMassListener.h"
+
+_NAME_BEGIN
+
+// Bakes the same lightmap as the hemicube backends, but traces rays against a BVH on the CPU,
+// so no graphics context is required and every core is used.
+class LightBakingRT final
+{
+public:
+	LightBakingRT() noexcept;
+	LightBakingRT(const LightBakingParams& params) noexcept;
+	~LightBakingRT() noexcept;
+
+	bool open(const LightBakingParams& params) noexcept;
+	void close() noexcept;
+
+	void setLightMassListener(LightMassListenerPtr pointer) noexcept;
+	LightMassListenerPtr getLightMassListener() const noexcept;
+
+	void setWorldTransform(const float4x4& transform) noexcept;
+	const float4x4& getWorldTransform() const noexcept;
+
+	bool isStopped() const noexcept;
+
+	bool start() noexcept;
+	void stop() noexcept;
+
+	float getSampleProcess() const noexcept;
+
+protected:
+	void setRenderTarget(float lightmap[], int w, int h, int channels);
+	void setGeometry(const LightModelData& model);
+
+private:
+	struct Triangle
+	{
+		float3 p0;
+		float3 e1;
+		float3 e2;
+		float3 emissive;
+	};
+
+	struct Node
+	{
+		float3 min;
+		std::uint32_t first;
+		float3 max;
+		std::uint32_t count;
+	};
+
+	struct Sample
+	{
+		std::int32_t x;
+		std::int32_t y;
+		float3 position;
+		float3 normal;
+	};
+
+	struct Hit
+	{
+		float distance;
+		std::uint32_t triangle;
+		bool backface;
+	};
+
+	std::uint32_t getIndex(std::size_t n) const noexcept;
+
+	void buildTriangles() noexcept;
+	void buildHierarchy() noexcept;
+	void buildSamples() noexcept;
+
+	bool intersect(const float3& orig, const float3& dir, float tmin, float tmax, Hit& hit) const noexcept;
+	void traceSample(const Sample& sample, float* out) const noexcept;
+
+private:
+	struct
+	{
+		const std::uint8_t* vertices;
+		const std::uint8_t* indices;
+		std::uint32_t numIndices;
+		std::uint32_t strideVertices;
+		std::uint32_t strideTexcoord;
+		std::uint16_t sizeofVertices;
+		std::uint8_t sizeofIndices;
+		std::vector<LightModelSubset> subsets;
+	} _mesh;
+
+	struct
+	{
+		std::int32_t width;
+		std::int32_t height;
+		std::uint8_t channels;
+		float* data;
+	} _lightmap;
+
+	float4x4 _world;
+
+	float _tmin;
+	float _tmax;
+	float3 _environmentColor;
+	std::uint32_t _numSamples;
+	std::uint32_t _numThreads;
+
+	std::atomic<bool> _isStopped;
+	std::atomic<std::uint32_t> _tracedSamples;
+
+	std::vector<Triangle> _triangles;
+	std::vector<std::uint32_t> _triangleIndices;
+	std::vector<Node> _nodes;
+	std::vector<Sample> _samples;
+
+	std::function<bool(float progress)> _progress;
+
+	LightMassListenerPtr _lightMassListener;
+};
+
+_NAME_END
+
+#endif
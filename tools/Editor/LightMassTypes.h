@@ -44,11 +44,13 @@ _NAME_BEGIN
 
 typedef std::shared_ptr<class LightMass> LightMassPtr;
 typedef std::shared_ptr<class LightMassBaking> LightMassBakingPtr;
+typedef std::shared_ptr<class LightBakingRT> LightBakingRTPtr;
 typedef std::shared_ptr<class LightMassListener> LightMassListenerPtr;
 typedef std::shared_ptr<class LightMapData> LightMapDataPtr;
 
 typedef std::weak_ptr<class LightMass> LightMassWeakPtr;
 typedef std::weak_ptr<class LightMassBaking> LightMassBakingWeakPtr;
+typedef std::weak_ptr<class LightBakingRT> LightBakingRTWeakPtr;
 typedef std::weak_ptr<class LightMassListener> LightMassListenerWeakPtr;
 typedef std::weak_ptr<class LightMapData> LightMapDataWeakPtr;
 
@@ -298,6 +298,7 @@ GuiControllerComponent::GuiControllerComponent() noexcept
 	, _lightMassListener(std::make_shared<AppMassListener>())
 	, _stopUVMapper(false)
 	, _stopLightmass(false)
+	, _iboType(ray::GraphicsIndexType::GraphicsIndexTypeUInt32)
 {
 }
 
@@ -600,6 +601,7 @@ GuiControllerComponent::makeMaterialCamera() noexcept
 
 	_vbo = ray::ResManager::instance()->createVertexBuffer(sphereMesh, ray::ModelMakerFlagBits::ModelMakerFlagBitALL);
 	_ibo = ray::ResManager::instance()->createIndexBuffer(sphereMesh);
+	_iboType = ray::ResManager::instance()->getIndexType(sphereMesh);
 
 	return true;
 }
@@ -1839,10 +1841,10 @@ GuiControllerComponent::onUVMapperProcessing(const GuiParams& params, float& pro
 
 	if (!_future)
 	{
-		static auto progress = [&](float progress) -> HRESULT
+		static auto progress = [&](float progress) -> bool
 		{
 			progressing = progress;
-			return _stopUVMapper ? -1 : S_OK;
+			return !_stopUVMapper;
 		};
 
 		_future = std::make_unique<std::future<bool>>(std::async(std::launch::async, [&]() -> bool
@@ -1944,6 +1946,7 @@ GuiControllerComponent::onLightMassProcessing(const GuiParams& options, float& p
 			params.baking.interpolationPasses = options.lightmass.interpolationPasses;
 			params.baking.interpolationThreshold = options.lightmass.interpolationThreshold;
 			params.baking.listener = progress;
+			params.backend = options.lightmass.enableRayTracing ? ray::LightBakingBackend::RayTracing : ray::LightBakingBackend::Hemisphere;
 
 			params.model.vertices = (std::uint8_t*)_models[0]->vertices.data();
 			params.model.indices = _models[0]->indices.data();
@@ -2176,7 +2179,7 @@ GuiControllerComponent::onUpdateMaterial(const EditorAssetItem& item) noexcept
 	ray::RenderSystem::instance()->setFramebuffer(_previewFramebuffer);
 	ray::RenderSystem::instance()->clearFramebuffer(0, ray::GraphicsClearFlagBits::GraphicsClearFlagColorDepthBit, ray::float4::Zero, 1.0, 0);
 	ray::RenderSystem::instance()->setVertexBuffer(0, _vbo, 0);
-	ray::RenderSystem::instance()->setIndexBuffer(_ibo, 0, ray::GraphicsIndexType::GraphicsIndexTypeUInt32);
+	ray::RenderSystem::instance()->setIndexBuffer(_ibo, 0, _iboType);
 	ray::RenderSystem::instance()->setMaterialPass(material->getTech("Preview")->getPass(0));
 	ray::RenderSystem::instance()->drawIndexed(4416, 1, 0, 0, 0);
 	ray::RenderSystem::instance()->readFramebuffer(0, item.preview, 0, 0, 0, item.preview->getGraphicsTextureDesc().getWidth(), item.preview->getGraphicsTextureDesc().getHeight());
@@ -132,6 +132,7 @@ private:
 
 	ray::GraphicsDataPtr _vbo;
 	ray::GraphicsDataPtr _ibo;
+	ray::GraphicsIndexType _iboType;
 
 	EditorAssetItems _itemTextures;
 	EditorAssetItems _itemMaterials;
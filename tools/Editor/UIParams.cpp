@@ -54,5 +54,6 @@ GUILightMass::GUILightMass() noexcept
 	, sampleCount(1)
 	, enableGI(false)
 	, enableSkyLighting(false)
+	, enableRayTracing(false)
 {
 }
\ No newline at end of file
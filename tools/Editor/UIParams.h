@@ -61,6 +61,7 @@ struct GUILightMass
 
 	bool enableGI;
 	bool enableSkyLighting;
+	bool enableRayTracing;
 
 	float hemisphereNear;
 	float hemisphereFar;
@@ -80,6 +80,7 @@ public:
 		StartUVMapper,
 		EnableGI,
 		EnableIBL,
+		EnableRayTracing,
 		SampleCount,
 		EnvironmentColor,
 		EnvironmentIntensity,
@@ -2456,6 +2456,8 @@ GuiViewComponent::showLightMass() noexcept
 			if (_setting.lightmass.enableGI)
 				ray::Gui::checkbox(_langs[UILang::EnableIBL].c_str(), &_setting.lightmass.enableSkyLighting);
 
+			ray::Gui::checkbox(_langs[UILang::EnableRayTracing].c_str(), &_setting.lightmass.enableRayTracing);
+
 			ray::Gui::textUnformatted(_langs[UILang::OutputImageSize].c_str(), _langs[UILang::OutputImageSize].c_str() + _langs[UILang::OutputImageSize].size());
 			ray::Gui::comboWithRevert("##Output size", _langs[UILang::Revert].c_str(), &_setting.lightmass.imageSize, _default.lightmass.imageSize, itemsImageSize, sizeof(itemsImageSize) / sizeof(itemsImageSize[0]));
 
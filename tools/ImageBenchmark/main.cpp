@@ -0,0 +1,668 @@
+// +----------------------------------------------------------------------
+// | Project : ray.
+// | All rights reserved.
+// +----------------------------------------------------------------------
+// | Copyright (c) 2013-2017.
+// +----------------------------------------------------------------------
+// | * Redistribution and use of this software in source and binary forms,
+// |   with or without modification, are permitted provided that the following
+// |   conditions are met:
+// |
+// | * Redistributions of source code must retain the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer.
+// |
+// | * Redistributions in binary form must reproduce the above
+// |   copyright notice, this list of conditions and the
+// |   following disclaimer in the documentation and/or other
+// |   materials provided with the distribution.
+// |
+// | * Neither the name of the ray team, nor the names of its
+// |   contributors may be used to endorse or promote products
+// |   derived from this software without specific prior
+// |   written permission of the ray team.
+// |
+// | THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// | "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// | LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// | A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// | OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// | SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// | LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// | DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// | THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// | (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// | OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// +----------------------------------------------------------------------
+#include <ray/imagutil.h>
+#include <ray/imagmipmap.h>
+#include <ray/imagcompress.h>
+#include <ray/mathutil.h>
+#include <ray/mstream.h>
+#include <ray/thread.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct ImageBenchmarkParams
+{
+	std::uint32_t width = 3840;
+	std::uint32_t height = 2160;
+	std::uint32_t iterations = 20;
+	std::uint32_t mipIterations = 3;
+	std::uint32_t threads = 0;
+	std::uint32_t compressSize = 512;
+	std::string output;
+	bool csv = false;
+};
+
+struct ConvertCase
+{
+	const char* name;
+	std::size_t srcSize;
+	std::size_t dstSize;
+	std::function<void(const std::uint8_t*, std::uint8_t*, std::size_t)> convert;
+};
+
+struct ConvertResult
+{
+	const char* name;
+	const char* simd;
+	double ms;
+	double mpixels;
+	double gbytes;
+	bool exact;
+};
+
+struct MipmapResult
+{
+	const char* filter;
+	std::uint32_t threads;
+	double ms;
+	double mpixels;
+};
+
+struct CompressCase
+{
+	const char* name;
+	ray::image::format_t format;
+	std::uint32_t channels;
+	bool hdr;
+};
+
+struct CompressResult
+{
+	const char* format;
+	const char* quality;
+	std::uint32_t threads;
+	double ms;
+	double mpixels;
+	double psnr;
+	bool readback;
+};
+
+static void
+printUsage(const char* name) noexcept
+{
+	std::printf("usage: %s [options]\n", name);
+	std::printf("  --csv               print csv instead of json\n");
+	std::printf("  --width <n>         image width, 3840 by default\n");
+	std::printf("  --height <n>        image height, 2160 by default\n");
+	std::printf("  --iterations <n>    runs per converter, the fastest one is reported\n");
+	std::printf("  --mip-iterations <n> runs per mip chain\n");
+	std::printf("  --threads <n>       threads for mip generation and compression, 0 uses every core\n");
+	std::printf("  --compress-size <n> side of the square image compressed to every block format, 512 by default\n");
+	std::printf("  --output <dir>      also writes every compressed image there as dds\n");
+}
+
+static bool
+parseParams(int argc, const char* argv[], ImageBenchmarkParams& params) noexcept
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+		if (std::strcmp(arg, "--csv") == 0)
+			params.csv = true;
+		else if (value)
+		{
+			if (std::strcmp(arg, "--width") == 0)
+				params.width = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--height") == 0)
+				params.height = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--iterations") == 0)
+				params.iterations = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--mip-iterations") == 0)
+				params.mipIterations = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--threads") == 0)
+				params.threads = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--compress-size") == 0)
+				params.compressSize = std::strtoul(value, nullptr, 10);
+			else if (std::strcmp(arg, "--output") == 0)
+				params.output = value;
+			else
+				return false;
+
+			i++;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return params.width > 0 && params.height > 0 && params.iterations > 0 && params.mipIterations > 0 && params.compressSize > 0;
+}
+
+static const char*
+simdName(ray::image::simd_t level) noexcept
+{
+	switch (level)
+	{
+	case ray::image::simd_t::SSE2: return "sse2";
+	case ray::image::simd_t::AVX2: return "avx2";
+	case ray::image::simd_t::NEON: return "neon";
+	default:
+		return "scalar";
+	}
+}
+
+static std::vector<ray::image::simd_t>
+supportedLevels() noexcept
+{
+	std::vector<ray::image::simd_t> levels;
+	levels.push_back(ray::image::simd_t::None);
+
+	auto support = ray::image::simd_support();
+	if (support == ray::image::simd_t::SSE2 || support == ray::image::simd_t::AVX2)
+		levels.push_back(ray::image::simd_t::SSE2);
+	if (support == ray::image::simd_t::AVX2)
+		levels.push_back(ray::image::simd_t::AVX2);
+	if (support == ray::image::simd_t::NEON)
+		levels.push_back(ray::image::simd_t::NEON);
+
+	return levels;
+}
+
+static std::vector<ConvertCase>
+makeCases(std::size_t pixels) noexcept
+{
+	using namespace ray::image;
+
+	std::vector<ConvertCase> cases;
+	cases.push_back({ "rgb8_to_rgba8", pixels * 3, pixels * 4, [](const std::uint8_t* src, std::uint8_t* dst, std::size_t count) { rgb8_to_rgba8(src, dst, count); } });
+	cases.push_back({ "rgba8_to_rgb8", pixels * 4, pixels * 3, [](const std::uint8_t* src, std::uint8_t* dst, std::size_t count) { rgba8_to_rgb8(src, dst, count); } });
+	cases.push_back({ "rgb8_to_bgr8", pixels * 3, pixels * 3, [](const std::uint8_t* src, std::uint8_t* dst, std::size_t count) { rgb8_to_bgr8(src, dst, count); } });
+	cases.push_back({ "rgba8_to_bgra8", pixels * 4, pixels * 4, [](const std::uint8_t* src, std::uint8_t* dst, std::size_t count) { rgba8_to_bgra8(src, dst, count); } });
+	cases.push_back({ "bgr8_to_rgba8", pixels * 3, pixels * 4, [](const std::uint8_t* src, std::uint8_t* dst, std::size_t count) { bgr8_to_rgba8(src, dst, count); } });
+	cases.push_back({ "rgba8_to_rgba32f", pixels * 4, pixels * 16, [](const std::uint8_t* src, std::uint8_t* dst, std::size_t count) { r8_to_r32f(src, (float*)dst, count * 4); } });
+	cases.push_back({ "rgba32f_to_rgba8", pixels * 16, pixels * 4, [](const std::uint8_t* src, std::uint8_t* dst, std::size_t count) { r32f_to_r8((const float*)src, dst, count * 4); } });
+	cases.push_back({ "rgba32f_to_rgba16f", pixels * 16, pixels * 8, [](const std::uint8_t* src, std::uint8_t* dst, std::size_t count) { r32f_to_r16f((const float*)src, (std::uint16_t*)dst, count * 4); } });
+	cases.push_back({ "rgba16f_to_rgba32f", pixels * 8, pixels * 16, [](const std::uint8_t* src, std::uint8_t* dst, std::size_t count) { r16f_to_r32f((const std::uint16_t*)src, (float*)dst, count * 4); } });
+
+	return cases;
+}
+
+// Bytes for 8 bit sources, floats in [-0.25, 1.25] for float sources and their halfs for half sources,
+// so that clamping and rounding are exercised too.
+static void
+fillSource(const ConvertCase& it, std::vector<std::uint8_t>& data) noexcept
+{
+	std::mt19937 random(it.srcSize);
+	data.resize(it.srcSize);
+
+	if (std::strncmp(it.name, "rgba32f", 7) == 0)
+	{
+		std::uniform_real_distribution<float> dist(-0.25f, 1.25f);
+		auto values = (float*)data.data();
+		for (std::size_t i = 0; i < it.srcSize / sizeof(float); i++)
+			values[i] = dist(random);
+	}
+	else if (std::strncmp(it.name, "rgba16f", 7) == 0)
+	{
+		std::uniform_real_distribution<float> dist(-0.25f, 1.25f);
+		auto values = (std::uint16_t*)data.data();
+		for (std::size_t i = 0; i < it.srcSize / sizeof(std::uint16_t); i++)
+			values[i] = ray::math::fpToHalf(dist(random));
+	}
+	else
+	{
+		for (auto& value : data)
+			value = (std::uint8_t)random();
+	}
+}
+
+static void
+printReport(const ImageBenchmarkParams& params, const std::vector<ConvertResult>& results, const std::vector<MipmapResult>& mipmaps, const std::vector<CompressResult>& compressions) noexcept
+{
+	if (params.csv)
+	{
+		std::printf("converter,simd,ms,mpix_s,gb_s,exact\n");
+
+		for (auto& it : results)
+			std::printf("%s,%s,%.4f,%.1f,%.2f,%d\n", it.name, it.simd, it.ms, it.mpixels, it.gbytes, it.exact ? 1 : 0);
+
+		std::printf("\nmipmap,threads,ms,mpix_s\n");
+
+		for (auto& it : mipmaps)
+			std::printf("%s,%u,%.4f,%.1f\n", it.filter, it.threads, it.ms, it.mpixels);
+
+		std::printf("\nformat,quality,threads,ms,mpix_s,psnr,readback\n");
+
+		for (auto& it : compressions)
+			std::printf("%s,%s,%u,%.4f,%.2f,%.2f,%d\n", it.format, it.quality, it.threads, it.ms, it.mpixels, it.psnr, it.readback ? 1 : 0);
+	}
+	else
+	{
+		std::printf("{\n");
+		std::printf("  \"width\": %u,\n", params.width);
+		std::printf("  \"height\": %u,\n", params.height);
+		std::printf("  \"iterations\": %u,\n", params.iterations);
+		std::printf("  \"simd\": \"%s\",\n", simdName(ray::image::simd_support()));
+		std::printf("  \"converters\": [\n");
+
+		for (std::size_t i = 0; i < results.size(); i++)
+		{
+			auto& it = results[i];
+			std::printf("    { \"converter\": \"%s\", \"simd\": \"%s\", \"ms\": %.4f, \"mpix_s\": %.1f, \"gb_s\": %.2f, \"exact\": %s }%s\n",
+				it.name, it.simd, it.ms, it.mpixels, it.gbytes, it.exact ? "true" : "false",
+				i + 1 < results.size() ? "," : "");
+		}
+
+		std::printf("  ],\n");
+		std::printf("  \"mipmaps\": [\n");
+
+		for (std::size_t i = 0; i < mipmaps.size(); i++)
+		{
+			auto& it = mipmaps[i];
+			std::printf("    { \"filter\": \"%s\", \"threads\": %u, \"ms\": %.4f, \"mpix_s\": %.1f }%s\n",
+				it.filter, it.threads, it.ms, it.mpixels,
+				i + 1 < mipmaps.size() ? "," : "");
+		}
+
+		std::printf("  ],\n");
+		std::printf("  \"compress_size\": %u,\n", params.compressSize);
+		std::printf("  \"compression\": [\n");
+
+		for (std::size_t i = 0; i < compressions.size(); i++)
+		{
+			auto& it = compressions[i];
+			std::printf("    { \"format\": \"%s\", \"quality\": \"%s\", \"threads\": %u, \"ms\": %.4f, \"mpix_s\": %.2f, \"psnr\": %.2f, \"readback\": %s }%s\n",
+				it.format, it.quality, it.threads, it.ms, it.mpixels, it.psnr, it.readback ? "true" : "false",
+				i + 1 < compressions.size() ? "," : "");
+		}
+
+		std::printf("  ]\n");
+		std::printf("}\n");
+	}
+}
+
+static bool
+runConverters(const ImageBenchmarkParams& params, std::vector<ConvertResult>& results) noexcept
+{
+	std::size_t pixels = (std::size_t)params.width * params.height;
+
+	auto levels = supportedLevels();
+	auto cases = makeCases(pixels);
+
+	std::vector<std::uint8_t> src, dst, reference;
+
+	bool exact = true;
+
+	for (auto& it : cases)
+	{
+		fillSource(it, src);
+		dst.resize(it.dstSize);
+		reference.resize(it.dstSize);
+
+		ray::image::set_simd_level(ray::image::simd_t::None);
+		it.convert(src.data(), reference.data(), pixels);
+
+		for (auto level : levels)
+		{
+			ray::image::set_simd_level(level);
+
+			double best = 0.0;
+
+			for (std::uint32_t i = 0; i < params.iterations; i++)
+			{
+				std::memset(dst.data(), 0, dst.size());
+
+				auto begin = std::chrono::high_resolution_clock::now();
+				it.convert(src.data(), dst.data(), pixels);
+				auto end = std::chrono::high_resolution_clock::now();
+
+				double seconds = std::chrono::duration<double>(end - begin).count();
+				if (i == 0 || seconds < best)
+					best = seconds;
+			}
+
+			ConvertResult result;
+			result.name = it.name;
+			result.simd = simdName(level);
+			result.ms = best * 1000.0;
+			result.mpixels = pixels / best / 1e6;
+			result.gbytes = (it.srcSize + it.dstSize) / best / 1e9;
+			result.exact = std::memcmp(dst.data(), reference.data(), dst.size()) == 0;
+
+			exact &= result.exact;
+			results.push_back(result);
+		}
+	}
+
+	ray::image::set_simd_level(ray::image::simd_support());
+
+	return exact;
+}
+
+// Times a full chain from a RGBA8 cutout texture, single threaded and on the requested thread count.
+static void
+runMipmaps(const ImageBenchmarkParams& params, std::vector<MipmapResult>& results) noexcept
+{
+	ray::image::Image image;
+	if (!image.create(params.width, params.height, ray::image::format_t::R8G8B8A8SRGB, false))
+		return;
+
+	std::mt19937 random(params.width * params.height);
+
+	auto data = (std::uint8_t*)image.data();
+	for (std::size_t i = 0; i < image.size(); i++)
+		data[i] = (std::uint8_t)random();
+
+	std::uint32_t threads = params.threads > 0 ? params.threads : std::max(1U, std::thread::hardware_concurrency());
+
+	std::vector<std::uint32_t> threadCounts;
+	threadCounts.push_back(1);
+	if (threads > 1)
+		threadCounts.push_back(threads);
+
+	std::size_t pixels = (std::size_t)params.width * params.height;
+
+	for (auto filter : { ray::image::mip_filter_t::Box, ray::image::mip_filter_t::Kaiser })
+	{
+		for (auto numThreads : threadCounts)
+		{
+			ray::ThreadPool threadPool;
+			threadPool.start(numThreads);
+
+			ray::image::MipmapDesc desc;
+			desc.filter = filter;
+			desc.alphaCutoff = 0.5f;
+			desc.threadPool = &threadPool;
+
+			double best = 0.0;
+
+			for (std::uint32_t i = 0; i < params.mipIterations; i++)
+			{
+				ray::image::Image mipmap;
+
+				auto begin = std::chrono::high_resolution_clock::now();
+				bool succeeded = ray::image::makeMipmap(mipmap, image, desc);
+				auto end = std::chrono::high_resolution_clock::now();
+
+				if (!succeeded)
+					return;
+
+				double seconds = std::chrono::duration<double>(end - begin).count();
+				if (i == 0 || seconds < best)
+					best = seconds;
+			}
+
+			MipmapResult result;
+			result.filter = filter == ray::image::mip_filter_t::Box ? "box" : "kaiser";
+			result.threads = numThreads;
+			result.ms = best * 1000.0;
+			result.mpixels = pixels / best / 1e6;
+
+			results.push_back(result);
+		}
+	}
+}
+
+// Smooth gradients, hard edged checkers, noise and a cut out alpha gradient, so that every block encoder
+// sees the kind of content it struggles with. The HDR copy is linear and gets brighter from left to right.
+static bool
+makeCompressSources(std::uint32_t size, ray::image::Image& ldr, ray::image::Image& hdr) noexcept
+{
+	if (!ldr.create(size, size, ray::image::format_t::R8G8B8A8UNorm, false))
+		return false;
+	if (!hdr.create(size, size, ray::image::format_t::R16G16B16A16SFloat, false))
+		return false;
+
+	std::mt19937 random(size);
+
+	auto pixels = (std::uint8_t*)ldr.data();
+	auto halfs = (std::uint16_t*)hdr.data();
+
+	for (std::uint32_t y = 0; y < size; y++)
+	{
+		for (std::uint32_t x = 0; x < size; x++)
+		{
+			float u = (float)x / size;
+			float v = (float)y / size;
+
+			std::uint8_t* pixel = pixels + ((std::size_t)y * size + x) * 4;
+
+			if (u < 0.5f || v < 0.5f)
+			{
+				pixel[0] = (std::uint8_t)(u * 255.0f);
+				pixel[1] = (std::uint8_t)(v * 255.0f);
+				pixel[2] = (std::uint8_t)(127.5f + 127.5f * std::sin((u + v) * 12.0f));
+			}
+
+			if (u >= 0.5f && v < 0.5f && ((x / 16 + y / 16) & 1))
+			{
+				pixel[0] = 230;
+				pixel[1] = 40;
+				pixel[2] = 60;
+			}
+
+			if (u >= 0.5f && v >= 0.5f)
+			{
+				pixel[0] = (std::uint8_t)(96 + random() % 64);
+				pixel[1] = (std::uint8_t)(128 + random() % 96);
+				pixel[2] = (std::uint8_t)(random() % 256);
+			}
+
+			float dx = u - 0.25f;
+			float dy = v - 0.75f;
+			pixel[3] = dx * dx + dy * dy < 0.01f ? 0 : (std::uint8_t)((u + v) * 127.5f);
+
+			for (std::uint32_t c = 0; c < 3; c++)
+				halfs[((std::size_t)y * size + x) * 4 + c] = ray::math::fpToHalf(std::pow(pixel[c] / 255.0f, 2.2f) * (1.0f + 15.0f * u));
+
+			halfs[((std::size_t)y * size + x) * 4 + 3] = ray::math::fpToHalf(1.0f);
+		}
+	}
+
+	return true;
+}
+
+// PSNR over the channels a format keeps, the peak of HDR images is their brightest value.
+static double
+computePsnr(const ray::image::Image& src, const ray::image::Image& decoded, const CompressCase& it) noexcept
+{
+	std::size_t pixels = (std::size_t)src.width() * src.height();
+	std::uint32_t stride = decoded.channel();
+
+	double error = 0.0;
+	double peak = 255.0;
+
+	if (it.hdr)
+	{
+		peak = 0.0;
+
+		auto expected = (const std::uint16_t*)src.data();
+		auto actual = (const std::uint16_t*)decoded.data();
+
+		for (std::size_t i = 0; i < pixels; i++)
+		{
+			for (std::uint32_t c = 0; c < it.channels; c++)
+			{
+				double value = ray::math::fpFromHalf(expected[i * 4 + c]);
+				double diff = ray::math::fpFromHalf(actual[i * stride + c]) - value;
+
+				error += diff * diff;
+				peak = std::max(peak, value);
+			}
+		}
+	}
+	else
+	{
+		auto expected = (const std::uint8_t*)src.data();
+		auto actual = (const std::uint8_t*)decoded.data();
+
+		for (std::size_t i = 0; i < pixels; i++)
+		{
+			for (std::uint32_t c = 0; c < it.channels; c++)
+			{
+				double diff = (double)actual[i * stride + c] - expected[i * 4 + c];
+				error += diff * diff;
+			}
+		}
+	}
+
+	error /= pixels * it.channels;
+
+	return error > 0.0 ? std::min(10.0 * std::log10(peak * peak / error), 99.0) : 99.0;
+}
+
+// Saves the blocks as dds and loads them back, the result must be the same image.
+static bool
+checkReadback(ray::image::Image& image) noexcept
+{
+	ray::MemoryStream stream;
+	if (!image.save(stream, "dds"))
+		return false;
+
+	stream.seekg(0, std::ios_base::beg);
+
+	ray::image::Image readback;
+	if (!readback.load(stream, "dds"))
+		return false;
+
+	return readback.format() == image.format() &&
+		readback.width() == image.width() &&
+		readback.height() == image.height() &&
+		readback.size() == image.size() &&
+		std::memcmp(readback.data(), image.data(), image.size()) == 0;
+}
+
+static void
+runCompress(const ImageBenchmarkParams& params, std::vector<CompressResult>& results) noexcept
+{
+	using namespace ray::image;
+
+	Image ldr, hdr;
+	if (!makeCompressSources(params.compressSize, ldr, hdr))
+		return;
+
+	const CompressCase cases[] =
+	{
+		{ "bc1", format_t::BC1RGBUNormBlock, 3, false },
+		{ "bc3", format_t::BC3UNormBlock, 4, false },
+		{ "bc4", format_t::BC4UNormBlock, 1, false },
+		{ "bc5", format_t::BC5UNormBlock, 2, false },
+		{ "bc6h", format_t::BC6HUFloatBlock, 3, true },
+		{ "bc7", format_t::BC7UNormBlock, 4, false },
+	};
+
+	const std::pair<compress_quality_t, const char*> qualities[] =
+	{
+		{ compress_quality_t::Fast, "fast" },
+		{ compress_quality_t::Normal, "normal" },
+		{ compress_quality_t::High, "high" },
+	};
+
+	std::uint32_t threads = params.threads > 0 ? params.threads : std::max(1U, std::thread::hardware_concurrency());
+	std::size_t pixels = (std::size_t)params.compressSize * params.compressSize;
+
+	ray::ThreadPool threadPool;
+	threadPool.start(threads);
+
+	for (auto& it : cases)
+	{
+		const Image& src = it.hdr ? hdr : ldr;
+
+		for (auto& quality : qualities)
+		{
+			CompressDesc desc;
+			desc.quality = quality.first;
+			desc.threadPool = &threadPool;
+
+			Image blocks;
+
+			auto begin = std::chrono::high_resolution_clock::now();
+			bool succeeded = compress(blocks, src, it.format, desc);
+			auto end = std::chrono::high_resolution_clock::now();
+
+			Image decoded;
+			if (!succeeded || !decompress(decoded, blocks))
+				continue;
+
+			double seconds = std::chrono::duration<double>(end - begin).count();
+
+			CompressResult result;
+			result.format = it.name;
+			result.quality = quality.second;
+			result.threads = threads;
+			result.ms = seconds * 1000.0;
+			result.mpixels = pixels / seconds / 1e6;
+			result.psnr = computePsnr(src, decoded, it);
+			result.readback = checkReadback(blocks);
+
+			if (!params.output.empty())
+				blocks.save(params.output + "/" + it.name + "_" + quality.second + ".dds", "dds");
+
+			results.push_back(result);
+		}
+	}
+}
+
+int main(int argc, const char* argv[])
+{
+	ImageBenchmarkParams params;
+	if (!parseParams(argc, argv, params))
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	std::vector<ConvertResult> results;
+	std::vector<MipmapResult> mipmaps;
+	std::vector<CompressResult> compressions;
+
+	bool exact = runConverters(params, results);
+
+	runMipmaps(params, mipmaps);
+	runCompress(params, compressions);
+
+	printReport(params, results, mipmaps, compressions);
+
+	if (!exact)
+	{
+		std::fprintf(stderr, "some converters do not match the scalar output.\n");
+		return 1;
+	}
+
+	for (auto& it : compressions)
+	{
+		if (!it.readback)
+		{
+			std::fprintf(stderr, "%s does not read back from dds.\n", it.format);
+			return 1;
+		}
+	}
+
+	return 0;
+}